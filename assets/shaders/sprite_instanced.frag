@@ -0,0 +1,12 @@
+#version 330 core
+
+in vec2 uvs;
+
+layout(location = 0) out vec4 final_col;
+
+uniform sampler2D tex0;
+
+void main()
+{
+	final_col = texture(tex0, uvs);
+}
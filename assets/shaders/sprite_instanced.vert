@@ -0,0 +1,29 @@
+#version 330 core
+
+// One quad per instance (GL_TRIANGLE_STRIP, 4 vertices), corners from gl_VertexID:
+// 0 top-left, 1 top-right, 2 bottom-left, 3 bottom-right. The diagonal (top-right to bottom-left)
+// is the one GL_QUADS uses for the immediate-mode quads, so both split the quad the same way.
+layout(location=0) in vec2 sp_center;     // Quad centre in grid space
+layout(location=1) in vec2 sp_halfSize;
+layout(location=2) in vec2 sp_anchor;     // Anchor offset, subtracted before rotating
+layout(location=3) in vec2 sp_rotation;   // cos, sin (counter-clockwise)
+layout(location=4) in vec4 sp_uvRect;     // u0, v0, u1, v1
+
+uniform mat4 transformMat; // Projection * modelview of the fixed-function stack
+
+out vec2 uvs;
+
+void main()
+{
+	vec2 corner = vec2((gl_VertexID & 1) != 0 ? 1.0 : -1.0, (gl_VertexID & 2) != 0 ? -1.0 : 1.0);
+	vec2 local = corner * sp_halfSize;
+
+	// Same composition as glTranslatef(center) * glRotatef(rotation) * glTranslatef(-anchor)
+	float c = sp_rotation.x;
+	float s = sp_rotation.y;
+	vec2 offset = vec2(c * -sp_anchor.x + -s * -sp_anchor.y, s * -sp_anchor.x + c * -sp_anchor.y) + sp_center;
+	vec2 position = vec2(c * local.x + -s * local.y, s * local.x + c * local.y) + offset;
+	gl_Position = transformMat * vec4(position, 0.0, 1.0);
+
+	uvs = vec2(corner.x < 0.0 ? sp_uvRect.x : sp_uvRect.z, corner.y < 0.0 ? sp_uvRect.y : sp_uvRect.w);
+}
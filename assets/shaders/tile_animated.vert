@@ -0,0 +1,57 @@
+#version 330 core
+
+// One block quad per instance (GL_TRIANGLE_STRIP, 4 vertices). Corners of the block, in the order
+// drawBlocks submits them: 0 bottom-left, 1 bottom-right, 2 top-right, 3 top-left. The strip
+// visits 1, 0, 2, 3 so its diagonal (bottom-left to top-right) is the one GL_QUADS uses.
+layout(location=0) in vec2 tl_cell;         // Block cell in world units
+layout(location=1) in float tl_phaseOffset; // Animation phase at clock 0, in frames
+layout(location=2) in uint tl_rotation;     // rotationAngle / 90
+
+uniform mat4 transformMat; // Projection * modelview of the fixed-function stack
+uniform vec4 cameraRect;   // cameraLeft, cameraBottom, view width, view height (world units)
+uniform vec4 gridRect;     // startX, startY, endX - startX, endY - startY
+uniform vec2 cellSize;     // One block in grid space
+uniform vec4 cullRect;     // cameraLeft - 1, cameraRight + 1, cameraBottom - 1, cameraTop + 1
+uniform float frameCount;  // Frames of the block type (1 for static textures)
+uniform float frameRatio;  // 1 / frameCount, computed on the CPU
+uniform float wrappedPhase; // Phase of the block type this frame, in [0, frameCount)
+
+out vec2 uvs;
+
+const int STRIP_CORNER[4] = int[4](1, 0, 2, 3);
+
+void main()
+{
+	// Same cull as collectBlockQuads: the quad collapses outside the clip volume
+	if (tl_cell.x < cullRect.x || tl_cell.x > cullRect.y || tl_cell.y < cullRect.z || tl_cell.y > cullRect.w) {
+		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+		uvs = vec2(0.0);
+		return;
+	}
+
+	// Same operations, in the same order, as the CPU quads (see collectBlockQuads)
+	int corner = STRIP_CORNER[gl_VertexID];
+	float normalizedX = (tl_cell.x - cameraRect.x) / cameraRect.z;
+	float normalizedY = (tl_cell.y - cameraRect.y) / cameraRect.w;
+	vec2 position = vec2(gridRect.x + normalizedX * gridRect.z, gridRect.y + normalizedY * gridRect.w);
+	if (corner == 1 || corner == 2) {
+		position.x = position.x + cellSize.x;
+	}
+	if (corner >= 2) {
+		position.y = position.y + cellSize.y;
+	}
+	gl_Position = transformMat * vec4(position, 0.0, 1.0);
+
+	// Animation frame (tileAnimationFrame) and its rows in the spritesheet
+	float frame = tl_phaseOffset + wrappedPhase;
+	if (frame >= frameCount) {
+		frame = frame - frameCount;
+	}
+	float rowStart = floor(frame) * frameRatio;
+	float rowEnd = rowStart + frameRatio;
+
+	// A rotation by k quarter turns gives each corner the texture coordinates of the corner k
+	// steps before it
+	int source = (corner - int(tl_rotation)) & 3;
+	uvs = vec2((source == 1 || source == 2) ? 1.0 : 0.0, source >= 2 ? rowEnd : rowStart);
+}
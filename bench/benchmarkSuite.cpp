@@ -0,0 +1,503 @@
+// Micro-benchmark suite for the hot paths of collision, pathfinding and rendering
+// Each benchmark runs its body in a loop until it has run for at least --min-time seconds
+// (iteration count grown like Google Benchmark does) and reports the wall time and the CPU time
+// of the benchmark thread per iteration. --json writes the results in Google Benchmark's JSON
+// format, so the usual tools (compare.py, CI dashboards) read them as they are.
+//
+// The worlds are synthetic: terrain from a fixed seed, the regular terrain elements, then
+// extra coconut trees and extra animals/pirates at seeded positions - the benchmark argument
+// scales the element or entity count. The suite runs as a lockstep session (simulationReplay.h):
+// no camera culling and a game clock that only moves when a world is (re)built, so the interval
+// caches of the collision code are fresh for every world and then stay warm, like between two
+// refreshes in the game.
+//
+// Usage: bench_suite [--filter substring] [--min-time seconds] [--json results.json] [--seed S]
+
+#include "../src/terrainGeneration.h"
+#include "../src/terrainGenerationConfig.h"
+#include "../src/map.h"
+#include "../src/elementsOnMap.h"
+#include "../src/entities.h"
+#include "../src/pathfinding.h"
+#include "../src/collision.h"
+#include "../src/gameClock.h"
+#include "../src/globals.h"
+#include "../src/simulationRandom.h"
+#include "../src/simulationReplay.h"
+#include "../src/visibleSet.h"
+#include "glbasimac/glbi_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#define ChangeDir _chdir
+#else
+#include <unistd.h>
+#define ChangeDir chdir
+#endif
+
+// Symbols normally defined by main.cpp (referenced by the menu/input code in the core library)
+bool gameplayActive = false;
+glbasimac::GLBI_Engine myEngine;
+bool startGameplay(glbasimac::GLBI_Engine&, GLFWwindow*) { return false; }
+void endGameplay() {}
+
+namespace {
+
+// ---- Harness ----
+
+// Results are folded into this so the compiler can't drop the benchmarked calls
+volatile uint64_t g_benchSink = 0;
+
+const int64_t MAX_ITERATIONS = 1000000000;
+
+double threadCpuSeconds() {
+#ifdef _WIN32
+    // No per-thread CPU clock in the standard library: process CPU time (the suite is single-threaded)
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+struct BenchmarkCase {
+    std::string name;                  // "BM_Name/arg"
+    const char* timeUnit;              // "ns", "us" or "ms"
+    std::function<void()> setup;       // Not timed (builds the synthetic world)
+    std::function<void()> body;        // One iteration
+};
+
+struct BenchmarkResult {
+    std::string name;
+    const char* timeUnit;
+    int64_t iterations;
+    double realTime;                   // Per iteration, in timeUnit
+    double cpuTime;
+};
+
+std::vector<BenchmarkCase> g_benchmarks;
+
+void addBenchmark(const std::string& name, const char* timeUnit, const std::vector<int64_t>& args,
+                  std::function<void(int64_t)> setup, std::function<void(int64_t)> body) {
+    for (int64_t arg : args) {
+        BenchmarkCase benchmark;
+        benchmark.name = name + "/" + std::to_string(arg);
+        benchmark.timeUnit = timeUnit;
+        benchmark.setup = [setup, arg] { if (setup) setup(arg); };
+        benchmark.body = [body, arg] { body(arg); };
+        g_benchmarks.push_back(std::move(benchmark));
+    }
+}
+
+double unitMultiplier(const char* timeUnit) {
+    if (std::strcmp(timeUnit, "ms") == 0) return 1e3;
+    if (std::strcmp(timeUnit, "us") == 0) return 1e6;
+    return 1e9;
+}
+
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmark, double minTimeSeconds) {
+    benchmark.setup();
+    benchmark.body(); // Warm-up: first-touch allocations and cache fills are not measured
+
+    int64_t iterations = 1;
+    double realSeconds = 0.0;
+    double cpuSeconds = 0.0;
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        double cpuStart = threadCpuSeconds();
+        for (int64_t i = 0; i < iterations; ++i) {
+            benchmark.body();
+        }
+        cpuSeconds = threadCpuSeconds() - cpuStart;
+        realSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (realSeconds >= minTimeSeconds || iterations >= MAX_ITERATIONS) break;
+        // Aim 40% past the minimum time; grow at most 10x while the last run was too short to predict from
+        double multiplier = minTimeSeconds * 1.4 / std::max(realSeconds, 1e-9);
+        if (realSeconds / minTimeSeconds <= 0.1) multiplier = std::min(multiplier, 10.0);
+        int64_t next = static_cast<int64_t>(std::llround(iterations * multiplier));
+        iterations = std::min(std::max(next, iterations + 1), MAX_ITERATIONS);
+    }
+
+    double scale = unitMultiplier(benchmark.timeUnit) / static_cast<double>(iterations);
+    return {benchmark.name, benchmark.timeUnit, iterations, realSeconds * scale, cpuSeconds * scale};
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool writeJson(const std::string& path, const std::string& executable, const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write benchmark results to " << path << std::endl;
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"executable\": \"" << jsonEscape(executable) << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    out << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        out << "    {\n";
+        out << "      \"name\": \"" << jsonEscape(result.name) << "\",\n";
+        out << "      \"run_name\": \"" << jsonEscape(result.name) << "\",\n";
+        out << "      \"run_type\": \"iteration\",\n";
+        out << "      \"iterations\": " << result.iterations << ",\n";
+        out << "      \"real_time\": " << result.realTime << ",\n";
+        out << "      \"cpu_time\": " << result.cpuTime << ",\n";
+        out << "      \"time_unit\": \"" << result.timeUnit << "\"\n";
+        out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+// ---- Synthetic worlds ----
+
+unsigned int g_seed = 12345;
+
+struct WorldSpec {
+    int extraElements = 0;
+    int extraEntities = 0;
+    bool operator==(const WorldSpec& other) const {
+        return extraElements == other.extraElements && extraEntities == other.extraEntities;
+    }
+};
+
+bool g_terrainGenerated = false;
+WorldSpec g_currentWorld{-1, -1};
+
+void generateTerrainOnce() {
+    if (g_terrainGenerated) return;
+    g_terrainGenerated = true;
+
+    // Same seeding as startGameplay
+    SEED_GAMEPLAY = g_seed;
+    srand(g_seed);
+    TERRAIN_RNG.seed(g_seed);
+    seedSimulationRandom(g_seed);
+    resetTerrainGeneration();
+    g_terrainConfig.initializeDefaultRules();
+
+    gameMap.init(myEngine);
+    WORLD_SIZE = GRID_SIZE;
+    TerrainGrid terrain = generateTerrainGrid(GRID_SIZE, GRID_SIZE, islandFeatureSize, seaFeatureSize, 0.55f, 0.65f);
+    gameMap.placeBlockGrid(terrain.blocks, terrain.width, terrain.height);
+
+    entitiesManager.initializeEntityConfigurations();
+    elementsManager.init(myEngine);
+    placeTerrainElements(elementsManager, gameMap, GRID_SIZE, GRID_SIZE);
+}
+
+// Seeded island world with extraElements coconut trees and extraEntities animals/pirates on top
+// of the regular terrain elements. Rebuilt only when the spec changes.
+void buildWorld(const WorldSpec& spec) {
+    generateTerrainOnce();
+    if (spec == g_currentWorld) return;
+    g_currentWorld = spec;
+
+    elementsManager.removeAllElementsByCategory("bench_tree_");
+    entitiesManager.clearAllEntities();
+
+    std::mt19937 placementRng(g_seed);
+    std::uniform_real_distribution<float> coordinate(1.0f, WORLD_SIZE - 1.0f);
+    const ElementName treeTypes[] = {ElementName::COCONUT_TREE_1, ElementName::COCONUT_TREE_2, ElementName::COCONUT_TREE_3};
+    for (int i = 0; i < spec.extraElements; ++i) {
+        float x = coordinate(placementRng);
+        float y = coordinate(placementRng);
+        elementsManager.placeElement("bench_tree_" + std::to_string(i), treeTypes[i % 3], 1.0f, x, y);
+    }
+
+    entitiesManager.placeEntityByTypeSafely("player1", EntityName::PLAYER, WORLD_SIZE / 2.0f, WORLD_SIZE / 2.0f);
+    const EntityName extraTypes[] = {EntityName::GIRAFFE, EntityName::ARMADILLO, EntityName::SHARK,
+                                     EntityName::PIRATE_MAN, EntityName::PIRATE_WOMAN};
+    for (int i = 0; i < spec.extraEntities; ++i) {
+        EntityName type = extraTypes[i % (sizeof(extraTypes) / sizeof(extraTypes[0]))];
+        float x = coordinate(placementRng);
+        float y = coordinate(placementRng);
+        entitiesManager.placeEntityByTypeSafely("bench_entity_" + std::to_string(i), type, x, y);
+    }
+
+    // The hierarchical element grid only learns about elements when it is (re)initialized
+    resetCollisionCache();
+    updateSpatialGrid();
+    updateEntitySpatialGrid();
+    // Move the lockstep clock past the longest refresh interval of the collision caches (the static
+    // element grid, 2 s): every cache sees the new world on its next query
+    for (int tick = 0; tick < static_cast<int>(3 * LOCKSTEP_TICK_RATE); ++tick) {
+        g_simulationReplay.nextTickInput();
+    }
+}
+
+// Fixed query positions spread over the whole world
+std::vector<std::pair<float, float>> seededPositions(size_t count, unsigned int salt) {
+    std::mt19937 rng(g_seed + salt);
+    std::uniform_real_distribution<float> coordinate(2.0f, WORLD_SIZE - 2.0f);
+    std::vector<std::pair<float, float>> positions;
+    positions.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        float x = coordinate(rng);
+        positions.push_back({x, coordinate(rng)});
+    }
+    return positions;
+}
+
+// Start/goal pairs about `distance` apart, both valid positions for the entity
+std::vector<std::pair<std::pair<float, float>, std::pair<float, float>>> seededRoutes(
+    size_t count, float distance, const EntityConfiguration& config) {
+    std::mt19937 rng(g_seed + static_cast<unsigned int>(distance));
+    std::uniform_real_distribution<float> coordinate(2.0f, WORLD_SIZE - 2.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<std::pair<std::pair<float, float>, std::pair<float, float>>> routes;
+    for (int attempt = 0; attempt < 10000 && routes.size() < count; ++attempt) {
+        float startX = coordinate(rng);
+        float startY = coordinate(rng);
+        float direction = angle(rng);
+        float goalX = startX + distance * std::cos(direction);
+        float goalY = startY + distance * std::sin(direction);
+        if (goalX < 2.0f || goalY < 2.0f || goalX > WORLD_SIZE - 2.0f || goalY > WORLD_SIZE - 2.0f) continue;
+        if (!isPositionValid(startX, startY, config, gameMap) || !isPositionValid(goalX, goalY, config, gameMap)) continue;
+        routes.push_back({{startX, startY}, {goalX, goalY}});
+    }
+    return routes;
+}
+
+std::vector<std::pair<float, float>> regularPolygon(int vertexCount, float centerX, float centerY, float radius) {
+    std::vector<std::pair<float, float>> polygon;
+    for (int i = 0; i < vertexCount; ++i) {
+        float angle = 6.2831853f * i / vertexCount;
+        polygon.push_back({centerX + radius * std::cos(angle), centerY + radius * std::sin(angle)});
+    }
+    return polygon;
+}
+
+const size_t QUERIES_PER_ITERATION = 256;
+const size_t ROUTE_COUNT = 16;
+const WorldSpec DEFAULT_WORLD{0, 50};
+
+void registerBenchmarks() {
+    // Block lookups: one pass over every cell of the world
+    addBenchmark("BM_GetBlockNameByCoordinates", "us", {GRID_SIZE},
+        [](int64_t) { buildWorld(DEFAULT_WORLD); },
+        [](int64_t size) {
+            uint64_t sum = 0;
+            for (int x = 0; x < size; ++x) {
+                for (int y = 0; y < size; ++y) {
+                    sum += static_cast<uint64_t>(gameMap.getBlockNameByCoordinates(x, y));
+                }
+            }
+            g_benchSink = g_benchSink + sum;
+        });
+
+    // SAT test between two regular polygons, half overlapping / half separated
+    addBenchmark("BM_PolygonPolygonCollision", "ns", {4, 8, 16, 32},
+        nullptr,
+        [](int64_t vertices) {
+            static std::vector<std::pair<float, float>> polygonA;
+            static std::vector<std::pair<float, float>> polygonOverlapping;
+            static std::vector<std::pair<float, float>> polygonApart;
+            static int64_t builtFor = 0;
+            if (builtFor != vertices) {
+                builtFor = vertices;
+                polygonA = regularPolygon(static_cast<int>(vertices), 0.0f, 0.0f, 1.0f);
+                polygonOverlapping = regularPolygon(static_cast<int>(vertices), 1.5f, 0.2f, 1.0f);
+                polygonApart = regularPolygon(static_cast<int>(vertices), 2.5f, 0.2f, 1.0f);
+            }
+            g_benchSink = g_benchSink + polygonPolygonCollision(polygonA, polygonOverlapping)
+                                      + polygonPolygonCollision(polygonA, polygonApart);
+        });
+
+    // Entity shape against the elements around 256 positions; arg = extra coconut trees
+    addBenchmark("BM_EntityCollideWithElementsGranular", "us", {0, 500, 2000},
+        [](int64_t elements) { buildWorld({static_cast<int>(elements), DEFAULT_WORLD.extraEntities}); },
+        [](int64_t) {
+            static const auto positions = seededPositions(QUERIES_PER_ITERATION, 1);
+            const EntityConfiguration* config = entitiesManager.getConfiguration(EntityName::PIRATE_MAN);
+            uint64_t hits = 0;
+            for (const auto& position : positions) {
+                hits += wouldEntityCollideWithElementsGranular(*config, position.first, position.second, false);
+                hits += wouldEntityCollideWithElementsGranular(*config, position.first, position.second, true);
+            }
+            g_benchSink = g_benchSink + hits;
+        });
+
+    // Entity shape against the other entities around 256 positions; arg = extra entities.
+    // No shipped configuration collides with entities yet: the pirate here collides with every type.
+    addBenchmark("BM_EntityCollideWithEntitiesGranular", "us", {0, 100, 400},
+        [](int64_t entities) { buildWorld({DEFAULT_WORLD.extraElements, static_cast<int>(entities)}); },
+        [](int64_t) {
+            static const auto positions = seededPositions(QUERIES_PER_ITERATION, 2);
+            static EntityConfiguration config = [] {
+                EntityConfiguration pirate = *entitiesManager.getConfiguration(EntityName::PIRATE_MAN);
+                pirate.collisionEntities = {EntityName::PLAYER, EntityName::GIRAFFE, EntityName::ARMADILLO,
+                                            EntityName::SHARK, EntityName::PIRATE_MAN, EntityName::PIRATE_WOMAN};
+                return pirate;
+            }();
+            uint64_t hits = 0;
+            for (const auto& position : positions) {
+                hits += wouldEntityCollideWithEntitiesGranular(config, position.first, position.second, false, "");
+            }
+            g_benchSink = g_benchSink + hits;
+        });
+
+    // A* on the seeded island, one route per iteration (16 routes in turn); arg = route length in blocks
+    auto registerPathfinding = [](const char* name, bool hybrid) {
+        addBenchmark(name, "ms", {8, 24, 64},
+            [](int64_t) { buildWorld(DEFAULT_WORLD); },
+            [hybrid](int64_t distance) {
+                static std::vector<std::pair<std::pair<float, float>, std::pair<float, float>>> routes;
+                static int64_t builtFor = 0;
+                static size_t next = 0;
+                const EntityConfiguration* config = entitiesManager.getConfiguration(EntityName::PIRATE_MAN);
+                if (builtFor != distance) {
+                    builtFor = distance;
+                    routes = seededRoutes(ROUTE_COUNT, static_cast<float>(distance), *config);
+                    next = 0;
+                }
+                if (routes.empty()) return;
+                const auto& route = routes[next++ % routes.size()];
+                std::vector<std::pair<float, float>> path = hybrid
+                    ? findPathHybrid(route.first.first, route.first.second, route.second.first, route.second.second, *config, gameMap, 1.0f)
+                    : findPathOptimized(route.first.first, route.first.second, route.second.first, route.second.second, *config, gameMap, 1.0f);
+                g_benchSink = g_benchSink + path.size();
+            });
+    };
+    registerPathfinding("BM_FindPathOptimized", false);
+    registerPathfinding("BM_FindPathHybrid", true);
+
+    // Legacy coordinate-map terrain generator; arg = world side in blocks
+    addBenchmark("BM_GenerateTerrain", "ms", {64, 170, 512},
+        [](int64_t) { generateTerrainOnce(); },
+        [](int64_t size) {
+            TERRAIN_RNG.seed(g_seed);
+            std::map<std::pair<int, int>, BlockName> terrain = generateTerrain(
+                static_cast<int>(size), static_cast<int>(size), islandFeatureSize, seaFeatureSize, 0.55f, 0.65f);
+            g_benchSink = g_benchSink + terrain.size();
+        });
+
+    // drawBlocks' per-frame work without OpenGL: block quads of a square view; arg = view side in blocks
+    addBenchmark("BM_DrawBlocksQuads", "us", {16, 48, 128},
+        [](int64_t) { buildWorld(DEFAULT_WORLD); },
+        [](int64_t viewSize) {
+            static std::vector<BlockQuad> quads;
+            static VisibleSet visible;
+            float center = WORLD_SIZE / 2.0f;
+            float half = viewSize / 2.0f;
+            visible.update(-1.0f, 1.0f, -1.0f, 1.0f, CameraView{center - half, center + half, center - half, center + half});
+            gameMap.collectBlockQuads(visible, 1.0 / 60.0, quads);
+            g_benchSink = g_benchSink + quads.size();
+        });
+
+    // drawElements' per-frame work without OpenGL: visible set, sort, animations and the sprite
+    // batch of a square view; arg = view side in blocks
+    addBenchmark("BM_DrawElementsSpriteBatch", "us", {16, 48, 128},
+        [](int64_t) { buildWorld({2000, DEFAULT_WORLD.extraEntities}); },
+        [](int64_t viewSize) {
+            static SpriteBatch batch;
+            static VisibleSet visible;
+            float center = WORLD_SIZE / 2.0f;
+            float half = viewSize / 2.0f;
+            visible.update(-1.0f, 1.0f, -1.0f, 1.0f, CameraView{center - half, center + half, center - half, center + half});
+            elementsManager.collectVisibleElements(visible);
+            elementsManager.collectSprites(visible, 1.0 / 60.0, batch);
+            g_benchSink = g_benchSink + batch.size() + batch.getRuns().size();
+        });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    double minTimeSeconds = 0.5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--filter") == 0) {
+            filter = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            jsonPath = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--min-time") == 0) {
+            minTimeSeconds = std::atof(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            g_seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+    }
+
+    // Resolve the output path before leaving the working directory
+    if (!jsonPath.empty()) {
+        jsonPath = std::filesystem::absolute(jsonPath).string();
+    }
+
+    // Asset paths are relative to src/ (like running the game from the build output directory)
+    if (ChangeDir(SORBETCOCO_ASSET_ROOT_DIR) != 0) {
+        std::cerr << "Cannot enter asset root directory: " << SORBETCOCO_ASSET_ROOT_DIR << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Null renderer, lockstep session (tick-derived clock, whole world visible to the collision checks)
+    HEADLESS_MODE = true;
+    g_simulationReplay.beginLive(g_seed);
+    setGameClockSource(lockstepGameClock);
+
+    registerBenchmarks();
+
+    std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(16) << "Time"
+              << std::setw(16) << "CPU" << std::setw(14) << "Iterations" << std::endl;
+    std::cout << std::string(94, '-') << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    for (const BenchmarkCase& benchmark : g_benchmarks) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+        BenchmarkResult result = runBenchmark(benchmark, minTimeSeconds);
+        std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(13) << result.realTime << " " << result.timeUnit
+                  << std::setw(13) << result.cpuTime << " " << result.timeUnit
+                  << std::setw(14) << result.iterations << std::endl;
+        results.push_back(result);
+    }
+
+    g_simulationReplay.end();
+
+    if (!jsonPath.empty()) {
+        if (!writeJson(jsonPath, argv[0], results)) return EXIT_FAILURE;
+        std::cout << "Results written to " << jsonPath << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+// Headless simulation benchmark
+// Generates a world from a fixed seed and replays the gameplay simulation (entity movement,
+// behaviors, pathfinding, block transformations) at a fixed 60 Hz step with no window:
+// textures are only measured (HEADLESS_MODE) and the simulation runs as a lockstep session
+// (simulationReplay.h), so the same seed simulates the same world every run - the world checksum
+// printed at the end must not change between runs of the same build.
+// Reports the per-tick time percentiles.
+// Usage: bench_sim [--seconds N] [--entities M] [--seed S] [--trace trace.json] [--metrics-port P]
+//   --trace also writes the profiler zones of the last ticks as a Chrome trace (see performanceProfiler.h)
+//   --metrics-port serves the runtime metrics on 127.0.0.1:P/metrics while simulating (see metrics.h)
+
+#include "../src/terrainGeneration.h"
+#include "../src/terrainGenerationConfig.h"
+#include "../src/map.h"
+#include "../src/elementsOnMap.h"
+#include "../src/entities.h"
+#include "../src/entityBehaviors.h"
+#include "../src/gameClock.h"
+#include "../src/globals.h"
+#include "../src/performanceProfiler.h"
+#include "../src/entitiesStatus.h"
+#include "../src/tickGraph.h"
+#include "../src/simulationRandom.h"
+#include "../src/simulationReplay.h"
+#include "../src/metricsServer.h"
+#include "../src/timeSlicedJobs.h"
+#include "../src/frameArena.h"
+#include "glbasimac/glbi_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#define ChangeDir _chdir
+#else
+#include <unistd.h>
+#define ChangeDir chdir
+#endif
+
+// Symbols normally defined by main.cpp (referenced by the menu/input code in the core library)
+bool gameplayActive = false;
+glbasimac::GLBI_Engine myEngine;
+bool startGameplay(glbasimac::GLBI_Engine&, GLFWwindow*) { return false; }
+void endGameplay() {}
+
+namespace {
+
+const double TICK_SECONDS = 1.0 / LOCKSTEP_TICK_RATE; // Same rate as the logic thread
+
+template <typename Func>
+double timeMs(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void printRow(const char* label, double ms) {
+    std::cout << "  " << std::left << std::setw(24) << label
+              << std::right << std::setw(10) << std::fixed << std::setprecision(3) << ms << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 30.0;
+    int extraEntities = 50;
+    unsigned int seed = 12345;
+    std::string tracePath;
+    int metricsPort = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--seconds") == 0) {
+            seconds = std::atof(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--entities") == 0) {
+            extraEntities = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--metrics-port") == 0) {
+            metricsPort = std::atoi(argv[i + 1]);
+        }
+    }
+
+    // Resolve the trace path before leaving the working directory
+    if (!tracePath.empty()) {
+        tracePath = std::filesystem::absolute(tracePath).string();
+    }
+
+    // Asset paths are relative to src/ (like running the game from the build output directory)
+    if (ChangeDir(SORBETCOCO_ASSET_ROOT_DIR) != 0) {
+        std::cerr << "Cannot enter asset root directory: " << SORBETCOCO_ASSET_ROOT_DIR << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Null renderer, lockstep session (tick-derived clock, whole world visible to the collision checks)
+    HEADLESS_MODE = true;
+    g_simulationReplay.beginLive(seed);
+    setGameClockSource(lockstepGameClock);
+
+    // Same seeding as startGameplay
+    SEED_GAMEPLAY = seed;
+    srand(seed);
+    TERRAIN_RNG.seed(seed);
+    seedSimulationRandom(seed);
+    resetTerrainGeneration();
+    g_terrainConfig.initializeDefaultRules();
+
+    double setupMs = timeMs([&] {
+        gameMap.init(myEngine);
+        WORLD_SIZE = GRID_SIZE;
+        TerrainGrid terrain = generateTerrainGrid(GRID_SIZE, GRID_SIZE, islandFeatureSize, seaFeatureSize, 0.55f, 0.65f);
+        gameMap.placeBlockGrid(terrain.blocks, terrain.width, terrain.height);
+
+        entitiesManager.initializeEntityConfigurations();
+        entitiesManager.initializeAsyncPathfinding();
+        entitiesManager.setDeferredPathfinding(true);
+
+        elementsManager.init(myEngine);
+        placeTerrainElements(elementsManager, gameMap, GRID_SIZE, GRID_SIZE);
+
+        entitiesManager.placeEntityByTypeSafely("player1", EntityName::PLAYER, WORLD_SIZE / 2.0f, WORLD_SIZE / 2.0f);
+
+        // Extra animals/pirates at seeded positions (placeEntityByTypeSafely moves them to walkable ground)
+        const EntityName extraTypes[] = {EntityName::GIRAFFE, EntityName::ARMADILLO, EntityName::SHARK,
+                                         EntityName::PIRATE_MAN, EntityName::PIRATE_WOMAN};
+        std::mt19937 placementRng(seed);
+        std::uniform_real_distribution<float> coordinate(1.0f, WORLD_SIZE - 1.0f);
+        for (int i = 0; i < extraEntities; ++i) {
+            EntityName type = extraTypes[i % (sizeof(extraTypes) / sizeof(extraTypes[0]))];
+            float x = coordinate(placementRng);
+            float y = coordinate(placementRng);
+            entitiesManager.placeEntityByTypeSafely("bench_entity_" + std::to_string(i), type, x, y);
+        }
+    });
+
+    int tickCount = static_cast<int>(seconds / TICK_SECONDS);
+    std::cout << "Simulating " << tickCount << " ticks (" << seconds << " s) with "
+              << entitiesManager.getEntities().size() << " entities, seed " << seed << std::endl;
+
+    // Whole world counts as visible: no view frustum culling
+    const float worldMin = 0.0f;
+    const float worldMax = static_cast<float>(WORLD_SIZE);
+
+    // The entity/world stages of the game's lockstep logic tick graph (GameThreadManager::buildTickGraph),
+    // without input, player movement and rendering. One worker, like a lockstep session.
+    tf::Executor tickExecutor(1, std::make_shared<TickWorkerInterface>());
+    TickGraph tickGraph(tickExecutor);
+    TickGraph::StageId entityMovement = tickGraph.addStage("Tick_EntityMovement", [&] {
+        entitiesManager.update(TICK_SECONDS, worldMin, worldMax, worldMin, worldMax);
+    });
+    TickGraph::StageId entitySensing = tickGraph.addStage("Tick_EntitySensing", [&] {
+        entityBehaviorManager.update(TICK_SECONDS, entitiesManager, worldMin, worldMax, worldMin, worldMax);
+    });
+    TickGraph::StageId jobs = tickGraph.addStage("Tick_Jobs", [] { g_timeSlicedJobs.runSteps(LOCKSTEP_JOB_STEPS_PER_TICK); });
+    TickGraph::StageId pathfinding = tickGraph.addStage("Tick_Pathfinding", [] { entitiesManager.runDeferredPathfinding(); });
+    TickGraph::StageId damage = tickGraph.addStage("Tick_Damage", [] { processQueuedAttackDamage(entitiesManager); });
+    TickGraph::StageId blockTransformations = tickGraph.addStage("Tick_BlockTransformations", [] {
+        gameMap.updateBlockTransformations(TICK_SECONDS);
+    });
+    tickGraph.precede(entityMovement, entitySensing);
+    tickGraph.precede(entitySensing, jobs);
+    tickGraph.precede(jobs, pathfinding);
+    tickGraph.precede(pathfinding, damage);
+    tickGraph.precede(damage, blockTransformations);
+
+    if (metricsPort > 0) {
+        g_metricsServer.start(metricsPort);
+    }
+
+    PerformanceProfiler::getInstance().setCurrentThreadName("Simulation");
+    PerformanceProfiler::getInstance().reset();
+
+    std::vector<double> tickTimes;
+    tickTimes.reserve(tickCount);
+    for (int tick = 0; tick < tickCount; ++tick) {
+        g_simulationReplay.nextTickInput(); // Advances the lockstep clock
+        tickTimes.push_back(timeMs([&] {
+            PROFILE_SCOPE("Simulation_Tick");
+            tickGraph.run();
+        }));
+    }
+
+    uint64_t worldChecksum = computeWorldChecksum(gameMap, elementsManager, entitiesManager);
+    entitiesManager.shutdownAsyncPathfinding();
+    g_simulationReplay.end();
+    g_metricsServer.stop();
+
+    PerformanceProfiler::getInstance().printReport();
+    tickGraph.printReport();
+    g_timeSlicedJobs.printReport();
+    printFrameArenaReport();
+    if (!tracePath.empty()) {
+        PerformanceProfiler::getInstance().exportChromeTrace(tracePath);
+    }
+
+    std::vector<double> sorted = tickTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double totalMs = 0.0;
+    for (double ms : tickTimes) totalMs += ms;
+
+    std::cout << "World setup" << std::endl;
+    printRow("generate + populate", setupMs);
+    std::cout << "Tick time" << std::endl;
+    printRow("mean", tickTimes.empty() ? 0.0 : totalMs / tickTimes.size());
+    printRow("p50", percentile(sorted, 0.50));
+    printRow("p90", percentile(sorted, 0.90));
+    printRow("p99", percentile(sorted, 0.99));
+    printRow("max", sorted.empty() ? 0.0 : sorted.back());
+    std::cout << "  simulated " << seconds << " s in " << std::fixed << std::setprecision(1) << totalMs / 1000.0
+              << " s (" << std::setprecision(1) << (totalMs > 0.0 ? seconds * 1000.0 / totalMs : 0.0) << "x real time)" << std::endl;
+    std::cout << "World checksum after " << tickCount << " ticks: " << std::hex << std::setw(16) << std::setfill('0')
+              << worldChecksum << std::dec << std::endl;
+
+    return EXIT_SUCCESS;
+}
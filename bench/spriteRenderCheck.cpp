@@ -0,0 +1,220 @@
+// Sprite renderer check
+// Draws the same seeded set of placed elements with the immediate-mode quads (USE_INSTANCED_SPRITES
+// off) and with the instanced sprite renderer into an offscreen framebuffer, compares the two
+// images pixel by pixel and times both paths. Meant for a software context: build with
+// -DGLFW_USE_OSMESA=ON (Mesa llvmpipe) to run it without a display.
+//   - scene 1 has no rotated sprite and must match exactly (the check fails otherwise)
+//   - scene 2 rotates one sprite in five; nearest sampling may pick the neighbouring texel on a
+//     few pixels there (the shader and the fixed-function pipeline round differently), so it is
+//     allowed up to MAX_ROTATED_MISMATCH_SHARE of the pixels
+// Usage: bench_sprite_check [--sprites N] [--frames F] [--seed S] [--dump prefix]
+//   --dump writes prefix_reference_N.ppm and prefix_instanced_N.ppm for each scene
+
+#include "../src/elementsOnMap.h"
+#include "../src/globals.h"
+#include "../src/visibleSet.h"
+#include "glbasimac/glbi_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#define ChangeDir _chdir
+#else
+#include <unistd.h>
+#define ChangeDir chdir
+#endif
+
+// Symbols normally defined by main.cpp (referenced by the menu/input code in the core library)
+bool gameplayActive = false;
+glbasimac::GLBI_Engine myEngine;
+bool startGameplay(glbasimac::GLBI_Engine&, GLFWwindow*) { return false; }
+void endGameplay() {}
+
+namespace {
+
+const int IMAGE_WIDTH = 900;
+const int IMAGE_HEIGHT = 700;
+const double MAX_ROTATED_MISMATCH_SHARE = 0.0001;
+
+struct SceneResult {
+    size_t mismatchedPixels = 0;
+    int maxChannelDifference = 0;
+    double immediateMs = 0.0;
+    double instancedMs = 0.0;
+};
+
+void placeSprites(int count, unsigned int seed, bool rotated) {
+    elementsManager.removeAllElementsByCategory("check_sprite_");
+
+    const ElementName types[] = {ElementName::COCONUT_TREE_1, ElementName::COCONUT_TREE_2, ElementName::COCONUT_TREE_3,
+                                 ElementName::CHARACTER1, ElementName::PIRATE_MAN, ElementName::PIRATE_WOMAN,
+                                 ElementName::SHARK, ElementName::GIRAFFE, ElementName::ARMADILLO,
+                                 ElementName::TEST, ElementName::COCONUT};
+    const AnchorPoint anchors[] = {AnchorPoint::USE_TEXTURE_DEFAULT, AnchorPoint::CENTER, AnchorPoint::TOP_LEFT_CORNER,
+                                   AnchorPoint::BOTTOM_RIGHT_CORNER, AnchorPoint::BOTTOM_CENTER,
+                                   AnchorPoint::TOP_RIGHT_CORNER, AnchorPoint::BOTTOM_LEFT_CORNER};
+    const int typeCount = sizeof(types) / sizeof(types[0]);
+    const int anchorCount = sizeof(anchors) / sizeof(anchors[0]);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coordinate(0.0f, 20.0f);
+    for (int i = 0; i < count; ++i) {
+        float x = coordinate(rng);
+        float y = coordinate(rng);
+        float rotation = (rotated && i % 5 == 0) ? static_cast<float>(i * 7 % 360) : 0.0f;
+        // Spritesheet phase/frame and anchor offsets vary too (ignored by static textures)
+        elementsManager.placeElement("check_sprite_" + std::to_string(i), types[i % typeCount], 0.5f + (i % 4) * 0.4f,
+                                     x, y, rotation, i % 3, i % 4, false, 10.0f, anchors[i % anchorCount],
+                                     (i % 3) * 0.1f, (i % 2) * 0.05f);
+    }
+}
+
+double drawFrames(int frames) {
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        g_visibleSet.update(-0.9f, 0.95f, -0.8f, 0.9f, CameraView{2.3f, 17.9f, 1.1f, 16.4f});
+        elementsManager.collectVisibleElements(g_visibleSet);
+        elementsManager.drawElements(g_visibleSet, 0.0);
+    }
+    glFinish();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+}
+
+std::vector<unsigned char> renderImage(bool instanced) {
+    USE_INSTANCED_SPRITES = instanced;
+    drawFrames(1);
+    std::vector<unsigned char> pixels(static_cast<size_t>(IMAGE_WIDTH) * IMAGE_HEIGHT * 4);
+    glReadPixels(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return pixels;
+}
+
+void writePpm(const std::string& path, const std::vector<unsigned char>& pixels) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Cannot write " << path << std::endl;
+        return;
+    }
+    std::fprintf(file, "P6 %d %d 255\n", IMAGE_WIDTH, IMAGE_HEIGHT);
+    for (int row = IMAGE_HEIGHT - 1; row >= 0; --row) { // glReadPixels starts at the bottom row
+        for (int column = 0; column < IMAGE_WIDTH; ++column) {
+            std::fwrite(&pixels[(static_cast<size_t>(row) * IMAGE_WIDTH + column) * 4], 1, 3, file);
+        }
+    }
+    std::fclose(file);
+}
+
+SceneResult runScene(int sceneIndex, int sprites, int frames, unsigned int seed, bool rotated, const std::string& dumpPrefix) {
+    placeSprites(sprites, seed, rotated);
+
+    SceneResult result;
+    std::vector<unsigned char> reference = renderImage(false);
+    std::vector<unsigned char> instanced = renderImage(true);
+    for (size_t pixel = 0; pixel < reference.size() / 4; ++pixel) {
+        int difference = 0;
+        for (int channel = 0; channel < 4; ++channel) {
+            difference = std::max(difference, std::abs(reference[pixel * 4 + channel] - instanced[pixel * 4 + channel]));
+        }
+        if (difference > 0) {
+            result.mismatchedPixels++;
+            result.maxChannelDifference = std::max(result.maxChannelDifference, difference);
+        }
+    }
+    if (!dumpPrefix.empty()) {
+        writePpm(dumpPrefix + "_reference_" + std::to_string(sceneIndex) + ".ppm", reference);
+        writePpm(dumpPrefix + "_instanced_" + std::to_string(sceneIndex) + ".ppm", instanced);
+    }
+
+    USE_INSTANCED_SPRITES = false;
+    result.immediateMs = drawFrames(frames);
+    USE_INSTANCED_SPRITES = true;
+    result.instancedMs = drawFrames(frames);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int sprites = 400;
+    int frames = 200;
+    unsigned int seed = 3;
+    std::string dumpPrefix;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--sprites") == 0) {
+            sprites = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--frames") == 0) {
+            frames = std::max(1, std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--dump") == 0) {
+            dumpPrefix = std::filesystem::absolute(argv[i + 1]).string();
+        }
+    }
+
+    if (!glfwInit()) {
+        std::cerr << "Cannot initialize GLFW" << std::endl;
+        return EXIT_FAILURE;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(IMAGE_WIDTH, IMAGE_HEIGHT, "Sprite check", nullptr, nullptr);
+    if (!window) {
+        std::cerr << "Cannot create an OpenGL context" << std::endl;
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Cannot load the OpenGL functions" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << " (" << glGetString(GL_VERSION) << ")" << std::endl;
+
+    // Offscreen target: a hidden window has no reliable default framebuffer contents
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, IMAGE_WIDTH, IMAGE_HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glViewport(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+    glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+
+    // Asset paths are relative to src/ (like running the game from the build output directory)
+    if (ChangeDir(SORBETCOCO_ASSET_ROOT_DIR) != 0) {
+        std::cerr << "Cannot enter asset root directory: " << SORBETCOCO_ASSET_ROOT_DIR << std::endl;
+        return EXIT_FAILURE;
+    }
+    elementsManager.init(myEngine);
+
+    bool passed = true;
+    for (int scene = 1; scene <= 2; ++scene) {
+        bool rotated = scene == 2;
+        SceneResult result = runScene(scene, sprites, frames, seed, rotated, dumpPrefix);
+        double share = static_cast<double>(result.mismatchedPixels) / (IMAGE_WIDTH * IMAGE_HEIGHT);
+        bool scenePassed = rotated ? share <= MAX_ROTATED_MISMATCH_SHARE : result.mismatchedPixels == 0;
+        passed = passed && scenePassed;
+
+        std::cout << "Scene " << scene << (rotated ? " (rotated sprites)" : " (no rotation)") << ": "
+                  << result.mismatchedPixels << " mismatched pixels (max channel difference "
+                  << result.maxChannelDifference << ") - " << (scenePassed ? "OK" : "FAILED") << std::endl;
+        std::cout << "  immediate mode: " << result.immediateMs << " ms/frame, instanced: " << result.instancedMs
+                  << " ms/frame" << std::endl;
+    }
+
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
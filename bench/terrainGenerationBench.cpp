@@ -0,0 +1,312 @@
+// Terrain generation timing benchmark
+// Times the flat-buffer generator against a copy of the previous nested-vector / BFS generator
+// (kept below as the reference), checks that both produce the same map for several seeds, and
+// times the bulk grid loader against Map::placeBlocks, at the in-game size and two large sizes.
+// Usage: bench_terrain [--full]   (--full also runs the legacy paths at 4096x4096)
+
+#include "../src/terrainGeneration.h"
+#include "../src/map.h"
+#include "../src/globals.h"
+#include "glbasimac/glbi_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <queue>
+#include <random>
+#include <vector>
+
+// Symbols normally defined by main.cpp (referenced by the menu/input code in the core library)
+bool gameplayActive = false;
+glbasimac::GLBI_Engine myEngine;
+bool startGameplay(glbasimac::GLBI_Engine&, GLFWwindow*) { return false; }
+void endGameplay() {}
+
+namespace {
+
+const unsigned int BENCH_SEED = 12345;
+
+template <typename Func>
+double timeMs(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Extra seeds the new generator is checked against the reference for, at the in-game size
+const unsigned int EXTRA_CHECK_SEEDS[] = {1, 7, 2024, 987654321};
+
+const float WATER_THRESHOLD = 0.55f;
+const float GRASS_THRESHOLD = 0.65f;
+
+// ---- Reference generator: the generateTerrain implementation before the flat-grid rewrite ----
+// Kept verbatim apart from owning its noise grid (no thread_local cache), so every call draws
+// fresh base noise from TERRAIN_RNG exactly like the old game did after resetTerrainGeneration().
+
+float legacyBilinearInterpolate(float x00, float x10, float x01, float x11, float tx, float ty) {
+    float u = 1.0f - tx;
+    float v = 1.0f - ty;
+    return u * v * x00 + tx * v * x10 + u * ty * x01 + tx * ty * x11;
+}
+
+float legacyInterpolatedNoise(const std::vector<std::vector<float>>& noiseGrid, float normX, float normY) {
+    const int noiseWidth = static_cast<int>(noiseGrid[0].size());
+    const int noiseHeight = static_cast<int>(noiseGrid.size());
+
+    float x = normX * (noiseWidth - 1);
+    float y = normY * (noiseHeight - 1);
+
+    int x0 = static_cast<int>(x);
+    int y0 = static_cast<int>(y);
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+
+    x0 = std::max(0, std::min(x0, noiseWidth - 1));
+    y0 = std::max(0, std::min(y0, noiseHeight - 1));
+    x1 = std::max(0, std::min(x1, noiseWidth - 1));
+    y1 = std::max(0, std::min(y1, noiseHeight - 1));
+
+    float tx = x - static_cast<float>(x0);
+    float ty = y - static_cast<float>(y0);
+
+    return legacyBilinearInterpolate(
+        noiseGrid[y0][x0], noiseGrid[y0][x1],
+        noiseGrid[y1][x0], noiseGrid[y1][x1],
+        tx, ty
+    );
+}
+
+std::map<std::pair<int, int>, BlockName> legacyGenerateTerrain(
+    int gridWidth, int gridHeight,
+    float islandFeatureSize, float seaFeatureSize,
+    float waterThreshold, float grassThreshold) {
+
+    std::map<std::pair<int, int>, BlockName> generatedBlocks;
+    if (DEBUG_MAP) {
+        int midPoint = gridHeight / 2;
+        for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+            for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+                generatedBlocks[{x_coord, y_coord}] = (y_coord >= midPoint) ? BlockName::WATER_4 : BlockName::GRASS_2;
+            }
+        }
+        return generatedBlocks;
+    }
+
+    float noiseFeatureSize = islandFeatureSize / seaFeatureSize;
+    int noiseWidth = static_cast<int>(gridWidth / noiseFeatureSize);
+    if (noiseWidth == 0) noiseWidth = 1;
+    int noiseHeight = static_cast<int>(gridHeight / noiseFeatureSize);
+    if (noiseHeight == 0) noiseHeight = 1;
+
+    std::vector<std::vector<float>> noiseGrid(noiseHeight, std::vector<float>(noiseWidth));
+    for (int y = 0; y < noiseHeight; ++y) {
+        for (int x = 0; x < noiseWidth; ++x) {
+            std::uniform_real_distribution<float> noiseDist(0.0f, 1.0f);
+            noiseGrid[y][x] = noiseDist(TERRAIN_RNG);
+        }
+    }
+
+    std::vector<std::vector<BlockName>> grid(gridHeight, std::vector<BlockName>(gridWidth));
+
+    // 1. Initial terrain generation based on noise
+    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+            float noiseValue = legacyInterpolatedNoise(
+                noiseGrid,
+                static_cast<float>(x_coord) / gridWidth,
+                static_cast<float>(y_coord) / gridHeight
+            );
+
+            if (noiseValue < waterThreshold) {
+                grid[y_coord][x_coord] = BlockName::WATER_0;
+            } else if (noiseValue < grassThreshold) {
+                grid[y_coord][x_coord] = BlockName::SAND;
+            } else {
+                grid[y_coord][x_coord] = BlockName::GRASS_0;
+            }
+        }
+    }
+
+    // 2. BFS to calculate distances to sand
+    std::vector<std::vector<int>> distanceToSand(gridHeight, std::vector<int>(gridWidth, std::numeric_limits<int>::max()));
+    std::queue<std::pair<int, int>> bfsQueue;
+
+    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+            if (grid[y_coord][x_coord] == BlockName::SAND) {
+                distanceToSand[y_coord][x_coord] = 0;
+                bfsQueue.push({x_coord, y_coord});
+            }
+        }
+    }
+
+    int dx[] = {0, 0, 1, -1};
+    int dy[] = {1, -1, 0, 0};
+
+    while (!bfsQueue.empty()) {
+        std::pair<int, int> curr = bfsQueue.front();
+        bfsQueue.pop();
+        int cx = curr.first;
+        int cy = curr.second;
+
+        for (int i = 0; i < 4; ++i) {
+            int nx = cx + dx[i];
+            int ny = cy + dy[i];
+
+            if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight) {
+                if (distanceToSand[ny][nx] == std::numeric_limits<int>::max()) {
+                    distanceToSand[ny][nx] = distanceToSand[cy][cx] + 1;
+                    bfsQueue.push({nx, ny});
+                }
+            }
+        }
+    }
+
+    // 3. Assign final water textures based on distance
+    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+            if (grid[y_coord][x_coord] != BlockName::SAND && grid[y_coord][x_coord] != BlockName::GRASS_0) {
+                int dist = distanceToSand[y_coord][x_coord];
+
+                if (dist == 1) {
+                    grid[y_coord][x_coord] = BlockName::WATER_0;
+                } else if (dist == 2) {
+                    grid[y_coord][x_coord] = BlockName::WATER_1;
+                } else if (dist == 3) {
+                    grid[y_coord][x_coord] = BlockName::WATER_2;
+                } else if (dist == 4) {
+                    grid[y_coord][x_coord] = BlockName::WATER_3;
+                } else if (dist >= 5) {
+                    grid[y_coord][x_coord] = BlockName::WATER_4;
+                }
+            }
+        }
+    }
+
+    // 3b. Assign final grass textures based on distance to sand
+    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+            if (grid[y_coord][x_coord] == BlockName::GRASS_0) {
+                int dist = distanceToSand[y_coord][x_coord];
+
+                if (dist == 1) {
+                    grid[y_coord][x_coord] = BlockName::GRASS_0;
+                } else if (dist == 2) {
+                    grid[y_coord][x_coord] = BlockName::GRASS_1;
+                } else if (dist >= 3) {
+                    grid[y_coord][x_coord] = BlockName::GRASS_2;
+                }
+            }
+        }
+    }
+
+    // 4. Convert grid to map for return
+    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+            generatedBlocks[{x_coord, y_coord}] = grid[y_coord][x_coord];
+        }
+    }
+
+    return generatedBlocks;
+}
+
+// ---- End of the reference generator ----
+
+// New generator with fresh base noise: the noise grid is cached per thread by size, so it must be
+// reset or the second call would reuse the first call's noise whatever the seed
+TerrainGrid generateSeeded(int size, unsigned int seed) {
+    resetTerrainGeneration();
+    TERRAIN_RNG.seed(seed);
+    return generateTerrainGrid(size, size, islandFeatureSize, seaFeatureSize, WATER_THRESHOLD, GRASS_THRESHOLD);
+}
+
+std::map<std::pair<int, int>, BlockName> legacySeeded(int size, unsigned int seed) {
+    TERRAIN_RNG.seed(seed);
+    return legacyGenerateTerrain(size, size, islandFeatureSize, seaFeatureSize, WATER_THRESHOLD, GRASS_THRESHOLD);
+}
+
+bool gridMatchesLegacy(const TerrainGrid& grid, const std::map<std::pair<int, int>, BlockName>& legacyMap) {
+    if (legacyMap.size() != grid.blocks.size()) {
+        return false;
+    }
+    for (const auto& entry : legacyMap) {
+        if (grid.at(entry.first.first, entry.first.second) != entry.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void printCheck(const char* label, bool passed) {
+    std::cout << "  " << std::left << std::setw(28) << label << (passed ? "yes" : "NO") << std::endl;
+}
+
+void printRow(const char* label, int size, double ms) {
+    double cells = static_cast<double>(size) * size;
+    std::cout << "  " << std::left << std::setw(28) << label
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+              << std::setw(12) << std::setprecision(1) << (cells / (ms * 1000.0)) << " Mcells/s" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool full = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--full") == 0) {
+            full = true;
+        }
+    }
+
+    const int sizes[] = {170, 1024, 4096};
+    bool allPassed = true;
+
+    for (int size : sizes) {
+        std::cout << size << "x" << size << std::endl;
+        bool runLegacy = full || size < 4096;
+
+        TerrainGrid grid;
+        printRow("generateTerrainGrid", size, timeMs([&] { grid = generateSeeded(size, BENCH_SEED); }));
+
+        bool deterministic = generateSeeded(size, BENCH_SEED).blocks == grid.blocks;
+        printCheck("same seed -> same grid:", deterministic);
+        bool seedSensitive = generateSeeded(size, BENCH_SEED + 1).blocks != grid.blocks;
+        printCheck("other seed -> other grid:", seedSensitive);
+        allPassed = allPassed && deterministic && seedSensitive;
+
+        if (!runLegacy) {
+            std::cout << "  (legacy paths skipped, pass --full)" << std::endl;
+            continue;
+        }
+
+        std::map<std::pair<int, int>, BlockName> legacyMap;
+        printRow("legacy generator", size, timeMs([&] { legacyMap = legacySeeded(size, BENCH_SEED); }));
+
+        bool matches = gridMatchesLegacy(grid, legacyMap);
+        if (size == sizes[0]) {
+            for (unsigned int seed : EXTRA_CHECK_SEEDS) {
+                matches = matches && gridMatchesLegacy(generateSeeded(size, seed), legacySeeded(size, seed));
+            }
+        }
+        allPassed = allPassed && matches;
+        printCheck(size == sizes[0] ? "matches legacy (5 seeds):" : "matches legacy:", matches);
+
+        {
+            Map map;
+            srand(BENCH_SEED);
+            printRow("Map::placeBlockGrid", size, timeMs([&] { map.placeBlockGrid(grid.blocks, grid.width, grid.height); }));
+        }
+        {
+            Map map;
+            srand(BENCH_SEED);
+            printRow("Map::placeBlocks (legacy)", size, timeMs([&] { map.placeBlocks(legacyMap); }));
+        }
+    }
+
+    return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
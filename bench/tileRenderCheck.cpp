@@ -0,0 +1,244 @@
+// Tile renderer check
+// Draws the same seeded block world with the immediate-mode quads (USE_GPU_TILES off) and with the
+// per-chunk tile streams into an offscreen framebuffer, compares the two images pixel by pixel and
+// times both paths. Meant for a software context: build with -DGLFW_USE_OSMESA=ON (Mesa llvmpipe)
+// to run it without a display.
+//   - every comparison draws the CPU quads first (advancing the animation clock), then the tiles
+//     with a zero delta time, so both show the same animation frames; any difference fails
+//   - scene 1: camera on whole cells, block edges fall exactly on pixel centres
+//   - scene 2: scrolled camera, grid rectangle smaller than the window (the per-block cull must
+//     match) and a few blocks replaced between frames (the chunk streams must be rebuilt)
+// Usage: bench_tile_check [--width W] [--height H] [--frames F] [--seed S] [--dump prefix]
+//   --dump writes prefix_reference_N.ppm and prefix_tiles_N.ppm for the last frame of each scene
+
+#include "../src/map.h"
+#include "../src/globals.h"
+#include "../src/visibleSet.h"
+#include "glbasimac/glbi_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#define ChangeDir _chdir
+#else
+#include <unistd.h>
+#define ChangeDir chdir
+#endif
+
+// Symbols normally defined by main.cpp (referenced by the menu/input code in the core library)
+bool gameplayActive = false;
+glbasimac::GLBI_Engine myEngine;
+bool startGameplay(glbasimac::GLBI_Engine&, GLFWwindow*) { return false; }
+void endGameplay() {}
+
+namespace {
+
+const int IMAGE_WIDTH = 900;
+const int IMAGE_HEIGHT = 700;
+const int COMPARED_FRAMES = 6;
+const double ANIMATION_STEP = 0.173; // Seconds between compared frames (several water frames)
+
+struct SceneView {
+    float startX, endX, startY, endY;
+    float cameraLeft, cameraRight, cameraBottom, cameraTop;
+};
+
+struct SceneResult {
+    size_t mismatchedPixels = 0;
+    int maxChannelDifference = 0;
+    double immediateMs = 0.0;
+    double tilesMs = 0.0;
+    size_t tileDrawCalls = 0;
+};
+
+void buildWorld(int width, int height, unsigned int seed) {
+    const BlockName types[] = {BlockName::GRASS_0, BlockName::GRASS_1, BlockName::GRASS_2, BlockName::SAND,
+                               BlockName::WATER_0, BlockName::WATER_1, BlockName::WATER_2, BlockName::WATER_3,
+                               BlockName::WATER_4, BlockName::ICE_1, BlockName::ICE_2, BlockName::ICE_3};
+    const int typeCount = sizeof(types) / sizeof(types[0]);
+
+    std::mt19937 rng(seed);
+    std::vector<BlockName> grid(static_cast<size_t>(width) * height);
+    for (BlockName& name : grid) {
+        name = types[rng() % typeCount];
+    }
+    gameMap.clearBlocks();
+    gameMap.placeBlockGrid(grid, width, height);
+}
+
+void drawBlocks(const SceneView& view, double deltaTime) {
+    VisibleSet visible;
+    visible.update(view.startX, view.endX, view.startY, view.endY,
+                   CameraView{view.cameraLeft, view.cameraRight, view.cameraBottom, view.cameraTop});
+    gameMap.drawBlocks(visible, deltaTime);
+}
+
+std::vector<unsigned char> renderImage(const SceneView& view, bool tiles, double deltaTime) {
+    USE_GPU_TILES = tiles;
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawBlocks(view, deltaTime);
+    std::vector<unsigned char> pixels(static_cast<size_t>(IMAGE_WIDTH) * IMAGE_HEIGHT * 4);
+    glReadPixels(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return pixels;
+}
+
+double drawFrames(const SceneView& view, bool tiles, int frames) {
+    USE_GPU_TILES = tiles;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawBlocks(view, 1.0 / 60.0);
+    }
+    glFinish();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+}
+
+void writePpm(const std::string& path, const std::vector<unsigned char>& pixels) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Cannot write " << path << std::endl;
+        return;
+    }
+    std::fprintf(file, "P6 %d %d 255\n", IMAGE_WIDTH, IMAGE_HEIGHT);
+    for (int row = IMAGE_HEIGHT - 1; row >= 0; --row) { // glReadPixels starts at the bottom row
+        for (int column = 0; column < IMAGE_WIDTH; ++column) {
+            std::fwrite(&pixels[(static_cast<size_t>(row) * IMAGE_WIDTH + column) * 4], 1, 3, file);
+        }
+    }
+    std::fclose(file);
+}
+
+SceneResult runScene(int sceneIndex, const SceneView& view, bool editBlocks, int frames, unsigned int seed, const std::string& dumpPrefix) {
+    SceneResult result;
+    std::mt19937 rng(seed + sceneIndex);
+    for (int frame = 0; frame < COMPARED_FRAMES; ++frame) {
+        if (editBlocks && frame > 0) {
+            // Replace a few visible blocks: their chunks get a new content version
+            for (int i = 0; i < 8; ++i) {
+                int x = static_cast<int>(view.cameraLeft) + static_cast<int>(rng() % 20);
+                int y = static_cast<int>(view.cameraBottom) + static_cast<int>(rng() % 15);
+                gameMap.placeBlock(i % 2 == 0 ? BlockName::WATER_2 : BlockName::GRASS_1, x, y);
+            }
+        }
+
+        std::vector<unsigned char> reference = renderImage(view, false, ANIMATION_STEP);
+        std::vector<unsigned char> tiles = renderImage(view, true, 0.0);
+        for (size_t pixel = 0; pixel < reference.size() / 4; ++pixel) {
+            int difference = 0;
+            for (int channel = 0; channel < 4; ++channel) {
+                difference = std::max(difference, std::abs(reference[pixel * 4 + channel] - tiles[pixel * 4 + channel]));
+            }
+            if (difference > 0) {
+                result.mismatchedPixels++;
+                result.maxChannelDifference = std::max(result.maxChannelDifference, difference);
+            }
+        }
+        if (!dumpPrefix.empty() && frame == COMPARED_FRAMES - 1) {
+            writePpm(dumpPrefix + "_reference_" + std::to_string(sceneIndex) + ".ppm", reference);
+            writePpm(dumpPrefix + "_tiles_" + std::to_string(sceneIndex) + ".ppm", tiles);
+        }
+    }
+
+    result.immediateMs = drawFrames(view, false, frames);
+    result.tilesMs = drawFrames(view, true, frames);
+    result.tileDrawCalls = gameMap.getTileDrawCalls();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int worldWidth = 160;
+    int worldHeight = 120;
+    int frames = 200;
+    unsigned int seed = 5;
+    std::string dumpPrefix;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--width") == 0) {
+            worldWidth = std::max(64, std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--height") == 0) {
+            worldHeight = std::max(64, std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--frames") == 0) {
+            frames = std::max(1, std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--dump") == 0) {
+            dumpPrefix = std::filesystem::absolute(argv[i + 1]).string();
+        }
+    }
+
+    if (!glfwInit()) {
+        std::cerr << "Cannot initialize GLFW" << std::endl;
+        return EXIT_FAILURE;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(IMAGE_WIDTH, IMAGE_HEIGHT, "Tile check", nullptr, nullptr);
+    if (!window) {
+        std::cerr << "Cannot create an OpenGL context" << std::endl;
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Cannot load the OpenGL functions" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << " (" << glGetString(GL_VERSION) << ")" << std::endl;
+
+    // Offscreen target: a hidden window has no reliable default framebuffer contents
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, IMAGE_WIDTH, IMAGE_HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glViewport(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+    glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+
+    // Asset paths are relative to src/ (like running the game from the build output directory)
+    if (ChangeDir(SORBETCOCO_ASSET_ROOT_DIR) != 0) {
+        std::cerr << "Cannot enter asset root directory: " << SORBETCOCO_ASSET_ROOT_DIR << std::endl;
+        return EXIT_FAILURE;
+    }
+    gameMap.init(myEngine);
+    if (!gameMap.isTileRendererReady()) {
+        std::cerr << "The tile renderer could not start on this context" << std::endl;
+        return EXIT_FAILURE;
+    }
+    buildWorld(worldWidth, worldHeight, seed);
+
+    const SceneView views[] = {
+        {-1.0f, 1.0f, -1.0f, 1.0f, 20.0f, 60.0f, 30.0f, 60.0f},
+        {-0.9f, 0.95f, -0.8f, 0.9f, 41.37f, 77.91f, 28.6f, 55.23f},
+    };
+
+    bool passed = true;
+    for (int scene = 1; scene <= 2; ++scene) {
+        SceneResult result = runScene(scene, views[scene - 1], scene == 2, frames, seed, dumpPrefix);
+        bool scenePassed = result.mismatchedPixels == 0;
+        passed = passed && scenePassed;
+
+        std::cout << "Scene " << scene << (scene == 1 ? " (camera on whole cells)" : " (scrolled camera, edited blocks)") << ": "
+                  << result.mismatchedPixels << " mismatched pixels over " << COMPARED_FRAMES << " frames (max channel difference "
+                  << result.maxChannelDifference << ") - " << (scenePassed ? "OK" : "FAILED") << std::endl;
+        std::cout << "  immediate mode: " << result.immediateMs << " ms/frame, tile streams: " << result.tilesMs
+                  << " ms/frame (" << result.tileDrawCalls << " draw calls)" << std::endl;
+    }
+
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -125,10 +125,11 @@ void GameLogic::updateEntities(double deltaTime) {
     
     try {
         // Get camera bounds for view frustum culling
-        float cameraLeft = m_camera->getLeft();
-        float cameraRight = m_camera->getRight();
-        float cameraBottom = m_camera->getBottom();
-        float cameraTop = m_camera->getTop();
+        CameraView cameraView = m_camera->getView();
+        float cameraLeft = cameraView.left;
+        float cameraRight = cameraView.right;
+        float cameraBottom = cameraView.bottom;
+        float cameraTop = cameraView.top;
         
         // Update entity movement and animations with view frustum culling
         m_entitiesManager->update(deltaTime, cameraLeft, cameraRight, cameraBottom, cameraTop);
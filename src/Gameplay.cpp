@@ -12,6 +12,8 @@
 #include "threading.h"
 #include "debug.h"
 #include "crashDebug.h"
+#include "chunkStreaming.h"
+#include "worldSave.h"
 #include <iostream>
 #include <ctime>
 #include <thread>
@@ -78,23 +80,67 @@ bool Gameplay::initialize(glbasimac::GLBI_Engine& engine, GLFWwindow* window) {
 bool Gameplay::initializeMap(glbasimac::GLBI_Engine& engine) {
     std::cout << "Initializing game map..." << std::endl;
     
+    // The element textures decode on the loader workers while the map loads its own
+    elementsManager.prefetchTextures();
+    
     // Initialize our game map
     if (!gameMap.init(engine)) {
         std::cerr << "Failed to initialize map!" << std::endl;
         return false;
     }
     
+    if (g_loadedWorldSave.isOpen()) {
+        // Continue a saved world: the chunks come straight from the save file
+        std::cout << "Loading saved world..." << std::endl;
+        if (g_loadedWorldSave.isStreamedWorld()) {
+            // Start streaming without generating anything, install the saved chunks, then
+            // generate whatever is missing around the player
+            STREAMED_WORLD_SIZE = g_loadedWorldSave.getWorldWidth();
+            startStreamedWorld(gameMap, 0.0f, 0.0f, 0);
+            g_loadedWorldSave.loadBlocks(gameMap);
+            float focusX, focusY;
+            g_loadedWorldSave.getFocusPoint(focusX, focusY);
+            float halfArea = GRID_SIZE / 2.0f;
+            g_chunkStreamer.loadAreaNow(gameMap, focusX - halfArea, focusY - halfArea, focusX + halfArea, focusY + halfArea);
+        } else {
+            WORLD_SIZE = g_loadedWorldSave.getWorldWidth();
+            g_loadedWorldSave.loadBlocks(gameMap);
+        }
+        gameCamera.setGridSize(WORLD_SIZE);
+        
+        std::cout << "Map loading complete." << std::endl;
+        DEBUG_LOG_MEMORY("map_initialization_complete");
+        s_mapInitialized = true;
+        return true;
+    }
+    
+    if (ENABLE_WORLD_STREAMING) {
+        // Large world generated chunk by chunk around the camera; only the spawn area
+        // (same size as the regular map) is generated up front
+        std::cout << "Starting streamed world (" << STREAMED_WORLD_SIZE << "x" << STREAMED_WORLD_SIZE << ")..." << std::endl;
+        startStreamedWorld(gameMap, STREAMED_WORLD_SIZE / 2.0f, STREAMED_WORLD_SIZE / 2.0f, GRID_SIZE);
+        gameCamera.setGridSize(WORLD_SIZE);
+        
+        std::cout << "Map generation complete." << std::endl;
+        DEBUG_LOG_MEMORY("map_initialization_complete");
+        s_mapInitialized = true;
+        return true;
+    }
+    
+    WORLD_SIZE = GRID_SIZE;
+    gameCamera.setGridSize(WORLD_SIZE);
+    
     // Generate the terrain first - this will be our base map
     std::cout << "Generating terrain..." << std::endl;
-    std::map<std::pair<int, int>, BlockName> generatedMap = generateTerrain(
+    TerrainGrid generatedTerrain = generateTerrainGrid(
         GRID_SIZE, GRID_SIZE, islandFeatureSize, seaFeatureSize, 0.55f, 0.65f
     );
     
-    std::cout << "DEBUG: Generated terrain map has " << generatedMap.size() << " blocks" << std::endl;
+    std::cout << "DEBUG: Generated terrain grid has " << generatedTerrain.blocks.size() << " blocks" << std::endl;
     
-    // Apply the generated terrain - this is more efficient than placing blocks and then overwriting them
+    // Apply the generated terrain - bulk-loaded straight from the flat grid
     std::cout << "Placing generated terrain..." << std::endl;
-    gameMap.placeBlocks(generatedMap);
+    gameMap.placeBlockGrid(generatedTerrain.blocks, generatedTerrain.width, generatedTerrain.height);
     
     std::cout << "Map generation complete." << std::endl;
     DEBUG_LOG_MEMORY("map_initialization_complete");
@@ -138,12 +184,18 @@ bool Gameplay::initializeElements(glbasimac::GLBI_Engine& engine) {
               << defaultBlockCount << " default blocks out of " << verifyCount << " tested" << std::endl;
     
     // Also verify map internal state
-    std::cout << "DEBUG: Map internal state - blockPositionMap size: " << gameMap.getBlockPositionMapSize() 
-              << ", blocks vector size: " << gameMap.getBlocksVectorSize() << std::endl;
+    std::cout << "DEBUG: Map internal state - block count: " << gameMap.getBlockCount() 
+              << ", resident chunks: " << gameMap.getResidentChunkCount() << std::endl;
     
     // Place terrain elements on the map (bushes, decorations, etc.)
     std::cout << "DEBUG: About to place terrain elements - map should be fully populated" << std::endl;
-    placeTerrainElements(elementsManager, gameMap, GRID_SIZE, GRID_SIZE);
+    // (the streamed world only decorates its spawn area, centered in the world)
+    if (g_loadedWorldSave.isOpen()) {
+        g_loadedWorldSave.placeElements(elementsManager);
+    } else {
+        int spawnAreaOrigin = (WORLD_SIZE - GRID_SIZE) / 2;
+        placeTerrainElementsInArea(elementsManager, gameMap, spawnAreaOrigin, spawnAreaOrigin, GRID_SIZE, GRID_SIZE);
+    }
     
     s_elementsInitialized = true;
     std::cout << "Elements manager initialized." << std::endl;
@@ -172,13 +224,21 @@ bool Gameplay::initializeEntityConfigurations() {
 bool Gameplay::placeInitialEntities() {
     std::cout << "Placing initial entities..." << std::endl;
     
-    // Place sharks
-    entitiesManager.placeEntityByTypeSafely("shark1", EntityName::SHARK, 42.0f, 31.0f);
-    entitiesManager.placeEntityByTypeSafely("shark2", EntityName::SHARK, 41.0f, 31.0f);
+    if (g_loadedWorldSave.isOpen()) {
+        // Saved entities go back where they were (their state is restored after the movement reset)
+        g_loadedWorldSave.placeEntities(entitiesManager, elementsManager);
+        DEBUG_LOG_MEMORY("entities_placed");
+        return true;
+    }
+    
+    // Place sharks (relative to the spawn area, which is the whole map unless streaming)
+    float spawnAreaOrigin = static_cast<float>((WORLD_SIZE - GRID_SIZE) / 2);
+    entitiesManager.placeEntityByTypeSafely("shark1", EntityName::SHARK, spawnAreaOrigin + 42.0f, spawnAreaOrigin + 31.0f);
+    entitiesManager.placeEntityByTypeSafely("shark2", EntityName::SHARK, spawnAreaOrigin + 41.0f, spawnAreaOrigin + 31.0f);
     
     // Place player
-    float centerX = GRID_SIZE / 2.0f;
-    float centerY = GRID_SIZE / 2.0f;
+    float centerX = WORLD_SIZE / 2.0f;
+    float centerY = WORLD_SIZE / 2.0f;
     std::cout << "Placing player at map center: (" << centerX << ", " << centerY << ")" << std::endl;
     entitiesManager.placeEntityByTypeSafely("player1", EntityName::PLAYER, centerX, centerY);
     
@@ -276,6 +336,10 @@ void Gameplay::cleanup() {
             s_threadingInitialized = false;
         }
         
+        // Finish writing any save in progress, then stop chunk generation before the map goes away
+        g_worldSaver.stop();
+        g_chunkStreamer.stop();
+        
         // Shutdown async pathfinding system
         if (s_entitiesInitialized) {
             std::cout << "Shutting down entity async pathfinding..." << std::endl;
@@ -12,6 +12,7 @@
 #include "entitiesStatus.h"
 #include "gameMenus.h"
 #include "threading.h"
+#include "metrics.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -20,9 +21,7 @@
 PlayerMovementManager* g_playerMovementManager = nullptr;
 
 PlayerMovementManager::PlayerMovementManager()
-    : m_running(false)
-    , m_threadStarted(false)
-    , m_paused(false)
+    : m_paused(false)
     , m_gameMap(nullptr)
     , m_elementsManager(nullptr)
     , m_entitiesManager(nullptr)
@@ -40,7 +39,6 @@ PlayerMovementManager::PlayerMovementManager()
 
 PlayerMovementManager::~PlayerMovementManager()
 {
-    stopThread();
 }
 
 bool PlayerMovementManager::initialize(Map* gameMap, ElementsOnMap* elementsManager, EntitiesManager* entitiesManager, Camera* camera)
@@ -71,8 +69,8 @@ bool PlayerMovementManager::initialize(Map* gameMap, ElementsOnMap* elementsMana
             std::cout << "Using player initial position from placement coordinates: (" 
                      << m_playerState.x << ", " << m_playerState.y << ")" << std::endl;
         } else {
-            m_playerState.x = GRID_SIZE / 2.0f;
-            m_playerState.y = GRID_SIZE / 2.0f;
+            m_playerState.x = WORLD_SIZE / 2.0f;
+            m_playerState.y = WORLD_SIZE / 2.0f;
             std::cout << "Using map center as initial player position: (" 
                      << m_playerState.x << ", " << m_playerState.y << ")" << std::endl;
         }
@@ -88,38 +86,6 @@ bool PlayerMovementManager::initialize(Map* gameMap, ElementsOnMap* elementsMana
     return true;
 }
 
-void PlayerMovementManager::startThread()
-{
-    if (m_threadStarted.load()) {
-        std::cout << "Player movement thread already started" << std::endl;
-        return;
-    }
-    
-    m_running.store(true);
-    
-    // Start player movement thread
-    m_movementThread = std::thread(&PlayerMovementManager::playerMovementThread, this);
-    
-    m_threadStarted.store(true);
-    std::cout << "Player movement thread started successfully" << std::endl;
-}
-
-void PlayerMovementManager::stopThread()
-{
-    m_running.store(false);
-    
-    // Wake up the thread if it's waiting
-    m_inputAvailable.notify_all();
-    m_pauseCondition.notify_all();
-    
-    if (m_movementThread.joinable()) {
-        m_movementThread.join();
-    }
-    
-    m_threadStarted.store(false);
-    std::cout << "Player movement thread stopped" << std::endl;
-}
-
 void PlayerMovementManager::setPlayerInput(float moveX, float moveY, bool sprint)
 {
     std::lock_guard<std::mutex> lock(m_inputMutex);
@@ -156,9 +122,6 @@ void PlayerMovementManager::setPlayerInput(float moveX, float moveY, bool sprint
         m_inputQueue.pop();
         m_inputQueue.push(newInput);
     }
-    
-    // Notify the movement thread
-    m_inputAvailable.notify_one();
 }
 
 PlayerMovementManager::PlayerState PlayerMovementManager::getPlayerState() const
@@ -197,77 +160,48 @@ void PlayerMovementManager::syncWithGameState()
     }
 }
 
-void PlayerMovementManager::playerMovementThread()
+void PlayerMovementManager::updateStep(double deltaTime)
 {
-    std::cout << "Player movement thread started with " << PLAYER_UPDATE_FPS << " FPS target" << std::endl;
+    // One 120 Hz step, called by the frame scheduler (see GameThreadManager::startThreads)
+    auto updateStart = std::chrono::high_resolution_clock::now();
     
-    auto lastTime = std::chrono::high_resolution_clock::now();
-    double accumulatedTime = 0.0;
-    
-    while (m_running.load()) {        // Check if paused and wait if necessary
-        std::unique_lock<std::mutex> pauseLock(m_stateMutex);
-        m_pauseCondition.wait(pauseLock, [this] { return !m_paused.load() || !m_running.load(); });
-        pauseLock.unlock();
-        
-        // If we're no longer running after waiting, exit
-        if (!m_running.load()) {
-            break;
-        }
-        
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration<double>(currentTime - lastTime).count();
-        lastTime = currentTime;
-        
-        // Accumulate time for fixed timestep
-        accumulatedTime += elapsed;
-        
-        // Process movement at fixed timestep
-        while (accumulatedTime >= PLAYER_UPDATE_TIMESTEP && m_running.load()) {
-            auto updateStart = std::chrono::high_resolution_clock::now();
-            
-            // Get current input
-            PlayerInput currentInput;
-            {
-                std::lock_guard<std::mutex> lock(m_inputMutex);
-                if (!m_inputQueue.empty()) {
-                    currentInput = m_inputQueue.front();
-                    m_inputQueue.pop();
-                } else {
-                    currentInput = m_currentInput;
-                }
-            }
-              // Process player movement if input is valid
-            if (currentInput.valid) {
-                processPlayerMovement(currentInput, PLAYER_UPDATE_TIMESTEP);
-            }
-              // Update camera at high frequency (120Hz) synchronized with player movement
-            updateCamera(PLAYER_UPDATE_TIMESTEP);
-            
-            // Process win condition timing
-            processWinCondition(PLAYER_UPDATE_TIMESTEP);
-            
-            // Process defeat condition timing
-            processDefeatCondition(PLAYER_UPDATE_TIMESTEP);
-            
-            accumulatedTime -= PLAYER_UPDATE_TIMESTEP;
-            m_movementUpdatesProcessed++;
-            
-            // Track performance
-            auto updateEnd = std::chrono::high_resolution_clock::now();
-            double updateTime = std::chrono::duration<double>(updateEnd - updateStart).count();
-            m_averageUpdateTime.store((m_averageUpdateTime.load() * 0.9) + (updateTime * 0.1)); // Rolling average
-        }
-        
-        // Sleep for a short time to prevent 100% CPU usage
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
-          // Respect pause state
-        {
-            std::unique_lock<std::mutex> lock(m_stateMutex);
-            m_pauseCondition.wait(lock, [this]() { return !m_paused.load() || !m_running.load(); });
+    // Get current input
+    PlayerInput currentInput;
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        if (!m_inputQueue.empty()) {
+            currentInput = m_inputQueue.front();
+            m_inputQueue.pop();
+        } else {
+            currentInput = m_currentInput;
         }
     }
+      // Process player movement if input is valid
+    if (currentInput.valid) {
+        processPlayerMovement(currentInput, deltaTime);
+    }
+      // Update camera at high frequency (120Hz) synchronized with player movement
+    updateCamera(deltaTime);
+    
+    // Process win condition timing
+    processWinCondition(deltaTime);
+    
+    // Process defeat condition timing
+    processDefeatCondition(deltaTime);
     
-    std::cout << "Player movement thread ended. Processed " << m_movementUpdatesProcessed.load() << " updates" << std::endl;
+    m_movementUpdatesProcessed++;
+    
+    // Track performance
+    auto updateEnd = std::chrono::high_resolution_clock::now();
+    double updateTime = std::chrono::duration<double>(updateEnd - updateStart).count();
+    m_averageUpdateTime.store((m_averageUpdateTime.load() * 0.9) + (updateTime * 0.1)); // Rolling average
+    
+    static MetricGauge& averageUpdateMetric = MetricsRegistry::getInstance().gauge("sorbetcoco_player_update_seconds",
+        "Rolling average of one player movement update");
+    static MetricHistogram& updateMetric = MetricsRegistry::getInstance().histogram("sorbetcoco_player_update_duration_seconds",
+        "Duration of one player movement update", {0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.002, 0.004, 0.008});
+    averageUpdateMetric.set(m_averageUpdateTime.load());
+    updateMetric.observe(updateTime);
 }
 
 void PlayerMovementManager::processPlayerMovement(const PlayerInput& input, double deltaTime)
@@ -711,7 +645,6 @@ void PlayerMovementManager::resumeMovement()
         m_currentInput = clearInput;
     }
     
-    m_pauseCondition.notify_all();
     std::cout << "Player movement resumed" << std::endl;
 }
 
@@ -727,20 +660,6 @@ bool initializePlayerMovement(Map* gameMap, ElementsOnMap* elementsManager, Enti
     return g_playerMovementManager->initialize(gameMap, elementsManager, entitiesManager, camera);
 }
 
-void startPlayerMovementThread()
-{
-    if (g_playerMovementManager != nullptr) {
-        g_playerMovementManager->startThread();
-    }
-}
-
-void stopPlayerMovementThread()
-{
-    if (g_playerMovementManager != nullptr) {
-        g_playerMovementManager->stopThread();
-    }
-}
-
 void cleanupPlayerMovement()
 {
     if (g_playerMovementManager != nullptr) {
@@ -1,9 +1,7 @@
 #ifndef PLAYER_MOVEMENT_MANAGER_H
 #define PLAYER_MOVEMENT_MANAGER_H
 
-#include <thread>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <chrono>
 #include <queue>
@@ -16,7 +14,7 @@ class EntitiesManager;
 class Camera;
 
 /**
- * PlayerMovementManager handles player movement in a separate thread
+ * PlayerMovementManager handles player movement on its own 120 Hz scheduler loop
  * to ensure responsive controls independent of entity processing lag
  */
 class PlayerMovementManager {
@@ -43,11 +41,8 @@ public:
     ~PlayerMovementManager();    // Initialize the player movement system
     bool initialize(Map* gameMap, ElementsOnMap* elementsManager, EntitiesManager* entitiesManager, Camera* camera);
 
-    // Start the player movement thread
-    void startThread();
-
-    // Stop the player movement thread
-    void stopThread();
+    // One fixed 120 Hz step: input, movement, camera, win/defeat timers (called by the frame scheduler)
+    void updateStep(double deltaTime);
 
     // Pause/Resume functionality
     void pauseMovement();
@@ -61,8 +56,7 @@ public:
     PlayerState getPlayerState() const;
 
     // Sync player position with main game state (called from game logic thread)
-    void syncWithGameState();    // Check if the system is running
-    bool isRunning() const { return m_running.load(); }
+    void syncWithGameState();
       // Trigger defeat condition externally (e.g., when player is destroyed)
     void triggerDefeatCondition();
     
@@ -70,8 +64,7 @@ public:
     void resetGameConditions();
 
 private:
-    // Player movement thread function
-    void playerMovementThread();    // Process player movement with collision detection
+    // Process player movement with collision detection
     void processPlayerMovement(const PlayerInput& input, double deltaTime);
 
     // Update camera based on player position
@@ -89,17 +82,12 @@ private:
     // Process defeat condition timing
     void processDefeatCondition(double deltaTime);
 
-    // Threading objects
-    std::thread m_movementThread;
-    std::atomic<bool> m_running;
-    std::atomic<bool> m_threadStarted;
+    // Pause state (input is ignored while paused)
     std::atomic<bool> m_paused;
 
     // Synchronization
     mutable std::mutex m_inputMutex;
     mutable std::mutex m_stateMutex;
-    std::condition_variable m_inputAvailable;
-    std::condition_variable m_pauseCondition;
 
     // Game objects (not owned)
     Map* m_gameMap;
@@ -140,8 +128,6 @@ extern PlayerMovementManager* g_playerMovementManager;
 
 // Convenience functions
 bool initializePlayerMovement(Map* gameMap, ElementsOnMap* elementsManager, EntitiesManager* entitiesManager, Camera* camera);
-void startPlayerMovementThread();
-void stopPlayerMovementThread();
 void cleanupPlayerMovement();
 
 #endif // PLAYER_MOVEMENT_MANAGER_H
@@ -0,0 +1,169 @@
+#include "assetPack.h"
+#include "gameLog.h"
+#include "globals.h"
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+long long writeTimeOf(const std::filesystem::path& path, std::error_code& error) {
+    return static_cast<long long>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+}
+
+} // namespace
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& packPath) {
+    std::error_code error;
+    if (!std::filesystem::exists(packPath, error)) {
+        GAME_LOG_INFO("No asset pack at " << packPath << ", textures load from the PNG files");
+        return false;
+    }
+    packWriteTime = writeTimeOf(packPath, error);
+
+    // Map the whole file read-only: the payloads are uploaded straight from the mapping
+#ifdef _WIN32
+    HANDLE file = CreateFileA(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        GAME_LOG_WARN("Cannot open asset pack " << packPath);
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+    if (!view) {
+        GAME_LOG_WARN("Cannot map asset pack " << packPath);
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+    mappedData = static_cast<const unsigned char*>(view);
+#else
+    int descriptor = ::open(packPath.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        GAME_LOG_WARN("Cannot open asset pack " << packPath);
+        return false;
+    }
+    struct stat fileStat;
+    void* view = MAP_FAILED;
+    if (fstat(descriptor, &fileStat) == 0 && fileStat.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    if (view == MAP_FAILED) {
+        GAME_LOG_WARN("Cannot map asset pack " << packPath);
+        ::close(descriptor);
+        return false;
+    }
+    fileDescriptor = descriptor;
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+    mappedData = static_cast<const unsigned char*>(view);
+#endif
+
+    // Validate the header and every entry once, lookups then trust the table
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(mappedData);
+    if (mappedSize < sizeof(AssetPackHeader) || std::memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0 ||
+        header->version != ASSET_PACK_VERSION) {
+        GAME_LOG_WARN("Asset pack " << packPath << " has an unknown format, textures load from the PNG files (rebuild it with the asset_pack target)");
+        close();
+        return false;
+    }
+    const uint64_t tableEnd = sizeof(AssetPackHeader) + static_cast<uint64_t>(header->entryCount) * sizeof(AssetPackEntry);
+    if (tableEnd > mappedSize || header->stringsOffset + header->stringsSize > mappedSize) {
+        GAME_LOG_WARN("Asset pack " << packPath << " is truncated, textures load from the PNG files");
+        close();
+        return false;
+    }
+    const AssetPackEntry* table = reinterpret_cast<const AssetPackEntry*>(mappedData + sizeof(AssetPackHeader));
+    const char* strings = reinterpret_cast<const char*>(mappedData + header->stringsOffset);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetPackEntry& entry = table[i];
+        const uint64_t expectedSize = static_cast<uint64_t>(entry.width) * entry.height * entry.channels;
+        if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > header->stringsSize ||
+            entry.payloadOffset + entry.payloadSize > mappedSize ||
+            entry.compression != ASSET_PACK_RAW || entry.payloadSize != expectedSize) {
+            GAME_LOG_WARN("Asset pack entry " << i << " is invalid, skipped");
+            continue;
+        }
+        entries[std::string(strings + entry.pathOffset, entry.pathLength)] = &entry;
+    }
+    GAME_LOG_INFO("Asset pack " << packPath << " mapped: " << entries.size() << " textures, " << mappedSize / 1024 << " KiB");
+    return true;
+}
+
+void AssetPack::close() {
+    entries.clear();
+    if (!mappedData) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mappedData);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(mappedData), mappedSize);
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+bool AssetPack::findTexture(const std::string& path, PackedTexture& texture) {
+    if (!USE_ASSET_PACK) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!openAttempted) {
+        openAttempted = true;
+        open(ASSET_PACK_PATH);
+    }
+    auto it = entries.find(path);
+    if (it == entries.end()) {
+        return false;
+    }
+    const AssetPackEntry& entry = *it->second;
+
+    // Development: a PNG edited after packing is loaded from the file (a deployment may ship
+    // the pack without the PNGs, nothing to check then)
+    std::error_code error;
+    uintmax_t sourceSize = std::filesystem::file_size(path, error);
+    if (!error) {
+        long long sourceWriteTime = writeTimeOf(path, error);
+        if (sourceSize != entry.sourceSize || (!error && sourceWriteTime > packWriteTime)) {
+            GAME_LOG_INFO("Texture " << path << " changed since the asset pack was built, loading the PNG file");
+            return false;
+        }
+    }
+
+    texture.pixels = mappedData + entry.payloadOffset;
+    texture.width = static_cast<int>(entry.width);
+    texture.height = static_cast<int>(entry.height);
+    texture.channels = static_cast<int>(entry.channels);
+    return true;
+}
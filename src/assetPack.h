@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Preprocessed texture pack: every PNG of assets/textures decoded once, offline, by the
+// sorbetcoco_asset_packer tool (CMake target asset_pack), and stored as raw pixels in a single
+// file. At startup the pack is memory-mapped and TextureLoader uploads straight from the mapping,
+// no PNG decoding at all.
+//  - the pixels are exactly what the loaders got from stb_image: flipped vertically, the channel
+//    count of the source image (1, 3 or 4), rows tightly packed
+//  - keys are the paths the game asks for ("../assets/textures/blocks/grass0.png"), so the tables
+//    in map.cpp, elementsOnMap.cpp and gameMenus.cpp do not change
+//  - no pack (or USE_ASSET_PACK off) and textures missing from the pack load from the loose files;
+//    a loose file edited after packing (other size, or newer than the pack) also wins, so
+//    development never needs the packer
+// Layout (little-endian): AssetPackHeader, entryCount AssetPackEntry records, the path strings,
+// then the payloads, each aligned to ASSET_PACK_PAYLOAD_ALIGNMENT bytes.
+
+const char ASSET_PACK_MAGIC[8] = {'S', 'C', 'P', 'A', 'C', 'K', '0', '1'};
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint64_t ASSET_PACK_PAYLOAD_ALIGNMENT = 16;
+
+// Payload encoding. Only raw pixels for now (no compression library in third_party); the field
+// lets a compressed encoding be added without changing the layout.
+enum AssetPackCompression : uint32_t {
+    ASSET_PACK_RAW = 0,
+};
+
+struct AssetPackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct AssetPackEntry {
+    uint64_t payloadOffset; // From the start of the file
+    uint64_t payloadSize;
+    uint64_t sourceSize;    // Size of the PNG when it was packed (stale check)
+    uint32_t pathOffset;    // In the string table
+    uint32_t pathLength;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t compression;   // AssetPackCompression
+};
+
+static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader is written as is");
+static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry is written as is");
+
+// A texture found in the pack: pixels point into the mapping (valid until the pack is closed)
+struct PackedTexture {
+    const unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+};
+
+class AssetPack {
+public:
+    static AssetPack& getInstance() {
+        static AssetPack instance;
+        return instance;
+    }
+
+    // Pixels of a packed texture. False when the texture has to come from the loose file: no pack,
+    // USE_ASSET_PACK off, path not packed, or the loose file changed since packing. The pack at
+    // ASSET_PACK_PATH is mapped on the first call. Any thread.
+    bool findTexture(const std::string& path, PackedTexture& texture);
+
+    bool isOpen() const { return mappedData != nullptr; }
+    size_t getTextureCount() const { return entries.size(); }
+
+private:
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& packPath);
+    void close();
+
+    std::mutex mutex;
+    bool openAttempted = false;
+    const unsigned char* mappedData = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+    long long packWriteTime = 0; // std::filesystem::file_time_type ticks of the pack file
+    std::unordered_map<std::string, const AssetPackEntry*> entries;
+};
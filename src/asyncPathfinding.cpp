@@ -4,8 +4,11 @@
 #endif
 
 #include "asyncPathfinding.h"
+#include "gameLog.h"
 #include "map.h"
 #include "crashDebug.h"
+#include "metrics.h"
+#include "readEpoch.h"
 #include <iostream>
 #include <chrono>
 #include "enumDefinitions.h"
@@ -26,7 +29,7 @@ extern std::vector<std::pair<float, float>> findPath(
 
 AsyncEntityPathfinder::AsyncEntityPathfinder(size_t numThreads) 
     : executor(numThreads), nextRequestId(1), isRunning(false), gameMapPtr(nullptr) {
-    std::cout << "AsyncEntityPathfinder initialized with " << numThreads << " threads using Taskflow efficiently" << std::endl;
+    GAME_LOG_INFO("AsyncEntityPathfinder initialized with " << numThreads << " threads using Taskflow efficiently");
 }
 
 AsyncEntityPathfinder::~AsyncEntityPathfinder() {
@@ -37,24 +40,24 @@ void AsyncEntityPathfinder::initialize(const Map* gameMap) {
     std::lock_guard<std::mutex> lock(gameMapMutex);
     DEBUG_VALIDATE_PTR(gameMap);
     if (!gameMap) {
-        std::cerr << "ERROR: AsyncEntityPathfinder::initialize - gameMap cannot be null!" << std::endl;
+        GAME_LOG_ERROR("ERROR: AsyncEntityPathfinder::initialize - gameMap cannot be null!");
         DEBUG_LOG_MEMORY("pathfinder_init_null_map");
         return;
     }
     gameMapPtr = gameMap;
     DEBUG_LOG_MEMORY("pathfinder_initialized");
-    std::cout << "AsyncEntityPathfinder initialized with game map reference" << std::endl;
+    GAME_LOG_INFO("AsyncEntityPathfinder initialized with game map reference");
 }
 
 void AsyncEntityPathfinder::start() {
     std::lock_guard<std::mutex> lock(stateMutex);
     if (!gameMapPtr) {
-        std::cerr << "ERROR: AsyncEntityPathfinder::start - Must call initialize() with game map first!" << std::endl;
+        GAME_LOG_ERROR("ERROR: AsyncEntityPathfinder::start - Must call initialize() with game map first!");
         return;
     }
     if (!isRunning) {
         isRunning = true;
-        std::cout << "AsyncEntityPathfinder started with efficient Taskflow-based processing" << std::endl;
+        GAME_LOG_INFO("AsyncEntityPathfinder started with efficient Taskflow-based processing");
     }
 }
 
@@ -62,7 +65,7 @@ void AsyncEntityPathfinder::stop() {
     std::lock_guard<std::mutex> lock(stateMutex);
     if (isRunning) {
         isRunning = false;
-        std::cout << "AsyncEntityPathfinder: Stopping Taskflow-based processing..." << std::endl;
+        GAME_LOG_INFO("AsyncEntityPathfinder: Stopping Taskflow-based processing...");
         
         // First, mark all active requests as cancelled to prevent new processing
         {
@@ -74,7 +77,7 @@ void AsyncEntityPathfinder::stop() {
         }
         
         // CRASH FIX: Enhanced graceful shutdown with better exception handling
-        std::cout << "Waiting for all async pathfinding tasks to complete..." << std::endl;
+        GAME_LOG_INFO("Waiting for all async pathfinding tasks to complete...");
         
         try {
             // THREAD SAFETY: Use timeout-based waiting to prevent deadlocks
@@ -95,17 +98,17 @@ void AsyncEntityPathfinder::stop() {
                                 // Task not ready, check overall timeout
                                 auto elapsed = std::chrono::steady_clock::now() - startTime;
                                 if (elapsed > maxWaitTime) {
-                                    std::cerr << "WARNING: Task " << taskPair.first << " did not complete within timeout" << std::endl;
+                                    GAME_LOG_WARN("WARNING: Task " << taskPair.first << " did not complete within timeout");
                                     allTasksCompleted = false;
                                     break;
                                 }
                             }
                         }
                     } catch (const std::exception& e) {
-                        std::cerr << "Exception waiting for task " << taskPair.first << ": " << e.what() << std::endl;
+                        GAME_LOG_ERROR("Exception waiting for task " << taskPair.first << ": " << e.what());
                         allTasksCompleted = false;
                     } catch (...) {
-                        std::cerr << "Unknown exception waiting for task " << taskPair.first << std::endl;
+                        GAME_LOG_ERROR("Unknown exception waiting for task " << taskPair.first);
                         allTasksCompleted = false;
                     }
                 }
@@ -116,15 +119,15 @@ void AsyncEntityPathfinder::stop() {
             std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Give threads time to finish
             
             if (allTasksCompleted) {
-                std::cout << "All async pathfinding tasks completed successfully" << std::endl;
+                GAME_LOG_INFO("All async pathfinding tasks completed successfully");
             } else {
-                std::cout << "Some async pathfinding tasks may not have completed cleanly" << std::endl;
+                GAME_LOG_INFO("Some async pathfinding tasks may not have completed cleanly");
             }
             
         } catch (const std::exception& e) {
-            std::cerr << "CRITICAL: Exception during graceful shutdown: " << e.what() << std::endl;
+            GAME_LOG_ERROR("CRITICAL: Exception during graceful shutdown: " << e.what());
         } catch (...) {
-            std::cerr << "CRITICAL: Unknown exception during graceful shutdown!" << std::endl;
+            GAME_LOG_ERROR("CRITICAL: Unknown exception during graceful shutdown!");
         }
         
         // Clean up after all tasks are done (or timeout reached)
@@ -148,12 +151,12 @@ void AsyncEntityPathfinder::stop() {
             }
             
         } catch (const std::exception& e) {
-            std::cerr << "Exception during cleanup: " << e.what() << std::endl;
+            GAME_LOG_ERROR("Exception during cleanup: " << e.what());
         } catch (...) {
-            std::cerr << "Unknown exception during cleanup!" << std::endl;
+            GAME_LOG_ERROR("Unknown exception during cleanup!");
         }
         
-        std::cout << "AsyncEntityPathfinder stopped with enhanced safety measures" << std::endl;
+        GAME_LOG_INFO("AsyncEntityPathfinder stopped with enhanced safety measures");
     }
 }
 
@@ -163,7 +166,7 @@ uint32_t AsyncEntityPathfinder::requestPathfinding(const std::string& entityId,
                                                    const EntityConfiguration& config,
                                                    WalkType walkType) {
     if (!isRunning.load()) {
-        std::cerr << "ERROR: AsyncEntityPathfinder is not running!" << std::endl;
+        GAME_LOG_ERROR("ERROR: AsyncEntityPathfinder is not running!");
         return 0;
     }
     
@@ -171,7 +174,7 @@ uint32_t AsyncEntityPathfinder::requestPathfinding(const std::string& entityId,
     {
         std::lock_guard<std::mutex> lock(gameMapMutex);
         if (!gameMapPtr) {
-            std::cerr << "ERROR: Game map not initialized!" << std::endl;
+            GAME_LOG_ERROR("ERROR: Game map not initialized!");
             return 0;
         }
     }
@@ -205,9 +208,20 @@ uint32_t AsyncEntityPathfinder::requestPathfinding(const std::string& entityId,
                 activeTasks.erase(oldRequestId);
             }
             
-            std::cout << "Cancelling previous pathfinding request for entity " << entityId << std::endl;        }
+            GAME_LOG_INFO("Cancelling previous pathfinding request for entity " << entityId);        }
         activeRequests[entityId] = requestId;
-    }    // Use the proper Taskflow async mechanism - much simpler and more stable
+    }
+    static MetricCounter& requestsMetric = MetricsRegistry::getInstance().counter("sorbetcoco_pathfinding_requests_total",
+        "Async pathfinding requests submitted");
+    requestsMetric.increment();
+    
+    if (deferredSubmission.load()) {
+        std::lock_guard<std::mutex> lock(deferredRequestsMutex);
+        deferredRequests.push_back(std::move(request));
+        return requestId;
+    }
+    
+    // Use the proper Taskflow async mechanism - much simpler and more stable
     // This creates a fire-and-forget async task without complex taskflow management
     try {
         auto future = executor.async([this, request]() {
@@ -220,7 +234,7 @@ uint32_t AsyncEntityPathfinder::requestPathfinding(const std::string& entityId,
             activeTasks[requestId] = std::move(future);
         }
     } catch (const std::exception& e) {
-        std::cerr << "Failed to submit pathfinding task: " << e.what() << std::endl;
+        GAME_LOG_ERROR("Failed to submit pathfinding task: " << e.what());
         
         // Clean up active request if task submission failed
         {
@@ -230,8 +244,8 @@ uint32_t AsyncEntityPathfinder::requestPathfinding(const std::string& entityId,
         return 0;
     }
     
-    std::cout << "Pathfinding task " << requestId << " submitted for entity " << entityId 
-              << " from (" << startX << ", " << startY << ") to (" << endX << ", " << endY << ")" << std::endl;
+    GAME_LOG_INFO("Pathfinding task " << requestId << " submitted for entity " << entityId 
+              << " from (" << startX << ", " << startY << ") to (" << endX << ", " << endY << ")");
     
     return requestId;
 }
@@ -258,7 +272,7 @@ bool AsyncEntityPathfinder::cancelPathfindingRequest(const std::string& entityId
         activeTasks.erase(requestId);
     }
     
-    std::cout << "Cancelled pathfinding request for entity " << entityId << std::endl;
+    GAME_LOG_INFO("Cancelled pathfinding request for entity " << entityId);
     return true;
 }
 
@@ -289,11 +303,30 @@ size_t AsyncEntityPathfinder::getCompletedResultsCount() const {
     return resultQueue.size();
 }
 
+void AsyncEntityPathfinder::setDeferredSubmission(bool deferred) {
+    deferredSubmission.store(deferred);
+}
+
+void AsyncEntityPathfinder::runDeferredRequests() {
+    std::vector<AsyncPathfindingRequest> requests;
+    {
+        std::lock_guard<std::mutex> lock(deferredRequestsMutex);
+        requests.swap(deferredRequests);
+    }
+    // Queued in request order; superseded requests are skipped as cancelled
+    for (AsyncPathfindingRequest& request : requests) {
+        processPathfindingTask(std::move(request));
+    }
+}
+
 // This is the new efficient processing function that handles individual tasks
 void AsyncEntityPathfinder::processPathfindingTask(AsyncPathfindingRequest request) {
+    // The search reads map chunks for as long as it runs (readEpoch.h)
+    ReadEpochGuard mapReadGuard;
+
     // Early safety checks
     if (!isRunning.load()) {
-        std::cout << "Pathfinding request " << request.requestId << " skipped - system shutting down" << std::endl;
+        GAME_LOG_INFO("Pathfinding request " << request.requestId << " skipped - system shutting down");
         return;
     }
     
@@ -302,7 +335,7 @@ void AsyncEntityPathfinder::processPathfindingTask(AsyncPathfindingRequest reque
         std::lock_guard<std::mutex> lock(activeRequestsMutex);
         if (cancelledRequests.find(request.requestId) != cancelledRequests.end()) {
             cancelledRequests.erase(request.requestId);
-            std::cout << "Skipping cancelled pathfinding request " << request.requestId << std::endl;
+            GAME_LOG_INFO("Skipping cancelled pathfinding request " << request.requestId);
             return;
         }
     }
@@ -346,7 +379,7 @@ void AsyncEntityPathfinder::processPathfindingTask(AsyncPathfindingRequest reque
             std::lock_guard<std::mutex> lock(activeRequestsMutex);
             if (cancelledRequests.find(request.requestId) != cancelledRequests.end()) {
                 cancelledRequests.erase(request.requestId);
-                std::cout << "Pathfinding request " << request.requestId << " cancelled after computation" << std::endl;
+                GAME_LOG_INFO("Pathfinding request " << request.requestId << " cancelled after computation");
                 return;
             }
         }
@@ -360,11 +393,11 @@ void AsyncEntityPathfinder::processPathfindingTask(AsyncPathfindingRequest reque
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
         result.computationTimeMs = duration.count() / 1000.0f;
         
-        std::cout << "Pathfinding request " << request.requestId << " completed in " 
-                  << result.computationTimeMs << "ms, path size: " << result.path.size() << std::endl;
+        GAME_LOG_INFO("Pathfinding request " << request.requestId << " completed in " 
+                  << result.computationTimeMs << "ms, path size: " << result.path.size());
         
     } catch (const std::exception& e) {
-        std::cerr << "Pathfinding request " << request.requestId << " failed: " << e.what() << std::endl;
+        GAME_LOG_ERROR("Pathfinding request " << request.requestId << " failed: " << e.what());
         result.success = false;
         result.completed = true;
         result.failed = true;
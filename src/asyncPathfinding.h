@@ -83,6 +83,12 @@ public:
     // Get queue statistics
     size_t getActiveRequestsCount() const;
     size_t getCompletedResultsCount() const;
+    
+    // Deferred mode (lockstep simulation): requests are queued instead of submitted, and
+    // runDeferredRequests() computes them all, in request order, on the calling thread - so the
+    // results never depend on worker timing. The results are picked up like async ones.
+    void setDeferredSubmission(bool deferred);
+    void runDeferredRequests();
 
 private:
     // Taskflow executor for efficient task management
@@ -104,6 +110,11 @@ private:
       // Active tasks - keep futures alive for tracking async tasks
     std::unordered_map<uint32_t, std::future<void>> activeTasks; // requestId -> future
     
+    // Deferred mode: requests waiting for runDeferredRequests()
+    std::atomic<bool> deferredSubmission{false};
+    std::mutex deferredRequestsMutex;
+    std::vector<AsyncPathfindingRequest> deferredRequests;
+    
     // Request ID management
     std::atomic<uint32_t> nextRequestId;
     
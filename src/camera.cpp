@@ -1,6 +1,7 @@
 #include "camera.h"
 #include "globals.h"
 #include <iostream>
+#include <chrono>
 #include <cmath> // For pow()
 #include "enumDefinitions.h"
 
@@ -16,10 +17,7 @@ Camera gameCamera(GRID_SIZE); // Initialize with GRID_SIZE from globals.h
 Camera::Camera(int gridSize) 
     : m_cameraRegion(DEFAULT_CAMERA_REGION), // Use the defined constant
       m_desiredCameraRegion(DEFAULT_CAMERA_REGION), // Initialize desired region to default
-      m_left(0.0f),
-      m_right(0.0f), 
-      m_bottom(0.0f), 
-      m_top(0.0f),
+      m_writerViews{CameraView(), CameraView(), 0.0, 0.0},
       m_gridSize(gridSize),
       m_isTransitioning(false),
       m_transitionStartRegion(0.0f),
@@ -89,6 +87,10 @@ void Camera::setCameraRegionWithWindowClamp(float value) {
     m_cameraRegion = std::min(m_desiredCameraRegion, maxAllowedRegion);
 }
 
+void Camera::setGridSize(int gridSize) {
+    m_gridSize = gridSize;
+}
+
 float Camera::getCameraRegion() const {
     return m_cameraRegion;
 }
@@ -126,9 +128,12 @@ float Camera::getMaxUsableCameraRegion(int windowWidth, int windowHeight) const
 
 void Camera::updateCameraPosition(float playerX, float playerY, int windowWidth, int windowHeight) {
     // Store this as the last known player position
-    m_lastKnownPlayerX = playerX;
-    m_lastKnownPlayerY = playerY;
-    m_hasLastKnownPosition = true;
+    {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        m_lastKnownPlayerX = playerX;
+        m_lastKnownPlayerY = playerY;
+        m_hasLastKnownPosition = true;
+    }
     
     // Calculate adaptive camera view that matches window aspect ratio
     float windowAspectRatio = static_cast<float>(windowWidth) / static_cast<float>(windowHeight);
@@ -179,38 +184,83 @@ void Camera::updateCameraPosition(float playerX, float playerY, int windowWidth,
     float cameraHeight = cameraHalfHeight * 2.0f;
     
     // Center camera on player
-    m_left = playerX - cameraHalfWidth;
-    m_right = playerX + cameraHalfWidth;
-    m_bottom = playerY - cameraHalfHeight;
-    m_top = playerY + cameraHalfHeight;
+    CameraView view;
+    view.left = playerX - cameraHalfWidth;
+    view.right = playerX + cameraHalfWidth;
+    view.bottom = playerY - cameraHalfHeight;
+    view.top = playerY + cameraHalfHeight;
     
     // Ensure the camera doesn't go out of bounds by clamping to map boundaries
-    if (m_left < 0) {
-        m_left = 0;
-        m_right = cameraWidth;
+    if (view.left < 0) {
+        view.left = 0;
+        view.right = cameraWidth;
+    }
+    if (view.right > m_gridSize) {
+        view.right = m_gridSize;
+        view.left = m_gridSize - cameraWidth;
+        if (view.left < 0) view.left = 0; // Additional safety check
     }
-    if (m_right > m_gridSize) {
-        m_right = m_gridSize;
-        m_left = m_gridSize - cameraWidth;
-        if (m_left < 0) m_left = 0; // Additional safety check
+    if (view.bottom < 0) {
+        view.bottom = 0;
+        view.top = cameraHeight;
     }
-    if (m_bottom < 0) {
-        m_bottom = 0;
-        m_top = cameraHeight;
+    if (view.top > m_gridSize) {
+        view.top = m_gridSize;
+        view.bottom = m_gridSize - cameraHeight;
+        if (view.bottom < 0) view.bottom = 0; // Additional safety check
     }
-    if (m_top > m_gridSize) {
-        m_top = m_gridSize;
-        m_bottom = m_gridSize - cameraHeight;
-        if (m_bottom < 0) m_bottom = 0; // Additional safety check
+    publishView(view);
+}
+
+void Camera::publishView(const CameraView& view) {
+    double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    PublishedViews& views = m_writerViews;
+    float movedX = (view.left + view.right) * 0.5f - (views.current.left + views.current.right) * 0.5f;
+    float movedY = (view.bottom + view.top) * 0.5f - (views.current.bottom + views.current.top) * 0.5f;
+    bool jumped = std::abs(movedX) > CAMERA_SNAP_DISTANCE || std::abs(movedY) > CAMERA_SNAP_DISTANCE;
+    if (jumped || now - views.currentTime > CAMERA_INTERPOLATION_MAX_GAP) {
+        // Nothing to interpolate from: both views are the new one
+        views.previous = view;
+        views.previousTime = now;
+    } else {
+        views.previous = views.current;
+        views.previousTime = views.currentTime;
     }
+    views.current = view;
+    views.currentTime = now;
+    m_publishedViews.store(views);
+}
+
+CameraView Camera::getView() const {
+    return m_publishedViews.load().current;
+}
+
+CameraView Camera::getRenderView() const {
+    PublishedViews views = m_publishedViews.load();
+    double span = views.currentTime - views.previousTime;
+    if (!INTERPOLATE_CAMERA || span <= 0.0) {
+        return views.current;
+    }
+    
+    // Fraction of the last publication interval elapsed since the last publication
+    double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    float alpha = static_cast<float>(std::min(std::max((now - views.currentTime) / span, 0.0), 1.0));
+    CameraView view;
+    view.left = views.previous.left + (views.current.left - views.previous.left) * alpha;
+    view.right = views.previous.right + (views.current.right - views.previous.right) * alpha;
+    view.bottom = views.previous.bottom + (views.current.bottom - views.previous.bottom) * alpha;
+    view.top = views.previous.top + (views.current.top - views.previous.top) * alpha;
+    return view;
 }
 
-float Camera::getLeft() const { return m_left; }
-float Camera::getRight() const { return m_right; }
-float Camera::getBottom() const { return m_bottom; }
-float Camera::getTop() const { return m_top; }
-float Camera::getWidth() const { return m_right - m_left; }
-float Camera::getHeight() const { return m_top - m_bottom; }
+float Camera::getLeft() const { return getView().left; }
+float Camera::getRight() const { return getView().right; }
+float Camera::getBottom() const { return getView().bottom; }
+float Camera::getTop() const { return getView().top; }
+float Camera::getWidth() const { return getView().getWidth(); }
+float Camera::getHeight() const { return getView().getHeight(); }
 
 void Camera::decreaseCameraRegionSmoothly(float amount, float timeSeconds) {
     // If already transitioning, cancel current transition and use current region as start
@@ -303,10 +353,12 @@ void Camera::updateSmoothTransitions(float deltaTime) {
 }
 
 void Camera::getLastKnownPlayerPosition(float& x, float& y) const {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
     x = m_lastKnownPlayerX;
     y = m_lastKnownPlayerY;
 }
 
 bool Camera::hasLastKnownPlayerPosition() const {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
     return m_hasLastKnownPosition;
 }
@@ -1,7 +1,24 @@
 #pragma once
 
 #include <algorithm> // For std::min and std::max
+#include <mutex>
 #include "enumDefinitions.h"
+#include "seqlock.h"
+
+// Camera bounds in world units
+struct CameraView {
+    float left = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+    float top = 0.0f;
+    float getWidth() const { return right - left; }
+    float getHeight() const { return top - bottom; }
+};
+
+// Interpolation between two published camera views: skipped after a jump (gameplay start, save
+// loaded, teleport) or a long gap between publications (pause), the view is shown as is
+const float CAMERA_SNAP_DISTANCE = 2.0f;            // World units the view center moved in one publication
+const double CAMERA_INTERPOLATION_MAX_GAP = 0.1;    // Seconds between the two publications
 
 
 class Camera {
@@ -28,29 +45,51 @@ public:
     // Calculate camera view based on player position
     void updateCameraPosition(float playerX, float playerY, int windowWidth, int windowHeight);
     
-    // Get camera bounds
+    // Camera bounds. The bounds are published by updateCameraPosition (player movement thread at
+    // 120 Hz, main thread on start and resize) behind a seqlock: any thread gets the latest bounds
+    // as one consistent snapshot, without locking.
+    CameraView getView() const;
+    // What the renderer draws: between the last two published views, as far as the time since the
+    // last publication allows (one publication behind at most), so the view moves smoothly at any
+    // refresh rate instead of in 120 Hz steps. The latest view when INTERPOLATE_CAMERA is off.
+    CameraView getRenderView() const;
+    
+    // Bounds of getView() (one snapshot per call: use getView() to read several consistently)
     float getLeft() const;
     float getRight() const;
     float getBottom() const;
     float getTop() const;
     float getWidth() const;    float getHeight() const;
     
+    // World size the camera is clamped to (GRID_SIZE, or the streamed world size)
+    void setGridSize(int gridSize);
+    int getGridSize() const { return m_gridSize; }
+    
     // Last known player position management
     void getLastKnownPlayerPosition(float& x, float& y) const;
     bool hasLastKnownPlayerPosition() const;
     
-private:// Camera properties
+private:
+    // Last two published views (steady clock seconds), swapped in by publishView
+    struct PublishedViews {
+        CameraView previous;
+        CameraView current;
+        double previousTime;
+        double currentTime;
+    };
+    void publishView(const CameraView& view);
+    
+    // Camera properties
     float m_cameraRegion; // Current applied camera region (may be adjusted for window constraints)
     float m_desiredCameraRegion; // User's desired camera region (preserved during window resize)
     static const float MIN_CAMERA_REGION;
     static const float MAX_CAMERA_REGION;
     static const float DEFAULT_CAMERA_REGION;
     
-    // Current camera boundaries
-    float m_left;
-    float m_right;
-    float m_bottom;
-    float m_top;
+    // Current camera boundaries: readers go through the seqlock, writers take m_publishMutex
+    Seqlock<PublishedViews> m_publishedViews;
+    PublishedViews m_writerViews; // Writer-side copy of the published state
+    mutable std::mutex m_publishMutex; // Also guards the last known player position
     
     // Last known player position
     float m_lastKnownPlayerX;
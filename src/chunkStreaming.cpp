@@ -0,0 +1,308 @@
+#include "chunkStreaming.h"
+#include "gameLog.h"
+#include "globals.h" // For DEBUG_LOGS, WORLD_SIZE and SEED_GAMEPLAY
+#include <taskflow.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+// Global chunk streamer
+ChunkStreamer g_chunkStreamer;
+
+ChunkStreamer::ChunkStreamer() {}
+
+ChunkStreamer::~ChunkStreamer() {
+    stop();
+}
+
+void ChunkStreamer::start(std::shared_ptr<const TerrainChunkSource> terrainSource, unsigned int seed) {
+    stop();
+
+    source = std::move(terrainSource);
+    worldSeed = seed;
+    if (!executor) {
+        // Leave a couple of cores for the main, logic and pathfinding threads
+        unsigned int workers = std::max(1u, std::thread::hardware_concurrency() / 4);
+        executor = std::make_unique<tf::Executor>(workers);
+    }
+    active = true;
+
+    GAME_LOG_INFO("Chunk streaming started: world " << source->getWorldWidth() << "x" << source->getWorldHeight()
+              << " blocks, " << CHUNK_SIZE << "x" << CHUNK_SIZE << " chunks");
+}
+
+void ChunkStreamer::stop() {
+    if (!active) return;
+
+    // Results still in flight belong to the old world - drop them
+    generation.fetch_add(1, std::memory_order_acq_rel);
+    if (executor) {
+        executor->wait_for_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(generatedMutex);
+        generatedChunks.clear();
+    }
+
+    pendingChunks.clear();
+    residentChunks.clear();
+    evictedChunks.clear();
+    stats = ChunkStreamingStats();
+    source.reset();
+    active = false;
+}
+
+ChunkStreamer::ChunkRange ChunkStreamer::chunkRangeAround(float minX, float minY, float maxX, float maxY, int margin) const {
+    const int chunkCountX = (source->getWorldWidth() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int chunkCountY = (source->getWorldHeight() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    ChunkRange range;
+    range.minChunkX = std::max(0, static_cast<int>(std::floor(minX / CHUNK_SIZE)) - margin);
+    range.minChunkY = std::max(0, static_cast<int>(std::floor(minY / CHUNK_SIZE)) - margin);
+    range.maxChunkX = std::min(chunkCountX - 1, static_cast<int>(std::floor(maxX / CHUNK_SIZE)) + margin);
+    range.maxChunkY = std::min(chunkCountY - 1, static_cast<int>(std::floor(maxY / CHUNK_SIZE)) + margin);
+    return range;
+}
+
+void ChunkStreamer::requestChunk(int chunkX, int chunkY) {
+    pendingChunks.insert(chunkKey(chunkX, chunkY));
+    stats.pendingChunks = pendingChunks.size();
+
+    // The task keeps its own reference to the source so it stays valid even if streaming restarts
+    std::shared_ptr<const TerrainChunkSource> chunkSource = source;
+    unsigned int requestGeneration = generation.load(std::memory_order_acquire);
+    executor->silent_async([this, chunkSource, requestGeneration, chunkX, chunkY]() {
+        GeneratedChunk chunk{chunkX, chunkY, requestGeneration, std::vector<BlockName>(CHUNK_CELL_COUNT, BlockName::GRASS_0)};
+        chunkSource->generateRegion(chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE, chunk.cells.data());
+
+        std::lock_guard<std::mutex> lock(generatedMutex);
+        generatedChunks.push_back(std::move(chunk));
+    });
+}
+
+void ChunkStreamer::installChunk(Map& map, int chunkX, int chunkY, const BlockName* cells) {
+    map.loadChunk(chunkX, chunkY, cells, chunkSeed(chunkX, chunkY));
+    residentChunks.insert(chunkKey(chunkX, chunkY));
+}
+
+void ChunkStreamer::evictChunk(Map& map, int chunkX, int chunkY) {
+    BlockName cells[CHUNK_CELL_COUNT];
+    unsigned int contentVersion = map.getChunkContentVersion(chunkX, chunkY);
+    if (map.unloadChunk(chunkX, chunkY, cells)) {
+        EvictedChunk& evicted = evictedChunks[chunkKey(chunkX, chunkY)];
+        encodeChunk(cells, evicted.encoded);
+        evicted.contentVersion = contentVersion;
+        stats.evictedBytes += evicted.encoded.size();
+        stats.chunksEvicted++;
+    }
+    residentChunks.erase(chunkKey(chunkX, chunkY));
+}
+
+void ChunkStreamer::encodeChunk(const BlockName* cells, std::vector<uint8_t>& encoded) {
+    encoded.clear();
+    int cell = 0;
+    while (cell < CHUNK_CELL_COUNT) {
+        BlockName name = cells[cell];
+        int run = 1;
+        while (cell + run < CHUNK_CELL_COUNT && cells[cell + run] == name && run < 255) {
+            run++;
+        }
+        encoded.push_back(static_cast<uint8_t>(name));
+        encoded.push_back(static_cast<uint8_t>(run));
+        cell += run;
+    }
+    encoded.shrink_to_fit();
+}
+
+void ChunkStreamer::decodeChunk(const std::vector<uint8_t>& encoded, BlockName* cells) {
+    int cell = 0;
+    for (size_t i = 0; i + 1 < encoded.size() && cell < CHUNK_CELL_COUNT; i += 2) {
+        BlockName name = static_cast<BlockName>(encoded[i]);
+        int run = std::min<int>(encoded[i + 1], CHUNK_CELL_COUNT - cell);
+        std::fill_n(cells + cell, run, name);
+        cell += run;
+    }
+}
+
+void ChunkStreamer::loadAreaNow(Map& map, float minX, float minY, float maxX, float maxY) {
+    if (!active) return;
+
+    ChunkRange range = chunkRangeAround(minX, minY, maxX, maxY, 0);
+    for (int chunkY = range.minChunkY; chunkY <= range.maxChunkY; ++chunkY) {
+        for (int chunkX = range.minChunkX; chunkX <= range.maxChunkX; ++chunkX) {
+            if (!map.isChunkResident(chunkX, chunkY) && !pendingChunks.count(chunkKey(chunkX, chunkY))) {
+                requestChunk(chunkX, chunkY);
+            }
+        }
+    }
+    executor->wait_for_all();
+
+    // Install everything that finished, with no per-frame budget
+    std::vector<GeneratedChunk> finished;
+    {
+        std::lock_guard<std::mutex> lock(generatedMutex);
+        finished.swap(generatedChunks);
+    }
+    for (const GeneratedChunk& chunk : finished) {
+        pendingChunks.erase(chunkKey(chunk.chunkX, chunk.chunkY));
+        if (chunk.generation != generation.load(std::memory_order_acquire)) continue;
+        installChunk(map, chunk.chunkX, chunk.chunkY, chunk.cells.data());
+        stats.chunksGenerated++;
+    }
+    stats.pendingChunks = pendingChunks.size();
+
+    GAME_LOG_INFO("Loaded " << map.getResidentChunkCount() << " chunks around ("
+              << (minX + maxX) / 2.0f << ", " << (minY + maxY) / 2.0f << ")");
+}
+
+void ChunkStreamer::update(Map& map, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop) {
+    if (!active) return;
+
+    const ChunkRange loadRange = chunkRangeAround(cameraLeft, cameraBottom, cameraRight, cameraTop, CHUNK_LOAD_MARGIN);
+    const ChunkRange keepRange = chunkRangeAround(cameraLeft, cameraBottom, cameraRight, cameraTop, CHUNK_EVICT_MARGIN);
+    int installBudget = MAX_CHUNKS_INSTALLED_PER_FRAME;
+
+    // 1. Install chunks generated by the workers
+    std::vector<GeneratedChunk> finished;
+    {
+        std::lock_guard<std::mutex> lock(generatedMutex);
+        finished.swap(generatedChunks);
+    }
+    const unsigned int currentGeneration = generation.load(std::memory_order_acquire);
+    for (size_t i = 0; i < finished.size(); ++i) {
+        GeneratedChunk& chunk = finished[i];
+        if (chunk.generation != currentGeneration) continue;
+
+        if (installBudget <= 0) {
+            // Over budget: hand the rest back for the next frame
+            std::lock_guard<std::mutex> lock(generatedMutex);
+            for (size_t j = i; j < finished.size(); ++j) {
+                generatedChunks.push_back(std::move(finished[j]));
+            }
+            break;
+        }
+
+        pendingChunks.erase(chunkKey(chunk.chunkX, chunk.chunkY));
+        stats.chunksGenerated++;
+        if (keepRange.contains(chunk.chunkX, chunk.chunkY)) {
+            installChunk(map, chunk.chunkX, chunk.chunkY, chunk.cells.data());
+            installBudget--;
+        } else {
+            // The camera moved away while it was generating - keep it in compact form only
+            // (content version 0: never was in the map, so it has nothing worth saving yet)
+            EvictedChunk& evicted = evictedChunks[chunkKey(chunk.chunkX, chunk.chunkY)];
+            encodeChunk(chunk.cells.data(), evicted.encoded);
+            evicted.contentVersion = 0;
+            stats.evictedBytes += evicted.encoded.size();
+        }
+    }
+
+    // 2. Request (or restore) chunks in and around the view
+    for (int chunkY = loadRange.minChunkY; chunkY <= loadRange.maxChunkY; ++chunkY) {
+        for (int chunkX = loadRange.minChunkX; chunkX <= loadRange.maxChunkX; ++chunkX) {
+            long long key = chunkKey(chunkX, chunkY);
+            if (residentChunks.count(key) || pendingChunks.count(key)) continue;
+
+            auto evicted = evictedChunks.find(key);
+            if (evicted != evictedChunks.end()) {
+                // Restoring is cheap but still mutates the map, so it shares the install budget
+                if (installBudget <= 0) continue;
+                BlockName cells[CHUNK_CELL_COUNT];
+                decodeChunk(evicted->second.encoded, cells);
+                stats.evictedBytes -= evicted->second.encoded.size();
+                evictedChunks.erase(evicted);
+                installChunk(map, chunkX, chunkY, cells);
+                stats.chunksRestored++;
+                installBudget--;
+            } else {
+                requestChunk(chunkX, chunkY);
+            }
+        }
+    }
+
+    // 3. Evict chunks that are far from the view
+    std::vector<long long> toEvict;
+    for (long long key : residentChunks) {
+        int chunkX = static_cast<int>(static_cast<unsigned int>(key & 0xffffffffLL));
+        int chunkY = static_cast<int>(key >> 32);
+        if (!keepRange.contains(chunkX, chunkY)) {
+            toEvict.push_back(key);
+        }
+    }
+    for (long long key : toEvict) {
+        evictChunk(map, static_cast<int>(static_cast<unsigned int>(key & 0xffffffffLL)), static_cast<int>(key >> 32));
+    }
+
+    stats.pendingChunks = pendingChunks.size();
+
+    if (GAME_LOG_DEBUG_ENABLED() && !toEvict.empty()) {
+        GAME_LOG_DEBUG("Chunk streaming: evicted " << toEvict.size() << " chunks, "
+                  << residentChunks.size() << " resident");
+    }
+}
+
+void ChunkStreamer::adoptResidentChunks(const Map& map) {
+    if (!active) return;
+    for (int chunkY = 0; chunkY < map.getChunkCountY(); ++chunkY) {
+        for (int chunkX = 0; chunkX < map.getChunkCountX(); ++chunkX) {
+            if (map.isChunkResident(chunkX, chunkY)) {
+                residentChunks.insert(chunkKey(chunkX, chunkY));
+                evictedChunks.erase(chunkKey(chunkX, chunkY));
+            }
+        }
+    }
+}
+
+void ChunkStreamer::addEvictedChunk(int chunkX, int chunkY, const BlockName* cells, unsigned int contentVersion) {
+    if (!active) return;
+    EvictedChunk& evicted = evictedChunks[chunkKey(chunkX, chunkY)];
+    stats.evictedBytes -= evicted.encoded.size();
+    encodeChunk(cells, evicted.encoded);
+    evicted.contentVersion = contentVersion;
+    stats.evictedBytes += evicted.encoded.size();
+}
+
+void ChunkStreamer::forEachEvictedChunk(const std::function<void(int, int, unsigned int)>& visitor) const {
+    for (const auto& entry : evictedChunks) {
+        int chunkX = static_cast<int>(static_cast<unsigned int>(entry.first & 0xffffffffLL));
+        int chunkY = static_cast<int>(entry.first >> 32);
+        visitor(chunkX, chunkY, entry.second.contentVersion);
+    }
+}
+
+bool ChunkStreamer::getEvictedChunkCells(int chunkX, int chunkY, BlockName* cells) const {
+    auto evicted = evictedChunks.find(chunkKey(chunkX, chunkY));
+    if (evicted == evictedChunks.end()) return false;
+    decodeChunk(evicted->second.encoded, cells);
+    return true;
+}
+
+ChunkStreamingStats ChunkStreamer::getStats() const {
+    return stats;
+}
+
+void ChunkStreamer::printStats() const {
+    std::cout << "=== Chunk Streaming Stats ===" << std::endl;
+    std::cout << "Resident chunks: " << residentChunks.size() << std::endl;
+    std::cout << "Pending chunks: " << stats.pendingChunks << std::endl;
+    std::cout << "Generated: " << stats.chunksGenerated << ", restored: " << stats.chunksRestored
+              << ", evicted: " << stats.chunksEvicted << std::endl;
+    std::cout << "Evicted chunks: " << evictedChunks.size() << " (" << stats.evictedBytes << " bytes)" << std::endl;
+}
+
+void startStreamedWorld(Map& map, float centerX, float centerY, int initialAreaSize) {
+    WORLD_SIZE = STREAMED_WORLD_SIZE;
+    map.clearBlocks();
+    map.setWorldSize(WORLD_SIZE, WORLD_SIZE);
+
+    // Same thresholds as the fixed-size map
+    auto terrainSource = std::make_shared<const TerrainChunkSource>(
+        WORLD_SIZE, WORLD_SIZE, islandFeatureSize, seaFeatureSize, 0.55f, 0.65f
+    );
+    g_chunkStreamer.start(terrainSource, SEED_GAMEPLAY);
+
+    if (initialAreaSize <= 0) return;
+    float halfArea = initialAreaSize / 2.0f;
+    g_chunkStreamer.loadAreaNow(map, centerX - halfArea, centerY - halfArea, centerX + halfArea, centerY + halfArea);
+}
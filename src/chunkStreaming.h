@@ -0,0 +1,129 @@
+#pragma once
+
+#include "map.h"
+#include "terrainGeneration.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tf { class Executor; }
+
+// Streaming parameters (in chunks of CHUNK_SIZE blocks)
+const int CHUNK_LOAD_MARGIN = 1;              // Chunks kept loaded around the camera view
+const int CHUNK_EVICT_MARGIN = 3;             // Chunks further than this from the view are evicted (hysteresis)
+const int MAX_CHUNKS_INSTALLED_PER_FRAME = 8; // Limits main thread work when many chunks finish at once
+
+struct ChunkStreamingStats {
+    size_t chunksGenerated = 0;   // Generated from noise on a worker thread
+    size_t chunksRestored = 0;    // Brought back from the compact evicted form
+    size_t chunksEvicted = 0;
+    size_t evictedBytes = 0;      // Memory used by the compact form of evicted chunks
+    size_t pendingChunks = 0;     // Requested but not generated yet
+};
+
+// Streams the world around the camera chunk by chunk:
+//  - chunks that come into view (plus CHUNK_LOAD_MARGIN) are generated on worker threads from a
+//    TerrainChunkSource and installed into the Map by update() on the main thread
+//  - chunks that leave the view (beyond CHUNK_EVICT_MARGIN) are removed from the Map and kept as a
+//    run-length encoded block list, so player changes survive and coming back is cheap
+// Everything except the generation itself runs on the main thread; each chunk is installed or
+// removed under the Map's write lock, atomically with respect to the logic tick's block changes.
+class ChunkStreamer {
+public:
+    ChunkStreamer();
+    ~ChunkStreamer();
+
+    // Start streaming from the given terrain source. worldSeed makes per-chunk block state deterministic.
+    void start(std::shared_ptr<const TerrainChunkSource> terrainSource, unsigned int worldSeed);
+    // Stop streaming, wait for in-flight generation and forget all evicted chunks
+    void stop();
+    bool isActive() const { return active; }
+
+    // Generate and install every chunk overlapping [minX, maxX] x [minY, maxY] before returning (startup)
+    void loadAreaNow(Map& map, float minX, float minY, float maxX, float maxY);
+
+    // Per-frame update with the camera bounds in world coordinates (main thread)
+    void update(Map& map, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop);
+
+    ChunkStreamingStats getStats() const;
+    void printStats() const;
+
+    // ---- World save support (main thread) ----
+
+    // Seed used for the block state (animation/rotation) of a chunk of this world
+    unsigned int chunkSeed(int chunkX, int chunkY) const { return streamedChunkSeed(worldSeed, chunkX, chunkY); }
+    // Register every chunk already resident in the map (installed from a save) so it is evicted/restored like the others
+    void adoptResidentChunks(const Map& map);
+    // Keep a chunk in compact form without installing it (saved chunks far from the view)
+    void addEvictedChunk(int chunkX, int chunkY, const BlockName* cells, unsigned int contentVersion);
+    // Visit the evicted chunks with the Map content version each had when it left the map
+    void forEachEvictedChunk(const std::function<void(int chunkX, int chunkY, unsigned int contentVersion)>& visitor) const;
+    bool getEvictedChunkCells(int chunkX, int chunkY, BlockName* cells) const;
+
+    // Same chunk of the same world always gets the same animation/rotation state
+    static unsigned int streamedChunkSeed(unsigned int worldSeed, int chunkX, int chunkY) {
+        return worldSeed ^ (static_cast<unsigned int>(chunkX) * 73856093u) ^ (static_cast<unsigned int>(chunkY) * 19349663u);
+    }
+
+private:
+    struct GeneratedChunk {
+        int chunkX;
+        int chunkY;
+        unsigned int generation;
+        std::vector<BlockName> cells; // CHUNK_CELL_COUNT, row-major
+    };
+
+    struct ChunkRange {
+        int minChunkX, minChunkY, maxChunkX, maxChunkY;
+        bool contains(int chunkX, int chunkY) const {
+            return chunkX >= minChunkX && chunkX <= maxChunkX && chunkY >= minChunkY && chunkY <= maxChunkY;
+        }
+    };
+
+    static long long chunkKey(int chunkX, int chunkY) { return (static_cast<long long>(chunkY) << 32) | static_cast<unsigned int>(chunkX); }
+    struct EvictedChunk {
+        std::vector<uint8_t> encoded;
+        unsigned int contentVersion = 0; // Map content version when evicted (see forEachEvictedChunk)
+    };
+
+    ChunkRange chunkRangeAround(float minX, float minY, float maxX, float maxY, int margin) const;
+
+    void requestChunk(int chunkX, int chunkY);
+    void installChunk(Map& map, int chunkX, int chunkY, const BlockName* cells);
+    void evictChunk(Map& map, int chunkX, int chunkY);
+
+    // Compact form: (BlockName, run length) byte pairs
+    static void encodeChunk(const BlockName* cells, std::vector<uint8_t>& encoded);
+    static void decodeChunk(const std::vector<uint8_t>& encoded, BlockName* cells);
+
+    std::unique_ptr<tf::Executor> executor;
+    std::shared_ptr<const TerrainChunkSource> source;
+    unsigned int worldSeed = 0;
+    bool active = false;
+
+    // Bumped on stop() so results from a previous world are dropped
+    std::atomic<unsigned int> generation{0};
+
+    // Filled by worker threads, drained by update()
+    std::mutex generatedMutex;
+    std::vector<GeneratedChunk> generatedChunks;
+
+    // Main thread only
+    std::unordered_set<long long> pendingChunks;
+    std::unordered_set<long long> residentChunks;
+    std::unordered_map<long long, EvictedChunk> evictedChunks;
+    ChunkStreamingStats stats;
+};
+
+// Global chunk streamer (only active when ENABLE_WORLD_STREAMING is set)
+extern ChunkStreamer g_chunkStreamer;
+
+// Switch the map to a STREAMED_WORLD_SIZE world (sets WORLD_SIZE), start g_chunkStreamer on it and
+// load the square of side initialAreaSize centered on (centerX, centerY) before returning (0 = start only).
+// Uses the current TERRAIN_RNG state, like generateTerrainGrid. Main thread, before other threads read the map.
+void startStreamedWorld(Map& map, float centerX, float centerY, int initialAreaSize);
@@ -1,8 +1,9 @@
 #include "collision.h"
+#include "gameLog.h"
 #include "elementsOnMap.h"
 #include "entities.h"  // Added for entitiesManager
-#include "globals.h"  // Added for GRID_SIZE
-#include "GLFW/glfw3.h" // Added for glfwGetTime
+#include "globals.h"  // Added for WORLD_SIZE
+#include "gameClock.h" // For getGameTime
 #include <cmath>
 #include <iostream>
 #include <vector>
@@ -40,6 +41,8 @@ thread_local static float lastSpatialGridUpdateTime = 0.0f;
 
 // Safety distance for collision resolution - ensures entities aren't teleported too close to collision areas
 const float SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION = 1.0f;
+// Distance between two rings of the safe position spiral (SafePositionSearch)
+const float SAFE_POSITION_SEARCH_STEP = 0.2f;
 
 // Last time debug messages were printed to reduce spam
 thread_local static float lastCollisionDebugTime = 0.0f;
@@ -56,7 +59,7 @@ std::set<BlockName> nonTraversableBlocks = {
 // Function to add a block type to the non-traversable set
 void addNonTraversableBlock(BlockName blockType) {
     nonTraversableBlocks.insert(blockType);
-    std::cout << "Added block type " << static_cast<int>(blockType) << " to non-traversable blocks." << std::endl;
+    GAME_LOG_INFO("Added block type " << static_cast<int>(blockType) << " to non-traversable blocks.");
 }
 
 // Function to remove a block type from the non-traversable set
@@ -64,7 +67,7 @@ void removeNonTraversableBlock(BlockName blockType) {
     auto it = nonTraversableBlocks.find(blockType);
     if (it != nonTraversableBlocks.end()) {
         nonTraversableBlocks.erase(it);
-        std::cout << "Removed block type " << static_cast<int>(blockType) << " from non-traversable blocks." << std::endl;
+        GAME_LOG_INFO("Removed block type " << static_cast<int>(blockType) << " from non-traversable blocks.");
     }
 }
 
@@ -76,12 +79,12 @@ bool isBlockNonTraversable(BlockName blockType) {
 // Function to clear all non-traversable blocks
 void clearNonTraversableBlocks() {
     nonTraversableBlocks.clear();
-    std::cout << "Cleared all non-traversable blocks." << std::endl;
+    GAME_LOG_INFO("Cleared all non-traversable blocks.");
 }
 
 // Function to print all non-traversable block types
 void printNonTraversableBlocks() {
-    std::cout << "Non-traversable block types (" << nonTraversableBlocks.size() << " total):" << std::endl;
+    GAME_LOG_INFO("Non-traversable block types (" << nonTraversableBlocks.size() << " total):");
     for (const auto& blockType : nonTraversableBlocks) {
         // std::cout << " - " << getBlockTypeName(blockType) << " (enum: " << static_cast<int>(blockType) << ")" << std::endl;
     }
@@ -95,8 +98,8 @@ std::vector<std::string> getCollidableElementNames() {
     // CRASH FIX: Validate elementsManager before accessing
     try {
         // Only update cache periodically to improve performance
-        float currentTime = static_cast<float>(glfwGetTime());
-        if (!collisionCacheInitialized || currentTime - lastCacheUpdateTime > 2.0f) {
+        float currentTime = static_cast<float>(getGameTime());
+        if (!collisionCacheInitialized || currentTime - lastCacheUpdateTime > 2.0f || currentTime < lastCacheUpdateTime) {
             // Update the cache when it's stale or needs initializing
             collidableElementNames.clear();
             lastCacheUpdateTime = currentTime;
@@ -117,7 +120,7 @@ std::vector<std::string> getCollidableElementNames() {
             collisionCacheInitialized = true;
         }
     } catch (const std::exception& e) {
-        std::cerr << "CRASH FIX: Exception in getCollidableElementNames: " << e.what() << std::endl;
+        GAME_LOG_ERROR("CRASH FIX: Exception in getCollidableElementNames: " << e.what());
         // Return safe empty vector on error
         return std::vector<std::string>();
     }
@@ -156,10 +159,10 @@ int getSpatialGridIndex(float x, float y) {
 void updateSpatialGrid() {
     PROFILE_SCOPE("CollisionSpatialGrid_Update");
     
-    float currentTime = static_cast<float>(glfwGetTime());
+    float currentTime = static_cast<float>(getGameTime());
     
     // Only update every 0.5 seconds to avoid performance impact
-    if (spatialGridInitialized && currentTime - lastSpatialGridUpdateTime < 0.5f) {
+    if (spatialGridInitialized && currentTime >= lastSpatialGridUpdateTime && currentTime - lastSpatialGridUpdateTime < 0.5f) {
         return;
     }
     
@@ -219,24 +222,28 @@ bool wouldCollideWithMapBlock(float x, float y, const Map& gameMap) {
     int gridY = static_cast<int>(y);
     
     // Skip invalid coordinates 
-    if (gridX < 0 || gridX >= GRID_SIZE || gridY < 0 || gridY >= GRID_SIZE) {
+    if (gridX < 0 || gridX >= WORLD_SIZE || gridY < 0 || gridY >= WORLD_SIZE) {
         return true; // Treat out-of-bounds as collision
     }
     
-    // Get the texture type at these coordinates
-    BlockName blockType = gameMap.getBlockNameByCoordinates(gridX, gridY);
+    // Get the texture type at these coordinates (chunk-aware: a chunk that is not loaded
+    // yet is treated as a wall so nothing walks into terrain that doesn't exist)
+    BlockName blockType;
+    if (!gameMap.tryGetBlockName(gridX, gridY, blockType)) {
+        return true;
+    }
     
     // Check if this block type is in our set of non-traversable blocks
     if (nonTraversableBlocks.find(blockType) != nonTraversableBlocks.end()) {
         // Throttle debug output much more aggressively
         thread_local static int mapCollisionCounter = 0;
         thread_local static float lastMapDebugTime = 0.0f;
-        float currentTime = static_cast<float>(glfwGetTime());
+        float currentTime = static_cast<float>(getGameTime());
         
         if (playerDebugMode && currentTime - lastMapDebugTime > 5.0f) {
             lastMapDebugTime = currentTime;
-            std::cout << "Map block collision at (" << x << ", " << y 
-                      << ") - Block type: " << static_cast<int>(blockType) << std::endl;
+            GAME_LOG_INFO("Map block collision at (" << x << ", " << y 
+                      << ") - Block type: " << static_cast<int>(blockType));
         }
         return true; // Collision detected with non-traversable block
     }
@@ -251,23 +258,27 @@ bool wouldCollideWithMapBlock(float x, float y, const Map& gameMap, const std::s
     int gridY = static_cast<int>(y);
     
     // Skip invalid coordinates 
-    if (gridX < 0 || gridX >= GRID_SIZE || gridY < 0 || gridY >= GRID_SIZE) {
+    if (gridX < 0 || gridX >= WORLD_SIZE || gridY < 0 || gridY >= WORLD_SIZE) {
         return true; // Treat out-of-bounds as collision
     }
     
-    // Get the texture type at these coordinates
-    BlockName blockType = gameMap.getBlockNameByCoordinates(gridX, gridY);
+    // Get the texture type at these coordinates (chunk-aware: a chunk that is not loaded
+    // yet is treated as a wall so nothing walks into terrain that doesn't exist)
+    BlockName blockType;
+    if (!gameMap.tryGetBlockName(gridX, gridY, blockType)) {
+        return true;
+    }
     
     // Check if this block type is in the entity's set of non-traversable blocks
     if (entityNonTraversableBlocks.find(blockType) != entityNonTraversableBlocks.end()) {
         // Throttle debug output much more aggressively        thread_local static int mapCollisionCounter = 0;
         thread_local static float lastMapDebugTime = 0.0f;
-        float currentTime = static_cast<float>(glfwGetTime());
+        float currentTime = static_cast<float>(getGameTime());
         
         if (playerDebugMode && currentTime - lastMapDebugTime > 5.0f) {
             lastMapDebugTime = currentTime;
-            std::cout << "Entity-specific map block collision at (" << x << ", " << y 
-                      << ") - Block type: " << static_cast<int>(blockType) << std::endl;
+            GAME_LOG_INFO("Entity-specific map block collision at (" << x << ", " << y 
+                      << ") - Block type: " << static_cast<int>(blockType));
         }
         return true; // Collision detected with non-traversable block
     }
@@ -331,19 +342,19 @@ bool findSafePosition(float& x, float& y, float playerRadius, const Map& gameMap
         return true; // Already in a safe position with adequate buffer
     }
     
-    std::cout << "Entity stuck at (" << x << ", " << y << ") - finding safe position with " 
-              << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION << " unit safety buffer..." << std::endl;
+    GAME_LOG_INFO("Entity stuck at (" << x << ", " << y << ") - finding safe position with " 
+              << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION << " unit safety buffer...");
     
     // Search in expanding concentric circles for a safe position
     const float searchStep = 1.0f; // Slightly larger step size for better performance
     const float maxSearchRadius = 5.0f; // Much larger search radius for multi-layer scenarios
     
-    std::cout << "Searching for safe position with radius up to " << maxSearchRadius << " units..." << std::endl;
+    GAME_LOG_INFO("Searching for safe position with radius up to " << maxSearchRadius << " units...");
     
     for (float radius = searchStep; radius <= maxSearchRadius; radius += searchStep) {
         // Progress indicator for long searches
         if (static_cast<int>(radius) % 5 == 0 && radius > 5.0f) {
-            std::cout << "Still searching... radius " << radius << "/" << maxSearchRadius << std::endl;
+            GAME_LOG_INFO("Still searching... radius " << radius << "/" << maxSearchRadius);
         }
         
         // Try 24 directions around the current position (more directions for better coverage)
@@ -354,11 +365,11 @@ bool findSafePosition(float& x, float& y, float playerRadius, const Map& gameMap
             
             // Make sure we stay within map bounds (with safety buffer margin)
             float margin = SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION + 0.5f;
-            if (testX < margin || testX >= (GRID_SIZE - margin) || 
-                testY < margin || testY >= (GRID_SIZE - margin)) {
+            if (testX < margin || testX >= (WORLD_SIZE - margin) || 
+                testY < margin || testY >= (WORLD_SIZE - margin)) {
                 // Debug: Log boundary rejections for initial attempts
                 if (radius <= 2.0f) {
-                    std::cout << "Position (" << testX << ", " << testY << ") rejected - outside map bounds (margin: " << margin << ")" << std::endl;
+                    GAME_LOG_INFO("Position (" << testX << ", " << testY << ") rejected - outside map bounds (margin: " << margin << ")");
                 }
                 continue;
             }
@@ -366,9 +377,9 @@ bool findSafePosition(float& x, float& y, float playerRadius, const Map& gameMap
             // Check if this position is safe with safety buffer
             if (isPositionSafeWithBuffer(testX, testY, playerRadius, gameMap)) {
                 // Found a safe position with adequate buffer!
-                std::cout << "Found safe position at (" << testX << ", " << testY 
+                GAME_LOG_INFO("Found safe position at (" << testX << ", " << testY 
                           << ") - distance: " << radius << " with safety buffer: " 
-                          << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION << std::endl;
+                          << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION);
                 x = testX;
                 y = testY;
                 return true;
@@ -376,92 +387,102 @@ bool findSafePosition(float& x, float& y, float playerRadius, const Map& gameMap
             
             // Debug: Log why this position failed (but only for first few attempts to avoid spam)
             if (radius <= 2.0f) {
-                std::cout << "Position (" << testX << ", " << testY << ") rejected - insufficient safety buffer" << std::endl;
+                GAME_LOG_INFO("Position (" << testX << ", " << testY << ") rejected - insufficient safety buffer");
             }
         }
     }
     
-    std::cout << "Could not find safe position within search radius of " << maxSearchRadius << std::endl;
+    GAME_LOG_INFO("Could not find safe position within search radius of " << maxSearchRadius);
     return false; // Could not find a safe position
 }
 
 // Enhanced function to find a safe position for entities using their collision shape
-bool findSafePositionForEntity(float& x, float& y, const EntityConfiguration& config, const Map& gameMap, const std::string& excludeInstanceName) {
-    // Store original position for comparison
-    float originalX = x;
-    float originalY = y;
-    
+SafePositionSearch::SafePositionSearch(float x, float y, const EntityConfiguration& config, const std::string& excludeInstanceName)
+    : originX(x), originY(y), config(&config), excludeInstanceName(excludeInstanceName), resultX(x), resultY(y) {
     // DO NOT immediately return if current position seems safe - this causes infinite loops
-    // When this function is called, it means the entity is definitively stuck, so we need to find a DIFFERENT position
-    
-    std::cout << "Entity with collision shape stuck at (" << x << ", " << y << ") - finding safe position with " 
-              << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION << " unit safety buffer..." << std::endl;
-    
-    // Calculate entity's approximate radius for search optimization
-    float entityRadius = 0.5f; // Default fallback
-    if (!config.collisionShapePoints.empty()) {
-        for (const auto& point : config.collisionShapePoints) {
-            float dist = std::sqrt(point.first * point.first + point.second * point.second);
-            entityRadius = std::max(entityRadius, dist);
-        }
-    }
-    
+    // When this search runs, it means the entity is definitively stuck, so we need to find a DIFFERENT position
+    GAME_LOG_INFO("Entity with collision shape stuck at (" << x << ", " << y << ") - finding safe position with " 
+              << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION << " unit safety buffer...");
+    radius = SAFE_POSITION_SEARCH_STEP;
+}
+
+bool SafePositionSearch::step(const Map& gameMap, int maxProbes) {
     // Search in expanding concentric circles for a safe position
-    const float searchStep = 0.2f; // Slightly larger step size for better performance
     const float maxSearchRadius = 5.0f; // Much larger search radius to match player search radius
-      std::cout << "Searching for safe entity position with radius up to " << maxSearchRadius << " units..." << std::endl;
+    const int directions = 32;          // More directions for better coverage
     
-    for (float radius = searchStep; radius <= maxSearchRadius; radius += searchStep) {
-        // Progress indicator for long searches
-        if (static_cast<int>(radius) % 5 == 0 && radius > 5.0f) {
-            std::cout << "Still searching... radius " << radius << "/" << maxSearchRadius << std::endl;
+    for (int probes = 0; !finished && probes < maxProbes; ++probes) {
+        if (directionIndex >= directions) {
+            radius += SAFE_POSITION_SEARCH_STEP;
+            directionIndex = 0;
+        }
+        if (radius > maxSearchRadius) {
+            GAME_LOG_INFO("Could not find safe position within search radius of " << maxSearchRadius);
+            finished = true;
+            break;
         }
         
-        // Try 32 directions around the current position (more directions for better coverage)
-        for (int i = 0; i < 32; i++) {
-            float angle = (i * 2.0f * M_PI) / 32.0f;
-            float testX = x + radius * cos(angle);
-            float testY = y + radius * sin(angle);            // Make sure we stay within map bounds with safety buffer margin
-            float margin = SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION + 0.5f;
-            if (testX < margin || testX >= (GRID_SIZE - margin) || 
-                testY < margin || testY >= (GRID_SIZE - margin)) {
-                // Debug: Log boundary rejections for initial attempts
-                if (radius <= 2.0f) {
-                    std::cout << "Position (" << testX << ", " << testY << ") rejected - outside map bounds (margin: " << margin << ")" << std::endl;
-                }
-                continue;
-            }            // Check if this position is safe with safety buffer
-            if (isEntityPositionSafeWithBuffer(testX, testY, config, gameMap, SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION, excludeInstanceName)) {
-                // Found a safe position with adequate buffer!
-                std::cout << "Found safe position at (" << testX << ", " << testY 
-                          << ") - distance: " << radius << " with safety buffer: " 
-                          << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION << std::endl;
-                x = testX;
-                y = testY;
-                return true;
-            }
-            
-            // Debug: Log why this position failed (but only for first few attempts to avoid spam)
+        float angle = (directionIndex * 2.0f * M_PI) / static_cast<float>(directions);
+        float testX = originX + radius * cos(angle);
+        float testY = originY + radius * sin(angle);
+        ++directionIndex;
+        
+        // Make sure we stay within map bounds with safety buffer margin
+        float margin = SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION + 0.5f;
+        if (testX < margin || testX >= (WORLD_SIZE - margin) || 
+            testY < margin || testY >= (WORLD_SIZE - margin)) {
+            // Debug: Log boundary rejections for initial attempts
             if (radius <= 2.0f) {
-                std::cout << "Position (" << testX << ", " << testY << ") rejected - insufficient safety buffer" << std::endl;
+                GAME_LOG_INFO("Position (" << testX << ", " << testY << ") rejected - outside map bounds (margin: " << margin << ")");
             }
+            continue;
+        }
+        
+        // Check if this position is safe with safety buffer
+        if (isEntityPositionSafeWithBuffer(testX, testY, *config, gameMap, SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION, excludeInstanceName)) {
+            // Found a safe position with adequate buffer!
+            GAME_LOG_INFO("Found safe position at (" << testX << ", " << testY 
+                      << ") - distance: " << radius << " with safety buffer: " 
+                      << SAFETY_DISTANCE_FROM_COLLISION_AREA_AFTER_RESOLUTION);
+            resultX = testX;
+            resultY = testY;
+            success = true;
+            finished = true;
+            break;
+        }
+        
+        // Debug: Log why this position failed (but only for first few attempts to avoid spam)
+        if (radius <= 2.0f) {
+            GAME_LOG_INFO("Position (" << testX << ", " << testY << ") rejected - insufficient safety buffer");
         }
     }
-    
-    std::cout << "Could not find safe position within search radius of " << maxSearchRadius << std::endl;
-    return false; // Could not find a safe position
+    return finished;
+}
+
+// Blocking form: runs the whole spiral in one call (spawning, teleporting and the player need
+// an answer right away)
+bool findSafePositionForEntity(float& x, float& y, const EntityConfiguration& config, const Map& gameMap, const std::string& excludeInstanceName) {
+    SafePositionSearch search(x, y, config, excludeInstanceName);
+    while (!search.step(gameMap, SAFE_POSITION_PROBES_PER_STEP)) {
+    }
+    if (!search.found()) {
+        return false; // Could not find a safe position
+    }
+    x = search.getResultX();
+    y = search.getResultY();
+    return true;
 }
 
 // Function to resolve collision when an entity is stuck (to be called from entities system)
 bool resolveEntityCollisionStuck(const std::string& entityId, float& x, float& y, const EntityConfiguration& config, const Map& gameMap) {
-    std::cout << "Collision resolution requested for entity: " << entityId << " at position (" << x << ", " << y << ")" << std::endl;
+    GAME_LOG_INFO("Collision resolution requested for entity: " << entityId << " at position (" << x << ", " << y << ")");
       // Use the enhanced entity collision resolution function with entity exclusion
     bool success = findSafePositionForEntity(x, y, config, gameMap, entityId);
     
     if (success) {
-        std::cout << "Successfully resolved collision for entity " << entityId << " - moved to (" << x << ", " << y << ")" << std::endl;
+        GAME_LOG_INFO("Successfully resolved collision for entity " << entityId << " - moved to (" << x << ", " << y << ")");
     } else {
-        std::cout << "Failed to resolve collision for entity " << entityId << " - no safe position found within search radius" << std::endl;
+        GAME_LOG_INFO("Failed to resolve collision for entity " << entityId << " - no safe position found within search radius");
     }
     
     return success;
@@ -475,7 +496,7 @@ bool wouldEntityCollideWithElement(float x, float y, const std::vector<std::pair
 }
 
 // Helper function to check collision between two polygons using Separating Axis Theorem (SAT)
-bool polygonPolygonCollision(const std::vector<std::pair<float, float>>& poly1, const std::vector<std::pair<float, float>>& poly2) {
+bool polygonPolygonCollision(PolygonView poly1, PolygonView poly2) {
     // Check if either polygon is empty
     if (poly1.empty() || poly2.empty()) {
         return false;
@@ -498,10 +519,10 @@ bool polygonPolygonCollision(const std::vector<std::pair<float, float>>& poly1,
         }
     };
       // Function to project polygon onto axis
-    auto projectPolygon = [](const std::vector<std::pair<float, float>>& polygon, const std::pair<float, float>& axis) -> std::pair<float, float> {
+    auto projectPolygon = [](PolygonView polygon, const std::pair<float, float>& axis) -> std::pair<float, float> {
         // CRASH FIX: Additional safety check for empty polygon
         if (polygon.empty()) {
-            std::cerr << "CRITICAL: Attempting to project empty polygon in SAT collision detection" << std::endl;
+            GAME_LOG_ERROR("CRITICAL: Attempting to project empty polygon in SAT collision detection");
             return {0.0f, 0.0f};
         }
         
@@ -552,7 +573,7 @@ bool polygonPolygonCollision(const std::vector<std::pair<float, float>>& poly1,
 }
 
 // Helper function for circle-polygon collision detection
-bool circlePolygonCollision(float circleX, float circleY, float radius, const std::vector<std::pair<float, float>>& polygon) {
+bool circlePolygonCollision(float circleX, float circleY, float radius, PolygonView polygon) {
     if (polygon.empty()) {
         return false;
     }
@@ -618,11 +639,10 @@ bool circlePolygonCollision(float circleX, float circleY, float radius, const st
 bool wouldEntityCollideWithMapBounds(float x, float y, const std::vector<std::pair<float, float>>& collisionShapePoints, float entityScale, float entityRotation) {
     if (collisionShapePoints.empty()) {
         // If no collision shape is defined, check only the center point
-        return (x < 0.0f || y < 0.0f || x >= static_cast<float>(GRID_SIZE) || y >= static_cast<float>(GRID_SIZE));
+        return (x < 0.0f || y < 0.0f || x >= static_cast<float>(WORLD_SIZE) || y >= static_cast<float>(WORLD_SIZE));
     }
     
     // Transform collision shape points to world coordinates
-    std::vector<std::pair<float, float>> worldShapePoints;
     float angleRad = entityRotation * M_PI / 180.0f;
     float cosA = cos(angleRad);
     float sinA = sin(angleRad);
@@ -639,7 +659,7 @@ bool wouldEntityCollideWithMapBounds(float x, float y, const std::vector<std::pa
         float worldY = y + rotatedY;
         
         // Check if any point of the collision shape is outside map bounds
-        if (worldX < 0.0f || worldY < 0.0f || worldX >= static_cast<float>(GRID_SIZE) || worldY >= static_cast<float>(GRID_SIZE)) {
+        if (worldX < 0.0f || worldY < 0.0f || worldX >= static_cast<float>(WORLD_SIZE) || worldY >= static_cast<float>(WORLD_SIZE)) {
             return true; // Collision shape extends beyond map boundaries
         }
     }
@@ -705,9 +725,9 @@ void HierarchicalSpatialGrid::initialize() {
                             element.instanceName.find("movable") != std::string::npos);
             
             if (isDynamic) {
-                dynamicElementNames.insert(element.instanceName);
+                dynamicElementNames.insert(element.symbol);
             } else {
-                staticElementNames.insert(element.instanceName);
+                staticElementNames.insert(element.symbol);
             }
         }
     }
@@ -715,20 +735,19 @@ void HierarchicalSpatialGrid::initialize() {
     updateGrid(true); // Force initial update
     isInitialized = true;
     
-    if (DEBUG_LOGS) {
-        std::cout << "HierarchicalSpatialGrid initialized with " 
+    GAME_LOG_DEBUG("HierarchicalSpatialGrid initialized with " 
                   << staticElementNames.size() << " static and " 
-                  << dynamicElementNames.size() << " dynamic elements" << std::endl;
-    }
+                  << dynamicElementNames.size() << " dynamic elements");
 }
 
 void HierarchicalSpatialGrid::updateGrid(bool forceUpdate) {
     PROFILE_SCOPE("HierarchicalSpatialGrid_UpdateGrid");
     
-    float currentTime = static_cast<float>(glfwGetTime());
+    float currentTime = static_cast<float>(getGameTime());
     
-    bool shouldUpdateStatic = forceUpdate || (currentTime - lastCoarseUpdateTime > HierarchicalSpatialGrid::STATIC_UPDATE_INTERVAL);
-    bool shouldUpdateDynamic = forceUpdate || (currentTime - lastFineUpdateTime > HierarchicalSpatialGrid::DYNAMIC_UPDATE_INTERVAL);
+    // The game clock restarts with every lockstep session (simulationReplay.h): time going backwards counts as stale
+    bool shouldUpdateStatic = forceUpdate || currentTime < lastCoarseUpdateTime || (currentTime - lastCoarseUpdateTime > HierarchicalSpatialGrid::STATIC_UPDATE_INTERVAL);
+    bool shouldUpdateDynamic = forceUpdate || currentTime < lastFineUpdateTime || (currentTime - lastFineUpdateTime > HierarchicalSpatialGrid::DYNAMIC_UPDATE_INTERVAL);
     
     if (shouldUpdateStatic) {
         updateStaticElements();
@@ -758,10 +777,10 @@ void HierarchicalSpatialGrid::updateStaticElements() {
     // Re-add static elements to both grids
     {
         PROFILE_SCOPE("HierarchicalSpatialGrid_ReaddStaticElements");
-        for (const auto& elementName : staticElementNames) {
+        for (SymbolId element : staticElementNames) {
             float x, y;
-            if (elementsManager.getElementPosition(elementName, x, y)) {
-                addElementToGrid(elementName, x, y, true);
+            if (elementsManager.getElementPosition(element, x, y)) {
+                addElementToGrid(element, x, y, true);
             }
         }
     }
@@ -784,28 +803,30 @@ void HierarchicalSpatialGrid::updateDynamicElements() {
     // Re-add dynamic elements to both grids
     {
         PROFILE_SCOPE("HierarchicalSpatialGrid_ReaddDynamicElements");
-        for (const auto& elementName : dynamicElementNames) {
+        for (SymbolId element : dynamicElementNames) {
             float x, y;
-            if (elementsManager.getElementPosition(elementName, x, y)) {
-                addElementToGrid(elementName, x, y, false);
+            if (elementsManager.getElementPosition(element, x, y)) {
+                addElementToGrid(element, x, y, false);
             }
         }
     }
 }
 
 void HierarchicalSpatialGrid::markElementAsDynamic(const std::string& elementName) {
-    staticElementNames.erase(elementName);
-    dynamicElementNames.insert(elementName);
+    SymbolId element = internSymbol(elementName);
+    staticElementNames.erase(element);
+    dynamicElementNames.insert(element);
 }
 
 void HierarchicalSpatialGrid::markElementAsStatic(const std::string& elementName) {
-    dynamicElementNames.erase(elementName);
-    staticElementNames.insert(elementName);
+    SymbolId element = internSymbol(elementName);
+    dynamicElementNames.erase(element);
+    staticElementNames.insert(element);
 }
 
-std::vector<std::string> HierarchicalSpatialGrid::getBroadPhaseElements(float x, float y, float radius) {
+void HierarchicalSpatialGrid::getBroadPhaseElements(float x, float y, float radius, std::vector<SymbolId>& result) {
     PROFILE_SCOPE("HierarchicalSpatialGrid_GetBroadPhaseElements");
-    std::vector<std::string> result;
+    result.clear();
     g_collisionStats.broadPhaseChecks++;
     
     // Use coarse grid for broad phase
@@ -825,13 +846,11 @@ std::vector<std::string> HierarchicalSpatialGrid::getBroadPhaseElements(float x,
             }
         }
     }
-    
-    return result;
 }
 
-std::vector<std::string> HierarchicalSpatialGrid::getNarrowPhaseElements(float x, float y, float radius) {
+void HierarchicalSpatialGrid::getNarrowPhaseElements(float x, float y, float radius, std::vector<SymbolId>& result) {
     PROFILE_SCOPE("HierarchicalSpatialGrid_GetNarrowPhaseElements");
-    std::vector<std::string> result;
+    result.clear();
     g_collisionStats.narrowPhaseChecks++;
     
     // Use fine grid for narrow phase
@@ -851,23 +870,19 @@ std::vector<std::string> HierarchicalSpatialGrid::getNarrowPhaseElements(float x
             }
         }
     }
-    
-    return result;
 }
 
-std::vector<std::string> HierarchicalSpatialGrid::getElementsHierarchical(float x, float y, float radius) {
+void HierarchicalSpatialGrid::getElementsHierarchical(float x, float y, float radius, std::vector<SymbolId>& result) {
     PROFILE_SCOPE("HierarchicalSpatialGrid_GetElementsHierarchical");
     auto startTime = std::chrono::high_resolution_clock::now();
     g_collisionStats.totalCollisionQueries++;
     
-    std::vector<std::string> result;
-    
     // Use broad phase for large radius queries
     if (radius > COARSE_GRID_SIZE * 0.5f) {
-        result = getBroadPhaseElements(x, y, radius);
+        getBroadPhaseElements(x, y, radius, result);
     } else {
         // Use narrow phase for precise queries
-        result = getNarrowPhaseElements(x, y, radius);
+        getNarrowPhaseElements(x, y, radius, result);
     }
     
     if (!result.empty()) {
@@ -877,8 +892,6 @@ std::vector<std::string> HierarchicalSpatialGrid::getElementsHierarchical(float
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
     g_collisionStats.totalTimeMs.store(g_collisionStats.totalTimeMs.load() + duration.count() / 1000.0);
-    
-    return result;
 }
 
 void HierarchicalSpatialGrid::clear() {
@@ -919,25 +932,25 @@ int HierarchicalSpatialGrid::getFineGridIndex(float x, float y) const {
     return gridX * 1000 + gridY; // Original multiplier for fine grid
 }
 
-void HierarchicalSpatialGrid::addElementToGrid(const std::string& elementName, float x, float y, bool isStatic) {
+void HierarchicalSpatialGrid::addElementToGrid(SymbolId element, float x, float y, bool isStatic) {
     // Add to coarse grid
     int coarseIndex = getCoarseGridIndex(x, y);
     if (isStatic) {
-        coarseGrid[coarseIndex].staticElements.push_back(elementName);
+        coarseGrid[coarseIndex].staticElements.push_back(element);
     } else {
-        coarseGrid[coarseIndex].dynamicElements.push_back(elementName);
+        coarseGrid[coarseIndex].dynamicElements.push_back(element);
     }
     
     // Add to fine grid
     int fineIndex = getFineGridIndex(x, y);
     if (isStatic) {
-        fineGrid[fineIndex].staticElements.push_back(elementName);
+        fineGrid[fineIndex].staticElements.push_back(element);
     } else {
-        fineGrid[fineIndex].dynamicElements.push_back(elementName);
+        fineGrid[fineIndex].dynamicElements.push_back(element);
     }
 }
 
-void HierarchicalSpatialGrid::removeElementFromGrid(const std::string& elementName) {
+void HierarchicalSpatialGrid::removeElementFromGrid(SymbolId element) {
     // Remove from both grids - this is expensive so we avoid it in favor of clearing and rebuilding
     // In a more sophisticated implementation, we could track element positions to remove more efficiently
 }
@@ -945,7 +958,7 @@ void HierarchicalSpatialGrid::removeElementFromGrid(const std::string& elementNa
 // Enhanced collision detection functions using hierarchical grid
 bool wouldCollideWithElementHierarchical(float x, float y, float playerRadius) {
     // Thread-safe access to hierarchical grid
-    std::vector<std::string> nearbyElements;
+    thread_local static std::vector<SymbolId> nearbyElements;
     {
         std::lock_guard<std::mutex> lock(g_hierarchicalGridMutex);
         // Initialize hierarchical grid if needed
@@ -957,22 +970,27 @@ bool wouldCollideWithElementHierarchical(float x, float y, float playerRadius) {
         g_hierarchicalGrid.updateGrid();
         
         // Get nearby elements using hierarchical lookup
-        nearbyElements = g_hierarchicalGrid.getElementsHierarchical(x, y, playerRadius + MAX_COLLISION_CHECK_RANGE);
+        g_hierarchicalGrid.getElementsHierarchical(x, y, playerRadius + MAX_COLLISION_CHECK_RANGE, nearbyElements);
     }
     
+    // Shape buffers come from the frame arena and are reused for every candidate
+    FrameArenaScope arenaScope;
+    FrameVector<std::pair<float, float>> elementCollisionShapePoints(&frameArena());
+    FrameVector<std::pair<float, float>> elementWorldShapePoints(&frameArena());
+    
     // Perform collision detection on nearby elements
-    for (const auto& elementName : nearbyElements) {
+    for (SymbolId element : nearbyElements) {
         float elementX, elementY;
         float elementScale = 1.0f;
         float elementRotation = 0.0f;
-        std::vector<std::pair<float, float>> elementCollisionShapePoints;
+        elementCollisionShapePoints.clear();
         
-        if (elementsManager.getElementPosition(elementName, elementX, elementY)) {
-            auto elementData = elementsManager.getElementData(elementName);
+        if (elementsManager.getElementPosition(element, elementX, elementY)) {
+            auto elementData = elementsManager.getElementData(element);
             if (elementData) {
                 elementScale = elementData->scale;
                 elementRotation = elementData->rotation;
-                elementCollisionShapePoints = elementData->collisionShapePoints;
+                elementCollisionShapePoints.assign(elementData->collisionShapePoints.begin(), elementData->collisionShapePoints.end());
             }
             
             // Calculate distance between player and element centers
@@ -983,7 +1001,7 @@ bool wouldCollideWithElementHierarchical(float x, float y, float playerRadius) {
             // If the element has collision shape points, use precise polygon collision
             if (!elementCollisionShapePoints.empty()) {
                 // Calculate element collision shape in world coordinates
-                std::vector<std::pair<float, float>> elementWorldShapePoints;
+                elementWorldShapePoints.clear();
                 float elementAngleRad = elementRotation * M_PI / 180.0f;
                 float elementCosA = cos(elementAngleRad);
                 float elementSinA = sin(elementAngleRad);
@@ -1024,24 +1042,22 @@ void HierarchicalEntityGrid::initialize() {
     // Initialize with all current entities
     const auto& allEntities = entitiesManager.getEntities();
     for (const auto& pair : allEntities) {
-        entityInstanceNames.insert(pair.first);
+        entityInstanceNames.insert(pair.second.symbol);
     }
     
     updateGrid(true); // Force initial update
     isInitialized = true;
     
-    if (DEBUG_LOGS) {
-        std::cout << "HierarchicalEntityGrid initialized with " 
-                  << entityInstanceNames.size() << " entities" << std::endl;
-    }
+    GAME_LOG_DEBUG("HierarchicalEntityGrid initialized with " 
+                  << entityInstanceNames.size() << " entities");
 }
 
 void HierarchicalEntityGrid::updateGrid(bool forceUpdate) {
     PROFILE_SCOPE("HierarchicalEntityGrid_UpdateGrid");
     
-    float currentTime = static_cast<float>(glfwGetTime());
+    float currentTime = static_cast<float>(getGameTime());
     
-    bool shouldUpdate = forceUpdate || (currentTime - lastFineUpdateTime > DYNAMIC_UPDATE_INTERVAL);
+    bool shouldUpdate = forceUpdate || currentTime < lastFineUpdateTime || (currentTime - lastFineUpdateTime > DYNAMIC_UPDATE_INTERVAL);
     
     if (shouldUpdate) {
         updateEntityPositions();
@@ -1057,21 +1073,21 @@ void HierarchicalEntityGrid::updateEntityPositions() {
     fineGrid.clear();
     
     // Re-add all entities to both grids
-    for (const auto& instanceName : entityInstanceNames) {
-        const Entity* entity = entitiesManager.getEntity(instanceName);
-        if (entity) {
-            std::string elementName = EntitiesManager::getElementName(instanceName);
+    // An entity's element has the entity's instance name (EntitiesManager::getElementName), so
+    // the symbol is also the element symbol
+    for (SymbolId entity : entityInstanceNames) {
+        if (entitiesManager.getEntity(entity)) {
             float x, y;
-            if (elementsManager.getElementPosition(elementName, x, y)) {
-                addEntityToGrid(instanceName, x, y);
+            if (elementsManager.getElementPosition(entity, x, y)) {
+                addEntityToGrid(entity, x, y);
             }
         }
     }
 }
 
-std::vector<std::string> HierarchicalEntityGrid::getBroadPhaseEntities(float x, float y, float radius) {
+void HierarchicalEntityGrid::getBroadPhaseEntities(float x, float y, float radius, std::vector<SymbolId>& result) {
     PROFILE_SCOPE("HierarchicalEntityGrid_GetBroadPhaseEntities");
-    std::vector<std::string> result;
+    result.clear();
     
     // Use coarse grid for broad phase
     int cellRadius = static_cast<int>(radius / COARSE_GRID_SIZE) + 1;
@@ -1090,13 +1106,11 @@ std::vector<std::string> HierarchicalEntityGrid::getBroadPhaseEntities(float x,
             }
         }
     }
-    
-    return result;
 }
 
-std::vector<std::string> HierarchicalEntityGrid::getNarrowPhaseEntities(float x, float y, float radius) {
+void HierarchicalEntityGrid::getNarrowPhaseEntities(float x, float y, float radius, std::vector<SymbolId>& result) {
     PROFILE_SCOPE("HierarchicalEntityGrid_GetNarrowPhaseEntities");
-    std::vector<std::string> result;
+    result.clear();
     
     // Use fine grid for narrow phase
     int cellRadius = static_cast<int>(radius / FINE_GRID_SIZE) + 1;
@@ -1115,32 +1129,28 @@ std::vector<std::string> HierarchicalEntityGrid::getNarrowPhaseEntities(float x,
             }
         }
     }
-    
-    return result;
 }
 
-std::vector<std::string> HierarchicalEntityGrid::getEntitiesHierarchical(float x, float y, float radius) {
+void HierarchicalEntityGrid::getEntitiesHierarchical(float x, float y, float radius, std::vector<SymbolId>& result) {
     PROFILE_SCOPE("HierarchicalEntityGrid_GetEntitiesHierarchical");
-    std::vector<std::string> result;
     
     // Use broad phase for large radius queries
     if (radius > COARSE_GRID_SIZE * 0.5f) {
-        result = getBroadPhaseEntities(x, y, radius);
+        getBroadPhaseEntities(x, y, radius, result);
     } else {
         // Use narrow phase for precise queries
-        result = getNarrowPhaseEntities(x, y, radius);
+        getNarrowPhaseEntities(x, y, radius, result);
     }
-    
-    return result;
 }
 
 void HierarchicalEntityGrid::addEntity(const std::string& instanceName, float x, float y) {
-    entityInstanceNames.insert(instanceName);
-    addEntityToGrid(instanceName, x, y);
+    SymbolId entity = internSymbol(instanceName);
+    entityInstanceNames.insert(entity);
+    addEntityToGrid(entity, x, y);
 }
 
 void HierarchicalEntityGrid::removeEntity(const std::string& instanceName) {
-    entityInstanceNames.erase(instanceName);
+    entityInstanceNames.erase(findSymbol(instanceName));
     // Note: We don't remove from grids immediately for performance
     // The grid will be cleaned up on next update
 }
@@ -1178,14 +1188,14 @@ int HierarchicalEntityGrid::getFineGridIndex(float x, float y) const {
     return gridX * 1000 + gridY; // Original multiplier for fine grid
 }
 
-void HierarchicalEntityGrid::addEntityToGrid(const std::string& instanceName, float x, float y) {
+void HierarchicalEntityGrid::addEntityToGrid(SymbolId entity, float x, float y) {
     // Add to coarse grid
     int coarseIndex = getCoarseGridIndex(x, y);
-    coarseGrid[coarseIndex].dynamicElements.push_back(instanceName);
+    coarseGrid[coarseIndex].dynamicElements.push_back(entity);
     
     // Add to fine grid
     int fineIndex = getFineGridIndex(x, y);
-    fineGrid[fineIndex].dynamicElements.push_back(instanceName);
+    fineGrid[fineIndex].dynamicElements.push_back(entity);
 }
 
 bool wouldEntityCollideWithElementHierarchical(float x, float y, const std::vector<std::pair<float, float>>& entityCollisionShapePoints, float entityScale, float entityRotation) {
@@ -1197,7 +1207,7 @@ bool wouldEntityCollideWithElementHierarchical(float x, float y, const std::vect
     }
     
     // Thread-safe access to hierarchical grid
-    std::vector<std::string> nearbyElements;
+    thread_local static std::vector<SymbolId> nearbyElements;
     {
         std::lock_guard<std::mutex> lock(g_hierarchicalGridMutex);
         // Initialize hierarchical grid if needed
@@ -1209,11 +1219,16 @@ bool wouldEntityCollideWithElementHierarchical(float x, float y, const std::vect
         g_hierarchicalGrid.updateGrid();
         
         // Get nearby elements using hierarchical lookup
-        nearbyElements = g_hierarchicalGrid.getElementsHierarchical(x, y, maxRadius + MAX_COLLISION_CHECK_RANGE);
+        g_hierarchicalGrid.getElementsHierarchical(x, y, maxRadius + MAX_COLLISION_CHECK_RANGE, nearbyElements);
     }
     
+    // Shape buffers come from the frame arena (the element one is reused for every candidate)
+    FrameArenaScope arenaScope;
+    FrameVector<std::pair<float, float>> entityWorldShapePoints(&frameArena());
+    FrameVector<std::pair<float, float>> elementWorldShapePoints(&frameArena());
+    entityWorldShapePoints.reserve(entityCollisionShapePoints.size());
+    
     // Transform entity polygon points to world coordinates
-    std::vector<std::pair<float, float>> entityWorldShapePoints;
     float entityAngleRad = entityRotation * M_PI / 180.0f;
     float entityCosA = cos(entityAngleRad);
     float entitySinA = sin(entityAngleRad);
@@ -1229,22 +1244,16 @@ bool wouldEntityCollideWithElementHierarchical(float x, float y, const std::vect
     }
     
     // Check collision with each nearby element
-    for (const auto& elementName : nearbyElements) {
-        const auto& elements = elementsManager.getElements();
-        const PlacedElement* currentElement = nullptr;
-        for (const auto& el : elements) {
-            if (el.instanceName == elementName) {
-                currentElement = &el;
-                break;
-            }
-        }
+    for (SymbolId element : nearbyElements) {
+        // Symbol slot lookup (this used to copy the whole elements vector per candidate)
+        const PlacedElement* currentElement = elementsManager.getElementData(element);
         
         if (!currentElement || !currentElement->hasCollision || currentElement->collisionShapePoints.empty()) {
             continue;
         }
         
         // Transform element polygon points to world coordinates
-        std::vector<std::pair<float, float>> elementWorldShapePoints;
+        elementWorldShapePoints.clear();
         float elementAngleRad = currentElement->rotation * M_PI / 180.0f;
         float elementCosA = cos(elementAngleRad);
         float elementSinA = sin(elementAngleRad);
@@ -11,6 +11,7 @@
 #include <atomic>
 #include <mutex>
 #include "enumDefinitions.h"
+#include "frameArena.h"
 
 
 // Forward declaration
@@ -25,11 +26,28 @@ bool wouldCollideWithElement(float x, float y, float playerRadius = 0.2f);
 // Function to check if an entity (using collision shape points) would collide with any element
 bool wouldEntityCollideWithElement(float x, float y, const std::vector<std::pair<float, float>>& entityCollisionShapePoints, float entityScale = 1.0f, float entityRotation = 0.0f);
 
+// Read-only view of a polygon's points: the collision helpers take heap vectors and frame arena
+// vectors (frameArena.h) alike, without copying
+struct PolygonView {
+    const std::pair<float, float>* points = nullptr;
+    size_t count = 0;
+
+    PolygonView(const std::vector<std::pair<float, float>>& polygon) : points(polygon.data()), count(polygon.size()) {}
+    PolygonView(const FrameVector<std::pair<float, float>>& polygon) : points(polygon.data()), count(polygon.size()) {}
+    PolygonView(const std::pair<float, float>* polygonPoints, size_t pointCount) : points(polygonPoints), count(pointCount) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    const std::pair<float, float>& operator[](size_t index) const { return points[index]; }
+    const std::pair<float, float>* begin() const { return points; }
+    const std::pair<float, float>* end() const { return points + count; }
+};
+
 // Helper function for polygon-polygon collision detection using Separating Axis Theorem (SAT)
-bool polygonPolygonCollision(const std::vector<std::pair<float, float>>& poly1, const std::vector<std::pair<float, float>>& poly2);
+bool polygonPolygonCollision(PolygonView poly1, PolygonView poly2);
 
 // Helper function for circle-polygon collision detection
-bool circlePolygonCollision(float circleX, float circleY, float radius, const std::vector<std::pair<float, float>>& polygon);
+bool circlePolygonCollision(float circleX, float circleY, float radius, PolygonView polygon);
 
 // Helper functions to check map boundary collisions with entity collision shapes
 bool wouldEntityCollideWithMapBounds(float x, float y, const std::vector<std::pair<float, float>>& collisionShapePoints, float entityScale = 1.0f, float entityRotation = 0.0f);
@@ -62,6 +80,33 @@ bool findSafePosition(float& x, float& y, float entityRadius, const Map& gameMap
 bool findSafePositionForEntity(float& x, float& y, const EntityConfiguration& config, const Map& gameMap, const std::string& excludeInstanceName = "");
 bool resolveEntityCollisionStuck(const std::string& entityId, float& x, float& y, const EntityConfiguration& config, const Map& gameMap);
 
+// findSafePositionForEntity as a resumable search for the time-sliced jobs (timeSlicedJobs.h):
+// step() tests at most maxProbes positions of the spiral (rings of 32 directions, 0.2 units
+// apart, up to 5 units away) and continues from there on the next call. The configuration must
+// outlive the search (EntitiesManager's configurations do).
+const int SAFE_POSITION_PROBES_PER_STEP = 32; // One ring
+
+class SafePositionSearch {
+public:
+    SafePositionSearch(float x, float y, const EntityConfiguration& config, const std::string& excludeInstanceName);
+
+    // True once the search is over (see found())
+    bool step(const Map& gameMap, int maxProbes);
+    bool found() const { return success; }
+    float getResultX() const { return resultX; }
+    float getResultY() const { return resultY; }
+
+private:
+    float originX, originY;
+    const EntityConfiguration* config;
+    std::string excludeInstanceName;
+    float radius;
+    int directionIndex = 0;
+    bool finished = false;
+    bool success = false;
+    float resultX, resultY;
+};
+
 // Functions to manage non-traversable blocks
 void addNonTraversableBlock(BlockName blockType);
 void removeNonTraversableBlock(BlockName blockType);
@@ -80,9 +125,10 @@ void updateSpatialGrid();
 std::vector<std::string> getNearbyElements(float x, float y, float radius);
 
 // Enhanced spatial partitioning for collision optimization
+// Cells hold interned instance names (symbolTable.h)
 struct SpatialCell {
-    std::vector<std::string> staticElements;  // Elements that rarely move
-    std::vector<std::string> dynamicElements; // Elements that move frequently
+    std::vector<SymbolId> staticElements;  // Elements that rarely move
+    std::vector<SymbolId> dynamicElements; // Elements that move frequently
     float lastUpdateTime = 0.0f;
     bool isDirty = true;
 };
@@ -96,8 +142,8 @@ private:    static const int COARSE_GRID_SIZE = 50;  // Large cells for broad-ph
     
     std::unordered_map<int, SpatialCell> coarseGrid;
     std::unordered_map<int, SpatialCell> fineGrid;
-    std::unordered_set<std::string> staticElementNames;
-    std::unordered_set<std::string> dynamicElementNames;
+    std::unordered_set<SymbolId> staticElementNames;
+    std::unordered_set<SymbolId> dynamicElementNames;
     
     bool isInitialized = false;
     float lastCoarseUpdateTime = 0.0f;
@@ -111,14 +157,15 @@ public:
     void markElementAsDynamic(const std::string& elementName);
     void markElementAsStatic(const std::string& elementName);
     
+    // The queries fill result (cleared first) so callers can reuse one buffer across queries
     // Fast broad-phase collision detection
-    std::vector<std::string> getBroadPhaseElements(float x, float y, float radius);
+    void getBroadPhaseElements(float x, float y, float radius, std::vector<SymbolId>& result);
     
     // Precise narrow-phase collision detection
-    std::vector<std::string> getNarrowPhaseElements(float x, float y, float radius);
+    void getNarrowPhaseElements(float x, float y, float radius, std::vector<SymbolId>& result);
     
     // Combined hierarchical lookup
-    std::vector<std::string> getElementsHierarchical(float x, float y, float radius);
+    void getElementsHierarchical(float x, float y, float radius, std::vector<SymbolId>& result);
       void clear();
     bool isEmpty() const;
     bool isInitializedState() const;
@@ -128,8 +175,8 @@ public:
 private:
     int getCoarseGridIndex(float x, float y) const;
     int getFineGridIndex(float x, float y) const;
-    void addElementToGrid(const std::string& elementName, float x, float y, bool isStatic);
-    void removeElementFromGrid(const std::string& elementName);
+    void addElementToGrid(SymbolId element, float x, float y, bool isStatic);
+    void removeElementFromGrid(SymbolId element);
 };
 
 // Global instance of hierarchical spatial grid
@@ -147,7 +194,7 @@ private:
     
     std::unordered_map<int, SpatialCell> coarseGrid;
     std::unordered_map<int, SpatialCell> fineGrid;
-    std::unordered_set<std::string> entityInstanceNames;
+    std::unordered_set<SymbolId> entityInstanceNames;
     
     bool isInitialized = false;
     float lastCoarseUpdateTime = 0.0f;
@@ -158,14 +205,15 @@ public:
     void updateGrid(bool forceUpdate = false);
     void updateEntityPositions();
     
+    // The queries fill result (cleared first) so callers can reuse one buffer across queries
     // Fast broad-phase entity collision detection
-    std::vector<std::string> getBroadPhaseEntities(float x, float y, float radius);
+    void getBroadPhaseEntities(float x, float y, float radius, std::vector<SymbolId>& result);
     
     // Precise narrow-phase entity collision detection
-    std::vector<std::string> getNarrowPhaseEntities(float x, float y, float radius);
+    void getNarrowPhaseEntities(float x, float y, float radius, std::vector<SymbolId>& result);
     
     // Combined hierarchical entity lookup (REPLACES getNearbyEntities)
-    std::vector<std::string> getEntitiesHierarchical(float x, float y, float radius);
+    void getEntitiesHierarchical(float x, float y, float radius, std::vector<SymbolId>& result);
     
     void addEntity(const std::string& instanceName, float x, float y);
     void removeEntity(const std::string& instanceName);
@@ -177,7 +225,7 @@ public:
 private:
     int getCoarseGridIndex(float x, float y) const;
     int getFineGridIndex(float x, float y) const;
-    void addEntityToGrid(const std::string& instanceName, float x, float y);
+    void addEntityToGrid(SymbolId entity, float x, float y);
 };
 
 // Global hierarchical entity grid instance
@@ -1,9 +1,14 @@
 #include "elementsOnMap.h"
+#include "gameLog.h"
 #include "debug.h"
 #include "globals.h" // For GRID_SIZE
+#include "timeSlicedJobs.h" // Sliced category removal
+#include "textureLoader.h"
+#include "visibleSet.h"
 #include <magic_enum.hpp>
 #include <iostream>
 #include <algorithm> // Added for std::find_if
+#include <memory>
 #include "enumDefinitions.h"
 
 
@@ -163,18 +168,53 @@ ElementsOnMap::~ElementsOnMap() {
     // Elements vector will be cleared automatically
 }
 
+void ElementsOnMap::prefetchTextures() {
+    if (HEADLESS_MODE) {
+        return;
+    }
+    std::vector<std::string> paths;
+    for (const auto& texInfo : elementTexturesToLoad) {
+        paths.push_back(texInfo.path);
+    }
+    TextureLoader::getInstance().prefetch(paths);
+}
+
 bool ElementsOnMap::init(glbasimac::GLBI_Engine& engine) {
     bool allLoaded = true;
     
+    // Decode every element texture in parallel (reusing the decodes started by prefetchTextures)
+    // and upload them as they finish. Headless: loadTexture reads the image headers below.
+    std::vector<TextureLoadResult> loadedTextures;
+    if (!HEADLESS_MODE) {
+        std::vector<std::string> paths;
+        for (const auto& texInfo : elementTexturesToLoad) {
+            paths.push_back(texInfo.path);
+        }
+        loadedTextures = TextureLoader::getInstance().loadTextures(paths, "elements");
+    }
+    
+    size_t textureIndex = 0;
     for (auto texInfo : elementTexturesToLoad) { // Copy to modify
         // Create a mutable copy of the texture info
         ElementInfo textureDetails = texInfo;
         
-        // Load the texture and get dimensions
-        int width, height;
-        GLuint textureID = loadTexture(texInfo.path);
+        // Get the texture and its dimensions
+        GLuint textureID = 0;
+        if (HEADLESS_MODE) {
+            textureID = loadTexture(texInfo.path);
+        } else {
+            const TextureLoadResult& loaded = loadedTextures[textureIndex];
+            textureID = loaded.textureID;
+            if (textureID > 0) {
+                textureDimensions[texInfo.name] = std::make_pair(loaded.width, loaded.height);
+            }
+        }
+        textureIndex++;
+        
+        // Headless simulation: no texture is uploaded, only the dimensions are recorded
+        bool headlessLoaded = HEADLESS_MODE && textureDimensions.find(texInfo.name) != textureDimensions.end();
         
-        if (textureID > 0) {
+        if (textureID > 0 || headlessLoaded) {
             // Store the texture ID and dimensions in our local copy
             textureDetails.textureID = textureID;
             
@@ -183,10 +223,10 @@ bool ElementsOnMap::init(glbasimac::GLBI_Engine& engine) {
             if (dimIt != textureDimensions.end()) {
                 textureDetails.totalWidth = dimIt->second.first;
                 textureDetails.totalHeight = dimIt->second.second;
-                  std::cout << "Loaded element texture: " << texInfo.path 
+                  GAME_LOG_INFO("Loaded element texture: " << texInfo.path 
                           << " (ID: " << textureID 
                           << ", Dimensions: " << textureDetails.totalWidth 
-                          << "x" << textureDetails.totalHeight << ")" << std::endl;
+                          << "x" << textureDetails.totalHeight << ")");
                 
                 // For sprite sheets, calculate number of frames per row
                 if (textureDetails.type == ElementTextureType::SPRITESHEET && 
@@ -196,21 +236,29 @@ bool ElementsOnMap::init(glbasimac::GLBI_Engine& engine) {
                     int framesPerRow = textureDetails.totalWidth / textureDetails.spriteWidth;
                     int numRows = textureDetails.totalHeight / textureDetails.spriteHeight;
                     
-                    std::cout << "Sprite sheet details for " << static_cast<int>(texInfo.name) << ": " 
+                    GAME_LOG_INFO("Sprite sheet details for " << static_cast<int>(texInfo.name) << ": " 
                               << framesPerRow << " frames per row, " 
                               << numRows << " rows, "
                               << "spriteWidth=" << textureDetails.spriteWidth << ", "
-                              << "spriteHeight=" << textureDetails.spriteHeight << std::endl;
+                              << "spriteHeight=" << textureDetails.spriteHeight);
                 }
             }
               // Store in the textureIDs map for backward compatibility
-            textureIDs[texInfo.name] = textureID;
+            if (textureID > 0) {
+                textureIDs[texInfo.name] = textureID;
+            }
         } else {
-if (DEBUG_LOGS) { std::cerr << "Failed to load element texture: " << texInfo.path << std::endl; }
+GAME_LOG_DEBUG("Failed to load element texture: " << texInfo.path);
             allLoaded = false;
         }
     }
     
+    // Per-ElementName texture table for the sprite batch, then the instanced renderer
+    refreshSpriteLayouts();
+    if (!HEADLESS_MODE) {
+        spriteRenderer.init();
+    }
+    
     return allLoaded;
 }
 
@@ -219,34 +267,8 @@ GLuint ElementsOnMap::loadTexture(const std::string& path) {
     // In map.cpp, it's set to true, so we'll do the same here
     stbi_set_flip_vertically_on_load(true); // Match map.cpp setting
     
-    // Load image using stb_image
-    int width, height, channels;
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-    
-    if (!data) {
-if (DEBUG_LOGS) { std::cerr << "Failed to load texture: " << path << " (" << stbi_failure_reason() << ")" << std::endl; }
-        return 0;
-    }
-    
-    // Create and bind an OpenGL texture
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    // Set texture parameters for pixel art (GL_NEAREST)
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    // Upload the texture data
-    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    
-    // Store dimensions for later use (aspect ratio calculation)
-    ElementName currentBlockName = ElementName::COCONUT_TREE_1; // Default
-    
     // Find which texture we're currently loading
+    ElementName currentBlockName = ElementName::COCONUT_TREE_1; // Default
     for (const auto& texInfo : elementTexturesToLoad) {
         if (texInfo.path == path) {
             currentBlockName = texInfo.name;
@@ -254,13 +276,28 @@ if (DEBUG_LOGS) { std::cerr << "Failed to load texture: " << path << " (" << stb
         }
     }
     
-    textureDimensions[currentBlockName] = std::make_pair(width, height);
+    int width, height, channels;
     
-    // Free the image data
-    stbi_image_free(data);
+    // Headless simulation: read the image header only, no GL context to upload to
+    if (HEADLESS_MODE) {
+        if (stbi_info(path.c_str(), &width, &height, &channels)) {
+            textureDimensions[currentBlockName] = std::make_pair(width, height);
+        } else {
+GAME_LOG_DEBUG("Failed to read texture header: " << path << " (" << stbi_failure_reason() << ")");
+        }
+        return 0;
+    }
     
-    // Unbind the texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Same decode and upload as the batch in init
+    TextureLoadResult loaded = TextureLoader::getInstance().loadTexture(path);
+    if (loaded.textureID == 0) {
+GAME_LOG_DEBUG("Failed to load texture: " << path << " (" << loaded.error << ")");
+        return 0;
+    }
+    GLuint textureID = loaded.textureID;
+    
+    // Store dimensions for later use (aspect ratio calculation)
+    textureDimensions[currentBlockName] = std::make_pair(loaded.width, loaded.height);
     
     return textureID;
 }
@@ -272,24 +309,24 @@ void ElementsOnMap::placeElement(const std::string& instanceName, ElementName el
                                AnchorPoint anchorPoint, float anchorOffsetX, float anchorOffsetY) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Check if an element with this name already exists by searching directly
-    // This is more reliable than using elementIndexMap which becomes stale after sorting
-    auto existingIt = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
-        
-    if (existingIt != elements.end()) {
-        if (DEBUG_LOGS) {
-            std::cerr << "WARNING: Element with name '" << instanceName << "' already exists" << std::endl;
-            std::cerr << "  Details: position=(" << existingIt->x << "," << existingIt->y 
-                      << "), texture=" << static_cast<int>(existingIt->elementName) << std::endl;
-            std::cerr << "To modify the existing element, use functions like changeElementCoordinates() instead." << std::endl;
+    // Check if an element with this name already exists. The indices in elementIndexMap go stale
+    // after removals, but its keys always track the live names, so the lookup is safe here and
+    // keeps bulk placement (terrain decoration) from going quadratic.
+    if (elementIndexMap.find(instanceName) != elementIndexMap.end()) {
+        if (GAME_LOG_DEBUG_ENABLED()) {
+            auto existingIt = findElementLocked(instanceName);
+            GAME_LOG_DEBUG("WARNING: Element with name '" << instanceName << "' already exists");
+            if (existingIt != elements.end()) {
+                GAME_LOG_DEBUG("  Details: position=(" << existingIt->x << "," << existingIt->y 
+                          << "), texture=" << static_cast<int>(existingIt->elementName));
+            }
+            GAME_LOG_DEBUG("To modify the existing element, use functions like changeElementCoordinates() instead.");
         }
         return;
     }// Create a PlacedElement explicitly instead of using initializer list (C++11 compatibility)
     PlacedElement element;
     element.instanceName = instanceName;
+    element.symbol = internSymbol(instanceName);
     element.elementName = elementName;
     element.scale = scale;    element.x = x;
     element.y = y;
@@ -351,67 +388,115 @@ void ElementsOnMap::placeElement(const std::string& instanceName, ElementName el
     }
     
     // Add element to vector and update the index map
+    element.animationTime = animationClock;
     size_t newIndex = elements.size();
     elements.push_back(element);
+    updateSymbolSlots(newIndex);
     elementIndexMap[instanceName] = newIndex;
+    addToChunkGrid(element);
     
-    std::cout << "Placed element: " << instanceName << " (Texture: " 
-              << static_cast<int>(elementName) << ") at (" << x << ", " << y 
-              << ") with scale " << scale;
-              
     if (isSpritesheet) {
-        std::cout << ", phase: " << spriteSheetPhase 
-                  << ", frame: " << spriteSheetFrame
-                  << ", animated: " << (isAnimated ? "yes" : "no")
-                  << ", frames in phase: " << element.numFramesInPhase;
+        GAME_LOG_DEBUG("Placed element: " << instanceName << " (Texture: " 
+                       << static_cast<int>(elementName) << ") at (" << x << ", " << y 
+                       << ") with scale " << scale
+                       << ", phase: " << spriteSheetPhase 
+                       << ", frame: " << spriteSheetFrame
+                       << ", animated: " << (isAnimated ? "yes" : "no")
+                       << ", frames in phase: " << element.numFramesInPhase);
+    } else {
+        GAME_LOG_DEBUG("Placed element: " << instanceName << " (Texture: " 
+                       << static_cast<int>(elementName) << ") at (" << x << ", " << y 
+                       << ") with scale " << scale);
+    }
+}
+
+void ElementsOnMap::restorePlacedElement(const PlacedElement& savedElement) {
+    std::lock_guard<std::mutex> lock(elementsMutex);
+    
+    if (elementIndexMap.find(savedElement.instanceName) != elementIndexMap.end()) {
+GAME_LOG_DEBUG("WARNING: Element with name '" << savedElement.instanceName << "' already exists, not restored");
+        return;
+    }
+    
+    PlacedElement element;
+    element.instanceName = savedElement.instanceName;
+    element.symbol = internSymbol(element.instanceName);
+    element.elementName = savedElement.elementName;
+    element.scale = savedElement.scale;
+    element.x = savedElement.x;
+    element.y = savedElement.y;
+    element.rotation = savedElement.rotation;
+    element.anchorPoint = savedElement.anchorPoint;
+    element.anchorOffsetX = savedElement.anchorOffsetX;
+    element.anchorOffsetY = savedElement.anchorOffsetY;
+    element.scaleOffsetX = savedElement.scaleOffsetX;
+    element.scaleOffsetY = savedElement.scaleOffsetY;
+    element.spriteSheetPhase = savedElement.spriteSheetPhase;
+    element.spriteSheetFrame = savedElement.spriteSheetFrame;
+    element.isAnimated = savedElement.isAnimated;
+    element.animationSpeed = savedElement.animationSpeed;
+    element.currentFrameTime = 0.0f;
+    element.animationTime = animationClock;
+    
+    // Collision shape and frame count are not saved - they belong to the texture
+    for (const auto& texInfo : elementTexturesToLoad) {
+        if (texInfo.name == element.elementName) {
+            element.hasCollision = texInfo.hasCollision;
+            element.collisionShapePoints = texInfo.collisionShapePoints;
+            if (texInfo.type == ElementTextureType::SPRITESHEET && texInfo.spriteWidth > 0 &&
+                textureDimensions.find(element.elementName) != textureDimensions.end()) {
+                element.numFramesInPhase = textureDimensions[element.elementName].first / texInfo.spriteWidth;
+            }
+            break;
+        }
     }
     
-if (DEBUG_LOGS) { std::cout << std::endl; }
+    elementIndexMap[element.instanceName] = elements.size();
+    elements.push_back(element);
+    updateSymbolSlots(elements.size() - 1);
+    addToChunkGrid(element);
 }
 
 bool ElementsOnMap::changeElementCoordinates(const std::string& instanceName, float newX, float newY, float newRotation) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for moving: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for moving: " << instanceName);
         return false;
     }
     
     // Update position
+    recordMotion(*it);
+    float oldX = it->x;
+    float oldY = it->y;
     it->x = newX;
     it->y = newY;
+    moveInChunkGrid(*it, oldX, oldY);
     
     // Update rotation if provided (a value of -1.0f means keep the existing rotation)
     if (newRotation >= 0.0f) {
         it->rotation = newRotation;
     }
     
-if (DEBUG_LOGS) { std::cout << "Moved element: " << instanceName << " to (" << newX << ", " << newY << ")" << std::endl; }
+GAME_LOG_DEBUG("Moved element: " << instanceName << " to (" << newX << ", " << newY << ")");
     return true;
 }
 
 bool ElementsOnMap::moveElement(const std::string& instanceName, float deltaX, float deltaY) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // First, find the element by name directly (not using the index map)
-    // This fixes the issue with elements being sorted in drawElements
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find the element through its symbol slot
+    auto it = findElementLocked(instanceName);
     
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for relative movement: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for relative movement: " << instanceName);
         // List available elements to help debug
-if (DEBUG_LOGS) { std::cout << "Available elements:" << std::endl; }
+GAME_LOG_DEBUG("Available elements:");
         for (const auto& elem : elements) {
-if (DEBUG_LOGS) { std::cout << "  - " << elem.instanceName << " at (" << elem.x << ", " << elem.y << ")" << std::endl; }
+GAME_LOG_DEBUG("  - " << elem.instanceName << " at (" << elem.x << ", " << elem.y << ")");
         }
         return false;
     }
@@ -421,30 +506,29 @@ if (DEBUG_LOGS) { std::cout << "  - " << elem.instanceName << " at (" << elem.x
     float currentY = it->y;
     
     // Update position by adding the deltas
+    recordMotion(*it);
     it->x = currentX + deltaX;
     it->y = currentY + deltaY;
+    moveInChunkGrid(*it, currentX, currentY);
     
-    std::cout << "Moved element: " << instanceName 
+    GAME_LOG_INFO("Moved element: " << instanceName 
               << " from (" << currentX << ", " << currentY << ")"
               << " to (" << it->x << ", " << it->y << ")"
-              << " (delta: " << deltaX << ", " << deltaY << ")" << std::endl;
+              << " (delta: " << deltaX << ", " << deltaY << ")");
     return true;
     
-if (DEBUG_LOGS) { std::cerr << "Element index out of range for relative movement: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element index out of range for relative movement: " << instanceName);
     return false;
 }
 
 bool ElementsOnMap::getElementPosition(const std::string& instanceName, float& x, float& y) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find the element by name directly instead of using the index map
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find the element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for position query: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for position query: " << instanceName);
         return false;
     }
     
@@ -457,11 +541,8 @@ if (DEBUG_LOGS) { std::cerr << "Element not found for position query: " << insta
 const PlacedElement* ElementsOnMap::getElementData(const std::string& instanceName) const {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find the element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find the element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
         return nullptr;
@@ -470,14 +551,87 @@ const PlacedElement* ElementsOnMap::getElementData(const std::string& instanceNa
     return &(*it);
 }
 
+bool ElementsOnMap::getElementPosition(SymbolId symbol, float& x, float& y) {
+    std::lock_guard<std::mutex> lock(elementsMutex);
+    auto it = findElementLocked(symbol);
+    if (it == elements.end()) {
+        return false;
+    }
+    x = it->x;
+    y = it->y;
+    return true;
+}
+
+const PlacedElement* ElementsOnMap::getElementData(SymbolId symbol) const {
+    std::lock_guard<std::mutex> lock(elementsMutex);
+    auto it = findElementLocked(symbol);
+    return it == elements.end() ? nullptr : &(*it);
+}
+
+void ElementsOnMap::updateSymbolSlots(size_t firstIndex) {
+    for (size_t i = firstIndex; i < elements.size(); ++i) {
+        SymbolId symbol = elements[i].symbol;
+        if (symbol >= symbolSlots.size()) {
+            symbolSlots.resize(symbol + 1, 0);
+        }
+        symbolSlots[symbol] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+std::vector<PlacedElement>::iterator ElementsOnMap::findElementLocked(SymbolId symbol) {
+    if (symbol == INVALID_SYMBOL || symbol >= symbolSlots.size() || symbolSlots[symbol] == 0) {
+        return elements.end();
+    }
+    return elements.begin() + (symbolSlots[symbol] - 1);
+}
+
+std::vector<PlacedElement>::const_iterator ElementsOnMap::findElementLocked(SymbolId symbol) const {
+    if (symbol == INVALID_SYMBOL || symbol >= symbolSlots.size() || symbolSlots[symbol] == 0) {
+        return elements.end();
+    }
+    return elements.begin() + (symbolSlots[symbol] - 1);
+}
+
+uint64_t ElementsOnMap::elementChunkKey(int chunkX, int chunkY) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+}
+
+uint64_t ElementsOnMap::elementChunkKey(float x, float y) {
+    return elementChunkKey(VisibleSet::chunkCoordinate(x), VisibleSet::chunkCoordinate(y));
+}
+
+void ElementsOnMap::addToChunkGrid(const PlacedElement& element) {
+    elementChunks[elementChunkKey(element.x, element.y)].push_back(element.symbol);
+    maxElementScale = std::max(maxElementScale, element.scale);
+}
+
+void ElementsOnMap::removeFromChunkGrid(SymbolId symbol, float x, float y) {
+    auto chunk = elementChunks.find(elementChunkKey(x, y));
+    if (chunk == elementChunks.end()) {
+        return;
+    }
+    // Unordered: the last symbol takes the removed one's place. Emptied chunks are kept, entities
+    // walk in and out of them all the time.
+    std::vector<SymbolId>& symbols = chunk->second;
+    auto it = std::find(symbols.begin(), symbols.end(), symbol);
+    if (it != symbols.end()) {
+        *it = symbols.back();
+        symbols.pop_back();
+    }
+}
+
+void ElementsOnMap::moveInChunkGrid(const PlacedElement& element, float oldX, float oldY) {
+    if (elementChunkKey(oldX, oldY) != elementChunkKey(element.x, element.y)) {
+        removeFromChunkGrid(element.symbol, oldX, oldY);
+        elementChunks[elementChunkKey(element.x, element.y)].push_back(element.symbol);
+    }
+}
+
 bool ElementsOnMap::elementExists(const std::string& instanceName) const {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find the element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find the element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     return it != elements.end();
 }
@@ -485,14 +639,11 @@ bool ElementsOnMap::elementExists(const std::string& instanceName) const {
 bool ElementsOnMap::changeElementScale(const std::string& instanceName, float newScale) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for scaling: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for scaling: " << instanceName);
         return false;
     }
     
@@ -553,54 +704,49 @@ if (DEBUG_LOGS) { std::cerr << "Element not found for scaling: " << instanceName
     
     // Update the element's scale and scale offsets
     it->scale = newScale;
+    maxElementScale = std::max(maxElementScale, newScale);
     it->scaleOffsetX = offsetX;
     it->scaleOffsetY = offsetY;
     
-    std::cout << "Changed element scale: " << instanceName << " to " << newScale 
-              << " with scale offsets (" << offsetX << ", " << offsetY << ")" << std::endl;
+    GAME_LOG_INFO("Changed element scale: " << instanceName << " to " << newScale 
+              << " with scale offsets (" << offsetX << ", " << offsetY << ")");
     return true;
 }
 
 bool ElementsOnMap::changeElementRotation(const std::string& instanceName, float newRotation) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for rotation: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for rotation: " << instanceName);
         return false;
     }
     
     it->rotation = newRotation;
-if (DEBUG_LOGS) { std::cout << "Changed element rotation: " << instanceName << " to " << newRotation << " degrees" << std::endl; }
+GAME_LOG_DEBUG("Changed element rotation: " << instanceName << " to " << newRotation << " degrees");
     return true;
 }
 
 bool ElementsOnMap::changeElementSpriteFrame(const std::string& instanceName, int newFrame) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for changing sprite frame: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for changing sprite frame: " << instanceName);
         return false;
     }
     
     // Ensure frame is within valid range
     if (it->numFramesInPhase > 0) {
         it->spriteSheetFrame = newFrame % it->numFramesInPhase;
-if (DEBUG_LOGS) { std::cout << "Changed element sprite frame: " << instanceName << " to " << it->spriteSheetFrame << std::endl; }
+GAME_LOG_DEBUG("Changed element sprite frame: " << instanceName << " to " << it->spriteSheetFrame);
         return true;
     } else {
-if (DEBUG_LOGS) { std::cerr << "Element doesn't support sprite frames: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element doesn't support sprite frames: " << instanceName);
         return false;
     }
 }
@@ -608,16 +754,13 @@ if (DEBUG_LOGS) { std::cerr << "Element doesn't support sprite frames: " << inst
 bool ElementsOnMap::changeElementSpritePhase(const std::string& instanceName, int newPhase) {
     std::lock_guard<std::mutex> lock(elementsMutex);
 
-    std::cout << "Changing sprite phase for element: " << instanceName << std::endl;
+    GAME_LOG_INFO("Changing sprite phase for element: " << instanceName);
     
-    // Find element by name directly to handle elements being sorted in drawElements
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for changing sprite phase: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for changing sprite phase: " << instanceName);
         return false;
     }
     
@@ -633,64 +776,61 @@ if (DEBUG_LOGS) { std::cerr << "Element not found for changing sprite phase: " <
                   // Check if phase is valid
                 if (newPhase >= 0 && newPhase < numPhases) {
                     it->spriteSheetPhase = newPhase;
-                    std::cout << "Changing sprite phase for element: " << instanceName << " to " << newPhase << std::endl;
+                    GAME_LOG_INFO("Changing sprite phase for element: " << instanceName << " to " << newPhase);
                     return true;
                 } else {
-                    std::cerr << "Invalid sprite phase " << newPhase << " for element: " << instanceName 
-                            << " (valid range: 0-" << (numPhases - 1) << ")" << std::endl;
+                    GAME_LOG_ERROR("Invalid sprite phase " << newPhase << " for element: " << instanceName 
+                            << " (valid range: 0-" << (numPhases - 1) << ")");
                     return false;
                 }
             } else {
-if (DEBUG_LOGS) { std::cerr << "Element doesn't support sprite phases: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element doesn't support sprite phases: " << instanceName);
                 return false;
             }
         }
     }
     
-if (DEBUG_LOGS) { std::cerr << "Couldn't find texture info for element: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Couldn't find texture info for element: " << instanceName);
     return false;
 }
 
 bool ElementsOnMap::changeElementAnimationStatus(const std::string& instanceName, bool isAnimated) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for changing animation status: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for changing animation status: " << instanceName);
         return false;
     }
     
+    if (isAnimated && !it->isAnimated) {
+        it->animationTime = animationClock; // Start from now, not from when it was last drawn
+    }
     it->isAnimated = isAnimated;
-    std::cout << "Changed element animation status: " << instanceName 
-            << " to " << (isAnimated ? "animated" : "static") << std::endl;
+    GAME_LOG_INFO("Changed element animation status: " << instanceName 
+            << " to " << (isAnimated ? "animated" : "static"));
     return true;
 }
 
 bool ElementsOnMap::changeElementAnimationSpeed(const std::string& instanceName, float newSpeed) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for changing animation speed: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for changing animation speed: " << instanceName);
         return false;
     }
     
     if (newSpeed >= 0.0f) {
         it->animationSpeed = newSpeed;
-if (DEBUG_LOGS) { std::cout << "Changed element animation speed: " << instanceName << " to " << newSpeed << " FPS" << std::endl; }
+GAME_LOG_DEBUG("Changed element animation speed: " << instanceName << " to " << newSpeed << " FPS");
         return true;
     } else {
-if (DEBUG_LOGS) { std::cerr << "Invalid animation speed (must be non-negative): " << newSpeed << std::endl; }
+GAME_LOG_DEBUG("Invalid animation speed (must be non-negative): " << newSpeed);
         return false;
     }
 }
@@ -698,30 +838,49 @@ if (DEBUG_LOGS) { std::cerr << "Invalid animation speed (must be non-negative):
 int ElementsOnMap::getElementSpritePhase(const std::string& instanceName) const {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find element by name directly
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find element through its symbol slot
+    auto it = findElementLocked(instanceName);
         
     if (it == elements.end()) {
-if (DEBUG_LOGS) { std::cerr << "Element not found for getting sprite phase: " << instanceName << std::endl; }
+GAME_LOG_DEBUG("Element not found for getting sprite phase: " << instanceName);
         return -1; // Return -1 to indicate element not found
     }
     
     return it->spriteSheetPhase;
 }
 
-void ElementsOnMap::drawElements(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop, double deltaTime) {
+void ElementsOnMap::recordElements(const VisibleSet& visible, double deltaTime) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
+    spriteOverlays.clear();
+    overlayPoints.clear();
     if (elements.empty()) {
+        spriteBatch.clear();
         return;
     }
     
-    // Calculate the visible area size for camera view
-    float viewWidth = cameraRight - cameraLeft;
-    float viewHeight = cameraTop - cameraBottom;
+    collectSpritesLocked(visible, deltaTime, spriteBatch, &spriteElementIndices);
+    
+    // Debug overlays: what they need of each element is copied now, submitElements runs without
+    // elementsMutex and the logic thread may move or remove the elements in between
+    recordedAnchorPoints = showAnchorPoints;
+    recordedCollisionBoxes = isShowingCollisionBoxes();
+    if (recordedAnchorPoints || recordedCollisionBoxes) {
+        overlayCellWidth = (visible.endX - visible.startX) / visible.camera.getWidth();
+        overlayCellHeight = (visible.endY - visible.startY) / visible.camera.getHeight();
+        for (size_t index : spriteElementIndices) {
+            const PlacedElement& element = elements[index];
+            SpriteOverlay overlay{element.hasCollision, element.scale, overlayPoints.size(), element.collisionShapePoints.size()};
+            overlayPoints.insert(overlayPoints.end(), element.collisionShapePoints.begin(), element.collisionShapePoints.end());
+            spriteOverlays.push_back(overlay);
+        }
+    }
+}
+
+void ElementsOnMap::submitElements() {
+    if (spriteBatch.size() == 0) {
+        return;
+    }
     
     // Save current OpenGL state
     GLboolean blendEnabled;
@@ -732,58 +891,137 @@ void ElementsOnMap::drawElements(float startX, float endX, float startY, float e
     
     // Enable blending for transparent textures
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);    // Sort elements by Y-coordinate (descending) to draw from back to front
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    // One instanced draw per run of same-texture sprites, or the immediate-mode quads when the
+    // context cannot run the sprite shader (or USE_INSTANCED_SPRITES is off)
+    if (USE_INSTANCED_SPRITES && spriteRenderer.isReady()) {
+        spriteRenderer.draw(spriteBatch);
+    } else {
+        drawSpritesImmediate();
+    }
+    
+    // Debug overlays on top of the sprites
+    if (!spriteOverlays.empty()) {
+        drawSpriteDebugOverlays();
+    }
+    
+    // Restore previous OpenGL state
+    if (!blendEnabled) {
+        glDisable(GL_BLEND);
+    } else {
+        glBlendFunc(blendSrcFactor, blendDstFactor);
+    }
+}
+
+void ElementsOnMap::drawElements(const VisibleSet& visible, double deltaTime) {
+    recordElements(visible, deltaTime);
+    submitElements();
+}
+
+void ElementsOnMap::collectSprites(const VisibleSet& visible, double deltaTime, SpriteBatch& batch) {
+    std::lock_guard<std::mutex> lock(elementsMutex);
+    collectSpritesLocked(visible, deltaTime, batch, nullptr);
+}
+
+void ElementsOnMap::recordMotion(PlacedElement& element) {
+    MotionStamp stamp = currentMotionStamp();
+    if (stamp.clock == MotionClockId::NONE) {
+        // Not moved by a simulation step (placement fix-up, world load): no interpolation
+        element.motionStamp = MotionStamp();
+    } else if (element.motionStamp != stamp) {
+        element.previousX = element.x;
+        element.previousY = element.y;
+        element.motionStamp = stamp;
+    }
+}
+
+void ElementsOnMap::getDrawPosition(const PlacedElement& element, const MotionFrame& motion, float& x, float& y) {
+    // Elements moved during the latest step of their clock are drawn between the two positions
+    x = element.x;
+    y = element.y;
+    float alpha = motion.alpha(element.motionStamp);
+    if (alpha >= 0.0f) {
+        x = element.previousX + (element.x - element.previousX) * alpha;
+        y = element.previousY + (element.y - element.previousY) * alpha;
+    }
+}
+
+void ElementsOnMap::collectVisibleElements(VisibleSet& visible) const {
+    std::lock_guard<std::mutex> lock(elementsMutex);
+    
+    // A sprite reaches up to its scale past its position (isSpriteVisible), so the chunks around
+    // the view are searched too
+    float margin = maxElementScale + VISIBLE_ELEMENT_MOTION_MARGIN;
+    int firstChunkX = VisibleSet::chunkCoordinate(visible.camera.left - margin);
+    int lastChunkX = VisibleSet::chunkCoordinate(visible.camera.right + margin);
+    int firstChunkY = VisibleSet::chunkCoordinate(visible.camera.bottom - margin);
+    int lastChunkY = VisibleSet::chunkCoordinate(visible.camera.top + margin);
+    
+    SpriteView view{visible.startX, visible.endX, visible.startY, visible.endY,
+                    visible.camera.left, visible.camera.right, visible.camera.bottom, visible.camera.top};
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            auto chunk = elementChunks.find(elementChunkKey(chunkX, chunkY));
+            if (chunk == elementChunks.end()) {
+                continue;
+            }
+            for (SymbolId symbol : chunk->second) {
+                auto it = findElementLocked(symbol);
+                if (it == elements.end()) {
+                    continue;
+                }
+                float drawX, drawY;
+                getDrawPosition(*it, visible.motion, drawX, drawY);
+                if (isSpriteVisible(view, *it, drawX, drawY)) {
+                    visible.addElement(symbol);
+                }
+            }
+        }
+    }
+}
+
+void ElementsOnMap::collectSpritesLocked(const VisibleSet& visible, double deltaTime, SpriteBatch& batch, std::vector<size_t>* elementIndices) {
+    animationClock += deltaTime;
+    
+    // Sort the visible elements by Y-coordinate (descending) to draw from back to front
     // Elements with larger Y (visually higher on screen) are drawn first (behind)
     // This means elements with smaller Y (lower on screen) will be drawn on top
-    std::sort(elements.begin(), elements.end(), [](const PlacedElement& a, const PlacedElement& b) {
-        return a.y > b.y;
+    // Equal Y: placement order, so overlapping sprites never swap from one frame to the next
+    drawOrder.clear();
+    for (SymbolId symbol : visible.getElements()) {
+        auto it = findElementLocked(symbol);
+        if (it != elements.end()) { // Removed since collectVisibleElements
+            drawOrder.push_back(static_cast<size_t>(it - elements.begin()));
+        }
+    }
+    std::sort(drawOrder.begin(), drawOrder.end(), [this](size_t a, size_t b) {
+        if (elements[a].y != elements[b].y) {
+            return elements[a].y > elements[b].y;
+        }
+        return a < b;
     });
-      // Calculate the grid cell dimensions in screen coordinates
-    float cellWidth = (endX - startX) / viewWidth;
-    float cellHeight = (endY - startY) / viewHeight;
-    
-    // Since the grid is already maintained as a square in main.cpp (through offsetX/offsetY),
-    // we know that cellWidth and cellHeight should represent the same physical size.
-    // In a perfect square grid, they would be exactly equal.
-    
-    // Direct OpenGL drawing (bypassing GLBI_Engine's texture limitations)
-    for (auto& element : elements) { // Changed to non-const to update animation state
-        // Get the texture ID
-        auto it = textureIDs.find(element.elementName);
-        if (it == textureIDs.end()) {
-if (DEBUG_LOGS) { std::cerr << "Texture not found for element: " << element.instanceName << std::endl; }
+    
+    // One instance per visible element, in draw order (spriteBatch.h)
+    SpriteView view{visible.startX, visible.endX, visible.startY, visible.endY,
+                    visible.camera.left, visible.camera.right, visible.camera.bottom, visible.camera.top};
+    batch.clear();
+    if (elementIndices) {
+        elementIndices->clear();
+    }
+    for (size_t index : drawOrder) { // Non-const to update animation state
+        PlacedElement& element = elements[index];
+        const SpriteTextureLayout* layout = getSpriteLayout(element.elementName);
+        if (layout == nullptr || !layout->loaded) {
+GAME_LOG_DEBUG("Texture not found for element: " << element.instanceName);
             continue;
         }
         
-        GLuint textureID = it->second;
-        
-        // Get the texture info to check if it's a spritesheet
-        bool isSpritesheet = false;
-        int spriteWidth = 0;
-        int spriteHeight = 0;
-        int textureWidth = 0;
-        int textureHeight = 0;
-        
-        // Look up element texture info
-        for (const auto& texInfo : elementTexturesToLoad) {
-            if (texInfo.name == element.elementName) {
-                isSpritesheet = (texInfo.type == ElementTextureType::SPRITESHEET);
-                spriteWidth = texInfo.spriteWidth;
-                spriteHeight = texInfo.spriteHeight;
-                break;
-            }
-        }
-        
-        // Get total texture dimensions
-        if (textureDimensions.find(element.elementName) != textureDimensions.end()) {
-            auto dims = textureDimensions[element.elementName];
-            textureWidth = dims.first;
-            textureHeight = dims.second;
-        }
-          // Update animation frame if this is an animated spritesheet element
-        if (isSpritesheet && element.isAnimated && element.numFramesInPhase > 0) {
+        // Update animation frame if this is an animated spritesheet element, by the time since it
+        // was last drawn (deltaTime when it was in view the frame before)
+        if (layout->isSpritesheet && element.isAnimated && element.numFramesInPhase > 0) {
             // Calculate frame time based on animation speed
-            element.currentFrameTime += static_cast<float>(deltaTime);
+            element.currentFrameTime += static_cast<float>(animationClock - element.animationTime);
             float frameTime = 1.0f / element.animationSpeed; // Time per frame in seconds
             
             if (element.currentFrameTime >= frameTime) {
@@ -791,209 +1029,121 @@ if (DEBUG_LOGS) { std::cerr << "Texture not found for element: " << element.inst
                 int advanceFrames = static_cast<int>(element.currentFrameTime / frameTime);
                 element.spriteSheetFrame = (element.spriteSheetFrame + advanceFrames) % element.numFramesInPhase;
                 element.currentFrameTime = fmod(element.currentFrameTime, frameTime); // Keep remainder
-                  // Debug animation info disabled for normal gameplay
-                // Uncomment if you need to debug animation frames
-                /*
-                std::cout << "Animating " << element.instanceName 
-                          << ": phase=" << element.spriteSheetPhase
-                          << ", frame=" << element.spriteSheetFrame 
-                          << ", numFrames=" << element.numFramesInPhase
-                          << ", deltaTime=" << deltaTime << std::endl;
-                */
             }
-        }        // Skip elements that are outside the camera view
-        if (element.x < cameraLeft - element.scale || element.x > cameraRight + element.scale || 
-            element.y < cameraBottom - element.scale || element.y > cameraTop + element.scale) {
-            continue;
         }
+        element.animationTime = animationClock;
         
-        // Calculate the element's position by mapping from world coordinates to screen coordinates
-        float normalizedX = (element.x - cameraLeft) / viewWidth;
-        float normalizedY = (element.y - cameraBottom) / viewHeight;
-        
-        // Map from normalized [0,1] to screen coordinates
-        float gridX = startX + normalizedX * (endX - startX);
-        float gridY = startY + normalizedY * (endY - startY);
-          // Apply scale offsets to maintain anchor position when scaling - scaled to camera view
-        gridX += (element.scaleOffsetX / viewWidth) * (endX - startX);
-        gridY += (element.scaleOffsetY / viewHeight) * (endY - startY);// Debug can be enabled below if needed for future troubleshooting
-        // Currently disabled to prevent console spam
-        /*
-        static int debugCounter = 0;
-        if (element.instanceName.find("terrain_bush_") != std::string::npos && debugCounter++ % 1000 == 0) {
-            std::cout << "Drawing " << element.instanceName << " - World coords: ("
-                      << element.x << ", " << element.y << "), Grid cell: ("
-                      << static_cast<int>(element.x) << ", " << static_cast<int>(element.y) << ")" << std::endl;
+        float drawX, drawY;
+        getDrawPosition(element, visible.motion, drawX, drawY);
+        batch.add(layout->textureID, buildSpriteInstance(view, element, *layout, drawX, drawY));
+        if (elementIndices) {
+            elementIndices->push_back(index);
         }
-        */
-          // Calculate UV coordinates based on whether this is a spritesheet
-        float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
-        float aspectRatio = 1.0f; // Default aspect ratio
-        
-        if (isSpritesheet && spriteWidth > 0 && spriteHeight > 0 && textureWidth > 0 && textureHeight > 0) {
-            // Calculate UV coordinates for the current frame in the sprite sheet
-            float frameWidthRatio = static_cast<float>(spriteWidth) / textureWidth;
-            float frameHeightRatio = static_cast<float>(spriteHeight) / textureHeight;
-            
-            // Store the aspect ratio for the sprite (height/width)
-            aspectRatio = static_cast<float>(spriteHeight) / spriteWidth;
-              
-            // Calculate horizontal position (frame index)
-            u0 = element.spriteSheetFrame * frameWidthRatio;
-            u1 = u0 + frameWidthRatio;
+    }
+}
+
+void ElementsOnMap::drawSpritesImmediate() const {
+    // One textured quad per sprite through the matrix stack (the renderer before instancing)
+    glEnable(GL_TEXTURE_2D);
+    glMatrixMode(GL_MODELVIEW);
+    for (const SpriteRun& run : spriteBatch.getRuns()) {
+        glBindTexture(GL_TEXTURE_2D, run.textureID);
+        for (size_t index = run.first; index < run.first + run.count; ++index) {
+            const SpriteInstance& sprite = spriteBatch.getInstances()[index];
             
-            // Calculate vertical position (animation phase/row)
-            // With stbi_set_flip_vertically_on_load(true), the image is already flipped
-            // so we need to adjust our sprite sheet row calculation accordingly
-            int numRows = textureHeight / spriteHeight;
-            if (numRows <= 0) numRows = 1; // Ensure we don't divide by zero
+            // Set color to white to preserve texture colors
+            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+            glPushMatrix();
+            glTranslatef(sprite.centerX, sprite.centerY, 0.0f);
+            if (sprite.rotationSin != 0.0f || sprite.rotationCos != 1.0f) {
+                GLfloat rotation[16];
+                spriteRotationMatrix(sprite, rotation);
+                glMultMatrixf(rotation);
+            }
+            glTranslatef(-sprite.anchorX, -sprite.anchorY, 0.0f);
             
-            // Since stbi_set_flip_vertically_on_load(true) flips the image,
-            // in OpenGL coordinates, row 0 is at the bottom
-            v0 = element.spriteSheetPhase * frameHeightRatio;
-            v1 = v0 + frameHeightRatio;  // Move up one row height
-              // Debug output disabled for normal gameplay
-            // Uncomment if you need to debug UV coordinates
-            /*
-            std::cout << "Element " << element.instanceName 
-                      << " UV coords: (" << u0 << "," << v0 << ") to (" 
-                      << u1 << "," << v1 << "), numRows=" << numRows 
-                      << ", phase=" << element.spriteSheetPhase << std::endl;
-            */
-        }
-          // Calculate element quad dimensions
-        float halfWidth_ndc = (cellWidth * element.scale) / 2.0f;
-        float halfHeight_ndc = (cellHeight * element.scale) / 2.0f;
-        
-        // Apply aspect ratio for sprite sheets to maintain correct proportions
-        if (isSpritesheet) {
-            halfHeight_ndc *= aspectRatio;
-        }
-        
-        // Calculate anchor point offset based on the selected anchor point
-        float anchorX = 0.0f;
-        float anchorY = 0.0f;
-          switch(element.anchorPoint) {
-            case AnchorPoint::CENTER:
-                // Default center anchor - no offset needed
-                break;
-            case AnchorPoint::TOP_LEFT_CORNER:
-                anchorX = -halfWidth_ndc;
-                anchorY = halfHeight_ndc;
-                break;
-            case AnchorPoint::TOP_RIGHT_CORNER:
-                anchorX = halfWidth_ndc;
-                anchorY = halfHeight_ndc;
-                break;
-            case AnchorPoint::BOTTOM_LEFT_CORNER:
-                anchorX = -halfWidth_ndc;
-                anchorY = -halfHeight_ndc;
-                break;
-            case AnchorPoint::BOTTOM_RIGHT_CORNER:
-                anchorX = halfWidth_ndc;
-                anchorY = -halfHeight_ndc;
-                break;
-            case AnchorPoint::BOTTOM_CENTER:
-                anchorX = 0.0f; // Centered horizontally
-                anchorY = -halfHeight_ndc; // Bottom aligned
-                break;
+            // Top-left, top-right, bottom-right, bottom-left (clockwise order, like the map)
+            glBegin(GL_QUADS);
+                glTexCoord2f(sprite.u0, sprite.v1); glVertex2f(-sprite.halfWidth,  sprite.halfHeight);
+                glTexCoord2f(sprite.u1, sprite.v1); glVertex2f( sprite.halfWidth,  sprite.halfHeight);
+                glTexCoord2f(sprite.u1, sprite.v0); glVertex2f( sprite.halfWidth, -sprite.halfHeight);
+                glTexCoord2f(sprite.u0, sprite.v0); glVertex2f(-sprite.halfWidth, -sprite.halfHeight);
+            glEnd();
+            glPopMatrix();
         }
-          // Apply additional anchor offsets (in screen space) - scaled to camera view
-        float additionalOffsetX = (element.anchorOffsetX / viewWidth) * (endX - startX);
-        float additionalOffsetY = (element.anchorOffsetY / viewHeight) * (endY - startY);
-        anchorX += additionalOffsetX;
-        anchorY += additionalOffsetY;
-        
-        // Bind texture
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        
-        // Set color to white to preserve texture colors
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+}
+
+void ElementsOnMap::drawSpriteDebugOverlays() const {
+    glMatrixMode(GL_MODELVIEW);
+    for (size_t index = 0; index < spriteOverlays.size(); ++index) {
+        const SpriteInstance& sprite = spriteBatch.getInstances()[index];
+        const SpriteOverlay& overlay = spriteOverlays[index];
         
-        // Save matrix state
-        glMatrixMode(GL_MODELVIEW);
+        // Same frame as the sprite: the anchor point is at (anchorX, anchorY) in it
         glPushMatrix();
-        
-        // Translate to element position
-        glTranslatef(gridX, gridY, 0.0f);
-        
-        // Rotate if needed
-        if (element.rotation != 0.0f) {
-            glRotatef(element.rotation, 0.0f, 0.0f, 1.0f);
+        glTranslatef(sprite.centerX, sprite.centerY, 0.0f);
+        if (sprite.rotationSin != 0.0f || sprite.rotationCos != 1.0f) {
+            GLfloat rotation[16];
+            spriteRotationMatrix(sprite, rotation);
+            glMultMatrixf(rotation);
         }
+        glTranslatef(-sprite.anchorX, -sprite.anchorY, 0.0f);
         
-        // Apply anchor point offset (this effectively changes where the element is positioned)
-        glTranslatef(-anchorX, -anchorY, 0.0f);        // Draw textured quad centered at origin using calculated UV coordinates
-        // Use a consistent vertex order that matches map rendering
-        // Map renders in clockwise order starting from top-left
-        glBegin(GL_QUADS);
-            // Normal rendering
-            // Top-left, top-right, bottom-right, bottom-left (clockwise order)
-            glTexCoord2f(u0, v1); glVertex2f(-halfWidth_ndc,  halfHeight_ndc);  // Top-left
-            glTexCoord2f(u1, v1); glVertex2f( halfWidth_ndc,  halfHeight_ndc);  // Top-right
-            glTexCoord2f(u1, v0); glVertex2f( halfWidth_ndc, -halfHeight_ndc);  // Bottom-right
-            glTexCoord2f(u0, v0); glVertex2f(-halfWidth_ndc, -halfHeight_ndc);  // Bottom-left
-        glEnd();
-        
-        // Unbind texture
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glDisable(GL_TEXTURE_2D);        // Draw anchor point indicator if visualization is enabled
-        if (showAnchorPoints) {
-            // Calculate the actual position of the anchor point
-            float anchorPosX = anchorX;
-            float anchorPosY = anchorY;
-            
-            // Draw the anchor point using the debug function
-            drawAnchorPoint(anchorPosX, anchorPosY);
+        if (recordedAnchorPoints) {
+            drawAnchorPoint(sprite.anchorX, sprite.anchorY);
         }
-          // Draw collision box if visualization is enabled and this element has collision
-        if (isShowingCollisionBoxes() && element.hasCollision) {
-            // Scale the collision radius to match the grid cell dimensions
-
-            // Draw the collision polygon centered on the anchor point
-            // The anchor point is at (anchorX, anchorY) before the -anchorX, -anchorY translation,
-            // so in the current coordinate system, we need to draw at (anchorX, anchorY)
-            
-            // Set color for collision box (e.g., red)
-            glColor4f(1.0f, 0.0f, 0.0f, 1.0f); // Red color
-
-            glMatrixMode(GL_MODELVIEW);
+        
+        // Collision polygon centred on the anchor point, in red
+        if (recordedCollisionBoxes && overlay.hasCollision) {
+            glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
             glPushMatrix();
-            // Translate to the anchor point of the element where the collision shape should be centered
-            glTranslatef(anchorX, anchorY, 0.0f);
-
-            // Draw the polygon using GL_LINE_LOOP
+            glTranslatef(sprite.anchorX, sprite.anchorY, 0.0f);
             glBegin(GL_LINE_LOOP);
-            if (!element.collisionShapePoints.empty()) {
-                for (const auto& point : element.collisionShapePoints) {
-                    // Scale points by element.scale first, then by cell dimensions
-                    // to convert from local element units (defined in collisionShapePoints)
-                    // to screen/grid units for drawing.
-                    float polyX = (point.first * element.scale) * cellWidth; 
-                    float polyY = (point.second * element.scale) * cellHeight; 
-                    glVertex2f(polyX, polyY);
-                }
+            for (size_t point = overlay.firstPoint; point < overlay.firstPoint + overlay.pointCount; ++point) {
+                // Local element units -> grid units (element scale, then cell size)
+                glVertex2f((overlayPoints[point].first * overlay.scale) * overlayCellWidth,
+                           (overlayPoints[point].second * overlay.scale) * overlayCellHeight);
             }
             glEnd();
-
             glPopMatrix();
-            // Restore original color if needed (e.g., white for textures)
-            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
         }
         
-        // Restore matrix state
         glPopMatrix();
     }
-    
-    // Restore previous OpenGL state
-    if (!blendEnabled) {
-        glDisable(GL_BLEND);
-    } else {
-        glBlendFunc(blendSrcFactor, blendDstFactor);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+void ElementsOnMap::refreshSpriteLayouts() {
+    spriteLayouts.assign(magic_enum::enum_count<ElementName>(), SpriteTextureLayout());
+    for (const auto& texInfo : elementTexturesToLoad) {
+        size_t slot = static_cast<size_t>(texInfo.name);
+        if (slot >= spriteLayouts.size()) {
+            continue;
+        }
+        SpriteTextureLayout& layout = spriteLayouts[slot];
+        auto idIt = textureIDs.find(texInfo.name);
+        layout.textureID = idIt != textureIDs.end() ? idIt->second : 0;
+        // Headless tools only measure the textures: their elements are batched with texture 0
+        layout.loaded = layout.textureID != 0 || (HEADLESS_MODE && textureDimensions.count(texInfo.name) > 0);
+        layout.isSpritesheet = texInfo.type == ElementTextureType::SPRITESHEET;
+        layout.spriteWidth = texInfo.spriteWidth;
+        layout.spriteHeight = texInfo.spriteHeight;
+        auto dimIt = textureDimensions.find(texInfo.name);
+        if (dimIt != textureDimensions.end()) {
+            layout.textureWidth = dimIt->second.first;
+            layout.textureHeight = dimIt->second.second;
+        }
     }
 }
 
+const SpriteTextureLayout* ElementsOnMap::getSpriteLayout(ElementName elementName) const {
+    size_t slot = static_cast<size_t>(elementName);
+    return slot < spriteLayouts.size() ? &spriteLayouts[slot] : nullptr;
+}
+
 void ElementsOnMap::listElements() const {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
@@ -1067,49 +1217,48 @@ if (DEBUG_LOGS) { std::cout << "================================================
 bool ElementsOnMap::removeElement(const std::string& instanceName) {
     std::lock_guard<std::mutex> lock(elementsMutex);
     
-    // Find the element by name directly in the elements vector
-    // This approach is immune to sorting operations in drawElements()
-    auto it = std::find_if(elements.begin(), elements.end(),
-        [&instanceName](const PlacedElement& element) {
-            return element.instanceName == instanceName;
-        });
+    // Find the element through its symbol slot
+    auto it = findElementLocked(instanceName);
     
     if (it == elements.end()) {
         // Element not found, return false
-        if (DEBUG_LOGS) {
-            std::cerr << "Element not found for removal: " << instanceName << std::endl;
-        }
+        GAME_LOG_DEBUG("Element not found for removal: " << instanceName);
         return false;
     }
     
-    // Remove the element from the elements vector
+    // Remove the element from the elements vector; everything after it shifts down one slot
+    size_t erasedIndex = static_cast<size_t>(it - elements.begin());
+    removeFromChunkGrid(it->symbol, it->x, it->y);
+    symbolSlots[it->symbol] = 0;
     elements.erase(it);
+    updateSymbolSlots(erasedIndex);
     
     // Remove from the index map if it exists (cleanup)
     elementIndexMap.erase(instanceName);
     
-    if (DEBUG_LOGS) {
-        std::cout << "Successfully removed element: " << instanceName << std::endl;
-    }
+    GAME_LOG_DEBUG("Successfully removed element: " << instanceName);
     
     return true;
 }
 
 // Implementation of removeAllElementsByCategory method to remove elements by category prefix
 int ElementsOnMap::removeAllElementsByCategory(const std::string& category) {
-    std::lock_guard<std::mutex> lock(elementsMutex);
-    
     int removedCount = 0;
     
     // Create a temporary list of element names to remove
     std::vector<std::string> elementsToRemove;
     
-    // Identify elements that match the category prefix
-    for (const auto& element : elements) {
-        // Check if the element's instanceName starts with the category prefix
-        // For terrain elements, they have names like "terrain_coconut_tree_X"
-        if (element.instanceName.find(category) == 0) {
-            elementsToRemove.push_back(element.instanceName);
+    // CRASH FIX: only hold the lock while collecting the names - removeElement locks
+    // elementsMutex itself, so removing with the lock held deadlocked on the first match
+    {
+        std::lock_guard<std::mutex> lock(elementsMutex);
+        // Identify elements that match the category prefix
+        for (const auto& element : elements) {
+            // Check if the element's instanceName starts with the category prefix
+            // For terrain elements, they have names like "terrain_coconut_tree_X"
+            if (element.instanceName.find(category) == 0) {
+                elementsToRemove.push_back(element.instanceName);
+            }
         }
     }
     
@@ -1122,9 +1271,45 @@ int ElementsOnMap::removeAllElementsByCategory(const std::string& category) {
     
     // Log how many elements were removed
     if (removedCount > 0) {
-        std::cout << "Removed " << removedCount << " elements with category prefix '" 
-                  << category << "'" << std::endl;
+        GAME_LOG_INFO("Removed " << removedCount << " elements with category prefix '" 
+                  << category << "'");
     }
     
     return removedCount;
 }
+
+void ElementsOnMap::removeAllElementsByCategorySliced(const std::string& category, std::function<void(int)> onDone) {
+    std::shared_ptr<std::vector<std::string>> elementsToRemove = std::make_shared<std::vector<std::string>>();
+    {
+        std::lock_guard<std::mutex> lock(elementsMutex);
+        for (const auto& element : elements) {
+            if (element.instanceName.find(category) == 0) {
+                elementsToRemove->push_back(element.instanceName);
+            }
+        }
+    }
+    
+    // Every removal erases from the middle of the elements vector: thousands of them in one tick
+    // were a visible hitch on map regeneration
+    std::shared_ptr<size_t> next = std::make_shared<size_t>(0);
+    std::shared_ptr<int> removedCount = std::make_shared<int>(0);
+    g_timeSlicedJobs.submit("Remove elements by category", [this, category, elementsToRemove, next, removedCount, onDone]() {
+        size_t end = std::min(elementsToRemove->size(), *next + ELEMENTS_REMOVED_PER_JOB_STEP);
+        for (; *next < end; ++*next) {
+            if (removeElement((*elementsToRemove)[*next])) {
+                ++*removedCount;
+            }
+        }
+        if (*next < elementsToRemove->size()) {
+            return JobStep::CONTINUE;
+        }
+        if (*removedCount > 0) {
+            GAME_LOG_INFO("Removed " << *removedCount << " elements with category prefix '" 
+                      << category << "'");
+        }
+        if (onDone) {
+            onDone(*removedCount);
+        }
+        return JobStep::DONE;
+    });
+}
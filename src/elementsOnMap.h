@@ -7,9 +7,15 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <mutex>
+#include <functional>
 #include "enumDefinitions.h"
 #include "collisionCache.h"
+#include "symbolTable.h"
+#include "spriteBatch.h"
+#include "spriteRenderer.h"
+#include "motionInterpolation.h"
 
 
 // Define an enum for texture types
@@ -49,12 +55,19 @@ struct ElementInfo {
 // Struct to hold placed element information
 struct PlacedElement {
     std::string instanceName; // Unique name for this instance (e.g., "bush1")
+    SymbolId symbol = INVALID_SYMBOL; // Interned instanceName (set when the element is placed)
     ElementName elementName;
     float scale;
     float x; // Grid-relative float coordinates (e.g., 0.5 for center of cell 0)
     float y;
     float rotation = 0.0f; // Optional: rotation angle in degrees
     
+    // Render interpolation (motionInterpolation.h): position before the simulation step that last
+    // moved the element, and that step (no clock: drawn at x, y)
+    float previousX = 0.0f;
+    float previousY = 0.0f;
+    MotionStamp motionStamp;
+    
     // Anchor point properties
     AnchorPoint anchorPoint = AnchorPoint::CENTER; // Default to center
     float anchorOffsetX = 0.0f;                    // Additional X offset from anchor point
@@ -69,6 +82,7 @@ struct PlacedElement {
     bool isAnimated = false;      // Whether to automatically animate this element
     float animationSpeed = 10.0f; // Frames per second for animation
     float currentFrameTime = 0.0f; // Time accumulator for animation
+    double animationTime = 0.0;    // Animation clock the frame was last advanced at (off-screen elements catch up when they come into view)
     int numFramesInPhase = 0;     // Number of frames in current animation phase (calculated)
       // Collision properties
     bool hasCollision = false;    // Whether this element has collision detection
@@ -78,12 +92,23 @@ struct PlacedElement {
     mutable PreCalculatedCollisionBox cachedCollisionBox;
 };
 
+// Elements removed per time-sliced job step by removeAllElementsByCategorySliced
+const size_t ELEMENTS_REMOVED_PER_JOB_STEP = 64;
+
+// Extra distance searched around the view for elements: an element is filed under the chunk of
+// its position, and is drawn up to one simulation step behind it (motionInterpolation.h)
+const float VISIBLE_ELEMENT_MOTION_MARGIN = 2.0f;
+
+class VisibleSet;
+
 // Main class to handle elements on the map
 class ElementsOnMap {
 public:
     ElementsOnMap();
     ~ElementsOnMap();
 
+    // Start decoding the element textures in the background (init picks the decodes up)
+    void prefetchTextures();
     // Initialize the manager and load textures
     bool init(glbasimac::GLBI_Engine& engine);
       // Debug functions
@@ -96,11 +121,19 @@ public:
                       bool isAnimated = false, float animationSpeed = 10.0f,
                       AnchorPoint anchorPoint = AnchorPoint::USE_TEXTURE_DEFAULT,
                       float anchorOffsetX = 0.0f, float anchorOffsetY = 0.0f);
+    // Re-create an element exactly as it was saved (world saves). Collision data and frame count
+    // come from the texture definition like in placeElement.
+    void restorePlacedElement(const PlacedElement& savedElement);
+
       // Remove an element by its instance name
     bool removeElement(const std::string& instanceName);
     
     // Remove all elements with a specific category prefix in their instanceName
     int removeAllElementsByCategory(const std::string& category);
+    // Same, as a time-sliced job (timeSlicedJobs.h): ELEMENTS_REMOVED_PER_JOB_STEP elements per
+    // step, then onDone(removedCount) on the tick thread. The names are collected right away, so
+    // elements placed afterwards are never removed by it.
+    void removeAllElementsByCategorySliced(const std::string& category, std::function<void(int)> onDone);
     
     // Move an existing element to a new position
     bool changeElementCoordinates(const std::string& instanceName, float newX, float newY, float newRotation = -1.0f);
@@ -109,9 +142,12 @@ public:
     bool moveElement(const std::string& instanceName, float deltaX, float deltaY);
       // Get element position
     bool getElementPosition(const std::string& instanceName, float& x, float& y);
+    // Same, by interned instance name (per-tick paths: no string hashing)
+    bool getElementPosition(SymbolId symbol, float& x, float& y);
     
     // Get element data by instance name
     const PlacedElement* getElementData(const std::string& instanceName) const;
+    const PlacedElement* getElementData(SymbolId symbol) const;
     
     // Check if an element exists by instance name
     bool elementExists(const std::string& instanceName) const;
@@ -137,8 +173,21 @@ public:
     // Get current sprite phase of an element
     int getElementSpritePhase(const std::string& instanceName) const;
 
-    // Draw all placed elements
-    void drawElements(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop, double deltaTime = 0.0);
+    // Add the elements in view to the frame's visible set: the chunks around the view are looked
+    // up in the element chunk grid, and only their elements are tested against the camera
+    void collectVisibleElements(VisibleSet& visible) const;
+    
+    // Draw the elements of the visible set (collectVisibleElements)
+    void drawElements(const VisibleSet& visible, double deltaTime = 0.0);
+    // drawElements in two halves (renderCommands.h): recordElements builds the sprite batch and
+    // copies what the debug overlays need without touching OpenGL (render worker), submitElements
+    // draws them (GL thread) and no longer reads the elements
+    void recordElements(const VisibleSet& visible, double deltaTime);
+    void submitElements();
+    
+    // drawElements' per-frame work without OpenGL: sort, advance the animations and build the
+    // sprite batch of the visible set (headless tools and benchmarks)
+    void collectSprites(const VisibleSet& visible, double deltaTime, SpriteBatch& batch);
     
     // Get texture dimensions for the specified texture
     std::pair<int, int> getTextureDimensions(ElementName elementName) const {
@@ -179,9 +228,70 @@ private:
     std::vector<PlacedElement> elements;
     std::map<ElementName, GLuint> textureIDs; // Direct OpenGL texture handles
     std::map<std::string, size_t> elementIndexMap; // Maps element name to index in elements vector
+    // SymbolId -> index + 1 in elements (0 = not placed). Unlike elementIndexMap this is kept
+    // exact: refreshed after every erase.
+    std::vector<uint32_t> symbolSlots;
+    void updateSymbolSlots(size_t firstIndex);
+    // Element lookups (elementsMutex must be held); return elements.end() when not placed
+    std::vector<PlacedElement>::iterator findElementLocked(SymbolId symbol);
+    std::vector<PlacedElement>::const_iterator findElementLocked(SymbolId symbol) const;
+    std::vector<PlacedElement>::iterator findElementLocked(const std::string& instanceName) {
+        return findElementLocked(findSymbol(instanceName));
+    }
+    std::vector<PlacedElement>::const_iterator findElementLocked(const std::string& instanceName) const {
+        return findElementLocked(findSymbol(instanceName));
+    }
+    // Before changing the position of an element: keep the position it had before the current
+    // simulation step (first move of the element in this step only)
+    static void recordMotion(PlacedElement& element);
+    
+    // Element chunk grid (visibleSet.h): the symbols of the elements whose position is in each
+    // chunk (CHUNK_SIZE blocks, any coordinate), kept up to date by every placement, move and
+    // removal (elementsMutex must be held)
+    std::unordered_map<uint64_t, std::vector<SymbolId>> elementChunks;
+    float maxElementScale = 0.0f; // Largest scale ever placed: how far a sprite reaches past its chunk
+    static uint64_t elementChunkKey(int chunkX, int chunkY);
+    static uint64_t elementChunkKey(float x, float y);
+    void addToChunkGrid(const PlacedElement& element);
+    void removeFromChunkGrid(SymbolId symbol, float x, float y);
+    void moveInChunkGrid(const PlacedElement& element, float oldX, float oldY);
+    // Where the renderer draws an element: its position, or between its last two positions
+    static void getDrawPosition(const PlacedElement& element, const MotionFrame& motion, float& x, float& y);
+    
+    // Sum of the deltaTime of every drawn frame: animations of elements out of view are advanced
+    // when they come back into view instead of every frame
+    double animationClock = 0.0;
+    std::vector<size_t> drawOrder; // collectSpritesLocked scratch: visible element indices, back to front
     
     // Store width and height for aspect ratio calculation
     std::map<ElementName, std::pair<int, int>> textureDimensions;
+    
+    // Sprite rendering (spriteBatch.h / spriteRenderer.h): texture layout per ElementName (indexed by
+    // the enum value, filled in init), the batch of the current frame and the element index of each
+    // of its sprites (debug overlays)
+    std::vector<SpriteTextureLayout> spriteLayouts;
+    SpriteBatch spriteBatch;
+    std::vector<size_t> spriteElementIndices;
+    // Debug overlay data of each sprite of the batch (recordElements), points in overlayPoints
+    struct SpriteOverlay {
+        bool hasCollision;
+        float scale;
+        size_t firstPoint;
+        size_t pointCount;
+    };
+    std::vector<SpriteOverlay> spriteOverlays;
+    std::vector<std::pair<float, float>> overlayPoints;
+    bool recordedAnchorPoints = false;
+    bool recordedCollisionBoxes = false;
+    float overlayCellWidth = 0.0f;
+    float overlayCellHeight = 0.0f;
+    SpriteRenderer spriteRenderer;
+    void refreshSpriteLayouts();
+    void collectSpritesLocked(const VisibleSet& visible, double deltaTime, SpriteBatch& batch, std::vector<size_t>* elementIndices);
+    const SpriteTextureLayout* getSpriteLayout(ElementName elementName) const;
+    // Fallback without the instanced renderer, and the anchor/collision overlays (from the recorded batch)
+    void drawSpritesImmediate() const;
+    void drawSpriteDebugOverlays() const;
 
     // Debug visualization flag
     bool showAnchorPoints = false;
@@ -1,22 +1,33 @@
 #include "entities.h"
+#include "gameLog.h"
 #include "entityBehaviors.h"
 #include "collision.h"
 #include "collisionCache.h"
 #include "entitiesStatus.h"
 #include "map.h" // Adding for gameMap access
 #include "pathfinding.h" // Include for pathfinding cooldown functions
-#include "globals.h" // For GRID_SIZE
+#include "globals.h" // For WORLD_SIZE
 #include "debug.h" // For isShowingCollisionBoxes function
 #include "asyncPathfinding.h"
 #include "performanceProfiler.h"
+#include "metrics.h"
 #include "camera.h" // For camera culling optimization
+#include "gameClock.h" // For getGameTime
+#include "simulationRandom.h" // Seeded ENTITIES stream
+#include "simulationReplay.h" // For isLockstepSimulation
+#include "timeSlicedJobs.h" // Unstuck searches run as time-sliced jobs
+#include "frameArena.h" // Per-tick transient buffers
+#include "visibleSet.h" // Debug overlays of the entities in view
+#include "renderCommands.h" // Debug lines recorded for the GL thread
 #include "Gameplay.h" // Include for accessing Gameplay::getGameMap()
 #include <iostream>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
+#include <memory>
 #include <mutex>
 #include <GLFW/glfw3.h>
 #include "enumDefinitions.h"
@@ -37,7 +48,7 @@ static std::vector<EntityInfo> entityTypes;
 static std::mutex entityTypesInitMutex;
 
 // Spatial grid optimization for entity collision detection (thread-safe with thread_local)
-thread_local static std::unordered_map<int, std::vector<std::string>> entitySpatialGrid;
+thread_local static std::unordered_map<int, std::vector<SymbolId>> entitySpatialGrid;
 thread_local static bool entitySpatialGridInitialized = false;
 thread_local static float lastEntitySpatialGridUpdateTime = 0.0f;
 static const int ENTITY_SPATIAL_GRID_SIZE = 20; // Size of each spatial grid cell for entities
@@ -574,7 +585,7 @@ static void initializeEntityTypes() {
 
 
     } catch (const std::exception& e) {
-        std::cerr << "CRASH FIX: Exception during entity initialization: " << e.what() << std::endl;
+        GAME_LOG_ERROR("CRASH FIX: Exception during entity initialization: " << e.what());
         entityTypes.clear(); // Clear on error to prevent corruption
     }
 }
@@ -616,7 +627,7 @@ void EntitiesManager::initializeEntityConfigurations() {
         EntityConfiguration config(entityInfo);
         addConfiguration(config);
     }
-    std::cout << "Initialized " << entityTypes.size() << " predefined entity configurations" << std::endl;
+    GAME_LOG_INFO("Initialized " << entityTypes.size() << " predefined entity configurations");
 }
 
 const EntityConfiguration* EntitiesManager::getConfiguration(EntityName entityType) const {
@@ -631,7 +642,7 @@ const EntityConfiguration* EntitiesManager::getConfiguration(EntityName entityTy
 void EntitiesManager::addConfiguration(const EntityConfiguration& config) {
     // Add or replace the configuration
     configurations[config.type] = config;
-    std::cout << "Added entity configuration: " << entityNameToString(config.type) << std::endl;
+    GAME_LOG_INFO("Added entity configuration: " << entityNameToString(config.type));
 }
 
 bool EntitiesManager::placeEntityByType(const std::string& instanceName, EntityName entityType, float x, float y) {
@@ -649,7 +660,7 @@ bool EntitiesManager::placeEntityByType(const std::string& instanceName, EntityN
         }
     }
     
-    std::cerr << "Entity type not found: " << entityNameToString(entityType) << std::endl;
+    GAME_LOG_ERROR("Entity type not found: " << entityNameToString(entityType));
     return false;
 }
 
@@ -669,7 +680,7 @@ bool EntitiesManager::placeEntityByType(const std::string& instanceName, EntityN
         }
     }
     
-    std::cerr << "Entity type not found: " << entityNameToString(entityType) << std::endl;
+    GAME_LOG_ERROR("Entity type not found: " << entityNameToString(entityType));
     return false;
 }
 
@@ -694,7 +705,7 @@ bool EntitiesManager::placeEntityByTypeSafely(const std::string& instanceName, E
     }
     
     if (!tempConfig) {
-        std::cerr << "Entity type not found for safe placement: " << entityNameToString(entityType) << std::endl;
+        GAME_LOG_ERROR("Entity type not found for safe placement: " << entityNameToString(entityType));
         return false;
     }
     
@@ -719,6 +730,7 @@ bool EntitiesManager::placeEntityByTypeSafely(const std::string& instanceName, E
     // Create temporary entity entry
     Entity tempEntity;
     tempEntity.instanceName = instanceName;
+    tempEntity.symbol = internSymbol(instanceName);
     tempEntity.type = entityType;
     entities[instanceName] = tempEntity;
     
@@ -731,13 +743,13 @@ bool EntitiesManager::placeEntityByTypeSafely(const std::string& instanceName, E
     elementsManager.removeElement(tempElementName);
     
     if (!foundSafePosition) {
-        std::cout << "Warning: Could not find safe position for entity " << instanceName 
-                  << " - placing at requested coordinates (" << x << ", " << y << ")" << std::endl;
+        GAME_LOG_WARN("Warning: Could not find safe position for entity " << instanceName 
+                  << " - placing at requested coordinates (" << x << ", " << y << ")");
         safeX = x;
         safeY = y;
     } else if (safeX != x || safeY != y) {
-        std::cout << "Found safe position for entity " << instanceName 
-                  << " - adjusted from (" << x << ", " << y << ") to (" << safeX << ", " << safeY << ")" << std::endl;
+        GAME_LOG_INFO("Found safe position for entity " << instanceName 
+                  << " - adjusted from (" << x << ", " << y << ") to (" << safeX << ", " << safeY << ")");
     }
     
     // Now place the entity at the safe coordinates using the normal method
@@ -749,7 +761,7 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
     // Check if the configuration exists
     const EntityConfiguration* config = getConfiguration(entityType);
     if (!config) {
-        std::cerr << "Entity configuration not found: " << entityNameToString(entityType) << std::endl;
+        GAME_LOG_ERROR("Entity configuration not found: " << entityNameToString(entityType));
         return false;
     }// COLLISION RESOLUTION INTEGRATION
     // Check if entity spawns in a collision area and resolve it
@@ -762,17 +774,17 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
         (wouldEntityCollideWithElementsGranular(*config, x, y, false) || 
          wouldEntityCollideWithBlocksGranular(*config, x, y, false))) {
         
-        std::cout << "Entity " << instanceName << " would spawn inside collision area at (" 
-                  << x << ", " << y << ") - attempting collision resolution..." << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " would spawn inside collision area at (" 
+                  << x << ", " << y << ") - attempting collision resolution...");
         
         // Try to find a safe position nearby
         if (resolveEntityCollisionStuck(instanceName, safeX, safeY, *config, gameMap)) {
             needsSafePosition = true;
-            std::cout << "Found safe spawn position for " << instanceName 
-                      << " at (" << safeX << ", " << safeY << ")" << std::endl;
+            GAME_LOG_INFO("Found safe spawn position for " << instanceName 
+                      << " at (" << safeX << ", " << safeY << ")");
         } else {
-            std::cout << "Warning: Could not find safe spawn position for " << instanceName 
-                      << " - placing at requested coordinates (" << x << ", " << y << ")" << std::endl;
+            GAME_LOG_WARN("Warning: Could not find safe spawn position for " << instanceName 
+                      << " - placing at requested coordinates (" << x << ", " << y << ")");
             safeX = x;
             safeY = y;
         }
@@ -782,6 +794,7 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
     // Create an Entity object
     Entity entity;
     entity.instanceName = instanceName;
+    entity.symbol = internSymbol(instanceName);
     entity.type = entityType;
     entity.lifePoints = config->lifePoints;  // Initialize entity's life points from config
     entity.damagePoints = config->damagePoints;  // Initialize entity's damage points from config
@@ -819,10 +832,10 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
     }
     
       if (needsSafePosition && (safeX != x || safeY != y)) {
-        std::cout << "Entity " << instanceName << " placed with collision resolution - moved from (" 
-                  << x << ", " << y << ") to (" << safeX << ", " << safeY << ")" << std::endl;    } else {
-        std::cout << "Placed entity: " << instanceName << " (type: " << entityNameToString(entityType) << ") at (" 
-                << safeX << ", " << safeY << ")" << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " placed with collision resolution - moved from (" 
+                  << x << ", " << y << ") to (" << safeX << ", " << safeY << ")");    } else {
+        GAME_LOG_INFO("Placed entity: " << instanceName << " (type: " << entityNameToString(entityType) << ") at (" 
+                << safeX << ", " << safeY << ")");
     }
     return true;
 }
@@ -832,7 +845,7 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
     // Check if the configuration exists
     const EntityConfiguration* config = getConfiguration(entityType);
     if (!config) {
-        std::cerr << "Entity configuration not found: " << entityNameToString(entityType) << std::endl;
+        GAME_LOG_ERROR("Entity configuration not found: " << entityNameToString(entityType));
         return false;
     }
 
@@ -847,17 +860,17 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
         (wouldEntityCollideWithElementsGranular(*config, x, y, false) || 
          wouldEntityCollideWithBlocksGranular(*config, x, y, false))) {
         
-        std::cout << "Entity " << instanceName << " would spawn inside collision area at (" 
-                  << x << ", " << y << ") - attempting collision resolution..." << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " would spawn inside collision area at (" 
+                  << x << ", " << y << ") - attempting collision resolution...");
         
         // Try to find a safe position nearby
         if (resolveEntityCollisionStuck(instanceName, safeX, safeY, *config, gameMap)) {
             needsSafePosition = true;
-            std::cout << "Found safe spawn position for " << instanceName 
-                      << " at (" << safeX << ", " << safeY << ")" << std::endl;
+            GAME_LOG_INFO("Found safe spawn position for " << instanceName 
+                      << " at (" << safeX << ", " << safeY << ")");
         } else {
-            std::cout << "Warning: Could not find safe spawn position for " << instanceName 
-                      << " - placing at requested coordinates (" << x << ", " << y << ")" << std::endl;
+            GAME_LOG_WARN("Warning: Could not find safe spawn position for " << instanceName 
+                      << " - placing at requested coordinates (" << x << ", " << y << ")");
             safeX = x;
             safeY = y;
         }
@@ -869,6 +882,7 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
     // Create an Entity object
     Entity entity;
     entity.instanceName = instanceName;
+    entity.symbol = internSymbol(instanceName);
     entity.type = entityType;
     entity.lifePoints = config->lifePoints;  // Initialize entity's life points from config
     entity.damagePoints = config->damagePoints;  // Initialize entity's damage points from config
@@ -909,11 +923,11 @@ bool EntitiesManager::placeEntity(const std::string& instanceName, EntityName en
     }
     
     if (needsSafePosition && (safeX != x || safeY != y)) {
-        std::cout << "Entity " << instanceName << " placed with collision resolution - moved from (" 
-                  << x << ", " << y << ") to (" << safeX << ", " << safeY << ") with sprite phase override: " << overrideSpritePhase << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " placed with collision resolution - moved from (" 
+                  << x << ", " << y << ") to (" << safeX << ", " << safeY << ") with sprite phase override: " << overrideSpritePhase);
     } else {
-        std::cout << "Placed entity: " << instanceName << " (type: " << entityNameToString(entityType) << ") at (" 
-                << safeX << ", " << safeY << ") with sprite phase override: " << overrideSpritePhase << std::endl;
+        GAME_LOG_INFO("Placed entity: " << instanceName << " (type: " << entityNameToString(entityType) << ") at (" 
+                << safeX << ", " << safeY << ") with sprite phase override: " << overrideSpritePhase);
     }
     return true;
 }
@@ -922,14 +936,14 @@ bool EntitiesManager::walkEntityWithPathfinding(const std::string& instanceName,
     // Get the entity
     Entity* entity = getEntity(instanceName);
     if (!entity) {
-        std::cerr << "Entity not found: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Entity not found: " << instanceName);
         return false;
     }
 
     // Get the configuration
     const EntityConfiguration* config = getConfiguration(entity->type);
     if (!config) {
-        std::cerr << "Entity configuration not found: " << entityNameToString(entity->type) << std::endl;
+        GAME_LOG_ERROR("Entity configuration not found: " << entityNameToString(entity->type));
         return false;
     }
 
@@ -939,13 +953,13 @@ bool EntitiesManager::walkEntityWithPathfinding(const std::string& instanceName,
     // Get current position from entity if available, otherwise from element
     float startPathX, startPathY;
     if (!elementsManager.getElementPosition(elementName, startPathX, startPathY)) {
-        std::cerr << "Error getting position for entity: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Error getting position for entity: " << instanceName);
         return false;
     }
       // Check if destination would cause entity collision shape to overlap with map boundaries
     if (config->offMapCollision && wouldEntityCollideWithMapBounds(*config, x, y)) {
-        std::cout << "Cannot move entity " << instanceName << " to (" << x << ", " << y 
-                  << ") - destination would cause collision with map boundaries" << std::endl;
+        GAME_LOG_INFO("Cannot move entity " << instanceName << " to (" << x << ", " << y 
+                  << ") - destination would cause collision with map boundaries");
         return false;
     }
     
@@ -953,8 +967,8 @@ bool EntitiesManager::walkEntityWithPathfinding(const std::string& instanceName,
     if (config->canCollide && 
         (wouldEntityCollideWithElementsGranular(*config, x, y, true) || 
          wouldEntityCollideWithBlocksGranular(*config, x, y, true))) {
-        std::cout << "Cannot move entity " << instanceName << " to (" << x << ", " << y 
-                  << ") - inaccessible destination (would cause collision with blocks/elements)" << std::endl;
+        GAME_LOG_INFO("Cannot move entity " << instanceName << " to (" << x << ", " << y 
+                  << ") - inaccessible destination (would cause collision with blocks/elements)");
         return false;
     }
     
@@ -963,19 +977,17 @@ bool EntitiesManager::walkEntityWithPathfinding(const std::string& instanceName,
     float dy = y - startPathY;
     float distance = std::sqrt(dx * dx + dy * dy);
     if (distance < 0.1f) {
-        std::cout << "Entity " << instanceName << " is already at destination" << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " is already at destination");
         return true;
     }    // Check async pathfinding availability
     if (!g_entityAsyncPathfinder) {
-        std::cerr << "Async pathfinder not initialized" << std::endl;
+        GAME_LOG_ERROR("Async pathfinder not initialized");
         return false;
     }
     
     // Check pathfinding cooldown to prevent too frequent requests
     if (!canEntityRequestPathfinding(instanceName)) {
-        if (DEBUG_LOGS) {
-            std::cout << "Pathfinding request for entity " << instanceName << " denied due to cooldown" << std::endl;
-        }
+        GAME_LOG_DEBUG("Pathfinding request for entity " << instanceName << " denied due to cooldown");
         return false;
     }
       // Cancel any existing pathfinding request for this entity
@@ -1006,12 +1018,12 @@ bool EntitiesManager::walkEntityWithPathfinding(const std::string& instanceName,
         // Update pathfinding cooldown time for this entity
         updateEntityPathfindingTime(instanceName);
         
-        std::cout << "Entity " << instanceName << " submitted async pathfinding request (ID: " << requestId 
+        GAME_LOG_INFO("Entity " << instanceName << " submitted async pathfinding request (ID: " << requestId 
                   << ") to (" << x << ", " << y << ") with "
-                  << ((walkType == WalkType::NORMAL) ? "normal" : "sprint") << " speed" << std::endl;
+                  << ((walkType == WalkType::NORMAL) ? "normal" : "sprint") << " speed");
         return true;
     } else {
-        std::cerr << "Failed to submit pathfinding request for entity: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Failed to submit pathfinding request for entity: " << instanceName);
         return false;
     }
 }
@@ -1020,14 +1032,14 @@ bool EntitiesManager::findNearestSafePlaceFromCoordinatesForEntity(const std::st
     // Get the entity
     Entity* entity = getEntity(instanceName);
     if (!entity) {
-        std::cerr << "Entity not found: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Entity not found: " << instanceName);
         return false;
     }
 
     // Get the configuration
     const EntityConfiguration* config = getConfiguration(entity->type);
     if (!config) {
-        std::cerr << "Entity configuration not found: " << entityNameToString(entity->type) << std::endl;
+        GAME_LOG_ERROR("Entity configuration not found: " << entityNameToString(entity->type));
         return false;
     }
 
@@ -1037,29 +1049,29 @@ bool EntitiesManager::findNearestSafePlaceFromCoordinatesForEntity(const std::st
     // Get current position
     float currentX, currentY;
     if (!elementsManager.getElementPosition(elementName, currentX, currentY)) {
-        std::cerr << "Error getting position for entity: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Error getting position for entity: " << instanceName);
         return false;
     }
 
     // First check if the target coordinates are already accessible
     // Check if destination would cause entity collision shape to overlap with map boundaries
     if (config->offMapCollision && wouldEntityCollideWithMapBounds(*config, x, y)) {
-        std::cout << "Target coordinates (" << x << ", " << y << ") would cause collision with map boundaries" << std::endl;
+        GAME_LOG_INFO("Target coordinates (" << x << ", " << y << ") would cause collision with map boundaries");
     }
     // Check if destination would cause entity collision shape to overlap with collision/avoidance blocks or elements
     else if (config->canCollide && 
         (wouldEntityCollideWithElementsGranular(*config, x, y, true) || 
          wouldEntityCollideWithBlocksGranular(*config, x, y, true))) {
-        std::cout << "Target coordinates (" << x << ", " << y << ") would cause collision with blocks/elements" << std::endl;
+        GAME_LOG_INFO("Target coordinates (" << x << ", " << y << ") would cause collision with blocks/elements");
     } else {
         // Target coordinates are accessible
         safeX = x;
         safeY = y;
-        std::cout << "Entity " << instanceName << " can reach target (" << x << ", " << y << ") - no adjustment needed" << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " can reach target (" << x << ", " << y << ") - no adjustment needed");
         return true;
     }
 
-    std::cout << "Entity " << instanceName << " cannot reach target (" << x << ", " << y << ") - searching for nearest accessible coordinates..." << std::endl;
+    GAME_LOG_INFO("Entity " << instanceName << " cannot reach target (" << x << ", " << y << ") - searching for nearest accessible coordinates...");
 
     // Target is not accessible, search for nearest accessible coordinates using spiral pattern
     const float searchStep = 1.0f;
@@ -1075,7 +1087,7 @@ bool EntitiesManager::findNearestSafePlaceFromCoordinatesForEntity(const std::st
             float testY = y + radius * std::sin(angle);
 
             // Check if this position is within map bounds
-            if (testX < 0 || testX >= GRID_SIZE || testY < 0 || testY >= GRID_SIZE) {
+            if (testX < 0 || testX >= WORLD_SIZE || testY < 0 || testY >= WORLD_SIZE) {
                 continue;
             }
 
@@ -1094,8 +1106,8 @@ bool EntitiesManager::findNearestSafePlaceFromCoordinatesForEntity(const std::st
             safeX = testX;
             safeY = testY;
             float distance = std::sqrt((testX - x) * (testX - x) + (testY - y) * (testY - y));
-            std::cout << "Found nearest safe accessible position for entity " << instanceName 
-                      << " at (" << safeX << ", " << safeY << ") - distance from target: " << distance << std::endl;
+            GAME_LOG_INFO("Found nearest safe accessible position for entity " << instanceName 
+                      << " at (" << safeX << ", " << safeY << ") - distance from target: " << distance);
             return true;
         }
     }
@@ -1103,8 +1115,8 @@ bool EntitiesManager::findNearestSafePlaceFromCoordinatesForEntity(const std::st
     // No safe position found, return current position as fallback
     safeX = currentX;
     safeY = currentY;
-    std::cout << "No accessible position found within search radius - returning current position (" 
-              << safeX << ", " << safeY << ") for entity " << instanceName << std::endl;
+    GAME_LOG_INFO("No accessible position found within search radius - returning current position (" 
+              << safeX << ", " << safeY << ") for entity " << instanceName);
     return false;
 }
 
@@ -1112,14 +1124,14 @@ bool EntitiesManager::findRandomSafePointAroundTheEntity(const std::string& inst
     // Get the entity
     Entity* entity = getEntity(instanceName);
     if (!entity) {
-        std::cerr << "Entity not found: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Entity not found: " << instanceName);
         return false;
     }
 
     // Get the configuration
     const EntityConfiguration* config = getConfiguration(entity->type);
     if (!config) {
-        std::cerr << "Entity configuration not found: " << entityNameToString(entity->type) << std::endl;
+        GAME_LOG_ERROR("Entity configuration not found: " << entityNameToString(entity->type));
         return false;
     }
 
@@ -1129,24 +1141,24 @@ bool EntitiesManager::findRandomSafePointAroundTheEntity(const std::string& inst
     // Get current position
     float currentX, currentY;
     if (!elementsManager.getElementPosition(elementName, currentX, currentY)) {
-        std::cerr << "Error getting position for entity: " << instanceName << std::endl;
-        return false;    }    // Set up random number generation using the global seeded RNG for consistency
+        GAME_LOG_ERROR("Error getting position for entity: " << instanceName);
+        return false;    }    // Set up random number generation from the seeded entity stream
     std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
     std::uniform_real_distribution<float> radiusDist(0.0f, radius);
 
     // Try to find a random accessible point within the radius
     const int maxAttempts = 100;
       for (int attempt = 0; attempt < maxAttempts; attempt++) {
-        // Generate random angle and distance using the global seeded RNG
-        float angle = angleDist(TERRAIN_RNG);
-        float distance = radiusDist(TERRAIN_RNG);
+        // Generate random angle and distance from the seeded entity stream
+        float angle = drawSimulationRandom(RandomStream::ENTITIES, angleDist);
+        float distance = drawSimulationRandom(RandomStream::ENTITIES, radiusDist);
         
         // Calculate test position
         float testX = currentX + distance * std::cos(angle);
         float testY = currentY + distance * std::sin(angle);
 
         // Check if this position is within map bounds
-        if (testX < 0 || testX >= GRID_SIZE || testY < 0 || testY >= GRID_SIZE) {
+        if (testX < 0 || testX >= WORLD_SIZE || testY < 0 || testY >= WORLD_SIZE) {
             continue;
         }
 
@@ -1165,15 +1177,15 @@ bool EntitiesManager::findRandomSafePointAroundTheEntity(const std::string& inst
         randomX = testX;
         randomY = testY;
         float actualDistance = std::sqrt((testX - currentX) * (testX - currentX) + (testY - currentY) * (testY - currentY));
-        std::cout << "Found random accessible position for entity " << instanceName 
+        GAME_LOG_INFO("Found random accessible position for entity " << instanceName 
                   << " at (" << randomX << ", " << randomY << ") - distance: " << actualDistance 
-                  << " (attempt " << (attempt + 1) << ")" << std::endl;
+                  << " (attempt " << (attempt + 1) << ")");
         return true;
     }
 
     // No accessible random position found within attempts
-    std::cout << "No accessible random position found within " << maxAttempts 
-              << " attempts for entity " << instanceName << " with radius " << radius << std::endl;
+    GAME_LOG_INFO("No accessible random position found within " << maxAttempts 
+              << " attempts for entity " << instanceName << " with radius " << radius);
     return false;
 }
 
@@ -1181,12 +1193,12 @@ bool EntitiesManager::walkEntityWithPathFindingToRandomRadiusTarget(const std::s
     // Find a random safe point around the entity
     float randomX, randomY;
     if (!findRandomSafePointAroundTheEntity(instanceName, radius, randomX, randomY)) {
-        std::cerr << "Failed to find random accessible target for entity: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Failed to find random accessible target for entity: " << instanceName);
         return false;
     }
 
     // Use the existing pathfinding function to walk to the random target
-    std::cout << "Entity " << instanceName << " moving to random target (" << randomX << ", " << randomY << ")" << std::endl;
+    GAME_LOG_INFO("Entity " << instanceName << " moving to random target (" << randomX << ", " << randomY << ")");
     return walkEntityWithPathfinding(instanceName, randomX, randomY, walkType);
 }
 
@@ -1197,21 +1209,24 @@ void EntitiesManager::update(double deltaTime) {
         processAsyncPathfindingResults();
         
         // CRASH FIX: Collect entity names first to avoid iterator invalidation
-        std::vector<std::string> walkingEntityNames;
-        walkingEntityNames.reserve(entities.size());
+        // (interned names in a frame arena buffer: no heap allocation per tick)
+        FrameArenaScope arenaScope;
+        FrameVector<SymbolId> walkingEntities(&frameArena());
+        walkingEntities.reserve(entities.size());
         
         for (const auto& pair : entities) {
             if (pair.second.isWalking) {
-                walkingEntityNames.push_back(pair.first);
+                walkingEntities.push_back(pair.second.symbol);
             }
         }
         
         // Update all walking entities using safe name-based iteration
-        for (const std::string& instanceName : walkingEntityNames) {
+        for (SymbolId walkingEntity : walkingEntities) {
+            const std::string& instanceName = symbolName(walkingEntity);
             // CRASH FIX: Verify entity still exists
             auto entityIt = entities.find(instanceName);
             if (entityIt == entities.end()) {
-                std::cout << "WARNING: Walking entity " << instanceName << " no longer exists during update" << std::endl;
+                GAME_LOG_WARN("WARNING: Walking entity " << instanceName << " no longer exists during update");
                 continue;
             }
             
@@ -1224,7 +1239,7 @@ void EntitiesManager::update(double deltaTime) {
               // Get the configuration for this entity
             const EntityConfiguration* config = getConfiguration(entity.type);
             if (!config) {
-                std::cerr << "Error: Cannot find configuration for entity: " << entity.instanceName << std::endl;
+                GAME_LOG_ERROR("Error: Cannot find configuration for entity: " << entity.instanceName);
                 stopEntityMovement(entity.instanceName); // Stop walking due to error
                 continue;
             }
@@ -1232,19 +1247,19 @@ void EntitiesManager::update(double deltaTime) {
             // Update the entity's walking animation with additional safety
             try {
                 updateEntityWalking(entity, *config, deltaTime);            } catch (const std::exception& e) {
-                std::cerr << "CRITICAL: Exception updating entity " << instanceName << ": " << e.what() << std::endl;
+                GAME_LOG_ERROR("CRITICAL: Exception updating entity " << instanceName << ": " << e.what());
                 // Stop entity to prevent further crashes
                 stopEntityMovement(instanceName);
             } catch (...) {
-                std::cerr << "CRITICAL: Unknown exception updating entity " << instanceName << std::endl;
+                GAME_LOG_ERROR("CRITICAL: Unknown exception updating entity " << instanceName);
                 // Stop entity to prevent further crashes
                 stopEntityMovement(instanceName);
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "CRITICAL: Exception in EntitiesManager::update: " << e.what() << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Exception in EntitiesManager::update: " << e.what());
     } catch (...) {
-        std::cerr << "CRITICAL: Unknown exception in EntitiesManager::update!" << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Unknown exception in EntitiesManager::update!");
     }
 }
 
@@ -1260,14 +1275,16 @@ void EntitiesManager::update(double deltaTime, float cameraLeft, float cameraRig
         }
         
         // CRASH FIX: Collect entity names first to avoid iterator invalidation
-        std::vector<std::string> walkingEntityNames;
+        // (interned names in a frame arena buffer: no heap allocation per tick)
+        FrameArenaScope arenaScope;
+        FrameVector<SymbolId> walkingEntities(&frameArena());
         {
             PROFILE_SCOPE("Entities_CollectWalkingNames");
-            walkingEntityNames.reserve(entities.size());
+            walkingEntities.reserve(entities.size());
             
             for (const auto& pair : entities) {
                 if (pair.second.isWalking) {
-                    walkingEntityNames.push_back(pair.first);
+                    walkingEntities.push_back(pair.second.symbol);
                 }
             }
         }
@@ -1275,11 +1292,12 @@ void EntitiesManager::update(double deltaTime, float cameraLeft, float cameraRig
         // Update all walking entities using safe name-based iteration with view frustum culling
         {
             PROFILE_SCOPE("Entities_UpdateWalking");
-            for (const std::string& instanceName : walkingEntityNames) {
+            for (SymbolId walkingEntity : walkingEntities) {
+                const std::string& instanceName = symbolName(walkingEntity);
                 // CRASH FIX: Verify entity still exists
                 auto entityIt = entities.find(instanceName);
                 if (entityIt == entities.end()) {
-                    std::cout << "WARNING: Walking entity " << instanceName << " no longer exists during update" << std::endl;
+                    GAME_LOG_WARN("WARNING: Walking entity " << instanceName << " no longer exists during update");
                     continue;
                 }
                 
@@ -1311,7 +1329,7 @@ void EntitiesManager::update(double deltaTime, float cameraLeft, float cameraRig
                 // Get the configuration for this entity
                 const EntityConfiguration* config = getConfiguration(entity.type);
                 if (!config) {
-                    std::cerr << "Error: Cannot find configuration for entity: " << entity.instanceName << std::endl;
+                    GAME_LOG_ERROR("Error: Cannot find configuration for entity: " << entity.instanceName);
                     stopEntityMovement(entity.instanceName); // Stop walking due to error
                     continue;
                 }
@@ -1320,81 +1338,117 @@ void EntitiesManager::update(double deltaTime, float cameraLeft, float cameraRig
                 try {
                     updateEntityWalking(entity, *config, deltaTime);
                 } catch (const std::exception& e) {
-                    std::cerr << "CRITICAL: Exception updating entity " << instanceName << ": " << e.what() << std::endl;
+                    GAME_LOG_ERROR("CRITICAL: Exception updating entity " << instanceName << ": " << e.what());
                     // Stop entity to prevent further crashes
                     stopEntityMovement(instanceName);
                 } catch (...) {
-                    std::cerr << "CRITICAL: Unknown exception updating entity " << instanceName << std::endl;
+                    GAME_LOG_ERROR("CRITICAL: Unknown exception updating entity " << instanceName);
                     // Stop entity to prevent further crashes
                     stopEntityMovement(instanceName);
                 }
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "CRITICAL: Exception in EntitiesManager::update: " << e.what() << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Exception in EntitiesManager::update: " << e.what());
     } catch (...) {
-        std::cerr << "CRITICAL: Unknown exception in EntitiesManager::update!" << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Unknown exception in EntitiesManager::update!");
     }
 }
 
-void EntitiesManager::drawDebugPaths(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop) {
+void EntitiesManager::recordDebugPaths(const VisibleSet& visible, LineCommandList& lines) {
     if (!DEBUG_SHOW_PATHS) {
         return;
     }
+    float startX = visible.startX;
+    float endX = visible.endX;
+    float startY = visible.startY;
+    float endY = visible.endY;
+    float cameraLeft = visible.camera.left;
+    float cameraRight = visible.camera.right;
+    float cameraBottom = visible.camera.bottom;
+    float cameraTop = visible.camera.top;
 
-    glLineWidth(2.0f); // Set line width for paths
-    
     for (const auto& pair : entities) {
         const Entity& entity = pair.second;
         if (entity.isWalking) {
             float currentX, currentY;
-            std::string elementName = getElementName(entity.instanceName);
-            if (!elementsManager.getElementPosition(elementName, currentX, currentY)) {
+            if (!elementsManager.getElementPosition(entity.symbol, currentX, currentY)) {
                 continue; // Skip if we can't get current position
             }
 
+            // An entity out of view still shows the part of its path that crosses the view
+            if (!visible.isElementVisible(entity.symbol)) {
+                float minX = currentX, maxX = currentX, minY = currentY, maxY = currentY;
+                if (entity.usePathfinding) {
+                    for (size_t i = entity.currentPathIndex; i < entity.path.size(); ++i) {
+                        minX = std::min(minX, entity.path[i].first);
+                        maxX = std::max(maxX, entity.path[i].first);
+                        minY = std::min(minY, entity.path[i].second);
+                        maxY = std::max(maxY, entity.path[i].second);
+                    }
+                } else {
+                    minX = std::min(minX, entity.targetX);
+                    maxX = std::max(maxX, entity.targetX);
+                    minY = std::min(minY, entity.targetY);
+                    maxY = std::max(maxY, entity.targetY);
+                }
+                if (!visible.overlaps(minX, minY, maxX, maxY)) {
+                    continue;
+                }
+            }
+
             // Convert current entity position to screen coordinates
             float entityScreenX = startX + (currentX - cameraLeft) / (cameraRight - cameraLeft) * (endX - startX);
             float entityScreenY = startY + (currentY - cameraBottom) / (cameraTop - cameraBottom) * (endY - startY);
 
             if (entity.usePathfinding && !entity.path.empty()) {
-                glColor3f(0.0f, 0.0f, 1.0f); // Blue color for pathfinding paths
-                glBegin(GL_LINE_STRIP);
-                glVertex2f(entityScreenX, entityScreenY); // Start line from current entity position
+                // Blue for pathfinding paths, 2 pixels wide
+                lines.begin(GL_LINE_STRIP, 0.0f, 0.0f, 1.0f, 1.0f, 2.0f);
+                lines.vertex(entityScreenX, entityScreenY); // Start line from current entity position
 
                 for (size_t i = entity.currentPathIndex; i < entity.path.size(); ++i) {
                     const auto& waypoint = entity.path[i];
                     // Convert world to screen coordinates
                     float screenX = startX + (waypoint.first - cameraLeft) / (cameraRight - cameraLeft) * (endX - startX);
                     float screenY = startY + (waypoint.second - cameraBottom) / (cameraTop - cameraBottom) * (endY - startY);
-                    glVertex2f(screenX, screenY);
+                    lines.vertex(screenX, screenY);
                 }
-                glEnd();
             } else if (!entity.usePathfinding) {
-                glColor3f(1.0f, 0.0f, 0.0f); // Red color for direct paths (walkEntityToCoordinates)
-                glBegin(GL_LINES);
-                glVertex2f(entityScreenX, entityScreenY); // Line start
+                // Red for direct paths (walkEntityToCoordinates)
+                lines.begin(GL_LINES, 1.0f, 0.0f, 0.0f, 1.0f, 2.0f);
+                lines.vertex(entityScreenX, entityScreenY); // Line start
 
                 // Convert target world to screen coordinates
                 float targetScreenX = startX + (entity.targetX - cameraLeft) / (cameraRight - cameraLeft) * (endX - startX);
                 float targetScreenY = startY + (entity.targetY - cameraBottom) / (cameraTop - cameraBottom) * (endY - startY);
-                glVertex2f(targetScreenX, targetScreenY); // Line end
-                glEnd();
+                lines.vertex(targetScreenX, targetScreenY); // Line end
             }
         }
     }
 }
 
-void EntitiesManager::drawDebugCollisionRadii(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop) {
+void EntitiesManager::recordDebugCollisionRadii(const VisibleSet& visible, LineCommandList& lines) {
     // Only draw if collision visualization is enabled
     if (!isShowingCollisionBoxes()) {
         return;
     }
+    float startX = visible.startX;
+    float endX = visible.endX;
+    float startY = visible.startY;
+    float endY = visible.endY;
+    float cameraLeft = visible.camera.left;
+    float cameraRight = visible.camera.right;
+    float cameraBottom = visible.camera.bottom;
+    float cameraTop = visible.camera.top;
 
-    glLineWidth(2.0f); // Set line width for collision shapes
-      for (const auto& pair : entities) {
+    for (const auto& pair : entities) {
         const Entity& entity = pair.second;
         
+        // The shape is drawn around the entity's sprite: nothing to draw when the sprite is out of view
+        if (!visible.isElementVisible(entity.symbol)) {
+            continue;
+        }
+        
         // Get the configuration for this entity to access collision shape
         const EntityConfiguration* config = getConfiguration(entity.type);
         if (!config || !config->canCollide) {
@@ -1403,8 +1457,7 @@ void EntitiesManager::drawDebugCollisionRadii(float startX, float endX, float st
         
         // Get current entity position
         float currentX, currentY;
-        std::string elementName = getElementName(entity.instanceName);
-        if (!elementsManager.getElementPosition(elementName, currentX, currentY)) {
+        if (!elementsManager.getElementPosition(entity.symbol, currentX, currentY)) {
             continue; // Skip if we can't get current position
         }
 
@@ -1426,16 +1479,12 @@ void EntitiesManager::drawDebugCollisionRadii(float startX, float endX, float st
                 screenShapePoints.push_back({screenX, screenY});
             }
               // Draw polygon outline only (no fill)
-            glColor4f(0.0f, 0.8f, 0.0f, 0.8f); // More solid green for the outline
-            glBegin(GL_LINE_LOOP);
+            lines.begin(GL_LINE_LOOP, 0.0f, 0.8f, 0.0f, 0.8f, 2.0f); // More solid green for the outline
             for (const auto& screenPoint : screenShapePoints) {
-                glVertex2f(screenPoint.first, screenPoint.second);
+                lines.vertex(screenPoint.first, screenPoint.second);
             }
-            glEnd();
         }
     }
-    
-    glLineWidth(1.0f); // Reset line width
 }
 
 // Implementation of async pathfinding system methods
@@ -1450,7 +1499,7 @@ void EntitiesManager::initializeAsyncPathfinding() {
         // Start the async pathfinding system
         g_entityAsyncPathfinder->start();
         
-        std::cout << "Async pathfinding system initialized" << std::endl;
+        GAME_LOG_INFO("Async pathfinding system initialized");
     }
 }
 
@@ -1463,7 +1512,19 @@ void EntitiesManager::shutdownAsyncPathfinding() {
         delete g_entityAsyncPathfinder;
         g_entityAsyncPathfinder = nullptr;
         
-        std::cout << "Async pathfinding system shutdown" << std::endl;
+        GAME_LOG_INFO("Async pathfinding system shutdown");
+    }
+}
+
+void EntitiesManager::setDeferredPathfinding(bool deferred) {
+    if (g_entityAsyncPathfinder) {
+        g_entityAsyncPathfinder->setDeferredSubmission(deferred);
+    }
+}
+
+void EntitiesManager::runDeferredPathfinding() {
+    if (g_entityAsyncPathfinder) {
+        g_entityAsyncPathfinder->runDeferredRequests();
     }
 }
 
@@ -1475,6 +1536,13 @@ void EntitiesManager::processAsyncPathfindingResults() {
     // Get all completed pathfinding results
     std::vector<AsyncPathfindingResult> completedResults = g_entityAsyncPathfinder->getCompletedResults();
     
+    static MetricGauge& queueDepth = MetricsRegistry::getInstance().gauge("sorbetcoco_pathfinding_queue_depth",
+        "Async pathfinding requests waiting for or running on a worker");
+    static MetricCounter& resultsProcessed = MetricsRegistry::getInstance().counter("sorbetcoco_pathfinding_results_total",
+        "Async pathfinding results applied to entities");
+    queueDepth.set(static_cast<double>(g_entityAsyncPathfinder->getActiveRequestsCount()));
+    resultsProcessed.increment(static_cast<double>(completedResults.size()));
+    
     // Process each completed result
     for (const auto& result : completedResults) {
         // Find the entity that requested this pathfinding
@@ -1511,16 +1579,13 @@ void EntitiesManager::processAsyncPathfindingResults() {
                 std::string elementName = getElementName(entity->instanceName);
                 elementsManager.changeElementAnimationStatus(elementName, true);
                 
-                std::cout << "Entity " << entity->instanceName << " received pathfinding result with " 
-                          << result.path.size() << " waypoints" << std::endl;
+                GAME_LOG_INFO("Entity " << entity->instanceName << " received pathfinding result with " 
+                          << result.path.size() << " waypoints");
             }
         } else {
             // Failed pathfinding - stop the entity
-            std::cout << "Pathfinding failed for entity " << entity->instanceName;
-            if (!result.errorMessage.empty()) {
-                std::cout << ": " << result.errorMessage;
-            }
-            std::cout << std::endl;
+            GAME_LOG_INFO("Pathfinding failed for entity " << entity->instanceName
+                          << (result.errorMessage.empty() ? "" : ": ") << result.errorMessage);
             
             stopEntityMovement(entity->instanceName);
         }
@@ -1537,6 +1602,15 @@ Entity* EntitiesManager::getEntity(const std::string& instanceName) {
     return nullptr;
 }
 
+// Entities can be erased through getEntities(), so there is no per-symbol pointer to go stale:
+// the name is resolved through the symbol table (no allocation) and looked up in the map
+Entity* EntitiesManager::getEntity(SymbolId symbol) {
+    if (symbol == INVALID_SYMBOL) {
+        return nullptr;
+    }
+    return getEntity(symbolName(symbol));
+}
+
 // CRASH FIX: Safe entity existence check
 bool EntitiesManager::entityExists(const std::string& instanceName) const {
     return entities.find(instanceName) != entities.end();
@@ -1558,7 +1632,7 @@ bool EntitiesManager::getNextPathWaypoint(Entity& entity, float& nextX, float& n
 
 void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfiguration& config, double deltaTime) {    // CRASH FIX: Validate entity state before processing
     if (entity.instanceName.empty()) {
-        std::cerr << "ERROR: Entity has empty instance name in updateEntityWalking" << std::endl;
+        GAME_LOG_ERROR("ERROR: Entity has empty instance name in updateEntityWalking");
         stopEntityMovement(entity.instanceName);
         return;
     }
@@ -1567,13 +1641,13 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
     std::string elementName = getElementName(entity.instanceName);
       // CRASH FIX: Verify element exists before processing
     if (!elementsManager.elementExists(elementName)) {
-        std::cerr << "ERROR: Element " << elementName << " for entity " << entity.instanceName << " no longer exists" << std::endl;
+        GAME_LOG_ERROR("ERROR: Element " << elementName << " for entity " << entity.instanceName << " no longer exists");
         stopEntityMovement(entity.instanceName);
         return;
     }
       // Get current position
     float currentActualX, currentActualY;    if (!elementsManager.getElementPosition(elementName, currentActualX, currentActualY)) {
-        std::cerr << "Error getting position for entity: " << entity.instanceName << std::endl;
+        GAME_LOG_ERROR("Error getting position for entity: " << entity.instanceName);
         stopEntityMovement(entity.instanceName); // Stop walking due to error
         return;
     }
@@ -1591,9 +1665,9 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
         
         // If stuck for too long, stop movement
         if (entity.stuckCheckTime >= ENTITY_STUCK_TIMEOUT_FOR_STOPPING_MOVEMENT) {
-            std::cout << "Entity " << entity.instanceName << " appears to be stuck at (" 
+            GAME_LOG_INFO("Entity " << entity.instanceName << " appears to be stuck at (" 
                       << currentActualX << ", " << currentActualY << ") for " 
-                      << entity.stuckCheckTime << " seconds. Stopping movement." << std::endl;
+                      << entity.stuckCheckTime << " seconds. Stopping movement.");
             stopEntityMovement(entity.instanceName);
             return;
         }
@@ -1610,9 +1684,9 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
         }
           
         // DEBUG: Log direction calculation for all entities to help diagnose sprite issues
-        std::cout << "DEBUG: Entity " << ent.instanceName 
+        GAME_LOG_DEBUG("DEBUG: Entity " << ent.instanceName 
                   << " direction calc: dirX=" << dirX << ", dirY=" << dirY 
-                  << " (abs: " << std::abs(dirX) << ", " << std::abs(dirY) << ")" << std::endl;
+                  << " (abs: " << std::abs(dirX) << ", " << std::abs(dirY) << ")");
         
         // Use a smaller threshold to be more responsive to direction changes
         const float directionThreshold = 0.05f;
@@ -1641,17 +1715,17 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
         }
           
         // DEBUG: Log sprite phase changes for all entities
-        std::cout << "DEBUG: Entity " << ent.instanceName 
-                  << " direction=" << newDirection << " -> phase=" << phase << std::endl;
+        GAME_LOG_DEBUG("DEBUG: Entity " << ent.instanceName 
+                  << " direction=" << newDirection << " -> phase=" << phase);
         
         // CRITICAL FIX: Change the sprite phase and verify success
         bool success = elementsManager.changeElementSpritePhase(elName, phase);
         if (!success) {
-            std::cerr << "ERROR: Failed to change sprite phase for entity " << ent.instanceName 
-                      << " to phase " << phase << " - element name: " << elName << std::endl;
+            GAME_LOG_ERROR("ERROR: Failed to change sprite phase for entity " << ent.instanceName 
+                      << " to phase " << phase << " - element name: " << elName);
         } else {
-            std::cout << "SUCCESS: Changed sprite phase for entity " << ent.instanceName 
-                      << " to phase " << phase << " - element name: " << elName << std::endl;
+            GAME_LOG_INFO("SUCCESS: Changed sprite phase for entity " << ent.instanceName 
+                      << " to phase " << phase << " - element name: " << elName);
         }
     };
     
@@ -1659,7 +1733,7 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
     float dx = 0.0f, dy = 0.0f, distance = 0.0f;    if (entity.usePathfinding && !entity.path.empty()) {
         // CRASH FIX: Validate path state before accessing
         if (entity.currentPathIndex >= entity.path.size()) {
-            std::cerr << "WARNING: Entity " << entity.instanceName << " has invalid path index "                      << entity.currentPathIndex << " >= " << entity.path.size() << std::endl;
+            GAME_LOG_WARN("WARNING: Entity " << entity.instanceName << " has invalid path index "                      << entity.currentPathIndex << " >= " << entity.path.size());
             // Reset to valid state
             entity.currentPathIndex = std::min(entity.currentPathIndex, entity.path.size() > 0 ? entity.path.size() - 1 : 0);
         }
@@ -1730,9 +1804,9 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
         float finalX = currentActualX;
         float finalY = currentActualY;
         
-        std::cout << "Entity " << entity.instanceName << " stopping naturally at (" 
+        GAME_LOG_INFO("Entity " << entity.instanceName << " stopping naturally at (" 
                   << finalX << ", " << finalY << ") - target was (" 
-                  << entity.targetX << ", " << entity.targetY << "), distance: " << distance << std::endl;
+                  << entity.targetX << ", " << entity.targetY << "), distance: " << distance);
         
         // Move to the final position (usually current position, preventing teleportation)
         elementsManager.changeElementCoordinates(elementName, finalX, finalY);
@@ -1740,8 +1814,8 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
         // Stop entity movement using centralized function
         stopEntityMovement(entity.instanceName);
         
-        std::cout << "Entity " << entity.instanceName << " reached target area - final position (" 
-                  << finalX << ", " << finalY << ")" << std::endl;
+        GAME_LOG_INFO("Entity " << entity.instanceName << " reached target area - final position (" 
+                  << finalX << ", " << finalY << ")");
         return;
     }
     
@@ -1799,7 +1873,7 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
         // Check for collision with other entities using granular entity collision control
         // For movement, we check collision entities (not avoidance entities)
         // This prevents entities from overlapping during movement
-        bool collisionWithEntity = wouldEntityCollideWithEntitiesGranular(config, newX, newY, false, entity.instanceName);
+        bool collisionWithEntity = wouldEntityCollideWithEntitiesGranular(config, newX, newY, false, entity.symbol);
         
         if ((collisionWithElement || collisionWithBlock || collisionWithEntity) && (moveDx != 0 || moveDy != 0)) {
             // If diagonal movement fails, try axis-separated movement (like player system)
@@ -1813,14 +1887,14 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
                 float testY = currentActualY; // Keep Y the same
                 bool horizontalCollision = wouldEntityCollideWithElementsGranular(config, testX, testY, false) || 
                                            wouldEntityCollideWithBlocksGranular(config, testX, testY, false) ||
-                                           wouldEntityCollideWithEntitiesGranular(config, testX, testY, false, entity.instanceName);
+                                           wouldEntityCollideWithEntitiesGranular(config, testX, testY, false, entity.symbol);
                 
                 // Try moving only vertically
                 float testX2 = currentActualX; // Keep X the same
                 float testY2 = currentActualY + moveDy;
                 bool verticalCollision = wouldEntityCollideWithElementsGranular(config, testX2, testY2, false) || 
                                         wouldEntityCollideWithBlocksGranular(config, testX2, testY2, false) ||
-                                        wouldEntityCollideWithEntitiesGranular(config, testX2, testY2, false, entity.instanceName);
+                                        wouldEntityCollideWithEntitiesGranular(config, testX2, testY2, false, entity.symbol);
                 
                 // If horizontal movement is possible
                 if (!horizontalCollision) {
@@ -1877,8 +1951,8 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
             // Check for pathfinding timeout condition first (shorter threshold)
             else if (entity.usePathfinding && entity.pathfindingTimeoutTimer >= ENTITY_STUCK_TIMEOUT_FOR_STOPPING_MOVEMENT) {
                 // Entity has been stuck for the pathfinding timeout duration, stop it
-                std::cout << "Entity " << entity.instanceName << " has not moved for " 
-                          << ENTITY_STUCK_TIMEOUT_FOR_STOPPING_MOVEMENT << " seconds during pathfinding - stopping movement" << std::endl;
+                GAME_LOG_INFO("Entity " << entity.instanceName << " has not moved for " 
+                          << ENTITY_STUCK_TIMEOUT_FOR_STOPPING_MOVEMENT << " seconds during pathfinding - stopping movement");
                 
                 // Stop the entity movement
                 stopEntityMovement(entity.instanceName);
@@ -1900,8 +1974,8 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
                 );
                   const float arrivalThreshold = 0.5f; // If within 0.5 units of target, consider it arrived
                 if (distanceToTarget <= arrivalThreshold) {
-                    std::cout << "Entity " << entity.instanceName << " appears stuck but is close to target (" 
-                              << distanceToTarget << " units away) - stopping naturally instead of teleporting" << std::endl;
+                    GAME_LOG_INFO("Entity " << entity.instanceName << " appears stuck but is close to target (" 
+                              << distanceToTarget << " units away) - stopping naturally instead of teleporting");
                     
                     // Stop the entity naturally using centralized function
                     stopEntityMovement(entity.instanceName);
@@ -1912,85 +1986,26 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
                     entity.lastPositionChangeTime = entity.stuckCheckTime;
                     entity.stuckCount = 0;
                 } else {
-                    std::cout << "Entity " << entity.instanceName << " is stuck (count: " << entity.stuckCount 
+                    GAME_LOG_INFO("Entity " << entity.instanceName << " is stuck (count: " << entity.stuckCount 
                               << ") at (" << currentActualX << ", " << currentActualY 
-                              << ") - distance to target: " << distanceToTarget << " - attempting collision resolution..." << std::endl;
-                    
-                    float safeX = currentActualX;
-                    float safeY = currentActualY;
+                              << ") - distance to target: " << distanceToTarget << " - attempting collision resolution...");
                     
-                    if (resolveEntityCollisionStuck(entity.instanceName, safeX, safeY, config, gameMap)) {
-                        // Check if the safe position is too far from current position
-                        float teleportDistance = std::sqrt(
-                            (safeX - currentActualX) * (safeX - currentActualX) +
-                            (safeY - currentActualY) * (safeY - currentActualY)
-                        );
-                        
-                        const float maxTeleportDistance = 2.0f; // Don't teleport more than 2 units
-                        if (teleportDistance <= maxTeleportDistance) {
-                            // Safe position is close enough, teleport entity there
-                            elementsManager.changeElementCoordinates(elementName, safeX, safeY);
-                            
-                            std::cout << "Successfully resolved stuck condition for entity " << entity.instanceName 
-                                      << " - moved " << teleportDistance << " units to safe position (" << safeX << ", " << safeY << ")" << std::endl;
-                            
-                            // Reset stuck detection after successful resolution
-                            entity.lastPositionX = safeX;
-                            entity.lastPositionY = safeY;
-                            entity.lastPositionChangeTime = entity.stuckCheckTime;
-                            entity.stuckCount = 0;                            
-                            // If using pathfinding, recalculate path from new position
-                            if (entity.usePathfinding && entity.isWalking && 
-                                g_entityAsyncPathfinder && !entity.isWaitingForPath) {
-                                
-                                std::cout << "Recalculating pathfinding for unstuck entity " << entity.instanceName 
-                                          << " from new position (" << safeX << ", " << safeY << ")" << std::endl;
-                                  // Cancel existing pathfinding request if any
-                                if (entity.pathfindingRequestId > 0) {
-                                    g_entityAsyncPathfinder->cancelPathfindingRequest(entity.instanceName);
-                                }
-                                
-                                // Check pathfinding cooldown before requesting
-                                if (canEntityRequestPathfinding(entity.instanceName)) {
-                                    // Request new pathfinding from safe position to original target
-                                    int newRequestId = g_entityAsyncPathfinder->requestPathfinding(
-                                        entity.instanceName, safeX, safeY, entity.targetX, entity.targetY, config, entity.walkType
-                                    );
-                                      if (newRequestId > 0) {
-                                        entity.pathfindingRequestId = newRequestId;
-                                        entity.isWaitingForPath = true;
-                                        entity.lastPathRequest = std::chrono::steady_clock::now();
-                                        
-                                        // Update pathfinding cooldown time for this entity
-                                        updateEntityPathfindingTime(entity.instanceName);
-                                    }
-                                } else {
-                                    std::cout << "Pathfinding request for unstuck entity " << entity.instanceName 
-                                              << " denied due to cooldown" << std::endl;
-                                }
+                    // The spiral search can take hundreds of probes: it runs as a time-sliced job
+                    // and the result is applied when it finishes (stuck detection is reset below, so
+                    // this doesn't fire again while the search runs)
+                    std::string stuckInstanceName = entity.instanceName;
+                    const EntityConfiguration* stuckConfig = &config;
+                    if (!g_timeSlicedJobs.isQueued("unstuck:" + stuckInstanceName)) {
+                        std::shared_ptr<SafePositionSearch> search = std::make_shared<SafePositionSearch>(
+                            currentActualX, currentActualY, config, entity.instanceName);
+                        g_timeSlicedJobs.submit("Unstuck search", [this, search, stuckInstanceName, stuckConfig, currentActualX, currentActualY]() {
+                            if (!search->step(gameMap, SAFE_POSITION_PROBES_PER_STEP)) {
+                                return JobStep::CONTINUE;
                             }
-                        } else {
-                            std::cout << "Safe position for entity " << entity.instanceName 
-                                      << " is too far away (" << teleportDistance << " units) - stopping entity instead of teleporting" << std::endl;
-                            
-                            // Stop the entity instead of teleporting too far using centralized function
-                            stopEntityMovement(entity.instanceName);
-                            
-                            // Reset stuck detection
-                            entity.lastPositionX = currentActualX;
-                            entity.lastPositionY = currentActualY;
-                            entity.lastPositionChangeTime = entity.stuckCheckTime;
-                            entity.stuckCount = 0;
-                        }                    } else {
-                        std::cout << "Failed to resolve stuck condition for entity " << entity.instanceName 
-                                  << " - no safe position found. Stopping entity." << std::endl;
-                        
-                        // Stop the entity if no safe position can be found using centralized function
-                        stopEntityMovement(entity.instanceName);
-                        
-                        // Reset stuck detection to avoid immediate re-triggering
-                        entity.lastPositionChangeTime = entity.stuckCheckTime;
-                        entity.stuckCount = 0;
+                            applyStuckResolution(stuckInstanceName, *stuckConfig, search->found(),
+                                                 search->getResultX(), search->getResultY(), currentActualX, currentActualY);
+                            return JobStep::DONE;
+                        }, "unstuck:" + stuckInstanceName);
                     }
                 }
                 
@@ -2010,6 +2025,104 @@ void EntitiesManager::updateEntityWalking(Entity& entity, const EntityConfigurat
     checkAndApplyDamageBlocksToEntity(entity.instanceName, *this);
 }
 
+// Apply the result of an unstuck search started by updateEntityWalking (a time-sliced job, so
+// possibly a few ticks later): teleport to the safe position when it is close, stop the entity otherwise
+void EntitiesManager::applyStuckResolution(const std::string& instanceName, const EntityConfiguration& config, bool found,
+                                           float safeX, float safeY, float currentActualX, float currentActualY) {
+    // CRASH FIX: the entity may have been removed while the search ran
+    Entity* stuckEntity = getEntity(instanceName);
+    if (!stuckEntity) {
+        return;
+    }
+    Entity& entity = *stuckEntity;
+    std::string elementName = getElementName(instanceName);
+    
+    // An entity that got free on its own in the meantime keeps going
+    float nowX, nowY;
+    if (!elementsManager.getElementPosition(elementName, nowX, nowY)) {
+        return;
+    }
+    const float positionChangeThreshold = 0.02f;
+    if (std::sqrt((nowX - currentActualX) * (nowX - currentActualX) + (nowY - currentActualY) * (nowY - currentActualY)) > positionChangeThreshold) {
+        return;
+    }
+    
+    if (found) {
+        // Check if the safe position is too far from current position
+        float teleportDistance = std::sqrt(
+            (safeX - currentActualX) * (safeX - currentActualX) +
+            (safeY - currentActualY) * (safeY - currentActualY)
+        );
+        
+        const float maxTeleportDistance = 2.0f; // Don't teleport more than 2 units
+        if (teleportDistance <= maxTeleportDistance) {
+            // Safe position is close enough, teleport entity there
+            elementsManager.changeElementCoordinates(elementName, safeX, safeY);
+            
+            GAME_LOG_INFO("Successfully resolved stuck condition for entity " << entity.instanceName 
+                      << " - moved " << teleportDistance << " units to safe position (" << safeX << ", " << safeY << ")");
+            
+            // Reset stuck detection after successful resolution
+            entity.lastPositionX = safeX;
+            entity.lastPositionY = safeY;
+            entity.lastPositionChangeTime = entity.stuckCheckTime;
+            entity.stuckCount = 0;                            
+            // If using pathfinding, recalculate path from new position
+            if (entity.usePathfinding && entity.isWalking && 
+                g_entityAsyncPathfinder && !entity.isWaitingForPath) {
+                
+                GAME_LOG_INFO("Recalculating pathfinding for unstuck entity " << entity.instanceName 
+                          << " from new position (" << safeX << ", " << safeY << ")");
+                  // Cancel existing pathfinding request if any
+                if (entity.pathfindingRequestId > 0) {
+                    g_entityAsyncPathfinder->cancelPathfindingRequest(entity.instanceName);
+                }
+                
+                // Check pathfinding cooldown before requesting
+                if (canEntityRequestPathfinding(entity.instanceName)) {
+                    // Request new pathfinding from safe position to original target
+                    int newRequestId = g_entityAsyncPathfinder->requestPathfinding(
+                        entity.instanceName, safeX, safeY, entity.targetX, entity.targetY, config, entity.walkType
+                    );
+                      if (newRequestId > 0) {
+                        entity.pathfindingRequestId = newRequestId;
+                        entity.isWaitingForPath = true;
+                        entity.lastPathRequest = std::chrono::steady_clock::now();
+                        
+                        // Update pathfinding cooldown time for this entity
+                        updateEntityPathfindingTime(entity.instanceName);
+                    }
+                } else {
+                    GAME_LOG_INFO("Pathfinding request for unstuck entity " << entity.instanceName 
+                              << " denied due to cooldown");
+                }
+            }
+        } else {
+            GAME_LOG_INFO("Safe position for entity " << entity.instanceName 
+                      << " is too far away (" << teleportDistance << " units) - stopping entity instead of teleporting");
+            
+            // Stop the entity instead of teleporting too far using centralized function
+            stopEntityMovement(entity.instanceName);
+            
+            // Reset stuck detection
+            entity.lastPositionX = currentActualX;
+            entity.lastPositionY = currentActualY;
+            entity.lastPositionChangeTime = entity.stuckCheckTime;
+            entity.stuckCount = 0;
+        }
+    } else {
+        GAME_LOG_INFO("Failed to resolve stuck condition for entity " << entity.instanceName 
+                  << " - no safe position found. Stopping entity.");
+        
+        // Stop the entity if no safe position can be found using centralized function
+        stopEntityMovement(entity.instanceName);
+        
+        // Reset stuck detection to avoid immediate re-triggering
+        entity.lastPositionChangeTime = entity.stuckCheckTime;
+        entity.stuckCount = 0;
+    }
+}
+
 // Function to check entity collision with elements (uses collision shape points if available, otherwise fallback to radius)
 bool wouldEntityCollideWithElement(const EntityConfiguration& config, float x, float y) {
     if (!config.collisionShapePoints.empty()) {
@@ -2045,9 +2158,10 @@ bool wouldEntityCollideWithElementsGranular(const EntityConfiguration& config, f
             float dist = std::sqrt(point.first * point.first + point.second * point.second);
             searchRadius = std::max(searchRadius, dist);
         }
-    }// Use hierarchical spatial grid for better performance with large numbers of elements
-    // Thread-safe access to hierarchical grid
-    std::vector<std::string> nearbyElements;
+    }
+    // Use hierarchical spatial grid for better performance with large numbers of elements
+    // Thread-safe access to hierarchical grid. The result buffer is reused between calls.
+    thread_local static std::vector<SymbolId> nearbyElements;
     {
         std::lock_guard<std::mutex> lock(g_hierarchicalGridMutex);
         // Initialize hierarchical grid if needed
@@ -2059,71 +2173,71 @@ bool wouldEntityCollideWithElementsGranular(const EntityConfiguration& config, f
         g_hierarchicalGrid.updateGrid();
         
         // Get nearby elements using optimized hierarchical lookup
-        nearbyElements = g_hierarchicalGrid.getElementsHierarchical(x, y, searchRadius + MAX_COLLISION_CHECK_RANGE);
+        g_hierarchicalGrid.getElementsHierarchical(x, y, searchRadius + MAX_COLLISION_CHECK_RANGE, nearbyElements);
     }
     // PERFORMANCE OPTIMIZATION: Thread-safe cache with proper synchronization
     // Use thread_local to avoid contention between threads
-    thread_local static std::unordered_map<std::string, PlacedElement> elementDataCache;
+    // The cache is a copy of the elements vector plus a slot per symbol (index + 1, 0 = absent)
+    thread_local static std::vector<PlacedElement> elementDataCache;
+    thread_local static std::vector<uint32_t> elementDataCacheSlots;
     thread_local static float lastCacheUpdateTime = 0.0f;
-    thread_local static std::unordered_set<ElementName> elementsToCheckSet;
-    thread_local static bool elementSetCached = false;
     thread_local static bool collisionCacheInitialized = false;
     
     // Refresh cache periodically or when elements list changes
-    float currentTime = static_cast<float>(glfwGetTime());
-    if (!collisionCacheInitialized || currentTime - lastCacheUpdateTime > 1.0f) {
-        elementDataCache.clear();
-        elementsToCheckSet.clear();
-        
+    float currentTime = static_cast<float>(getGameTime());
+    if (!collisionCacheInitialized || currentTime - lastCacheUpdateTime > 1.0f || currentTime < lastCacheUpdateTime) {
         // Get fresh copy of elements (this is already thread-safe in ElementsManager)
-        const auto& elements = elementsManager.getElements();
-        elementDataCache.reserve(elements.size()); // Pre-allocate to prevent reallocations
-        
-        for (const auto& el : elements) {
-            elementDataCache[el.instanceName] = el; // Store copy of element data
+        elementDataCache = elementsManager.getElements();
+        std::fill(elementDataCacheSlots.begin(), elementDataCacheSlots.end(), 0);
+        for (size_t i = 0; i < elementDataCache.size(); ++i) {
+            SymbolId symbol = elementDataCache[i].symbol;
+            if (symbol >= elementDataCacheSlots.size()) {
+                elementDataCacheSlots.resize(symbol + 1, 0);
+            }
+            elementDataCacheSlots[symbol] = static_cast<uint32_t>(i + 1);
         }
         
         lastCacheUpdateTime = currentTime;
         collisionCacheInitialized = true;
-        elementSetCached = false;
     }
     
-    // Cache the set conversion for faster lookups (thread-local, no race condition)
-    if (!elementSetCached) {
-        elementsToCheckSet.clear();
-        elementsToCheckSet.reserve(elementsToCheck.size()); // Pre-allocate
-        elementsToCheckSet.insert(elementsToCheck.begin(), elementsToCheck.end());
-        elementSetCached = true;
-    }    // CAMERA CULLING OPTIMIZATION: Get current camera bounds to avoid processing elements outside view
-    float cameraLeft = gameCamera.getLeft();
-    float cameraRight = gameCamera.getRight();
-    float cameraBottom = gameCamera.getBottom();
-    float cameraTop = gameCamera.getTop();
+    // The entity's own collision box only depends on this call's position: built once, on the
+    // first candidate that needs it, into a buffer reused between calls
+    thread_local static PreCalculatedCollisionBox entityCollisionBox;
+    bool entityCollisionBoxReady = false;
+    
+    // CAMERA CULLING OPTIMIZATION: Get current camera bounds to avoid processing elements outside view
+    // (not in a lockstep session: the result must not depend on the window size)
+    const bool cullOutsideCamera = !isLockstepSimulation();
+    CameraView cameraView = gameCamera.getView(); // One consistent snapshot, published by the player thread
+    float cameraLeft = cameraView.left;
+    float cameraRight = cameraView.right;
+    float cameraBottom = cameraView.bottom;
+    float cameraTop = cameraView.top;
     
     // Check collision only with elements that match the specified texture types
-    for (const auto& elementName : nearbyElements) {
+    for (SymbolId elementSymbol : nearbyElements) {
         // PERFORMANCE FIX: Use cached lookup instead of linear search
-        auto cacheIt = elementDataCache.find(elementName);
-        if (cacheIt == elementDataCache.end()) {
+        if (elementSymbol >= elementDataCacheSlots.size() || elementDataCacheSlots[elementSymbol] == 0) {
             continue; // Element not found in cache
         }
         
-        const PlacedElement& currentElement = cacheIt->second; // Get reference to cached data
+        const PlacedElement& currentElement = elementDataCache[elementDataCacheSlots[elementSymbol] - 1]; // Get reference to cached data
         if (!currentElement.hasCollision) {
             continue; // Skip elements without collision enabled
         }
         
-        // PERFORMANCE FIX: Use set lookup instead of linear search
-        if (elementsToCheckSet.find(currentElement.elementName) == elementsToCheckSet.end()) {
+        // The lists hold a handful of types: a linear scan beats building a set per call
+        if (std::find(elementsToCheck.begin(), elementsToCheck.end(), currentElement.elementName) == elementsToCheck.end()) {
             continue; // Skip elements not in our collision/avoidance list
         }
           // CAMERA CULLING: Skip elements that are outside the camera view with generous buffer
         // Only apply culling when entity is also outside camera view to prevent edge cases
         const float cameraBuffer = 10.0f; // Buffer to prevent culling elements near camera edges
-        if (currentElement.x < cameraLeft - currentElement.scale - cameraBuffer || 
+        if (cullOutsideCamera && (currentElement.x < cameraLeft - currentElement.scale - cameraBuffer || 
             currentElement.x > cameraRight + currentElement.scale + cameraBuffer || 
             currentElement.y < cameraBottom - currentElement.scale - cameraBuffer || 
-            currentElement.y > cameraTop + currentElement.scale + cameraBuffer) {
+            currentElement.y > cameraTop + currentElement.scale + cameraBuffer)) {
             
             // Also check if the entity itself is outside camera view before culling
             if (x < cameraLeft - searchRadius - cameraBuffer || 
@@ -2154,10 +2268,12 @@ bool wouldEntityCollideWithElementsGranular(const EntityConfiguration& config, f
             // PERFORMANCE OPTIMIZATION: Use pre-calculated collision boxes for massive speedup
             // This replaces the expensive real-time transformation calculations
             
-            // Get or calculate cached collision box for entity
-            PreCalculatedCollisionBox entityCollisionBox;
-            const auto& entityCachedBox = CollisionBoxUtils::getOrUpdateCollisionBox(
-                entityCollisionBox, config.collisionShapePoints, x, y, 0.0f, 1.0f);
+            // Calculate the entity collision box once per call
+            if (!entityCollisionBoxReady) {
+                CollisionBoxUtils::calculateCollisionBox(entityCollisionBox, config.collisionShapePoints, x, y, 0.0f, 1.0f);
+                entityCollisionBoxReady = true;
+            }
+            const PreCalculatedCollisionBox& entityCachedBox = entityCollisionBox;
             
             // Get or calculate cached collision box for element 
             const auto& elementCachedBox = CollisionBoxUtils::getOrUpdateCollisionBox(
@@ -2230,17 +2346,17 @@ bool wouldEntityCollideWithBlocksGranular(const EntityConfiguration& config, flo
         return false; // No blocks to check = no collision
     }
     
-    // Convert to std::set for faster lookup
-    std::set<BlockName> blockSet(blocksToCheck.begin(), blocksToCheck.end());
-    
     // If entity has no collision shape, fall back to point-based collision
     if (config.collisionShapePoints.empty()) {
+        std::set<BlockName> blockSet(blocksToCheck.begin(), blocksToCheck.end());
         return wouldCollideWithMapBlock(x, y, gameMap, blockSet);
     }
     
     // Use collision shape for precise block collision detection
-    // Transform entity collision shape points to world coordinates
-    std::vector<std::pair<float, float>> entityWorldShapePoints;
+    // Transform entity collision shape points to world coordinates (frame arena buffer)
+    FrameArenaScope arenaScope;
+    FrameVector<std::pair<float, float>> entityWorldShapePoints(&frameArena());
+    entityWorldShapePoints.reserve(config.collisionShapePoints.size());
     float entityAngleRad = 0.0f; // Entities don't rotate currently
     float entityCosA = cos(entityAngleRad);
     float entitySinA = sin(entityAngleRad);
@@ -2256,7 +2372,8 @@ bool wouldEntityCollideWithBlocksGranular(const EntityConfiguration& config, flo
     }
       // CRASH FIX: Check if transformation actually produced any points
     if (entityWorldShapePoints.empty()) {
-        std::cerr << "CRITICAL: entityWorldShapePoints is empty after transformation - using fallback collision detection" << std::endl;
+        GAME_LOG_ERROR("CRITICAL: entityWorldShapePoints is empty after transformation - using fallback collision detection");
+        std::set<BlockName> blockSet(blocksToCheck.begin(), blocksToCheck.end());
         return wouldCollideWithMapBlock(x, y, gameMap, blockSet);
     }
     
@@ -2281,9 +2398,9 @@ bool wouldEntityCollideWithBlocksGranular(const EntityConfiguration& config, flo
     
     // Clamp to valid grid coordinates
     startGridX = std::max(0, startGridX);
-    endGridX = std::min(GRID_SIZE - 1, endGridX);
+    endGridX = std::min(WORLD_SIZE - 1, endGridX);
     startGridY = std::max(0, startGridY);
-    endGridY = std::min(GRID_SIZE - 1, endGridY);
+    endGridY = std::min(WORLD_SIZE - 1, endGridY);
     
     // Check each grid cell that might overlap with the entity
     for (int gridY = startGridY; gridY <= endGridY; ++gridY) {
@@ -2291,10 +2408,10 @@ bool wouldEntityCollideWithBlocksGranular(const EntityConfiguration& config, flo
             // Get the block type at this grid position
             BlockName blockType = gameMap.getBlockNameByCoordinates(gridX, gridY);
             
-            // Check if this block type is in our collision list
-            if (blockSet.find(blockType) != blockSet.end()) {
+            // Check if this block type is in our collision list (a handful of types: linear scan)
+            if (std::find(blocksToCheck.begin(), blocksToCheck.end(), blockType) != blocksToCheck.end()) {
                 // Create a polygon for the block (full grid cell)
-                std::vector<std::pair<float, float>> blockShapePoints = {
+                const std::pair<float, float> blockShapePoints[4] = {
                     {static_cast<float>(gridX), static_cast<float>(gridY)},         // Bottom-left
                     {static_cast<float>(gridX + 1), static_cast<float>(gridY)},     // Bottom-right  
                     {static_cast<float>(gridX + 1), static_cast<float>(gridY + 1)}, // Top-right
@@ -2302,7 +2419,7 @@ bool wouldEntityCollideWithBlocksGranular(const EntityConfiguration& config, flo
                 };
                 
                 // Check if entity collision shape overlaps with this block
-                if (polygonPolygonCollision(entityWorldShapePoints, blockShapePoints)) {
+                if (polygonPolygonCollision(entityWorldShapePoints, PolygonView(blockShapePoints, 4))) {
                     return true; // Collision detected with block
                 }
             }
@@ -2317,14 +2434,14 @@ bool EntitiesManager::teleportEntity(const std::string& instanceName, float x, f
     // Get the entity
     Entity* entity = getEntity(instanceName);
     if (!entity) {
-        std::cerr << "Entity not found: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Entity not found: " << instanceName);
         return false;
     }
     
     // Get the configuration
     const EntityConfiguration* config = getConfiguration(entity->type);
     if (!config) {
-        std::cerr << "Entity configuration not found: " << entityNameToString(entity->type) << std::endl;
+        GAME_LOG_ERROR("Entity configuration not found: " << entityNameToString(entity->type));
         return false;
     }
     
@@ -2340,17 +2457,17 @@ bool EntitiesManager::teleportEntity(const std::string& instanceName, float x, f
         (wouldEntityCollideWithElementsGranular(*config, x, y, false) || 
          wouldEntityCollideWithBlocksGranular(*config, x, y, false))) {
         
-        std::cout << "Entity " << instanceName << " would be teleported into collision area at (" 
-                  << x << ", " << y << ") - attempting collision resolution..." << std::endl;
+        GAME_LOG_INFO("Entity " << instanceName << " would be teleported into collision area at (" 
+                  << x << ", " << y << ") - attempting collision resolution...");
         
         // Try to find a safe position nearby
         if (resolveEntityCollisionStuck(instanceName, safeX, safeY, *config, gameMap)) {
             needsSafePosition = true;
-            std::cout << "Found safe teleport position for " << instanceName 
-                      << " at (" << safeX << ", " << safeY << ")" << std::endl;
+            GAME_LOG_INFO("Found safe teleport position for " << instanceName 
+                      << " at (" << safeX << ", " << safeY << ")");
         } else {
-            std::cout << "Warning: Could not find safe teleport position for " << instanceName 
-                      << " - teleporting to requested coordinates (" << x << ", " << y << ")" << std::endl;
+            GAME_LOG_WARN("Warning: Could not find safe teleport position for " << instanceName 
+                      << " - teleporting to requested coordinates (" << x << ", " << y << ")");
             safeX = x;
             safeY = y;
         }
@@ -2359,7 +2476,7 @@ bool EntitiesManager::teleportEntity(const std::string& instanceName, float x, f
     stopEntityMovement(instanceName);
       // Teleport the element on the map
     if (!elementsManager.changeElementCoordinates(elementName, safeX, safeY)) {
-        std::cerr << "Failed to teleport entity element: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Failed to teleport entity element: " << instanceName);
         return false;
     }
     
@@ -2368,11 +2485,12 @@ bool EntitiesManager::teleportEntity(const std::string& instanceName, float x, f
     
     // Reset to default sprite
     
-    std::cout << "Teleported entity " << instanceName << " to (" << safeX << ", " << safeY << ")";
     if (needsSafePosition && (safeX != x || safeY != y)) {
-        std::cout << " (collision resolved from requested " << x << ", " << y << ")";
+        GAME_LOG_INFO("Teleported entity " << instanceName << " to (" << safeX << ", " << safeY << ")"
+                      << " (collision resolved from requested " << x << ", " << y << ")");
+    } else {
+        GAME_LOG_INFO("Teleported entity " << instanceName << " to (" << safeX << ", " << safeY << ")");
     }
-    std::cout << std::endl;
     return true;
 }
 
@@ -2381,7 +2499,7 @@ void EntitiesManager::stopEntityMovement(const std::string& instanceName) {
     // Get the entity
     Entity* entity = getEntity(instanceName);
     if (!entity) {
-        std::cerr << "Entity not found for stopping movement: " << instanceName << std::endl;
+        GAME_LOG_ERROR("Entity not found for stopping movement: " << instanceName);
         return;
     }
     
@@ -2420,7 +2538,7 @@ void EntitiesManager::stopEntityMovement(const std::string& instanceName) {
 
 // Reset all entity movement states for gameplay restart
 void EntitiesManager::resetAllEntityMovementStates() {
-    std::cout << "Resetting all entity movement states for gameplay restart..." << std::endl;
+    GAME_LOG_INFO("Resetting all entity movement states for gameplay restart...");
     
     try {
         // 1. Clear all pathfinding cooldowns to allow immediate pathfinding requests
@@ -2506,21 +2624,21 @@ void EntitiesManager::resetAllEntityMovementStates() {
                 g_entityAsyncPathfinder->cancelPathfindingRequest(instanceName);
             }
             
-            std::cout << "Cancelled " << entityNamesToCancel.size() << " pending pathfinding requests" << std::endl;
+            GAME_LOG_INFO("Cancelled " << entityNamesToCancel.size() << " pending pathfinding requests");
         }
         
-        std::cout << "Entity movement states reset complete - " << entities.size() << " entities processed" << std::endl;
+        GAME_LOG_INFO("Entity movement states reset complete - " << entities.size() << " entities processed");
         
     } catch (const std::exception& e) {
-        std::cerr << "Exception while resetting entity movement states: " << e.what() << std::endl;
+        GAME_LOG_ERROR("Exception while resetting entity movement states: " << e.what());
     } catch (...) {
-        std::cerr << "Unknown exception while resetting entity movement states" << std::endl;
+        GAME_LOG_ERROR("Unknown exception while resetting entity movement states");
     }
 }
 
 // Clear all entities for gameplay restart
 void EntitiesManager::clearAllEntities() {
-    std::cout << "Clearing all entities for gameplay restart..." << std::endl;
+    GAME_LOG_INFO("Clearing all entities for gameplay restart...");
     
     try {
         // Get list of all entity instance names first to avoid iterator invalidation
@@ -2529,7 +2647,7 @@ void EntitiesManager::clearAllEntities() {
             entityNames.push_back(pair.first);
         }
         
-        std::cout << "Found " << entityNames.size() << " entities to clear" << std::endl;
+        GAME_LOG_INFO("Found " << entityNames.size() << " entities to clear");
         
         // Clear all entities using the destroy function
         extern ElementsOnMap elementsManager;
@@ -2547,7 +2665,7 @@ void EntitiesManager::clearAllEntities() {
             // Remove the element from the map
             elementsManager.removeElement(elementName);
             
-            std::cout << "Cleared entity " << instanceName << " and its element " << elementName << std::endl;
+            GAME_LOG_INFO("Cleared entity " << instanceName << " and its element " << elementName);
         }
         
         // Clear the entities map
@@ -2564,18 +2682,23 @@ void EntitiesManager::clearAllEntities() {
             g_hierarchicalEntityGrid.clear();
         }
         
-        std::cout << "All entities cleared successfully" << std::endl;
+        GAME_LOG_INFO("All entities cleared successfully");
         
     } catch (const std::exception& e) {
-        std::cerr << "Exception while clearing entities: " << e.what() << std::endl;
+        GAME_LOG_ERROR("Exception while clearing entities: " << e.what());
     } catch (...) {
-        std::cerr << "Unknown exception while clearing entities" << std::endl;
+        GAME_LOG_ERROR("Unknown exception while clearing entities");
     }
 }
 
 // Enhanced entity collision function that respects granular entity collision settings
 // useAvoidanceList: true = check avoidanceEntities, false = check collisionEntities
 bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, float x, float y, bool useAvoidanceList, const std::string& excludeInstanceName) {
+    // A name that was never interned can't match any nearby entity
+    return wouldEntityCollideWithEntitiesGranular(config, x, y, useAvoidanceList, findSymbol(excludeInstanceName));
+}
+
+bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, float x, float y, bool useAvoidanceList, SymbolId excludeEntity) {
     if (!config.canCollide) {
         return false; // Entity doesn't have collision enabled
     }
@@ -2595,30 +2718,34 @@ bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, f
         return false; // No entities to check = no collision
     }
     
-    // Convert to std::set for faster lookup
-    std::set<EntityName> entitySet(entitiesToCheck.begin(), entitiesToCheck.end());
+    // The lists hold a handful of types: a linear scan beats building a set per call
+    auto isEntityTypeChecked = [&entitiesToCheck](EntityName type) {
+        return std::find(entitiesToCheck.begin(), entitiesToCheck.end(), type) != entitiesToCheck.end();
+    };
+    
+    // Buffers reused between calls: this runs for every candidate step of every moving entity
+    thread_local static std::vector<SymbolId> nearbyEntities;
     
     // If entity has no collision shape, fall back to point-based collision
     if (config.collisionShapePoints.empty()) {
         // Simple radius-based collision check - look for nearby entities
         const float searchRadius = 1.0f; // Default search radius for entities without collision shapes
-        std::vector<std::string> nearbyEntities = getNearbyEntities(x, y, searchRadius);
+        getNearbyEntities(x, y, searchRadius, nearbyEntities);
         
-        for (const std::string& nearbyEntityName : nearbyEntities) {
-            if (nearbyEntityName == excludeInstanceName) continue; // Skip self
+        for (SymbolId nearbyEntitySymbol : nearbyEntities) {
+            if (nearbyEntitySymbol == excludeEntity) continue; // Skip self
             
-            Entity* nearbyEntity = entitiesManager.getEntity(nearbyEntityName);
+            Entity* nearbyEntity = entitiesManager.getEntity(nearbyEntitySymbol);
             if (!nearbyEntity) continue;
             
             // Check if this entity type is in our collision list
-            if (entitySet.find(nearbyEntity->type) == entitySet.end()) {
+            if (!isEntityTypeChecked(nearbyEntity->type)) {
                 continue; // Not in our collision list
             }
             
-            // Get nearby entity position
-            std::string nearbyElementName = EntitiesManager::getElementName(nearbyEntityName);
+            // Get nearby entity position (its element shares its symbol)
             float nearbyX, nearbyY;
-            if (elementsManager.getElementPosition(nearbyElementName, nearbyX, nearbyY)) {
+            if (elementsManager.getElementPosition(nearbyEntitySymbol, nearbyX, nearbyY)) {
                 float distance = std::sqrt((x - nearbyX) * (x - nearbyX) + (y - nearbyY) * (y - nearbyY));
                 if (distance < searchRadius) {
                     return true; // Collision detected
@@ -2630,7 +2757,9 @@ bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, f
     
     // Use collision shape for precise entity collision detection
     // Transform entity collision shape points to world coordinates
-    std::vector<std::pair<float, float>> entityWorldShapePoints;
+    thread_local static std::vector<std::pair<float, float>> entityWorldShapePoints;
+    thread_local static std::vector<std::pair<float, float>> nearbyEntityWorldShapePoints;
+    entityWorldShapePoints.clear();
     float entityAngleRad = 0.0f; // Entities don't rotate currently
     float entityCosA = cos(entityAngleRad);
     float entitySinA = sin(entityAngleRad);
@@ -2647,34 +2776,33 @@ bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, f
     
     // CRASH FIX: Check if transformation actually produced any points
     if (entityWorldShapePoints.empty()) {
-        std::cerr << "CRITICAL: entityWorldShapePoints is empty after transformation - using fallback collision detection" << std::endl;
+        GAME_LOG_ERROR("CRITICAL: entityWorldShapePoints is empty after transformation - using fallback collision detection");
         return false; // Fallback to no collision
     }
     
     // Check collision with other entities using hierarchical entity grid
     const float searchRadius = 3.0f; // Search radius for nearby entities
-    std::vector<std::string> nearbyEntities;
     
     // Use hierarchical entity grid if available
     {
         std::lock_guard<std::mutex> lock(g_hierarchicalEntityGridMutex);
         if (g_hierarchicalEntityGrid.isInitializedState()) {
-            nearbyEntities = g_hierarchicalEntityGrid.getEntitiesHierarchical(x, y, searchRadius);
+            g_hierarchicalEntityGrid.getEntitiesHierarchical(x, y, searchRadius, nearbyEntities);
         } else {
             // Fallback to basic spatial grid
-            nearbyEntities = getNearbyEntities(x, y, searchRadius);
+            getNearbyEntities(x, y, searchRadius, nearbyEntities);
         }
     }
     
     // Check each nearby entity for collision
-    for (const std::string& nearbyEntityName : nearbyEntities) {
-        if (nearbyEntityName == excludeInstanceName) continue; // Skip self
+    for (SymbolId nearbyEntitySymbol : nearbyEntities) {
+        if (nearbyEntitySymbol == excludeEntity) continue; // Skip self
         
-        Entity* nearbyEntity = entitiesManager.getEntity(nearbyEntityName);
+        Entity* nearbyEntity = entitiesManager.getEntity(nearbyEntitySymbol);
         if (!nearbyEntity) continue;
         
         // Check if this entity type is in our collision list
-        if (entitySet.find(nearbyEntity->type) == entitySet.end()) {
+        if (!isEntityTypeChecked(nearbyEntity->type)) {
             continue; // Not in our collision list
         }
         
@@ -2684,15 +2812,14 @@ bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, f
             continue; // Skip entities without collision shapes
         }
         
-        // Get nearby entity position
-        std::string nearbyElementName = EntitiesManager::getElementName(nearbyEntityName);
+        // Get nearby entity position (its element shares its symbol)
         float nearbyX, nearbyY;
-        if (!elementsManager.getElementPosition(nearbyElementName, nearbyX, nearbyY)) {
+        if (!elementsManager.getElementPosition(nearbyEntitySymbol, nearbyX, nearbyY)) {
             continue; // Could not get position
         }
         
         // Transform nearby entity collision shape to world coordinates
-        std::vector<std::pair<float, float>> nearbyEntityWorldShapePoints;
+        nearbyEntityWorldShapePoints.clear();
         float nearbyAngleRad = 0.0f; // Entities don't rotate currently
         float nearbyCosA = cos(nearbyAngleRad);
         float nearbySinA = sin(nearbyAngleRad);
@@ -2725,26 +2852,28 @@ void resetEntitySpatialGrid() {
 
 // Update entity spatial grid for collision optimization
 void updateEntitySpatialGrid() {
-    float currentTime = static_cast<float>(glfwGetTime());
+    float currentTime = static_cast<float>(getGameTime());
     
     // Only update every interval to avoid performance impact
-    if (entitySpatialGridInitialized && 
+    if (entitySpatialGridInitialized && currentTime >= lastEntitySpatialGridUpdateTime &&
         currentTime - lastEntitySpatialGridUpdateTime < ENTITY_SPATIAL_GRID_UPDATE_INTERVAL) {
         return;
     }
     
     lastEntitySpatialGridUpdateTime = currentTime;
-    entitySpatialGrid.clear();
+    // Empty the cells instead of dropping them: their buffers are reused by the next rebuild
+    for (auto& cell : entitySpatialGrid) {
+        cell.second.clear();
+    }
     
-    // Place each entity in the appropriate grid cell
+    // Place each entity in the appropriate grid cell (its element shares its symbol)
     for (const auto& pair : entitiesManager.getEntities()) {
-        const std::string& instanceName = pair.first;
-        std::string elementName = EntitiesManager::getElementName(instanceName);
+        SymbolId entity = pair.second.symbol;
         
         float x, y;
-        if (elementsManager.getElementPosition(elementName, x, y)) {
+        if (elementsManager.getElementPosition(entity, x, y)) {
             int index = getEntitySpatialGridIndex(x, y);
-            entitySpatialGrid[index].push_back(instanceName);
+            entitySpatialGrid[index].push_back(entity);
         }
     }
     
@@ -2760,9 +2889,21 @@ int getEntitySpatialGridIndex(float x, float y) {
 
 // Get nearby entities within radius for collision detection
 std::vector<std::string> getNearbyEntities(float x, float y, float radius) {
-    updateEntitySpatialGrid();
+    std::vector<SymbolId> symbols;
+    getNearbyEntities(x, y, radius, symbols);
     
     std::vector<std::string> result;
+    result.reserve(symbols.size());
+    for (SymbolId entity : symbols) {
+        result.push_back(symbolName(entity));
+    }
+    return result;
+}
+
+void getNearbyEntities(float x, float y, float radius, std::vector<SymbolId>& result) {
+    updateEntitySpatialGrid();
+    
+    result.clear();
     int cellRadius = static_cast<int>(radius / ENTITY_SPATIAL_GRID_SIZE) + 1;
     int centerCellX = static_cast<int>(x) / ENTITY_SPATIAL_GRID_SIZE;
     int centerCellY = static_cast<int>(y) / ENTITY_SPATIAL_GRID_SIZE;
@@ -2777,8 +2918,6 @@ std::vector<std::string> getNearbyEntities(float x, float y, float radius) {
             }
         }
     }
-    
-    return result;
 }
 
 // Handle waypoint arrival for entity movement precision
@@ -2839,11 +2978,11 @@ bool EntitiesManager::handleWaypointArrival(Entity& entity, const std::string& e
               // Apply sprite direction change
             bool phaseChanged = elementsManager.changeElementSpritePhase(elementName, spritePhase);
             if (!phaseChanged) {
-                std::cerr << "ERROR: Failed to change sprite phase for entity " << entity.instanceName 
-                          << " to phase " << spritePhase << " during waypoint arrival" << std::endl;
+                GAME_LOG_ERROR("ERROR: Failed to change sprite phase for entity " << entity.instanceName 
+                          << " to phase " << spritePhase << " during waypoint arrival");
             } else {
-                std::cout << "Entity " << entity.instanceName << " changed direction at waypoint - sprite phase: " 
-                          << spritePhase << " for direction: " << direction << std::endl;
+                GAME_LOG_INFO("Entity " << entity.instanceName << " changed direction at waypoint - sprite phase: " 
+                          << spritePhase << " for direction: " << direction);
             }
         } else {
             // Path completed - stop walking
@@ -2856,8 +2995,8 @@ bool EntitiesManager::handleWaypointArrival(Entity& entity, const std::string& e
             elementsManager.changeElementSpritePhase(elementName, config.defaultSpriteSheetPhase);
             elementsManager.changeElementSpriteFrame(elementName, config.defaultSpriteSheetFrame);
             
-            std::cout << "Entity " << entity.instanceName << " completed path and stopped at (" 
-                      << currentX << ", " << currentY << ")" << std::endl;
+            GAME_LOG_INFO("Entity " << entity.instanceName << " completed path and stopped at (" 
+                      << currentX << ", " << currentY << ")");
         }
         
         return true; // Waypoint was processed
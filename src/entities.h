@@ -12,6 +12,8 @@
 #include "enumDefinitions.h"
 #include "collisionCache.h"
 
+class LineCommandList; // renderCommands.h
+
 // Constants for entity movement and stuck detection
 const float ENTITY_STUCK_TIMEOUT_FOR_STOPPING_MOVEMENT = 0.5f; // seconds
 
@@ -242,6 +244,7 @@ struct EntityConfiguration {    EntityName type;
 
 // Struct to hold entity instance data
 struct Entity {    std::string instanceName;
+    SymbolId symbol = INVALID_SYMBOL; // Interned instanceName, also the symbol of its element
     EntityName type;
     
     // Health/damage system
@@ -369,6 +372,11 @@ public:
     
     // Shutdown async pathfinding system
     void shutdownAsyncPathfinding();
+    
+    // Lockstep simulation: queue the pathfinding requests and compute them at a fixed point of
+    // the tick (runDeferredPathfinding) instead of on the pathfinding workers
+    void setDeferredPathfinding(bool deferred);
+    void runDeferredPathfinding();
           // Update all entities (called once per frame)
     void update(double deltaTime);
     
@@ -382,10 +390,11 @@ public:
 
     // Get entity by instance name (made public for EntityBehaviorManager access)
     Entity* getEntity(const std::string& instanceName);
+    Entity* getEntity(SymbolId symbol);
 
-    // Draw debug paths for all entities
-    void drawDebugPaths(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop);    // Draw debug collision radii for all entities
-    void drawDebugCollisionRadii(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop);
+    // Record the debug paths of the walking entities whose path crosses the view (no OpenGL)
+    void recordDebugPaths(const VisibleSet& visible, LineCommandList& lines);    // Record the debug collision radii of the entities in view
+    void recordDebugCollisionRadii(const VisibleSet& visible, LineCommandList& lines);
     
 private:
     std::map<EntityName, EntityConfiguration> configurations;    std::map<std::string, Entity> entities;    // Helper methods
@@ -399,6 +408,10 @@ private:
     // Process async pathfinding results
     void processAsyncPathfindingResults();
     
+    // Apply a finished unstuck search (time-sliced job started by updateEntityWalking)
+    void applyStuckResolution(const std::string& instanceName, const EntityConfiguration& config, bool found,
+                              float safeX, float safeY, float currentActualX, float currentActualY);
+    
     // COLLISION RESOLUTION FUNCTIONS (DISABLED)
     // These functions are disabled but declarations kept for compatibility
 };
@@ -417,12 +430,16 @@ bool wouldEntityCollideWithBlocksGranular(const EntityConfiguration& config, flo
 // Enhanced entity collision function that respects granular entity collision settings
 // useAvoidanceList: true = check avoidanceEntities, false = check collisionEntities
 bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, float x, float y, bool useAvoidanceList = false, const std::string& excludeInstanceName = "");
+// Same, excluding an entity by interned name (per-tick callers: no string compare per candidate)
+bool wouldEntityCollideWithEntitiesGranular(const EntityConfiguration& config, float x, float y, bool useAvoidanceList, SymbolId excludeEntity);
 
 // Spatial grid functions for entity collision optimization
 int getEntitySpatialGridIndex(float x, float y);
 void updateEntitySpatialGrid();
 void resetEntitySpatialGrid();
 std::vector<std::string> getNearbyEntities(float x, float y, float radius);
+// Fills result (cleared first) with the interned names of the nearby entities
+void getNearbyEntities(float x, float y, float radius, std::vector<SymbolId>& result);
 
 // Global instance
 extern EntitiesManager entitiesManager;
\ No newline at end of file
@@ -175,6 +175,29 @@ void handleAttackDamage(const std::string& attackerInstanceName, const std::stri
     }
 }
 
+// Attacks reported by the behavior update, applied by the damage stage of the tick
+static std::mutex queuedAttacksMutex;
+static std::vector<std::pair<std::string, std::string>> queuedAttacks; // (attacker, target)
+
+void queueAttackDamage(const std::string& attackerInstanceName, const std::string& targetInstanceName) {
+    std::lock_guard<std::mutex> lock(queuedAttacksMutex);
+    queuedAttacks.emplace_back(attackerInstanceName, targetInstanceName);
+}
+
+void processQueuedAttackDamage(EntitiesManager& entitiesManager) {
+    std::vector<std::pair<std::string, std::string>> attacks;
+    {
+        std::lock_guard<std::mutex> lock(queuedAttacksMutex);
+        attacks.swap(queuedAttacks);
+    }
+    
+    // An earlier attack in the list may already have destroyed the attacker or the target:
+    // applyDamage skips entities that no longer exist
+    for (const auto& attack : attacks) {
+        handleAttackDamage(attack.first, attack.second, entitiesManager);
+    }
+}
+
 // Function to get the block name underneath an entity's anchor point
 BlockName giveBlockNameUnderneathEntity(const std::string& instanceName, EntitiesManager& entitiesManager) {
     // Get the entity
@@ -23,6 +23,13 @@ void processEntityDestructions(EntitiesManager& entitiesManager);
 void handleAttackDamage(const std::string& attackerInstanceName, const std::string& targetInstanceName,
                        EntitiesManager& entitiesManager);
 
+// Queue an attack for the damage stage of the logic tick instead of applying it mid-behavior update
+// (thread-safe; the target is only damaged/destroyed once processQueuedAttackDamage runs)
+void queueAttackDamage(const std::string& attackerInstanceName, const std::string& targetInstanceName);
+
+// Apply every queued attack in order (called once per tick after the behavior update)
+void processQueuedAttackDamage(EntitiesManager& entitiesManager);
+
 // Function to get the block name underneath an entity's anchor point
 BlockName giveBlockNameUnderneathEntity(const std::string& instanceName, EntitiesManager& entitiesManager);
 
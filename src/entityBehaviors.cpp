@@ -1,22 +1,21 @@
 #include "entityBehaviors.h"
+#include "gameLog.h"
 #include "entities.h"
 #include "elementsOnMap.h" // For global elementsManager
 #include "collision.h" // For collision functions
 #include "entitiesStatus.h" // For damage system
-#include "globals.h" // For TERRAIN_RNG
+#include "globals.h"
+#include "simulationRandom.h" // Seeded BEHAVIORS stream
+#include "timeSlicedJobs.h" // Flee point searches run as time-sliced jobs
+#include "frameArena.h" // Per-tick entity symbol list
 #include <iostream>
 #include <random>
 #include <chrono>
 #include <limits> // For numeric_limits
 #include <cmath> // For sqrt, atan2
+#include <memory> // For shared_ptr
 #include "enumDefinitions.h"
 
-// Forward declaration
-bool findAccessibleFleePoint(const std::string& entityInstanceName, EntitiesManager& entitiesManager,
-                            float currentX, float currentY, float threatX, float threatY,
-                            float minDistance, float maxDistance,
-                            float idealX, float idealY, float& resultX, float& resultY);
-
 // Helper function to check if a position is accessible for an entity in flee state
 bool isFleePositionAccessible(const std::string& entityInstanceName, EntitiesManager& entitiesManager,
                              float x, float y) {
@@ -45,124 +44,205 @@ bool isFleePositionAccessible(const std::string& entityInstanceName, EntitiesMan
     return true;
 }
 
-// Intelligent function to find an accessible flee point when facing dead ends
-bool findAccessibleFleePoint(const std::string& entityInstanceName, EntitiesManager& entitiesManager,
-                            float currentX, float currentY, float threatX, float threatY,
-                            float minDistance, float maxDistance,
-                            float idealX, float idealY, float& resultX, float& resultY) {
-    
-    // Strategy 1: Try the ideal position first (original behavior)
-    if (isFleePositionAccessible(entityInstanceName, entitiesManager, idealX, idealY)) {
-        // Check distance from threat to ensure it's safe
-        float distanceFromThreat = std::sqrt((idealX - threatX) * (idealX - threatX) + 
-                                           (idealY - threatY) * (idealY - threatY));
-        if (distanceFromThreat >= minDistance) {
-            resultX = idealX;
-            resultY = idealY;
-            return true;
-        }
-    }
-    
-    // Strategy 2: Try alternative directions if ideal point is blocked
-    // Calculate direction away from threat
-    float dx = currentX - threatX;
-    float dy = currentY - threatY;
-    float threatDistance = std::sqrt(dx * dx + dy * dy);
-    
-    if (threatDistance > 0.0f) {
-        dx /= threatDistance;
-        dy /= threatDistance;
-        
-        // Try different angles around the ideal direction
-        const float angleStep = 30.0f * M_PI / 180.0f; // 30 degrees in radians
-        const int maxAngles = 12; // Try up to 360 degrees
-        
-        for (int i = 1; i <= maxAngles; i++) {
+// Intelligent search for an accessible flee point when facing dead ends, as a resumable job
+// (timeSlicedJobs.h): a trapped entity can need hundreds of probes, so step() makes at most
+// FLEE_PROBES_PER_STEP of them and continues from there on the next call. The probe order is
+// the one of the original single-call search:
+//   1. the ideal point straight away from the threat
+//   2. alternative directions, +/-30 degree steps around the ideal one, at every distance in the flee range
+//   3. a spiral around the entity for any accessible point at least half the minimum distance from the threat
+//   4. last resort: any accessible point within 3 units
+const int FLEE_PROBES_PER_STEP = 16;
+
+class FleePointSearch {
+public:
+    FleePointSearch(const std::string& entityInstanceName, float currentX, float currentY, float threatX, float threatY,
+                    float minDistance, float maxDistance, float idealX, float idealY)
+        : entityInstanceName(entityInstanceName), currentX(currentX), currentY(currentY), threatX(threatX), threatY(threatY),
+          minDistance(minDistance), maxDistance(maxDistance), idealX(idealX), idealY(idealY) {}
+    
+    // Make up to maxProbes position checks; true once the search is over (see found())
+    bool step(EntitiesManager& entitiesManager, int maxProbes);
+    bool found() const { return success; }
+    float getResultX() const { return resultX; }
+    float getResultY() const { return resultY; }
+    
+private:
+    enum Strategy { IDEAL_POINT, ALTERNATIVE_DIRECTIONS, SPIRAL, LAST_RESORT, FINISHED };
+    
+    bool finish(bool foundPoint, float x, float y) {
+        strategy = FINISHED;
+        success = foundPoint;
+        resultX = x;
+        resultY = y;
+        return true;
+    }
+    
+    float distanceFromThreat(float x, float y) const {
+        return std::sqrt((x - threatX) * (x - threatX) + (y - threatY) * (y - threatY));
+    }
+    
+    std::string entityInstanceName;
+    float currentX, currentY, threatX, threatY;
+    float minDistance, maxDistance;
+    float idealX, idealY;
+    
+    Strategy strategy = IDEAL_POINT;
+    bool success = false;
+    float resultX = 0.0f, resultY = 0.0f;
+    
+    // Loop positions of the strategy in progress
+    float awayX = 0.0f, awayY = 0.0f; // Unit direction away from the threat (strategy 2)
+    int angleIndex = 1;
+    float testDistance = 0.0f;
+    float radius = 0.0f;
+    int directionIndex = 0;
+};
+
+bool FleePointSearch::step(EntitiesManager& entitiesManager, int maxProbes) {
+    if (strategy == FINISHED) {
+        return true;
+    }
+    // CRASH FIX: the entity can be removed between two steps - every probe would fail and the
+    // search would walk through all four strategies for nothing
+    if (!entitiesManager.entityExists(entityInstanceName)) {
+        return finish(false, 0.0f, 0.0f);
+    }
+    
+    int probes = 0;
+    while (probes < maxProbes) {
+        switch (strategy) {
+        case IDEAL_POINT: {
+            // Strategy 1: Try the ideal position first (original behavior)
+            ++probes;
+            if (isFleePositionAccessible(entityInstanceName, entitiesManager, idealX, idealY)) {
+                // Check distance from threat to ensure it's safe
+                if (distanceFromThreat(idealX, idealY) >= minDistance) {
+                    return finish(true, idealX, idealY);
+                }
+            }
+            
+            // Strategy 2: Try alternative directions if ideal point is blocked
+            // Calculate direction away from threat
+            awayX = currentX - threatX;
+            awayY = currentY - threatY;
+            float threatDistance = std::sqrt(awayX * awayX + awayY * awayY);
+            if (threatDistance > 0.0f) {
+                awayX /= threatDistance;
+                awayY /= threatDistance;
+                angleIndex = 1;
+                testDistance = minDistance;
+                strategy = ALTERNATIVE_DIRECTIONS;
+            } else {
+                radius = 1.0f;
+                directionIndex = 0;
+                strategy = SPIRAL;
+            }
+            break;
+        }
+        case ALTERNATIVE_DIRECTIONS: {
+            // Try different angles around the ideal direction, up to 360 degrees in 30 degree steps
+            const float angleStep = 30.0f * M_PI / 180.0f;
+            const int maxAngles = 12;
+            if (angleIndex > maxAngles) {
+                // Strategy 3: If no good direction away from threat, find ANY accessible position in flee zone
+                radius = 1.0f;
+                directionIndex = 0;
+                strategy = SPIRAL;
+                break;
+            }
+            if (testDistance > maxDistance) {
+                ++angleIndex;
+                testDistance = minDistance;
+                break;
+            }
+            
             // Alternate between positive and negative angles
-            float angle = (i % 2 == 1) ? (i / 2) * angleStep : -(i / 2) * angleStep;
+            float angle = (angleIndex % 2 == 1) ? (angleIndex / 2) * angleStep : -(angleIndex / 2) * angleStep;
             
             // Rotate the direction vector
-            float rotatedDx = dx * std::cos(angle) - dy * std::sin(angle);
-            float rotatedDy = dx * std::sin(angle) + dy * std::cos(angle);
+            float rotatedDx = awayX * std::cos(angle) - awayY * std::sin(angle);
+            float rotatedDy = awayX * std::sin(angle) + awayY * std::cos(angle);
+            float testX = currentX + rotatedDx * testDistance;
+            float testY = currentY + rotatedDy * testDistance;
+            testDistance += 1.0f;
+            ++probes;
             
-            // Try different distances within the flee range
-            for (float testDistance = minDistance; testDistance <= maxDistance; testDistance += 1.0f) {
-                float testX = currentX + rotatedDx * testDistance;
-                float testY = currentY + rotatedDy * testDistance;
-                
-                if (isFleePositionAccessible(entityInstanceName, entitiesManager, testX, testY)) {
-                    // Verify this position maintains safe distance from threat
-                    float distanceFromThreat = std::sqrt((testX - threatX) * (testX - threatX) + 
-                                                       (testY - threatY) * (testY - threatY));
-                    if (distanceFromThreat >= minDistance) {
-                        resultX = testX;
-                        resultY = testY;
-                        std::cout << "Found alternative flee direction for " << entityInstanceName 
-                                  << " at angle " << (angle * 180.0f / M_PI) << " degrees" << std::endl;
-                        return true;
-                    }
-                }
+            // Verify this position maintains safe distance from threat
+            if (isFleePositionAccessible(entityInstanceName, entitiesManager, testX, testY) &&
+                distanceFromThreat(testX, testY) >= minDistance) {
+                GAME_LOG_INFO("Found alternative flee direction for " << entityInstanceName 
+                          << " at angle " << (angle * 180.0f / M_PI) << " degrees");
+                return finish(true, testX, testY);
             }
-        }
-    }
-    
-    // Strategy 3: If no good direction away from threat, find ANY accessible position in flee zone
-    // Use spiral search pattern around current position
-    const float searchStep = 1.0f;
-    const float maxSearchRadius = maxDistance;
-    
-    for (float radius = 1.0f; radius <= maxSearchRadius; radius += searchStep) {
-        const int numDirections = std::max(8, static_cast<int>(radius * 4));
-        
-        for (int i = 0; i < numDirections; i++) {
-            float angle = (i * 2.0f * M_PI) / numDirections;
+            break;
+        }
+        case SPIRAL: {
+            // Spiral search pattern around current position
+            if (radius > maxDistance) {
+                // Strategy 4: Last resort - try to move to any nearby accessible position
+                // This handles extreme cases where entity is completely trapped
+                radius = 0.5f;
+                directionIndex = 0;
+                strategy = LAST_RESORT;
+                break;
+            }
+            const int numDirections = std::max(8, static_cast<int>(radius * 4));
+            if (directionIndex >= numDirections) {
+                radius += 1.0f;
+                directionIndex = 0;
+                break;
+            }
+            
+            float angle = (directionIndex * 2.0f * M_PI) / numDirections;
             float testX = currentX + radius * std::cos(angle);
             float testY = currentY + radius * std::sin(angle);
+            ++directionIndex;
+            ++probes;
             
-            if (isFleePositionAccessible(entityInstanceName, entitiesManager, testX, testY)) {
-                // Check if this position is far enough from threat
-                float distanceFromThreat = std::sqrt((testX - threatX) * (testX - threatX) + 
-                                                   (testY - threatY) * (testY - threatY));
-                
-                // Accept any position that's accessible, even if not optimal distance from threat
-                // This handles cases where the entity is truly trapped
-                if (distanceFromThreat >= minDistance * 0.5f) { // Relaxed distance requirement
-                    resultX = testX;
-                    resultY = testY;
-                    std::cout << "Found emergency flee position for " << entityInstanceName 
-                              << " at distance " << radius << " from current position" << std::endl;
-                    return true;
-                }
+            // Accept any position that's accessible, even if not optimal distance from threat
+            // This handles cases where the entity is truly trapped (relaxed distance requirement)
+            if (isFleePositionAccessible(entityInstanceName, entitiesManager, testX, testY) &&
+                distanceFromThreat(testX, testY) >= minDistance * 0.5f) {
+                GAME_LOG_INFO("Found emergency flee position for " << entityInstanceName 
+                          << " at distance " << radius << " from current position");
+                return finish(true, testX, testY);
             }
-        }
-    }
-    
-    // Strategy 4: Last resort - try to move to any nearby accessible position
-    // This handles extreme cases where entity is completely trapped
-    for (float radius = 0.5f; radius <= 3.0f; radius += 0.5f) {
-        const int numDirections = 8;
-        
-        for (int i = 0; i < numDirections; i++) {
-            float angle = (i * 2.0f * M_PI) / numDirections;
+            break;
+        }
+        case LAST_RESORT: {
+            const int numDirections = 8;
+            if (radius > 3.0f) {
+                // If we get here, the entity is completely trapped
+                GAME_LOG_WARN("WARNING: Entity " << entityInstanceName << " is completely trapped with no accessible flee positions!");
+                return finish(false, 0.0f, 0.0f);
+            }
+            if (directionIndex >= numDirections) {
+                radius += 0.5f;
+                directionIndex = 0;
+                break;
+            }
+            
+            float angle = (directionIndex * 2.0f * M_PI) / numDirections;
             float testX = currentX + radius * std::cos(angle);
             float testY = currentY + radius * std::sin(angle);
+            ++directionIndex;
+            ++probes;
             
             if (isFleePositionAccessible(entityInstanceName, entitiesManager, testX, testY)) {
-                resultX = testX;
-                resultY = testY;
-                std::cout << "Found last-resort position for trapped entity " << entityInstanceName 
-                          << " at distance " << radius << " from current position" << std::endl;
-                return true;
+                GAME_LOG_INFO("Found last-resort position for trapped entity " << entityInstanceName 
+                          << " at distance " << radius << " from current position");
+                return finish(true, testX, testY);
             }
+            break;
+        }
+        case FINISHED:
+            return true;
         }
     }
-    
-    // If we get here, the entity is completely trapped
-    std::cout << "WARNING: Entity " << entityInstanceName << " is completely trapped with no accessible flee positions!" << std::endl;
     return false;
 }
 
-
 // Global behavior manager instance
 EntityBehaviorManager entityBehaviorManager;
 
@@ -177,27 +257,29 @@ EntityBehaviorManager::~EntityBehaviorManager() {
 void EntityBehaviorManager::update(double deltaTime, EntitiesManager& entitiesManager) {
     // CRASH FIX: Safe entity iteration with proper reference handling
     try {
-        // Get reference to entities map and collect instance names first
+        // Get reference to entities map and collect instance symbols first (tick arena, no malloc)
         const auto& entitiesMap = entitiesManager.getEntities();
-        std::vector<std::string> entityNames;
-        entityNames.reserve(entitiesMap.size());
+        FrameArenaScope arenaScope;
+        FrameVector<SymbolId> entitySymbols(&frameArena());
+        entitySymbols.reserve(entitiesMap.size());
         
         for (const auto& pair : entitiesMap) {
-            entityNames.push_back(pair.first);
+            entitySymbols.push_back(pair.second.symbol);
         }
         
         // Process each entity by name to avoid iterator invalidation
-        for (const std::string& instanceName : entityNames) {
+        for (SymbolId entitySymbol : entitySymbols) {
+            const std::string& instanceName = symbolName(entitySymbol);
             // CRASH FIX: Verify entity still exists before processing
             if (!entitiesManager.entityExists(instanceName)) {
-                std::cout << "WARNING: Entity " << instanceName << " no longer exists during behavior update" << std::endl;
+                GAME_LOG_WARN("WARNING: Entity " << instanceName << " no longer exists during behavior update");
                 continue;
             }
             
             // Get fresh reference to the actual entity (not a copy)
             Entity* entity = entitiesManager.getEntity(instanceName);
             if (!entity) {
-                std::cout << "WARNING: Could not get entity reference for " << instanceName << std::endl;
+                GAME_LOG_WARN("WARNING: Could not get entity reference for " << instanceName);
                 continue;
             }
             
@@ -205,43 +287,44 @@ void EntityBehaviorManager::update(double deltaTime, EntitiesManager& entitiesMa
             updateEntityBehavior(*entity, deltaTime, entitiesManager);
         }
     } catch (const std::exception& e) {
-        std::cerr << "CRITICAL: Exception in entity behavior update: " << e.what() << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Exception in entity behavior update: " << e.what());
     } catch (...) {
-        std::cerr << "CRITICAL: Unknown exception in entity behavior update!" << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Unknown exception in entity behavior update!");
     }
 }
 
 void EntityBehaviorManager::update(double deltaTime, EntitiesManager& entitiesManager, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop) {
     // CRASH FIX: Safe entity iteration with proper reference handling and view frustum culling
     try {
-        // Get reference to entities map and collect instance names first
+        // Get reference to entities map and collect instance symbols first (tick arena, no malloc)
         const auto& entitiesMap = entitiesManager.getEntities();
-        std::vector<std::string> entityNames;
-        entityNames.reserve(entitiesMap.size());
+        FrameArenaScope arenaScope;
+        FrameVector<SymbolId> entitySymbols(&frameArena());
+        entitySymbols.reserve(entitiesMap.size());
         
         for (const auto& pair : entitiesMap) {
-            entityNames.push_back(pair.first);
+            entitySymbols.push_back(pair.second.symbol);
         }
         
         // Process each entity by name to avoid iterator invalidation with view frustum culling
-        for (const std::string& instanceName : entityNames) {
+        for (SymbolId entitySymbol : entitySymbols) {
+            const std::string& instanceName = symbolName(entitySymbol);
             // CRASH FIX: Verify entity still exists before processing
             if (!entitiesManager.entityExists(instanceName)) {
-                std::cout << "WARNING: Entity " << instanceName << " no longer exists during behavior update" << std::endl;
+                GAME_LOG_WARN("WARNING: Entity " << instanceName << " no longer exists during behavior update");
                 continue;
             }
             
             // Get fresh reference to the actual entity (not a copy)
             Entity* entity = entitiesManager.getEntity(instanceName);
             if (!entity) {
-                std::cout << "WARNING: Could not get entity reference for " << instanceName << std::endl;
+                GAME_LOG_WARN("WARNING: Could not get entity reference for " << instanceName);
                 continue;
             }
             
             // View frustum culling: Check if entity is within camera bounds
-            std::string elementName = EntitiesManager::getElementName(entity->instanceName);
             float entityX, entityY;
-            if (elementsManager.getElementPosition(elementName, entityX, entityY)) {
+            if (elementsManager.getElementPosition(entity->symbol, entityX, entityY)) {
                 // Get entity configuration to access scale for culling bounds
                 const EntityConfiguration* config = entitiesManager.getConfiguration(entity->type);
                 if (config) {
@@ -260,9 +343,9 @@ void EntityBehaviorManager::update(double deltaTime, EntitiesManager& entitiesMa
             updateEntityBehavior(*entity, deltaTime, entitiesManager);
         }
     } catch (const std::exception& e) {
-        std::cerr << "CRITICAL: Exception in entity behavior update: " << e.what() << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Exception in entity behavior update: " << e.what());
     } catch (...) {
-        std::cerr << "CRITICAL: Unknown exception in entity behavior update!" << std::endl;
+        GAME_LOG_ERROR("CRITICAL: Unknown exception in entity behavior update!");
     }
 }
 
@@ -306,15 +389,15 @@ void EntityBehaviorManager::updatePassiveStateBehavior(Entity& entity, double de
     if (entity.behaviorTimer >= entity.nextBehaviorTriggerTime) {        // Reset timer
         entity.behaviorTimer = 0.0;
         
-        // Generate next trigger time randomly between min and max using global seeded RNG
+        // Generate next trigger time randomly between min and max from the seeded behavior stream
         std::uniform_real_distribution<float> timeDist(config.passiveStateRandomWalkTriggerTimeIntervalMin, 
                                                        config.passiveStateRandomWalkTriggerTimeIntervalMax);
-        entity.nextBehaviorTriggerTime = timeDist(TERRAIN_RNG);
+        entity.nextBehaviorTriggerTime = drawSimulationRandom(RandomStream::BEHAVIORS, timeDist);
         
         // Only trigger random walk if entity is not currently moving or waiting for path
         if (!entity.isWalking && !entity.isWaitingForPath) {
-            std::cout << "Triggering passive behavior for entity " << entity.instanceName 
-                      << " - walking to random target within radius " << config.passiveStateWalkingRadius << std::endl;
+            GAME_LOG_INFO("Triggering passive behavior for entity " << entity.instanceName 
+                      << " - walking to random target within radius " << config.passiveStateWalkingRadius);
             
             // Trigger random walk within specified radius
             entitiesManager.walkEntityWithPathFindingToRandomRadiusTarget(
@@ -323,8 +406,8 @@ void EntityBehaviorManager::updatePassiveStateBehavior(Entity& entity, double de
                 WalkType::NORMAL
             );
         } else {
-            std::cout << "Entity " << entity.instanceName 
-                      << " is busy (walking or waiting), skipping passive behavior trigger" << std::endl;
+            GAME_LOG_INFO("Entity " << entity.instanceName 
+                      << " is busy (walking or waiting), skipping passive behavior trigger");
         }
     }
 }
@@ -338,13 +421,13 @@ void EntityBehaviorManager::initializeEntityBehavior(Entity& entity, const Entit
     if (config.passiveState) {        // Initialize behavior timer and next trigger time
         entity.behaviorTimer = 0.0;
         
-        // Generate initial trigger time randomly between min and max using global seeded RNG
+        // Generate initial trigger time randomly between min and max from the seeded behavior stream
         std::uniform_real_distribution<float> timeDist(config.passiveStateRandomWalkTriggerTimeIntervalMin, 
                                                        config.passiveStateRandomWalkTriggerTimeIntervalMax);
-        entity.nextBehaviorTriggerTime = timeDist(TERRAIN_RNG);
+        entity.nextBehaviorTriggerTime = drawSimulationRandom(RandomStream::BEHAVIORS, timeDist);
         
-        std::cout << "Initialized passive behavior for entity " << entity.instanceName 
-                  << " - first trigger in " << entity.nextBehaviorTriggerTime << " seconds" << std::endl;
+        GAME_LOG_INFO("Initialized passive behavior for entity " << entity.instanceName 
+                  << " - first trigger in " << entity.nextBehaviorTriggerTime << " seconds");
     }
 }
 
@@ -384,10 +467,9 @@ void EntityBehaviorManager::updateAlertStateBehavior(Entity& entity, double delt
             continue;
         }
         
-        // Get other entity position
-        std::string otherElementName = EntitiesManager::getElementName(otherEntity.instanceName);
+        // Get other entity position (its element shares its symbol: no name copy per pair)
         float otherX, otherY;
-        if (!elementsManager.getElementPosition(otherElementName, otherX, otherY)) {
+        if (!elementsManager.getElementPosition(otherEntity.symbol, otherX, otherY)) {
             continue; // Can't get position, skip this entity
         }
         
@@ -413,8 +495,8 @@ void EntityBehaviorManager::updateAlertStateBehavior(Entity& entity, double delt
     
     // Debug: Always log alert state changes
     if (wasInAlertState != entity.isInAlertState) {
-        std::cout << "DEBUG: Alert state changed for " << entity.instanceName 
-                  << " - was: " << wasInAlertState << ", now: " << entity.isInAlertState << std::endl;
+        GAME_LOG_DEBUG("DEBUG: Alert state changed for " << entity.instanceName 
+                  << " - was: " << wasInAlertState << ", now: " << entity.isInAlertState);
     }
     
     if (foundTriggerEntity) {
@@ -423,8 +505,8 @@ void EntityBehaviorManager::updateAlertStateBehavior(Entity& entity, double delt
         entity.alertTargetDistance = nearestDistance;
         
         if (!wasInAlertState) {
-            std::cout << "Entity " << entity.instanceName << " entering alert state - triggered by " 
-                      << nearestTriggerEntity << " at distance " << nearestDistance << std::endl;
+            GAME_LOG_INFO("Entity " << entity.instanceName << " entering alert state - triggered by " 
+                      << nearestTriggerEntity << " at distance " << nearestDistance);
             
             // Stop current movement when entering alert state
             entitiesManager.stopEntityMovement(entity.instanceName);
@@ -457,13 +539,13 @@ void EntityBehaviorManager::updateAlertStateBehavior(Entity& entity, double delt
                 // Update sprite to face the trigger entity
                 elementsManager.changeElementSpritePhase(elementName, spritePhase);
                 
-                std::cout << "Entity " << entity.instanceName << " facing " << nearestTriggerEntity 
-                          << " - angle: " << angle << "° -> sprite phase: " << spritePhase << std::endl;
+                GAME_LOG_INFO("Entity " << entity.instanceName << " facing " << nearestTriggerEntity 
+                          << " - angle: " << angle << "° -> sprite phase: " << spritePhase);
             }
         }
     } else if (wasInAlertState) {
         // Exit alert state
-        std::cout << "Entity " << entity.instanceName << " exiting alert state - no trigger entities in range" << std::endl;
+        GAME_LOG_INFO("Entity " << entity.instanceName << " exiting alert state - no trigger entities in range");
         entity.alertTargetEntityName = "";
         entity.alertTargetDistance = 0.0f;
         
@@ -509,10 +591,9 @@ void EntityBehaviorManager::updateFleeStateBehavior(Entity& entity, double delta
             continue;
         }
         
-        // Get other entity position
-        std::string otherElementName = EntitiesManager::getElementName(otherEntity.instanceName);
+        // Get other entity position (its element shares its symbol: no name copy per pair)
         float otherX, otherY;
-        if (!elementsManager.getElementPosition(otherElementName, otherX, otherY)) {
+        if (!elementsManager.getElementPosition(otherEntity.symbol, otherX, otherY)) {
             continue; // Can't get position, skip this entity
         }
         
@@ -539,8 +620,8 @@ void EntityBehaviorManager::updateFleeStateBehavior(Entity& entity, double delta
     
     // Debug: Log flee state changes
     if (wasInFleeState != entity.isInFleeState) {
-        std::cout << "DEBUG: Flee state changed for " << entity.instanceName 
-                  << " - was: " << wasInFleeState << ", now: " << entity.isInFleeState << std::endl;
+        GAME_LOG_DEBUG("DEBUG: Flee state changed for " << entity.instanceName 
+                  << " - was: " << wasInFleeState << ", now: " << entity.isInFleeState);
     }
     
     if (foundThreatEntity) {
@@ -549,8 +630,8 @@ void EntityBehaviorManager::updateFleeStateBehavior(Entity& entity, double delta
         entity.fleeTargetDistance = nearestThreatDistance;
         
         if (!wasInFleeState) {
-            std::cout << "Entity " << entity.instanceName << " entering flee state - threatened by " 
-                      << nearestThreatEntity << " at distance " << nearestThreatDistance << std::endl;
+            GAME_LOG_INFO("Entity " << entity.instanceName << " entering flee state - threatened by " 
+                      << nearestThreatEntity << " at distance " << nearestThreatDistance);
             
             // Stop current movement when entering flee state
             entitiesManager.stopEntityMovement(entity.instanceName);
@@ -590,39 +671,55 @@ void EntityBehaviorManager::updateFleeStateBehavior(Entity& entity, double delta
                     float idealSafeX = currentX + dx * targetFleeDistance;
                     float idealSafeY = currentY + dy * targetFleeDistance;
                     
-                    // Find the best accessible safe point using intelligent dead-end handling
-                    float finalSafeX, finalSafeY;
-                    if (findAccessibleFleePoint(entity.instanceName, entitiesManager, 
-                                               currentX, currentY, threatX, threatY,
-                                               config.fleeStateMinDistance, config.fleeStateMaxDistance,
-                                               idealSafeX, idealSafeY, finalSafeX, finalSafeY)) {
-                        
-                        std::cout << "Entity " << entity.instanceName << " fleeing from " << nearestThreatEntity 
-                                  << " - moving to accessible safe point (" << finalSafeX << ", " << finalSafeY 
-                                  << ") at distance " << std::sqrt((finalSafeX-currentX)*(finalSafeX-currentX) + (finalSafeY-currentY)*(finalSafeY-currentY)) << std::endl;
-                          // Move to safe point using appropriate walk type
-                        WalkType walkType = config.fleeStateRunning ? WalkType::SPRINT : WalkType::NORMAL;
-                        entitiesManager.walkEntityWithPathfinding(
-                            entity.instanceName, 
-                            finalSafeX, 
-                            finalSafeY, 
-                            walkType
-                        );
-                    } else {
-                        std::cout << "Entity " << entity.instanceName << " is trapped - no accessible flee destination found!" << std::endl;
-                        // Entity is truly trapped, just try to move to any nearby safe spot
-                        // This will be handled by the pathfinding system's fallback mechanisms
-                    }
+                    // Find the best accessible safe point using intelligent dead-end handling. The search
+                    // is a time-sliced job: a trapped entity's search spreads over a few ticks instead of
+                    // spiking this one, and a newer search for the same entity replaces a pending one
+                    std::string instanceName = entity.instanceName;
+                    std::string threatName = nearestThreatEntity;
+                    bool running = config.fleeStateRunning;
+                    EntitiesManager* manager = &entitiesManager;
+                    std::shared_ptr<FleePointSearch> search = std::make_shared<FleePointSearch>(
+                        instanceName, currentX, currentY, threatX, threatY,
+                        config.fleeStateMinDistance, config.fleeStateMaxDistance, idealSafeX, idealSafeY);
+                    
+                    g_timeSlicedJobs.submit("Flee point search", [=]() {
+                        if (!search->step(*manager, FLEE_PROBES_PER_STEP)) {
+                            return JobStep::CONTINUE;
+                        }
+                        // The threat may have gone away while the search ran
+                        Entity* fleeing = manager->getEntity(instanceName);
+                        if (!fleeing || !fleeing->isInFleeState) {
+                            return JobStep::DONE;
+                        }
+                        if (search->found()) {
+                            float finalSafeX = search->getResultX();
+                            float finalSafeY = search->getResultY();
+                            GAME_LOG_INFO("Entity " << instanceName << " fleeing from " << threatName 
+                                      << " - moving to accessible safe point (" << finalSafeX << ", " << finalSafeY 
+                                      << ") at distance " << std::sqrt((finalSafeX-currentX)*(finalSafeX-currentX) + (finalSafeY-currentY)*(finalSafeY-currentY)));
+                            // Move to safe point using appropriate walk type
+                            WalkType walkType = running ? WalkType::SPRINT : WalkType::NORMAL;
+                            manager->walkEntityWithPathfinding(instanceName, finalSafeX, finalSafeY, walkType);
+                        } else {
+                            GAME_LOG_INFO("Entity " << instanceName << " is trapped - no accessible flee destination found!");
+                            // Entity is truly trapped, just try to move to any nearby safe spot
+                            // This will be handled by the pathfinding system's fallback mechanisms
+                        }
+                        return JobStep::DONE;
+                    }, "flee:" + instanceName);
                 }
             }
         }
     } else if (wasInFleeState) {
         // Exit flee state
-        std::cout << "Entity " << entity.instanceName << " exiting flee state - no threat entities in range" << std::endl;
+        GAME_LOG_INFO("Entity " << entity.instanceName << " exiting flee state - no threat entities in range");
         entity.fleeTargetEntityName = "";
         entity.fleeTargetDistance = 0.0f;
         entity.fleeStateTimer = 0.0;
-        
+
+        // A flee point search still running has nothing left to do
+        g_timeSlicedJobs.cancel("flee:" + entity.instanceName);
+
         // Stop fleeing movement when exiting flee state
         // entitiesManager.stopEntityMovement(entity.instanceName);
     }
@@ -647,7 +744,7 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
         if (entity.attackStateWaitTimer >= entity.nextChargeTime) {
             entity.isWaitingBeforeCharge = false;
             entity.attackStateWaitTimer = 0.0;
-            std::cout << "Entity " << entity.instanceName << " finished waiting - ready to charge again" << std::endl;
+            GAME_LOG_INFO("Entity " << entity.instanceName << " finished waiting - ready to charge again");
         }
     }
     
@@ -678,10 +775,9 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
             continue;
         }
         
-        // Get other entity position
-        std::string otherElementName = EntitiesManager::getElementName(otherEntity.instanceName);
+        // Get other entity position (its element shares its symbol: no name copy per pair)
         float otherX, otherY;
-        if (!elementsManager.getElementPosition(otherElementName, otherX, otherY)) {
+        if (!elementsManager.getElementPosition(otherEntity.symbol, otherX, otherY)) {
             continue; // Can't get position, skip this entity
         }
         
@@ -710,8 +806,8 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
     
     // Debug: Log attack state changes
     if (wasInAttackState != entity.isInAttackState) {
-        std::cout << "DEBUG: Attack state changed for " << entity.instanceName 
-                  << " - was: " << wasInAttackState << ", now: " << entity.isInAttackState << std::endl;
+        GAME_LOG_DEBUG("DEBUG: Attack state changed for " << entity.instanceName 
+                  << " - was: " << wasInAttackState << ", now: " << entity.isInAttackState);
     }
     
     if (foundTargetEntity) {
@@ -720,8 +816,8 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
         entity.attackTargetDistance = nearestTargetDistance;
         
         if (!wasInAttackState) {
-            std::cout << "Entity " << entity.instanceName << " entering attack state - targeting " 
-                      << nearestTargetEntity << " at distance " << nearestTargetDistance << std::endl;
+            GAME_LOG_INFO("Entity " << entity.instanceName << " entering attack state - targeting " 
+                      << nearestTargetEntity << " at distance " << nearestTargetDistance);
             
             // Stop current movement when entering attack state
             entitiesManager.stopEntityMovement(entity.instanceName);
@@ -740,12 +836,12 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
                   if (nearestTargetDistance <= touchingDistance) {
                     // Entity is touching the target - start waiting before next charge
                     if (!entity.isWaitingBeforeCharge) {
-                        std::cout << "Entity " << entity.instanceName << " reached target " 
-                                  << nearestTargetEntity << " - starting wait period" << std::endl;
-                          // Apply damage to the target
-                        handleAttackDamage(entity.instanceName, nearestTargetEntity, entitiesManager);
+                        GAME_LOG_INFO("Entity " << entity.instanceName << " reached target " 
+                                  << nearestTargetEntity << " - starting wait period");
+                          // Apply damage to the target (in the damage stage, after every behavior ran)
+                        queueAttackDamage(entity.instanceName, nearestTargetEntity);
                         
-                        // Generate random wait time between min and max using global seeded RNG
+                        // Generate random wait time between min and max from the seeded behavior stream
                         std::uniform_real_distribution<float> waitDist(
                             config.attackStateWaitBeforeChargeMin, 
                             config.attackStateWaitBeforeChargeMax
@@ -753,10 +849,10 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
                         
                         entity.isWaitingBeforeCharge = true;
                         entity.attackStateWaitTimer = 0.0;
-                        entity.nextChargeTime = waitDist(TERRAIN_RNG);
+                        entity.nextChargeTime = drawSimulationRandom(RandomStream::BEHAVIORS, waitDist);
                         
-                        std::cout << "Entity " << entity.instanceName << " will wait " 
-                                  << entity.nextChargeTime << " seconds before charging again" << std::endl;
+                        GAME_LOG_INFO("Entity " << entity.instanceName << " will wait " 
+                                  << entity.nextChargeTime << " seconds before charging again");
                         
                         // Stop movement during wait period
                         entitiesManager.stopEntityMovement(entity.instanceName);
@@ -770,9 +866,9 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
                         // Determine walk type based on configuration
                         WalkType walkType = config.attackStateRunning ? WalkType::SPRINT : WalkType::NORMAL;
                         
-                        std::cout << "Entity " << entity.instanceName << " charging towards " 
+                        GAME_LOG_INFO("Entity " << entity.instanceName << " charging towards " 
                                   << nearestTargetEntity << " at (" << targetX << ", " << targetY 
-                                  << ") - distance: " << nearestTargetDistance << std::endl;
+                                  << ") - distance: " << nearestTargetDistance);
                         
                         // Walk directly towards the target entity
                         entitiesManager.walkEntityWithPathfinding(entity.instanceName, targetX, targetY, walkType);
@@ -782,7 +878,7 @@ void EntityBehaviorManager::updateAttackStateBehavior(Entity& entity, double del
         }
     } else if (wasInAttackState) {
         // Exit attack state
-        std::cout << "Entity " << entity.instanceName << " exiting attack state - no target entities in range" << std::endl;
+        GAME_LOG_INFO("Entity " << entity.instanceName << " exiting attack state - no target entities in range");
         entity.attackTargetEntityName = "";
         entity.attackTargetDistance = 0.0f;
         entity.attackStateTimer = 0.0;
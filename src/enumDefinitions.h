@@ -57,6 +57,20 @@ enum class GameState {
     WIN
 };
 
+// Input replay of a lockstep gameplay session (see simulationReplay.h)
+enum class ReplayMode {
+    OFF,
+    RECORD, // Record the per-tick input to REPLAY_PATH
+    PLAY    // Re-run REPLAY_PATH's seed and input, checking the world checksums
+};
+
+// How the main loop paces its frames (see framePacer.h)
+enum class FramePacingMode {
+    VSYNC,    // Swap interval 1: presents follow the monitor refresh
+    CAPPED,   // Swap interval 0, frames started on a fixed grid of 1 / FRAME_RATE_CAP
+    UNCAPPED  // Swap interval 0, no wait at all (benchmarks: measures raw rendering throughput)
+};
+
 // Utility functions for EntityName enum using magic_enum
 std::string entityNameToString(EntityName entityName);
 std::string elementNameToString(ElementName elementName);
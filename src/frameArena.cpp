@@ -0,0 +1,153 @@
+#include "frameArena.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace {
+
+// Arenas outlive their threads (the report may read them at any time); a thread that exits
+// frees its blocks and hands its arena to the next new thread
+std::mutex arenaRegistryMutex;
+std::vector<std::unique_ptr<FrameArena>> arenaRegistry;
+std::vector<FrameArena*> freeArenas;
+
+size_t alignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+FrameArena::~FrameArena() {
+    for (const Block& block : blocks) {
+        ::operator delete(block.data);
+    }
+}
+
+void FrameArena::releaseBlocks() {
+    for (const Block& block : blocks) {
+        ::operator delete(block.data);
+    }
+    blocks.clear();
+    currentBlock = 0;
+    currentOffset = 0;
+    bytesBeforeCurrent = 0;
+    reservedBytes.store(0, std::memory_order_relaxed);
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    allocationCount.store(allocationCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (!blocks.empty()) {
+        size_t start = alignUp(currentOffset, alignment);
+        if (start + bytes <= blocks[currentBlock].size) {
+            currentOffset = start + bytes;
+            notePeak();
+            return blocks[currentBlock].data + start;
+        }
+        // Next kept block large enough (::operator new blocks are aligned for any fundamental type)
+        for (size_t next = currentBlock + 1; next < blocks.size(); ++next) {
+            bytesBeforeCurrent += blocks[next - 1].size;
+            if (bytes <= blocks[next].size) {
+                currentBlock = next;
+                currentOffset = bytes;
+                notePeak();
+                return blocks[next].data;
+            }
+        }
+        bytesBeforeCurrent += blocks.back().size;
+    }
+
+    // Bigger than anything seen so far: this is the only place the arena allocates
+    Block block;
+    block.size = std::max(FRAME_ARENA_BLOCK_SIZE, alignUp(bytes, alignof(std::max_align_t)));
+    block.data = static_cast<char*>(::operator new(block.size));
+    blocks.push_back(block);
+    currentBlock = blocks.size() - 1;
+    currentOffset = bytes;
+    blockAllocationCount.store(blockAllocationCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    reservedBytes.store(reservedBytes.load(std::memory_order_relaxed) + block.size, std::memory_order_relaxed);
+    notePeak();
+    return block.data;
+}
+
+void FrameArena::do_deallocate(void* pointer, size_t bytes, size_t) {
+    // Only the latest allocation can be given back (a vector growing into a larger buffer)
+    if (!blocks.empty() && static_cast<char*>(pointer) + bytes == blocks[currentBlock].data + currentOffset) {
+        currentOffset = static_cast<size_t>(static_cast<char*>(pointer) - blocks[currentBlock].data);
+    }
+}
+
+void FrameArena::rewind(const Marker& marker) {
+    if (blocks.empty()) return;
+    currentBlock = marker.block;
+    currentOffset = marker.offset;
+    bytesBeforeCurrent = 0;
+    for (size_t block = 0; block < currentBlock; ++block) {
+        bytesBeforeCurrent += blocks[block].size;
+    }
+}
+
+void FrameArena::notePeak() {
+    size_t used = bytesBeforeCurrent + currentOffset;
+    if (used > peakBytes.load(std::memory_order_relaxed)) {
+        peakBytes.store(used, std::memory_order_relaxed);
+    }
+}
+
+namespace {
+
+// Frees the thread's blocks when it exits and returns its arena to the free list
+struct ThreadArenaHandle {
+    FrameArena* arena = nullptr;
+
+    ~ThreadArenaHandle() {
+        if (arena == nullptr) return;
+        arena->releaseBlocks();
+        std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+        freeArenas.push_back(arena);
+    }
+};
+
+} // namespace
+
+FrameArena& frameArena() {
+    thread_local ThreadArenaHandle handle;
+    if (handle.arena == nullptr) {
+        std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+        if (!freeArenas.empty()) {
+            handle.arena = freeArenas.back();
+            freeArenas.pop_back();
+        } else {
+            arenaRegistry.emplace_back(new FrameArena());
+            handle.arena = arenaRegistry.back().get();
+        }
+    }
+    return *handle.arena;
+}
+
+FrameArenaTotals collectFrameArenaTotals() {
+    FrameArenaTotals totals;
+    std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+    for (const auto& arena : arenaRegistry) {
+        totals.allocations += arena->getAllocationCount();
+        totals.blockAllocations += arena->getBlockAllocationCount();
+        totals.reservedBytes += arena->getReservedBytes();
+        totals.peakBytes = std::max(totals.peakBytes, arena->getPeakBytes());
+    }
+    totals.threads = static_cast<int>(arenaRegistry.size() - freeArenas.size());
+    return totals;
+}
+
+void printFrameArenaReport() {
+    static FrameArenaTotals previous;
+    FrameArenaTotals totals = collectFrameArenaTotals();
+
+    std::cout << "=== Frame Arena ===" << std::endl;
+    std::cout << "Allocations=" << totals.allocations - previous.allocations
+              << ", blocks allocated=" << totals.blockAllocations - previous.blockAllocations
+              << " (" << totals.blockAllocations << " total), reserved=" << totals.reservedBytes / 1024
+              << "KB over " << totals.threads << " threads, peak per thread=" << totals.peakBytes / 1024 << "KB" << std::endl;
+    previous = totals;
+}
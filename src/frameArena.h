@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Per-thread bump allocator for the short-lived buffers of a tick (walking entity lists, A*
+// neighbor lists, collision shapes in world space):
+//  - allocation moves a pointer forward in the current block, deallocation is free (only the
+//    most recent allocation is given back, which is what a growing vector does)
+//  - blocks are kept when the arena is rewound, so once the largest tick has been seen the arena
+//    never calls malloc again; a block is only allocated when a tick needs more than ever before
+//  - FrameArenaScope marks the arena and rewinds it when it closes. Every tick graph stage runs
+//    inside one, so each tick starts with an empty arena on every thread
+//  - containers are the std::pmr ones (FrameVector) built on frameArena()
+// Fundamental alignments only (up to alignof(std::max_align_t)).
+// Rule: a container allocated from the arena must be destroyed before the scope it was created
+// in closes - declare the FrameArenaScope first, in the same block, and never keep the container
+// in a member or a static. A container from an outer scope must not grow while a nested scope
+// is open (a callee's scope would hand its new buffer back).
+
+const size_t FRAME_ARENA_BLOCK_SIZE = 256 * 1024; // Bytes per block (larger requests get their own block)
+
+class FrameArena : public std::pmr::memory_resource {
+public:
+    struct Marker {
+        size_t block;
+        size_t offset;
+    };
+
+    FrameArena() = default;
+    ~FrameArena() override;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    Marker mark() const { return Marker{currentBlock, currentOffset}; }
+    // Give back everything allocated since the marker (the blocks stay)
+    void rewind(const Marker& marker);
+    // Free every block (the owning thread is exiting)
+    void releaseBlocks();
+
+    // Lifetime statistics, readable from any thread (report side)
+    uint64_t getAllocationCount() const { return allocationCount.load(std::memory_order_relaxed); }
+    uint64_t getBlockAllocationCount() const { return blockAllocationCount.load(std::memory_order_relaxed); }
+    size_t getReservedBytes() const { return reservedBytes.load(std::memory_order_relaxed); }
+    size_t getPeakBytes() const { return peakBytes.load(std::memory_order_relaxed); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    void notePeak();
+
+    std::vector<Block> blocks;
+    size_t currentBlock = 0;        // Block being filled
+    size_t currentOffset = 0;       // Bytes used in the current block
+    size_t bytesBeforeCurrent = 0;  // Sizes of the blocks before the current one (peak tracking)
+
+    // Owner thread writes, the report reads: relaxed stores only
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> blockAllocationCount{0};
+    std::atomic<size_t> reservedBytes{0};
+    std::atomic<size_t> peakBytes{0};
+};
+
+// The calling thread's arena (created on first use, lives until the thread exits)
+FrameArena& frameArena();
+
+// Marks the calling thread's arena and rewinds it on destruction
+class FrameArenaScope {
+public:
+    FrameArenaScope() : arena(frameArena()), marker(arena.mark()) {}
+    ~FrameArenaScope() { arena.rewind(marker); }
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+private:
+    FrameArena& arena;
+    FrameArena::Marker marker;
+};
+
+template <typename T>
+using FrameVector = std::pmr::vector<T>;
+
+// Arena totals over every thread: lifetime allocation counts, blocks (= mallocs) and bytes
+struct FrameArenaTotals {
+    uint64_t allocations = 0;
+    uint64_t blockAllocations = 0;
+    size_t reservedBytes = 0;
+    size_t peakBytes = 0; // Largest per-thread peak
+    int threads = 0;
+};
+FrameArenaTotals collectFrameArenaTotals();
+
+// One line per report window: arena allocations and blocks allocated since the previous call
+void printFrameArenaReport();
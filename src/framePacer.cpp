@@ -0,0 +1,201 @@
+#include "framePacer.h"
+#include "globals.h"
+#include "metrics.h"
+#include "performanceProfiler.h"
+#include "GLFW/glfw3.h"
+#include <algorithm>
+#include <iostream>
+
+FramePacer g_framePacer;
+
+namespace {
+
+const double REFRESH_RATE_CHECK_SECONDS = 2.0; // The window can be dragged to another monitor
+const int VSYNC_CHECK_FRAMES = 120;
+const double VSYNC_SHORT_PRESENT = 0.5;       // Fraction of the refresh period
+
+const char* modeName(FramePacingMode mode) {
+    switch (mode) {
+        case FramePacingMode::VSYNC: return "vsync";
+        case FramePacingMode::CAPPED: return "capped";
+        case FramePacingMode::UNCAPPED: return "uncapped";
+    }
+    return "unknown";
+}
+
+// Monitor showing the largest part of the window (fullscreen: its own monitor)
+GLFWmonitor* findWindowMonitor(GLFWwindow* window) {
+    GLFWmonitor* fullscreenMonitor = glfwGetWindowMonitor(window);
+    if (fullscreenMonitor) {
+        return fullscreenMonitor;
+    }
+    int windowX, windowY, windowW, windowH;
+    glfwGetWindowPos(window, &windowX, &windowY);
+    glfwGetWindowSize(window, &windowW, &windowH);
+
+    int monitorCount = 0;
+    GLFWmonitor** monitors = glfwGetMonitors(&monitorCount);
+    GLFWmonitor* best = nullptr;
+    long long bestArea = 0;
+    for (int i = 0; i < monitorCount; ++i) {
+        const GLFWvidmode* videoMode = glfwGetVideoMode(monitors[i]);
+        if (!videoMode) {
+            continue;
+        }
+        int monitorX, monitorY;
+        glfwGetMonitorPos(monitors[i], &monitorX, &monitorY);
+        long long overlapW = std::min(windowX + windowW, monitorX + videoMode->width) - std::max(windowX, monitorX);
+        long long overlapH = std::min(windowY + windowH, monitorY + videoMode->height) - std::max(windowY, monitorY);
+        if (overlapW > 0 && overlapH > 0 && overlapW * overlapH > bestArea) {
+            bestArea = overlapW * overlapH;
+            best = monitors[i];
+        }
+    }
+    return best ? best : glfwGetPrimaryMonitor();
+}
+
+} // namespace
+
+void FramePacer::init(GLFWwindow* pacedWindow) {
+    window = pacedWindow;
+    frameSeconds = &MetricsRegistry::getInstance().histogram("sorbetcoco_frame_seconds",
+        "Time between two presented frames", frameTimeBuckets());
+    targetFrameRate = &MetricsRegistry::getInstance().gauge("sorbetcoco_frame_target_hz",
+        "Frame rate the main loop paces to (0 = uncapped)");
+    updateRefreshRate();
+    setMode(FRAME_PACING_MODE);
+    lastPresentNs = PerformanceProfiler::nowNanoseconds();
+}
+
+void FramePacer::setMode(FramePacingMode newMode) {
+    mode = newMode;
+    FRAME_PACING_MODE = newMode;
+    vsyncHonored = true;
+    vsyncCheckFrames = 0;
+    vsyncShortPresents = 0;
+    frameDeadline = glfwGetTime();
+    applySwapInterval();
+
+    double period = getFramePeriod(false);
+    std::cout << "Frame pacing: " << modeName(mode);
+    if (mode != FramePacingMode::UNCAPPED) {
+        std::cout << " at " << (mode == FramePacingMode::VSYNC ? refreshRate : 1.0 / period) << " Hz";
+    }
+    std::cout << " (monitor refresh " << refreshRate << " Hz)" << std::endl;
+}
+
+void FramePacer::cycleMode() {
+    setMode(mode == FramePacingMode::VSYNC ? FramePacingMode::CAPPED
+          : mode == FramePacingMode::CAPPED ? FramePacingMode::UNCAPPED : FramePacingMode::VSYNC);
+}
+
+void FramePacer::applySwapInterval() {
+    if (window && glfwGetCurrentContext() == window) {
+        glfwSwapInterval(mode == FramePacingMode::VSYNC ? 1 : 0);
+    }
+    if (targetFrameRate) {
+        double period = getFramePeriod(false);
+        targetFrameRate->set(mode == FramePacingMode::VSYNC ? refreshRate : period > 0.0 ? 1.0 / period : 0.0);
+    }
+}
+
+void FramePacer::updateRefreshRate() {
+    lastRefreshCheck = glfwGetTime();
+    double detected = 1.0 / FRAMERATE_IN_SECONDS;
+    if (window) {
+        GLFWmonitor* monitor = findWindowMonitor(window);
+        const GLFWvidmode* videoMode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+        if (videoMode && videoMode->refreshRate > 0) {
+            detected = videoMode->refreshRate;
+        }
+    }
+    if (detected != refreshRate) {
+        refreshRate = detected;
+        std::cout << "Frame pacing: monitor refresh rate " << refreshRate << " Hz" << std::endl;
+        // A new monitor gets a new chance at vsync
+        vsyncHonored = true;
+        vsyncCheckFrames = 0;
+        vsyncShortPresents = 0;
+        applySwapInterval();
+    }
+}
+
+double FramePacer::getFramePeriod(bool idleFrame) const {
+    if (mode == FramePacingMode::UNCAPPED) {
+        return 0.0;
+    }
+    if (idleFrame) {
+        return IDLE_FRAMERATE_IN_SECONDS;
+    }
+    if (mode == FramePacingMode::CAPPED) {
+        return FRAME_RATE_CAP > 0.0 ? 1.0 / FRAME_RATE_CAP : 1.0 / refreshRate;
+    }
+    // VSYNC: the swap waits for the refresh, unless the driver ignores the swap interval
+    return vsyncHonored ? 0.0 : 1.0 / refreshRate;
+}
+
+void FramePacer::beginFrame() {
+    frameStartNs = PerformanceProfiler::nowNanoseconds();
+}
+
+void FramePacer::framePresented() {
+    static const ProfileZoneId renderZone = PerformanceProfiler::getInstance().registerZone("Frame_Render");
+    static const ProfileZoneId presentZone = PerformanceProfiler::getInstance().registerZone("Frame_PresentInterval");
+
+    uint64_t now = PerformanceProfiler::nowNanoseconds();
+    PerformanceProfiler& profiler = PerformanceProfiler::getInstance();
+    if (frameStartNs != 0) {
+        profiler.addSample(renderZone, frameStartNs, now - frameStartNs);
+    }
+    if (lastPresentNs != 0) {
+        profiler.addSample(presentZone, lastPresentNs, now - lastPresentNs);
+        lastPresentInterval = (now - lastPresentNs) * 1e-9;
+        if (frameSeconds) {
+            frameSeconds->observe(lastPresentInterval);
+        }
+    }
+    lastPresentNs = now;
+
+    // Only frames the loop did not wait for tell whether the swap waited for the refresh
+    if (mode == FramePacingMode::VSYNC && vsyncHonored && !waitedForFrame) {
+        vsyncCheckFrames++;
+        if (lastPresentInterval < VSYNC_SHORT_PRESENT / refreshRate) {
+            vsyncShortPresents++;
+        }
+        if (vsyncCheckFrames >= VSYNC_CHECK_FRAMES) {
+            if (vsyncShortPresents * 2 > vsyncCheckFrames) {
+                vsyncHonored = false;
+                std::cout << "Frame pacing: the driver does not wait for vsync, pacing to " << refreshRate << " Hz instead" << std::endl;
+            }
+            vsyncCheckFrames = 0;
+            vsyncShortPresents = 0;
+        }
+    }
+
+    if (glfwGetTime() - lastRefreshCheck > REFRESH_RATE_CHECK_SECONDS) {
+        updateRefreshRate();
+    }
+}
+
+void FramePacer::waitForNextFrame(bool idleFrame) {
+    double period = getFramePeriod(idleFrame);
+    double now = glfwGetTime();
+    if (period <= 0.0) {
+        // Nothing to wait for: the swap paced the frame (vsync) or nothing should (uncapped)
+        frameDeadline = now;
+        waitedForFrame = false;
+        return;
+    }
+    // Frames stay on a fixed grid instead of drifting by the poll overhead
+    frameDeadline += period;
+    waitedForFrame = now < frameDeadline;
+    if (!waitedForFrame) {
+        // Frame overran: start a new grid from now rather than rushing to catch up
+        frameDeadline = now;
+    }
+    /* Sleep in the event wait until the frame is due (input still wakes it up and gets processed) */
+    while (now < frameDeadline) {
+        glfwWaitEventsTimeout(frameDeadline - now);
+        now = glfwGetTime();
+    }
+}
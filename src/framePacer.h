@@ -0,0 +1,70 @@
+#pragma once
+
+#include "enumDefinitions.h"
+#include <cstdint>
+
+struct GLFWwindow;
+class MetricHistogram;
+class MetricGauge;
+
+// Frame pacing of the main loop (FRAME_PACING_MODE, R cycles the modes):
+//  - VSYNC: swap interval 1, glfwSwapBuffers waits for the vertical blank, so frames follow the
+//    refresh rate of the monitor the window is on (no tearing, no extra wait). Drivers that ignore
+//    the swap interval (some Linux compositors, forced off in the control panel) are detected from
+//    the present intervals, and the loop then waits on a grid of one refresh period instead.
+//  - CAPPED: swap interval 0, frames start on a fixed grid of 1 / FRAME_RATE_CAP (the monitor
+//    refresh rate when FRAME_RATE_CAP is 0)
+//  - UNCAPPED: swap interval 0 and no wait, for benchmarks (rendering throughput)
+// Menus and the pause screen stay at IDLE_FRAMERATE_IN_SECONDS except in UNCAPPED mode.
+// Every present-to-present interval goes to the "Frame_PresentInterval" profiler zone and the
+// sorbetcoco_frame_seconds metric; the CPU time of the frame (start to swap) to "Frame_Render".
+class FramePacer {
+public:
+    // Main thread, with the window's context current
+    void init(GLFWwindow* window);
+
+    // Apply a pacing mode (swap interval, grid restarted)
+    void setMode(FramePacingMode mode);
+    void cycleMode();
+    FramePacingMode getMode() const { return mode; }
+
+    // Read the refresh rate of the monitor the window is on again (window moved or resized)
+    void updateRefreshRate();
+    double getRefreshRate() const { return refreshRate; }
+
+    // Start of a frame's work
+    void beginFrame();
+    // Right after glfwSwapBuffers: records the present interval and the frame's CPU time
+    void framePresented();
+    // After the event poll: sleeps in the event wait until the next frame is due (input wakes it up)
+    void waitForNextFrame(bool idleFrame);
+
+    // Time between the last two presents, in seconds
+    double getLastPresentInterval() const { return lastPresentInterval; }
+
+private:
+    // Seconds between two frame starts the loop waits for (0 = no wait)
+    double getFramePeriod(bool idleFrame) const;
+    void applySwapInterval();
+
+    GLFWwindow* window = nullptr;
+    FramePacingMode mode = FramePacingMode::VSYNC;
+    double refreshRate = 60.0;
+    double lastRefreshCheck = 0.0;
+
+    double frameDeadline = 0.0;     // Absolute time the next frame is due
+    bool waitedForFrame = false;    // The loop slept before the current frame
+    uint64_t frameStartNs = 0;
+    uint64_t lastPresentNs = 0;
+    double lastPresentInterval = 0.0;
+
+    // Vsync check: presents much shorter than a refresh period mean the swap did not wait
+    bool vsyncHonored = true;
+    int vsyncCheckFrames = 0;
+    int vsyncShortPresents = 0;
+
+    MetricHistogram* frameSeconds = nullptr;
+    MetricGauge* targetFrameRate = nullptr;
+};
+
+extern FramePacer g_framePacer;
@@ -0,0 +1,163 @@
+#include "frameScheduler.h"
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <time.h>
+#endif
+
+void FrameScheduler::addFixedStepLoop(const std::string& name, double rateHz, StepFunction step) {
+    if (running.load()) {
+        std::cerr << "FrameScheduler: cannot add loop '" << name << "' while running" << std::endl;
+        return;
+    }
+    std::unique_ptr<FixedStepLoop> loop(new FixedStepLoop());
+    loop->name = name;
+    loop->rateHz = rateHz;
+    loop->period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    loop->step = std::move(step);
+    // Same series for every gameplay session: the loop name is the label
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    std::string label = metricLabel("loop", name);
+    loop->stepsMetric = &metrics.counter("sorbetcoco_scheduler_steps_total", "Fixed steps run", label);
+    loop->droppedStepsMetric = &metrics.counter("sorbetcoco_scheduler_dropped_steps_total",
+                                                "Fixed steps dropped after falling too far behind", label);
+    loop->latenessMetric = &metrics.histogram("sorbetcoco_scheduler_wake_lateness_seconds",
+                                              "Wake-up time minus step deadline", {0.0001, 0.0005, 0.001, 0.002, 0.004, 0.008, 0.016}, label);
+    loops.push_back(std::move(loop));
+}
+
+void FrameScheduler::start() {
+    if (running.load()) return;
+    running.store(true);
+    epoch = Clock::now();
+    for (auto& loop : loops) {
+        FixedStepLoop* loopPtr = loop.get();
+        loop->thread = std::thread([this, loopPtr] { runLoop(*loopPtr); });
+    }
+}
+
+void FrameScheduler::stop() {
+    if (!running.load()) return;
+    {
+        std::lock_guard<std::mutex> lock(pauseMutex);
+        running.store(false);
+    }
+    pauseCondition.notify_all();
+    // A sleeping loop notices within one period
+    for (auto& loop : loops) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+    }
+}
+
+void FrameScheduler::pause() {
+    std::lock_guard<std::mutex> lock(pauseMutex);
+    paused.store(true);
+}
+
+void FrameScheduler::resume() {
+    {
+        std::lock_guard<std::mutex> lock(pauseMutex);
+        paused.store(false);
+    }
+    pauseCondition.notify_all();
+}
+
+void FrameScheduler::sleepUntil(Clock::time_point deadline) {
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC here: one absolute sleep, immune to drift and early wakeups
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    if (sinceEpoch <= 0) return;
+    timespec target;
+    target.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+    target.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {
+        // Interrupted by a signal: sleep for the rest
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+void FrameScheduler::runLoop(FixedStepLoop& loop) {
+    PerformanceProfiler::getInstance().setCurrentThreadName(loop.name);
+    std::cout << loop.name << " loop started at " << loop.rateHz << " Hz" << std::endl;
+
+    const double stepSeconds = 1.0 / loop.rateHz;
+    Clock::time_point deadline = epoch + loop.period;
+
+    while (running.load()) {
+        if (paused.load()) {
+            // Parked until resume() or stop() - no timed wakeups while paused
+            std::unique_lock<std::mutex> lock(pauseMutex);
+            pauseCondition.wait(lock, [this] { return !paused.load() || !running.load(); });
+            // Don't try to catch up on the paused time; stay on the shared epoch grid
+            Clock::time_point now = Clock::now();
+            auto periodsElapsed = (now - epoch) / loop.period + 1;
+            deadline = epoch + periodsElapsed * loop.period;
+            continue;
+        }
+
+        sleepUntil(deadline);
+        if (!running.load() || paused.load()) continue;
+
+        Clock::time_point now = Clock::now();
+        uint64_t lateNanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count());
+        loop.lateness.record(lateNanoseconds);
+        loop.latenessMetric->observe(lateNanoseconds * 1e-9);
+
+        // Run every step that is due (normally exactly one)
+        int stepsRun = 0;
+        while (deadline <= now && stepsRun < FRAME_SCHEDULER_MAX_CATCH_UP_STEPS && running.load()) {
+            loop.step(stepSeconds);
+            deadline += loop.period;
+            stepsRun++;
+            loop.steps.fetch_add(1, std::memory_order_relaxed);
+            loop.stepsMetric->increment();
+        }
+
+        // Still behind after catching up: drop the backlog rather than spiral
+        now = Clock::now();
+        if (deadline <= now) {
+            auto behind = (now - deadline) / loop.period + 1;
+            loop.droppedSteps.fetch_add(static_cast<uint64_t>(behind), std::memory_order_relaxed);
+            loop.droppedStepsMetric->increment(static_cast<double>(behind));
+            deadline += behind * loop.period;
+        }
+    }
+
+    std::cout << loop.name << " loop ended after " << loop.steps.load() << " steps" << std::endl;
+}
+
+std::vector<FrameLoopStats> FrameScheduler::collectStats() const {
+    std::vector<FrameLoopStats> stats;
+    for (const auto& loop : loops) {
+        FrameLoopStats loopStats;
+        loopStats.name = loop->name;
+        loopStats.rateHz = loop->rateHz;
+        loopStats.steps = loop->steps.load(std::memory_order_relaxed);
+        loopStats.droppedSteps = loop->droppedSteps.load(std::memory_order_relaxed);
+        loopStats.lateP50Ms = loop->lateness.valueAtPercentile(0.50) / 1000000.0;
+        loopStats.lateP99Ms = loop->lateness.valueAtPercentile(0.99) / 1000000.0;
+        loopStats.lateMaxMs = loop->lateness.maxNanoseconds.load(std::memory_order_relaxed) / 1000000.0;
+        stats.push_back(loopStats);
+    }
+    return stats;
+}
+
+void FrameScheduler::printJitterStats() const {
+    std::cout << "=== Frame Scheduler Jitter ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& loopStats : collectStats()) {
+        std::cout << loopStats.name << " (" << loopStats.rateHz << " Hz): steps=" << loopStats.steps
+                  << " dropped=" << loopStats.droppedSteps
+                  << " wake late p50=" << loopStats.lateP50Ms << "ms"
+                  << " p99=" << loopStats.lateP99Ms << "ms"
+                  << " max=" << loopStats.lateMaxMs << "ms" << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "performanceProfiler.h" // For ProfileHistogram
+#include "metrics.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed-step loops driven by absolute deadlines instead of sleep-polling:
+//  - every loop runs on its own thread (a slow logic tick never delays player movement) and sleeps
+//    until its next deadline with one timed wait (clock_nanosleep(TIMER_ABSTIME) on Linux), so an
+//    idle loop costs nothing between steps and the deadlines don't drift
+//  - all loops share one epoch: the 60 Hz logic steps line up with every other 120 Hz movement step
+//  - pause() parks every loop on a condition variable (no wakeups at all until resume())
+//  - a loop that falls behind runs up to MAX_CATCH_UP_STEPS steps back to back, then drops the rest
+//  - wake-up lateness (actual wake time - deadline) is recorded per loop for the jitter report,
+//    and steps, dropped steps and lateness are published as sorbetcoco_scheduler_* metrics
+
+const int FRAME_SCHEDULER_MAX_CATCH_UP_STEPS = 4;
+
+struct FrameLoopStats {
+    std::string name;
+    double rateHz = 0.0;
+    uint64_t steps = 0;
+    uint64_t droppedSteps = 0;   // Steps skipped after falling more than MAX_CATCH_UP_STEPS behind
+    double lateP50Ms = 0.0;      // Wake-up lateness percentiles
+    double lateP99Ms = 0.0;
+    double lateMaxMs = 0.0;
+};
+
+class FrameScheduler {
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(double deltaTime)> StepFunction;
+
+    FrameScheduler() {}
+    ~FrameScheduler() { stop(); }
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    // Register a loop calling step(1 / rateHz) rateHz times per second (before start())
+    void addFixedStepLoop(const std::string& name, double rateHz, StepFunction step);
+
+    void start();
+    // Stop and join every loop (a step in progress finishes first)
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+    void pause();
+    void resume();
+    bool isPaused() const { return paused.load(); }
+
+    std::vector<FrameLoopStats> collectStats() const;
+    void printJitterStats() const;
+
+    // Sleep until an absolute steady_clock time (no polling)
+    static void sleepUntil(Clock::time_point deadline);
+
+private:
+    struct FixedStepLoop {
+        std::string name;
+        double rateHz = 0.0;
+        Clock::duration period{};
+        StepFunction step;
+        std::thread thread;
+        ProfileHistogram lateness;               // Written by the loop thread only
+        std::atomic<uint64_t> steps{0};
+        std::atomic<uint64_t> droppedSteps{0};
+        MetricCounter* stepsMetric = nullptr;
+        MetricCounter* droppedStepsMetric = nullptr;
+        MetricHistogram* latenessMetric = nullptr;
+    };
+
+    void runLoop(FixedStepLoop& loop);
+
+    std::vector<std::unique_ptr<FixedStepLoop>> loops;
+    Clock::time_point epoch;
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> paused{false};
+    std::mutex pauseMutex;
+    std::condition_variable pauseCondition;
+};
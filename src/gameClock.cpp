@@ -0,0 +1,16 @@
+#include "gameClock.h"
+#define GLFW_INCLUDE_NONE
+#include "GLFW/glfw3.h"
+#include <atomic>
+
+// Read from the logic, player and pathfinding threads
+static std::atomic<GameClockSource> g_gameClockSource{nullptr};
+
+void setGameClockSource(GameClockSource source) {
+    g_gameClockSource.store(source, std::memory_order_release);
+}
+
+double getGameTime() {
+    GameClockSource source = g_gameClockSource.load(std::memory_order_acquire);
+    return source ? source() : glfwGetTime();
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Clock used by gameplay code (collision caches, pathfinding graph refresh, entity timers), in seconds.
+// Defaults to glfwGetTime(). Headless runs (bench_sim) install a simulated clock instead, so the
+// simulation needs no window and replays the same way every time.
+typedef double (*GameClockSource)();
+
+// Install a time source; nullptr goes back to glfwGetTime()
+void setGameClockSource(GameClockSource source);
+
+// Current gameplay time in seconds
+double getGameTime();
@@ -0,0 +1,323 @@
+#include "gameLog.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+const std::chrono::steady_clock::time_point g_logStartTime = std::chrono::steady_clock::now();
+
+double secondsSinceStart() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - g_logStartTime).count();
+}
+
+uint32_t currentLogThreadId() {
+    static std::atomic<uint32_t> nextThreadId{1};
+    thread_local uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+const char* levelName(GameLogLevel level) {
+    switch (level) {
+        case GameLogLevel::LOG_DEBUG: return "DEBUG";
+        case GameLogLevel::LOG_INFO: return "INFO";
+        case GameLogLevel::LOG_WARN: return "WARN";
+        case GameLogLevel::LOG_ERROR: return "ERROR";
+    }
+    return "INFO";
+}
+
+const char* baseName(const char* path) {
+    const char* slash = std::strrchr(path, '/');
+    const char* backslash = std::strrchr(path, '\\');
+    const char* last = slash > backslash ? slash : backslash;
+    return last != nullptr ? last + 1 : path;
+}
+
+struct LogRecord {
+    std::atomic<LogRecord*> next{nullptr};
+    GameLogLevel level = GameLogLevel::LOG_INFO;
+    const char* file = "";
+    int line = 0;
+    uint32_t threadId = 0;
+    uint32_t suppressedCount = 0;
+    double time = 0.0;
+    std::string message;
+};
+
+// Intrusive multi-producer single-consumer queue (D. Vyukov): push is one atomic exchange,
+// pop is consumer-only. pop() may briefly return nullptr while a push is half done.
+class LogQueue {
+public:
+    LogQueue() : head(&stub), tail(&stub) {}
+
+    void push(LogRecord* record) {
+        record->next.store(nullptr, std::memory_order_relaxed);
+        LogRecord* previous = head.exchange(record, std::memory_order_acq_rel);
+        previous->next.store(record, std::memory_order_release);
+    }
+
+    LogRecord* pop() {
+        LogRecord* first = tail;
+        LogRecord* next = first->next.load(std::memory_order_acquire);
+        if (first == &stub) {
+            if (next == nullptr) return nullptr;
+            tail = next;
+            first = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next != nullptr) {
+            tail = next;
+            return first;
+        }
+        if (first != head.load(std::memory_order_acquire)) {
+            return nullptr; // A producer is between its exchange and its link
+        }
+        push(&stub);
+        next = first->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            tail = next;
+            return first;
+        }
+        return nullptr;
+    }
+
+private:
+    LogRecord stub;
+    std::atomic<LogRecord*> head;
+    LogRecord* tail; // Consumer only
+};
+
+class GameLogger {
+public:
+    void submit(LogRecord* record) {
+        if (queuedCount.fetch_add(1, std::memory_order_relaxed) >= GAME_LOG_MAX_QUEUED) {
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            delete record;
+            return;
+        }
+        submittedCount.fetch_add(1, std::memory_order_relaxed);
+        queue.push(record);
+        // Warnings and errors show up right away, the rest within WRITER_PERIOD
+        if (record->level >= GameLogLevel::LOG_WARN) {
+            urgentRecord.store(true, std::memory_order_release);
+            wakeCondition.notify_one();
+        }
+    }
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        if (running.load() || stopped) return;
+        running.store(true, std::memory_order_release);
+        writerThread = std::thread(&GameLogger::writerLoop, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            if (!running.load()) return;
+            stopped = true;
+            {
+                std::lock_guard<std::mutex> wakeLock(wakeMutex);
+                stopRequested = true;
+            }
+            wakeCondition.notify_one();
+        }
+        if (writerThread.joinable()) {
+            writerThread.join();
+        }
+        running.store(false, std::memory_order_release);
+    }
+
+    void flush() {
+        if (!isRunning()) return;
+        uint64_t target = submittedCount.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        flushRequested = true;
+        wakeCondition.notify_one();
+        flushedCondition.wait(lock, [&] { return writtenCount.load() >= target || !running.load(); });
+    }
+
+    bool setFile(const std::string& path) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (jsonFile != nullptr) {
+            std::fclose(jsonFile);
+            jsonFile = nullptr;
+        }
+        if (path.empty()) return true;
+        jsonFile = std::fopen(path.c_str(), "a");
+        return jsonFile != nullptr;
+    }
+
+    // Caller holds outputMutex
+    void write(const LogRecord& record) {
+        FILE* console = record.level >= GameLogLevel::LOG_WARN ? stderr : stdout;
+        std::fwrite(record.message.data(), 1, record.message.size(), console);
+        if (record.suppressedCount > 0) {
+            std::fprintf(console, " (%u similar messages suppressed)", record.suppressedCount);
+        }
+        std::fputc('\n', console);
+
+        if (jsonFile != nullptr) {
+            std::fprintf(jsonFile, "{\"t\":%.6f,\"level\":\"%s\",\"thread\":%u,\"file\":\"%s\",\"line\":%d,\"suppressed\":%u,\"msg\":\"",
+                         record.time, levelName(record.level), record.threadId, baseName(record.file), record.line, record.suppressedCount);
+            for (char c : record.message) {
+                if (c == '"' || c == '\\') {
+                    std::fputc('\\', jsonFile);
+                    std::fputc(c, jsonFile);
+                } else if (c == '\n') {
+                    std::fputs("\\n", jsonFile);
+                } else if (static_cast<unsigned char>(c) >= 0x20) {
+                    std::fputc(c, jsonFile);
+                }
+            }
+            std::fputs("\"}\n", jsonFile);
+        }
+    }
+
+    void flushOutputs() {
+        std::fflush(stdout);
+        std::fflush(stderr);
+        if (jsonFile != nullptr) std::fflush(jsonFile);
+    }
+
+    std::mutex outputMutex;
+
+private:
+    static constexpr std::chrono::milliseconds WRITER_PERIOD{10};
+
+    // Write everything queued, one flush per batch instead of one per line
+    void drain() {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        bool wroteAny = false;
+        while (LogRecord* record = queue.pop()) {
+            write(*record);
+            delete record;
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            writtenCount.fetch_add(1, std::memory_order_release);
+            wroteAny = true;
+        }
+        uint32_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            std::fprintf(stderr, "WARNING: %u log messages dropped (logger queue full)\n", dropped);
+            wroteAny = true;
+        }
+        if (wroteAny) {
+            flushOutputs();
+        }
+    }
+
+    void writerLoop() {
+        while (true) {
+            drain();
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            flushRequested = false;
+            flushedCondition.notify_all(); // Wake flushGameLog() callers to recheck what was written
+            if (stopRequested) break;
+            wakeCondition.wait_for(lock, WRITER_PERIOD, [this] { return flushRequested || stopRequested || urgentRecord.exchange(false); });
+        }
+        drain();
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        flushedCondition.notify_all();
+    }
+
+    LogQueue queue;
+    std::atomic<uint32_t> queuedCount{0};
+    std::atomic<uint32_t> droppedCount{0};
+    std::atomic<uint64_t> submittedCount{0};
+    std::atomic<uint64_t> writtenCount{0};
+
+    std::atomic<bool> running{false};
+    bool stopped = false; // After shutdown the writer is not restarted
+    std::mutex controlMutex;
+    std::thread writerThread;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable flushedCondition;
+    bool stopRequested = false;
+    bool flushRequested = false;
+    std::atomic<bool> urgentRecord{false}; // A WARN/ERROR is waiting
+
+    FILE* jsonFile = nullptr;
+};
+
+constexpr std::chrono::milliseconds GameLogger::WRITER_PERIOD;
+
+// Never destroyed: other globals may still log from their destructors (written synchronously then)
+GameLogger& logger() {
+    static GameLogger* instance = [] {
+        GameLogger* created = new GameLogger();
+        created->start();
+        std::atexit(shutdownGameLog);
+        return created;
+    }();
+    return *instance;
+}
+
+} // namespace
+
+bool GameLogRateLimiter::allow(uint32_t& suppressedCount) {
+    int64_t second = static_cast<int64_t>(secondsSinceStart());
+    int64_t start = windowStart.load(std::memory_order_relaxed);
+    if (second != start && windowStart.compare_exchange_strong(start, second, std::memory_order_relaxed)) {
+        windowCount.store(0, std::memory_order_relaxed);
+    }
+    if (windowCount.fetch_add(1, std::memory_order_relaxed) < GAME_LOG_RATE_LIMIT) {
+        suppressedCount = suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void gameLogSubmit(GameLogLevel level, const char* file, int line, std::string&& message, uint32_t suppressedCount) {
+    GameLogger& log = logger();
+    if (!log.isRunning()) {
+        gameLogWriteNow(level, file, line, message);
+        return;
+    }
+    LogRecord* record = new LogRecord();
+    record->level = level;
+    record->file = file;
+    record->line = line;
+    record->threadId = currentLogThreadId();
+    record->suppressedCount = suppressedCount;
+    record->time = secondsSinceStart();
+    record->message = std::move(message);
+    log.submit(record);
+}
+
+void gameLogWriteNow(GameLogLevel level, const char* file, int line, const std::string& message) {
+    GameLogger& log = logger();
+    log.flush();
+    LogRecord record;
+    record.level = level;
+    record.file = file;
+    record.line = line;
+    record.threadId = currentLogThreadId();
+    record.time = secondsSinceStart();
+    record.message = message;
+    std::lock_guard<std::mutex> lock(log.outputMutex);
+    log.write(record);
+    log.flushOutputs();
+}
+
+bool setGameLogFile(const std::string& path) {
+    return logger().setFile(path);
+}
+
+void flushGameLog() {
+    logger().flush();
+}
+
+void shutdownGameLog() {
+    logger().stop();
+}
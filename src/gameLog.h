@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// Asynchronous game logger. GAME_LOG_INFO("Entity " << name << " arrived") formats the message
+// on the calling thread and pushes it on a lock-free queue; a background writer thread does the
+// console/file I/O, so logging never blocks the logic, player or pathfinding threads on a flush.
+//
+//  - Levels below GAME_LOG_COMPILE_LEVEL are compiled out (define it to e.g. GAME_LOG_LEVEL_INFO)
+//  - At run time DEBUG messages are only kept while DEBUG_LOGS is set; other levels always
+//  - Every call site allows GAME_LOG_RATE_LIMIT messages per second; the rest are counted and the
+//    count is reported with the next message from that site
+//  - Records carry time, level, thread and call site. Console output is plain text (WARN/ERROR on
+//    stderr); setGameLogFile() adds a JSON-lines file with the same records
+//
+// Use GAME_LOG_ERROR_SYNC for the last words before exit/abort (writes immediately, after the queue).
+
+#define GAME_LOG_LEVEL_DEBUG 0
+#define GAME_LOG_LEVEL_INFO 1
+#define GAME_LOG_LEVEL_WARN 2
+#define GAME_LOG_LEVEL_ERROR 3
+
+#ifndef GAME_LOG_COMPILE_LEVEL
+#define GAME_LOG_COMPILE_LEVEL GAME_LOG_LEVEL_DEBUG
+#endif
+
+const uint32_t GAME_LOG_RATE_LIMIT = 20;           // Messages per second per call site
+const uint32_t GAME_LOG_MAX_QUEUED = 65536;        // Beyond this the writer is hopelessly behind: drop
+
+enum class GameLogLevel : uint8_t {
+    LOG_DEBUG = GAME_LOG_LEVEL_DEBUG,
+    LOG_INFO = GAME_LOG_LEVEL_INFO,
+    LOG_WARN = GAME_LOG_LEVEL_WARN,
+    LOG_ERROR = GAME_LOG_LEVEL_ERROR
+};
+
+extern bool DEBUG_LOGS; // globals.h
+
+// Run-time level check (DEBUG follows DEBUG_LOGS), inline so disabled debug logs cost one load
+inline bool gameLogEnabled(GameLogLevel level) {
+    return level != GameLogLevel::LOG_DEBUG || DEBUG_LOGS;
+}
+
+// Queue a formatted message (use the macros)
+void gameLogSubmit(GameLogLevel level, const char* file, int line, std::string&& message, uint32_t suppressedCount);
+// Write a message right away from the calling thread, after whatever is already queued
+void gameLogWriteNow(GameLogLevel level, const char* file, int line, const std::string& message);
+
+// Also write every record to this file as JSON lines (empty path = console only). Returns false if
+// the file can't be opened.
+bool setGameLogFile(const std::string& path);
+// Block until everything queued so far is written
+void flushGameLog();
+// Drain the queue and stop the writer thread (later messages are written synchronously)
+void shutdownGameLog();
+
+// Per call site limiter: GAME_LOG_RATE_LIMIT messages per one-second window, lock-free
+class GameLogRateLimiter {
+public:
+    // True if this message may be logged; suppressedCount = messages dropped since the last one that was
+    bool allow(uint32_t& suppressedCount);
+
+private:
+    std::atomic<int64_t> windowStart{0};  // Seconds since the logger started
+    std::atomic<uint32_t> windowCount{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+#define GAME_LOG(level, ...) \
+    do { \
+        if (gameLogEnabled(level)) { \
+            static GameLogRateLimiter gameLogLimiter_; \
+            uint32_t gameLogSuppressed_ = 0; \
+            if (gameLogLimiter_.allow(gameLogSuppressed_)) { \
+                std::ostringstream gameLogStream_; \
+                gameLogStream_ << __VA_ARGS__; \
+                gameLogSubmit(level, __FILE__, __LINE__, gameLogStream_.str(), gameLogSuppressed_); \
+            } \
+        } \
+    } while (0)
+
+#define GAME_LOG_SYNC(level, ...) \
+    do { \
+        std::ostringstream gameLogStream_; \
+        gameLogStream_ << __VA_ARGS__; \
+        gameLogWriteNow(level, __FILE__, __LINE__, gameLogStream_.str()); \
+    } while (0)
+
+#if GAME_LOG_COMPILE_LEVEL <= GAME_LOG_LEVEL_DEBUG
+#define GAME_LOG_DEBUG(...) GAME_LOG(GameLogLevel::LOG_DEBUG, __VA_ARGS__)
+#define GAME_LOG_DEBUG_ENABLED() gameLogEnabled(GameLogLevel::LOG_DEBUG)
+#else
+#define GAME_LOG_DEBUG(...) do {} while (0)
+#define GAME_LOG_DEBUG_ENABLED() false
+#endif
+
+#if GAME_LOG_COMPILE_LEVEL <= GAME_LOG_LEVEL_INFO
+#define GAME_LOG_INFO(...) GAME_LOG(GameLogLevel::LOG_INFO, __VA_ARGS__)
+#else
+#define GAME_LOG_INFO(...) do {} while (0)
+#endif
+
+#if GAME_LOG_COMPILE_LEVEL <= GAME_LOG_LEVEL_WARN
+#define GAME_LOG_WARN(...) GAME_LOG(GameLogLevel::LOG_WARN, __VA_ARGS__)
+#else
+#define GAME_LOG_WARN(...) do {} while (0)
+#endif
+
+#define GAME_LOG_ERROR(...) GAME_LOG(GameLogLevel::LOG_ERROR, __VA_ARGS__)
+#define GAME_LOG_ERROR_SYNC(...) GAME_LOG_SYNC(GameLogLevel::LOG_ERROR, __VA_ARGS__)
@@ -3,10 +3,10 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <cstddef> // offsetof
 #include "glbasimac/glbi_texture.hpp"
-// Include stb_image without defining STB_IMAGE_IMPLEMENTATION
-// This avoids duplicate symbols since it's already defined in map.cpp
-#include "../third_party/glbasimac/tools/stb_image.h"
+#include "globals.h" // windowWidth / windowHeight
+#include "textureLoader.h" // Background decode of the UI textures
 
 // Define UI elements to load - using C++11 compatible initialization syntax
 static std::vector<UIElementInfo> createUIElementsToLoad() {
@@ -98,6 +98,10 @@ GameMenus::~GameMenus() {
         glDeleteTextures(1, &element.textureID);
     }
     m_activeElements.clear();
+    if (m_vertexBuffer != 0) {
+        glDeleteBuffers(1, &m_vertexBuffer);
+        m_vertexBuffer = 0;
+    }
 }
 
 std::vector<UIElementInfo> GameMenus::createUIElementsToLoad() {
@@ -114,6 +118,14 @@ bool GameMenus::initialize(glbasimac::GLBI_Engine& engine) {
         std::cout << "Registered UI element: " << static_cast<int>(uiElementInfo.name) << std::endl;
     }
     
+    // Decode every UI texture in the background now; the start menu below waits for its own
+    // image only, the others are ready by the time the game places them
+    std::vector<std::string> texturePaths;
+    for (const auto& uiElementInfo : uiElementsToLoad) {
+        texturePaths.push_back(uiElementInfo.texturePath);
+    }
+    TextureLoader::getInstance().prefetch(texturePaths);
+    
     // Example: Place START_MENU at CENTER position (as requested)
     if (!placeUIElement(UIElementName::START_MENU, UIElementPosition::CENTER)) {
         std::cerr << "Failed to place START_MENU UI element!" << std::endl;
@@ -180,6 +192,7 @@ bool GameMenus::placeUIElement(UIElementName elementName, UIElementPosition posi
     }
     
     m_activeElements.push_back(instance);
+    markBatchDirty();
     
     std::cout << "Placed UI element: " << static_cast<int>(elementName) 
               << " at position: " << static_cast<int>(position);
@@ -204,6 +217,13 @@ void GameMenus::removeUIElement(UIElementName elementName) {
         // Clean up texture
         glDeleteTextures(1, &it->textureID);
         m_activeElements.erase(it);
+        markBatchDirty();
+        
+        // Menus come back (pause, game over): decode the image again in the background
+        auto registeredIt = m_registeredElements.find(elementName);
+        if (registeredIt != m_registeredElements.end()) {
+            TextureLoader::getInstance().prefetch({registeredIt->second.texturePath});
+        }
         std::cout << "Removed UI element: " << static_cast<int>(elementName) << std::endl;
     }
 }
@@ -216,6 +236,7 @@ void GameMenus::showUIElement(UIElementName elementName, bool visible) {
     
     if (it != m_activeElements.end()) {
         it->visible = visible;
+        markBatchDirty();
         std::cout << "UI element " << static_cast<int>(elementName) 
                   << " visibility set to: " << visible << std::endl;
     }
@@ -239,8 +260,13 @@ void GameMenus::render(double deltaTime) {
         return;
     }
     
-    // Update screen dimensions
-    glfwGetWindowSize(glfwGetCurrentContext(), &m_screenWidth, &m_screenHeight);
+    // Window resized (onWindowResize keeps windowWidth/windowHeight current): the corner
+    // positions move, rebuild the quads
+    if (windowWidth != m_screenWidth || windowHeight != m_screenHeight) {
+        m_screenWidth = windowWidth;
+        m_screenHeight = windowHeight;
+        markBatchDirty();
+    }
     
     // Update animations for sprite sheet elements
     for (auto& element : m_activeElements) { // Changed to non-const to update animation state
@@ -258,13 +284,38 @@ void GameMenus::render(double deltaTime) {
             if (element.currentFrameTime >= frameTime) {
                 // Advance to next frame
                 int advanceFrames = static_cast<int>(element.currentFrameTime / frameTime);
+                int previousFrame = element.spriteSheetFrame;
                 element.spriteSheetFrame = (element.spriteSheetFrame + advanceFrames) % element.numFramesInPhase;
                 element.currentFrameTime = fmod(element.currentFrameTime, frameTime); // Keep remainder
+                if (element.spriteSheetFrame != previousFrame) {
+                    markBatchDirty();
+                }
             }
         }
     }
-      // Save current OpenGL state
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    
+    if (m_batchDirty.exchange(false, std::memory_order_acq_rel)) {
+        rebuildBatch();
+    }
+    if (m_batchRuns.empty()) {
+        return;
+    }
+    
+    // Explicit state instead of glPushAttrib(GL_ALL_ATTRIB_BITS): only what the UI pass changes
+    // is saved and put back (depth test, blending, texture environment, matrix mode, bound program)
+    GLboolean depthTestWasEnabled = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
+    GLint previousBlend[4] = {GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
+    GLint previousTextureEnvMode = GL_MODULATE;
+    GLint previousMatrixMode = GL_MODELVIEW;
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_BLEND_SRC_RGB, &previousBlend[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &previousBlend[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &previousBlend[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &previousBlend[3]);
+    glGetTexEnviv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, &previousTextureEnvMode);
+    glGetIntegerv(GL_MATRIX_MODE, &previousMatrixMode);
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
     
     // Set up OpenGL state for pixel-perfect UI rendering
     glUseProgram(0); 
@@ -283,9 +334,6 @@ void GameMenus::render(double deltaTime) {
     // Set texture environment mode to replace (important!)
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
     
-    // Disable texture filtering to ensure pixel-perfect rendering
-    glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_FASTEST);
-    
     // Set up matrices for 2D rendering
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
@@ -296,12 +344,20 @@ void GameMenus::render(double deltaTime) {
     glPushMatrix();
     glLoadIdentity();
     
-    // Render all visible UI elements
-    for (const auto& element : m_activeElements) {
-        if (element.visible) {
-            renderUIElement(element);
-        }
-    }
+    // Cached quads: one glDrawArrays per texture run, same GL_QUADS as the old immediate-mode path
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(UIVertex), reinterpret_cast<const void*>(offsetof(UIVertex, x)));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(UIVertex), reinterpret_cast<const void*>(offsetof(UIVertex, u)));
+    for (const UIBatchRun& run : m_batchRuns) {
+        glBindTexture(GL_TEXTURE_2D, run.textureID);
+        glDrawArrays(GL_QUADS, run.firstVertex, run.vertexCount);
+    }
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
     
     // Restore matrices
     glMatrixMode(GL_MODELVIEW);
@@ -309,13 +365,43 @@ void GameMenus::render(double deltaTime) {
     
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
+    glMatrixMode(static_cast<GLenum>(previousMatrixMode));
     
     // Unbind texture
     glBindTexture(GL_TEXTURE_2D, 0);
     glDisable(GL_TEXTURE_2D);
     
-    // Restore previous OpenGL state
-    glPopAttrib();
+    // Restore the state saved above
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, previousTextureEnvMode);
+    glBlendFuncSeparate(static_cast<GLenum>(previousBlend[0]), static_cast<GLenum>(previousBlend[1]),
+                        static_cast<GLenum>(previousBlend[2]), static_cast<GLenum>(previousBlend[3]));
+    if (!blendWasEnabled) glDisable(GL_BLEND);
+    if (depthTestWasEnabled) glEnable(GL_DEPTH_TEST);
+    glUseProgram(static_cast<GLuint>(previousProgram));
+}
+
+void GameMenus::rebuildBatch() {
+    m_batchVertices.clear();
+    m_batchRuns.clear();
+    for (const auto& element : m_activeElements) {
+        if (!element.visible) {
+            continue;
+        }
+        if (m_batchRuns.empty() || m_batchRuns.back().textureID != element.textureID) {
+            m_batchRuns.push_back({element.textureID, static_cast<GLint>(m_batchVertices.size()), 0});
+        }
+        appendUIElementQuad(element, m_batchVertices);
+        m_batchRuns.back().vertexCount += 4;
+    }
+    
+    if (m_vertexBuffer == 0) {
+        glGenBuffers(1, &m_vertexBuffer);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_batchVertices.size() * sizeof(UIVertex)),
+                 m_batchVertices.empty() ? nullptr : m_batchVertices.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_batchRebuildCount++;
 }
 
 void GameMenus::clearAllUIElements() {
@@ -324,6 +410,7 @@ void GameMenus::clearAllUIElements() {
         glDeleteTextures(1, &element.textureID);
     }
     m_activeElements.clear();
+    markBatchDirty();
     std::cout << "Cleared all UI elements" << std::endl;
 }
 
@@ -332,49 +419,18 @@ bool GameMenus::loadUIElementTexture(const UIElementInfo& elementInfo, GLuint& t
     width = 0;
     height = 0;
     
-    // Generate texture
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    // Set texture parameters for pixel art - use GL_NEAREST for crisp pixel rendering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    
-    // Make sure stb_image uses the correct orientation
-    stbi_set_flip_vertically_on_load(true);
-    
-    // Load image using stb_image
-    int nrChannels;
-    unsigned char* data = stbi_load(elementInfo.texturePath.c_str(), &width, &height, &nrChannels, 0);
-    
-    if (data) {
-        GLenum format;
-        if (nrChannels == 1)
-            format = GL_RED;
-        else if (nrChannels == 3)
-            format = GL_RGB;
-        else if (nrChannels == 4)
-            format = GL_RGBA;
-        else {
-            std::cerr << "Unsupported number of channels: " << nrChannels << std::endl;
-            stbi_image_free(data);
-            return false;
-        }
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        
-        std::cout << "UI texture loaded successfully: " << elementInfo.texturePath << std::endl;
-        std::cout << "Dimensions: " << width << "x" << height << ", Channels: " << nrChannels << std::endl;
-        
-        stbi_image_free(data);
-        return true;
-    } else {
+    // Decoded on a loader worker (usually prefetched), uploaded here through a pixel buffer
+    TextureLoadResult loaded = TextureLoader::getInstance().loadTexture(elementInfo.texturePath);
+    if (loaded.textureID == 0) {
         std::cerr << "Failed to load UI texture: " << elementInfo.texturePath << std::endl;
-        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
+        std::cerr << "Reason: " << loaded.error << std::endl;
         return false;
     }
+    
+    textureID = loaded.textureID;
+    width = loaded.width;
+    height = loaded.height; // TextureLoader already logged the load and its timings
+    return true;
 }
 
 void GameMenus::calculateElementPosition(UIElementPosition position, int elementWidth, int elementHeight, 
@@ -415,7 +471,7 @@ void GameMenus::calculateElementPosition(UIElementPosition position, int element
     }
 }
 
-void GameMenus::renderUIElement(const UIElementInstance& element) const {
+void GameMenus::appendUIElementQuad(const UIElementInstance& element, std::vector<UIVertex>& vertices) const {
     // Calculate position and size
     float x, y, width, height;
     
@@ -432,13 +488,6 @@ void GameMenus::renderUIElement(const UIElementInstance& element) const {
                            element.scale, element.marginTop, element.marginBottom,
                            element.marginLeft, element.marginRight, x, y, width, height);
     
-    // Bind the texture
-    glBindTexture(GL_TEXTURE_2D, element.textureID);
-    
-    // Ensure nearest-neighbor filtering is used (for crisp pixel art)
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    
     // Calculate UV coordinates based on whether this is a spritesheet
     float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
     
@@ -460,24 +509,12 @@ void GameMenus::renderUIElement(const UIElementInstance& element) const {
         v1 = v0 + frameHeightRatio;
     }
     
-    // Draw the UI element as a quad
-    glBegin(GL_QUADS);
-    // Bottom-left
-    glTexCoord2f(u0, v0);
-    glVertex2f(x, y);
-    
-    // Bottom-right
-    glTexCoord2f(u1, v0);
-    glVertex2f(x + width, y);
-    
-    // Top-right
-    glTexCoord2f(u1, v1);
-    glVertex2f(x + width, y + height);
-    
-    // Top-left
-    glTexCoord2f(u0, v1);
-    glVertex2f(x, y + height);
-    glEnd();
+    // The UI element as a quad: bottom-left, bottom-right, top-right, top-left
+    // (textures keep the GL_NEAREST filtering set when they are loaded)
+    vertices.push_back({x, y, u0, v0});
+    vertices.push_back({x + width, y, u1, v0});
+    vertices.push_back({x + width, y + height, u1, v1});
+    vertices.push_back({x, y + height, u0, v1});
 }
 
 bool GameMenus::changeUIElementSpriteSheetPhase(UIElementName elementName, int newPhase) {
@@ -503,6 +540,7 @@ bool GameMenus::changeUIElementSpriteSheetPhase(UIElementName elementName, int n
         int numPhases = it->totalHeight / it->spriteHeight;
         if (newPhase >= 0 && newPhase < numPhases) {
             it->spriteSheetPhase = newPhase;
+            markBatchDirty();
             std::cout << "Changed UI element sprite phase: " << static_cast<int>(elementName) 
                       << " to " << newPhase << std::endl;
             return true;
@@ -538,6 +576,7 @@ bool GameMenus::changeUIElementSpriteSheetFrame(UIElementName elementName, int n
     // Ensure frame is within valid range
     if (it->numFramesInPhase > 0) {
         it->spriteSheetFrame = newFrame % it->numFramesInPhase;
+        markBatchDirty();
         std::cout << "Changed UI element sprite frame: " << static_cast<int>(elementName) 
                   << " to " << it->spriteSheetFrame << std::endl;
         return true;
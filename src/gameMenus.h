@@ -7,6 +7,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <atomic>
 
 // UI Element names enum
 enum class UIElementName {
@@ -101,6 +102,19 @@ struct UIElementInstance {
           marginTop(0.0f), marginBottom(0.0f), marginLeft(0.0f), marginRight(0.0f) {}
 };
 
+// One corner of a cached UI quad (screen pixels, texture coordinates)
+struct UIVertex {
+    float x, y;
+    float u, v;
+};
+
+// Consecutive quads of the UI batch drawn with the same texture (one draw call each)
+struct UIBatchRun {
+    GLuint textureID;
+    GLint firstVertex;
+    GLsizei vertexCount;
+};
+
 class GameMenus {
 public:
     GameMenus();
@@ -137,6 +151,9 @@ public:
     
     // Clear all UI elements
     void clearAllUIElements();
+
+    // Times the cached UI quads were rebuilt (debug / profiling)
+    size_t getBatchRebuildCount() const { return m_batchRebuildCount; }
     
 private:
     // Load a texture for a UI element
@@ -147,16 +164,30 @@ private:
                                 float marginLeft, float marginRight,
                                 float& x, float& y, float& width, float& height) const;
     
-    // Render a single UI element
-    void renderUIElement(const UIElementInstance& element) const;
+    // Append the quad of a UI element (4 vertices, GL_QUADS order) to the batch
+    void appendUIElementQuad(const UIElementInstance& element, std::vector<UIVertex>& vertices) const;
+
+    // Rebuild the cached quads and upload them (render thread, only when the batch is dirty)
+    void rebuildBatch();
+    // Elements added/removed/shown/hidden, a sprite frame or phase changed: rebuild before the next draw.
+    // Called from the input and logic threads too, hence the atomic flag.
+    void markBatchDirty() { m_batchDirty.store(true, std::memory_order_release); }
     
     glbasimac::GLBI_Engine* m_enginePtr;
     std::map<UIElementName, UIElementInfo> m_registeredElements;
     std::vector<UIElementInstance> m_activeElements;
     
-    // Screen dimensions (updated during render)
-    mutable int m_screenWidth;
-    mutable int m_screenHeight;
+    // Screen dimensions the batch was built for (windowWidth/windowHeight, set by the resize callback)
+    int m_screenWidth;
+    int m_screenHeight;
+
+    // Retained UI batch: the visible quads in one vertex buffer, rebuilt only when something
+    // changed, drawn with one glDrawArrays per texture run
+    std::vector<UIVertex> m_batchVertices;
+    std::vector<UIBatchRun> m_batchRuns;
+    GLuint m_vertexBuffer = 0;
+    std::atomic<bool> m_batchDirty{true};
+    size_t m_batchRebuildCount = 0;
 };
 
 // Global instance of the menu system
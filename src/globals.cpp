@@ -7,9 +7,29 @@
 
 // Framerate
 const double FRAMERATE_IN_SECONDS = 1. / 60.; // 60 FPS
+const double IDLE_FRAMERATE_IN_SECONDS = 1. / 30.; // Menus and pause screen: nothing moves, save the CPU/GPU
+FramePacingMode FRAME_PACING_MODE = FramePacingMode::VSYNC;
+double FRAME_RATE_CAP = 0.0; // FRAMERATE_IN_SECONDS is the fallback when the monitor reports no refresh rate
 
 // Grid properties
 const int GRID_SIZE = 170;
+// World streaming: the world is STREAMED_WORLD_SIZE blocks wide and generated in CHUNK_SIZE chunks around the camera
+bool ENABLE_WORLD_STREAMING = false;
+int STREAMED_WORLD_SIZE = 2048;
+int WORLD_SIZE = GRID_SIZE; // Set when gameplay starts
+// World saves: F5 saves to WORLD_SAVE_PATH, F9 toggles loading it on the next gameplay start
+bool LOAD_SAVED_WORLD = false;
+const char* WORLD_SAVE_PATH = "saves/world.sav";
+float AUTOSAVE_INTERVAL_SECONDS = 120.0f; // 0 disables autosave
+// Lockstep simulation: F11 cycles REPLAY_MODE (off, record, play) for the next gameplay start
+bool DETERMINISTIC_SIMULATION = false;
+ReplayMode REPLAY_MODE = ReplayMode::OFF;
+const char* REPLAY_PATH = "saves/replay.rpl";
+bool ENABLE_METRICS_ENDPOINT = true; // Loopback only, never reachable from the network
+int METRICS_PORT = 9464;
+bool HEADLESS_MODE = false; // Set by headless tools before Map::init / ElementsOnMap::init
+bool USE_ASSET_PACK = true;
+const char* ASSET_PACK_PATH = "../assets/textures.pack";
 // Player speeds are defined in entity configuration in entities.cpp
 const float PLAYER_BASE_SPEED = 3.0f;   // DEPRECATED: Use playerConfig->normalWalkingSpeed instead
 const float PLAYER_SPRINT_SPEED = 6.0f; // DEPRECATED: Use playerConfig->sprintWalkingSpeed instead
@@ -24,6 +44,11 @@ float seaFeatureSize = 0.1f;  // Controls the size of sea areas
 
 // Rendering parameters
 float gridLineWidth = 1.0f;
+bool USE_INSTANCED_SPRITES = true;
+bool USE_GPU_TILES = true;
+bool INTERPOLATE_CAMERA = true;
+bool INTERPOLATE_MOTION = true;
+bool RECORD_RENDER_IN_PARALLEL = true;
 int windowWidth = 1920;
 int windowHeight = 1080;
 float aspectRatio = 1.0f;
@@ -7,7 +7,34 @@ struct GLFWwindow;
 
 // Constants
 extern const double FRAMERATE_IN_SECONDS;
+extern const double IDLE_FRAMERATE_IN_SECONDS;
+// Frame pacing (see framePacer.h): R cycles vsync, capped and uncapped
+extern FramePacingMode FRAME_PACING_MODE;
+extern double FRAME_RATE_CAP; // Frames per second in CAPPED mode, 0 = the monitor refresh rate
 extern const int GRID_SIZE;
+// World streaming (chunks generated around the camera instead of one GRID_SIZE map)
+extern bool ENABLE_WORLD_STREAMING;
+extern int STREAMED_WORLD_SIZE;
+// Side of the active world in blocks: GRID_SIZE, or STREAMED_WORLD_SIZE when streaming. Use this for bounds checks.
+extern int WORLD_SIZE;
+// World save/load (see worldSave.h)
+extern bool LOAD_SAVED_WORLD; // When true, gameplay starts from WORLD_SAVE_PATH instead of generating a new world
+extern const char* WORLD_SAVE_PATH;
+extern float AUTOSAVE_INTERVAL_SECONDS;
+// Lockstep simulation (see simulationReplay.h): seeded random streams, tick-derived game clock, the
+// player moved inside the logic tick. Same seed + same input = same world, tick for tick.
+extern bool DETERMINISTIC_SIMULATION;
+extern ReplayMode REPLAY_MODE; // Record/replay the next gameplay session (implies DETERMINISTIC_SIMULATION)
+extern const char* REPLAY_PATH;
+// Runtime metrics (see metrics.h): Prometheus text endpoint on 127.0.0.1:METRICS_PORT/metrics
+extern bool ENABLE_METRICS_ENDPOINT;
+extern int METRICS_PORT;
+// Headless simulation (bench_sim): no window and no OpenGL context. Textures are only measured, never uploaded.
+extern bool HEADLESS_MODE;
+// Pre-decoded texture pack (see assetPack.h), built by the asset_pack target; missing or stale
+// entries load from the PNG files
+extern bool USE_ASSET_PACK;
+extern const char* ASSET_PACK_PATH;
 // DEPRECATED: Use entity configuration instead (playerConfig->normalWalkingSpeed and playerConfig->sprintWalkingSpeed)
 extern const float PLAYER_BASE_SPEED;
 extern const float PLAYER_SPRINT_SPEED;
@@ -18,6 +45,11 @@ extern float seaFeatureSize;
 
 // Rendering parameters
 extern float gridLineWidth;
+extern bool USE_INSTANCED_SPRITES; // Elements drawn with the instanced sprite renderer (immediate-mode quads when off)
+extern bool USE_GPU_TILES; // Blocks drawn from per-chunk tile streams, animated in the shader (immediate-mode quads when off)
+extern bool INTERPOLATE_CAMERA; // Render the camera between its last two published positions (latest position when off)
+extern bool INTERPOLATE_MOTION; // Render moving elements between their last two simulation steps (motionInterpolation.h)
+extern bool RECORD_RENDER_IN_PARALLEL; // World render layers recorded on worker threads, submitted by the main thread (renderCommands.h)
 extern int windowWidth;
 extern int windowHeight;
 extern float aspectRatio;
@@ -9,6 +9,11 @@
 #include "camera.h"
 #include "collision.h"
 #include "terrainGeneration.h"
+#include "chunkStreaming.h"
+#include "worldSave.h"
+#include "performanceProfiler.h"
+#include "metricsOverlay.h"
+#include "framePacer.h"
 #include "enumDefinitions.h"
 #include "threading.h"
 #include "gameMenus.h" // Added include for game menu system
@@ -70,8 +75,8 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         else if (key == GLFW_KEY_F) {
             // Find a water tile in the grid
             bool waterFound = false;
-            for (int x = 0; x < GRID_SIZE && !waterFound; x++) {
-                for (int y = 0; y < GRID_SIZE && !waterFound; y++) {
+            for (int x = 0; x < WORLD_SIZE && !waterFound; x++) {
+                for (int y = 0; y < WORLD_SIZE && !waterFound; y++) {
                     BlockName blockType = gameMap.getBlockNameByCoordinates(x, y);
                     if (isBlockNonTraversable(blockType)) {
                         // Found a non-traversable block (water), try to teleport player near it
@@ -90,8 +95,8 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         else if (key == GLFW_KEY_E) {
             // Find a water tile in the grid
             bool waterFound = false;
-            for (int x = 0; x < GRID_SIZE && !waterFound; x++) {
-                for (int y = 0; y < GRID_SIZE && !waterFound; y++) {
+            for (int x = 0; x < WORLD_SIZE && !waterFound; x++) {
+                for (int y = 0; y < WORLD_SIZE && !waterFound; y++) {
                     BlockName blockType = gameMap.getBlockNameByCoordinates(x, y);
                     if (isBlockNonTraversable(blockType)) {
                         // Found a non-traversable block (water), try to teleport entity near it
@@ -123,6 +128,45 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
             std::cout << "\n--- Current Elements List ---" << std::endl;
             elementsManager.listElements();
         }
+        // Save the world when F5 is pressed (written in the background)
+        else if (key == GLFW_KEY_F5) {
+            extern bool gameplayActive;
+            if (!gameplayActive) {
+                std::cout << "No world to save - start gameplay first" << std::endl;
+            } else if (g_worldSaver.requestSave(WORLD_SAVE_PATH)) {
+                std::cout << "Saving world to " << WORLD_SAVE_PATH << "..." << std::endl;
+            }
+        }
+        // Toggle loading the saved world on the next gameplay start with F9
+        else if (key == GLFW_KEY_F9) {
+            LOAD_SAVED_WORLD = !LOAD_SAVED_WORLD;
+            std::cout << "Next gameplay start will " << (LOAD_SAVED_WORLD ? "load the saved world" : "generate a new world") << std::endl;
+        }
+        // Cycle input replay for the next gameplay start with F11: off -> record -> play
+        else if (key == GLFW_KEY_F11) {
+            REPLAY_MODE = REPLAY_MODE == ReplayMode::OFF ? ReplayMode::RECORD
+                        : REPLAY_MODE == ReplayMode::RECORD ? ReplayMode::PLAY : ReplayMode::OFF;
+            DETERMINISTIC_SIMULATION = REPLAY_MODE != ReplayMode::OFF;
+            if (REPLAY_MODE == ReplayMode::RECORD) {
+                std::cout << "Next gameplay start will record its input to " << REPLAY_PATH << std::endl;
+            } else if (REPLAY_MODE == ReplayMode::PLAY) {
+                std::cout << "Next gameplay start will replay " << REPLAY_PATH << std::endl;
+            } else {
+                std::cout << "Next gameplay start will not record or replay input" << std::endl;
+            }
+        }
+        // Toggle the metrics overlay (tick/frame time, path queue, collision queries) with F12
+        else if (key == GLFW_KEY_F12) {
+            g_metricsOverlay.toggle();
+        }
+        // Cycle frame pacing with R: vsync -> capped -> uncapped (benchmark)
+        else if (key == GLFW_KEY_R) {
+            g_framePacer.cycleMode();
+        }
+        // Export the recent profiler zones of every thread as a Chrome trace (open in Perfetto) with F10
+        else if (key == GLFW_KEY_F10) {
+            PerformanceProfiler::getInstance().exportChromeTrace("profile_trace.json");
+        }
         // Print detailed element positions when F6 is pressed
         else if (key == GLFW_KEY_F6) {
             elementsManager.printElementPositions();
@@ -154,14 +198,27 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
             
             // Regenerate the map with the new setting
             std::cout << "Regenerating terrain with DEBUG_MAP=" << (DEBUG_MAP ? "true" : "false") << "..." << std::endl;
-            std::map<std::pair<int, int>, BlockName> generatedMap = generateTerrain(GRID_SIZE, GRID_SIZE, islandFeatureSize, seaFeatureSize, 0.55f, 0.65f);
-            gameMap.placeBlocks(generatedMap);
-            
-            // Regenerate terrain elements
-            elementsManager.removeAllElementsByCategory("decoration");
-            placeTerrainElements(elementsManager, gameMap, GRID_SIZE, GRID_SIZE);
+            int areaOriginX = 0;
+            int areaOriginY = 0;
+            if (ENABLE_WORLD_STREAMING) {
+                // Restart streaming from scratch around the current view
+                CameraView cameraView = gameCamera.getView();
+                float centerX = (cameraView.left + cameraView.right) / 2.0f;
+                float centerY = (cameraView.bottom + cameraView.top) / 2.0f;
+                startStreamedWorld(gameMap, centerX, centerY, GRID_SIZE);
+                areaOriginX = std::max(0, static_cast<int>(centerX) - GRID_SIZE / 2);
+                areaOriginY = std::max(0, static_cast<int>(centerY) - GRID_SIZE / 2);
+            } else {
+                TerrainGrid generatedTerrain = generateTerrainGrid(GRID_SIZE, GRID_SIZE, islandFeatureSize, seaFeatureSize, 0.55f, 0.65f);
+                gameMap.placeBlockGrid(generatedTerrain.blocks, generatedTerrain.width, generatedTerrain.height);
+            }
             
-            std::cout << "Map regeneration complete." << std::endl;
+            // Regenerate terrain elements: the old ones go over a few ticks (time-sliced job), the
+            // new ones are placed once they are all gone - placement reuses the same names
+            elementsManager.removeAllElementsByCategorySliced("decoration", [areaOriginX, areaOriginY](int) {
+                placeTerrainElementsInArea(elementsManager, gameMap, areaOriginX, areaOriginY, GRID_SIZE, GRID_SIZE);
+                std::cout << "Map regeneration complete." << std::endl;
+            });
         }
         // Show collision information
         else if (key == GLFW_KEY_F7) {
@@ -270,8 +327,8 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
             normalizedY >= g_startY && normalizedY <= g_endY) {
             
             // Map normalized coordinates to grid coordinates
-            float gridX = (normalizedX - g_startX) / (g_endX - g_startX) * GRID_SIZE;
-            float gridY = (normalizedY - g_startY) / (g_endY - g_startY) * GRID_SIZE;
+            float gridX = (normalizedX - g_startX) / (g_endX - g_startX) * WORLD_SIZE;
+            float gridY = (normalizedY - g_startY) / (g_endY - g_startY) * WORLD_SIZE;
             
             // Convert to integer grid coordinates
             int gridXInt = static_cast<int>(gridX);
@@ -368,8 +425,9 @@ void processDebugKeys(ElementsOnMap& elementsManager) {
     // Log camera dimensions when F1 is pressed (for debugging)
     static bool lastF1KeyState = false;
     if (keyPressedStates[GLFW_KEY_F1] && !lastF1KeyState) {
-        float cameraWidth = gameCamera.getWidth();
-        float cameraHeight = gameCamera.getHeight();
+        CameraView cameraView = gameCamera.getView();
+        float cameraWidth = cameraView.getWidth();
+        float cameraHeight = cameraView.getHeight();
         float windowAspectRatio = (float)windowWidth / (float)windowHeight;
         
         std::cout << "Window size: " << windowWidth << "x" << windowHeight 
@@ -18,6 +18,18 @@
 #include "gameMenus.h" // Added include for game menu system
 #include "terrainGeneration.h" // Added include for terrain generation reset
 #include "terrainGenerationConfig.h" // Added include for terrain configuration reset
+#include "chunkStreaming.h" // Added include for world chunk streaming
+#include "worldSave.h" // Added include for world save/load
+#include "simulationRandom.h" // Added include for the seeded simulation random streams
+#include "simulationReplay.h" // Added include for lockstep sessions and input replays
+#include "gameClock.h" // Added include for the lockstep game clock
+#include "metrics.h" // Added include for the runtime metrics registry
+#include "metricsServer.h" // Added include for the loopback metrics endpoint
+#include "metricsOverlay.h" // Added include for the F12 metrics overlay
+#include "timeSlicedJobs.h" // Added include for the time-sliced gameplay jobs
+#include "framePacer.h" // Added include for the main loop frame pacing
+#include "visibleSet.h" // Added include for the per-frame visible set
+#include "renderCommands.h" // Added include for the render layer recording
 #include <ctime> // For time(0) to seed random number generator
 #include <cmath> // For sqrt function
 #include <algorithm> // For std::min and std::max
@@ -57,8 +69,36 @@ bool startGameplay(GLBI_Engine& engine, GLFWwindow* window) {
     }
       std::cout << "Starting gameplay..." << std::endl;    // Generate a new random seed for this gameplay session
     SEED_GAMEPLAY = static_cast<unsigned int>(time(0));
+    // Lockstep session: seeded per-system random streams and a tick-derived clock, optionally
+    // recording or replaying the input (see simulationReplay.h)
+    if (DETERMINISTIC_SIMULATION || REPLAY_MODE != ReplayMode::OFF) {
+        if (ENABLE_WORLD_STREAMING) {
+            std::cerr << "Lockstep simulation does not support world streaming - starting a regular session" << std::endl;
+        } else if (REPLAY_MODE == ReplayMode::PLAY) {
+            if (g_simulationReplay.beginPlayback(REPLAY_PATH)) {
+                SEED_GAMEPLAY = g_simulationReplay.getSeed();
+            }
+        } else if (REPLAY_MODE == ReplayMode::RECORD) {
+            g_simulationReplay.beginRecording(REPLAY_PATH, SEED_GAMEPLAY);
+        } else {
+            g_simulationReplay.beginLive(SEED_GAMEPLAY);
+        }
+        if (g_simulationReplay.isActive()) {
+            // The clock stands at 0 while the world is generated and advances with the logic ticks
+            setGameClockSource(lockstepGameClock);
+        }
+    }
+    // Continue a saved world instead (blocks, elements and entities come from the save file);
+    // a lockstep session always starts from its seed
+    if (LOAD_SAVED_WORLD && !g_simulationReplay.isActive() && g_loadedWorldSave.open(WORLD_SAVE_PATH)) {
+        SEED_GAMEPLAY = g_loadedWorldSave.getSeed();
+        std::cout << "Loading saved world from " << WORLD_SAVE_PATH << std::endl;
+    }
+    // The next save starts a new file unless this session continues the saved one
+    g_worldSaver.resetTracking();
     srand(SEED_GAMEPLAY);
     TERRAIN_RNG.seed(SEED_GAMEPLAY);  // Set the seed for the global C++ random generator
+    seedSimulationRandom(SEED_GAMEPLAY); // Block, behavior and entity streams (simulationRandom.h)
     std::cout << "Generated new gameplay seed: " << SEED_GAMEPLAY << std::endl;
       // Reset coconut counter for fresh gameplay session
     COCONUT_COUNTER = 0;
@@ -76,6 +116,7 @@ bool startGameplay(GLBI_Engine& engine, GLFWwindow* window) {
     std::cout << "Reset terrain generation configuration with fresh rules" << std::endl;
         // Clear all existing blocks from previous gameplay session to ensure fresh map state
     gameMap.clearBlocks();
+    gameMap.releaseAllRetiredChunks(); // The previous session's threads are stopped
         // Clear ALL elements from previous gameplay session (not just terrain_ prefix)
     // Elements are created with names like "CoconutTrees_0", "coconut_1", etc.
     auto elements = elementsManager.getElements();  // Get a copy of elements
@@ -114,6 +155,14 @@ bool startGameplay(GLBI_Engine& engine, GLFWwindow* window) {
     std::cout << "Resetting entity movement states..." << std::endl;
     Gameplay::getEntitiesManager().resetAllEntityMovementStates();
     
+    // Saved worlds get their entity movement/behavior state and counters back after the reset
+    if (g_loadedWorldSave.isOpen()) {
+        g_loadedWorldSave.restoreEntityStates(Gameplay::getEntitiesManager());
+        COCONUT_COUNTER = g_loadedWorldSave.getCoconutCounter();
+        g_worldSaver.trackLoadedWorld(g_loadedWorldSave, Gameplay::getGameMap());
+        g_loadedWorldSave.close();
+    }
+    
     // Ensure camera is properly positioned at player's starting position to prevent flicker
     float playerX, playerY;
     if (getPlayerPosition(playerX, playerY)) {
@@ -176,6 +225,15 @@ void endGameplay() {
     }
       // Cleanup gameplay systems (threads, entities, etc.)
     Gameplay::cleanup();
+    
+    // Work queued for this world has nothing to act on in the next one
+    g_timeSlicedJobs.clear();
+    
+    // Write the replay / report the playback once the last tick ran, then back to the wall clock
+    if (g_simulationReplay.isActive()) {
+        g_simulationReplay.end();
+        setGameClockSource(nullptr);
+    }
 
     gameMenus.removeUIElement(UIElementName::HEALTH_BAR);
     gameMenus.removeUIElement(UIElementName::COCONUTS);
@@ -262,13 +320,16 @@ void onWindowResize(GLFWwindow* window, int width, int height) {
         std::cout << "Using last known player position for camera: (" << playerX << ", " << playerY << ")" << std::endl;
     } else {
         // No player and no last known position - use center of the map
-        gameCamera.updateCameraPosition(GRID_SIZE / 2.0f, GRID_SIZE / 2.0f, width, height);
+        gameCamera.updateCameraPosition(WORLD_SIZE / 2.0f, WORLD_SIZE / 2.0f, width, height);
     }
     
     // Keep grid rendering parameters for coordinate conversion covering the full NDC space
     g_startX = -1.0f;
     g_endX = 1.0f;
     g_startY = -1.0f;    g_endY = 1.0f;
+
+    // A resize can come with a move to another monitor (fullscreen, window snapping)
+    g_framePacer.updateRefreshRate();
 }
 
 int main() {
@@ -326,20 +387,28 @@ int main() {
 	}
 	
 	std::cout << "Game engine initialization complete - press Enter to start gameplay" << std::endl;
+	
+	// Loopback metrics endpoint for soak tests (stays up across gameplay sessions)
+	if (ENABLE_METRICS_ENDPOINT) {
+		g_metricsServer.start(METRICS_PORT);
+	}
+	// Swap interval and refresh rate of the monitor the window is on (FRAME_PACING_MODE)
+	g_framePacer.init(window);
+	// Worker threads recording the world render layers (RECORD_RENDER_IN_PARALLEL)
+	g_renderRecorder.init();
 	/* Main render loop - runs until user closes the window */
 	int frameCount = 0;
 	while (!glfwWindowShouldClose(window))
 	{
 		frameCount++;
+		g_framePacer.beginFrame();
+		double frameInterval = g_framePacer.getLastPresentInterval();
 		
 		// CRASH FIX: Add periodic memory monitoring
 		if (frameCount % 300 == 0) { // Every ~5 seconds at 60 FPS
 			DEBUG_LOG_MEMORY("game_loop_frame_" + std::to_string(frameCount));
 		}
 				try {
-			/* Get time (in second) at loop beginning */
-			double startTime = glfwGetTime();
-			
 			/* Render here */
 			glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Black background
 			glClear(GL_COLOR_BUFFER_BIT);
@@ -382,14 +451,23 @@ int main() {
 				bool sprint = keyPressedStates[GLFW_KEY_LEFT_SHIFT] || keyPressedStates[GLFW_KEY_RIGHT_SHIFT];
 				
 				// Set player movement input directly to the player movement manager
-				g_threadManager->setPlayerMovementInput(playerMoveX, playerMoveY, sprint);
+				// (a lockstep session samples it once per logic tick instead, see simulationReplay.h)
+				if (g_simulationReplay.isActive()) {
+					g_simulationReplay.setLiveInput(playerMoveX, playerMoveY, sprint);
+				} else {
+					g_threadManager->setPlayerMovementInput(playerMoveX, playerMoveY, sprint);
+				}
 				
 				// Handle spacebar for ICE block placement
 				static bool lastSpaceState = false;
 				bool currentSpaceState = keyPressedStates[GLFW_KEY_SPACE];
 				if (currentSpaceState && !lastSpaceState && playerExists) {
-					// Spacebar was just pressed - place ICE block
-					placeIceBlockInFront();
+					// Spacebar was just pressed - place ICE block (on the next tick in a lockstep session)
+					if (g_simulationReplay.isActive()) {
+						g_simulationReplay.requestIcePlacement();
+					} else {
+						placeIceBlockInFront();
+					}
 				}
 				lastSpaceState = currentSpaceState;
 				
@@ -407,15 +485,13 @@ int main() {
 				float startY = g_startY;
 				float endY = g_endY;
 				
-				// Get camera boundaries (camera position is updated by game thread)
-				float cameraLeft = gameCamera.getLeft();
-				float cameraRight = gameCamera.getRight();
-				float cameraBottom = gameCamera.getBottom();
-				float cameraTop = gameCamera.getTop();
-				
-				// Calculate the width and height of the view in world coordinates
-				float viewWidth = gameCamera.getWidth();
-				float viewHeight = gameCamera.getHeight();
+				// Get camera boundaries (published by the player movement thread, interpolated between
+				// its last two positions for this frame)
+				CameraView cameraView = gameCamera.getRenderView();
+				float cameraLeft = cameraView.left;
+				float cameraRight = cameraView.right;
+				float cameraBottom = cameraView.bottom;
+				float cameraTop = cameraView.top;
 				  
 				// Calculate the map grid boundaries in window coordinates for the scissor test
 				// Convert from normalized device coordinates (-1 to 1) to window coordinates (0 to windowWidth/Height)
@@ -468,34 +544,36 @@ int main() {
 					glEnd();
 				}
 				
-				// Update block transformations (only when game is not paused)
+				// Stream world chunks in and out around the view (no-op unless world streaming is enabled)
+				g_chunkStreamer.update(Gameplay::getGameMap(), cameraLeft, cameraRight, cameraBottom, cameraTop);
+				
+				// World saves: snapshot the map for a pending save (under the map's write lock, so the logic
+				// tick's block transformations land before or after it);
+				// entities are snapshotted by the logic thread, or here while it is paused
 				if (!g_threadManager->isPaused()) {
-					Gameplay::getGameMap().updateBlockTransformations(gameState.deltaTime);
+					g_worldSaver.updateAutosave();
+				}
+				g_worldSaver.captureMapState(Gameplay::getGameMap());
+				if (g_threadManager->isPaused()) {
+					g_worldSaver.captureObjectState(Gameplay::getEntitiesManager(), Gameplay::getElementsManager());
 				}
 				
-				// Draw the blocks (textured squares) on the grid
-				// Now we pass the camera boundaries to drawBlocks instead of the GRID_SIZE
-				Gameplay::getGameMap().drawBlocks(startX, endX, startY, endY, cameraLeft, cameraRight, cameraBottom, cameraTop, gameState.deltaTime);
-				
-				// Reset to default state before drawing elements
-				glMatrixMode(GL_MODELVIEW);
-				glLoadIdentity();
-				
-				// Draw elements on top of the map tiles (freely placed decorations)
-				Gameplay::getElementsManager().drawElements(startX, endX, startY, endY, cameraLeft, cameraRight, cameraBottom, cameraTop, gameState.deltaTime);
+				// What the camera sees this frame (block cells), shared by the render layers below
+				g_visibleSet.update(startX, endX, startY, endY, cameraView);
 				
-				// Draw entity debug paths if enabled
-				if (DEBUG_SHOW_PATHS) {
-					Gameplay::getEntitiesManager().drawDebugPaths(startX, endX, startY, endY, cameraLeft, cameraRight, cameraBottom, cameraTop);
-				}
-
-				// Draw entity collision radii if collision visualization is enabled
-				Gameplay::getEntitiesManager().drawDebugCollisionRadii(startX, endX, startY, endY, cameraLeft, cameraRight, cameraBottom, cameraTop);
+				// The render workers record the world layers (blocks, elements on top of them, entity
+				// debug paths and collision radii) from the visible set, then this thread submits them
+				g_renderRecorder.record(g_visibleSet, Gameplay::getGameMap(), Gameplay::getElementsManager(),
+				                        Gameplay::getEntitiesManager(), gameState.deltaTime);
+				g_renderRecorder.submit(Gameplay::getGameMap(), Gameplay::getElementsManager());
 
 				// Disable scissor test when rendering is complete
 				if (hideOutsideGrid) {
 					glDisable(GL_SCISSOR_TEST);
 				}
+				
+				// Metrics strip charts (F12) over the world, under the menus
+				g_metricsOverlay.render(frameInterval);
 						// Check escape key to close the window (but not during active gameplay)
 				if (keyPressedStates[GLFW_KEY_X]) {
 					if (GAME_STATE == GameState::GAMEPLAY) {
@@ -528,20 +606,16 @@ int main() {
 			// This ensures menus are visible regardless of gameplay state
 			gameMenus.render();
 			
-		/* Swap front and back buffers */
+		/* Swap front and back buffers (waits for the vertical blank in vsync mode) */
 		glfwSwapBuffers(window);
+		g_framePacer.framePresented();
 
 		/* Poll for and process events */
 		glfwPollEvents();
 
-		/* Elapsed time computation from loop beginning */
-		double elapsedTime = glfwGetTime() - startTime;
-		/* If too little time is spent vs our wanted FPS, we wait */
-		while(elapsedTime < FRAMERATE_IN_SECONDS)
-		{
-			glfwWaitEventsTimeout(FRAMERATE_IN_SECONDS - elapsedTime);
-			elapsedTime = glfwGetTime() - startTime;
-		}
+		/* Menus and the pause screen don't need the full frame rate */
+		bool idleFrame = !gameplayActive || GAME_STATE != GameState::GAMEPLAY;
+		g_framePacer.waitForNextFrame(idleFrame);
 		
 		} catch (const std::exception& e) {
 			std::cerr << "CRASH FIX: Exception in game loop frame " << frameCount << ": " << e.what() << std::endl;
@@ -558,6 +632,8 @@ int main() {
 	
 	// Cleanup gameplay systems (threads, entities, etc.)
 	Gameplay::cleanup();
+	
+	g_metricsServer.stop();
 
     // Cleanup input system
     std::cout << "Cleaning up input system..." << std::endl;
@@ -1,12 +1,21 @@
 #include "map.h"
+#include "gameLog.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 #include <algorithm>   // For std::replace
 #include <string>
 #include <map>
+#include <cmath>
+#include <random>
+#include <limits>
 #include "enumDefinitions.h"
 #include "entitiesStatus.h"
+#include "globals.h" // For HEADLESS_MODE
+#include "simulationRandom.h"
+#include "textureLoader.h"
+#include "visibleSet.h"
+#include "readEpoch.h"
 
 // For cross-platform directory checking
 #ifdef _WIN32
@@ -25,15 +34,16 @@
 Map gameMap;
 
 Map::Map() : enginePtr(nullptr) {
-    // Reserve some space for blocks to reduce reallocations
-    blocks.reserve(5000); // Assuming a map size of approximately 70x70
 }
 
 Map::~Map() {
     // CRASH FIX: Add OpenGL context validation before cleanup
-    if (glfwGetCurrentContext() == nullptr) {
-        std::cerr << "WARNING: No OpenGL context available for texture cleanup" << std::endl;
+    if (HEADLESS_MODE) {
+        // Nothing was uploaded (see loadTexture)
+    } else if (glfwGetCurrentContext() == nullptr) {
+        GAME_LOG_WARN("WARNING: No OpenGL context available for texture cleanup");
     } else {
+        tileRenderer.shutdown();
         // Clean up all loaded textures
         for (auto const& pair : textureDetails) {
             if (pair.second.textureID > 0) {
@@ -42,7 +52,7 @@ Map::~Map() {
                 if (isTexture == GL_TRUE) {
                     glDeleteTextures(1, &pair.second.textureID);
                 } else {
-                    std::cerr << "WARNING: Invalid texture ID " << pair.second.textureID << " detected during cleanup" << std::endl;
+                    GAME_LOG_WARN("WARNING: Invalid texture ID " << pair.second.textureID << " detected during cleanup");
                 }
             }
         }
@@ -50,8 +60,10 @@ Map::~Map() {
     
     // Clear containers
     textureDetails.clear();
-    blocks.clear();
-    blockPositionMap.clear();
+    for (int i = 0; i < chunkCountX * chunkCountY; ++i) {
+        delete chunkSlots[i].load(std::memory_order_relaxed);
+    }
+    releaseRetiredChunks(true);
 }
 
 bool Map::init(glbasimac::GLBI_Engine& engine) {
@@ -60,7 +72,7 @@ bool Map::init(glbasimac::GLBI_Engine& engine) {
     // Print current working directory to debug file path issues
     char cwd[1024];
     if (GetCurrentDir(cwd, sizeof(cwd)) != NULL) {
-        std::cout << "Current working directory: " << cwd << std::endl;
+        GAME_LOG_INFO("Current working directory: " << cwd);
     }
 
     // C++11 compatible way to initialize the map
@@ -169,23 +181,32 @@ bool Map::init(glbasimac::GLBI_Engine& engine) {
 
 
 
-    for (auto it = textureConfigs.begin(); it != textureConfigs.end(); ++it) { // Changed to iterator loop
+    // Decode all the block textures in parallel, uploaded as each decode finishes (the loader
+    // logs one timing line per texture and the errors). Headless: image headers only.
+    std::vector<TextureLoadResult> loadedTextures;
+    if (!HEADLESS_MODE) {
+        std::vector<std::string> texturePaths;
+        for (const auto& pair : textureConfigs) {
+            texturePaths.push_back(pair.second.path);
+        }
+        loadedTextures = TextureLoader::getInstance().loadTextures(texturePaths, "map blocks");
+    }
+
+    size_t textureIndex = 0;
+    for (auto it = textureConfigs.begin(); it != textureConfigs.end(); ++it, ++textureIndex) { // Changed to iterator loop
         BlockName name = it->first;
         BlockInfo& info = it->second; // Get a reference to modify
 
-        std::cout << "Attempting to load texture for type " << static_cast<int>(name) << " from: " << info.path << std::endl;
-        std::ifstream testFile(info.path.c_str());
-        if (!testFile.good()) {
-            std::cerr << "✗ Texture file NOT found at: " << info.path << std::endl;
-            // return false; // Uncomment to make it a fatal error
+        if (HEADLESS_MODE) {
+            if (!loadTexture(info.path, info.textureID, info.textureWidth, info.textureHeight)) {
+                GAME_LOG_ERROR("Failed to load texture: " << info.path);
+                // return false; // Uncomment to make it a fatal error
+            }
         } else {
-            testFile.close();
-            std::cout << "✓ Texture file found at: " << info.path << std::endl;
-        }
-        
-        if (!loadTexture(info.path, info.textureID, info.textureWidth, info.textureHeight)) {
-            std::cerr << "Failed to load texture: " << info.path << std::endl;
-            // return false; // Uncomment to make it a fatal error
+            const TextureLoadResult& loaded = loadedTextures[textureIndex];
+            info.textureID = loaded.textureID;
+            info.textureWidth = loaded.width;
+            info.textureHeight = loaded.height;
         }
 
         if (info.animType == TextureAnimationType::ANIMATED) {
@@ -194,61 +215,39 @@ bool Map::init(glbasimac::GLBI_Engine& engine) {
             } else {
                 info.frameCount = 1; // Avoid division by zero
             }
-            std::cout << "Animated texture loaded: " << info.path << " with " << info.frameCount << " frames." << std::endl;
+            GAME_LOG_INFO("Animated texture loaded: " << info.path << " with " << info.frameCount << " frames.");
         }
         textureDetails[name] = info; // Store the configured and loaded texture info
     }
     
-    std::cout << "Map initialized. Loaded " << textureDetails.size() << " texture configurations." << std::endl;
+    GAME_LOG_INFO("Map initialized. Loaded " << textureDetails.size() << " texture configurations.");
+    tileTypes.clear();
+    advanceBlockAnimations(0.0);
+
+    if (!HEADLESS_MODE) {
+        tileRenderer.init();
+    }
     return true;
 }
 
 bool Map::loadTexture(const std::string& path, GLuint& textureID, int& width, int& height) {
-    // Print attempting to load
-    std::cout << "Attempting to load texture from: " << path << std::endl;
-    
-    // Generate texture
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-      // Set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-      // Make sure stb_image uses the correct orientation
-    stbi_set_flip_vertically_on_load(true);
-    
-    // Load image using stb_image
-    int nrChannels;
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
-    
-    if (data) {
-        GLenum format;
-        if (nrChannels == 1)
-            format = GL_RED;
-        else if (nrChannels == 3)
-            format = GL_RGB;
-        else if (nrChannels == 4)
-            format = GL_RGBA;
-        else {
-            std::cerr << "Unsupported number of channels: " << nrChannels << std::endl;
-            stbi_image_free(data);
+    // Headless simulation: no GL context, only the dimensions are needed (animation frame counts)
+    if (HEADLESS_MODE) {
+        int nrChannels;
+        textureID = 0;
+        if (!stbi_info(path.c_str(), &width, &height, &nrChannels)) {
+            GAME_LOG_ERROR("Failed to read texture header: " << path);
             return false;
         }
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        
-        std::cout << "Texture loaded successfully: " << path << std::endl;
-        std::cout << "Dimensions: " << width << "x" << height << ", Channels: " << nrChannels << std::endl;
-        std::cout << "TextureID: " << textureID << std::endl;
-        
-        stbi_image_free(data);
         return true;
-    } else {
-        std::cerr << "Failed to load texture: " << path << std::endl;
-        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
-        return false;
     }
+    
+    // Same decode and upload as the batch in init (pixel buffer upload, GL_NEAREST, clamped)
+    TextureLoadResult loaded = TextureLoader::getInstance().loadTexture(path);
+    textureID = loaded.textureID;
+    width = loaded.width;
+    height = loaded.height;
+    return textureID != 0;
 }
 
 GLuint Map::getTexture(BlockName name) const {
@@ -256,22 +255,20 @@ GLuint Map::getTexture(BlockName name) const {
     if (it != textureDetails.end()) {
         return it->second.textureID;
     }
-    std::cerr << "Texture type " << static_cast<int>(name) << " not found!" << std::endl;
+    GAME_LOG_ERROR("Texture type " << static_cast<int>(name) << " not found!");
     return 0; 
 }
 
 void Map::placeBlock(BlockName name, int x, int y) {
-    // First check if a block already exists at these coordinates
-    bool blockExists = false;
-    size_t existingBlockIndex = 0;
-    
-    for (size_t i = 0; i < blocks.size(); ++i) {
-        if (blocks[i].x == x && blocks[i].y == y) {
-            blockExists = true;
-            existingBlockIndex = i;
-            break;
-        }
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    if (x < 0 || y < 0) {
+        GAME_LOG_WARN("Warning: Cannot place block at negative coordinates (" << x << ", " << y << ")");
+        return;
     }
+
+    // First check if a block already exists at these coordinates
+    Block* existingBlock = findBlock(x, y);
+    bool blockExists = existingBlock != nullptr;
     
     Block newBlock;
     newBlock.name = name;
@@ -283,14 +280,17 @@ void Map::placeBlock(BlockName name, int x, int y) {
         
         // Save previous existing block if requested and a block already exists
         if (texInfo.savePreviousExistingBlock && blockExists) {
-            BlockName previousBlockName = blocks[existingBlockIndex].name;
-            savedExistingBlocks[{x, y}] = previousBlockName;
-            std::cout << "Saved previous block " << static_cast<int>(previousBlockName) << " at coordinates (" << x << ", " << y << ")" << std::endl;
+            BlockName previousBlockName = existingBlock->name;
+            {
+                std::lock_guard<std::mutex> lock(savedBlocksMutex);
+                savedExistingBlocks[{x, y}] = previousBlockName;
+            }
+            GAME_LOG_INFO("Saved previous block " << static_cast<int>(previousBlockName) << " at coordinates (" << x << ", " << y << ")");
         }
         
         if (texInfo.animType == TextureAnimationType::ANIMATED && texInfo.animationStartRandomFrame && texInfo.frameCount > 0) {
             // Generate a random starting frame for this block instance
-            newBlock.currentFrame = static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
+            newBlock.currentFrame = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
             // Ensure the random frame is within [0, frameCount)
             if (newBlock.currentFrame >= texInfo.frameCount) {
                 newBlock.currentFrame = static_cast<float>(texInfo.frameCount - 1);
@@ -299,7 +299,7 @@ void Map::placeBlock(BlockName name, int x, int y) {
             newBlock.currentFrame = 0.0f; // Default start frame if not random or not animated
         }// Initialize rotationAngle
         if (texInfo.randomizedRotation) {
-            int randomRotation = rand() % 4; // 0, 1, 2, or 3
+            int randomRotation = simulationRand(RandomStream::BLOCKS) % 4; // 0, 1, 2, or 3
             newBlock.rotationAngle = randomRotation * 90; // 0, 90, 180, or 270
         } else {
             newBlock.rotationAngle = 0;
@@ -311,7 +311,7 @@ void Map::placeBlock(BlockName name, int x, int y) {
         if (texInfo.hasTransformation && texInfo.transformBlockTimeIntervalEnd > texInfo.transformBlockTimeIntervalStart) {
             // Generate a random transformation time within the specified interval
             float interval = texInfo.transformBlockTimeIntervalEnd - texInfo.transformBlockTimeIntervalStart;
-            float randomFactor = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+            float randomFactor = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / static_cast<float>(RAND_MAX);
             newBlock.transformationTarget = texInfo.transformBlockTimeIntervalStart + (randomFactor * interval);
             newBlock.hasBeenInitializedForTransformation = true;
         } else {
@@ -326,26 +326,27 @@ void Map::placeBlock(BlockName name, int x, int y) {
     }    // If a block already exists at these coordinates, replace it instead of adding a new one
     if (blockExists) {
         // Only replace if the texture is different (reduce unnecessary operations)
-        if (blocks[existingBlockIndex].name != name) {
+        if (existingBlock->name != name) {
             // Reset transformation parameters when replacing a block
             newBlock.transformationTimer = 0.0f;
             newBlock.hasBeenInitializedForTransformation = false;
             if (it != textureDetails.end() && it->second.hasTransformation && 
                 it->second.transformBlockTimeIntervalEnd > it->second.transformBlockTimeIntervalStart) {
                 float interval = it->second.transformBlockTimeIntervalEnd - it->second.transformBlockTimeIntervalStart;
-                float randomFactor = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+                float randomFactor = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / static_cast<float>(RAND_MAX);
                 newBlock.transformationTarget = it->second.transformBlockTimeIntervalStart + (randomFactor * interval);
                 newBlock.hasBeenInitializedForTransformation = true;
             } else {
                 newBlock.transformationTarget = -1.0f;
             }
             
-            blocks[existingBlockIndex] = newBlock;        }
+            *existingBlock = newBlock;
+            markBlockModified(x, y);
+        }
     } else {
-        // Add the new block
-        blocks.push_back(newBlock);
-        // Update the position map
-        blockPositionMap[{x, y}] = blocks.size() - 1;
+        // Add the new block (creates its chunk if needed)
+        setWorldSize(std::max(worldWidth, x + 1), std::max(worldHeight, y + 1));
+        insertBlock(*getOrCreateChunk(x / CHUNK_SIZE, y / CHUNK_SIZE), x, y) = newBlock;
     }
       // Check for damage blocks if any entities are affected by the placed block
     extern EntitiesManager entitiesManager;
@@ -353,24 +354,32 @@ void Map::placeBlock(BlockName name, int x, int y) {
 }
 
 void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPlace) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
     // DEBUG: Log the number of blocks being placed
-    std::cout << "DEBUG: placeBlocks called with " << blocksToPlace.size() << " blocks to place" << std::endl;
-    std::cout << "DEBUG: Current blocks vector size: " << blocks.size() << ", blockPositionMap size: " << blockPositionMap.size() << std::endl;
+    GAME_LOG_DEBUG("DEBUG: placeBlocks called with " << blocksToPlace.size() << " blocks to place");
+    GAME_LOG_DEBUG("DEBUG: Current block count: " << totalBlockCount << ", resident chunks: " << residentChunkCount);
     
-    // Since we already maintain blockPositionMap, we don't need to create it here anymore
+    // Grow the chunk table once up front instead of block by block
+    if (!blocksToPlace.empty()) {
+        int maxX = blocksToPlace.rbegin()->first.first;
+        int maxY = 0;
+        for (const auto& pair : blocksToPlace) maxY = std::max(maxY, pair.first.second);
+        setWorldSize(std::max(worldWidth, maxX + 1), std::max(worldHeight, maxY + 1));
+    }
       // Now process the blocks we want to place
     for (const auto& pair : blocksToPlace) {
         const std::pair<int, int>& coords = pair.first;
         BlockName name = pair.second;
+        if (coords.first < 0 || coords.second < 0) continue;
         
-        auto existingBlockIt = blockPositionMap.find(coords);
-        if (existingBlockIt != blockPositionMap.end()) {
+        Block* existingBlock = findBlock(coords.first, coords.second);
+        if (existingBlock) {
             // Block exists - check if we need to replace it
-            size_t existingBlockIndex = existingBlockIt->second;
-            if (blocks[existingBlockIndex].name != name) {                // Replace with new texture
-                Block& block = blocks[existingBlockIndex];
+            if (existingBlock->name != name) {                // Replace with new texture
+                Block& block = *existingBlock;
                 BlockName previousBlockName = block.name; // Save the current block name before replacing
                 block.name = name;
+                markBlockModified(coords.first, coords.second);
                 
                 // Reset animation parameters
                 auto texIt = textureDetails.find(name);
@@ -379,12 +388,13 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
                     
                     // Save previous existing block if requested
                     if (texInfo.savePreviousExistingBlock) {
+                        std::lock_guard<std::mutex> lock(savedBlocksMutex);
                         savedExistingBlocks[coords] = previousBlockName;
-                        std::cout << "Saved previous block " << static_cast<int>(previousBlockName) << " at coordinates (" << coords.first << ", " << coords.second << ")" << std::endl;
+                        GAME_LOG_INFO("Saved previous block " << static_cast<int>(previousBlockName) << " at coordinates (" << coords.first << ", " << coords.second << ")");
                     }
                     
                     if (texInfo.animType == TextureAnimationType::ANIMATED && texInfo.animationStartRandomFrame && texInfo.frameCount > 0) {
-                        block.currentFrame = static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
+                        block.currentFrame = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
                         if (block.currentFrame >= texInfo.frameCount) {
                             block.currentFrame = static_cast<float>(texInfo.frameCount - 1);
                         }
@@ -392,7 +402,7 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
                         block.currentFrame = 0.0f;
                     }
                       if (texInfo.randomizedRotation) {
-                        int randomRotation = rand() % 4;
+                        int randomRotation = simulationRand(RandomStream::BLOCKS) % 4;
                         block.rotationAngle = randomRotation * 90;
                     } else {
                         block.rotationAngle = 0;
@@ -403,7 +413,7 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
                     block.hasBeenInitializedForTransformation = false;
                     if (texInfo.hasTransformation && texInfo.transformBlockTimeIntervalEnd > texInfo.transformBlockTimeIntervalStart) {
                         float interval = texInfo.transformBlockTimeIntervalEnd - texInfo.transformBlockTimeIntervalStart;
-                        float randomFactor = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+                        float randomFactor = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / static_cast<float>(RAND_MAX);
                         block.transformationTarget = texInfo.transformBlockTimeIntervalStart + (randomFactor * interval);
                         block.hasBeenInitializedForTransformation = true;
                     } else {
@@ -429,7 +439,7 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
             if (texIt != textureDetails.end()) {
                 const BlockInfo& texInfo = texIt->second;
                 if (texInfo.animType == TextureAnimationType::ANIMATED && texInfo.animationStartRandomFrame && texInfo.frameCount > 0) {
-                    newBlock.currentFrame = static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
+                    newBlock.currentFrame = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
                     if (newBlock.currentFrame >= texInfo.frameCount) {
                         newBlock.currentFrame = static_cast<float>(texInfo.frameCount - 1);
                     }
@@ -437,7 +447,7 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
                     newBlock.currentFrame = 0.0f;
                 }
                   if (texInfo.randomizedRotation) {
-                    int randomRotation = rand() % 4;
+                    int randomRotation = simulationRand(RandomStream::BLOCKS) % 4;
                     newBlock.rotationAngle = randomRotation * 90;
                 } else {
                     newBlock.rotationAngle = 0;
@@ -448,7 +458,7 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
                 newBlock.hasBeenInitializedForTransformation = false;
                 if (texInfo.hasTransformation && texInfo.transformBlockTimeIntervalEnd > texInfo.transformBlockTimeIntervalStart) {
                     float interval = texInfo.transformBlockTimeIntervalEnd - texInfo.transformBlockTimeIntervalStart;
-                    float randomFactor = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+                    float randomFactor = static_cast<float>(simulationRand(RandomStream::BLOCKS)) / static_cast<float>(RAND_MAX);
                     newBlock.transformationTarget = texInfo.transformBlockTimeIntervalStart + (randomFactor * interval);
                     newBlock.hasBeenInitializedForTransformation = true;
                 } else {
@@ -461,9 +471,8 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
                 newBlock.transformationTarget = -1.0f;
                 newBlock.hasBeenInitializedForTransformation = false;
             }
-              // Add the block and update the position map
-            blocks.push_back(newBlock);
-            blockPositionMap[coords] = blocks.size() - 1;
+              // Add the block to its chunk
+            insertBlock(*getOrCreateChunk(coords.first / CHUNK_SIZE, coords.second / CHUNK_SIZE), coords.first, coords.second) = newBlock;
         }
     }
       // Check for damage blocks for each placed block
@@ -474,10 +483,102 @@ void Map::placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPl
         checkAllEntitiesDamageAtPosition(coords.first, coords.second, name, entitiesManager);
     }
     // DEBUG: Log final state after placing blocks
-    std::cout << "DEBUG: After placeBlocks - blocks vector size: " << blocks.size() << ", blockPositionMap size: " << blockPositionMap.size() << std::endl;
+    GAME_LOG_DEBUG("DEBUG: After placeBlocks - block count: " << totalBlockCount << ", resident chunks: " << residentChunkCount);
+}
+
+template <typename RandomSource>
+void Map::initializeBlockState(Block& block, RandomSource&& nextRandom) const {
+    // Same initialization (and the same random draw order) as placeBlocks uses for new blocks
+    block.transformationTimer = 0.0f;
+    block.hasBeenInitializedForTransformation = false;
+
+    auto texIt = textureDetails.find(block.name);
+    if (texIt == textureDetails.end()) {
+        block.currentFrame = 0.0f;
+        block.rotationAngle = 0;
+        block.transformationTarget = -1.0f;
+        return;
+    }
+
+    const BlockInfo& texInfo = texIt->second;
+    if (texInfo.animType == TextureAnimationType::ANIMATED && texInfo.animationStartRandomFrame && texInfo.frameCount > 0) {
+        block.currentFrame = static_cast<float>(nextRandom()) / (static_cast<float>(RAND_MAX / texInfo.frameCount));
+        if (block.currentFrame >= texInfo.frameCount) {
+            block.currentFrame = static_cast<float>(texInfo.frameCount - 1);
+        }
+    } else {
+        block.currentFrame = 0.0f;
+    }
+
+    if (texInfo.randomizedRotation) {
+        int randomRotation = nextRandom() % 4;
+        block.rotationAngle = randomRotation * 90;
+    } else {
+        block.rotationAngle = 0;
+    }
+
+    if (texInfo.hasTransformation && texInfo.transformBlockTimeIntervalEnd > texInfo.transformBlockTimeIntervalStart) {
+        float interval = texInfo.transformBlockTimeIntervalEnd - texInfo.transformBlockTimeIntervalStart;
+        float randomFactor = static_cast<float>(nextRandom()) / static_cast<float>(RAND_MAX);
+        block.transformationTarget = texInfo.transformBlockTimeIntervalStart + (randomFactor * interval);
+        block.hasBeenInitializedForTransformation = true;
+    } else {
+        block.transformationTarget = -1.0f;
+    }
+}
+
+void Map::placeBlockGrid(const std::vector<BlockName>& grid, int gridWidth, int gridHeight) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    if (gridWidth <= 0 || gridHeight <= 0 || grid.size() < static_cast<size_t>(gridWidth) * gridHeight) {
+        GAME_LOG_ERROR("placeBlockGrid: grid buffer does not match " << gridWidth << "x" << gridHeight);
+        return;
+    }
+
+    setWorldSize(std::max(worldWidth, gridWidth), std::max(worldHeight, gridHeight));
+    auto nextRandom = [] { return simulationRand(RandomStream::BLOCKS); };
+
+    // Walk the cells in the same (x, y) order as the coordinate map used by placeBlocks, so the
+    // BLOCKS random sequence - and therefore every rotation and animation phase - is unchanged.
+    for (int x = 0; x < gridWidth; ++x) {
+        for (int y = 0; y < gridHeight; ++y) {
+            BlockName name = grid[static_cast<size_t>(y) * gridWidth + x];
+
+            if (Block* existing = findBlock(x, y)) {
+                // Block exists - replace it only if the type changes
+                if (existing->name != name) {
+                    auto texIt = textureDetails.find(name);
+                    if (texIt != textureDetails.end() && texIt->second.savePreviousExistingBlock) {
+                        std::lock_guard<std::mutex> lock(savedBlocksMutex);
+                        savedExistingBlocks[{x, y}] = existing->name;
+                    }
+                    existing->name = name;
+                    initializeBlockState(*existing, nextRandom);
+                    markBlockModified(x, y);
+                }
+            } else {
+                Block& block = insertBlock(*getOrCreateChunk(x / CHUNK_SIZE, y / CHUNK_SIZE), x, y);
+                block.name = name;
+                initializeBlockState(block, nextRandom);
+            }
+        }
+    }
+
+    // Check for damage blocks under existing entities (nothing to do on a fresh map)
+    extern EntitiesManager entitiesManager;
+    if (!entitiesManager.getEntities().empty()) {
+        for (int x = 0; x < gridWidth; ++x) {
+            for (int y = 0; y < gridHeight; ++y) {
+                checkAllEntitiesDamageAtPosition(x, y, grid[static_cast<size_t>(y) * gridWidth + x], entitiesManager);
+            }
+        }
+    }
+
+    GAME_LOG_DEBUG("DEBUG: placeBlockGrid loaded " << gridWidth << "x" << gridHeight << " grid - block count: " << totalBlockCount
+              << " in " << residentChunkCount << " chunks");
 }
 
 void Map::placeBlockArea(BlockName name, int x1, int y1, int x2, int y2) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
     int startX = std::min(x1, x2);
     int endX = std::max(x1, x2);
     int startY = std::min(y1, y2);
@@ -495,187 +596,631 @@ void Map::placeBlockArea(BlockName name, int x1, int y1, int x2, int y2) {
     placeBlocks(blocksToPlace);
 }
 
-BlockName Map::getBlockNameByCoordinates(int x, int y) const {
-    // Use the blockPositionMap for direct lookups
-    auto it = blockPositionMap.find({x, y});
-    if (it != blockPositionMap.end()) {
-        size_t blockIndex = it->second;
-        if (blockIndex < blocks.size()) {
-            return blocks[blockIndex].name;
-        } else {
-            std::cerr << "Warning: Block index " << blockIndex << " out of bounds (blocks.size()=" << blocks.size() << ")" << std::endl;
-        }
-    } else {
-        // DEBUG: Log when we return default block instead of actual terrain
-        static int defaultReturnCount = 0;
-        defaultReturnCount++;
-        if (defaultReturnCount <= 10) { // Only log first 10 instances to avoid spam
-            std::cout << "DEBUG: No block found at (" << x << ", " << y << "), returning GRASS_0 default (count: " << defaultReturnCount << ")" << std::endl;
-            std::cout << "DEBUG: blockPositionMap size: " << blockPositionMap.size() << ", blocks size: " << blocks.size() << std::endl;
+void Map::copyBlockGrid(std::vector<BlockName>& grid, int gridWidth, int gridHeight) const {
+    copyBlockGrid(grid, 0, 0, gridWidth, gridHeight);
+}
+
+void Map::copyBlockGrid(std::vector<BlockName>& grid, int originX, int originY, int gridWidth, int gridHeight) const {
+    grid.assign(static_cast<size_t>(std::max(gridWidth, 0)) * std::max(gridHeight, 0), BlockName::GRASS_0);
+    if (gridWidth <= 0 || gridHeight <= 0) return;
+
+    for (int y = 0; y < gridHeight; ++y) {
+        BlockName* row = &grid[static_cast<size_t>(y) * gridWidth];
+        for (int x = 0; x < gridWidth; ++x) {
+            if (const Block* block = findBlock(originX + x, originY + y)) {
+                row[x] = block->name;
+            }
         }
     }
+}
+
+BlockName Map::getBlockNameByCoordinates(int x, int y) const {
+    if (const Block* block = findBlock(x, y)) {
+        return block->name;
+    }
+
+    // DEBUG: Log when we return default block instead of actual terrain
+    static int defaultReturnCount = 0;
+    defaultReturnCount++;
+    if (defaultReturnCount <= 10) { // Only log first 10 instances to avoid spam
+        GAME_LOG_DEBUG("DEBUG: No block found at (" << x << ", " << y << "), returning GRASS_0 default (count: " << defaultReturnCount << ")");
+        GAME_LOG_DEBUG("DEBUG: block count: " << totalBlockCount << ", resident chunks: " << residentChunkCount);
+    }
     
     // If no block is found at these coordinates, return GRASS_0 as default
     // Check if the coordinates are within our grid bounds first
-    if (x < 0 || y < 0 || x >= 70 || y >= 70) {
-        std::cerr << "Warning: Coordinates (" << x << ", " << y << ") are outside the grid bounds" << std::endl;
+    if (x < 0 || y < 0 || x >= worldWidth || y >= worldHeight) {
+        GAME_LOG_WARN("Warning: Coordinates (" << x << ", " << y << ") are outside the grid bounds");
     }    return BlockName::GRASS_0;
 }
 
+bool Map::tryGetBlockName(int x, int y, BlockName& name) const {
+    const Block* block = findBlock(x, y);
+    if (!block) return false;
+    name = block->name;
+    return true;
+}
+
+bool Map::isChunkResident(int chunkX, int chunkY) const {
+    return getChunk(chunkX, chunkY) != nullptr;
+}
+
 void Map::clearBlocks() {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
     // Clear all block-related data structures
-    blocks.clear();
-    blockPositionMap.clear();
-    savedExistingBlocks.clear();
+    for (int i = 0; i < chunkCountX * chunkCountY; ++i) {
+        BlockChunk* chunk = chunkSlots[i].exchange(nullptr, std::memory_order_acq_rel);
+        if (chunk) retireChunk(chunk);
+    }
+    releaseRetiredChunks(false);
+    totalBlockCount = 0;
+    residentChunkCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(savedBlocksMutex);
+        savedExistingBlocks.clear();
+    }
+    residencyVersion.fetch_add(1, std::memory_order_acq_rel);
     
-    std::cout << "DEBUG: Map blocks cleared - blocks size: " << blocks.size() 
-              << ", blockPositionMap size: " << blockPositionMap.size() 
-              << ", savedExistingBlocks size: " << savedExistingBlocks.size() << std::endl;
+    GAME_LOG_DEBUG("DEBUG: Map blocks cleared - block count: " << totalBlockCount 
+              << ", resident chunks: " << residentChunkCount 
+              << ", savedExistingBlocks size: " << savedExistingBlocks.size());
+}
+
+// ---- Chunk storage ----
+
+Map::BlockChunk* Map::getChunk(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkY < 0 || chunkX >= chunkCountX || chunkY >= chunkCountY) {
+        return nullptr;
+    }
+    return chunkSlots[static_cast<size_t>(chunkY) * chunkCountX + chunkX].load(std::memory_order_acquire);
+}
+
+const Map::Block* Map::findBlock(int x, int y) const {
+    if (x < 0 || y < 0 || x >= worldWidth || y >= worldHeight) {
+        return nullptr;
+    }
+    const BlockChunk* chunk = getChunk(x / CHUNK_SIZE, y / CHUNK_SIZE);
+    if (!chunk) return nullptr;
+    int cell = (y % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE);
+    return chunk->occupied[cell] ? &chunk->cells[cell] : nullptr;
+}
+
+Map::Block* Map::findBlock(int x, int y) {
+    return const_cast<Block*>(static_cast<const Map*>(this)->findBlock(x, y));
+}
+
+Map::BlockChunk* Map::getOrCreateChunk(int chunkX, int chunkY) {
+    BlockChunk* chunk = getChunk(chunkX, chunkY);
+    if (chunk) return chunk;
+
+    chunk = new BlockChunk();
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunkSlots[static_cast<size_t>(chunkY) * chunkCountX + chunkX].store(chunk, std::memory_order_release);
+    residentChunkCount++;
+    residencyVersion.fetch_add(1, std::memory_order_acq_rel);
+    return chunk;
+}
+
+Map::Block& Map::insertBlock(BlockChunk& chunk, int x, int y) {
+    int cell = (y % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE);
+    Block& block = chunk.cells[cell];
+    if (!chunk.occupied[cell]) {
+        chunk.occupied.set(cell);
+        chunk.blockCount++;
+        totalBlockCount++;
+    }
+    block = Block();
+    block.x = x;
+    block.y = y;
+    chunk.contentVersion = ++contentVersionCounter;
+    return block;
+}
+
+void Map::markBlockModified(int x, int y) {
+    if (BlockChunk* chunk = getChunk(x / CHUNK_SIZE, y / CHUNK_SIZE)) {
+        chunk->contentVersion = ++contentVersionCounter;
+    }
+}
+
+void Map::setWorldSize(int width, int height) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    width = std::max(width, worldWidth);
+    height = std::max(height, worldHeight);
+    int newChunkCountX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int newChunkCountY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    if (newChunkCountX != chunkCountX || newChunkCountY != chunkCountY) {
+        std::unique_ptr<std::atomic<BlockChunk*>[]> newSlots(new std::atomic<BlockChunk*>[static_cast<size_t>(newChunkCountX) * newChunkCountY]);
+        for (size_t i = 0; i < static_cast<size_t>(newChunkCountX) * newChunkCountY; ++i) {
+            newSlots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        for (int cy = 0; cy < chunkCountY; ++cy) {
+            for (int cx = 0; cx < chunkCountX; ++cx) {
+                newSlots[static_cast<size_t>(cy) * newChunkCountX + cx].store(
+                    chunkSlots[static_cast<size_t>(cy) * chunkCountX + cx].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+        if (chunkSlots) retiredChunkTables.push_back(std::move(chunkSlots));
+        chunkSlots = std::move(newSlots);
+        chunkCountX = newChunkCountX;
+        chunkCountY = newChunkCountY;
+    }
+    worldWidth = width;
+    worldHeight = height;
+}
+
+void Map::loadChunk(int chunkX, int chunkY, const BlockName* cells, unsigned int chunkSeed) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    if (chunkX < 0 || chunkY < 0 || chunkX >= chunkCountX || chunkY >= chunkCountY || getChunk(chunkX, chunkY)) {
+        return;
+    }
+    releaseRetiredChunks(false);
+
+    // Fill the chunk completely before publishing it to readers
+    BlockChunk* chunk = new BlockChunk();
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunk->contentVersion = ++contentVersionCounter;
+    std::mt19937 chunkRng(chunkSeed);
+    auto nextRandom = [&chunkRng] { return static_cast<int>(chunkRng() % (static_cast<unsigned int>(RAND_MAX) + 1u)); };
+
+    for (int localY = 0; localY < CHUNK_SIZE; ++localY) {
+        int y = chunkY * CHUNK_SIZE + localY;
+        if (y >= worldHeight) break;
+        for (int localX = 0; localX < CHUNK_SIZE; ++localX) {
+            int x = chunkX * CHUNK_SIZE + localX;
+            if (x >= worldWidth) break;
+            int cell = localY * CHUNK_SIZE + localX;
+            Block& block = chunk->cells[cell];
+            block.name = cells[cell];
+            block.x = x;
+            block.y = y;
+            initializeBlockState(block, nextRandom);
+            chunk->occupied.set(cell);
+            chunk->blockCount++;
+        }
+    }
+
+    chunkSlots[static_cast<size_t>(chunkY) * chunkCountX + chunkX].store(chunk, std::memory_order_release);
+    totalBlockCount += chunk->blockCount;
+    residentChunkCount++;
+    residencyVersion.fetch_add(1, std::memory_order_acq_rel);
 }
 
-void Map::drawBlocks(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop, double deltaTime) {
+bool Map::unloadChunk(int chunkX, int chunkY, BlockName* cellsOut) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    BlockChunk* chunk = getChunk(chunkX, chunkY);
+    if (!chunk) return false;
+
+    for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+        cellsOut[cell] = chunk->occupied[cell] ? chunk->cells[cell].name : BlockName::GRASS_0;
+    }
+
+    chunkSlots[static_cast<size_t>(chunkY) * chunkCountX + chunkX].store(nullptr, std::memory_order_release);
+    totalBlockCount -= chunk->blockCount;
+    residentChunkCount--;
+    residencyVersion.fetch_add(1, std::memory_order_acq_rel);
+    retireChunk(chunk);
+    releaseRetiredChunks(false);
+    return true;
+}
+
+unsigned int Map::getChunkContentVersion(int chunkX, int chunkY) const {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    BlockChunk* chunk = getChunk(chunkX, chunkY);
+    return chunk ? chunk->contentVersion : 0;
+}
+
+bool Map::exportChunkImage(int chunkX, int chunkY, ChunkImage& image) const {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    BlockChunk* chunk = getChunk(chunkX, chunkY);
+    if (!chunk) return false;
+
+    image.chunkX = chunkX;
+    image.chunkY = chunkY;
+    image.blockCount = chunk->blockCount;
+    image.contentVersion = chunk->contentVersion;
+    image.flags = 0;
+    for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+        if (chunk->occupied[cell]) {
+            image.names[cell] = static_cast<int32_t>(chunk->cells[cell].name);
+            image.rotations[cell] = static_cast<uint8_t>((chunk->cells[cell].rotationAngle / 90) & 3);
+        } else {
+            image.names[cell] = CHUNK_IMAGE_NO_BLOCK;
+            image.rotations[cell] = 0;
+        }
+    }
+    return true;
+}
+
+void Map::importChunkImage(const ChunkImage& image, unsigned int chunkSeed) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    const int chunkX = image.chunkX;
+    const int chunkY = image.chunkY;
+    // The world must already be large enough (setWorldSize) - chunks outside it are ignored
+    if (chunkX < 0 || chunkY < 0 || chunkX >= chunkCountX || chunkY >= chunkCountY) return;
+
+    // Drop whatever is there now, then build the chunk completely before publishing it
+    BlockName unused[CHUNK_CELL_COUNT];
+    unloadChunk(chunkX, chunkY, unused);
+
+    BlockChunk* chunk = new BlockChunk();
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunk->contentVersion = ++contentVersionCounter;
+    std::mt19937 chunkRng(chunkSeed);
+    auto nextRandom = [&chunkRng] { return static_cast<int>(chunkRng() % (static_cast<unsigned int>(RAND_MAX) + 1u)); };
+
+    for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+        if (image.names[cell] == CHUNK_IMAGE_NO_BLOCK) continue;
+        Block& block = chunk->cells[cell];
+        block.name = static_cast<BlockName>(image.names[cell]);
+        block.x = chunkX * CHUNK_SIZE + cell % CHUNK_SIZE;
+        block.y = chunkY * CHUNK_SIZE + cell / CHUNK_SIZE;
+        initializeBlockState(block, nextRandom);
+        if (!(image.flags & CHUNK_IMAGE_ROTATIONS_FROM_SEED)) {
+            block.rotationAngle = (image.rotations[cell] & 3) * 90;
+        }
+        chunk->occupied.set(cell);
+        chunk->blockCount++;
+    }
+
+    chunkSlots[static_cast<size_t>(chunkY) * chunkCountX + chunkX].store(chunk, std::memory_order_release);
+    totalBlockCount += chunk->blockCount;
+    residentChunkCount++;
+    residencyVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void Map::exportBlockTimers(std::vector<BlockTimerState>& timers) const {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    timers.clear();
+    for (int chunkIndex = 0; chunkIndex < chunkCountX * chunkCountY; ++chunkIndex) {
+        BlockChunk* chunk = chunkSlots[chunkIndex].load(std::memory_order_acquire);
+        if (!chunk) continue;
+        for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+            if (!chunk->occupied[cell]) continue;
+            const Block& block = chunk->cells[cell];
+            if (block.hasBeenInitializedForTransformation && block.transformationTarget >= 0.0f) {
+                timers.push_back({block.x, block.y, block.transformationTimer, block.transformationTarget});
+            }
+        }
+    }
+}
+
+void Map::importBlockTimers(const BlockTimerState* timers, size_t count) {
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    for (size_t i = 0; i < count; ++i) {
+        if (Block* block = findBlock(timers[i].x, timers[i].y)) {
+            block->transformationTimer = timers[i].timer;
+            block->transformationTarget = timers[i].target;
+            block->hasBeenInitializedForTransformation = timers[i].target >= 0.0f;
+        }
+    }
+}
+
+void Map::retireChunk(BlockChunk* chunk) {
+    retiredChunks.push_back({chunk, retireReadEpoch()});
+}
+
+void Map::releaseRetiredChunks(bool releaseAll) {
+    if (retiredChunks.empty() && !releaseAll) return;
+    const uint64_t oldestReader = releaseAll ? std::numeric_limits<uint64_t>::max() : oldestActiveReadEpoch();
+    size_t kept = 0;
+    for (auto& retired : retiredChunks) {
+        if (retired.second < oldestReader) {
+            delete retired.first;
+        } else {
+            retiredChunks[kept++] = retired;
+        }
+    }
+    retiredChunks.resize(kept);
+    if (releaseAll) retiredChunkTables.clear();
+}
+
+void Map::collectBlockQuads(const VisibleSet& visible, double deltaTime, std::vector<BlockQuad>& quads) {
+    float startX = visible.startX;
+    float endX = visible.endX;
+    float startY = visible.startY;
+    float endY = visible.endY;
+    float cameraLeft = visible.camera.left;
+    float cameraBottom = visible.camera.bottom;
+
     // Calculate cell dimensions in screen coordinates
-    float viewWidth = cameraRight - cameraLeft;
-    float viewHeight = cameraTop - cameraBottom;
+    float viewWidth = visible.camera.getWidth();
+    float viewHeight = visible.camera.getHeight();
     float cellWidth = (endX - startX) / viewWidth;
     float cellHeight = (endY - startY) / viewHeight;
 
-    glUseProgram(0); 
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    quads.clear();
+    advanceBlockAnimations(deltaTime);
 
-    // Only process blocks that are within or partially within the camera view
-    for (auto& block : blocks) { // Iterate by reference to potentially modify block state if needed in future
-        // Skip blocks that are outside the camera view
-        if (block.x < cameraLeft - 1 || block.x > cameraRight + 1 || 
-            block.y < cameraBottom - 1 || block.y > cameraTop + 1) {
-            continue;
-        }
-        auto it = textureDetails.find(block.name);
-        if (it == textureDetails.end()) {
-            std::cerr << "Texture details not found for block type " << static_cast<int>(block.name) << std::endl;
-            continue;
-        }        const BlockInfo& texInfo = it->second; // New: Read-only for shared info
-        Block& currentBlock = block; // Get reference to the current block instance
-        
-        // Convert block world coordinates to screen coordinates based on the camera view
-        float worldX = currentBlock.x;
-        float worldY = currentBlock.y;
+    // Only visit the resident chunks that overlap the camera view
+    int firstChunkX = std::max(0, visible.firstChunkX);
+    int lastChunkX = std::min(chunkCountX - 1, visible.lastChunkX);
+    int firstChunkY = std::max(0, visible.firstChunkY);
+    int lastChunkY = std::min(chunkCountY - 1, visible.lastChunkY);
+
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            BlockChunk* chunk = getChunk(chunkX, chunkY);
+            if (!chunk) continue;
+            // Only the cells of the chunk under the view, in storage (row-major) order
+            int firstLocalX = std::max(0, visible.firstBlockX - chunkX * CHUNK_SIZE);
+            int lastLocalX = std::min(CHUNK_SIZE - 1, visible.lastBlockX - chunkX * CHUNK_SIZE);
+            int firstLocalY = std::max(0, visible.firstBlockY - chunkY * CHUNK_SIZE);
+            int lastLocalY = std::min(CHUNK_SIZE - 1, visible.lastBlockY - chunkY * CHUNK_SIZE);
+            for (int localY = firstLocalY; localY <= lastLocalY; ++localY) {
+                for (int cell = localY * CHUNK_SIZE + firstLocalX; cell <= localY * CHUNK_SIZE + lastLocalX; ++cell) {
+                    if (!chunk->occupied[cell]) continue;
+                    Block& block = chunk->cells[cell];
+                    auto it = textureDetails.find(block.name);
+                    if (it == textureDetails.end()) {
+                        GAME_LOG_ERROR("Texture details not found for block type " << static_cast<int>(block.name));
+                        continue;
+                    }        const BlockInfo& texInfo = it->second; // New: Read-only for shared info
+                    Block& currentBlock = block; // Get reference to the current block instance
         
-        // Calculate position in screen space (normalized to [0,1] within the camera view)
-        float normalizedX = (worldX - cameraLeft) / viewWidth;
-        float normalizedY = (worldY - cameraBottom) / viewHeight;
+                    // Convert block world coordinates to screen coordinates based on the camera view
+                    float worldX = currentBlock.x;
+                    float worldY = currentBlock.y;
         
-        // Map from normalized [0,1] to screen coordinates
-        float x = startX + normalizedX * (endX - startX);
-        float y = startY + normalizedY * (endY - startY);
+                    // Calculate position in screen space (normalized to [0,1] within the camera view)
+                    float normalizedX = (worldX - cameraLeft) / viewWidth;
+                    float normalizedY = (worldY - cameraBottom) / viewHeight;
         
-        glBindTexture(GL_TEXTURE_2D, texInfo.textureID);
+                    BlockQuad quad;
+                    quad.textureID = texInfo.textureID;
+                    // Map from normalized [0,1] to screen coordinates
+                    quad.x = startX + normalizedX * (endX - startX);
+                    quad.y = startY + normalizedY * (endY - startY);
+                    quad.width = cellWidth;
+                    quad.height = cellHeight;
         
-        float texCoordYStart = 0.0f;
-        float texCoordYEnd = 1.0f;
+                    float texCoordYStart = 0.0f;
+                    float texCoordYEnd = 1.0f;
+
+                    if (texInfo.animType == TextureAnimationType::ANIMATED && texInfo.frameCount > 0) {
+                        // The block's phase offset plus the phase of its type (same frame as tile_animated.vert)
+                        int frame = tileAnimationFrame(currentBlock.currentFrame, tileTypes[static_cast<size_t>(currentBlock.name)].wrappedPhase, texInfo.frameCount);
+            
+                        float frameTexHeight = 1.0f / texInfo.frameCount;
+                        texCoordYStart = frame * frameTexHeight;
+                        texCoordYEnd = texCoordYStart + frameTexHeight;
+                    }
+
+                    // Define texture coordinates based on rotation
+                    float* tc = quad.texCoords; // 8 texture coordinates (x1,y1, x2,y2, x3,y3, x4,y4)
+
+                    // Default: 0 degrees rotation (Bottom-left, Bottom-right, Top-right, Top-left)
+                    tc[0] = 0.0f; tc[1] = texCoordYStart; 
+                    tc[2] = 1.0f; tc[3] = texCoordYStart; 
+                    tc[4] = 1.0f; tc[5] = texCoordYEnd;   
+                    tc[6] = 0.0f; tc[7] = texCoordYEnd;   
+
+                    if (currentBlock.rotationAngle == 90) {
+                        // Rotated 90 deg: (Top-left, Bottom-left, Bottom-right, Top-right)
+                        tc[0] = 0.0f; tc[1] = texCoordYEnd;   
+                        tc[2] = 0.0f; tc[3] = texCoordYStart; 
+                        tc[4] = 1.0f; tc[5] = texCoordYStart; 
+                        tc[6] = 1.0f; tc[7] = texCoordYEnd;   
+                    } else if (currentBlock.rotationAngle == 180) {
+                        // Rotated 180 deg: (Top-right, Top-left, Bottom-left, Bottom-right)
+                        tc[0] = 1.0f; tc[1] = texCoordYEnd;   
+                        tc[2] = 0.0f; tc[3] = texCoordYEnd;   
+                        tc[4] = 0.0f; tc[5] = texCoordYStart; 
+                        tc[6] = 1.0f; tc[7] = texCoordYStart; 
+                    } else if (currentBlock.rotationAngle == 270) {
+                        // Rotated 270 deg: (Bottom-right, Top-right, Top-left, Bottom-left)
+                        tc[0] = 1.0f; tc[1] = texCoordYStart; 
+                        tc[2] = 1.0f; tc[3] = texCoordYEnd;   
+                        tc[4] = 0.0f; tc[5] = texCoordYEnd;   
+                        tc[6] = 0.0f; tc[7] = texCoordYStart; 
+                    }
+                    quads.push_back(quad);
+                }
+            }
+        }
+    }
+}
 
+void Map::advanceBlockAnimations(double deltaTime) {
+    animationClock += deltaTime;
+
+    if (tileTypes.empty() && !textureDetails.empty()) {
+        tileTypes.resize(static_cast<size_t>(textureDetails.rbegin()->first) + 1);
+    }
+    for (const auto& pair : textureDetails) {
+        const BlockInfo& texInfo = pair.second;
+        TileTypeAnimation& type = tileTypes[static_cast<size_t>(pair.first)];
+        type.known = true;
+        type.textureID = texInfo.textureID;
         if (texInfo.animType == TextureAnimationType::ANIMATED && texInfo.frameCount > 0) {
-            // Use and update the block's individual currentFrame
-            currentBlock.currentFrame += static_cast<float>(deltaTime) * texInfo.animationSpeed;
-            if (currentBlock.currentFrame >= texInfo.frameCount) {
-                currentBlock.currentFrame = fmod(currentBlock.currentFrame, static_cast<float>(texInfo.frameCount));
+            // Wrapped in double: the clock keeps its precision however long the game runs
+            type.frameCount = static_cast<float>(texInfo.frameCount);
+            type.frameRatio = 1.0f / texInfo.frameCount;
+            type.wrappedPhase = static_cast<float>(std::fmod(animationClock * texInfo.animationSpeed, static_cast<double>(texInfo.frameCount)));
+        } else {
+            type.frameCount = 1.0f;
+            type.frameRatio = 1.0f;
+            type.wrappedPhase = 0.0f;
+        }
+    }
+}
+
+void Map::buildChunkTiles(const BlockChunk& chunk, std::vector<TileInstance>& tiles, std::vector<TileRun>& runs) const {
+    tiles.clear();
+    runs.clear();
+
+    // Counting sort by block type: one run (one draw call) per type present in the chunk
+    std::vector<size_t> typeCounts(tileTypes.size(), 0);
+    for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+        if (!chunk.occupied[cell]) continue;
+        size_t typeIndex = static_cast<size_t>(chunk.cells[cell].name);
+        if (typeIndex < tileTypes.size() && tileTypes[typeIndex].known) {
+            typeCounts[typeIndex]++;
+        }
+    }
+    std::vector<size_t> typeStarts(tileTypes.size(), 0);
+    size_t tileCount = 0;
+    for (size_t typeIndex = 0; typeIndex < tileTypes.size(); ++typeIndex) {
+        typeStarts[typeIndex] = tileCount;
+        if (typeCounts[typeIndex] > 0) {
+            runs.push_back(TileRun{static_cast<int>(typeIndex), tileCount, typeCounts[typeIndex]});
+            tileCount += typeCounts[typeIndex];
+        }
+    }
+
+    tiles.resize(tileCount);
+    for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+        if (!chunk.occupied[cell]) continue;
+        const Block& block = chunk.cells[cell];
+        size_t typeIndex = static_cast<size_t>(block.name);
+        if (typeIndex >= tileTypes.size() || !tileTypes[typeIndex].known) continue;
+        TileInstance& tile = tiles[typeStarts[typeIndex]++];
+        tile.x = static_cast<float>(block.x);
+        tile.y = static_cast<float>(block.y);
+        tile.phaseOffset = block.currentFrame;
+        tile.rotation = static_cast<uint32_t>((block.rotationAngle / 90) & 3);
+    }
+}
+
+void Map::recordBlockTiles(const VisibleSet& visible) {
+    // Same chunk range as collectBlockQuads; the per-block cull happens in the vertex shader
+    int firstChunkX = std::max(0, visible.firstChunkX);
+    int lastChunkX = std::min(chunkCountX - 1, visible.lastChunkX);
+    int firstChunkY = std::max(0, visible.firstChunkY);
+    int lastChunkY = std::min(chunkCountY - 1, visible.lastChunkY);
+
+    tileView = TileView{visible.startX, visible.endX, visible.startY, visible.endY,
+                        visible.camera.left, visible.camera.right, visible.camera.bottom, visible.camera.top};
+    tileUploadCount = 0;
+    tileDrawChunks.clear();
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            BlockChunk* chunk = getChunk(chunkX, chunkY);
+            if (!chunk) continue;
+            // Rebuilt only when a block of the chunk changed or the chunk was (re)loaded
+            unsigned int contentVersion = chunk->contentVersion;
+            if (!tileRenderer.hasChunk(chunkX, chunkY, contentVersion)) {
+                if (tileUploadCount == tileUploads.size()) {
+                    tileUploads.emplace_back();
+                }
+                ChunkTileUpload& upload = tileUploads[tileUploadCount++];
+                upload.chunkX = chunkX;
+                upload.chunkY = chunkY;
+                upload.contentVersion = contentVersion;
+                buildChunkTiles(*chunk, upload.tiles, upload.runs);
             }
-            
-            float frameTexHeight = 1.0f / texInfo.frameCount;
-            // Use the block's currentFrame for texture coordinates
-            texCoordYStart = (static_cast<int>(currentBlock.currentFrame)) * frameTexHeight;
-            texCoordYEnd = texCoordYStart + frameTexHeight;
+            tileDrawChunks.emplace_back(chunkX, chunkY);
         }
+    }
+}
+
+void Map::recordBlocks(const VisibleSet& visible, double deltaTime) {
+    recordedTiles = USE_GPU_TILES && tileRenderer.isReady();
+    if (recordedTiles) {
+        drawQuads.clear();
+        advanceBlockAnimations(deltaTime);
+        recordBlockTiles(visible);
+        return;
+    }
+    collectBlockQuads(visible, deltaTime, drawQuads);
+}
 
-        // Define texture coordinates based on rotation
-        float tc[8]; // Array to hold 8 texture coordinates (x1,y1, x2,y2, x3,y3, x4,y4)
-
-        // Default: 0 degrees rotation (Bottom-left, Bottom-right, Top-right, Top-left)
-        tc[0] = 0.0f; tc[1] = texCoordYStart; 
-        tc[2] = 1.0f; tc[3] = texCoordYStart; 
-        tc[4] = 1.0f; tc[5] = texCoordYEnd;   
-        tc[6] = 0.0f; tc[7] = texCoordYEnd;   
-
-        if (currentBlock.rotationAngle == 90) {
-            // Rotated 90 deg: (Top-left, Bottom-left, Bottom-right, Top-right)
-            tc[0] = 0.0f; tc[1] = texCoordYEnd;   
-            tc[2] = 0.0f; tc[3] = texCoordYStart; 
-            tc[4] = 1.0f; tc[5] = texCoordYStart; 
-            tc[6] = 1.0f; tc[7] = texCoordYEnd;   
-        } else if (currentBlock.rotationAngle == 180) {
-            // Rotated 180 deg: (Top-right, Top-left, Bottom-left, Bottom-right)
-            tc[0] = 1.0f; tc[1] = texCoordYEnd;   
-            tc[2] = 0.0f; tc[3] = texCoordYEnd;   
-            tc[4] = 0.0f; tc[5] = texCoordYStart; 
-            tc[6] = 1.0f; tc[7] = texCoordYStart; 
-        } else if (currentBlock.rotationAngle == 270) {
-            // Rotated 270 deg: (Bottom-right, Top-right, Top-left, Bottom-left)
-            tc[0] = 1.0f; tc[1] = texCoordYStart; 
-            tc[2] = 1.0f; tc[3] = texCoordYEnd;   
-            tc[4] = 0.0f; tc[5] = texCoordYEnd;   
-            tc[6] = 0.0f; tc[7] = texCoordYStart; 
+void Map::submitBlocks() {
+    if (recordedTiles) {
+        tileRenderer.beginFrame(tileView);
+        for (size_t index = 0; index < tileUploadCount; ++index) {
+            const ChunkTileUpload& upload = tileUploads[index];
+            tileRenderer.uploadChunk(upload.chunkX, upload.chunkY, upload.contentVersion, upload.tiles, upload.runs);
+        }
+        for (const auto& chunk : tileDrawChunks) {
+            tileRenderer.drawChunk(chunk.first, chunk.second, tileTypes);
         }
+        tileRenderer.endFrame();
+        return;
+    }
 
+    glUseProgram(0); 
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+    for (const BlockQuad& quad : drawQuads) {
+        const float* tc = quad.texCoords;
+        glBindTexture(GL_TEXTURE_2D, quad.textureID);
         glBegin(GL_QUADS);
-        glTexCoord2f(tc[0], tc[1]); glVertex2f(x, y);                            
-        glTexCoord2f(tc[2], tc[3]); glVertex2f(x + cellWidth, y);                
-        glTexCoord2f(tc[4], tc[5]); glVertex2f(x + cellWidth, y + cellHeight);    
-        glTexCoord2f(tc[6], tc[7]); glVertex2f(x, y + cellHeight);                
+        glTexCoord2f(tc[0], tc[1]); glVertex2f(quad.x, quad.y);                            
+        glTexCoord2f(tc[2], tc[3]); glVertex2f(quad.x + quad.width, quad.y);                
+        glTexCoord2f(tc[4], tc[5]); glVertex2f(quad.x + quad.width, quad.y + quad.height);    
+        glTexCoord2f(tc[6], tc[7]); glVertex2f(quad.x, quad.y + quad.height);                
         glEnd();
     }
     
     glDisable(GL_TEXTURE_2D);
 }
 
+void Map::drawBlocks(const VisibleSet& visible, double deltaTime) {
+    recordBlocks(visible, deltaTime);
+    submitBlocks();
+}
+
 void Map::updateBlockTransformations(double deltaTime) {
-    for (size_t i = 0; i < blocks.size(); ++i) {
-        Block& block = blocks[i];
+    std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+    for (int chunkIndex = 0; chunkIndex < chunkCountX * chunkCountY; ++chunkIndex) {
+        BlockChunk* chunk = chunkSlots[chunkIndex].load(std::memory_order_acquire);
+        if (!chunk) continue;
+        for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+            if (!chunk->occupied[cell]) continue;
+            Block& block = chunk->cells[cell];
         
-        // Skip blocks that don't have transformation enabled
-        if (block.transformationTarget < 0.0f) {
-            continue;
-        }
+            // Skip blocks that don't have transformation enabled
+            if (block.transformationTarget < 0.0f) {
+                continue;
+            }
         
-        // Update the transformation timer
-        block.transformationTimer += static_cast<float>(deltaTime);
-          // Check if it's time to transform this block
-        if (block.hasBeenInitializedForTransformation && block.transformationTimer >= block.transformationTarget) {
-            // Get the texture info for the current block to find transformation target
-            auto it = textureDetails.find(block.name);
-            if (it != textureDetails.end() && it->second.hasTransformation) {
-                const BlockInfo& currentTexInfo = it->second;
-                BlockName newBlockType;
+            // Update the transformation timer
+            block.transformationTimer += static_cast<float>(deltaTime);
+              // Check if it's time to transform this block
+            if (block.hasBeenInitializedForTransformation && block.transformationTimer >= block.transformationTarget) {
+                // Get the texture info for the current block to find transformation target
+                auto it = textureDetails.find(block.name);
+                if (it != textureDetails.end() && it->second.hasTransformation) {
+                    const BlockInfo& currentTexInfo = it->second;
+                    BlockName newBlockType;
                 
-                // Check if we should transform to previous existing block
-                if (currentTexInfo.transformBlockToPreviousExistingBlock) {
-                    // Look for saved previous block at these coordinates
-                    auto savedBlockIt = savedExistingBlocks.find({block.x, block.y});
-                    if (savedBlockIt != savedExistingBlocks.end()) {
-                        newBlockType = savedBlockIt->second;
-                        // Remove the saved block since we're using it
-                        savedExistingBlocks.erase(savedBlockIt);
-                        std::cout << "Transforming block at (" << block.x << ", " << block.y << ") from " 
-                                  << static_cast<int>(block.name) << " to previous existing block " << static_cast<int>(newBlockType) << std::endl;
+                    // Check if we should transform to previous existing block
+                    if (currentTexInfo.transformBlockToPreviousExistingBlock) {
+                        // Look for saved previous block at these coordinates
+                        std::unique_lock<std::mutex> savedBlocksLock(savedBlocksMutex);
+                        auto savedBlockIt = savedExistingBlocks.find({block.x, block.y});
+                        if (savedBlockIt != savedExistingBlocks.end()) {
+                            newBlockType = savedBlockIt->second;
+                            // Remove the saved block since we're using it
+                            savedExistingBlocks.erase(savedBlockIt);
+                            savedBlocksLock.unlock();
+                            GAME_LOG_INFO("Transforming block at (" << block.x << ", " << block.y << ") from " 
+                                      << static_cast<int>(block.name) << " to previous existing block " << static_cast<int>(newBlockType));
+                        } else {
+                            // No saved block found, fallback to regular transformation
+                            newBlockType = currentTexInfo.transformBlockTo;
+                            GAME_LOG_INFO("No saved block found at (" << block.x << ", " << block.y << "), using fallback transformation from " 
+                                      << static_cast<int>(block.name) << " to " << static_cast<int>(newBlockType));
+                        }
                     } else {
-                        // No saved block found, fallback to regular transformation
+                        // Regular transformation
                         newBlockType = currentTexInfo.transformBlockTo;
-                        std::cout << "No saved block found at (" << block.x << ", " << block.y << "), using fallback transformation from " 
-                                  << static_cast<int>(block.name) << " to " << static_cast<int>(newBlockType) << std::endl;
+                        GAME_LOG_INFO("Transforming block at (" << block.x << ", " << block.y << ") from " 
+                                  << static_cast<int>(block.name) << " to " << static_cast<int>(newBlockType));
                     }
-                } else {
-                    // Regular transformation
-                    newBlockType = currentTexInfo.transformBlockTo;
-                    std::cout << "Transforming block at (" << block.x << ", " << block.y << ") from " 
-                              << static_cast<int>(block.name) << " to " << static_cast<int>(newBlockType) << std::endl;
-                }
                 
-                // Place the new block type at the same coordinates (this will replace the existing block)
-                placeBlock(newBlockType, block.x, block.y);
+                    // Place the new block type at the same coordinates (this will replace the existing block)
+                    placeBlock(newBlockType, block.x, block.y);
                 
-                // Note: placeBlock will handle all the initialization of the new block,
-                // including setting up new transformation parameters if the new block type also has transformations
+                    // Note: placeBlock will handle all the initialization of the new block,
+                    // including setting up new transformation parameters if the new block type also has transformations
+                }
             }
         }
     }
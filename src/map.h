@@ -10,8 +10,14 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <atomic>
+#include <mutex>
+#include <bitset>
+#include <memory>
+#include <cstdint>
 #include <stdexcept> // For std::runtime_error
 #include "enumDefinitions.h"
+#include "tileRenderer.h"
 
 
 // Forward declaration of the GLBI_Engine class
@@ -52,6 +58,46 @@ struct BlockInfo {
     bool transformBlockToPreviousExistingBlock = false; // Flag to transform to the saved previous block
 };
 
+// Blocks are stored in square chunks of CHUNK_SIZE x CHUNK_SIZE cells. A chunk is either
+// resident (all its blocks readable) or absent (not generated yet, or evicted by the streamer).
+const int CHUNK_SIZE = 32;
+const int CHUNK_CELL_COUNT = CHUNK_SIZE * CHUNK_SIZE;
+
+// Fixed-size image of one chunk's blocks - the unit of world saves (see worldSave.h). Plain data
+// with no pointers, so a saved chunk can be installed straight from a memory-mapped save file.
+const int32_t CHUNK_IMAGE_NO_BLOCK = -1;
+const uint32_t CHUNK_IMAGE_ROTATIONS_FROM_SEED = 1u; // rotations[] is not set, derive it from the chunk seed
+struct ChunkImage {
+    int32_t chunkX;
+    int32_t chunkY;
+    int32_t blockCount;
+    uint32_t contentVersion;              // Map::getChunkContentVersion when the image was taken
+    uint32_t flags;                       // CHUNK_IMAGE_* flags
+    int32_t names[CHUNK_CELL_COUNT];      // BlockName values, CHUNK_IMAGE_NO_BLOCK for empty cells
+    uint8_t rotations[CHUNK_CELL_COUNT];  // rotationAngle / 90
+};
+
+// Transformation timer of one block (ICE melting etc.)
+struct BlockTimerState {
+    int32_t x;
+    int32_t y;
+    float timer;
+    float target;
+};
+
+class VisibleSet;
+
+// One textured block quad in screen coordinates, as drawBlocks submits it
+struct BlockQuad {
+    GLuint textureID;
+    float x, y;              // Bottom-left corner
+    float width, height;
+    float texCoords[8];      // Bottom-left, bottom-right, top-right, top-left (after rotation)
+};
+
+// Writers: block placement runs on the main thread (input, streaming, world generation) and the
+// block transformations on the logic tick, so every mutation takes the map's write lock and is
+// applied as a whole. Readers stay lock-free (see "Chunk-aware access").
 class Map {
 public:
     Map();
@@ -64,24 +110,123 @@ public:
     void placeBlock(BlockName name, int x, int y);
 
     // Place multiple blocks based on a map of coordinates to BlockNames
-    void placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPlace);    // Place a texture on all blocks in a rectangular area using its BlockName
+    void placeBlocks(const std::map<std::pair<int, int>, BlockName>& blocksToPlace);
+
+    // Bulk-load a flat row-major grid of blocks (index = y * gridWidth + x) covering [0, gridWidth) x [0, gridHeight).
+    // Produces the same map state as placeBlocks on the equivalent coordinate map, without building one.
+    void placeBlockGrid(const std::vector<BlockName>& grid, int gridWidth, int gridHeight);
+    // Place a texture on all blocks in a rectangular area using its BlockName
     void placeBlockArea(BlockName name, int x1, int y1, int x2, int y2);    // Draw all blocks, deltaTime for animations
-    void drawBlocks(float startX, float endX, float startY, float endY, float cameraLeft, float cameraRight, float cameraBottom, float cameraTop, double deltaTime);
+    // (the block cells of the frame's visible set only)
+    void drawBlocks(const VisibleSet& visible, double deltaTime);
+    // drawBlocks in two halves (renderCommands.h): recordBlocks does all the CPU work and keeps
+    // the result (block quads, or the tile streams to upload and the chunks to draw) without
+    // touching OpenGL, so it can run on a render worker; submitBlocks draws it on the GL thread
+    void recordBlocks(const VisibleSet& visible, double deltaTime);
+    void submitBlocks();
+    // The quads drawBlocks submits without the tile renderer, without touching OpenGL (also
+    // advances the block animation clock by deltaTime)
+    void collectBlockQuads(const VisibleSet& visible, double deltaTime, std::vector<BlockQuad>& quads);
 
-    // Update block transformations
+    // Update block transformations (logic tick)
     void updateBlockTransformations(double deltaTime);
 
     // Public method to get a loaded texture ID by its type
     GLuint getTexture(BlockName type) const;
       // Get the texture name at the specified grid coordinates
     BlockName getBlockNameByCoordinates(int x, int y) const;
+
+    // Snapshot [0, gridWidth) x [0, gridHeight) into a flat row-major buffer (index = y * gridWidth + x)
+    // in one ordered pass; cells without a block read as GRASS_0, like getBlockNameByCoordinates
+    void copyBlockGrid(std::vector<BlockName>& grid, int gridWidth, int gridHeight) const;
+    // Same for the area starting at (originX, originY)
+    void copyBlockGrid(std::vector<BlockName>& grid, int originX, int originY, int gridWidth, int gridHeight) const;
     
-    // Clear all blocks and related data structures
+    // Clear all blocks and related data structures. The chunks are retired like unloaded ones
+    // (freed once no reader can hold them), so this is safe during gameplay (V key regeneration).
     void clearBlocks();
-    
+    // Free every retired chunk now. Only while no other thread reads the map (between gameplay
+    // sessions, before the threads start).
+    void releaseAllRetiredChunks() {
+        std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+        releaseRetiredChunks(true);
+    }
+
+    // ---- Chunk-aware access (safe to call from any thread) ----
+
+    // World size in blocks covered by the chunk table
+    int getWorldWidth() const { return worldWidth; }
+    int getWorldHeight() const { return worldHeight; }
+
+    // Read the block at (x, y). Returns false when the cell is outside the world or its chunk
+    // is not resident - collision and pathfinding treat that as blocked.
+    bool tryGetBlockName(int x, int y, BlockName& name) const;
+    bool isChunkResident(int chunkX, int chunkY) const;
+
+    // Bumped every time a chunk is loaded or unloaded, so caches built from the map can tell
+    // when the resident area changed
+    unsigned int getResidencyVersion() const { return residencyVersion.load(std::memory_order_acquire); }
+
+    // ---- Chunk residency (main thread, under the write lock like every other map mutation) ----
+
+    // Grow the world to at least width x height blocks. Only call this before other threads
+    // start reading the map (the chunk table is reallocated).
+    void setWorldSize(int width, int height);
+
+    // Install a chunk from CHUNK_CELL_COUNT row-major block names (cells outside the world are
+    // ignored). Per-block animation and rotation come from chunkSeed, so the result does not
+    // depend on the order in which chunks arrive.
+    void loadChunk(int chunkX, int chunkY, const BlockName* cells, unsigned int chunkSeed);
+
+    // Remove a resident chunk, copying its current block names (including player changes)
+    // into cellsOut. Returns false if the chunk was not resident.
+    bool unloadChunk(int chunkX, int chunkY, BlockName* cellsOut);
+
+    // ---- World save support (main thread) ----
+
+    // Hold the write lock across several calls, so no mutation lands in between (the world save
+    // captures the chunks, the block timers and the ICE memory as one state). Recursive: the
+    // mutators and exports below can be called while holding it.
+    std::unique_lock<std::recursive_mutex> lockWrites() const { return std::unique_lock<std::recursive_mutex>(writeMutex); }
+
+    // Bumped whenever a block of the chunk changes type; 0 if the chunk is not resident.
+    // Lets the world saver only rewrite chunks that changed since the last save.
+    unsigned int getChunkContentVersion(int chunkX, int chunkY) const;
+    int getChunkCountX() const { return chunkCountX; }
+    int getChunkCountY() const { return chunkCountY; }
+
+    // Copy a resident chunk into image. Returns false if the chunk is not resident.
+    bool exportChunkImage(int chunkX, int chunkY, ChunkImage& image) const;
+    // Replace the chunk with the content of image (animation frames restart from the chunk seed).
+    // The world must already cover the chunk (setWorldSize).
+    void importChunkImage(const ChunkImage& image, unsigned int chunkSeed);
+
+    // Transformation timers of every block that is counting down to a transformation
+    void exportBlockTimers(std::vector<BlockTimerState>& timers) const;
+    void importBlockTimers(const BlockTimerState* timers, size_t count);
+
+    // Blocks remembered under ICE so they can be restored when it melts (copied: ICE is placed from
+    // the input callbacks while it melts in the logic tick)
+    std::map<std::pair<int, int>, BlockName> getSavedExistingBlocks() const {
+        std::lock_guard<std::mutex> lock(savedBlocksMutex);
+        return savedExistingBlocks;
+    }
+    void setSavedExistingBlocks(const std::map<std::pair<int, int>, BlockName>& blocks) {
+        std::lock_guard<std::mutex> lock(savedBlocksMutex);
+        savedExistingBlocks = blocks;
+    }
+
     // Debug methods to access internal map state
-    size_t getBlockPositionMapSize() const { return blockPositionMap.size(); }
-    size_t getBlocksVectorSize() const { return blocks.size(); }
+    size_t getBlockCount() const {
+        std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+        return totalBlockCount;
+    }
+    size_t getResidentChunkCount() const {
+        std::lock_guard<std::recursive_mutex> writeLock(writeMutex);
+        return residentChunkCount;
+    }
+    bool isTileRendererReady() const { return tileRenderer.isReady(); }
+    size_t getTileDrawCalls() const { return tileRenderer.getLastDrawCalls(); }
     
 private:
     // Internal helper to load a single texture from file
@@ -89,17 +234,85 @@ private:
         BlockName name; // Store BlockName instead of GLuint
         int x;
         int y;
-        float currentFrame = 0.0f; // Added for individual animation state
+        float currentFrame = 0.0f; // Animation phase at clock 0 (the shown frame is tileAnimationFrame of this and the type's phase)
         int rotationAngle = 0; // Added for block-specific rotation (0, 90, 180, 270)
         
         // Block transformation timing
         float transformationTimer = 0.0f; // Timer tracking how long this block has existed
         float transformationTarget = 0.0f; // The randomly chosen time when this block should transform
         bool hasBeenInitializedForTransformation = false; // Flag to ensure transformation timer is only set once
-    };    std::vector<Block> blocks;
+    };
+
+    // Reset a block's animation, rotation and transformation state for its (new) block type.
+    // nextRandom() returns values in [0, RAND_MAX], drawn in the same order as placeBlocks draws from the BLOCKS stream.
+    template <typename RandomSource>
+    void initializeBlockState(Block& block, RandomSource&& nextRandom) const;
+
+    struct BlockChunk {
+        int chunkX = 0;
+        int chunkY = 0;
+        int blockCount = 0;
+        unsigned int contentVersion = 0;        // See getChunkContentVersion
+        std::bitset<CHUNK_CELL_COUNT> occupied; // Cells that hold a block
+        Block cells[CHUNK_CELL_COUNT];          // Row-major, index = localY * CHUNK_SIZE + localX
+    };
+
+    Block* findBlock(int x, int y);
+    const Block* findBlock(int x, int y) const;
+    BlockChunk* getChunk(int chunkX, int chunkY) const;
+    BlockChunk* getOrCreateChunk(int chunkX, int chunkY);
+    Block& insertBlock(BlockChunk& chunk, int x, int y);
+    void markBlockModified(int x, int y);
+
+    // Advance the animation clock and refresh tileTypes (wrapped phase of every animated type)
+    void advanceBlockAnimations(double deltaTime);
+    // Tile renderer path of recordBlocks: (re)build the streams of changed chunks, list the visible ones
+    void recordBlockTiles(const VisibleSet& visible);
+    // Stream of one chunk, grouped by block type
+    void buildChunkTiles(const BlockChunk& chunk, std::vector<TileInstance>& tiles, std::vector<TileRun>& runs) const;
+
+    // An unloaded chunk is freed once every reader that could still hold it has closed its
+    // ReadEpochGuard (readEpoch.h), however long its tick or job runs. Old chunk tables are kept
+    // until the map is destroyed (setWorldSize only reallocates before readers start).
+    void retireChunk(BlockChunk* chunk);
+    void releaseRetiredChunks(bool releaseAll);
+
+    int worldWidth = 0;
+    int worldHeight = 0;
+    int chunkCountX = 0;
+    int chunkCountY = 0;
+    std::unique_ptr<std::atomic<BlockChunk*>[]> chunkSlots; // Index = chunkY * chunkCountX + chunkX
+    std::vector<std::pair<BlockChunk*, uint64_t>> retiredChunks; // Chunk, retireReadEpoch() tag
+    std::vector<std::unique_ptr<std::atomic<BlockChunk*>[]>> retiredChunkTables;
+    std::atomic<unsigned int> residencyVersion{0};
+    // Guards every field mutators change (chunk contents, counters, retiredChunks); taken before
+    // savedBlocksMutex when both are needed
+    mutable std::recursive_mutex writeMutex;
+    unsigned int contentVersionCounter = 0;
+    size_t totalBlockCount = 0;
+    size_t residentChunkCount = 0;
+
+    // What recordBlocks left for submitBlocks (render thread and render workers, never at the same time)
+    std::vector<BlockQuad> drawQuads;
+    bool recordedTiles = false;  // Tile renderer path: the fields below instead of drawQuads
+    TileView tileView{};
+    struct ChunkTileUpload {
+        int chunkX, chunkY;
+        unsigned int contentVersion;
+        std::vector<TileInstance> tiles;
+        std::vector<TileRun> runs;
+    };
+    std::vector<ChunkTileUpload> tileUploads; // Kept across frames for their capacity
+    size_t tileUploadCount = 0;
+    std::vector<std::pair<int, int>> tileDrawChunks;
+    // Block animations run on one clock (render thread): a block shows its phase offset plus the
+    // phase of its type, so the frame of every block is known without per-block state
+    double animationClock = 0.0;
+    std::vector<TileTypeAnimation> tileTypes; // Index = static_cast<int>(BlockName)
+    TileRenderer tileRenderer;
     std::map<BlockName, BlockInfo> textureDetails; // Stores detailed info for each texture
-    std::map<std::pair<int, int>, size_t> blockPositionMap; // Maps coordinates to block index for faster lookups
     std::map<std::pair<int, int>, BlockName> savedExistingBlocks; // Maps coordinates to previously existing block types
+    mutable std::mutex savedBlocksMutex; // Guards savedExistingBlocks
     glbasimac::GLBI_Engine* enginePtr;
 };
 
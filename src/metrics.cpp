@@ -0,0 +1,217 @@
+#include "metrics.h"
+#include "collision.h"
+#include "pathfinding.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+void atomicAdd(std::atomic<double>& target, double amount) {
+    double expected = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(expected, expected + amount, std::memory_order_relaxed)) {
+    }
+}
+
+std::string formatValue(double value) {
+    if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+    if (std::isnan(value)) return "NaN";
+    std::ostringstream out;
+    out.precision(12);
+    out << value;
+    return out.str();
+}
+
+std::string seriesName(const std::string& name, const std::string& labels) {
+    return labels.empty() ? name : name + "{" + labels + "}";
+}
+
+} // namespace
+
+void MetricCounter::increment(double amount) {
+    atomicAdd(total, amount);
+}
+
+void MetricCounter::publishTotal(double sourceTotal) {
+    double delta = sourceTotal >= lastSourceTotal ? sourceTotal - lastSourceTotal : sourceTotal;
+    lastSourceTotal = sourceTotal;
+    if (delta > 0.0) {
+        atomicAdd(total, delta);
+    }
+}
+
+MetricHistogram::MetricHistogram(const std::vector<double>& bounds)
+    : upperBounds(bounds), counts(new std::atomic<uint64_t>[bounds.size() + 1]) {
+    std::sort(upperBounds.begin(), upperBounds.end());
+    for (size_t i = 0; i <= upperBounds.size(); ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double sample) {
+    size_t bucket = std::lower_bound(upperBounds.begin(), upperBounds.end(), sample) - upperBounds.begin();
+    counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    sampleCount.fetch_add(1, std::memory_order_relaxed);
+    atomicAdd(sampleSum, sample);
+}
+
+std::vector<uint64_t> MetricHistogram::bucketCounts() const {
+    std::vector<uint64_t> result(upperBounds.size() + 1);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = counts[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+const std::vector<double>& frameTimeBuckets() {
+    static const std::vector<double> buckets = {0.001, 0.002, 0.004, 0.008, 0.012, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25};
+    return buckets;
+}
+
+std::string metricLabel(const std::string& key, const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') escaped += '\\';
+        if (c == '\n') { escaped += "\\n"; continue; }
+        escaped += c;
+    }
+    return key + "=\"" + escaped + "\"";
+}
+
+MetricsRegistry::Series& MetricsRegistry::findOrCreate(const std::string& name, const std::string& help, MetricType type,
+                                                        const std::string& labels) {
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    auto familyIt = families.find(name);
+    if (familyIt == families.end()) {
+        familyIt = families.emplace(name, Family{help, type, {}}).first;
+    } else if (familyIt->second.help.empty()) {
+        familyIt->second.help = help;
+    }
+    if (familyIt->second.type != type) {
+        // A programming error; give the caller a detached series rather than a wrong-typed one
+        std::cerr << "Metrics: " << name << " registered again with another type" << std::endl;
+        static std::vector<std::unique_ptr<Series>> orphans;
+        orphans.emplace_back(new Series());
+        orphans.back()->labels = labels;
+        return *orphans.back();
+    }
+
+    for (auto& series : familyIt->second.series) {
+        if (series->labels == labels) return *series;
+    }
+    familyIt->second.series.emplace_back(new Series());
+    Series& series = *familyIt->second.series.back();
+    series.labels = labels;
+    return series;
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    Series& series = findOrCreate(name, help, MetricType::COUNTER, labels);
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    if (!series.counter) series.counter.reset(new MetricCounter());
+    return *series.counter;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    Series& series = findOrCreate(name, help, MetricType::GAUGE, labels);
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    if (!series.gauge) series.gauge.reset(new MetricGauge());
+    return *series.gauge;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                            const std::vector<double>& upperBounds, const std::string& labels) {
+    Series& series = findOrCreate(name, help, MetricType::HISTOGRAM, labels);
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    if (!series.histogram) series.histogram.reset(new MetricHistogram(upperBounds));
+    return *series.histogram;
+}
+
+void MetricsRegistry::addCollector(std::function<void()> collector) {
+    std::lock_guard<std::mutex> lock(collectMutex);
+    collectors.push_back(std::move(collector));
+}
+
+void MetricsRegistry::collect() {
+    // One reader at a time: MetricCounter::publishTotal expects a single publisher
+    std::lock_guard<std::mutex> lock(collectMutex);
+    for (auto& collector : collectors) {
+        collector();
+    }
+}
+
+std::string MetricsRegistry::renderPrometheus() {
+    collect();
+
+    std::ostringstream out;
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    for (const auto& pair : families) {
+        const std::string& name = pair.first;
+        const Family& family = pair.second;
+        const char* typeName = family.type == MetricType::COUNTER ? "counter"
+                             : family.type == MetricType::GAUGE ? "gauge" : "histogram";
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << typeName << "\n";
+
+        for (const auto& series : family.series) {
+            if (series->counter) {
+                out << seriesName(name, series->labels) << " " << formatValue(series->counter->value()) << "\n";
+            } else if (series->gauge) {
+                out << seriesName(name, series->labels) << " " << formatValue(series->gauge->value()) << "\n";
+            } else if (series->histogram) {
+                const MetricHistogram& histogram = *series->histogram;
+                std::vector<uint64_t> counts = histogram.bucketCounts();
+                std::string labelPrefix = series->labels.empty() ? "" : series->labels + ",";
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < counts.size(); ++i) {
+                    cumulative += counts[i];
+                    double bound = i < histogram.getUpperBounds().size() ? histogram.getUpperBounds()[i] : INFINITY;
+                    out << name << "_bucket{" << labelPrefix << "le=\"" << formatValue(bound) << "\"} " << cumulative << "\n";
+                }
+                out << seriesName(name + "_sum", series->labels) << " " << formatValue(histogram.sum()) << "\n";
+                // _count from the buckets so it always matches the +Inf bucket
+                out << seriesName(name + "_count", series->labels) << " " << cumulative << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+MetricsRegistry::MetricsRegistry() {
+    // The stats structs of collision and pathfinding are global and live as long as the process,
+    // so they can be read from any thread at any time
+    MetricCounter& collisionQueries = counter("sorbetcoco_collision_queries_total", "Hierarchical spatial grid element queries");
+    MetricCounter& broadPhase = counter("sorbetcoco_collision_broad_phase_checks_total", "Collision queries answered from the coarse grid");
+    MetricCounter& narrowPhase = counter("sorbetcoco_collision_narrow_phase_checks_total", "Collision queries answered from the fine grid");
+    MetricCounter& gridHits = counter("sorbetcoco_collision_grid_hits_total", "Collision queries that found at least one element");
+    MetricCounter& collisionSeconds = counter("sorbetcoco_collision_query_seconds_total", "Time spent in spatial grid queries");
+
+    MetricCounter& pathCalls = counter("sorbetcoco_pathfinding_calls_total", "A* searches started");
+    MetricCounter& pathNodes = counter("sorbetcoco_pathfinding_nodes_explored_total", "A* nodes expanded");
+    MetricCounter& pathChecks = counter("sorbetcoco_pathfinding_collision_checks_total", "Position checks made by A*");
+    MetricCounter& pathSeconds = counter("sorbetcoco_pathfinding_seconds_total", "Time spent in A* searches");
+
+    MetricCounter& hierarchicalPaths = counter("sorbetcoco_pathfinding_routes_total", "Routes found by findPathHybrid",
+                                               metricLabel("method", "hierarchical"));
+    MetricCounter& directPaths = counter("sorbetcoco_pathfinding_routes_total", "Routes found by findPathHybrid",
+                                         metricLabel("method", "direct"));
+    MetricCounter& clusterPaths = counter("sorbetcoco_pathfinding_cluster_paths_total", "Cluster-level paths built by hierarchical pathfinding");
+
+    addCollector([&] {
+        collisionQueries.publishTotal(g_collisionStats.totalCollisionQueries.load());
+        broadPhase.publishTotal(g_collisionStats.broadPhaseChecks.load());
+        narrowPhase.publishTotal(g_collisionStats.narrowPhaseChecks.load());
+        gridHits.publishTotal(g_collisionStats.hierarchicalHits.load());
+        collisionSeconds.publishTotal(g_collisionStats.totalTimeMs.load() / 1000.0);
+
+        pathCalls.publishTotal(g_pathfindingStats.totalPathfindingCalls.load());
+        pathNodes.publishTotal(g_pathfindingStats.nodesExplored.load());
+        pathChecks.publishTotal(g_pathfindingStats.collisionChecks.load());
+        pathSeconds.publishTotal(g_pathfindingStats.totalComputationTimeMs.load() / 1000.0);
+
+        hierarchicalPaths.publishTotal(g_hierarchicalPathfindingStats.hierarchicalPathsUsed.load());
+        directPaths.publishTotal(g_hierarchicalPathfindingStats.directPathsUsed.load());
+        clusterPaths.publishTotal(g_hierarchicalPathfindingStats.clusterPathsGenerated.load());
+    });
+}
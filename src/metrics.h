@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Runtime metrics registry: the live counters of every subsystem in one place, readable while the
+// game runs (the loopback endpoint in metricsServer.h, the F12 overlay in metricsOverlay.h).
+//  - counters only go up, gauges hold the latest value, histograms count samples into fixed buckets
+//  - metrics are created once and never freed: subsystems keep a reference (usually in a
+//    function-local static) and publishing is one or two atomic operations, no lock, no lookup
+//  - stats that already live in their own structs (CollisionPerformanceStats, PathfindingStats,
+//    HierarchicalPathfindingStats) are copied in by collectors when the metrics are read
+//  - renderPrometheus() writes the Prometheus text exposition format (version 0.0.4)
+// Names follow the Prometheus conventions: sorbetcoco_ prefix, _total for counters, base units
+// (seconds) in the name.
+
+class MetricCounter {
+public:
+    void increment(double amount = 1.0);
+    // Publish a running total kept elsewhere. A total that went down was reset by its owner: the
+    // counter keeps counting from there instead of going backwards. One publisher per counter.
+    void publishTotal(double sourceTotal);
+    double value() const { return total.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> total{0.0};
+    double lastSourceTotal = 0.0;
+};
+
+class MetricGauge {
+public:
+    void set(double newValue) { current.store(newValue, std::memory_order_relaxed); }
+    double value() const { return current.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> current{0.0};
+};
+
+class MetricHistogram {
+public:
+    // upperBounds: ascending bucket bounds; a +Inf bucket is implied
+    explicit MetricHistogram(const std::vector<double>& upperBounds);
+
+    void observe(double sample);
+
+    const std::vector<double>& getUpperBounds() const { return upperBounds; }
+    // Per-bucket (non-cumulative) counts, the +Inf bucket last
+    std::vector<uint64_t> bucketCounts() const;
+    uint64_t count() const { return sampleCount.load(std::memory_order_relaxed); }
+    double sum() const { return sampleSum.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<double> upperBounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> counts; // upperBounds.size() + 1
+    std::atomic<uint64_t> sampleCount{0};
+    std::atomic<double> sampleSum{0.0};
+};
+
+// Bucket bounds in seconds for frame-sized durations (1 ms .. 250 ms, 16.7 ms = one 60 Hz frame)
+const std::vector<double>& frameTimeBuckets();
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& getInstance() {
+        static MetricsRegistry instance;
+        return instance;
+    }
+
+    // Get or create a metric. labels is the Prometheus label list without braces, e.g.
+    // loop="Game logic" (empty for none). The same name must always be the same type.
+    MetricCounter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricHistogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& upperBounds,
+                               const std::string& labels = "");
+
+    // Run before every read of the metrics (scrape or overlay sample), one at a time
+    void addCollector(std::function<void()> collector);
+    void collect();
+
+    // Runs the collectors, then formats every metric
+    std::string renderPrometheus();
+
+private:
+    MetricsRegistry();
+
+    enum class MetricType { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::string labels;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+    };
+
+    struct Family {
+        std::string help;
+        MetricType type;
+        std::vector<std::unique_ptr<Series>> series;
+    };
+
+    Series& findOrCreate(const std::string& name, const std::string& help, MetricType type, const std::string& labels);
+
+    std::mutex familiesMutex;               // Creation and formatting, never the publish path
+    std::map<std::string, Family> families; // Sorted by name: stable exposition order
+
+    std::mutex collectMutex;
+    std::vector<std::function<void()>> collectors;
+};
+
+// Helper for labels: key="value" with the value escaped
+std::string metricLabel(const std::string& key, const std::string& value);
@@ -0,0 +1,150 @@
+#include "metricsOverlay.h"
+#include "metrics.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+
+MetricsOverlay g_metricsOverlay;
+
+namespace {
+
+enum OverlayChart { CHART_TICK, CHART_FRAME, CHART_PATH_QUEUE, CHART_COLLISIONS, CHART_COUNT };
+
+const float OVERLAY_LEFT = -0.98f;       // Normalized device coordinates
+const float OVERLAY_TOP = 0.98f;
+const float OVERLAY_WIDTH = 0.6f;
+const float OVERLAY_CHART_HEIGHT = 0.12f;
+const float OVERLAY_CHART_GAP = 0.02f;
+
+} // namespace
+
+void MetricsOverlay::toggle() {
+    visible = !visible;
+    if (!visible) {
+        std::cout << "Metrics overlay disabled" << std::endl;
+        return;
+    }
+    if (charts.empty()) {
+        charts.resize(CHART_COUNT);
+        charts[CHART_TICK] = {0.2f, 0.9f, 0.3f, 0.0333, 0.0167, {}};
+        charts[CHART_FRAME] = {0.3f, 0.6f, 1.0f, 0.0333, 0.0167, {}};
+        charts[CHART_PATH_QUEUE] = {1.0f, 0.6f, 0.1f, 32.0, 0.0, {}};
+        charts[CHART_COLLISIONS] = {0.9f, 0.3f, 0.9f, 200000.0, 0.0, {}};
+        for (Chart& chart : charts) {
+            chart.history.assign(OVERLAY_HISTORY, 0.0f);
+        }
+    }
+    std::cout << "Metrics overlay enabled (top to bottom):" << std::endl;
+    std::cout << "  green   logic tick time, full height 33 ms, line at 16.7 ms" << std::endl;
+    std::cout << "  blue    frame time, full height 33 ms, line at 16.7 ms" << std::endl;
+    std::cout << "  orange  pathfinding queue depth, full height 32 requests" << std::endl;
+    std::cout << "  magenta collision queries per second, full height 200k" << std::endl;
+}
+
+void MetricsOverlay::sample(double frameSeconds) {
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    static MetricGauge& lastTick = metrics.gauge("sorbetcoco_logic_tick_last_seconds", "Wall time of the latest logic tick");
+    static MetricGauge& pathQueue = metrics.gauge("sorbetcoco_pathfinding_queue_depth",
+                                                  "Async pathfinding requests waiting for or running on a worker");
+    static MetricCounter& collisionQueries = metrics.counter("sorbetcoco_collision_queries_total",
+                                                             "Hierarchical spatial grid element queries");
+
+    // The collision counter is filled in by a collector: refresh it a few times per second only
+    sampleTime += frameSeconds;
+    double collisionRate = charts[CHART_COLLISIONS].history[(writeIndex + OVERLAY_HISTORY - 1) % OVERLAY_HISTORY];
+    if (sampleTime >= 0.25) {
+        metrics.collect();
+        double queries = collisionQueries.value();
+        collisionRate = (queries - lastCollisionQueries) / sampleTime;
+        lastCollisionQueries = queries;
+        sampleTime = 0.0;
+    }
+
+    charts[CHART_TICK].history[writeIndex] = static_cast<float>(lastTick.value());
+    charts[CHART_FRAME].history[writeIndex] = static_cast<float>(frameSeconds);
+    charts[CHART_PATH_QUEUE].history[writeIndex] = static_cast<float>(pathQueue.value());
+    charts[CHART_COLLISIONS].history[writeIndex] = static_cast<float>(collisionRate);
+    writeIndex = (writeIndex + 1) % OVERLAY_HISTORY;
+}
+
+void MetricsOverlay::drawChart(const Chart& chart, float left, float top, float width, float height) const {
+    float bottom = top - height;
+    float barWidth = width / OVERLAY_HISTORY;
+
+    // Background
+    glColor4f(0.0f, 0.0f, 0.0f, 0.55f);
+    glBegin(GL_QUADS);
+    glVertex2f(left, bottom);
+    glVertex2f(left + width, bottom);
+    glVertex2f(left + width, top);
+    glVertex2f(left, top);
+    glEnd();
+
+    // Bars, oldest first
+    glBegin(GL_QUADS);
+    for (int i = 0; i < OVERLAY_HISTORY; ++i) {
+        float value = chart.history[(writeIndex + i) % OVERLAY_HISTORY];
+        float fraction = static_cast<float>(std::min(1.0, std::max(0.0, value / chart.fullScale)));
+        if (fraction <= 0.0f) continue;
+        if (chart.warnLevel > 0.0 && value > chart.warnLevel) {
+            glColor4f(1.0f, 0.2f, 0.2f, 0.9f);
+        } else {
+            glColor4f(chart.red, chart.green, chart.blue, 0.9f);
+        }
+        float x = left + i * barWidth;
+        glVertex2f(x, bottom);
+        glVertex2f(x + barWidth, bottom);
+        glVertex2f(x + barWidth, bottom + fraction * height);
+        glVertex2f(x, bottom + fraction * height);
+    }
+    glEnd();
+
+    // Reference line
+    if (chart.warnLevel > 0.0) {
+        float y = bottom + static_cast<float>(chart.warnLevel / chart.fullScale) * height;
+        glColor4f(1.0f, 1.0f, 1.0f, 0.8f);
+        glBegin(GL_LINES);
+        glVertex2f(left, y);
+        glVertex2f(left + width, y);
+        glEnd();
+    }
+}
+
+void MetricsOverlay::render(double frameSeconds) {
+    if (!visible || charts.empty()) return;
+    sample(frameSeconds);
+
+    // The menus drawn next expect the blend state they left
+    GLboolean blendEnabled;
+    GLint blendSrcFactor, blendDstFactor;
+    glGetBooleanv(GL_BLEND, &blendEnabled);
+    glGetIntegerv(GL_BLEND_SRC, &blendSrcFactor);
+    glGetIntegerv(GL_BLEND_DST, &blendDstFactor);
+
+    glUseProgram(0);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    float top = OVERLAY_TOP;
+    for (const Chart& chart : charts) {
+        drawChart(chart, OVERLAY_LEFT, top, OVERLAY_WIDTH, OVERLAY_CHART_HEIGHT);
+        top -= OVERLAY_CHART_HEIGHT + OVERLAY_CHART_GAP;
+    }
+
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    glBlendFunc(blendSrcFactor, blendDstFactor);
+    if (!blendEnabled) glDisable(GL_BLEND);
+}
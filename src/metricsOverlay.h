@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+// In-game metrics overlay (F12): strip charts of the last OVERLAY_HISTORY frames in the top-left
+// corner, newest on the right. The game has no text renderer, so each chart is a colour and a
+// scale; the legend is printed to the console when the overlay is switched on.
+//   green   logic tick time         full height = 33 ms, line at 16.7 ms (one 60 Hz tick)
+//   blue    frame time              full height = 33 ms, line at 16.7 ms
+//   orange  pathfinding queue depth full height = 32 requests
+//   magenta collision queries/s     full height = 200k queries/s
+// Bars over the line are drawn red. Values come from MetricsRegistry, like the endpoint's.
+const int OVERLAY_HISTORY = 180;
+
+class MetricsOverlay {
+public:
+    void toggle();
+    bool isVisible() const { return visible; }
+
+    // Sample the metrics and draw the charts (main thread, after the world, before the menus)
+    void render(double frameSeconds);
+
+private:
+    struct Chart {
+        float red, green, blue;
+        double fullScale;  // Value drawn at full height
+        double warnLevel;  // Reference line; bars above it are drawn red (0 = none)
+        std::vector<float> history;
+    };
+
+    void sample(double frameSeconds);
+    void drawChart(const Chart& chart, float left, float top, float width, float height) const;
+
+    bool visible = false;
+    int writeIndex = 0;
+    double lastCollisionQueries = 0.0;
+    double sampleTime = 0.0;
+    std::vector<Chart> charts;
+};
+
+extern MetricsOverlay g_metricsOverlay;
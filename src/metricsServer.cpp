@@ -0,0 +1,178 @@
+#include "metricsServer.h"
+#include "metrics.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET NativeSocket;
+#define CloseSocket closesocket
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int NativeSocket;
+#define CloseSocket close
+#endif
+
+// A scraper that hangs up mid-response must not raise SIGPIPE (its default action ends the game):
+// Linux takes a send flag, macOS a socket option (set on each accepted client)
+#if defined(MSG_NOSIGNAL)
+const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+MetricsServer g_metricsServer;
+
+namespace {
+
+const int ACCEPT_POLL_MS = 250;          // How quickly stop() is noticed
+const int CLIENT_TIMEOUT_MS = 1000;      // A client that doesn't send its request in time is dropped
+
+// Wait until the socket is readable (or the timeout runs out)
+bool waitReadable(NativeSocket socket, int timeoutMs) {
+#ifdef _WIN32
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET(socket, &readSet);
+    timeval timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+    return select(0, &readSet, nullptr, nullptr, &timeout) > 0;
+#else
+    pollfd descriptor{socket, POLLIN, 0};
+    return poll(&descriptor, 1, timeoutMs) > 0;
+#endif
+}
+
+void sendAll(NativeSocket socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int result = static_cast<int>(send(socket, data.data() + sent, static_cast<int>(data.size() - sent), SEND_FLAGS));
+        if (result <= 0) return;
+        sent += static_cast<size_t>(result);
+    }
+}
+
+} // namespace
+
+bool MetricsServer::start(int port) {
+    if (running.load()) return true;
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        std::cerr << "Metrics endpoint: WSAStartup failed" << std::endl;
+        return false;
+    }
+#endif
+
+    NativeSocket server = socket(AF_INET, SOCK_STREAM, 0);
+#ifdef _WIN32
+    if (server == INVALID_SOCKET) {
+#else
+    if (server < 0) {
+#endif
+        std::cerr << "Metrics endpoint: cannot create a socket" << std::endl;
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Loopback only
+    address.sin_port = htons(static_cast<unsigned short>(port));
+    if (bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(server, 8) != 0) {
+        std::cerr << "Metrics endpoint: cannot listen on 127.0.0.1:" << port << " (port in use?)" << std::endl;
+        CloseSocket(server);
+        return false;
+    }
+
+    listenSocket = static_cast<long long>(server);
+    running.store(true);
+    serverThread = std::thread(&MetricsServer::serveLoop, this);
+    std::cout << "Metrics endpoint: http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running.exchange(false)) return;
+    if (serverThread.joinable()) {
+        serverThread.join();
+    }
+    CloseSocket(static_cast<NativeSocket>(listenSocket));
+    listenSocket = -1;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void MetricsServer::serveLoop() {
+    NativeSocket server = static_cast<NativeSocket>(listenSocket);
+    while (running.load()) {
+        if (!waitReadable(server, ACCEPT_POLL_MS)) continue;
+        NativeSocket client = accept(server, nullptr, nullptr);
+#ifdef _WIN32
+        if (client == INVALID_SOCKET) continue;
+#else
+        if (client < 0) continue;
+#endif
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        // CRASH FIX: a failing scrape must never take the game down
+        try {
+            handleClient(static_cast<long long>(client));
+        } catch (const std::exception& e) {
+            std::cerr << "Metrics endpoint: exception while answering a request: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Metrics endpoint: unknown exception while answering a request" << std::endl;
+        }
+        CloseSocket(client);
+    }
+}
+
+void MetricsServer::handleClient(long long clientSocket) {
+    NativeSocket client = static_cast<NativeSocket>(clientSocket);
+
+    // Read up to the end of the request headers (a scrape request has no body)
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        if (!waitReadable(client, CLIENT_TIMEOUT_MS)) return;
+        int received = static_cast<int>(recv(client, buffer, sizeof(buffer), 0));
+        if (received <= 0) return;
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    // "GET /metrics HTTP/1.1" - the path is the second word of the request line
+    size_t pathStart = request.find(' ');
+    size_t pathEnd = pathStart == std::string::npos ? std::string::npos : request.find(' ', pathStart + 1);
+    std::string method = request.substr(0, pathStart);
+    std::string path = pathEnd == std::string::npos ? "" : request.substr(pathStart + 1, pathEnd - pathStart - 1);
+
+    std::string status = "200 OK";
+    std::string contentType = "text/plain; version=0.0.4; charset=utf-8";
+    std::string body;
+    if (method != "GET") {
+        status = "405 Method Not Allowed";
+        contentType = "text/plain";
+        body = "Only GET is supported\n";
+    } else if (path == "/metrics" || path == "/") {
+        body = MetricsRegistry::getInstance().renderPrometheus();
+    } else {
+        status = "404 Not Found";
+        contentType = "text/plain";
+        body = "Metrics are served at /metrics\n";
+    }
+
+    sendAll(client, "HTTP/1.1 " + status + "\r\nContent-Type: " + contentType + "\r\nContent-Length: "
+                    + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
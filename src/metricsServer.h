@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+// Serves MetricsRegistry::renderPrometheus() over HTTP on 127.0.0.1 (loopback only, never on the
+// network): point Prometheus or `curl http://127.0.0.1:9464/metrics` at it during soak tests.
+// One background thread answers one request at a time; a scrape costs one pass over the metrics.
+class MetricsServer {
+public:
+    ~MetricsServer() { stop(); }
+
+    // Listen on 127.0.0.1:port. False (and a message) when the port is taken.
+    bool start(int port);
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+private:
+    void serveLoop();
+    void handleClient(long long clientSocket);
+
+    std::atomic<bool> running{false};
+    long long listenSocket = -1; // SOCKET on Windows, file descriptor elsewhere
+    std::thread serverThread;
+};
+
+extern MetricsServer g_metricsServer;
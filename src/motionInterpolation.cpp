@@ -0,0 +1,91 @@
+#include "motionInterpolation.h"
+#include "globals.h"
+#include "seqlock.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// One per clock: written by its loop thread at the start and end of every step, read by the
+// movers (currentMotionStamp) and the renderer (MotionFrame::capture)
+struct MotionClockState {
+    uint32_t step;
+    uint32_t inStep;    // 1 between the start and the end of a step
+    double stepStart;   // steady clock seconds
+    double stepSeconds; // Period of the loop
+};
+
+Seqlock<MotionClockState> motionClocks[static_cast<int>(MotionClockId::COUNT)];
+
+// Clock of the step the calling thread is in (only loops with their own thread set it)
+thread_local MotionClockId threadMotionClock = MotionClockId::NONE;
+
+double steadySeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+MotionStepScope::MotionStepScope(MotionClockId clock, double stepSeconds) : clock(clock) {
+    Seqlock<MotionClockState>& state = motionClocks[static_cast<int>(clock)];
+    MotionClockState next = state.load();
+    next.step++;
+    next.inStep = 1;
+    next.stepStart = steadySeconds();
+    next.stepSeconds = stepSeconds;
+    state.store(next);
+    if (clock == MotionClockId::PLAYER_MOVEMENT) {
+        threadMotionClock = clock;
+    }
+}
+
+MotionStepScope::~MotionStepScope() {
+    Seqlock<MotionClockState>& state = motionClocks[static_cast<int>(clock)];
+    MotionClockState next = state.load();
+    next.inStep = 0;
+    state.store(next);
+    if (clock == MotionClockId::PLAYER_MOVEMENT) {
+        threadMotionClock = MotionClockId::NONE;
+    }
+}
+
+MotionStamp currentMotionStamp() {
+    MotionStamp stamp;
+    if (threadMotionClock != MotionClockId::NONE) {
+        stamp.clock = threadMotionClock;
+        stamp.step = motionClocks[static_cast<int>(threadMotionClock)].load().step;
+        return stamp;
+    }
+    MotionClockState logic = motionClocks[static_cast<int>(MotionClockId::GAME_LOGIC)].load();
+    if (logic.inStep) {
+        stamp.clock = MotionClockId::GAME_LOGIC;
+        stamp.step = logic.step;
+    }
+    return stamp;
+}
+
+MotionFrame MotionFrame::capture() {
+    MotionFrame frame;
+    if (!INTERPOLATE_MOTION) {
+        return frame;
+    }
+    double now = steadySeconds();
+    for (int clock = static_cast<int>(MotionClockId::NONE) + 1; clock < static_cast<int>(MotionClockId::COUNT); ++clock) {
+        MotionClockState state = motionClocks[clock].load();
+        if (state.step == 0 || state.stepSeconds <= 0.0) {
+            continue; // The loop never ran
+        }
+        // A late or paused loop leaves its elements at their latest position (alpha 1)
+        frame.clocks[clock].step = state.step;
+        frame.clocks[clock].alpha = static_cast<float>(std::min(std::max((now - state.stepStart) / state.stepSeconds, 0.0), 1.0));
+    }
+    return frame;
+}
+
+float MotionFrame::alpha(MotionStamp stamp) const {
+    if (stamp.clock == MotionClockId::NONE) {
+        return -1.0f;
+    }
+    const ClockFrame& clock = clocks[static_cast<int>(stamp.clock)];
+    return clock.step == stamp.step ? clock.alpha : -1.0f;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+// Render interpolation of moving elements between fixed simulation steps.
+// The entities move on the 60 Hz logic tick and the player on the 120 Hz movement loop, while the
+// main thread renders at the display rate: drawing the positions as they are makes moving sprites
+// judder (a 144 Hz display shows some steps twice and others not at all) and a frame drawn in the
+// middle of a tick shows some entities already moved and others not.
+//  - every fixed-step loop counts its steps on a motion clock (MotionStepScope around the step)
+//  - an element moved during a step keeps the position it had before that step
+//    (PlacedElement::previousX/Y) and the step that moved it (PlacedElement::motionStamp)
+//  - the renderer draws elements moved during the latest step of their clock between the two
+//    positions, by the fraction of the step period elapsed since that step started; anything else
+//    is drawn where it is. The picture is at most one step behind the simulation, and it no longer
+//    depends on when a step lands in the frame, so a lower logic rate still renders smoothly.
+// Moves made outside of a step (placement, world load, teleports from the main thread) get no
+// stamp: the element is drawn at its new position right away.
+
+enum class MotionClockId : uint8_t {
+    NONE = 0,
+    GAME_LOGIC,       // The logic tick, every stage of its tick graph (any worker thread)
+    PLAYER_MOVEMENT,  // The 120 Hz player movement loop (its own thread)
+    COUNT
+};
+
+// The step of a motion clock an element was last moved in
+struct MotionStamp {
+    MotionClockId clock = MotionClockId::NONE;
+    uint32_t step = 0;
+    bool operator==(const MotionStamp& other) const { return clock == other.clock && step == other.step; }
+    bool operator!=(const MotionStamp& other) const { return !(*this == other); }
+};
+
+// Marks one step of a fixed-step loop on its motion clock, for the duration of the scope.
+// PLAYER_MOVEMENT applies to moves made on this thread only; GAME_LOGIC to moves made on any
+// thread that is not in a PLAYER_MOVEMENT step (the tick stages run on the Taskflow workers).
+class MotionStepScope {
+public:
+    MotionStepScope(MotionClockId clock, double stepSeconds);
+    ~MotionStepScope();
+    MotionStepScope(const MotionStepScope&) = delete;
+    MotionStepScope& operator=(const MotionStepScope&) = delete;
+
+private:
+    MotionClockId clock;
+};
+
+// Stamp for a move made now on the calling thread (NONE outside of any step)
+MotionStamp currentMotionStamp();
+
+// The step state of every clock, read once per rendered frame
+class MotionFrame {
+public:
+    // Snapshot of the clocks at the current time
+    static MotionFrame capture();
+
+    // Fraction of the way from previousX/Y to x/y to draw an element with this stamp at, or a
+    // negative value when it is drawn at its position (not moved in the latest step of its clock,
+    // or INTERPOLATE_MOTION off)
+    float alpha(MotionStamp stamp) const;
+
+private:
+    struct ClockFrame {
+        uint32_t step = 0;
+        float alpha = -1.0f;
+    };
+    ClockFrame clocks[static_cast<int>(MotionClockId::COUNT)];
+};
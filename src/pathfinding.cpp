@@ -1,7 +1,10 @@
 #include "pathfinding.h"
+#include "gameLog.h"
 #include "entities.h" // For EntityConfiguration
 #include "globals.h" // For GRID_SIZE and DEBUG_LOGS
 #include "collision.h" // For collision detection
+#include "gameClock.h" // For getGameTime
+#include "timeSlicedJobs.h" // Periodic graph refresh runs as a time-sliced job
 #include <vector>
 #include <queue>
 #include <set>
@@ -27,7 +30,7 @@ float MIN_DISTANCE_FROM_AVOIDANCE_ELEMENTS = 0.3f; // Default: no buffer
 
 // Pathfinding cooldown system
 const float PATH_FINDING_COOLDOWN = 0.5f; // seconds - Minimum time between pathfinding calculations per entity (increased for performance)
-static std::unordered_map<std::string, std::chrono::steady_clock::time_point> entityLastPathfindingTime;
+static std::unordered_map<std::string, double> entityLastPathfindingTime; // getGameTime() of the last request
 static std::mutex pathfindingCooldownMutex;
 
 // Global instances for performance optimization
@@ -39,6 +42,8 @@ AsyncPathfinder g_asyncPathfinder;
 
 // Global instances for hierarchical pathfinding
 HierarchicalPathfindingGraph g_hierarchicalPathfindingGraph;
+std::mutex g_hierarchicalPathfindingGraphMutex;
+static const char* PATHFINDING_REFRESH_JOB_KEY = "pathfinding graph refresh";
 HierarchicalPathfindingStats g_hierarchicalPathfindingStats;
 
 void HierarchicalPathfindingStats::reset() {
@@ -87,40 +92,76 @@ void HierarchicalPathfindingStats::updateSpeedup(double hierarchicalTime, double
 void HierarchicalPathfindingGraph::initialize(const Map& gameMap) {
     if (isInitialized) return;
     
-    if (DEBUG_LOGS) {
-        std::cout << "Initializing hierarchical pathfinding graph..." << std::endl;
-    }
+    GAME_LOG_DEBUG("Initializing hierarchical pathfinding graph...");
     
     clear();
+    mapResidencyVersion = gameMap.getResidencyVersion();
     generateClusters(gameMap);
     findClusterConnections(gameMap);
     
     isInitialized = true;
-    lastUpdateTime = static_cast<float>(glfwGetTime());
+    lastUpdateTime = static_cast<float>(getGameTime());
     
-    if (DEBUG_LOGS) {
-        std::cout << "Hierarchical pathfinding graph initialized with " 
-                  << clusters.size() << " clusters" << std::endl;
-    }
+    GAME_LOG_DEBUG("Hierarchical pathfinding graph initialized with " 
+                  << clusters.size() << " clusters");
 }
 
 void HierarchicalPathfindingGraph::updateGraph(const Map& gameMap, bool forceUpdate) {
-    float currentTime = static_cast<float>(glfwGetTime());
+    float currentTime = static_cast<float>(getGameTime());
     
-    if (!forceUpdate && (currentTime - lastUpdateTime < UPDATE_INTERVAL)) {
+    if (!forceUpdate && currentTime >= lastUpdateTime && (currentTime - lastUpdateTime < UPDATE_INTERVAL)) {
         return;
     }
     
-    // Re-analyze cluster obstacles (connections remain mostly static)
-    for (auto& cluster : clusters) {
-        analyzeClusterObstacles(cluster, gameMap);
+    // The world was resized (map regenerated with/without streaming) - start over
+    if (graphWorldSize != WORLD_SIZE) {
+        isInitialized = false;
+        initialize(gameMap);
+        return;
+    }
+    
+    if (gameMap.getResidencyVersion() != mapResidencyVersion) {
+        // Chunks were streamed in or out: terrain that used to be unknown (blocked) may now be walkable
+        refreshForResidencyChange(gameMap);
+        refreshQueued = false;
+    } else if (forceUpdate) {
+        // Re-analyze cluster obstacles (connections remain mostly static)
+        for (auto& cluster : clusters) {
+            analyzeClusterObstacles(cluster, gameMap);
+        }
+        refreshQueued = false;
+    } else if (!g_timeSlicedJobs.isQueued(PATHFINDING_REFRESH_JOB_KEY)) {
+        // The periodic re-analysis walks every cluster: hand it to the time-sliced jobs instead of
+        // stalling the pathfinding request that happened to cross the interval
+        refreshQueued = true;
+        refreshCursor = 0;
+        const Map* map = &gameMap;
+        g_timeSlicedJobs.submit("Pathfinding graph refresh", [this, map]() {
+            std::lock_guard<std::mutex> lock(g_hierarchicalPathfindingGraphMutex);
+            return refreshObstaclesStep(*map, PATHFINDING_CLUSTERS_PER_JOB_STEP) ? JobStep::DONE : JobStep::CONTINUE;
+        }, PATHFINDING_REFRESH_JOB_KEY);
     }
     
     lastUpdateTime = currentTime;
     
-    if (DEBUG_LOGS) {
-        std::cout << "Updated hierarchical pathfinding graph" << std::endl;
+    GAME_LOG_DEBUG("Updated hierarchical pathfinding graph");
+}
+
+bool HierarchicalPathfindingGraph::refreshObstaclesStep(const Map& gameMap, size_t maxClusters) {
+    // Cleared (or rebuilt) since the refresh was queued: nothing left to refresh
+    if (!refreshQueued) {
+        return true;
+    }
+    size_t end = std::min(clusters.size(), refreshCursor + maxClusters);
+    for (; refreshCursor < end; ++refreshCursor) {
+        analyzeClusterObstacles(clusters[refreshCursor], gameMap);
     }
+    if (refreshCursor < clusters.size()) {
+        return false;
+    }
+    refreshQueued = false;
+    GAME_LOG_DEBUG("Refreshed hierarchical pathfinding graph obstacles");
+    return true;
 }
 
 std::vector<int> HierarchicalPathfindingGraph::findClusterPath(int startClusterId, int goalClusterId) {
@@ -238,6 +279,21 @@ std::vector<std::pair<float, float>> HierarchicalPathfindingGraph::clusterPathTo
 }
 
 int HierarchicalPathfindingGraph::getClusterIdForPosition(float x, float y) const {
+    // Clusters tile the world row-major, so the cluster is found directly from the coordinates.
+    // Bounds are inclusive, so a point exactly on a shared edge belongs to the lower cluster
+    // (same as the first match of the linear scan this replaces).
+    if (clusterColumns > 0 && x >= 0.0f && y >= 0.0f) {
+        int column = std::max(0, static_cast<int>(std::ceil(x / CLUSTER_SIZE)) - 1);
+        int row = std::max(0, static_cast<int>(std::ceil(y / CLUSTER_SIZE)) - 1);
+        if (column < clusterColumns && row < clusterRows) {
+            const PathfindingCluster& cluster = clusters[static_cast<size_t>(row) * clusterColumns + column];
+            if (x >= cluster.minX && x <= cluster.maxX && y >= cluster.minY && y <= cluster.maxY) {
+                return cluster.id;
+            }
+        }
+        return -1; // No cluster found
+    }
+    
     for (const auto& cluster : clusters) {
         if (x >= cluster.minX && x <= cluster.maxX && 
             y >= cluster.minY && y <= cluster.maxY) {
@@ -292,6 +348,11 @@ void HierarchicalPathfindingGraph::clear() {
     interClusterDistances.clear();
     isInitialized = false;
     lastUpdateTime = 0.0f;
+    clusterColumns = 0;
+    clusterRows = 0;
+    graphWorldSize = 0;
+    refreshQueued = false;
+    refreshCursor = 0;
 }
 
 bool HierarchicalPathfindingGraph::isEmpty() const {
@@ -303,6 +364,10 @@ size_t HierarchicalPathfindingGraph::getClusterCount() const {
 }
 
 const PathfindingCluster* HierarchicalPathfindingGraph::getCluster(int clusterId) const {
+    // Ids are assigned in order, so the id is the index
+    if (clusterId >= 0 && clusterId < static_cast<int>(clusters.size()) && clusters[clusterId].id == clusterId) {
+        return &clusters[clusterId];
+    }
     for (const auto& cluster : clusters) {
         if (cluster.id == clusterId) {
             return &cluster;
@@ -313,10 +378,14 @@ const PathfindingCluster* HierarchicalPathfindingGraph::getCluster(int clusterId
 
 void HierarchicalPathfindingGraph::generateClusters(const Map& gameMap) {
     int clusterId = 0;
+    graphWorldSize = WORLD_SIZE;
+    clusterColumns = static_cast<int>(std::ceil((WORLD_SIZE - CLUSTER_SIZE / 2) / CLUSTER_SIZE));
+    clusterRows = clusterColumns;
+    clusters.reserve(static_cast<size_t>(clusterColumns) * clusterRows);
     
     // Generate clusters in a grid pattern
-    for (float y = CLUSTER_SIZE / 2; y < GRID_SIZE; y += CLUSTER_SIZE) {
-        for (float x = CLUSTER_SIZE / 2; x < GRID_SIZE; x += CLUSTER_SIZE) {
+    for (float y = CLUSTER_SIZE / 2; y < WORLD_SIZE; y += CLUSTER_SIZE) {
+        for (float x = CLUSTER_SIZE / 2; x < WORLD_SIZE; x += CLUSTER_SIZE) {
             PathfindingCluster cluster(clusterId++, x, y);
             analyzeClusterObstacles(cluster, gameMap);
             generateEntrancePoints(cluster, gameMap);
@@ -335,7 +404,7 @@ void HierarchicalPathfindingGraph::analyzeClusterObstacles(PathfindingCluster& c
         for (float x = cluster.minX; x <= cluster.maxX; x += sampleStep) {
             totalCells++;
             
-            if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
+            if (x >= 0 && x < WORLD_SIZE && y >= 0 && y < WORLD_SIZE) {
                 if (wouldCollideWithMapBlock(x, y, gameMap)) {
                     blockedCells++;
                 }
@@ -352,22 +421,48 @@ void HierarchicalPathfindingGraph::analyzeClusterObstacles(PathfindingCluster& c
 }
 
 void HierarchicalPathfindingGraph::findClusterConnections(const Map& gameMap) {
-    // Find connections between adjacent clusters
+    // Only clusters within INTER_CLUSTER_CONNECTION_RADIUS can connect, so each cluster only needs
+    // to be tested against its grid neighbours instead of every other cluster (O(n) instead of O(n^2)
+    // - matters once the streamed world has thousands of clusters). Visiting neighbours in increasing
+    // index order keeps the same connection order as the all-pairs scan.
+    const int reach = static_cast<int>(std::ceil(INTER_CLUSTER_CONNECTION_RADIUS / CLUSTER_SIZE));
+    
     for (size_t i = 0; i < clusters.size(); ++i) {
-        for (size_t j = i + 1; j < clusters.size(); ++j) {
-            if (canConnectClusters(clusters[i].id, clusters[j].id, gameMap)) {
-                clusterConnections[clusters[i].id].push_back(clusters[j].id);
-                clusterConnections[clusters[j].id].push_back(clusters[i].id);
-                
-                // Cache distance
-                float distance = calculateClusterDistance(clusters[i].id, clusters[j].id);
-                interClusterDistances[{clusters[i].id, clusters[j].id}] = distance;
-                interClusterDistances[{clusters[j].id, clusters[i].id}] = distance;
+        const int column = static_cast<int>(i) % clusterColumns;
+        const int row = static_cast<int>(i) / clusterColumns;
+        for (int neighborRow = row; neighborRow <= std::min(clusterRows - 1, row + reach); ++neighborRow) {
+            for (int neighborColumn = std::max(0, column - reach); neighborColumn <= std::min(clusterColumns - 1, column + reach); ++neighborColumn) {
+                size_t j = static_cast<size_t>(neighborRow) * clusterColumns + neighborColumn;
+                if (j <= i) continue;
+                if (canConnectClusters(clusters[i].id, clusters[j].id, gameMap)) {
+                    clusterConnections[clusters[i].id].push_back(clusters[j].id);
+                    clusterConnections[clusters[j].id].push_back(clusters[i].id);
+                    
+                    // Cache distance
+                    float distance = calculateClusterDistance(clusters[i].id, clusters[j].id);
+                    interClusterDistances[{clusters[i].id, clusters[j].id}] = distance;
+                    interClusterDistances[{clusters[j].id, clusters[i].id}] = distance;
+                }
             }
         }
     }
 }
 
+void HierarchicalPathfindingGraph::refreshForResidencyChange(const Map& gameMap) {
+    // Obstacles, entrances and connections all depend on which chunks are loaded
+    for (auto& cluster : clusters) {
+        analyzeClusterObstacles(cluster, gameMap);
+        cluster.entrancePoints.clear();
+        generateEntrancePoints(cluster, gameMap);
+    }
+    clusterConnections.clear();
+    interClusterDistances.clear();
+    findClusterConnections(gameMap);
+    mapResidencyVersion = gameMap.getResidencyVersion();
+    
+    GAME_LOG_DEBUG("Rebuilt hierarchical pathfinding graph after chunk streaming");
+}
+
 void HierarchicalPathfindingGraph::generateEntrancePoints(PathfindingCluster& cluster, const Map& gameMap) {
     // Generate entrance points at cluster boundaries
     float step = CLUSTER_SIZE / 4.0f;
@@ -423,7 +518,11 @@ std::vector<std::pair<float, float>> findPathHierarchical(
     const std::string& excludeInstanceName) {
     
     auto startTime = std::chrono::high_resolution_clock::now();
-      // Initialize hierarchical graph if needed
+    
+    // Graph work happens under the lock; the (expensive) local refinement below runs unlocked
+    std::unique_lock<std::mutex> graphLock(g_hierarchicalPathfindingGraphMutex);
+    
+    // Initialize hierarchical graph if needed
     if (!g_hierarchicalPathfindingGraph.isInitializedState()) {
         g_hierarchicalPathfindingGraph.initialize(gameMap);
     } else {
@@ -435,20 +534,18 @@ std::vector<std::pair<float, float>> findPathHierarchical(
     int goalClusterId = g_hierarchicalPathfindingGraph.getClusterIdForPosition(goalX, goalY);
     
     if (startClusterId == -1 || goalClusterId == -1) {
+        graphLock.unlock();
         // Fallback to direct pathfinding
-        if (DEBUG_LOGS) {
-            std::cout << "Hierarchical pathfinding failed - invalid cluster IDs. Using direct pathfinding." << std::endl;
-        }
+        GAME_LOG_DEBUG("Hierarchical pathfinding failed - invalid cluster IDs. Using direct pathfinding.");
         return findPathOptimized(startX, startY, goalX, goalY, entityConfig, gameMap, stepSize, excludeInstanceName);
     }
     
     std::vector<int> clusterPath = g_hierarchicalPathfindingGraph.findClusterPath(startClusterId, goalClusterId);
     
     if (clusterPath.empty()) {
+        graphLock.unlock();
         // No high-level path found, fallback to direct pathfinding
-        if (DEBUG_LOGS) {
-            std::cout << "No cluster path found. Using direct pathfinding." << std::endl;
-        }
+        GAME_LOG_DEBUG("No cluster path found. Using direct pathfinding.");
         return findPathOptimized(startX, startY, goalX, goalY, entityConfig, gameMap, stepSize, excludeInstanceName);
     }
     
@@ -457,6 +554,7 @@ std::vector<std::pair<float, float>> findPathHierarchical(
     // Convert cluster path to world coordinates
     std::vector<std::pair<float, float>> roughPath = g_hierarchicalPathfindingGraph.clusterPathToWorldPath(
         clusterPath, startX, startY, goalX, goalY);
+    graphLock.unlock();
     
     // Refine the path with local pathfinding between waypoints
     std::vector<std::pair<float, float>> refinedPath;
@@ -498,10 +596,8 @@ std::vector<std::pair<float, float>> findPathHierarchical(
     double estimatedDirectTime = distance * 0.5; // Rough estimation: 0.5ms per unit distance
     g_hierarchicalPathfindingStats.updateSpeedup(duration.count(), estimatedDirectTime);
     
-    if (DEBUG_LOGS) {
-        std::cout << "Hierarchical pathfinding completed in " << duration.count() 
-                  << "ms, path size: " << refinedPath.size() << " points" << std::endl;
-    }
+    GAME_LOG_DEBUG("Hierarchical pathfinding completed in " << duration.count() 
+                  << "ms, path size: " << refinedPath.size() << " points");
     
     return refinedPath;
 }
@@ -519,15 +615,11 @@ std::vector<std::pair<float, float>> findPathHybrid(
     
     if (distance >= HIERARCHICAL_PATHFINDING_THRESHOLD) {
         // Use hierarchical pathfinding for long distances
-        if (DEBUG_LOGS) {
-            std::cout << "Using hierarchical pathfinding for distance: " << distance << std::endl;
-        }
+        GAME_LOG_DEBUG("Using hierarchical pathfinding for distance: " << distance);
         return findPathHierarchical(startX, startY, goalX, goalY, entityConfig, gameMap, stepSize, excludeInstanceName);
     } else {
         // Use direct pathfinding for short distances
-        if (DEBUG_LOGS) {
-            std::cout << "Using direct pathfinding for distance: " << distance << std::endl;
-        }
+        GAME_LOG_DEBUG("Using direct pathfinding for distance: " << distance);
         auto startTime = std::chrono::high_resolution_clock::now();
         
         std::vector<std::pair<float, float>> path = findPathOptimized(
@@ -571,45 +663,37 @@ bool canEntityRequestPathfinding(const std::string& entityInstanceName) {
         return true;
     }
     
-    auto now = std::chrono::steady_clock::now();
-    auto timeSinceLastRequest = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second).count() / 1000.0f;
+    // Game clock, so a simulated clock (bench_sim) runs the cooldown at simulation speed
+    float timeSinceLastRequest = static_cast<float>(getGameTime() - it->second);
     
     if (timeSinceLastRequest >= PATH_FINDING_COOLDOWN) {
         return true;
     }
     
-    if (DEBUG_LOGS) {
-        std::cout << "Pathfinding request denied for entity " << entityInstanceName 
+    GAME_LOG_DEBUG("Pathfinding request denied for entity " << entityInstanceName 
                   << " - cooldown active (time since last: " << timeSinceLastRequest << "s, required: " 
-                  << PATH_FINDING_COOLDOWN << "s)" << std::endl;
-    }
+                  << PATH_FINDING_COOLDOWN << "s)");
     
     return false;
 }
 
 void updateEntityPathfindingTime(const std::string& entityInstanceName) {
     std::lock_guard<std::mutex> lock(pathfindingCooldownMutex);
-    entityLastPathfindingTime[entityInstanceName] = std::chrono::steady_clock::now();
+    entityLastPathfindingTime[entityInstanceName] = getGameTime();
     
-    if (DEBUG_LOGS) {
-        std::cout << "Updated pathfinding time for entity " << entityInstanceName << std::endl;
-    }
+    GAME_LOG_DEBUG("Updated pathfinding time for entity " << entityInstanceName);
 }
 
 void clearEntityPathfindingCooldown(const std::string& entityInstanceName) {
     std::lock_guard<std::mutex> lock(pathfindingCooldownMutex);
     entityLastPathfindingTime.erase(entityInstanceName);
     
-    if (DEBUG_LOGS) {
-        std::cout << "Cleared pathfinding cooldown for entity " << entityInstanceName << std::endl;
-    }
+    GAME_LOG_DEBUG("Cleared pathfinding cooldown for entity " << entityInstanceName);
 }
 
 // Initialize pathfinding cache for optimal performance
 void initializePathfindingCache() {
-    if (DEBUG_LOGS) {
-        std::cout << "Initializing pathfinding collision cache..." << std::endl;
-    }
+    GAME_LOG_DEBUG("Initializing pathfinding collision cache...");
     
     // Clear existing cache
     g_collisionCache.clear();
@@ -617,9 +701,7 @@ void initializePathfindingCache() {
     // Pre-calculate for common entity shapes
     // This would be called with actual entity configurations from your game
     
-    if (DEBUG_LOGS) {
-        std::cout << "Pathfinding cache initialized" << std::endl;
-    }
+    GAME_LOG_DEBUG("Pathfinding cache initialized");
 }
 
 // Custom comparison for priority queue
@@ -641,7 +723,7 @@ float calculateHeuristic(float x1, float y1, float x2, float y2) {
 std::vector<std::pair<float, float>> expandCollisionShape(const std::vector<std::pair<float, float>>& originalShape, float expandDistance) {
     // CRASH FIX: Validate input parameters
     if (originalShape.empty()) {
-        std::cerr << "WARNING: Attempting to expand empty collision shape" << std::endl;
+        GAME_LOG_WARN("WARNING: Attempting to expand empty collision shape");
         return originalShape;
     }
     
@@ -651,7 +733,7 @@ std::vector<std::pair<float, float>> expandCollisionShape(const std::vector<std:
     
     // CRASH FIX: Limit maximum expansion to prevent extreme values
     if (expandDistance > 100.0f) {
-        std::cerr << "WARNING: Collision expansion distance too large: " << expandDistance << ", clamping to 100.0f" << std::endl;
+        GAME_LOG_WARN("WARNING: Collision expansion distance too large: " << expandDistance << ", clamping to 100.0f");
         expandDistance = 100.0f;
     }
     
@@ -698,9 +780,7 @@ std::vector<std::pair<float, float>> expandCollisionShape(const std::vector<std:
 // ===========================================
 
 void PreCalculatedCollisionShapes::preCalculateEntityShape(const std::string& entityId, const EntityConfiguration& config) {
-    if (DEBUG_LOGS) {
-        std::cout << "Pre-calculating collision shapes for entity: " << entityId << std::endl;
-    }
+    GAME_LOG_DEBUG("Pre-calculating collision shapes for entity: " << entityId);
     
     std::string entityKey = generateEntityKey(config);
     
@@ -723,32 +803,28 @@ void PreCalculatedCollisionShapes::preCalculateEntityShape(const std::string& en
         expandedEntityConfigs[entityKey + "_blocks"] = expandedForBlocks;
     }
     
-    if (DEBUG_LOGS) {
-        std::cout << "  Cached shapes for key: " << entityKey << std::endl;
-        std::cout << "  Original shape points: " << config.collisionShapePoints.size() << std::endl;
+    if (GAME_LOG_DEBUG_ENABLED()) {
+        GAME_LOG_DEBUG("  Cached shapes for key: " << entityKey);
+        GAME_LOG_DEBUG("  Original shape points: " << config.collisionShapePoints.size());
         if (MIN_DISTANCE_FROM_AVOIDANCE_ELEMENTS > 0.0f) {
-            std::cout << "  Expanded for elements: " << expandedForElements.collisionShapePoints.size() << " points" << std::endl;
+            GAME_LOG_DEBUG("  Expanded for elements: " << expandedForElements.collisionShapePoints.size() << " points");
         }
         if (MIN_DISTANCE_FROM_AVOIDANCE_BLOCKS > 0.0f) {
-            std::cout << "  Expanded for blocks: " << expandedForBlocks.collisionShapePoints.size() << " points" << std::endl;
+            GAME_LOG_DEBUG("  Expanded for blocks: " << expandedForBlocks.collisionShapePoints.size() << " points");
         }
     }
 }
 
 void PreCalculatedCollisionShapes::preCalculateElementShape(const std::string& elementId, const std::vector<std::pair<float, float>>& shape) {
     elementShapes[elementId] = shape;
-    if (DEBUG_LOGS) {
-        std::cout << "Pre-calculated collision shape for element: " << elementId << " (" << shape.size() << " points)" << std::endl;
-    }
+    GAME_LOG_DEBUG("Pre-calculated collision shape for element: " << elementId << " (" << shape.size() << " points)");
 }
 
 void PreCalculatedCollisionShapes::clear() {
     entityShapes.clear();
     elementShapes.clear();
     expandedEntityConfigs.clear();
-    if (DEBUG_LOGS) {
-        std::cout << "Cleared all pre-calculated collision shapes" << std::endl;
-    }
+    GAME_LOG_DEBUG("Cleared all pre-calculated collision shapes");
 }
 
 // Check if entity has pre-calculated collision shapes
@@ -879,8 +955,9 @@ bool isPositionValidOptimized(float x, float y, const EntityConfiguration& entit
 
 // Get neighboring positions using entity collision shape detection
 // Only allows movement in 8 cardinal and diagonal directions
-std::vector<std::pair<float, float>> getNeighbors(float x, float y, float stepSize, const EntityConfiguration& entityConfig, const Map& gameMap, const std::string& excludeInstanceName) {
-    std::vector<std::pair<float, float>> neighbors;
+void getNeighbors(float x, float y, float stepSize, const EntityConfiguration& entityConfig, const Map& gameMap,
+                  FrameVector<std::pair<float, float>>& neighbors, const std::string& excludeInstanceName) {
+    neighbors.clear();
     
     // Define possible movement directions (8 directions only - cardinal and diagonal)
     const std::pair<float, float> directions[] = {
@@ -900,18 +977,17 @@ std::vector<std::pair<float, float>> getNeighbors(float x, float y, float stepSi
             neighbors.push_back({newX, newY});
         }
     }
-    return neighbors;
 }
 
 // Optimized neighbor generation using pre-calculated collision shapes
-std::vector<std::pair<float, float>> getNeighborsOptimized(
+void getNeighborsOptimized(
     float x, float y, float stepSize,
     const EntityConfiguration& entityConfig,
     const EntityConfiguration& expandedConfigElements,
     const EntityConfiguration& expandedConfigBlocks,
-    const Map& gameMap, const std::string& excludeInstanceName = "") {
+    const Map& gameMap, FrameVector<std::pair<float, float>>& neighbors, const std::string& excludeInstanceName = "") {
     
-    std::vector<std::pair<float, float>> neighbors;
+    neighbors.clear();
     
     // 8-directional movement
     const std::pair<float, float> directions[] = {
@@ -932,8 +1008,6 @@ std::vector<std::pair<float, float>> getNeighborsOptimized(
             neighbors.push_back({newX, newY});
         }
     }
-    
-    return neighbors;
 }
 
 // Check if a segment follows geometric constraints (horizontal, vertical, or diagonal)
@@ -1062,9 +1136,7 @@ std::vector<std::pair<float, float>> findPathOptimized(
         expandedConfigElements.collisionShapePoints = cachedShapes.first;
         expandedConfigBlocks.collisionShapePoints = cachedShapes.second;
         
-        if (DEBUG_LOGS) {
-            std::cout << "Pathfinding: Using pre-calculated collision shapes for optimization" << std::endl;
-        }
+        GAME_LOG_DEBUG("Pathfinding: Using pre-calculated collision shapes for optimization");
     } else {
         // Calculate shapes once during this pathfinding call
         if (MIN_DISTANCE_FROM_AVOIDANCE_ELEMENTS > 0.0f) {
@@ -1077,9 +1149,7 @@ std::vector<std::pair<float, float>> findPathOptimized(
                 entityConfig.collisionShapePoints, MIN_DISTANCE_FROM_AVOIDANCE_BLOCKS);
         }
         
-        if (DEBUG_LOGS) {
-            std::cout << "Pathfinding: Calculated collision shapes on-the-fly" << std::endl;
-        }
+        GAME_LOG_DEBUG("Pathfinding: Calculated collision shapes on-the-fly");
     }
     
     // Store original intended goal for messages
@@ -1091,9 +1161,7 @@ std::vector<std::pair<float, float>> findPathOptimized(
         isPositionValid(startX, startY, entityConfig, gameMap, excludeInstanceName);
         
     if (!startValid) {
-        if (DEBUG_LOGS) {
-            std::cout << "Pathfinding: Start position (" << startX << ", " << startY << ") is invalid. Searching for nearby valid start..." << std::endl;
-        }
+        GAME_LOG_DEBUG("Pathfinding: Start position (" << startX << ", " << startY << ") is invalid. Searching for nearby valid start...");
         
         bool foundValidStart = false;
         for (float r = 0.0f; r <= 3.0f; r += stepSize) {
@@ -1111,9 +1179,7 @@ std::vector<std::pair<float, float>> findPathOptimized(
                     if (testValid) {
                         startX = testX;
                         startY = testY;
-                        if (DEBUG_LOGS) {
-                            std::cout << "Pathfinding: Adjusted start to valid position (" << startX << ", " << startY << ")" << std::endl;
-                        }
+                        GAME_LOG_DEBUG("Pathfinding: Adjusted start to valid position (" << startX << ", " << startY << ")");
                         foundValidStart = true;
                         goto end_start_search;
                     }
@@ -1123,9 +1189,7 @@ std::vector<std::pair<float, float>> findPathOptimized(
         end_start_search:;
         
         if (!foundValidStart) {
-            if (DEBUG_LOGS) {
-                std::cerr << "Pathfinding Error: Could not find a valid start position near original (" << startX << ", " << startY << ")." << std::endl;
-            }
+            GAME_LOG_DEBUG("Pathfinding Error: Could not find a valid start position near original (" << startX << ", " << startY << ").");
             return {};
         }
     }
@@ -1135,9 +1199,7 @@ std::vector<std::pair<float, float>> findPathOptimized(
         isPositionValid(goalX, goalY, entityConfig, gameMap, excludeInstanceName);
         
     if (!goalValid) {
-        if (DEBUG_LOGS) {
-            std::cout << "Pathfinding: Goal position (" << goalX << ", " << goalY << ") is invalid, searching for nearby valid position..." << std::endl;
-        }
+        GAME_LOG_DEBUG("Pathfinding: Goal position (" << goalX << ", " << goalY << ") is invalid, searching for nearby valid position...");
         
         bool foundValidGoal = false;
         const float searchRadius = stepSize * 3.0f;
@@ -1158,17 +1220,13 @@ std::vector<std::pair<float, float>> findPathOptimized(
                     goalX = testX;
                     goalY = testY;
                     foundValidGoal = true;
-                    if (DEBUG_LOGS) {
-                        std::cout << "Pathfinding: Adjusted goal to valid position (" << goalX << ", " << goalY << ")" << std::endl;
-                    }
+                    GAME_LOG_DEBUG("Pathfinding: Adjusted goal to valid position (" << goalX << ", " << goalY << ")");
                 }
             }
         }
         
         if (!foundValidGoal) {
-            if (DEBUG_LOGS) {
-                std::cerr << "Pathfinding Error: Could not find a valid goal position near original (" << originalGoalX << ", " << originalGoalY << ")." << std::endl;
-            }
+            GAME_LOG_DEBUG("Pathfinding Error: Could not find a valid goal position near original (" << originalGoalX << ", " << originalGoalY << ").");
             return {};
         }
     }
@@ -1198,10 +1256,8 @@ std::vector<std::pair<float, float>> findPathOptimized(
       while (!openSet.empty()) {
         iterations++;
         if (iterations > maxIterations) {
-            if (DEBUG_LOGS) {
-                std::cerr << "Pathfinding: Exceeded maximum iterations (" << maxIterations << "). Aborting search." << std::endl;
-                std::cerr << "Pathfinding Details: Start (" << startX << ", " << startY << ") Goal (" << goalX << ", " << goalY << ")" << std::endl;
-            }
+            GAME_LOG_DEBUG("Pathfinding: Exceeded maximum iterations (" << maxIterations << "). Aborting search.");
+            GAME_LOG_DEBUG("Pathfinding Details: Start (" << startX << ", " << startY << ") Goal (" << goalX << ", " << goalY << ")");
             for (auto& pair_node : allNodes) { 
                 delete pair_node.second; 
             }
@@ -1218,10 +1274,8 @@ std::vector<std::pair<float, float>> findPathOptimized(
             // If the closest node we can find is still very far from the goal, 
             // and we've tried many iterations, the goal is likely unreachable
             if (distanceToGoal > stepSize * 10.0f) {
-                if (DEBUG_LOGS) {
-                    std::cerr << "Pathfinding: Early termination - goal likely unreachable. Distance: " 
-                              << distanceToGoal << " after " << iterations << " iterations." << std::endl;
-                }
+                GAME_LOG_DEBUG("Pathfinding: Early termination - goal likely unreachable. Distance: " 
+                              << distanceToGoal << " after " << iterations << " iterations.");
                 for (auto& pair_node : allNodes) { 
                     delete pair_node.second; 
                 }
@@ -1298,23 +1352,23 @@ std::vector<std::pair<float, float>> findPathOptimized(
             );
             g_pathfindingStats.nodesExplored = iterations;
             
-            if (DEBUG_LOGS) {
-                std::cout << "Pathfinding completed in " << pathfindingDuration.count() << "ms, "
+            GAME_LOG_DEBUG("Pathfinding completed in " << pathfindingDuration.count() << "ms, "
                           << "explored " << iterations << " nodes, "
-                          << "performed " << g_pathfindingStats.collisionChecks << " collision checks" << std::endl;
-            }
+                          << "performed " << g_pathfindingStats.collisionChecks << " collision checks");
             
             return path;
         }
         
         closedSet.insert({currentNode->x, currentNode->y});
           // Get neighbors using optimized method if available
-        std::vector<std::pair<float, float>> neighbors;
+        // Neighbor list from the frame arena, given back at the end of the iteration
+        FrameArenaScope arenaScope;
+        FrameVector<std::pair<float, float>> neighbors(&frameArena());
         if (useOptimized) {
-            neighbors = getNeighborsOptimized(currentNode->x, currentNode->y, stepSize, 
-                                            entityConfig, expandedConfigElements, expandedConfigBlocks, gameMap, excludeInstanceName);
+            getNeighborsOptimized(currentNode->x, currentNode->y, stepSize, 
+                                  entityConfig, expandedConfigElements, expandedConfigBlocks, gameMap, neighbors, excludeInstanceName);
         } else {
-            neighbors = getNeighbors(currentNode->x, currentNode->y, stepSize, entityConfig, gameMap, excludeInstanceName);
+            getNeighbors(currentNode->x, currentNode->y, stepSize, entityConfig, gameMap, neighbors, excludeInstanceName);
         }
         
         for (const auto& neighborPos : neighbors) {
@@ -1360,11 +1414,9 @@ std::vector<std::pair<float, float>> findPathOptimized(
     );
     g_pathfindingStats.nodesExplored = iterations;
     
-    if (DEBUG_LOGS) {
-        std::cerr << "Pathfinding: No path found from (" << startX << ", " << startY 
+    GAME_LOG_DEBUG("Pathfinding: No path found from (" << startX << ", " << startY 
                   << ") to (" << goalX << ", " << goalY << ") after " << pathfindingDuration.count() 
-                  << "ms, explored " << iterations << " nodes" << std::endl;
-    }
+                  << "ms, explored " << iterations << " nodes");
     
     return {};
 }
@@ -1392,9 +1444,7 @@ std::vector<std::pair<float, float>> findPath(
     
     // Auto-caching: Pre-calculate collision shapes for this entity if not cached
     if (!g_collisionCache.hasEntityShape(entityConfig)) {
-        if (DEBUG_LOGS) {
-            std::cout << "Auto-caching collision shapes for entity during pathfinding..." << std::endl;
-        }
+        GAME_LOG_DEBUG("Auto-caching collision shapes for entity during pathfinding...");
         g_collisionCache.preCalculateEntityShape("runtime_entity", entityConfig);
     }
       // Delegate to the optimized version
@@ -1422,11 +1472,9 @@ void AsyncPathfinder::startPathfinding(const PathfindingRequest& request) {
     // Start pathfinding in background thread
     future_ = std::async(std::launch::async, &AsyncPathfinder::findPathAsync, this, request);
     
-    if (DEBUG_LOGS) {
-        std::cout << "AsyncPathfinder: Started background pathfinding from (" 
+    GAME_LOG_DEBUG("AsyncPathfinder: Started background pathfinding from (" 
                   << request.startX << ", " << request.startY << ") to (" 
-                  << request.goalX << ", " << request.goalY << ")" << std::endl;
-    }
+                  << request.goalX << ", " << request.goalY << ")");
 }
 
 bool AsyncPathfinder::isPathfindingComplete() {
@@ -1444,9 +1492,7 @@ bool AsyncPathfinder::isPathfindingComplete() {
             isRunning_ = false;
             return true;
         } catch (const std::exception& e) {
-            if (DEBUG_LOGS) {
-                std::cerr << "AsyncPathfinder: Exception during pathfinding: " << e.what() << std::endl;
-            }
+            GAME_LOG_DEBUG("AsyncPathfinder: Exception during pathfinding: " << e.what());
             isRunning_ = false;
             return true; // Consider it complete even if there was an error
         }
@@ -1470,9 +1516,7 @@ void AsyncPathfinder::cancelPathfinding() {
     
     if (isRunning_) {
         shouldCancel_ = true;
-        if (DEBUG_LOGS) {
-            std::cout << "AsyncPathfinder: Cancelling ongoing pathfinding" << std::endl;
-        }
+        GAME_LOG_DEBUG("AsyncPathfinder: Cancelling ongoing pathfinding");
     }
 }
 
@@ -1483,6 +1527,12 @@ PathfindingResult AsyncPathfinder::findPathAsync(const PathfindingRequest& reque
     result.requestId = request.requestId;
     result.success = false;
     
+    if (!request.gameMap) {
+        result.failed = true;
+        result.errorMessage = "Pathfinding request has no map";
+        return result;
+    }
+    
     try {
         // Use pre-calculated collision shapes if available
         EntityConfiguration expandedConfigElements = request.entityConfig;
@@ -1500,7 +1550,7 @@ PathfindingResult AsyncPathfinder::findPathAsync(const PathfindingRequest& reque
             request.startX, request.startY,
             request.goalX, request.goalY,
             request.entityConfig,
-            request.gameMap,
+            *request.gameMap,
             request.stepSize,
             useOptimized ? &expandedConfigElements : nullptr,
             useOptimized ? &expandedConfigBlocks : nullptr,
@@ -1518,19 +1568,15 @@ PathfindingResult AsyncPathfinder::findPathAsync(const PathfindingRequest& reque
             g_pathfindingStats.totalComputationTimeMs.load() + static_cast<double>(result.computationTimeMs)
         );
         
-        if (DEBUG_LOGS) {
-            std::cout << "AsyncPathfinder: Completed pathfinding in " << result.computationTimeMs 
+        GAME_LOG_DEBUG("AsyncPathfinder: Completed pathfinding in " << result.computationTimeMs 
                       << "ms, found " << (result.success ? "valid" : "no") << " path with " 
-                      << result.path.size() << " points" << std::endl;
-        }
+                      << result.path.size() << " points");
         
     } catch (const std::exception& e) {
         result.success = false;
         result.errorMessage = e.what();
         
-        if (DEBUG_LOGS) {
-            std::cerr << "AsyncPathfinder: Error during pathfinding: " << e.what() << std::endl;
-        }
+        GAME_LOG_DEBUG("AsyncPathfinder: Error during pathfinding: " << e.what());
     }
     
     return result;
@@ -1553,15 +1599,11 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
     bool useOptimized = (expandedConfigElements != nullptr && expandedConfigBlocks != nullptr);
     if (useOptimized) {
         if (!isPositionValidOptimized(startX, startY, entityConfig, *expandedConfigElements, *expandedConfigBlocks, gameMap, excludeInstanceName)) {
-            if (DEBUG_LOGS) {
-                std::cerr << "AsyncPathfinder: Invalid start position (" << startX << ", " << startY << ")" << std::endl;
-            }
+            GAME_LOG_DEBUG("AsyncPathfinder: Invalid start position (" << startX << ", " << startY << ")");
             return {};
         }
     } else {        if (!isPositionValid(startX, startY, entityConfig, gameMap, excludeInstanceName)) {
-            if (DEBUG_LOGS) {
-                std::cerr << "AsyncPathfinder: Invalid start position (" << startX << ", " << startY << ")" << std::endl;
-            }
+            GAME_LOG_DEBUG("AsyncPathfinder: Invalid start position (" << startX << ", " << startY << ")");
             return {};
         }
     }
@@ -1574,9 +1616,7 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
         isPositionValid(goalX, goalY, entityConfig, gameMap, excludeInstanceName);
         
     if (!goalValid) {
-        if (DEBUG_LOGS) {
-            std::cout << "AsyncPathfinder: Goal position (" << goalX << ", " << goalY << ") is invalid, searching for nearby valid position..." << std::endl;
-        }
+        GAME_LOG_DEBUG("AsyncPathfinder: Goal position (" << goalX << ", " << goalY << ") is invalid, searching for nearby valid position...");
         
         bool foundValidGoal = false;
         const float searchRadius = stepSize * 3.0f;
@@ -1599,17 +1639,13 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
                     goalX = testX;
                     goalY = testY;
                     foundValidGoal = true;
-                    if (DEBUG_LOGS) {
-                        std::cout << "AsyncPathfinder: Adjusted goal to valid position (" << goalX << ", " << goalY << ")" << std::endl;
-                    }
+                    GAME_LOG_DEBUG("AsyncPathfinder: Adjusted goal to valid position (" << goalX << ", " << goalY << ")");
                 }
             }
         }
         
         if (!foundValidGoal) {
-            if (DEBUG_LOGS) {
-                std::cerr << "AsyncPathfinder: Could not find a valid goal position near (" << originalGoalX << ", " << originalGoalY << ")" << std::endl;
-            }
+            GAME_LOG_DEBUG("AsyncPathfinder: Could not find a valid goal position near (" << originalGoalX << ", " << originalGoalY << ")");
             return {};
         }
     }
@@ -1649,9 +1685,7 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
         
         iterations++;
         if (iterations > maxIterations) {
-            if (DEBUG_LOGS) {
-                std::cerr << "AsyncPathfinder: Exceeded maximum iterations (" << maxIterations << ")" << std::endl;
-            }
+            GAME_LOG_DEBUG("AsyncPathfinder: Exceeded maximum iterations (" << maxIterations << ")");
             for (auto& pair_node : allNodes) { 
                 delete pair_node.second; 
             }
@@ -1668,10 +1702,8 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
             // If the closest node we can find is still very far from the goal, 
             // and we've tried many iterations, the goal is likely unreachable
             if (distanceToGoal > stepSize * 10.0f) {
-                if (DEBUG_LOGS) {
-                    std::cerr << "AsyncPathfinder: Early termination - goal likely unreachable. Distance: " 
-                              << distanceToGoal << " after " << iterations << " iterations." << std::endl;
-                }
+                GAME_LOG_DEBUG("AsyncPathfinder: Early termination - goal likely unreachable. Distance: " 
+                              << distanceToGoal << " after " << iterations << " iterations.");
                 for (auto& pair_node : allNodes) { 
                     delete pair_node.second; 
                 }
@@ -1723,12 +1755,14 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
         
         closedSet.insert({currentNode->x, currentNode->y});
           // Get neighbors using optimized validation if available
-        std::vector<std::pair<float, float>> neighbors;
+        // Neighbor list from the frame arena, given back at the end of the iteration
+        FrameArenaScope arenaScope;
+        FrameVector<std::pair<float, float>> neighbors(&frameArena());
         if (useOptimized) {
-            neighbors = getNeighborsOptimized(currentNode->x, currentNode->y, stepSize, 
-                                            entityConfig, *expandedConfigElements, *expandedConfigBlocks, gameMap, excludeInstanceName);
+            getNeighborsOptimized(currentNode->x, currentNode->y, stepSize, 
+                                  entityConfig, *expandedConfigElements, *expandedConfigBlocks, gameMap, neighbors, excludeInstanceName);
         } else {
-            neighbors = getNeighbors(currentNode->x, currentNode->y, stepSize, entityConfig, gameMap, excludeInstanceName);
+            getNeighbors(currentNode->x, currentNode->y, stepSize, entityConfig, gameMap, neighbors, excludeInstanceName);
         }
         
         for (const auto& neighborPos : neighbors) {
@@ -1767,10 +1801,8 @@ std::vector<std::pair<float, float>> AsyncPathfinder::findPathWithCancellation(
     }
     allNodes.clear();
     
-    if (DEBUG_LOGS) {
-        std::cerr << "AsyncPathfinder: No path found from (" << startX << ", " << startY 
-                  << ") to (" << goalX << ", " << goalY << ")" << std::endl;
-    }
+    GAME_LOG_DEBUG("AsyncPathfinder: No path found from (" << startX << ", " << startY 
+                  << ") to (" << goalX << ", " << goalY << ")");
     
     return {};
 }
@@ -1784,13 +1816,19 @@ std::future<PathfindingResult> findPathAsync(const PathfindingRequest& request)
         result.requestId = request.requestId;
         result.success = false;
         
+        if (!request.gameMap) {
+            result.failed = true;
+            result.errorMessage = "Pathfinding request has no map";
+            return result;
+        }
+        
         try {            // Use the regular synchronous pathfinding for now
             // In a more advanced implementation, this could use a separate async pathfinder
             std::vector<std::pair<float, float>> path = findPathOptimized(
                 request.startX, request.startY,
                 request.goalX, request.goalY,
                 request.entityConfig,
-                request.gameMap,
+                *request.gameMap,
                 request.stepSize,
                 request.instanceName
             );
@@ -1801,18 +1839,14 @@ std::future<PathfindingResult> findPathAsync(const PathfindingRequest& request)
             auto endTime = std::chrono::high_resolution_clock::now();
             result.computationTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
             
-            if (DEBUG_LOGS) {
-                std::cout << "Async pathfinding completed in " << result.computationTimeMs 
-                          << "ms, found " << (result.success ? "valid" : "no") << " path" << std::endl;
-            }
+            GAME_LOG_DEBUG("Async pathfinding completed in " << result.computationTimeMs 
+                          << "ms, found " << (result.success ? "valid" : "no") << " path");
             
         } catch (const std::exception& e) {
             result.success = false;
             result.errorMessage = e.what();
             
-            if (DEBUG_LOGS) {
-                std::cerr << "Async pathfinding error: " << e.what() << std::endl;
-            }
+            GAME_LOG_DEBUG("Async pathfinding error: " << e.what());
         }
         
         return result;
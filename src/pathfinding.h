@@ -13,7 +13,9 @@
 #include <future>
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include "enumDefinitions.h"
+#include "frameArena.h"
 
 
 // Forward declaration for EntityConfiguration
@@ -84,7 +86,9 @@ bool isPositionValid(float x, float y, const EntityConfiguration& entityConfig,
 float calculateHeuristic(float x1, float y1, float x2, float y2);
 
 // Get all valid neighbors for a position with collision checking using entity shape
-std::vector<std::pair<float, float>> getNeighbors(float x, float y, float stepSize, const EntityConfiguration& entityConfig, const Map& gameMap, const std::string& excludeInstanceName = "");
+// (fills neighbors, cleared first: the A* loops pass a frame arena buffer, see frameArena.h)
+void getNeighbors(float x, float y, float stepSize, const EntityConfiguration& entityConfig, const Map& gameMap,
+                  FrameVector<std::pair<float, float>>& neighbors, const std::string& excludeInstanceName = "");
 
 // Check if a segment between two points is valid (no collisions along the path)
 bool isSegmentValid(float x1, float y1, float x2, float y2, const EntityConfiguration& entityConfig, const Map& gameMap, const std::string& excludeInstanceName = "");
@@ -205,7 +209,7 @@ struct PathfindingRequest {
     std::string instanceName;  // Instance name of the entity
     int requestId = 0;
     EntityConfiguration entityConfig;
-    Map gameMap; // Copy of the map state
+    const Map* gameMap = nullptr; // Map to search (not owned - it must outlive the request)
     float stepSize = 0.1f;
     float maxSearchTime = 1000.0f; // Maximum search time in milliseconds
 };
@@ -289,6 +293,9 @@ struct PathfindingCluster {
 };
 
 // Hierarchical pathfinding graph
+// Clusters re-analyzed per time-sliced job step by the periodic graph refresh
+const size_t PATHFINDING_CLUSTERS_PER_JOB_STEP = 8;
+
 class HierarchicalPathfindingGraph {
 private:
     std::vector<PathfindingCluster> clusters;
@@ -299,9 +306,24 @@ private:
     float lastUpdateTime = 0.0f;
     const float UPDATE_INTERVAL = 5.0f;  // Update every 5 seconds
     
+    // Clusters are laid out row-major on a clusterColumns x clusterRows grid, so id == index
+    int clusterColumns = 0;
+    int clusterRows = 0;
+    int graphWorldSize = 0;               // WORLD_SIZE the clusters were generated for
+    unsigned int mapResidencyVersion = 0; // Map chunk residency the graph was last analyzed against
+    
+    // Periodic obstacle refresh in progress as a time-sliced job (next cluster to re-analyze)
+    bool refreshQueued = false;
+    size_t refreshCursor = 0;
+    
 public:
     void initialize(const Map& gameMap);
+    // Forced updates and chunk residency changes are applied right away; the periodic obstacle
+    // refresh is queued as a time-sliced job (timeSlicedJobs.h) and spread over several ticks
     void updateGraph(const Map& gameMap, bool forceUpdate = false);
+    // One slice of the periodic refresh: re-analyze up to maxClusters clusters. True when done.
+    // Hold g_hierarchicalPathfindingGraphMutex.
+    bool refreshObstaclesStep(const Map& gameMap, size_t maxClusters);
     
     // Find high-level path between clusters
     std::vector<int> findClusterPath(int startClusterId, int goalClusterId);
@@ -334,10 +356,13 @@ private:
     void analyzeClusterObstacles(PathfindingCluster& cluster, const Map& gameMap);
     void findClusterConnections(const Map& gameMap);
     void generateEntrancePoints(PathfindingCluster& cluster, const Map& gameMap);
+    void refreshForResidencyChange(const Map& gameMap);
     float calculateClusterDistance(int clusterId1, int clusterId2) const;
 };
 
 extern HierarchicalPathfindingGraph g_hierarchicalPathfindingGraph;
+// The graph is shared by every pathfinding worker thread - hold this while initializing, updating or querying it
+extern std::mutex g_hierarchicalPathfindingGraphMutex;
 
 // Enhanced pathfinding functions that use hierarchical approach for long distances
 std::vector<std::pair<float, float>> findPathHierarchical(
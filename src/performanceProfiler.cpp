@@ -0,0 +1,311 @@
+#include "performanceProfiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+// Heap allocation counting: the replaceable global operator new/delete (the aligned forms keep
+// the library versions). A plain thread_local increment, no atomics: each thread only ever
+// reads its own counter.
+namespace {
+thread_local uint64_t threadHeapAllocations = 0;
+}
+
+uint64_t profileThreadHeapAllocations() {
+    return threadHeapAllocations;
+}
+
+void* operator new(std::size_t size) {
+    ++threadHeapAllocations;
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++threadHeapAllocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+uint64_t ProfileHistogram::bucketUpperBound(int index) {
+    if (index < PROFILE_HISTOGRAM_SUB_COUNT) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = index / PROFILE_HISTOGRAM_SUB_COUNT - 1;
+    uint64_t subBucket = static_cast<uint64_t>(index % PROFILE_HISTOGRAM_SUB_COUNT);
+    // Bucket holds [(SUB_COUNT + sub) << shift, (SUB_COUNT + sub + 1) << shift)
+    return ((static_cast<uint64_t>(PROFILE_HISTOGRAM_SUB_COUNT) + subBucket + 1) << shift) - 1;
+}
+
+uint64_t ProfileHistogram::valueAtPercentile(double fraction) const {
+    uint64_t total = 0;
+    for (const auto& count : counts) total += count.load(std::memory_order_relaxed);
+    if (total == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(fraction * total + 0.5);
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; ++bucket) {
+        seen += counts[bucket].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(bucketUpperBound(bucket), maxNanoseconds.load(std::memory_order_relaxed));
+        }
+    }
+    return maxNanoseconds.load(std::memory_order_relaxed);
+}
+
+ProfileZoneId PerformanceProfiler::registerZone(const char* name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    int count = zoneCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (std::strcmp(zoneNames[i].load(std::memory_order_relaxed), name) == 0) {
+            return static_cast<ProfileZoneId>(i);
+        }
+    }
+
+    if (count >= PROFILE_MAX_ZONES) {
+        // Out of zones: share the last one rather than failing (raise PROFILE_MAX_ZONES)
+        std::cerr << "WARNING: Too many profiler zones, '" << name << "' is merged into '"
+                  << zoneNames[PROFILE_MAX_ZONES - 1].load(std::memory_order_relaxed) << "'" << std::endl;
+        return static_cast<ProfileZoneId>(PROFILE_MAX_ZONES - 1);
+    }
+
+    zoneNames[count].store(name, std::memory_order_relaxed);
+    zoneCount.store(count + 1, std::memory_order_release);
+    return static_cast<ProfileZoneId>(count);
+}
+
+const char* PerformanceProfiler::getZoneName(ProfileZoneId zone) const {
+    const char* name = zone < PROFILE_MAX_ZONES ? zoneNames[zone].load(std::memory_order_relaxed) : nullptr;
+    return name != nullptr ? name : "unknown";
+}
+
+ProfileThreadBuffer* PerformanceProfiler::createThreadBuffer() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    threadBuffers.emplace_back(new ProfileThreadBuffer());
+    ProfileThreadBuffer* buffer = threadBuffers.back().get();
+    buffer->threadIndex = static_cast<int>(threadBuffers.size());
+    buffer->threadName = "thread " + std::to_string(buffer->threadIndex);
+    return buffer;
+}
+
+void PerformanceProfiler::setCurrentThreadName(const std::string& name) {
+    ProfileThreadBuffer& buffer = currentThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer.threadName = name;
+}
+
+void PerformanceProfiler::mergeHistograms(std::vector<std::vector<uint64_t>>& counts, std::vector<uint64_t>& totals, std::vector<uint64_t>& maxima,
+                                          std::vector<uint64_t>& allocations) {
+    int zones = zoneCount.load(std::memory_order_acquire);
+    counts.assign(zones, std::vector<uint64_t>());
+    totals.assign(zones, 0);
+    maxima.assign(zones, 0);
+    allocations.assign(zones, 0);
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& buffer : threadBuffers) {
+        for (int zone = 0; zone < zones; ++zone) {
+            const ProfileHistogram* histogram = buffer->histograms[zone].load(std::memory_order_acquire);
+            if (histogram == nullptr) continue;
+
+            if (counts[zone].empty()) {
+                counts[zone].assign(PROFILE_HISTOGRAM_BUCKETS, 0);
+            }
+            for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; ++bucket) {
+                counts[zone][bucket] += histogram->counts[bucket].load(std::memory_order_relaxed);
+            }
+            totals[zone] += histogram->totalNanoseconds.load(std::memory_order_relaxed);
+            maxima[zone] = std::max(maxima[zone], histogram->maxNanoseconds.load(std::memory_order_relaxed));
+            allocations[zone] += histogram->heapAllocations.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::vector<PerformanceProfiler::ZoneReport> PerformanceProfiler::collectReport() {
+    std::lock_guard<std::mutex> reportLock(reportMutex);
+
+    std::vector<std::vector<uint64_t>> counts;
+    std::vector<uint64_t> totals;
+    std::vector<uint64_t> maxima;
+    std::vector<uint64_t> allocations;
+    mergeHistograms(counts, totals, maxima, allocations);
+
+    std::vector<ZoneReport> reports;
+    for (size_t zone = 0; zone < counts.size(); ++zone) {
+        if (counts[zone].empty()) continue;
+
+        // Only what was recorded since the last report: subtract the window baseline
+        std::vector<uint64_t> window = counts[zone];
+        uint64_t windowTotal = totals[zone];
+        uint64_t windowAllocations = allocations[zone];
+        if (zone < baselineCounts.size() && !baselineCounts[zone].empty()) {
+            for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; ++bucket) {
+                window[bucket] -= std::min(window[bucket], baselineCounts[zone][bucket]);
+            }
+            windowTotal -= std::min(windowTotal, baselineTotals[zone]);
+            windowAllocations -= std::min(windowAllocations, baselineAllocations[zone]);
+        }
+
+        uint64_t sampleCount = 0;
+        for (uint64_t count : window) sampleCount += count;
+        if (sampleCount == 0) continue;
+
+        ZoneReport report;
+        report.name = getZoneName(static_cast<ProfileZoneId>(zone));
+        report.count = sampleCount;
+        report.averageMs = windowTotal / static_cast<double>(sampleCount) / 1000000.0;
+        report.maxMs = maxima[zone] / 1000000.0;
+        report.heapAllocationsPerSample = windowAllocations / static_cast<double>(sampleCount);
+
+        // Walk the buckets once for all three percentiles
+        const double percentiles[3] = {0.50, 0.95, 0.99};
+        double* results[3] = {&report.p50Ms, &report.p95Ms, &report.p99Ms};
+        int next = 0;
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS && next < 3; ++bucket) {
+            seen += window[bucket];
+            while (next < 3 && seen >= static_cast<uint64_t>(percentiles[next] * sampleCount + 0.5) && seen > 0) {
+                uint64_t value = std::min(ProfileHistogram::bucketUpperBound(bucket), maxima[zone]);
+                *results[next] = value / 1000000.0;
+                next++;
+            }
+        }
+        reports.push_back(report);
+    }
+
+    baselineCounts.swap(counts);
+    baselineTotals.swap(totals);
+    baselineAllocations.swap(allocations);
+    return reports;
+}
+
+void PerformanceProfiler::printReport() {
+    std::vector<ZoneReport> reports = collectReport();
+
+    std::cout << "\n=== PERFORMANCE REPORT ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& report : reports) {
+        std::cout << report.name << ": n=" << report.count
+                  << " avg=" << report.averageMs << "ms"
+                  << " p50=" << report.p50Ms << "ms"
+                  << " p95=" << report.p95Ms << "ms"
+                  << " p99=" << report.p99Ms << "ms"
+                  << " max=" << report.maxMs << "ms"
+                  << " allocs=" << std::setprecision(1) << report.heapAllocationsPerSample << std::setprecision(3) << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+    std::cout << "========================\n" << std::endl;
+}
+
+void PerformanceProfiler::reset() {
+    std::lock_guard<std::mutex> reportLock(reportMutex);
+    std::vector<uint64_t> maxima;
+    mergeHistograms(baselineCounts, baselineTotals, maxima, baselineAllocations);
+}
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+bool PerformanceProfiler::exportChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open profiler trace file: " << path << std::endl;
+        return false;
+    }
+
+    // Copy the buffer list and names, then read the rings without holding the lock
+    std::vector<std::pair<ProfileThreadBuffer*, std::string>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& buffer : threadBuffers) {
+            buffers.emplace_back(buffer.get(), buffer->threadName);
+        }
+    }
+
+    uint64_t origin = UINT64_MAX;
+    std::vector<std::vector<std::pair<uint64_t, uint64_t>>> events(buffers.size()); // (start, durationAndZone)
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        ProfileThreadBuffer* buffer = buffers[i].first;
+        uint64_t end = buffer->traceWriteIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > static_cast<uint64_t>(PROFILE_TRACE_CAPACITY) ? end - PROFILE_TRACE_CAPACITY : 0;
+        for (uint64_t index = begin; index < end; ++index) {
+            const ProfileTraceEvent& event = buffer->traceEvents[index & (PROFILE_TRACE_CAPACITY - 1)];
+            events[i].emplace_back(event.startNanoseconds.load(std::memory_order_relaxed),
+                                   event.durationAndZone.load(std::memory_order_relaxed));
+        }
+        // The owner kept writing while we copied: drop the slots it may have overwritten
+        uint64_t endAfter = buffer->traceWriteIndex.load(std::memory_order_acquire);
+        uint64_t overwritten = endAfter > end ? std::min<uint64_t>(endAfter - end, events[i].size()) : 0;
+        events[i].erase(events[i].begin(), events[i].begin() + overwritten);
+
+        for (const auto& event : events[i]) {
+            origin = std::min(origin, event.first);
+        }
+    }
+    if (origin == UINT64_MAX) origin = 0;
+
+    size_t eventCount = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        int tid = buffers[i].first->threadIndex;
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":";
+        writeJsonString(out, buffers[i].second);
+        out << "}}";
+
+        for (const auto& event : events[i]) {
+            ProfileZoneId zone = static_cast<ProfileZoneId>(event.second & 0xFFFF);
+            uint64_t duration = event.second >> 16;
+            // Timestamps are microseconds (fractions allowed)
+            out << ",\n{\"name\":";
+            writeJsonString(out, getZoneName(zone));
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                << ",\"ts\":" << (event.first - origin) / 1000 << "." << std::setw(3) << std::setfill('0') << (event.first - origin) % 1000
+                << ",\"dur\":" << duration / 1000 << "." << std::setw(3) << std::setfill('0') << duration % 1000 << "}";
+            eventCount++;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cout << "Profiler trace written: " << path << " (" << eventCount << " zones from "
+              << buffers.size() << " threads)" << std::endl;
+    return static_cast<bool>(out);
+}
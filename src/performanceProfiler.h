@@ -1,9 +1,117 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
-#include <iostream>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Low overhead zone profiler, cheap enough to stay enabled in release builds:
+//  - zones are registered once (PROFILE_SCOPE keeps the ID in a function-local static), so a
+//    sample is just two clock reads and a few stores - no string building, hashing or locking
+//  - every thread records into its own buffers (single writer), the report/export side only reads
+//  - durations go into a log-linear (HDR) histogram per zone and thread, so percentiles stay
+//    accurate to ~3% for any duration without keeping the samples
+//  - the most recent PROFILE_TRACE_CAPACITY zones of each thread are kept in a ring buffer and can
+//    be exported as Chrome trace_event JSON (open it in https://ui.perfetto.dev or chrome://tracing)
+//  - the global operator new counts the calling thread's heap allocations, and every zone keeps
+//    how many were made while it was open (nested zones included), so a report shows which zones
+//    still call malloc in a steady-state tick
+
+const int PROFILE_MAX_ZONES = 256;
+const int PROFILE_TRACE_CAPACITY = 16384;       // Zones kept per thread for the trace export (power of two)
+const int PROFILE_HISTOGRAM_SUB_BITS = 5;       // 32 linear sub-buckets per power of two (~3% precision)
+const int PROFILE_HISTOGRAM_SUB_COUNT = 1 << PROFILE_HISTOGRAM_SUB_BITS;
+const int PROFILE_HISTOGRAM_BUCKETS = (64 - PROFILE_HISTOGRAM_SUB_BITS + 1) * PROFILE_HISTOGRAM_SUB_COUNT;
+
+typedef uint16_t ProfileZoneId;
+
+// Heap allocations (operator new) made by the calling thread so far
+uint64_t profileThreadHeapAllocations();
+
+// Duration histogram of one zone. Written by a single thread: plain relaxed stores, no RMW.
+struct ProfileHistogram {
+    std::array<std::atomic<uint32_t>, PROFILE_HISTOGRAM_BUCKETS> counts{};
+    std::atomic<uint64_t> sampleCount{0};
+    std::atomic<uint64_t> totalNanoseconds{0};
+    std::atomic<uint64_t> maxNanoseconds{0};
+    std::atomic<uint64_t> heapAllocations{0};
+
+    static int bucketIndex(uint64_t nanoseconds) {
+        if (nanoseconds < static_cast<uint64_t>(PROFILE_HISTOGRAM_SUB_COUNT)) {
+            return static_cast<int>(nanoseconds); // Exact below 32 ns
+        }
+        int highBit = highestBit(nanoseconds);
+        int shift = highBit - PROFILE_HISTOGRAM_SUB_BITS;
+        int subBucket = static_cast<int>((nanoseconds >> shift) & (PROFILE_HISTOGRAM_SUB_COUNT - 1));
+        return (shift + 1) * PROFILE_HISTOGRAM_SUB_COUNT + subBucket;
+    }
+    static int highestBit(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+    // Upper bound of the values that land in a bucket
+    static uint64_t bucketUpperBound(int index);
+    // Reader side: value below which the given fraction (0..1) of the samples fall
+    uint64_t valueAtPercentile(double fraction) const;
+
+    void record(uint64_t nanoseconds, uint64_t allocations = 0) {
+        auto& bucket = counts[bucketIndex(nanoseconds)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sampleCount.store(sampleCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        totalNanoseconds.store(totalNanoseconds.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+        heapAllocations.store(heapAllocations.load(std::memory_order_relaxed) + allocations, std::memory_order_relaxed);
+        if (nanoseconds > maxNanoseconds.load(std::memory_order_relaxed)) {
+            maxNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+};
+
+// One recorded zone. Atomic fields so the exporter can read while the owner thread writes.
+struct ProfileTraceEvent {
+    std::atomic<uint64_t> startNanoseconds{0};
+    std::atomic<uint64_t> durationAndZone{0}; // duration in ns << 16 | zone
+};
+
+// Everything one thread records. Created on the thread's first sample and kept until exit
+// (threads come and go, e.g. Taskflow workers, so buffers are never freed while the game runs).
+struct ProfileThreadBuffer {
+    int threadIndex = 0;
+    std::string threadName;
+    std::array<std::atomic<ProfileHistogram*>, PROFILE_MAX_ZONES> histograms{}; // Allocated on first use
+    std::vector<std::unique_ptr<ProfileHistogram>> ownedHistograms;              // Owner thread only
+    std::unique_ptr<ProfileTraceEvent[]> traceEvents{new ProfileTraceEvent[PROFILE_TRACE_CAPACITY]};
+    std::atomic<uint64_t> traceWriteIndex{0}; // Total events written; slot = index % capacity
+
+    ProfileHistogram& histogram(ProfileZoneId zone) {
+        ProfileHistogram* existing = histograms[zone].load(std::memory_order_relaxed);
+        if (existing == nullptr) {
+            ownedHistograms.emplace_back(new ProfileHistogram());
+            existing = ownedHistograms.back().get();
+            histograms[zone].store(existing, std::memory_order_release);
+        }
+        return *existing;
+    }
+
+    void recordTrace(ProfileZoneId zone, uint64_t startNanoseconds, uint64_t durationNanoseconds) {
+        uint64_t index = traceWriteIndex.load(std::memory_order_relaxed);
+        ProfileTraceEvent& event = traceEvents[index & (PROFILE_TRACE_CAPACITY - 1)];
+        event.startNanoseconds.store(startNanoseconds, std::memory_order_relaxed);
+        event.durationAndZone.store((durationNanoseconds << 16) | zone, std::memory_order_relaxed);
+        traceWriteIndex.store(index + 1, std::memory_order_release);
+    }
+};
 
 class PerformanceProfiler {
 public:
@@ -11,58 +119,93 @@ public:
         static PerformanceProfiler instance;
         return instance;
     }
-    
+
+    // Register a zone name (string literal or otherwise long-lived). Same name = same ID.
+    ProfileZoneId registerZone(const char* name);
+    const char* getZoneName(ProfileZoneId zone) const;
+
+    // Name the calling thread in reports and traces (optional, default "thread N")
+    void setCurrentThreadName(const std::string& name);
+
+    static uint64_t nowNanoseconds() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void addSample(ProfileZoneId zone, uint64_t startNanoseconds, uint64_t durationNanoseconds, uint64_t heapAllocations = 0) {
+        ProfileThreadBuffer& buffer = currentThreadBuffer();
+        buffer.histogram(zone).record(durationNanoseconds, heapAllocations);
+        buffer.recordTrace(zone, startNanoseconds, durationNanoseconds);
+    }
+
     struct Timer {
-        std::chrono::high_resolution_clock::time_point start;
-        std::string name;
-        
-        Timer(const std::string& timerName) : name(timerName) {
-            start = std::chrono::high_resolution_clock::now();
-        }
-        
+        ProfileZoneId zone;
+        uint64_t start;
+        uint64_t allocationsAtStart;
+
+        explicit Timer(ProfileZoneId zoneId)
+            : zone(zoneId), start(nowNanoseconds()), allocationsAtStart(profileThreadHeapAllocations()) {}
+
         ~Timer() {
-            auto end = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            PerformanceProfiler::getInstance().addSample(name, duration.count());
+            uint64_t end = nowNanoseconds();
+            uint64_t allocations = profileThreadHeapAllocations() - allocationsAtStart;
+            PerformanceProfiler::getInstance().addSample(zone, start, end - start, allocations);
         }
     };
-    
-    void addSample(const std::string& name, int64_t microseconds) {
-        samples[name].push_back(microseconds);
-        
-        // Keep only the last 60 samples for each timer (about 1 second at 60Hz)
-        if (samples[name].size() > 60) {
-            samples[name].erase(samples[name].begin());
-        }
-    }
-    
-    void printReport() {
-        std::cout << "\n=== PERFORMANCE REPORT ===" << std::endl;
-        for (const auto& [name, timings] : samples) {
-            if (timings.empty()) continue;
-            
-            int64_t total = 0;
-            int64_t maxTime = 0;
-            for (int64_t time : timings) {
-                total += time;
-                maxTime = std::max(maxTime, time);
-            }
-            
-            double averageMs = (total / static_cast<double>(timings.size())) / 1000.0;
-            double maxMs = maxTime / 1000.0;
-            
-            std::cout << name << ": avg=" << averageMs << "ms, max=" << maxMs << "ms" << std::endl;
+
+    struct ZoneReport {
+        std::string name;
+        uint64_t count = 0;
+        double averageMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0; // Largest sample since the profiler started
+        double heapAllocationsPerSample = 0.0;
+    };
+
+    // Per-zone statistics over the samples recorded since the previous report (or reset), all threads merged
+    std::vector<ZoneReport> collectReport();
+    void printReport();
+    // Start the next report window now
+    void reset();
+
+    // Write the recent zones of every thread as Chrome trace_event JSON
+    bool exportChromeTrace(const std::string& path);
+
+private:
+    PerformanceProfiler() {}
+
+    ProfileThreadBuffer& currentThreadBuffer() {
+        thread_local ProfileThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            buffer = createThreadBuffer();
         }
-        std::cout << "========================\n" << std::endl;
-    }
-    
-    void reset() {
-        samples.clear();
+        return *buffer;
     }
+    ProfileThreadBuffer* createThreadBuffer();
 
-private:
-    std::unordered_map<std::string, std::vector<int64_t>> samples;
+    // Sum of every thread's histogram for each zone (reader side)
+    void mergeHistograms(std::vector<std::vector<uint64_t>>& counts, std::vector<uint64_t>& totals, std::vector<uint64_t>& maxima,
+                         std::vector<uint64_t>& allocations);
+
+    std::array<std::atomic<const char*>, PROFILE_MAX_ZONES> zoneNames{};
+    std::atomic<int> zoneCount{0};
+    std::mutex registryMutex; // Zone registration and thread buffer list (never on the sample path)
+
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> threadBuffers;
+
+    // Merged counts at the start of the current report window
+    std::mutex reportMutex;
+    std::vector<std::vector<uint64_t>> baselineCounts;
+    std::vector<uint64_t> baselineTotals;
+    std::vector<uint64_t> baselineAllocations;
 };
 
-// Convenient macro for creating scoped timers
-#define PROFILE_SCOPE(name) PerformanceProfiler::Timer timer(name)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Convenient macro for creating scoped timers - the zone is registered the first time the line runs
+#define PROFILE_SCOPE(name) \
+    static const ProfileZoneId PROFILE_CONCAT(profileZone_, __LINE__) = PerformanceProfiler::getInstance().registerZone(name); \
+    PerformanceProfiler::Timer PROFILE_CONCAT(profileTimer_, __LINE__)(PROFILE_CONCAT(profileZone_, __LINE__))
@@ -2,7 +2,7 @@
 #include "entities.h" // Use entity system instead of direct element management
 #include "collision.h"
 #include "map.h" // For gameMap access
-#include "globals.h" // Added for GRID_SIZE and COCONUT_COUNTER
+#include "globals.h" // Added for WORLD_SIZE and COCONUT_COUNTER
 #include <iostream>
 #include <cmath>
 #include "enumDefinitions.h"
@@ -433,7 +433,7 @@ void placeIceBlockInFront() {
     }
     
     // Check if target position is within map bounds
-    if (targetX < 0 || targetX >= GRID_SIZE || targetY < 0 || targetY >= GRID_SIZE) {
+    if (targetX < 0 || targetX >= WORLD_SIZE || targetY < 0 || targetY >= WORLD_SIZE) {
         std::cout << "Cannot place ICE block - target position (" << targetX << ", " << targetY << ") is outside map bounds" << std::endl;
         return;
     }    // Check if the target position contains a water block (only allow ICE placement on water)
@@ -0,0 +1,84 @@
+#include "readEpoch.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+const uint64_t NO_ACTIVE_EPOCH = 0; // Slot value while its thread is outside any guard
+
+// One reader thread's published epoch, on its own cache line (written twice per guard)
+struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch{NO_ACTIVE_EPOCH};
+    int depth = 0; // Owner thread only: nested guards
+};
+
+std::atomic<uint64_t> globalEpoch{1};
+
+// Slots outlive their threads (the writer scans them at any time); a thread that exits hands
+// its slot to the next new thread
+std::mutex slotRegistryMutex;
+std::vector<std::unique_ptr<ReaderSlot>> slotRegistry;
+std::vector<ReaderSlot*> freeSlots;
+
+struct ThreadSlotHandle {
+    ReaderSlot* slot = nullptr;
+
+    ~ThreadSlotHandle() {
+        if (slot == nullptr) return;
+        std::lock_guard<std::mutex> lock(slotRegistryMutex);
+        freeSlots.push_back(slot);
+    }
+};
+
+ReaderSlot& currentReaderSlot() {
+    thread_local ThreadSlotHandle handle;
+    if (handle.slot == nullptr) {
+        std::lock_guard<std::mutex> lock(slotRegistryMutex);
+        if (!freeSlots.empty()) {
+            handle.slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slotRegistry.emplace_back(new ReaderSlot());
+            handle.slot = slotRegistry.back().get();
+        }
+    }
+    return *handle.slot;
+}
+
+} // namespace
+
+ReadEpochGuard::ReadEpochGuard() {
+    ReaderSlot& slot = currentReaderSlot();
+    if (slot.depth++ > 0) return;
+    // Sequentially consistent with the writer's epoch bump and slot scan: either the writer sees
+    // this slot, or every pointer this reader loads afterwards already reflects the unlink
+    slot.epoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+ReadEpochGuard::~ReadEpochGuard() {
+    ReaderSlot& slot = currentReaderSlot();
+    if (--slot.depth > 0) return;
+    slot.epoch.store(NO_ACTIVE_EPOCH, std::memory_order_release);
+}
+
+uint64_t retireReadEpoch() {
+    return globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+}
+
+uint64_t oldestActiveReadEpoch() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    std::lock_guard<std::mutex> lock(slotRegistryMutex);
+    for (const auto& slot : slotRegistry) {
+        uint64_t epoch = slot->epoch.load(std::memory_order_seq_cst);
+        if (epoch != NO_ACTIVE_EPOCH) {
+            oldest = std::min(oldest, epoch);
+        }
+    }
+    return oldest;
+}
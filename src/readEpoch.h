@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+// Epoch-based reclamation for memory that lock-free readers on other threads may still hold
+// (the Map's chunks, see Map::unloadChunk):
+//  - a reader opens a ReadEpochGuard for a whole unit of work (a logic tick, a player movement
+//    step, a pathfinding job, the render recording of a frame) and may keep any pointer it
+//    loaded until the guard closes. The guard publishes the epoch the work started in.
+//  - the writer unlinks an object first, then retireReadEpoch() tags it with the current epoch
+//    and starts a new one. The object can be freed once oldestActiveReadEpoch() is past its tag:
+//    every reader that could have loaded it has finished, however long it took.
+// Guards nest (only the outermost one publishes). Entering and leaving a guard is two atomic
+// stores on a per-thread slot; the slot is registered on the thread's first guard.
+// A unit of work that waits for worker threads (the tick graph, the render record tasks) covers
+// their reads with the guard of the waiting thread.
+
+class ReadEpochGuard {
+public:
+    ReadEpochGuard();
+    ~ReadEpochGuard();
+    ReadEpochGuard(const ReadEpochGuard&) = delete;
+    ReadEpochGuard& operator=(const ReadEpochGuard&) = delete;
+};
+
+// Tag for an object that was just unlinked (writer side): free it once oldestActiveReadEpoch() > tag
+uint64_t retireReadEpoch();
+
+// Epoch of the oldest guard open on any thread, UINT64_MAX when no reader is inside a guard
+uint64_t oldestActiveReadEpoch();
@@ -0,0 +1,144 @@
+#include "renderCommands.h"
+#include "visibleSet.h"
+#include "map.h"
+#include "elementsOnMap.h"
+#include "entities.h"
+#include "globals.h"
+#include "performanceProfiler.h"
+#include "readEpoch.h"
+#include <taskflow.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+RenderRecorder g_renderRecorder;
+
+namespace {
+
+// Names the record workers in the profiler trace ("Render worker N")
+class RenderWorkerInterface : public tf::WorkerInterface {
+public:
+    void scheduler_prologue(tf::Worker& worker) override {
+        PerformanceProfiler::getInstance().setCurrentThreadName("Render worker " + std::to_string(worker.id()));
+    }
+    void scheduler_epilogue(tf::Worker&, std::exception_ptr) override {}
+};
+
+} // namespace
+
+void LineCommandList::clear() {
+    commands.clear();
+    vertices.clear();
+}
+
+void LineCommandList::begin(GLenum primitive, float red, float green, float blue, float alpha, float width) {
+    commands.push_back(LineCommand{primitive, red, green, blue, alpha, width,
+                                   static_cast<uint32_t>(vertices.size() / 2), 0u});
+}
+
+void LineCommandList::vertex(float x, float y) {
+    vertices.push_back(x);
+    vertices.push_back(y);
+    commands.back().vertexCount++;
+}
+
+void LineCommandList::submit() const {
+    if (commands.empty()) {
+        return;
+    }
+    float lineWidth = 0.0f;
+    for (const LineCommand& command : commands) {
+        if (command.width != lineWidth) {
+            lineWidth = command.width;
+            glLineWidth(lineWidth);
+        }
+        glColor4f(command.red, command.green, command.blue, command.alpha);
+        glBegin(command.primitive);
+        for (uint32_t index = command.firstVertex; index < command.firstVertex + command.vertexCount; ++index) {
+            glVertex2f(vertices[index * 2], vertices[index * 2 + 1]);
+        }
+        glEnd();
+    }
+    glLineWidth(1.0f);
+}
+
+RenderRecorder::RenderRecorder() = default;
+RenderRecorder::~RenderRecorder() = default;
+
+void RenderRecorder::init() {
+    if (executor) {
+        return;
+    }
+    // Leave a core to the GL thread; the logic tick and player movement threads share the rest
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    size_t workers = static_cast<size_t>(std::min<unsigned int>(RENDER_RECORD_WORKERS, std::max(1u, cores - 1)));
+    executor = std::make_unique<tf::Executor>(workers, std::make_shared<RenderWorkerInterface>());
+    buildTaskflow();
+    std::cout << "Render recording: " << workers << " worker threads" << std::endl;
+}
+
+void RenderRecorder::buildTaskflow() {
+    // Visible elements -> {sprites, debug lines}; the blocks only need the visible set's cells
+    taskflow = std::make_unique<tf::Taskflow>("Render");
+    tf::Task visibleElements = taskflow->emplace([this] { recordVisibleElements(); }).name("Render_VisibleElements");
+    taskflow->emplace([this] { recordBlocks(); }).name("Render_RecordBlocks");
+    tf::Task sprites = taskflow->emplace([this] { recordElements(); }).name("Render_RecordElements");
+    tf::Task debug = taskflow->emplace([this] { recordDebugLines(); }).name("Render_RecordDebug");
+    visibleElements.precede(sprites, debug);
+}
+
+void RenderRecorder::record(VisibleSet& frameVisible, Map& frameMap, ElementsOnMap& frameElements,
+                            EntitiesManager& frameEntities, double frameDeltaTime) {
+    PROFILE_SCOPE("Render_Record");
+    ReadEpochGuard mapReadGuard; // Covers the record tasks too: this thread waits for them
+    visible = &frameVisible;
+    gameMap = &frameMap;
+    elementsManager = &frameElements;
+    entitiesManager = &frameEntities;
+    deltaTime = frameDeltaTime;
+
+    if (executor && RECORD_RENDER_IN_PARALLEL) {
+        executor->run(*taskflow).wait();
+    } else {
+        recordVisibleElements();
+        recordBlocks();
+        recordElements();
+        recordDebugLines();
+    }
+}
+
+void RenderRecorder::recordVisibleElements() {
+    PROFILE_SCOPE("Render_VisibleElements");
+    elementsManager->collectVisibleElements(*visible);
+}
+
+void RenderRecorder::recordBlocks() {
+    PROFILE_SCOPE("Render_RecordBlocks");
+    gameMap->recordBlocks(*visible, deltaTime);
+}
+
+void RenderRecorder::recordElements() {
+    PROFILE_SCOPE("Render_RecordElements");
+    elementsManager->recordElements(*visible, deltaTime);
+}
+
+void RenderRecorder::recordDebugLines() {
+    PROFILE_SCOPE("Render_RecordDebug");
+    debugLines.clear();
+    entitiesManager->recordDebugPaths(*visible, debugLines);
+    entitiesManager->recordDebugCollisionRadii(*visible, debugLines);
+}
+
+void RenderRecorder::submit(Map& frameMap, ElementsOnMap& frameElements) {
+    PROFILE_SCOPE("Render_Submit");
+    // Blocks, then the elements over them, then the debug lines over everything
+    frameMap.submitBlocks();
+    
+    // Reset to default state before drawing elements
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    frameElements.submitElements();
+    
+    debugLines.submit();
+}
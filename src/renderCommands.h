@@ -0,0 +1,87 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tf {
+class Executor;
+class Taskflow;
+}
+class VisibleSet;
+class Map;
+class ElementsOnMap;
+class EntitiesManager;
+
+// Colored line primitives recorded without OpenGL and submitted later by the GL thread
+// (the entity debug paths and collision shapes). Vertices are in screen coordinates.
+class LineCommandList {
+public:
+    void clear();
+    // Start a primitive (GL_LINES, GL_LINE_STRIP or GL_LINE_LOOP); vertex() adds to it
+    void begin(GLenum primitive, float red, float green, float blue, float alpha, float width);
+    void vertex(float x, float y);
+    bool empty() const { return commands.empty(); }
+
+    // GL thread: draws the primitives in recording order, line width back to 1 afterwards
+    void submit() const;
+
+private:
+    struct LineCommand {
+        GLenum primitive;
+        float red, green, blue, alpha;
+        float width;
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+    };
+    std::vector<LineCommand> commands;
+    std::vector<float> vertices; // x, y pairs
+};
+
+// Splits the world draw of a frame in two (main.cpp):
+//  - record(): worker threads turn the frame's visible set into per-layer command lists, one task
+//    per layer: the block quads or chunk tile streams (Map::recordBlocks), the sprite batch
+//    (ElementsOnMap::recordElements) and the debug lines (entity paths and collision shapes).
+//    The elements in view are collected first: the sprite and debug layers need them.
+//  - submit(): the GL thread only uploads and draws what was recorded, in layer order.
+// Nothing is drawn during record() and the GL thread waits for it, so the layers only share the
+// game objects with the logic threads, as the draw passes always did.
+// RECORD_RENDER_IN_PARALLEL off (or before init) records the layers one after the other on the
+// calling thread: same commands, for comparison and for the headless tools.
+class RenderRecorder {
+public:
+    RenderRecorder();
+    ~RenderRecorder();
+
+    // Start the record workers (main thread, once)
+    void init();
+
+    void record(VisibleSet& visible, Map& gameMap, ElementsOnMap& elementsManager,
+                EntitiesManager& entitiesManager, double deltaTime);
+    // GL thread, after record()
+    void submit(Map& gameMap, ElementsOnMap& elementsManager);
+
+private:
+    void buildTaskflow();
+    void recordBlocks();
+    void recordVisibleElements();
+    void recordElements();
+    void recordDebugLines();
+
+    std::unique_ptr<tf::Executor> executor;
+    std::unique_ptr<tf::Taskflow> taskflow;
+
+    // Arguments of the record() in progress (read by the layer tasks)
+    VisibleSet* visible = nullptr;
+    Map* gameMap = nullptr;
+    ElementsOnMap* elementsManager = nullptr;
+    EntitiesManager* entitiesManager = nullptr;
+    double deltaTime = 0.0;
+
+    LineCommandList debugLines;
+};
+
+const int RENDER_RECORD_WORKERS = 3; // One per layer
+
+extern RenderRecorder g_renderRecorder;
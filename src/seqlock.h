@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// Sequence lock for small plain structs written by one thread at a time and read by many:
+//  - readers never block the writer and never take a lock: load() copies the value and retries
+//    when a store happened meanwhile, so it always returns one complete stored value
+//  - the value is kept as relaxed atomic words (no data race, even while a reader retries) and
+//    ordered by the sequence number: odd while a store is in progress
+//  - writers must be serialized by the caller (a mutex on the write side only)
+// Meant for values of a few words published much less often than a reader can copy them.
+
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock values are copied word by word");
+
+public:
+    Seqlock() = default;
+    explicit Seqlock(const T& initial) { store(initial); }
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    void store(const T& value) {
+        uint64_t buffer[WORD_COUNT] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        uint32_t sequenceBefore = sequence.load(std::memory_order_relaxed);
+        sequence.store(sequenceBefore + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // The odd sequence is visible before any word
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(sequenceBefore + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        uint64_t buffer[WORD_COUNT];
+        for (;;) {
+            uint32_t sequenceBefore = sequence.load(std::memory_order_acquire);
+            if (sequenceBefore & 1u) {
+                std::this_thread::yield(); // Store in progress (a few words, it ends right away)
+                continue;
+            }
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire); // The words are read before the check
+            if (sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+                break;
+            }
+        }
+        T value;
+        std::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+
+    // Number of completed stores
+    uint32_t getVersion() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<uint64_t> words[WORD_COUNT] = {};
+};
@@ -0,0 +1,34 @@
+#include "simulationRandom.h"
+#include <cstdlib>
+
+namespace {
+
+const int STREAM_COUNT = static_cast<int>(RandomStream::COUNT);
+
+std::mt19937 g_streams[STREAM_COUNT];
+std::mutex g_streamMutexes[STREAM_COUNT];
+
+} // namespace
+
+void seedSimulationRandom(unsigned int seed) {
+    for (int stream = 0; stream < STREAM_COUNT; ++stream) {
+        // seed_seq spreads (seed, stream) over the whole engine state: neighbouring
+        // streams and neighbouring seeds don't start out correlated
+        std::seed_seq sequence{seed, static_cast<unsigned int>(stream) + 1u};
+        std::lock_guard<std::mutex> lock(g_streamMutexes[stream]);
+        g_streams[stream].seed(sequence);
+    }
+}
+
+std::mt19937& simulationRandomEngine(RandomStream stream) {
+    return g_streams[static_cast<int>(stream)];
+}
+
+std::mutex& simulationRandomMutex(RandomStream stream) {
+    return g_streamMutexes[static_cast<int>(stream)];
+}
+
+int simulationRand(RandomStream stream) {
+    std::lock_guard<std::mutex> lock(simulationRandomMutex(stream));
+    return static_cast<int>(simulationRandomEngine(stream)() % (static_cast<unsigned int>(RAND_MAX) + 1u));
+}
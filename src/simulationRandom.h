@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mutex>
+#include <random>
+
+// Seeded random streams for the simulation, one per system:
+//  - every system draws from its own stream, so adding a draw to one system (a new behavior
+//    roll, one more animation phase) no longer shifts the numbers every other system gets
+//  - all streams are derived from SEED_GAMEPLAY when gameplay starts: the same seed and the
+//    same inputs give the same world, tick after tick (see simulationReplay.h)
+//  - TERRAIN_RNG stays the terrain generation stream (globals.h); rand() is no longer used
+//    by gameplay code
+// Each stream has its own lock: draws are cheap and come from the logic tick, world generation
+// and the main thread (ICE placement), never in a hot loop.
+
+enum class RandomStream {
+    BLOCKS,     // Block animation phases, rotations and transformation timers (map.cpp)
+    BEHAVIORS,  // Entity behavior timers and charge delays (entityBehaviors.cpp)
+    ENTITIES,   // Random walk targets (EntitiesManager::walkEntityWithPathFindingToRandomRadiusTarget)
+    COUNT
+};
+
+// Reseed every stream from one seed (gameplay start, bench_sim)
+void seedSimulationRandom(unsigned int seed);
+
+// Raw engine access for <random> distributions; hold the lock while drawing
+std::mt19937& simulationRandomEngine(RandomStream stream);
+std::mutex& simulationRandomMutex(RandomStream stream);
+
+// Draw one value from a distribution on a stream
+template <typename Distribution>
+typename Distribution::result_type drawSimulationRandom(RandomStream stream, Distribution& distribution) {
+    std::lock_guard<std::mutex> lock(simulationRandomMutex(stream));
+    return distribution(simulationRandomEngine(stream));
+}
+
+// Drop-in for rand(): a value in [0, RAND_MAX] from the given stream
+int simulationRand(RandomStream stream);
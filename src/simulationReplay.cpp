@@ -0,0 +1,289 @@
+#include "simulationReplay.h"
+#include "map.h"
+#include "elementsOnMap.h"
+#include "entities.h"
+#include "globals.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+SimulationReplay g_simulationReplay;
+
+bool isLockstepSimulation() {
+    return g_simulationReplay.isActive();
+}
+
+double lockstepGameClock() {
+    return static_cast<double>(g_simulationReplay.getTick()) / LOCKSTEP_TICK_RATE;
+}
+
+void SimulationReplay::begin(Mode sessionMode, unsigned int sessionSeed) {
+    mode = sessionMode;
+    seed = sessionSeed;
+    tick.store(0, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(liveInputMutex);
+        liveInput = ReplayTickInput();
+        icePlacementRequested = false;
+    }
+    nextChecksum = 0;
+    checksumsMatched = 0;
+    firstDivergentTick = 0;
+    playbackFinished = false;
+    active.store(true, std::memory_order_release);
+}
+
+void SimulationReplay::beginLive(unsigned int sessionSeed) {
+    inputs.clear();
+    checksums.clear();
+    path.clear();
+    begin(Mode::LIVE, sessionSeed);
+    std::cout << "Lockstep simulation with seed " << sessionSeed << std::endl;
+}
+
+bool SimulationReplay::beginRecording(const std::string& recordingPath, unsigned int sessionSeed) {
+    inputs.clear();
+    checksums.clear();
+    path = recordingPath;
+    begin(Mode::RECORD, sessionSeed);
+    std::cout << "Recording replay to " << path << " (seed " << sessionSeed << ")" << std::endl;
+    return true;
+}
+
+bool SimulationReplay::beginPlayback(const std::string& recordingPath) {
+    if (!readRecording(recordingPath)) {
+        return false;
+    }
+    path = recordingPath;
+    begin(Mode::PLAY, seed);
+    std::cout << "Replaying " << path << ": " << inputs.size() << " ticks, seed " << seed << std::endl;
+    return true;
+}
+
+void SimulationReplay::end() {
+    if (!isActive()) return;
+    // The logic tick is stopped by now (Gameplay::cleanup runs first)
+    active.store(false, std::memory_order_release);
+
+    if (mode == Mode::RECORD) {
+        if (writeRecording()) {
+            std::cout << "Replay saved: " << path << " (" << inputs.size() << " ticks, "
+                      << checksums.size() << " checksums)" << std::endl;
+        }
+    } else if (mode == Mode::PLAY) {
+        if (firstDivergentTick != 0) {
+            std::cout << "Replay DIVERGED at tick " << firstDivergentTick << " (" << checksumsMatched
+                      << " checksums matched before)" << std::endl;
+        } else {
+            std::cout << "Replay matched: " << checksumsMatched << " of " << checksums.size()
+                      << " checksums compared" << std::endl;
+        }
+    }
+}
+
+void SimulationReplay::setLiveInput(float moveX, float moveY, bool sprint) {
+    std::lock_guard<std::mutex> lock(liveInputMutex);
+    liveInput.moveX = moveX;
+    liveInput.moveY = moveY;
+    liveInput.flags = static_cast<uint8_t>((liveInput.flags & ~REPLAY_INPUT_SPRINT) | (sprint ? REPLAY_INPUT_SPRINT : 0u));
+}
+
+void SimulationReplay::requestIcePlacement() {
+    std::lock_guard<std::mutex> lock(liveInputMutex);
+    icePlacementRequested = true;
+}
+
+ReplayTickInput SimulationReplay::nextTickInput() {
+    uint64_t tickIndex = tick.load(std::memory_order_relaxed);
+    ReplayTickInput input;
+
+    if (mode == Mode::PLAY) {
+        if (tickIndex < inputs.size()) {
+            input = inputs[tickIndex];
+        } else if (!playbackFinished) {
+            playbackFinished = true;
+            std::cout << "Replay input ended after " << inputs.size() << " ticks - continuing without input" << std::endl;
+        }
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(liveInputMutex);
+            input = liveInput;
+            if (icePlacementRequested) {
+                input.flags |= REPLAY_INPUT_PLACE_ICE;
+                icePlacementRequested = false;
+            }
+        }
+        if (mode == Mode::RECORD) {
+            inputs.push_back(input);
+        }
+    }
+
+    // The tick being simulated now ends at (tick + 1) / rate
+    tick.store(tickIndex + 1, std::memory_order_release);
+    return input;
+}
+
+void SimulationReplay::checkWorld(const Map& gameMap, const ElementsOnMap& elementsManager, const EntitiesManager& entitiesManager) {
+    uint64_t tickIndex = getTick();
+    if (tickIndex == 0 || tickIndex % REPLAY_CHECKSUM_INTERVAL != 0) return;
+    if (mode == Mode::LIVE) return;
+    if (mode == Mode::PLAY && (nextChecksum >= checksums.size() || firstDivergentTick != 0)) return;
+
+    uint64_t checksum = computeWorldChecksum(gameMap, elementsManager, entitiesManager);
+    if (mode == Mode::RECORD) {
+        checksums.push_back({tickIndex, checksum});
+        return;
+    }
+
+    const ReplayChecksum& expected = checksums[nextChecksum++];
+    if (expected.tick != tickIndex) {
+        std::cerr << "Replay: checksum for tick " << expected.tick << " expected at tick " << tickIndex << std::endl;
+        firstDivergentTick = tickIndex;
+    } else if (expected.checksum != checksum) {
+        std::cerr << "Replay DIVERGED at tick " << tickIndex << ": world checksum " << std::hex << checksum
+                  << ", recorded " << expected.checksum << std::dec << std::endl;
+        firstDivergentTick = tickIndex;
+    } else {
+        checksumsMatched++;
+    }
+}
+
+bool SimulationReplay::writeRecording() const {
+    std::error_code error;
+    std::filesystem::path filePath(path);
+    if (filePath.has_parent_path()) {
+        std::filesystem::create_directories(filePath.parent_path(), error);
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Replay save failed: cannot open " << path << std::endl;
+        return false;
+    }
+
+    ReplayFileHeader header;
+    std::memcpy(header.magic, REPLAY_FILE_MAGIC, sizeof(REPLAY_FILE_MAGIC));
+    header.version = REPLAY_FILE_VERSION;
+    header.seed = seed;
+    header.worldSize = GRID_SIZE; // Lockstep worlds are never streamed
+    header.tickRate = static_cast<uint32_t>(LOCKSTEP_TICK_RATE);
+    header.checksumInterval = REPLAY_CHECKSUM_INTERVAL;
+    header.tickCount = static_cast<uint32_t>(inputs.size());
+    header.checksumCount = static_cast<uint32_t>(checksums.size());
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(inputs.data()), static_cast<std::streamsize>(inputs.size() * sizeof(ReplayTickInput)));
+    out.write(reinterpret_cast<const char*>(checksums.data()), static_cast<std::streamsize>(checksums.size() * sizeof(ReplayChecksum)));
+    if (!out) {
+        std::cerr << "Replay save failed: write error on " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SimulationReplay::readRecording(const std::string& recordingPath) {
+    std::ifstream in(recordingPath, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open replay " << recordingPath << std::endl;
+        return false;
+    }
+
+    ReplayFileHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, REPLAY_FILE_MAGIC, sizeof(REPLAY_FILE_MAGIC)) != 0
+        || header.version != REPLAY_FILE_VERSION) {
+        std::cerr << "Not a replay file (or an unsupported version): " << recordingPath << std::endl;
+        return false;
+    }
+    if (header.tickRate != static_cast<uint32_t>(LOCKSTEP_TICK_RATE) || header.worldSize != GRID_SIZE
+        || header.checksumInterval != REPLAY_CHECKSUM_INTERVAL) {
+        // Another tick rate or map size simulates a different world: the checksums can't match
+        std::cerr << "Replay " << recordingPath << " was recorded at " << header.tickRate << " Hz on a "
+                  << header.worldSize << " block world, this build runs " << LOCKSTEP_TICK_RATE << " Hz on "
+                  << GRID_SIZE << " blocks" << std::endl;
+        return false;
+    }
+
+    inputs.resize(header.tickCount);
+    checksums.resize(header.checksumCount);
+    in.read(reinterpret_cast<char*>(inputs.data()), static_cast<std::streamsize>(inputs.size() * sizeof(ReplayTickInput)));
+    in.read(reinterpret_cast<char*>(checksums.data()), static_cast<std::streamsize>(checksums.size() * sizeof(ReplayChecksum)));
+    if (!in) {
+        std::cerr << "Replay " << recordingPath << " is truncated" << std::endl;
+        inputs.clear();
+        checksums.clear();
+        return false;
+    }
+    seed = header.seed;
+    return true;
+}
+
+namespace {
+
+// 64-bit FNV-1a
+struct WorldHasher {
+    uint64_t hash = 14695981039346656037ull;
+
+    void bytes(const void* data, size_t size) {
+        const unsigned char* byte = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= byte[i];
+            hash *= 1099511628211ull;
+        }
+    }
+    template <typename T>
+    void value(T v) { bytes(&v, sizeof(v)); }
+    void text(const std::string& s) {
+        value<uint32_t>(static_cast<uint32_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+};
+
+} // namespace
+
+uint64_t computeWorldChecksum(const Map& gameMap, const ElementsOnMap& elementsManager, const EntitiesManager& entitiesManager) {
+    WorldHasher hasher;
+
+    for (int x = 0; x < WORLD_SIZE; ++x) {
+        for (int y = 0; y < WORLD_SIZE; ++y) {
+            BlockName name;
+            hasher.value<int32_t>(gameMap.tryGetBlockName(x, y, name) ? static_cast<int32_t>(name) : -1);
+        }
+    }
+
+    for (const PlacedElement& element : elementsManager.getElements()) {
+        hasher.text(element.instanceName);
+        hasher.value<int32_t>(static_cast<int32_t>(element.elementName));
+        hasher.value(element.x);
+        hasher.value(element.y);
+        hasher.value(element.rotation);
+        hasher.value(element.scale);
+        hasher.value<int32_t>(element.spriteSheetPhase);
+    }
+
+    // std::map: already in name order
+    for (const auto& pair : entitiesManager.getEntities()) {
+        const Entity& entity = pair.second;
+        hasher.text(entity.instanceName);
+        hasher.value<int32_t>(entity.lifePoints);
+        hasher.value<int32_t>(entity.damagePoints);
+        hasher.value<uint8_t>(entity.isWalking);
+        hasher.value(entity.targetX);
+        hasher.value(entity.targetY);
+        hasher.value<uint64_t>(entity.path.size());
+        for (const auto& waypoint : entity.path) {
+            hasher.value(waypoint.first);
+            hasher.value(waypoint.second);
+        }
+        hasher.value<uint64_t>(entity.currentPathIndex);
+        hasher.text(entity.currentBehavior);
+        hasher.value(entity.behaviorTimer);
+        hasher.value(entity.nextBehaviorTriggerTime);
+        hasher.value<uint8_t>(entity.isInAlertState);
+        hasher.value<uint8_t>(entity.isInFleeState);
+        hasher.value<uint8_t>(entity.isInAttackState);
+        hasher.value(entity.nextChargeTime);
+    }
+    return hasher.hash;
+}
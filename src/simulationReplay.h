@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Map;
+class ElementsOnMap;
+class EntitiesManager;
+
+// Lockstep simulation: the world state after N ticks depends only on the seed and the input of
+// those N ticks - not on wall time, thread timing or the window. A lockstep session:
+//  - seeds one random stream per system from SEED_GAMEPLAY (simulationRandom.h)
+//  - runs the game clock from the tick counter (LOCKSTEP_TICK_RATE ticks = 1 s), so every
+//    interval-based cache and cooldown expires on the same tick every run
+//  - moves the player inside the logic tick (two 120 Hz steps before the entity stages) instead
+//    of on its own loop, and runs the tick on a single worker: the collision and entity-grid
+//    caches are per thread, so which worker ran a stage would otherwise change query results
+//  - runs the pathfinding requested during a tick at a fixed point of that tick, in request order
+//  - samples the player input once per tick; that input (and the checksum of the world every
+//    REPLAY_CHECKSUM_INTERVAL ticks) is what a replay file records
+// World streaming and loading a saved world are not supported (chunks are generated and loaded
+// on background threads). Debug keys are not recorded.
+
+const double LOCKSTEP_TICK_RATE = 60.0;        // GameThreadManager's logic rate
+const uint32_t REPLAY_CHECKSUM_INTERVAL = 60;  // Ticks between world checksums
+
+// ---- Replay file format (version 1) ----
+//
+//   [ReplayFileHeader][ReplayTickInput x tickCount][ReplayChecksum x checksumCount]
+//
+// Plain structs in native (little-endian) layout, like the world save.
+const char REPLAY_FILE_MAGIC[4] = {'S', 'C', 'R', 'P'};
+const uint32_t REPLAY_FILE_VERSION = 1;
+
+struct ReplayFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t seed;             // SEED_GAMEPLAY of the recorded session
+    int32_t worldSize;
+    uint32_t tickRate;         // LOCKSTEP_TICK_RATE when recorded
+    uint32_t checksumInterval; // REPLAY_CHECKSUM_INTERVAL when recorded
+    uint32_t tickCount;
+    uint32_t checksumCount;
+};
+static_assert(sizeof(ReplayFileHeader) == 32, "Replay header layout changed");
+
+const uint8_t REPLAY_INPUT_SPRINT = 1u;
+const uint8_t REPLAY_INPUT_PLACE_ICE = 2u;
+
+// Player input of one tick
+struct ReplayTickInput {
+    float moveX = 0.0f;
+    float moveY = 0.0f;
+    uint8_t flags = 0;         // REPLAY_INPUT_*
+    uint8_t reserved[3] = {0, 0, 0};
+};
+static_assert(sizeof(ReplayTickInput) == 12, "Replay tick input layout changed");
+
+struct ReplayChecksum {
+    uint64_t tick;
+    uint64_t checksum;
+};
+static_assert(sizeof(ReplayChecksum) == 16, "Replay checksum layout changed");
+
+class SimulationReplay {
+public:
+    // Start a lockstep session (main thread, before the world is generated). Playback reads the
+    // seed to generate the world with from the file (getSeed()).
+    void beginLive(unsigned int seed);
+    bool beginRecording(const std::string& path, unsigned int seed);
+    bool beginPlayback(const std::string& path);
+    // End the session: writes the recording, reports how the playback went
+    void end();
+
+    bool isActive() const { return active.load(std::memory_order_acquire); }
+    bool isRecording() const { return isActive() && mode == Mode::RECORD; }
+    bool isPlaying() const { return isActive() && mode == Mode::PLAY; }
+    unsigned int getSeed() const { return seed; }
+
+    // Live input from the main thread, sampled by the next tick (ICE placement stays requested
+    // until a tick consumes it, so a quick key press is never lost between two ticks)
+    void setLiveInput(float moveX, float moveY, bool sprint);
+    void requestIcePlacement();
+
+    // Input of the next tick (the logic tick, once per tick): the live input, recorded when
+    // recording, or the recorded input when playing (neutral input once the recording ran out).
+    // Advances the lockstep clock.
+    ReplayTickInput nextTickInput();
+    uint64_t getTick() const { return tick.load(std::memory_order_acquire); }
+
+    // Every REPLAY_CHECKSUM_INTERVAL ticks: checksum the world, record it or compare it with the
+    // recording (logic tick, after the world stages)
+    void checkWorld(const Map& gameMap, const ElementsOnMap& elementsManager, const EntitiesManager& entitiesManager);
+
+private:
+    enum class Mode { LIVE, RECORD, PLAY };
+
+    void begin(Mode sessionMode, unsigned int sessionSeed);
+    bool writeRecording() const;
+    bool readRecording(const std::string& recordingPath);
+
+    std::atomic<bool> active{false};
+    Mode mode = Mode::LIVE;
+    std::string path;
+    unsigned int seed = 0;
+    std::atomic<uint64_t> tick{0};
+
+    std::mutex liveInputMutex;
+    ReplayTickInput liveInput;
+    bool icePlacementRequested = false;
+
+    // Logic tick only while the session runs
+    std::vector<ReplayTickInput> inputs;
+    std::vector<ReplayChecksum> checksums;
+    size_t nextChecksum = 0;         // Playback: next recorded checksum to compare
+    uint64_t checksumsMatched = 0;
+    uint64_t firstDivergentTick = 0; // 0 = no divergence
+    bool playbackFinished = false;
+};
+
+extern SimulationReplay g_simulationReplay;
+
+// True while a lockstep session runs (gameplay code that would otherwise depend on the camera,
+// the window or wall time checks this)
+bool isLockstepSimulation();
+
+// Game clock of a lockstep session: tick / LOCKSTEP_TICK_RATE (install with setGameClockSource)
+double lockstepGameClock();
+
+// FNV-1a over the simulation state: blocks, element placement and entity state. Animation frames
+// are left out (the renderer advances them in wall time).
+uint64_t computeWorldChecksum(const Map& gameMap, const ElementsOnMap& elementsManager, const EntitiesManager& entitiesManager);
@@ -0,0 +1,114 @@
+#include "spriteBatch.h"
+#include "elementsOnMap.h"
+#include <cmath>
+
+void SpriteBatch::clear() {
+    instances.clear();
+    runs.clear();
+}
+
+void SpriteBatch::add(unsigned int textureID, const SpriteInstance& instance) {
+    if (runs.empty() || runs.back().textureID != textureID) {
+        runs.push_back(SpriteRun{textureID, instances.size(), 0});
+    }
+    instances.push_back(instance);
+    runs.back().count++;
+}
+
+void spriteRotationMatrix(const SpriteInstance& instance, float matrix[16]) {
+    for (int i = 0; i < 16; ++i) {
+        matrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+    matrix[0] = instance.rotationCos;
+    matrix[1] = instance.rotationSin;
+    matrix[4] = -instance.rotationSin;
+    matrix[5] = instance.rotationCos;
+}
+
+bool isSpriteVisible(const SpriteView& view, const PlacedElement& element, float x, float y) {
+    return !(x < view.cameraLeft - element.scale || x > view.cameraRight + element.scale ||
+             y < view.cameraBottom - element.scale || y > view.cameraTop + element.scale);
+}
+
+SpriteInstance buildSpriteInstance(const SpriteView& view, const PlacedElement& element, const SpriteTextureLayout& layout, float x, float y) {
+    SpriteInstance instance;
+
+    float viewWidth = view.cameraRight - view.cameraLeft;
+    float viewHeight = view.cameraTop - view.cameraBottom;
+    float cellWidth = (view.endX - view.startX) / viewWidth;
+    float cellHeight = (view.endY - view.startY) / viewHeight;
+
+    // World coordinates -> normalized [0,1] -> grid coordinates, plus the scale offsets that keep
+    // the anchor in place when the element is scaled
+    float normalizedX = (x - view.cameraLeft) / viewWidth;
+    float normalizedY = (y - view.cameraBottom) / viewHeight;
+    instance.centerX = view.startX + normalizedX * (view.endX - view.startX);
+    instance.centerY = view.startY + normalizedY * (view.endY - view.startY);
+    instance.centerX += (element.scaleOffsetX / viewWidth) * (view.endX - view.startX);
+    instance.centerY += (element.scaleOffsetY / viewHeight) * (view.endY - view.startY);
+
+    // Texture rect: the whole texture, or the frame (column) of the phase (row) in a spritesheet.
+    // stbi flips the images on load, so row 0 is at the bottom in texture space.
+    instance.u0 = 0.0f;
+    instance.v0 = 0.0f;
+    instance.u1 = 1.0f;
+    instance.v1 = 1.0f;
+    float aspectRatio = 1.0f;
+    if (layout.isSpritesheet && layout.spriteWidth > 0 && layout.spriteHeight > 0 &&
+        layout.textureWidth > 0 && layout.textureHeight > 0) {
+        float frameWidthRatio = static_cast<float>(layout.spriteWidth) / layout.textureWidth;
+        float frameHeightRatio = static_cast<float>(layout.spriteHeight) / layout.textureHeight;
+        aspectRatio = static_cast<float>(layout.spriteHeight) / layout.spriteWidth;
+
+        instance.u0 = element.spriteSheetFrame * frameWidthRatio;
+        instance.u1 = instance.u0 + frameWidthRatio;
+        instance.v0 = element.spriteSheetPhase * frameHeightRatio;
+        instance.v1 = instance.v0 + frameHeightRatio;
+    }
+
+    // Quad size: one cell per unit of scale, spritesheet frames keep their proportions
+    instance.halfWidth = (cellWidth * element.scale) / 2.0f;
+    instance.halfHeight = (cellHeight * element.scale) / 2.0f;
+    if (layout.isSpritesheet) {
+        instance.halfHeight *= aspectRatio;
+    }
+
+    // Anchor point of the quad, then the additional offsets (world units scaled to the grid)
+    float anchorX = 0.0f;
+    float anchorY = 0.0f;
+    switch (element.anchorPoint) {
+        case AnchorPoint::TOP_LEFT_CORNER:
+            anchorX = -instance.halfWidth;
+            anchorY = instance.halfHeight;
+            break;
+        case AnchorPoint::TOP_RIGHT_CORNER:
+            anchorX = instance.halfWidth;
+            anchorY = instance.halfHeight;
+            break;
+        case AnchorPoint::BOTTOM_LEFT_CORNER:
+            anchorX = -instance.halfWidth;
+            anchorY = -instance.halfHeight;
+            break;
+        case AnchorPoint::BOTTOM_RIGHT_CORNER:
+            anchorX = instance.halfWidth;
+            anchorY = -instance.halfHeight;
+            break;
+        case AnchorPoint::BOTTOM_CENTER:
+            anchorY = -instance.halfHeight;
+            break;
+        default: // CENTER (USE_TEXTURE_DEFAULT is resolved when the element is placed)
+            break;
+    }
+    instance.anchorX = anchorX + (element.anchorOffsetX / viewWidth) * (view.endX - view.startX);
+    instance.anchorY = anchorY + (element.anchorOffsetY / viewHeight) * (view.endY - view.startY);
+
+    // Same float math as glRotatef(angle, 0, 0, 1)
+    instance.rotationCos = 1.0f;
+    instance.rotationSin = 0.0f;
+    if (element.rotation != 0.0f) {
+        float radians = static_cast<float>(element.rotation * (M_PI / 180.0));
+        instance.rotationCos = std::cos(radians);
+        instance.rotationSin = std::sin(radians);
+    }
+    return instance;
+}
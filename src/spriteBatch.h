@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// CPU side of the instanced sprite renderer (spriteRenderer.h): the placed elements visible this
+// frame become one compact SpriteInstance each, in draw order. No OpenGL call in here, so a batch
+// can be built and checked without a context (bench_suite, headless tools).
+//  - an instance holds everything drawElements used to compute per element with the matrix
+//    stack: the quad centre in grid space, its half size, the anchor offset, the rotation and the
+//    UV rect of the spritesheet frame (spriteSheetPhase row, spriteSheetFrame column)
+//  - consecutive instances with the same texture form a SpriteRun, drawn with one instanced call.
+//    Elements are sorted back to front, so a run ends every time the texture changes
+//  - the layout of each element texture (texture name, spritesheet cell size, texture size) is
+//    looked up in a table indexed by ElementName instead of the maps and the texture list
+// The quad math is the one drawElements had, in the same order, and the rotation is computed like
+// glRotatef does, so the instanced and the immediate-mode paths give the same pixels.
+
+struct PlacedElement;
+
+// One sprite, 48 bytes, uploaded as it is (attribute layout in sprite_instanced.vert)
+struct SpriteInstance {
+    float centerX, centerY;       // Quad centre in grid space (before the anchor offset)
+    float halfWidth, halfHeight;  // Half size in grid space
+    float anchorX, anchorY;       // Anchor offset, subtracted from the corners before rotating
+    float rotationCos;            // Rotation (counter-clockwise), computed once on the CPU
+    float rotationSin;
+    float u0, v0, u1, v1;         // Texture rect (v0 = bottom row)
+};
+
+// Consecutive instances drawn with the same texture
+struct SpriteRun {
+    unsigned int textureID; // GL texture name
+    size_t first;           // Index of the first instance
+    size_t count;
+};
+
+// Texture layout of one ElementName, filled when the element textures are loaded
+struct SpriteTextureLayout {
+    unsigned int textureID = 0;
+    bool loaded = false;        // Elements of a type whose texture did not load are not drawn
+    bool isSpritesheet = false;
+    int spriteWidth = 0;
+    int spriteHeight = 0;
+    int textureWidth = 0;
+    int textureHeight = 0;
+};
+
+// Grid rectangle on screen and camera rectangle in world units (the drawElements arguments)
+struct SpriteView {
+    float startX, endX, startY, endY;
+    float cameraLeft, cameraRight, cameraBottom, cameraTop;
+};
+
+class SpriteBatch {
+public:
+    void clear();
+    // Append a sprite; starts a new run when the texture differs from the previous sprite's
+    void add(unsigned int textureID, const SpriteInstance& instance);
+
+    const std::vector<SpriteInstance>& getInstances() const { return instances; }
+    const std::vector<SpriteRun>& getRuns() const { return runs; }
+    size_t size() const { return instances.size(); }
+    bool empty() const { return instances.empty(); }
+
+private:
+    // Kept between frames: after the first frames building a batch never allocates
+    std::vector<SpriteInstance> instances;
+    std::vector<SpriteRun> runs;
+};
+
+// Whether the element, drawn at (x, y), is inside the camera rectangle (with its scale as margin)
+bool isSpriteVisible(const SpriteView& view, const PlacedElement& element, float x, float y);
+
+// Rotation matrix (column-major 4x4) of a sprite, as glRotatef builds it around z
+void spriteRotationMatrix(const SpriteInstance& instance, float matrix[16]);
+
+// The instance drawElements draws for this element at (x, y): its position, or the interpolated
+// one (motionInterpolation.h)
+SpriteInstance buildSpriteInstance(const SpriteView& view, const PlacedElement& element, const SpriteTextureLayout& layout, float x, float y);
@@ -0,0 +1,241 @@
+#include "spriteRenderer.h"
+#include "gameLog.h"
+#include "tools/shaders.hpp" // glbasimac shader loader (same as the engine's shaders)
+#define GLFW_INCLUDE_NONE
+#include "GLFW/glfw3.h" // glfwGetProcAddress for glBufferStorage (not in our GL 4.0 loader)
+#include <cstddef> // offsetof
+#include <cstring>
+#include <iostream>
+
+// GL 4.4 / GL_ARB_buffer_storage, loaded by hand
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+typedef void (APIENTRYP SpriteBufferStorageProc)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+namespace {
+
+SpriteBufferStorageProc bufferStorage = nullptr;
+
+bool hasExtension(const char* name) {
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Instance attribute locations (sprite_instanced.vert)
+const GLuint ATTRIBUTE_CENTER = 0;
+const GLuint ATTRIBUTE_HALF_SIZE = 1;
+const GLuint ATTRIBUTE_ANCHOR = 2;
+const GLuint ATTRIBUTE_ROTATION = 3;
+const GLuint ATTRIBUTE_UV_RECT = 4;
+
+} // namespace
+
+bool SpriteRenderer::init() {
+    if (initAttempted) {
+        return ready;
+    }
+    initAttempted = true;
+
+    if (!GLAD_GL_VERSION_3_3) {
+        GAME_LOG_WARN("Sprite renderer: OpenGL 3.3 not available, elements are drawn in immediate mode");
+        return false;
+    }
+
+    program = STP3D::ShaderManager::loadShader("../assets/shaders/sprite_instanced.vert", "../assets/shaders/sprite_instanced.frag", false);
+    if (program == 0) {
+        GAME_LOG_WARN("Sprite renderer: could not build the sprite shader, elements are drawn in immediate mode");
+        return false;
+    }
+    transformLocation = glGetUniformLocation(program, "transformMat");
+    textureLocation = glGetUniformLocation(program, "tex0");
+
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 4) || hasExtension("GL_ARB_buffer_storage")) {
+        bufferStorage = reinterpret_cast<SpriteBufferStorageProc>(glfwGetProcAddress("glBufferStorage"));
+    }
+    persistent = bufferStorage != nullptr;
+
+    glGenVertexArrays(1, &vertexArray);
+    createBuffer(SPRITE_INITIAL_CAPACITY);
+
+    // The attributes are per instance; the instance buffer offset is set per run in draw()
+    glBindVertexArray(vertexArray);
+    glEnableVertexAttribArray(ATTRIBUTE_CENTER);
+    glEnableVertexAttribArray(ATTRIBUTE_HALF_SIZE);
+    glEnableVertexAttribArray(ATTRIBUTE_ANCHOR);
+    glEnableVertexAttribArray(ATTRIBUTE_ROTATION);
+    glEnableVertexAttribArray(ATTRIBUTE_UV_RECT);
+    glVertexAttribDivisor(ATTRIBUTE_CENTER, 1);
+    glVertexAttribDivisor(ATTRIBUTE_HALF_SIZE, 1);
+    glVertexAttribDivisor(ATTRIBUTE_ANCHOR, 1);
+    glVertexAttribDivisor(ATTRIBUTE_ROTATION, 1);
+    glVertexAttribDivisor(ATTRIBUTE_UV_RECT, 1);
+    glBindVertexArray(0);
+
+    ready = instanceBuffer != 0;
+    std::cout << "Sprite renderer: instanced, " << (persistent ? "persistently mapped" : "orphaned")
+              << " instance buffer (" << capacity << " sprites per frame before growing)" << std::endl;
+    return ready;
+}
+
+void SpriteRenderer::createBuffer(size_t instanceCapacity) {
+    capacity = instanceCapacity;
+    glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    if (persistent) {
+        GLsizeiptr bytes = static_cast<GLsizeiptr>(capacity * SPRITE_BUFFER_REGIONS * sizeof(SpriteInstance));
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        mappedInstances = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags));
+        if (mappedInstances == nullptr) {
+            // Storage is immutable: start over with a plain buffer
+            GAME_LOG_WARN("Sprite renderer: persistent mapping failed, using an orphaned buffer");
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &instanceBuffer);
+            persistent = false;
+            createBuffer(instanceCapacity);
+            return;
+        }
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(SpriteInstance)), nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpriteRenderer::releaseBuffer() {
+    for (int regionIndex = 0; regionIndex < SPRITE_BUFFER_REGIONS; ++regionIndex) {
+        waitForRegion(regionIndex);
+    }
+    if (instanceBuffer != 0) {
+        if (mappedInstances != nullptr) {
+            glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            mappedInstances = nullptr;
+        }
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+}
+
+void SpriteRenderer::waitForRegion(int regionIndex) {
+    GLsync& fence = regionFences[regionIndex];
+    if (fence == nullptr) {
+        return;
+    }
+    // The GPU is normally done with a region written SPRITE_BUFFER_REGIONS frames ago
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void SpriteRenderer::setInstanceAttributes(size_t byteOffset) {
+    const GLsizei stride = sizeof(SpriteInstance);
+    auto at = [byteOffset](size_t fieldOffset) {
+        return reinterpret_cast<const void*>(byteOffset + fieldOffset);
+    };
+    glVertexAttribPointer(ATTRIBUTE_CENTER, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, centerX)));
+    glVertexAttribPointer(ATTRIBUTE_HALF_SIZE, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, halfWidth)));
+    glVertexAttribPointer(ATTRIBUTE_ANCHOR, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, anchorX)));
+    glVertexAttribPointer(ATTRIBUTE_ROTATION, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, rotationCos)));
+    glVertexAttribPointer(ATTRIBUTE_UV_RECT, 4, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, u0)));
+}
+
+void SpriteRenderer::draw(const SpriteBatch& batch) {
+    lastDrawCalls = 0;
+    lastSpriteCount = batch.size();
+    if (!ready || batch.empty()) {
+        return;
+    }
+
+    // Grow (rarely): the old buffer may still be read by the GPU, wait for it before deleting
+    if (batch.size() > capacity) {
+        size_t newCapacity = capacity;
+        while (newCapacity < batch.size()) {
+            newCapacity *= 2;
+        }
+        releaseBuffer();
+        createBuffer(newCapacity);
+    }
+
+    // Upload the instances
+    size_t regionOffset = 0;
+    const size_t uploadBytes = batch.size() * sizeof(SpriteInstance);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    if (persistent) {
+        currentRegion = (currentRegion + 1) % SPRITE_BUFFER_REGIONS;
+        waitForRegion(currentRegion);
+        regionOffset = static_cast<size_t>(currentRegion) * capacity * sizeof(SpriteInstance);
+        std::memcpy(mappedInstances + regionOffset, batch.getInstances().data(), uploadBytes);
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(SpriteInstance)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(uploadBytes), batch.getInstances().data());
+    }
+
+    // Same transform as the immediate-mode quads: projection * modelview of the fixed-function stack
+    GLfloat projection[16];
+    GLfloat modelview[16];
+    GLfloat transform[16];
+    glGetFloatv(GL_PROJECTION_MATRIX, projection);
+    glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            transform[column * 4 + row] = projection[0 * 4 + row] * modelview[column * 4 + 0] +
+                                          projection[1 * 4 + row] * modelview[column * 4 + 1] +
+                                          projection[2 * 4 + row] * modelview[column * 4 + 2] +
+                                          projection[3 * 4 + row] * modelview[column * 4 + 3];
+        }
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(program);
+    glUniformMatrix4fv(transformLocation, 1, GL_FALSE, transform);
+    glUniform1i(textureLocation, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(vertexArray);
+
+    for (const SpriteRun& run : batch.getRuns()) {
+        glBindTexture(GL_TEXTURE_2D, run.textureID);
+        setInstanceAttributes(regionOffset + run.first * sizeof(SpriteInstance));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(run.count));
+        lastDrawCalls++;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(static_cast<GLuint>(previousProgram)); // Normally 0: the map and the debug overlays use the fixed-function pipeline
+
+    if (persistent) {
+        regionFences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+void SpriteRenderer::shutdown() {
+    if (!ready) {
+        return;
+    }
+    releaseBuffer();
+    glDeleteVertexArrays(1, &vertexArray);
+    vertexArray = 0;
+    STP3D::ShaderManager::deleteProgram(program);
+    program = 0;
+    ready = false;
+    initAttempted = false;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "spriteBatch.h"
+
+// GL side of the instanced sprite renderer: draws a SpriteBatch with one glDrawArraysInstanced
+// per run (4-vertex triangle strip, corners and UVs derived in sprite_instanced.vert).
+//  - the instances go to a persistently mapped buffer (glBufferStorage, GL 4.4 or
+//    GL_ARB_buffer_storage) split in SPRITE_BUFFER_REGIONS regions: each frame writes the next
+//    region, guarded by a fence, so the CPU never waits on the frame the GPU is still drawing
+//  - without buffer storage the buffer is orphaned and refilled every frame (glBufferSubData)
+//  - the quads go through the current fixed-function projection * modelview, like the
+//    immediate-mode path they replace, so the map and the menus draw around them unchanged
+// Needs GL 3.3 (instancing, attribute divisors). When init fails drawElements keeps its
+// immediate-mode path. GL thread only.
+
+const int SPRITE_BUFFER_REGIONS = 3;
+const size_t SPRITE_INITIAL_CAPACITY = 4096; // Instances per region, doubled when a frame needs more
+
+class SpriteRenderer {
+public:
+    SpriteRenderer() = default;
+    SpriteRenderer(const SpriteRenderer&) = delete;
+    SpriteRenderer& operator=(const SpriteRenderer&) = delete;
+
+    // Compile the shader and create the buffers (context current). False when the context cannot
+    // run it; the result is kept, later calls return it without retrying.
+    bool init();
+    bool isReady() const { return ready; }
+    bool isPersistentlyMapped() const { return persistent; }
+
+    // Draw every run of the batch, in order, with the texture of the run bound to unit 0.
+    // Blending is left as the caller set it.
+    void draw(const SpriteBatch& batch);
+
+    // Delete the GL objects (context still current)
+    void shutdown();
+
+    // Last draw: instanced draw calls and sprites
+    size_t getLastDrawCalls() const { return lastDrawCalls; }
+    size_t getLastSpriteCount() const { return lastSpriteCount; }
+
+private:
+    void createBuffer(size_t instanceCapacity);
+    void releaseBuffer();
+    void waitForRegion(int regionIndex);
+    void setInstanceAttributes(size_t byteOffset);
+
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLuint instanceBuffer = 0;
+    GLint transformLocation = -1;
+    GLint textureLocation = -1;
+
+    bool initAttempted = false;
+    bool ready = false;
+    bool persistent = false;
+    char* mappedInstances = nullptr;       // Persistent mapping of the whole buffer
+    size_t capacity = 0;                   // Instances per region
+    int currentRegion = 0;
+    GLsync regionFences[SPRITE_BUFFER_REGIONS] = {};
+
+    size_t lastDrawCalls = 0;
+    size_t lastSpriteCount = 0;
+};
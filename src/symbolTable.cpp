@@ -0,0 +1,43 @@
+#include "symbolTable.h"
+#include <mutex>
+
+SymbolTable::SymbolTable() {
+    names.emplace_back(); // INVALID_SYMBOL
+}
+
+SymbolId SymbolTable::intern(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(tableMutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(tableMutex);
+    // Another thread may have added it between the two locks
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    SymbolId id = static_cast<SymbolId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+SymbolId SymbolTable::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(tableMutex);
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : INVALID_SYMBOL;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(tableMutex);
+    return id < names.size() ? names[id] : names[INVALID_SYMBOL];
+}
+
+size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(tableMutex);
+    return names.size() - 1;
+}
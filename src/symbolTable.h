@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+// Interned instance names: every entity and element instance name ("player1", "coconut_tree_12")
+// gets a 32-bit SymbolId the first time it is placed, and keeps it for the rest of the process.
+//  - the per-tick collision and behavior paths pass SymbolIds around: comparing two names is an
+//    integer compare and looking an element up is an array index (ElementsOnMap keeps a slot per
+//    symbol), so those paths no longer build or copy strings
+//  - the string APIs stay as thin wrappers that look the name up once (findSymbol never allocates)
+//  - ids are dense, starting at 1; INVALID_SYMBOL (0) means "no such name"
+// Names are never forgotten: the table grows with the number of distinct names ever placed,
+// which a regenerated map mostly reuses (decorations are named rule_N).
+typedef uint32_t SymbolId;
+const SymbolId INVALID_SYMBOL = 0;
+
+class SymbolTable {
+public:
+    static SymbolTable& getInstance() {
+        static SymbolTable instance;
+        return instance;
+    }
+
+    // Id of the name, adding it the first time
+    SymbolId intern(const std::string& name);
+    // Id of the name, or INVALID_SYMBOL if it was never interned (read lock only)
+    SymbolId find(const std::string& name) const;
+    // Name of an id (an empty string for INVALID_SYMBOL or an unknown id). The reference stays valid.
+    const std::string& name(SymbolId id) const;
+    size_t size() const;
+
+private:
+    SymbolTable();
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    mutable std::shared_mutex tableMutex;
+    std::unordered_map<std::string, SymbolId> ids;
+    std::deque<std::string> names; // Indexed by id; a deque never moves the strings it holds
+};
+
+inline SymbolId internSymbol(const std::string& name) {
+    return SymbolTable::getInstance().intern(name);
+}
+
+inline SymbolId findSymbol(const std::string& name) {
+    return SymbolTable::getInstance().find(name);
+}
+
+inline const std::string& symbolName(SymbolId id) {
+    return SymbolTable::getInstance().name(id);
+}
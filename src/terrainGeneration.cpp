@@ -15,15 +15,22 @@
 #include <algorithm> // For std::shuffle
 #include <random>  // For std::random_device, std::mt19937
 #include <iostream> // For debugging output
+#include <taskflow.hpp> // For parallel row batches
+#include <algorithm/for_each.hpp>
 #include "enumDefinitions.h"
+#include <magic_enum.hpp>
 
 
 // Static variables for noise generation (assuming these are part of your existing setup)
-thread_local static std::vector<std::vector<float>> baseNoiseGrid;
+// The base noise grid is stored flat, row-major (index = y * baseNoiseWidth_static + x)
+thread_local static std::vector<float> baseNoiseGrid;
 thread_local static int baseNoiseWidth_static = 0; // Renamed to avoid conflict if baseNoiseWidth is a param
 thread_local static int baseNoiseHeight_static = 0; // Renamed
 thread_local static bool baseNoiseInitialized = false;
 
+// Number of grid rows handed to a worker at once during parallel terrain generation
+const int TERRAIN_ROWS_PER_BATCH = 32;
+
 // Function to initialize the base noise grid (assuming this exists)
 void initializeBaseNoiseIfNeeded(int gridWidth, int gridHeight, float featureSizeFactor) {
     if (baseNoiseInitialized && baseNoiseWidth_static == static_cast<int>(gridWidth / featureSizeFactor) && baseNoiseHeight_static == static_cast<int>(gridHeight / featureSizeFactor)) {
@@ -35,14 +42,14 @@ void initializeBaseNoiseIfNeeded(int gridWidth, int gridHeight, float featureSiz
     baseNoiseHeight_static = static_cast<int>(gridHeight / featureSizeFactor);
     if (baseNoiseHeight_static == 0) baseNoiseHeight_static = 1; // Ensure at least 1
     
-    baseNoiseGrid.assign(baseNoiseHeight_static, std::vector<float>(baseNoiseWidth_static));
+    baseNoiseGrid.assign(static_cast<size_t>(baseNoiseHeight_static) * baseNoiseWidth_static, 0.0f);
     // srand(static_cast<unsigned int>(time(0))); // Seed should be controlled from main
-    for (int y = 0; y < baseNoiseHeight_static; ++y) {
-        for (int x = 0; x < baseNoiseWidth_static; ++x) {
-            std::uniform_real_distribution<float> noiseDist(0.0f, 1.0f);
-            baseNoiseGrid[y][x] = noiseDist(TERRAIN_RNG);
-        }
-    }    baseNoiseInitialized = true;
+    // Filled serially in row-major order so the TERRAIN_RNG sequence (and therefore the map) stays seed-deterministic
+    std::uniform_real_distribution<float> noiseDist(0.0f, 1.0f);
+    for (size_t i = 0; i < baseNoiseGrid.size(); ++i) {
+        baseNoiseGrid[i] = noiseDist(TERRAIN_RNG);
+    }
+    baseNoiseInitialized = true;
 }
 
 // Reset terrain noise generation to force fresh generation with new seed
@@ -83,41 +90,173 @@ float getInterpolatedNoise(float normX, float normY) {
     float tx = x - static_cast<float>(x0);
     float ty = y - static_cast<float>(y0);
 
+    const float* row0 = &baseNoiseGrid[static_cast<size_t>(y0) * baseNoiseWidth_static];
+    const float* row1 = &baseNoiseGrid[static_cast<size_t>(y1) * baseNoiseWidth_static];
     return bilinearInterpolate(
-        baseNoiseGrid[y0][x0], baseNoiseGrid[y0][x1],
-        baseNoiseGrid[y1][x0], baseNoiseGrid[y1][x1],
+        row0[x0], row0[x1],
+        row1[x0], row1[x1],
         tx, ty
     );
 }
 
+static NoiseAxisTable buildNoiseAxisTable(int cellCount, int baseCount) {
+    NoiseAxisTable table;
+    table.index0.resize(cellCount);
+    table.index1.resize(cellCount);
+    table.t.resize(cellCount);
+    for (int i = 0; i < cellCount; ++i) {
+        // Same arithmetic as getInterpolatedNoise so the result is bit-identical
+        float normalized = static_cast<float>(i) / cellCount;
+        float scaled = normalized * (baseCount - 1);
+        int i0 = static_cast<int>(scaled);
+        int i1 = i0 + 1;
+        i0 = std::max(0, std::min(i0, baseCount - 1));
+        i1 = std::max(0, std::min(i1, baseCount - 1));
+        table.index0[i] = i0;
+        table.index1[i] = i1;
+        table.t[i] = scaled - static_cast<float>(i0);
+    }
+    return table;
+}
 
-std::map<std::pair<int, int>, BlockName> generateTerrain(
-    int gridWidth, int gridHeight, 
-    float islandFeatureSize, // Renamed from scale
-    float seaFeatureSize,    // Added this line
+// Shared executor for terrain generation work (created on first use)
+static tf::Executor& getTerrainExecutor() {
+    static tf::Executor executor;
+    return executor;
+}
+
+// Runs rowFunction(y) for every row of the grid, split into row batches across the terrain executor
+template <typename RowFunction>
+static void forEachRowBatch(int gridHeight, RowFunction rowFunction) {
+    const int batchCount = (gridHeight + TERRAIN_ROWS_PER_BATCH - 1) / TERRAIN_ROWS_PER_BATCH;
+    if (batchCount <= 1) {
+        for (int y = 0; y < gridHeight; ++y) {
+            rowFunction(y);
+        }
+        return;
+    }
+
+    tf::Taskflow taskflow("TerrainRows");
+    taskflow.for_each_index(0, batchCount, 1, [&](int batch) {
+        const int rowStart = batch * TERRAIN_ROWS_PER_BATCH;
+        const int rowEnd = std::min(rowStart + TERRAIN_ROWS_PER_BATCH, gridHeight);
+        for (int y = rowStart; y < rowEnd; ++y) {
+            rowFunction(y);
+        }
+    });
+    getTerrainExecutor().run(taskflow).wait();
+}
+
+// Two-pass city-block distance transform. Produces, for every cell, the 4-neighbour
+// step distance to the nearest seed cell (distance 0), exactly what a multi-source BFS
+// over the open grid would produce, without the queue.
+static void computeManhattanDistanceTransform(std::vector<int>& distance, int gridWidth, int gridHeight) {
+    // Forward pass: top-left to bottom-right
+    for (int y = 0; y < gridHeight; ++y) {
+        int* row = &distance[static_cast<size_t>(y) * gridWidth];
+        const int* previousRow = (y > 0) ? row - gridWidth : nullptr;
+        for (int x = 0; x < gridWidth; ++x) {
+            int d = row[x];
+            if (previousRow) d = std::min(d, previousRow[x] + 1);
+            if (x > 0) d = std::min(d, row[x - 1] + 1);
+            row[x] = d;
+        }
+    }
+
+    // Backward pass: bottom-right to top-left
+    for (int y = gridHeight - 1; y >= 0; --y) {
+        int* row = &distance[static_cast<size_t>(y) * gridWidth];
+        const int* nextRow = (y < gridHeight - 1) ? row + gridWidth : nullptr;
+        for (int x = gridWidth - 1; x >= 0; --x) {
+            int d = row[x];
+            if (nextRow) d = std::min(d, nextRow[x] + 1);
+            if (x < gridWidth - 1) d = std::min(d, row[x + 1] + 1);
+            row[x] = d;
+        }
+    }
+}
+
+// Classifies one row of cells from the noise as WATER_0 / SAND / GRASS_0 (refined later by
+// distance) and seeds the distance-to-sand buffer. firstColumn is the world x of blockRow[0].
+static void classifyTerrainRow(
+    const float* noise, int noiseWidth,
+    const NoiseAxisTable& columns, const NoiseAxisTable& rows,
+    int worldY, int firstColumn, int count,
+    float waterThreshold, float grassThreshold,
+    BlockName* blockRow, int* distanceRow) {
+
+    const int unreachedDistance = std::numeric_limits<int>::max() / 2;
+    const float* row0 = noise + static_cast<size_t>(rows.index0[worldY]) * noiseWidth;
+    const float* row1 = noise + static_cast<size_t>(rows.index1[worldY]) * noiseWidth;
+    const float ty = rows.t[worldY];
+    const int* x0 = columns.index0.data() + firstColumn;
+    const int* x1 = columns.index1.data() + firstColumn;
+    const float* tx = columns.t.data() + firstColumn;
+
+    for (int i = 0; i < count; ++i) {
+        float noiseValue = bilinearInterpolate(
+            row0[x0[i]], row0[x1[i]],
+            row1[x0[i]], row1[x1[i]],
+            tx[i], ty
+        );
+
+        // Initial water type is WATER_0 (refined below)
+        bool isWater = noiseValue < waterThreshold;
+        bool isSand = !isWater && noiseValue < grassThreshold;
+        blockRow[i] = isWater ? BlockName::WATER_0 : (isSand ? BlockName::SAND : BlockName::GRASS_0);
+        distanceRow[i] = isSand ? 0 : unreachedDistance;
+    }
+}
+
+// Largest distance to sand that changes a texture (WATER_4 from 5 on); anything further looks the same
+const int TERRAIN_MAX_TEXTURE_DISTANCE = 5;
+
+// Assigns final water and grass textures from the distance to the nearest sand block.
+// Index = min(distance, last entry). Distance 0 is sand, which is never re-textured.
+static void textureTerrainRow(BlockName* blockRow, const int* distanceRow, int count) {
+    static const BlockName waterByDistance[] = {
+        BlockName::WATER_0, BlockName::WATER_0, BlockName::WATER_1,
+        BlockName::WATER_2, BlockName::WATER_3, BlockName::WATER_4
+    };
+    static const BlockName grassByDistance[] = {
+        BlockName::GRASS_0, BlockName::GRASS_0, BlockName::GRASS_1, BlockName::GRASS_2
+    };
+    for (int i = 0; i < count; ++i) {
+        int dist = distanceRow[i];
+        BlockName block = blockRow[i];
+        if (block == BlockName::WATER_0) {
+            blockRow[i] = waterByDistance[std::min(dist, TERRAIN_MAX_TEXTURE_DISTANCE)];
+        } else if (block == BlockName::GRASS_0) {
+            blockRow[i] = grassByDistance[std::min(dist, 3)];
+        }
+    }
+}
+
+// DEBUG_MAP layout: top half WATER_4, bottom half GRASS_2
+static BlockName debugMapBlock(int y, int gridHeight) {
+    return (y >= gridHeight / 2) ? BlockName::WATER_4 : BlockName::GRASS_2;
+}
+
+TerrainGrid generateTerrainGrid(
+    int gridWidth, int gridHeight,
+    float islandFeatureSize,
+    float seaFeatureSize,
     float waterThreshold, float grassThreshold) {
 
+    TerrainGrid terrain;
+    terrain.width = gridWidth;
+    terrain.height = gridHeight;
+    terrain.blocks.resize(static_cast<size_t>(gridWidth) * gridHeight);
+
     // Check if we should generate a debug map instead of the regular terrain
     if (DEBUG_MAP) {
         std::cout << "Generating DEBUG MAP - Top half: GRASS_2, Bottom half: WATER_4" << std::endl;
         
-        std::map<std::pair<int, int>, BlockName> debugMap;
-        int midPoint = gridHeight / 2;
-        
-        // Fill the grid with the debug pattern
         for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
-            for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
-                if (y_coord >= midPoint) {
-                    // Top half - GRASS_2
-                    debugMap[{x_coord, y_coord}] = BlockName::WATER_4;
-                } else {
-                    // Bottom half - WATER_4
-                    debugMap[{x_coord, y_coord}] = BlockName::GRASS_2;
-                }
-            }
+            // Top half - WATER_4, bottom half - GRASS_2
+            std::fill_n(terrain.blocks.begin() + static_cast<size_t>(y_coord) * gridWidth, gridWidth, debugMapBlock(y_coord, gridHeight));
         }
-        
-        return debugMap;
+        return terrain;
     }
 
     // Regular terrain generation (only executed if DEBUG_MAP is false)
@@ -126,114 +265,294 @@ std::map<std::pair<int, int>, BlockName> generateTerrain(
     float noiseFeatureSize = islandFeatureSize / seaFeatureSize; 
     initializeBaseNoiseIfNeeded(gridWidth, gridHeight, noiseFeatureSize);
 
-    std::vector<std::vector<BlockName>> grid(gridHeight, std::vector<BlockName>(gridWidth));
+    // The base noise lives in a thread_local, so hand the workers a pointer to this thread's copy
+    const float* noise = baseNoiseGrid.data();
+    const int noiseWidth = baseNoiseWidth_static;
+    const NoiseAxisTable columns = buildNoiseAxisTable(gridWidth, baseNoiseWidth_static);
+    const NoiseAxisTable rows = buildNoiseAxisTable(gridHeight, baseNoiseHeight_static);
 
-    // 1. Initial terrain generation based on noise
-    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
-        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
-            float noiseValue = getInterpolatedNoise(
-                static_cast<float>(x_coord) / gridWidth, 
-                static_cast<float>(y_coord) / gridHeight
-            );
+    // Distance to the nearest sand block; sand cells are the seeds of the distance transform
+    std::vector<int> distanceToSand(terrain.blocks.size());
 
-            if (noiseValue < waterThreshold) {
-                grid[y_coord][x_coord] = BlockName::WATER_0; // Initial water type (will be refined)
-            } else if (noiseValue < grassThreshold) {
-                grid[y_coord][x_coord] = BlockName::SAND;
-            } else {
-                grid[y_coord][x_coord] = BlockName::GRASS_0;
-            }
+    // 1. Initial terrain generation based on noise (row batches in parallel)
+    BlockName* blocks = terrain.blocks.data();
+    int* distances = distanceToSand.data();
+    forEachRowBatch(gridHeight, [&](int y_coord) {
+        classifyTerrainRow(noise, noiseWidth, columns, rows, y_coord, 0, gridWidth, waterThreshold, grassThreshold,
+                           blocks + static_cast<size_t>(y_coord) * gridWidth, distances + static_cast<size_t>(y_coord) * gridWidth);
+    });
+
+    // 2. Distance transform to calculate distances to sand
+    computeManhattanDistanceTransform(distanceToSand, gridWidth, gridHeight);
+
+    // 3. Assign final water and grass textures based on distance (row batches in parallel)
+    forEachRowBatch(gridHeight, [&](int y_coord) {
+        textureTerrainRow(blocks + static_cast<size_t>(y_coord) * gridWidth, distances + static_cast<size_t>(y_coord) * gridWidth, gridWidth);
+    });
+
+    return terrain;
+}
+
+std::map<std::pair<int, int>, BlockName> generateTerrain(
+    int gridWidth, int gridHeight, 
+    float islandFeatureSize, // Renamed from scale
+    float seaFeatureSize,    // Added this line
+    float waterThreshold, float grassThreshold) {
+
+    TerrainGrid terrain = generateTerrainGrid(gridWidth, gridHeight, islandFeatureSize, seaFeatureSize, waterThreshold, grassThreshold);
+
+    // Convert grid to map for return (keys are inserted in sorted order, so the hint makes this linear)
+    std::map<std::pair<int, int>, BlockName> generatedBlocks;
+    for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
+        for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
+            generatedBlocks.emplace_hint(generatedBlocks.end(), std::make_pair(x_coord, y_coord), terrain.at(x_coord, y_coord));
         }
     }
 
-    // 2. BFS to calculate distances to sand
-    std::vector<std::vector<int>> distanceToSand(gridHeight, std::vector<int>(gridWidth, std::numeric_limits<int>::max()));
-    std::queue<std::pair<int, int>> bfsQueue;
+    return generatedBlocks;
+}
 
-    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
-        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
-            if (grid[y_coord][x_coord] == BlockName::SAND) {
-                distanceToSand[y_coord][x_coord] = 0;
-                bfsQueue.push({x_coord, y_coord});
-            }
+TerrainChunkSource::TerrainChunkSource(
+    int worldWidth, int worldHeight,
+    float islandFeatureSize, float seaFeatureSize,
+    float waterThreshold, float grassThreshold)
+    : worldWidth(worldWidth), worldHeight(worldHeight),
+      waterThreshold(waterThreshold), grassThreshold(grassThreshold),
+      debugMap(DEBUG_MAP) {
+    if (debugMap) return;
+
+    // Same base noise (and the same TERRAIN_RNG draws) as generateTerrainGrid for this world size.
+    // Copied out of the thread_local so worker threads can share it.
+    initializeBaseNoiseIfNeeded(worldWidth, worldHeight, islandFeatureSize / seaFeatureSize);
+    noise = baseNoiseGrid;
+    noiseWidth = baseNoiseWidth_static;
+    columns = buildNoiseAxisTable(worldWidth, baseNoiseWidth_static);
+    rows = buildNoiseAxisTable(worldHeight, baseNoiseHeight_static);
+}
+
+void TerrainChunkSource::generateRegion(int x0, int y0, int width, int height, BlockName* out) const {
+    // Clip the requested region to the world
+    const int regionX0 = std::max(0, x0);
+    const int regionY0 = std::max(0, y0);
+    const int regionX1 = std::min(worldWidth, x0 + width);
+    const int regionY1 = std::min(worldHeight, y0 + height);
+    if (regionX0 >= regionX1 || regionY0 >= regionY1) return;
+
+    if (debugMap) {
+        for (int y = regionY0; y < regionY1; ++y) {
+            std::fill_n(out + static_cast<size_t>(y - y0) * width + (regionX0 - x0), regionX1 - regionX0, debugMapBlock(y, worldHeight));
         }
+        return;
+    }
+
+    // Textures only depend on the distance to sand up to TERRAIN_MAX_TEXTURE_DISTANCE, so a halo of
+    // that many cells around the region gives exactly the distances the whole-world transform would
+    const int halo = TERRAIN_MAX_TEXTURE_DISTANCE;
+    const int haloX0 = std::max(0, regionX0 - halo);
+    const int haloY0 = std::max(0, regionY0 - halo);
+    const int haloX1 = std::min(worldWidth, regionX1 + halo);
+    const int haloY1 = std::min(worldHeight, regionY1 + halo);
+    const int haloWidth = haloX1 - haloX0;
+    const int haloHeight = haloY1 - haloY0;
+
+    std::vector<BlockName> haloBlocks(static_cast<size_t>(haloWidth) * haloHeight);
+    std::vector<int> distanceToSand(haloBlocks.size());
+    for (int y = 0; y < haloHeight; ++y) {
+        classifyTerrainRow(noise.data(), noiseWidth, columns, rows, haloY0 + y, haloX0, haloWidth, waterThreshold, grassThreshold,
+                           &haloBlocks[static_cast<size_t>(y) * haloWidth], &distanceToSand[static_cast<size_t>(y) * haloWidth]);
     }
+    computeManhattanDistanceTransform(distanceToSand, haloWidth, haloHeight);
 
-    int dx[] = {0, 0, 1, -1}; // For 4-directional neighbors
-    int dy[] = {1, -1, 0, 0};
+    for (int y = regionY0; y < regionY1; ++y) {
+        const size_t haloRow = static_cast<size_t>(y - haloY0) * haloWidth + (regionX0 - haloX0);
+        BlockName* outRow = out + static_cast<size_t>(y - y0) * width + (regionX0 - x0);
+        std::copy_n(&haloBlocks[haloRow], regionX1 - regionX0, outRow);
+        textureTerrainRow(outRow, &distanceToSand[haloRow], regionX1 - regionX0);
+    }
+}
 
-    while (!bfsQueue.empty()) {
-        std::pair<int, int> curr = bfsQueue.front();
-        bfsQueue.pop();
-        int cx = curr.first;
-        int cy = curr.second;
+// ---- Spawn rule helpers ----
+
+// Lookup table indexed by BlockName: true for every block type in the list
+static std::vector<char> buildBlockMask(const std::vector<BlockName>& blockTypes) {
+    std::vector<char> mask(magic_enum::enum_count<BlockName>(), 0);
+    for (const auto& blockType : blockTypes) {
+        size_t index = static_cast<size_t>(blockType);
+        if (index >= mask.size()) mask.resize(index + 1, 0);
+        mask[index] = 1;
+    }
+    return mask;
+}
 
-        for (int i = 0; i < 4; ++i) {
-            int nx = cx + dx[i];
-            int ny = cy + dy[i];
+static inline bool blockMaskContains(const std::vector<char>& mask, BlockName blockType) {
+    size_t index = static_cast<size_t>(blockType);
+    return index < mask.size() && mask[index] != 0;
+}
 
-            if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight) {
-                if (distanceToSand[ny][nx] == std::numeric_limits<int>::max()) { // If not sand and not visited
-                    distanceToSand[ny][nx] = distanceToSand[cy][cx] + 1;
-                    bfsQueue.push({nx, ny});
-                }
-            }
+// 1D squared distance transform of a sampled function (lower envelope of parabolas,
+// Felzenszwalb & Huttenlocher). f and d hold n values; v and z are scratch of size n and n + 1.
+static void squaredDistanceTransform1D(const double* f, double* d, int n, int* v, double* z) {
+    const double infinity = std::numeric_limits<double>::infinity();
+    int k = 0;
+    v[0] = 0;
+    z[0] = -infinity;
+    z[1] = infinity;
+    for (int q = 1; q < n; ++q) {
+        double s = ((f[q] + static_cast<double>(q) * q) - (f[v[k]] + static_cast<double>(v[k]) * v[k])) / (2.0 * q - 2.0 * v[k]);
+        while (k > 0 && s <= z[k]) {
+            k--;
+            s = ((f[q] + static_cast<double>(q) * q) - (f[v[k]] + static_cast<double>(v[k]) * v[k])) / (2.0 * q - 2.0 * v[k]);
         }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = infinity;
     }
-    
-    // 3. Assign final water textures based on distance
-    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
-        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
-            // Only modify if it was initially classified as a water block
-            if (grid[y_coord][x_coord] != BlockName::SAND && grid[y_coord][x_coord] != BlockName::GRASS_0) {
-                int dist = distanceToSand[y_coord][x_coord];
-                
-                if (dist == 1) {
-                    grid[y_coord][x_coord] = BlockName::WATER_0;
-                } else if (dist == 2) {
-                    grid[y_coord][x_coord] = BlockName::WATER_1;
-                } else if (dist == 3) {
-                    grid[y_coord][x_coord] = BlockName::WATER_2;
-                } else if (dist == 4) {
-                    grid[y_coord][x_coord] = BlockName::WATER_3;
-                } else if (dist >= 5) {
-                    grid[y_coord][x_coord] = BlockName::WATER_4;
-                }
-                // If dist is 0, it's sand, so this block is skipped by the outer if.
-                // If it was WATER_0 and dist is still max_int (e.g. isolated pond), it becomes WATER_5.
-            }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) k++;
+        double offset = static_cast<double>(q - v[k]);
+        d[q] = offset * offset + f[v[k]];
+    }
+}
+
+// Exact squared Euclidean distance from every cell to the nearest cell of the mask
+// (column pass then row pass, both linear). Cells with no reachable seed stay at +infinity.
+static std::vector<float> computeSquaredDistanceField(const std::vector<char>& seeds, int gridWidth, int gridHeight) {
+    // "Far" must stay finite so the parabola intersections are well defined; anything this
+    // large is treated as unreachable once the row pass is done
+    const double far = 1e20;
+    std::vector<double> field(seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        field[i] = seeds[i] ? 0.0 : far;
+    }
+
+    // Column pass (each index is a column)
+    forEachRowBatch(gridWidth, [&](int x) {
+        thread_local static std::vector<double> f, d, z;
+        thread_local static std::vector<int> v;
+        f.resize(gridHeight); d.resize(gridHeight); z.resize(gridHeight + 1); v.resize(gridHeight);
+        for (int y = 0; y < gridHeight; ++y) f[y] = field[static_cast<size_t>(y) * gridWidth + x];
+        squaredDistanceTransform1D(f.data(), d.data(), gridHeight, v.data(), z.data());
+        for (int y = 0; y < gridHeight; ++y) field[static_cast<size_t>(y) * gridWidth + x] = d[y];
+    });
+
+    // Row pass
+    std::vector<float> result(seeds.size());
+    forEachRowBatch(gridHeight, [&](int y) {
+        thread_local static std::vector<double> d, z;
+        thread_local static std::vector<int> v;
+        d.resize(gridWidth); z.resize(gridWidth + 1); v.resize(gridWidth);
+        const size_t rowStart = static_cast<size_t>(y) * gridWidth;
+        squaredDistanceTransform1D(&field[rowStart], d.data(), gridWidth, v.data(), z.data());
+        for (int x = 0; x < gridWidth; ++x) {
+            // Stored the same way the old per-location scan computed it: float(int dx*dx + dy*dy)
+            result[rowStart + x] = (d[x] < far * 0.5)
+                ? static_cast<float>(static_cast<int>(d[x]))
+                : std::numeric_limits<float>::infinity();
         }
+    });
+    return result;
+}
+
+// Distance-to-proximity-blocks constraint of a rule, precomputed once as a distance field
+struct ProximityField {
+    bool active = false;
+    int width = 0;
+    float maxDistanceSquared = 0.0f;
+    std::vector<float> squaredDistance;
+
+    bool isNear(int x, int y) const {
+        return !active || squaredDistance[static_cast<size_t>(y) * width + x] <= maxDistanceSquared;
+    }
+};
+
+static ProximityField buildProximityField(const std::vector<BlockName>& blockGrid, int gridWidth, int gridHeight, const GenerationRuleInfo& rule) {
+    ProximityField proximity;
+    if (rule.proximityBlocks.empty() || rule.maxDistanceFromBlocks <= 0) {
+        return proximity;
+    }
+
+    std::vector<char> proximityMask = buildBlockMask(rule.proximityBlocks);
+    std::vector<char> seeds(blockGrid.size());
+    for (size_t i = 0; i < blockGrid.size(); ++i) {
+        seeds[i] = blockMaskContains(proximityMask, blockGrid[i]) ? 1 : 0;
     }
 
-    // 3b. Assign final grass textures based on distance to sand
-    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
-        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
-            // Only modify if it was initially classified as GRASS_0 
-            // (and not changed by water texturing, which it wouldn't be)
-            if (grid[y_coord][x_coord] == BlockName::GRASS_0) {
-                int dist = distanceToSand[y_coord][x_coord];
-
-                if (dist == 1) { // Adjacent to sand
-                    grid[y_coord][x_coord] = BlockName::GRASS_0;
-                } else if (dist == 2) { // One grass block away from sand
-                    grid[y_coord][x_coord] = BlockName::GRASS_1;
-                } else if (dist >= 3) { // Two or more grass blocks away from sand (or isolated)
-                    grid[y_coord][x_coord] = BlockName::GRASS_2;
+    proximity.active = true;
+    proximity.width = gridWidth;
+    proximity.maxDistanceSquared = rule.maxDistanceFromBlocks * rule.maxDistanceFromBlocks;
+    proximity.squaredDistance = computeSquaredDistanceField(seeds, gridWidth, gridHeight);
+    return proximity;
+}
+
+// Background grid for Poisson-disk spacing between spawns of the same rule. Cells are at
+// least minDistance wide, so any placed point closer than minDistance lies in the 3x3
+// neighbourhood of the candidate's cell. Points are kept in per-cell linked lists.
+class PoissonDiskGrid {
+public:
+    PoissonDiskGrid(int gridWidth, int gridHeight, float minDistance)
+        : minDistanceSquared(minDistance * minDistance) {
+        if (minDistance <= 0.0f) return;
+        cellSize = std::max(1, static_cast<int>(std::ceil(minDistance)));
+        cellsX = (gridWidth + cellSize - 1) / cellSize;
+        cellsY = (gridHeight + cellSize - 1) / cellSize;
+        cellHead.assign(static_cast<size_t>(cellsX) * cellsY, -1);
+    }
+
+    bool isTooClose(int x, int y) const {
+        if (cellHead.empty()) return false;
+        int cellX = x / cellSize;
+        int cellY = y / cellSize;
+        for (int cy = std::max(0, cellY - 1); cy <= std::min(cellsY - 1, cellY + 1); ++cy) {
+            for (int cx = std::max(0, cellX - 1); cx <= std::min(cellsX - 1, cellX + 1); ++cx) {
+                for (int i = cellHead[static_cast<size_t>(cy) * cellsX + cx]; i != -1; i = nextPoint[i]) {
+                    int dx = points[i].first - x;
+                    int dy = points[i].second - y;
+                    float distanceSquared = static_cast<float>(dx*dx + dy*dy);
+                    if (distanceSquared < minDistanceSquared) return true;
                 }
             }
         }
+        return false;
     }
 
-    // 4. Convert grid to map for return
-    std::map<std::pair<int, int>, BlockName> generatedBlocks;
-    for (int y_coord = 0; y_coord < gridHeight; ++y_coord) {
-        for (int x_coord = 0; x_coord < gridWidth; ++x_coord) {
-            generatedBlocks[{x_coord, y_coord}] = grid[y_coord][x_coord];
-        }
+    void insert(int x, int y) {
+        if (cellHead.empty()) return;
+        int& head = cellHead[static_cast<size_t>(y / cellSize) * cellsX + (x / cellSize)];
+        points.push_back({x, y});
+        nextPoint.push_back(head);
+        head = static_cast<int>(points.size()) - 1;
     }
 
-    return generatedBlocks;
-}
+private:
+    float minDistanceSquared;
+    int cellSize = 1;
+    int cellsX = 0;
+    int cellsY = 0;
+    std::vector<int> cellHead;
+    std::vector<int> nextPoint;
+    std::vector<std::pair<int, int>> points;
+};
+
+static void placeElementsFromRuleOnGrid(
+    ElementsOnMap& elementsManager,
+    const std::vector<BlockName>& blockGrid,
+    int gridWidth,
+    int gridHeight,
+    const GenerationRuleInfo& rule,
+    int originX = 0,
+    int originY = 0
+);
+
+static void placeEntitiesFromRuleOnGrid(
+    const std::vector<BlockName>& blockGrid,
+    int gridWidth,
+    int gridHeight,
+    const GenerationRuleInfo& rule,
+    int originX = 0,
+    int originY = 0
+);
 
 // Places decorative elements based on configuration rules
 void placeTerrainElements(
@@ -241,12 +560,27 @@ void placeTerrainElements(
     const Map& map,
     int gridWidth,
     int gridHeight
+) {
+    placeTerrainElementsInArea(elementsManager, map, 0, 0, gridWidth, gridHeight);
+}
+
+void placeTerrainElementsInArea(
+    ElementsOnMap& elementsManager,
+    const Map& map,
+    int originX,
+    int originY,
+    int gridWidth,
+    int gridHeight
 ) {
     // DEBUG: Log when terrain elements placement starts
     std::cout << "DEBUG: placeTerrainElements starting - will read blocks from map" << std::endl;
     
     // Get generation rules from the global configuration
     const auto& rules = g_terrainConfig.getGenerationRules();
+
+    // Snapshot the terrain once; every rule reads from the same flat grid
+    std::vector<BlockName> blockGrid;
+    map.copyBlockGrid(blockGrid, originX, originY, gridWidth, gridHeight);
     
     // Count of different block types for debugging
     int sandCount = 0;
@@ -255,26 +589,23 @@ void placeTerrainElements(
     int otherCount = 0;
     
     // Count blocks for debugging
-    for (int y = 0; y < gridHeight; y++) {
-        for (int x = 0; x < gridWidth; x++) {
-            BlockName blockType = map.getBlockNameByCoordinates(x, y);
-            if (blockType == BlockName::SAND) {
-                sandCount++;
-            } else if (blockType >= BlockName::GRASS_0 && blockType <= BlockName::GRASS_5) {
-                grassCount++;
-            } else if (blockType >= BlockName::WATER_0 && blockType <= BlockName::WATER_4) {
-                waterCount++;
-            } else {
-                otherCount++;
-            }
+    for (BlockName blockType : blockGrid) {
+        if (blockType == BlockName::SAND) {
+            sandCount++;
+        } else if (blockType >= BlockName::GRASS_0 && blockType <= BlockName::GRASS_5) {
+            grassCount++;
+        } else if (blockType >= BlockName::WATER_0 && blockType <= BlockName::WATER_4) {
+            waterCount++;
+        } else {
+            otherCount++;
         }
     }
       // Process each generation rule
     for (const auto& rule : rules) {
         if (rule.spawnType == SpawnType::ELEMENT) {
-            placeElementsFromRule(elementsManager, map, gridWidth, gridHeight, rule);
+            placeElementsFromRuleOnGrid(elementsManager, blockGrid, gridWidth, gridHeight, rule, originX, originY);
         } else if (rule.spawnType == SpawnType::ENTITY) {
-            placeEntitiesFromRule(map, gridWidth, gridHeight, rule);
+            placeEntitiesFromRuleOnGrid(blockGrid, gridWidth, gridHeight, rule, originX, originY);
         }
         // Future: handle BLOCK spawn types
     }
@@ -293,6 +624,32 @@ void placeElementsFromRule(
     int gridWidth,
     int gridHeight,
     const GenerationRuleInfo& rule
+) {
+    std::vector<BlockName> blockGrid;
+    map.copyBlockGrid(blockGrid, gridWidth, gridHeight);
+    placeElementsFromRuleOnGrid(elementsManager, blockGrid, gridWidth, gridHeight, rule);
+}
+
+// Helper function to place entities based on a single generation rule
+void placeEntitiesFromRule(
+    const Map& map,
+    int gridWidth,
+    int gridHeight,
+    const GenerationRuleInfo& rule
+) {
+    std::vector<BlockName> blockGrid;
+    map.copyBlockGrid(blockGrid, gridWidth, gridHeight);
+    placeEntitiesFromRuleOnGrid(blockGrid, gridWidth, gridHeight, rule);
+}
+
+static void placeElementsFromRuleOnGrid(
+    ElementsOnMap& elementsManager,
+    const std::vector<BlockName>& blockGrid,
+    int gridWidth,
+    int gridHeight,
+    const GenerationRuleInfo& rule,
+    int originX,
+    int originY
 ) {
     std::cout << "DEBUG: placeElementsFromRule starting for rule: " << rule.ruleName << std::endl;
     std::cout << "DEBUG: Rule spawn blocks: ";
@@ -302,77 +659,106 @@ void placeElementsFromRule(
     std::cout << std::endl;
     
     int placedCount = 0;
-    std::vector<std::pair<int, int>> placedLocations;
+    // Spacing between spawns of this rule (Poisson-disk background grid)
+    PoissonDiskGrid placedLocations(gridWidth, gridHeight, rule.minDistanceFromSameRule);
 
-    // Pre-compute proximity blocks locations if needed
-    std::vector<std::pair<int, int>> proximityBlockLocations;
-    if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-        for (int y = 0; y < gridHeight; y++) {
-            for (int x = 0; x < gridWidth; x++) {
-                BlockName blockType = map.getBlockNameByCoordinates(x, y);
-                for (const auto& proximityBlock : rule.proximityBlocks) {
-                    if (blockType == proximityBlock) {
-                        proximityBlockLocations.push_back({x, y});
-                        break;
-                    }
-                }
-            }
-        }
-    }
+    // Distance to the nearest proximity block, computed once for the whole grid
+    const ProximityField proximity = buildProximityField(blockGrid, gridWidth, gridHeight, rule);
+    const std::vector<char> spawnMask = buildBlockMask(rule.spawnBlocks);
 
     // Track how many times we get default blocks vs actual blocks
     int defaultBlockCount = 0;
     int actualBlockCount = 0;
     int validSpawnLocationCount = 0;
     
-    // DEBUG: Test a few specific locations to see what blocks we're getting    std::cout << "DEBUG: Testing block reads at sample locations:" << std::endl;
+    // DEBUG: Test a few specific locations to see what blocks we're getting
+    std::cout << "DEBUG: Testing block reads at sample locations:" << std::endl;
     for (int testY = 0; testY < std::min(5, gridHeight); testY++) {
         for (int testX = 0; testX < std::min(5, gridWidth); testX++) {
-            BlockName testBlock = map.getBlockNameByCoordinates(testX, testY);
+            BlockName testBlock = blockGrid[static_cast<size_t>(testY) * gridWidth + testX];
             std::cout << "  Block at (" << testX << ", " << testY << "): " << static_cast<int>(testBlock) << std::endl;
         }
-    }    // First, collect ALL valid spawn locations for this rule based on current terrain
-    std::vector<std::pair<int, int>> validSpawnLocations;
-    for (int y = 0; y < gridHeight; y++) {
-        for (int x = 0; x < gridWidth; x++) {
-            BlockName blockType = map.getBlockNameByCoordinates(x, y);
+    }
+    
+    // Places one spawn (or one group) at block (x, y) - same RNG draws as before
+    auto placeAt = [&](int x, int y) {
+        // Determine how many elements to place (group spawning)
+        int elementsToPlace = 1;
+        if (rule.spawnInGroup) {
+            elementsToPlace = std::uniform_int_distribution<int>(rule.groupNumberMin, rule.groupNumberMax)(TERRAIN_RNG);
+        }
+        
+        // Place the element(s)
+        for (int groupIndex = 0; groupIndex < elementsToPlace && placedCount < rule.maxSpawns; groupIndex++) {
+            // Calculate position for this element (grid cell -> world block)
+            float elementX = (originX + x) + 0.5f;  // Center of the block
+            float elementY = (originY + y) + 0.5f;  // Center of the block
             
-            // Check if this block type is valid for spawning
-            bool validBlock = false;
-            for (const auto& spawnBlock : rule.spawnBlocks) {
-                if (blockType == spawnBlock) {
-                    validBlock = true;
-                    break;
-                }
+            // Add group positioning offset if spawning in groups
+            if (rule.spawnInGroup && groupIndex > 0) {
+                float angle = (std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f)(TERRAIN_RNG));
+                float distance = (std::uniform_real_distribution<float>(0.0f, rule.groupRadius)(TERRAIN_RNG));
+                elementX += distance * cos(angle);
+                elementY += distance * sin(angle);
             }
             
-            if (validBlock) {
-                // Check proximity to required blocks if specified
-                bool nearProximityBlocks = true;
-                if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-                    nearProximityBlocks = false;
-                    for (const auto& proximityLoc : proximityBlockLocations) {
-                        int dx = proximityLoc.first - x;
-                        int dy = proximityLoc.second - y;
-                        float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                        if (distanceSquared <= rule.maxDistanceFromBlocks * rule.maxDistanceFromBlocks) {
-                            nearProximityBlocks = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (nearProximityBlocks) {
-                    validSpawnLocations.push_back({x, y});
-                }
+            // Select element to spawn (equiprobable if multiple)
+            ElementName selectedElement = rule.spawnElements[std::uniform_int_distribution<size_t>(0, rule.spawnElements.size() - 1)(TERRAIN_RNG)];
+            
+            // Calculate scale with random variation
+            float randomScale = rule.scaleMin + 
+                (std::uniform_real_distribution<float>(rule.scaleMin, rule.scaleMax)(TERRAIN_RNG) - rule.scaleMin);
+            float finalScale = rule.baseScale * randomScale;
+            
+            // Calculate rotation
+            float finalRotation = rule.rotation;
+            if (rule.rotation < 0) {  // -1 means random rotation
+                finalRotation = (std::uniform_real_distribution<float>(0.0f, 360.0f)(TERRAIN_RNG));
+            }
+            
+            // Create unique name for this element
+            std::string elementName = rule.ruleName + "_" + std::to_string(placedCount);
+            
+            // Place the element
+            elementsManager.placeElement(
+                elementName,
+                selectedElement,
+                finalScale,
+                elementX,
+                elementY,
+                finalRotation,
+                rule.defaultSpriteSheetPhase,
+                rule.defaultSpriteSheetFrame,
+                rule.isAnimated,
+                rule.animationSpeed,
+                rule.anchorPoint,
+                rule.additionalXAnchorOffset,
+                rule.additionalYAnchorOffset
+            );
+            
+            placedCount++;
+            
+            // Only track the first element of a group for distance calculations
+            if (groupIndex == 0) {
+                placedLocations.insert(x, y);
             }
         }
-    }
-    
-    std::cout << "DEBUG: Found " << validSpawnLocations.size() << " valid spawn locations for rule '" << rule.ruleName << "'" << std::endl;
+    };
     
     // Now randomly sample from valid locations based on current terrain
     if (rule.randomPlacement) {
+        // First, collect ALL valid spawn locations for this rule based on current terrain
+        std::vector<std::pair<int, int>> validSpawnLocations;
+        for (int y = 0; y < gridHeight; y++) {
+            for (int x = 0; x < gridWidth; x++) {
+                if (blockMaskContains(spawnMask, blockGrid[static_cast<size_t>(y) * gridWidth + x]) && proximity.isNear(x, y)) {
+                    validSpawnLocations.push_back({x, y});
+                }
+            }
+        }
+        
+        std::cout << "DEBUG: Found " << validSpawnLocations.size() << " valid spawn locations for rule '" << rule.ruleName << "'" << std::endl;
+        
         // Shuffle the valid locations using the seeded RNG - this ensures different placement patterns
         // with different terrain layouts even with the same seed
         std::shuffle(validSpawnLocations.begin(), validSpawnLocations.end(), TERRAIN_RNG);
@@ -382,221 +768,37 @@ void placeElementsFromRule(
             if (placedCount >= rule.maxSpawns) break;
             
             int x = location.first;
-            int y = location.second;            // Check spawn probability using seeded RNG
+            int y = location.second;
+            // Check spawn probability using seeded RNG
             std::uniform_int_distribution<int> spawnDist(0, rule.spawnChance - 1);
             if (spawnDist(TERRAIN_RNG) != 0) continue;
             
             // Check distance from previously placed elements of this rule
-            bool tooClose = false;
-            if (rule.minDistanceFromSameRule > 0) {
-                for (const auto& placed : placedLocations) {
-                    int dx = placed.first - x;
-                    int dy = placed.second - y;
-                    float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                    if (distanceSquared < rule.minDistanceFromSameRule * rule.minDistanceFromSameRule) {
-                        tooClose = true;
-                        break;
-                    }
-                }
-            }
-            
-            if (tooClose) continue;
-            
-            // Check proximity to required blocks
-            bool nearProximityBlocks = true;
-            if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-                nearProximityBlocks = false;
-                for (const auto& proximityLoc : proximityBlockLocations) {
-                    int dx = proximityLoc.first - x;
-                    int dy = proximityLoc.second - y;
-                    float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                    if (distanceSquared <= rule.maxDistanceFromBlocks * rule.maxDistanceFromBlocks) {
-                        nearProximityBlocks = true;
-                        break;
-                    }
-                }
-            }
-            
-            if (!nearProximityBlocks) continue;
+            if (placedLocations.isTooClose(x, y)) continue;
             
-            // Determine how many elements to place (group spawning)
-            int elementsToPlace = 1;
-            if (rule.spawnInGroup) {
-                elementsToPlace = std::uniform_int_distribution<int>(rule.groupNumberMin, rule.groupNumberMax)(TERRAIN_RNG);
-            }
-            
-            // Place the element(s)
-            for (int groupIndex = 0; groupIndex < elementsToPlace && placedCount < rule.maxSpawns; groupIndex++) {
-                // Calculate position for this element
-                float elementX = x + 0.5f;  // Center of the block
-                float elementY = y + 0.5f;  // Center of the block
-                
-                // Add group positioning offset if spawning in groups
-                if (rule.spawnInGroup && groupIndex > 0) {
-                    float angle = (std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f)(TERRAIN_RNG));
-                    float distance = (std::uniform_real_distribution<float>(0.0f, rule.groupRadius)(TERRAIN_RNG));
-                    elementX += distance * cos(angle);
-                    elementY += distance * sin(angle);
-                }
-                
-                // Select element to spawn (equiprobable if multiple)
-                ElementName selectedElement = rule.spawnElements[std::uniform_int_distribution<size_t>(0, rule.spawnElements.size() - 1)(TERRAIN_RNG)];
-                
-                // Calculate scale with random variation
-                float randomScale = rule.scaleMin + 
-                    (std::uniform_real_distribution<float>(rule.scaleMin, rule.scaleMax)(TERRAIN_RNG) - rule.scaleMin);
-                float finalScale = rule.baseScale * randomScale;
-                
-                // Calculate rotation
-                float finalRotation = rule.rotation;
-                if (rule.rotation < 0) {  // -1 means random rotation
-                    finalRotation = (std::uniform_real_distribution<float>(0.0f, 360.0f)(TERRAIN_RNG));
-                }
-                
-                // Create unique name for this element
-                std::string elementName = rule.ruleName + "_" + std::to_string(placedCount);
-                
-                // Place the element
-                elementsManager.placeElement(
-                    elementName,
-                    selectedElement,
-                    finalScale,
-                    elementX,
-                    elementY,
-                    finalRotation,
-                    rule.defaultSpriteSheetPhase,
-                    rule.defaultSpriteSheetFrame,
-                    rule.isAnimated,
-                    rule.animationSpeed,
-                    rule.anchorPoint,
-                    rule.additionalXAnchorOffset,
-                    rule.additionalYAnchorOffset
-                );
-                
-                placedCount++;
-                
-                // Only track the first element of a group for distance calculations
-                if (groupIndex == 0) {
-                    placedLocations.push_back({x, y});
-                }
-            }
+            placeAt(x, y);
         }
     } else {
         // Sequential placement (original algorithm)
         for (int y = 0; y < gridHeight && placedCount < rule.maxSpawns; y++) {
             for (int x = 0; x < gridWidth && placedCount < rule.maxSpawns; x++) {
-                BlockName blockType = map.getBlockNameByCoordinates(x, y);
-                
                 // Check if this block type is valid for spawning
-                bool validBlock = false;
-                for (const auto& spawnBlock : rule.spawnBlocks) {
-                    if (blockType == spawnBlock) {
-                        validBlock = true;
-                        break;
-                    }
-                }
-                  if (!validBlock) continue;
+                if (!blockMaskContains(spawnMask, blockGrid[static_cast<size_t>(y) * gridWidth + x])) continue;
                 
                 // Check spawn probability using seeded RNG
                 std::uniform_int_distribution<int> spawnDist(0, rule.spawnChance - 1);
                 if (spawnDist(TERRAIN_RNG) != 0) continue;
                 
                 // Check distance from previously placed elements of this rule
-                bool tooClose = false;
-                if (rule.minDistanceFromSameRule > 0) {
-                    for (const auto& placed : placedLocations) {
-                        int dx = placed.first - x;
-                        int dy = placed.second - y;
-                        float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                        if (distanceSquared < rule.minDistanceFromSameRule * rule.minDistanceFromSameRule) {
-                            tooClose = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (tooClose) continue;
+                if (placedLocations.isTooClose(x, y)) continue;
                 
                 // Check proximity to required blocks
-                bool nearProximityBlocks = true;
-                if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-                    nearProximityBlocks = false;
-                    for (const auto& proximityLoc : proximityBlockLocations) {
-                        int dx = proximityLoc.first - x;
-                        int dy = proximityLoc.second - y;
-                        float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                        if (distanceSquared <= rule.maxDistanceFromBlocks * rule.maxDistanceFromBlocks) {
-                            nearProximityBlocks = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (!nearProximityBlocks) continue;
-                
-                // Determine how many elements to place (group spawning)
-                int elementsToPlace = 1;
-                if (rule.spawnInGroup) {
-                    elementsToPlace = std::uniform_int_distribution<int>(rule.groupNumberMin, rule.groupNumberMax)(TERRAIN_RNG);
-                }
+                if (!proximity.isNear(x, y)) continue;
                 
-                // Place the element(s)
-                for (int groupIndex = 0; groupIndex < elementsToPlace && placedCount < rule.maxSpawns; groupIndex++) {
-                    // Calculate position for this element
-                    float elementX = x + 0.5f;  // Center of the block
-                    float elementY = y + 0.5f;  // Center of the block
-                    
-                    // Add group positioning offset if spawning in groups
-                    if (rule.spawnInGroup && groupIndex > 0) {
-                        float angle = (std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f)(TERRAIN_RNG));
-                        float distance = (std::uniform_real_distribution<float>(0.0f, rule.groupRadius)(TERRAIN_RNG));
-                        elementX += distance * cos(angle);
-                        elementY += distance * sin(angle);
-                    }
-                    
-                    // Select element to spawn (equiprobable if multiple)
-                    ElementName selectedElement = rule.spawnElements[std::uniform_int_distribution<size_t>(0, rule.spawnElements.size() - 1)(TERRAIN_RNG)];
-                    
-                    // Calculate scale with random variation
-                    float randomScale = rule.scaleMin + 
-                        (std::uniform_real_distribution<float>(rule.scaleMin, rule.scaleMax)(TERRAIN_RNG) - rule.scaleMin);
-                    float finalScale = rule.baseScale * randomScale;
-                    
-                    // Calculate rotation
-                    float finalRotation = rule.rotation;
-                    if (rule.rotation < 0) {  // -1 means random rotation
-                        finalRotation = (std::uniform_real_distribution<float>(0.0f, 360.0f)(TERRAIN_RNG));
-                    }
-                    
-                    // Create unique name for this element
-                    std::string elementName = rule.ruleName + "_" + std::to_string(placedCount);
-                    
-                    // Place the element
-                    elementsManager.placeElement(
-                        elementName,
-                        selectedElement,
-                        finalScale,
-                        elementX,
-                        elementY,
-                        finalRotation,
-                        rule.defaultSpriteSheetPhase,
-                        rule.defaultSpriteSheetFrame,
-                        rule.isAnimated,
-                        rule.animationSpeed,
-                        rule.anchorPoint,
-                        rule.additionalXAnchorOffset,
-                        rule.additionalYAnchorOffset
-                    );
-                    
-                    placedCount++;
-                    
-                    // Only track the first element of a group for distance calculations
-                    if (groupIndex == 0) {
-                        placedLocations.push_back({x, y});
-                    }
-                }
+                placeAt(x, y);
             }
-        }    }
+        }
+    }
     
     std::cout << "DEBUG: Rule '" << rule.ruleName << "' summary:" << std::endl;
     std::cout << "  - Default blocks (GRASS_0) encountered: " << defaultBlockCount << std::endl;
@@ -607,45 +809,84 @@ void placeElementsFromRule(
     std::cout << "Placed " << placedCount << " elements using rule '" << rule.ruleName << "'" << std::endl;
 }
 
-// Helper function to place entities based on a single generation rule
-void placeEntitiesFromRule(
-    const Map& map,
+static void placeEntitiesFromRuleOnGrid(
+    const std::vector<BlockName>& blockGrid,
     int gridWidth,
     int gridHeight,
-    const GenerationRuleInfo& rule
+    const GenerationRuleInfo& rule,
+    int originX,
+    int originY
 ) {
     // Access the global entities manager
     extern EntitiesManager entitiesManager;
     
     int placedCount = 0;
-    std::vector<std::pair<int, int>> placedLocations;
+    // Spacing between spawns of this rule (Poisson-disk background grid)
+    PoissonDiskGrid placedLocations(gridWidth, gridHeight, rule.minDistanceFromSameRule);
     
-    // Pre-compute proximity blocks locations if needed
-    std::vector<std::pair<int, int>> proximityBlockLocations;
-    if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-        for (int y = 0; y < gridHeight; y++) {
-            for (int x = 0; x < gridWidth; x++) {
-                BlockName blockType = map.getBlockNameByCoordinates(x, y);
-                for (const auto& proximityBlock : rule.proximityBlocks) {
-                    if (blockType == proximityBlock) {
-                        proximityBlockLocations.push_back({x, y});
-                        break;
-                    }
+    // Distance to the nearest proximity block, computed once for the whole grid
+    const ProximityField proximity = buildProximityField(blockGrid, gridWidth, gridHeight, rule);
+    const std::vector<char> spawnMask = buildBlockMask(rule.spawnBlocks);
+    
+    // Places one spawn (or one group) at block (x, y) - same RNG draws as before
+    auto placeAt = [&](int x, int y) {
+        // Determine how many entities to place (group spawning)
+        int entitiesToPlace = 1;
+        if (rule.spawnInGroup) {
+            entitiesToPlace = std::uniform_int_distribution<int>(rule.groupNumberMin, rule.groupNumberMax)(TERRAIN_RNG);
+        }
+        
+        // Place the entity(s)
+        for (int groupIndex = 0; groupIndex < entitiesToPlace && placedCount < rule.maxSpawns; groupIndex++) {
+            // Calculate position for this entity (grid cell -> world block)
+            float entityX = (originX + x) + 0.5f;  // Center of the block
+            float entityY = (originY + y) + 0.5f;  // Center of the block
+            
+            // Add group positioning offset if spawning in groups
+            if (rule.spawnInGroup && groupIndex > 0) {
+                float angle = (std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f)(TERRAIN_RNG));
+                float distance = (std::uniform_real_distribution<float>(0.0f, rule.groupRadius)(TERRAIN_RNG));
+                entityX += distance * cos(angle);
+                entityY += distance * sin(angle);
+            }
+            
+            // Select entity to spawn (equiprobable if multiple)
+            EntityName selectedEntity = rule.spawnEntities[std::uniform_int_distribution<size_t>(0, rule.spawnEntities.size() - 1)(TERRAIN_RNG)];
+            
+            // Create unique name for this entity
+            std::string entityInstanceName = rule.ruleName + "_" + std::to_string(placedCount);
+            
+            // Place the entity using safe placement to avoid collisions
+            bool success = entitiesManager.placeEntityByTypeSafely(entityInstanceName, selectedEntity, entityX, entityY);
+            
+            if (success) {
+                placedCount++;
+                
+                // Only track the first entity of a group for distance calculations
+                if (groupIndex == 0) {
+                    placedLocations.insert(x, y);
                 }
+            } else {
+                std::cout << "Warning: Failed to place entity " << entityInstanceName 
+                          << " at position (" << entityX << "," << entityY << ")" << std::endl;
             }
         }
-    }
-      // Iterate through all grid positions using either sequential or random order
+    };
+    
+    // Iterate through all grid positions using either sequential or random order
     if (rule.randomPlacement) {
         // Create a list of all valid grid positions
         std::vector<std::pair<int, int>> gridPositions;
-        for (int y = 0; y < gridHeight; y++) {            for (int x = 0; x < gridWidth; x++) {
+        gridPositions.reserve(static_cast<size_t>(gridWidth) * gridHeight);
+        for (int y = 0; y < gridHeight; y++) {
+            for (int x = 0; x < gridWidth; x++) {
                 gridPositions.push_back({x, y});
-            }        }
+            }
+        }
         
         // Shuffle the positions for random placement using the global seeded RNG
         std::shuffle(gridPositions.begin(), gridPositions.end(), TERRAIN_RNG);
-          // Process positions in randomized order
+        // Process positions in randomized order
         for (const auto& pos : gridPositions) {
             if (placedCount >= rule.maxSpawns) break;
             
@@ -653,189 +894,40 @@ void placeEntitiesFromRule(
             int y = pos.second;
             
             // Check if current block type matches spawn requirements
-            BlockName currentBlockType = map.getBlockNameByCoordinates(x, y);
-            bool matchesSpawnBlock = false;
-            for (const auto& spawnBlock : rule.spawnBlocks) {
-                if (currentBlockType == spawnBlock) {
-                    matchesSpawnBlock = true;
-                    break;
-                }
-            }
-            
-            if (!matchesSpawnBlock) continue;
+            if (!blockMaskContains(spawnMask, blockGrid[static_cast<size_t>(y) * gridWidth + x])) continue;
             
             // Check spawn probability using seeded RNG
             std::uniform_int_distribution<int> spawnDist(0, rule.spawnChance - 1);
             if (spawnDist(TERRAIN_RNG) != 0) continue;
             
             // Check minimum distance from previous spawns of same rule
-            bool tooClose = false;
-            for (const auto& placedLoc : placedLocations) {
-                int dx = placedLoc.first - x;
-                int dy = placedLoc.second - y;
-                float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                if (distanceSquared < rule.minDistanceFromSameRule * rule.minDistanceFromSameRule) {
-                    tooClose = true;
-                    break;
-                }
-            }
-            
-            if (tooClose) continue;
+            if (placedLocations.isTooClose(x, y)) continue;
             
             // Check proximity to required blocks if specified
-            if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-                bool nearProximityBlocks = false;
-                for (const auto& proximityLoc : proximityBlockLocations) {
-                    int dx = proximityLoc.first - x;
-                    int dy = proximityLoc.second - y;
-                    float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                    if (distanceSquared <= rule.maxDistanceFromBlocks * rule.maxDistanceFromBlocks) {
-                        nearProximityBlocks = true;
-                        break;
-                    }
-                }
-                
-                if (!nearProximityBlocks) continue;
-            }
-            
-            // Determine how many entities to place (group spawning)
-            int entitiesToPlace = 1;
-            if (rule.spawnInGroup) {
-                entitiesToPlace = std::uniform_int_distribution<int>(rule.groupNumberMin, rule.groupNumberMax)(TERRAIN_RNG);
-            }
+            if (!proximity.isNear(x, y)) continue;
             
-            // Place the entity(s)
-            for (int groupIndex = 0; groupIndex < entitiesToPlace && placedCount < rule.maxSpawns; groupIndex++) {
-                // Calculate position for this entity
-                float entityX = x + 0.5f;  // Center of the block
-                float entityY = y + 0.5f;  // Center of the block
-                
-                // Add group positioning offset if spawning in groups
-                if (rule.spawnInGroup && groupIndex > 0) {
-                    float angle = (std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f)(TERRAIN_RNG));
-                    float distance = (std::uniform_real_distribution<float>(0.0f, rule.groupRadius)(TERRAIN_RNG));
-                    entityX += distance * cos(angle);
-                    entityY += distance * sin(angle);
-                }
-                
-                // Select entity to spawn (equiprobable if multiple)
-                EntityName selectedEntity = rule.spawnEntities[std::uniform_int_distribution<size_t>(0, rule.spawnEntities.size() - 1)(TERRAIN_RNG)];
-                
-                // Create unique name for this entity
-                std::string entityInstanceName = rule.ruleName + "_" + std::to_string(placedCount);
-                
-                // Place the entity using safe placement to avoid collisions
-                bool success = entitiesManager.placeEntityByTypeSafely(entityInstanceName, selectedEntity, entityX, entityY);
-                
-                if (success) {
-                    placedCount++;
-                    
-                    // Only track the first entity of a group for distance calculations
-                    if (groupIndex == 0) {
-                        placedLocations.push_back({x, y});
-                    }
-                } else {
-                    std::cout << "Warning: Failed to place entity " << entityInstanceName 
-                              << " at position (" << entityX << "," << entityY << ")" << std::endl;
-                }
-            }
+            placeAt(x, y);
         }
     } else {
         // Sequential placement (original algorithm)
         for (int y = 0; y < gridHeight && placedCount < rule.maxSpawns; y++) {
             for (int x = 0; x < gridWidth && placedCount < rule.maxSpawns; x++) {
                 // Check if current block type matches spawn requirements
-                BlockName currentBlockType = map.getBlockNameByCoordinates(x, y);
-                bool matchesSpawnBlock = false;
-                for (const auto& spawnBlock : rule.spawnBlocks) {
-                    if (currentBlockType == spawnBlock) {
-                        matchesSpawnBlock = true;
-                        break;
-                    }
-                }
-                
-                if (!matchesSpawnBlock) continue;
+                if (!blockMaskContains(spawnMask, blockGrid[static_cast<size_t>(y) * gridWidth + x])) continue;
                 
                 // Check spawn probability
                 if ((std::uniform_int_distribution<int>(0, rule.spawnChance - 1)(TERRAIN_RNG) != 0)) continue;
                 
                 // Check minimum distance from previous spawns of same rule
-                bool tooClose = false;
-                for (const auto& placedLoc : placedLocations) {
-                    int dx = placedLoc.first - x;
-                    int dy = placedLoc.second - y;
-                    float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                    if (distanceSquared < rule.minDistanceFromSameRule * rule.minDistanceFromSameRule) {
-                        tooClose = true;
-                        break;
-                    }
-                }
-                
-                if (tooClose) continue;
+                if (placedLocations.isTooClose(x, y)) continue;
                 
                 // Check proximity to required blocks if specified
-                if (!rule.proximityBlocks.empty() && rule.maxDistanceFromBlocks > 0) {
-                    bool nearProximityBlocks = false;
-                    for (const auto& proximityLoc : proximityBlockLocations) {
-                        int dx = proximityLoc.first - x;
-                        int dy = proximityLoc.second - y;
-                        float distanceSquared = static_cast<float>(dx*dx + dy*dy);
-                        if (distanceSquared <= rule.maxDistanceFromBlocks * rule.maxDistanceFromBlocks) {
-                            nearProximityBlocks = true;
-                            break;
-                        }
-                    }
-                    
-                    if (!nearProximityBlocks) continue;
-                }
-                
-                // Determine how many entities to place (group spawning)
-                int entitiesToPlace = 1;
-                if (rule.spawnInGroup) {
-                    entitiesToPlace = std::uniform_int_distribution<int>(rule.groupNumberMin, rule.groupNumberMax)(TERRAIN_RNG);
-                }
+                if (!proximity.isNear(x, y)) continue;
                 
-                // Place the entity(s)
-                for (int groupIndex = 0; groupIndex < entitiesToPlace && placedCount < rule.maxSpawns; groupIndex++) {
-                    // Calculate position for this entity
-                    float entityX = x + 0.5f;  // Center of the block
-                    float entityY = y + 0.5f;  // Center of the block
-                    
-                    // Add group positioning offset if spawning in groups
-                    if (rule.spawnInGroup && groupIndex > 0) {
-                        float angle = (std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f)(TERRAIN_RNG));
-                        float distance = (std::uniform_real_distribution<float>(0.0f, rule.groupRadius)(TERRAIN_RNG));
-                        entityX += distance * cos(angle);
-                        entityY += distance * sin(angle);
-                    }
-                    
-                    // Select entity to spawn (equiprobable if multiple)
-                    EntityName selectedEntity = rule.spawnEntities[std::uniform_int_distribution<size_t>(0, rule.spawnEntities.size() - 1)(TERRAIN_RNG)];
-                    
-                    // Create unique name for this entity
-                    std::string entityInstanceName = rule.ruleName + "_" + std::to_string(placedCount);
-                    
-                    // Place the entity using safe placement to avoid collisions
-                    bool success = entitiesManager.placeEntityByTypeSafely(entityInstanceName, selectedEntity, entityX, entityY);
-                    
-                    if (success) {
-                        placedCount++;
-                        
-                        // Only track the first entity of a group for distance calculations
-                        if (groupIndex == 0) {
-                            placedLocations.push_back({x, y});
-                        }
-                    } else {
-                        std::cout << "Warning: Failed to place entity " << entityInstanceName 
-                                  << " at position (" << entityX << "," << entityY << ")" << std::endl;
-                    }
-                }
+                placeAt(x, y);
             }
         }
     }
     
     std::cout << "Placed " << placedCount << " entities using rule '" << rule.ruleName << "'" << std::endl;
 }
-
-
-
@@ -10,9 +10,39 @@
 // Forward declaration for configuration structure
 struct GenerationRuleInfo;
 
+// Flat row-major block grid produced by the terrain generator (index = y * width + x)
+struct TerrainGrid {
+    int width = 0;
+    int height = 0;
+    std::vector<BlockName> blocks;
+
+    BlockName at(int x, int y) const { return blocks[static_cast<size_t>(y) * width + x]; }
+};
+
+// Per-axis lookup table for the noise interpolation: cell index -> the two base noise
+// samples to blend and the blend factor. Computed once per axis so the per-cell loop
+// is branch-free and the compiler can vectorize it.
+struct NoiseAxisTable {
+    std::vector<int> index0;
+    std::vector<int> index1;
+    std::vector<float> t;
+};
+
+// Generates a terrain grid into a flat buffer. Noise evaluation and texturing run in
+// row batches across worker threads; the distance-to-sand pass is a two-pass distance
+// transform. The same TERRAIN_RNG seed always produces the same grid.
+TerrainGrid generateTerrainGrid(
+    int gridWidth,
+    int gridHeight,
+    float islandFeatureSize,
+    float seaFeatureSize,
+    float waterThreshold,
+    float grassThreshold
+);
 
 // Generates a terrain map using a placeholder Perlin noise function.
 // A real Perlin noise implementation/library should be used for better results.
+// Kept for callers that still want a coordinate map; prefer generateTerrainGrid + Map::placeBlockGrid.
 std::map<std::pair<int, int>, BlockName> generateTerrain(
     int gridWidth, 
     int gridHeight, 
@@ -22,6 +52,40 @@ std::map<std::pair<int, int>, BlockName> generateTerrain(
     float grassThreshold // Added: Values above this (and waterThreshold) become grass
 );
 
+// Generates any rectangle of a fixed-size world on demand. Every block matches what
+// generateTerrainGrid(worldWidth, worldHeight, ...) would produce for the same seed, so the world
+// can be generated chunk by chunk. Construct it on the thread that owns TERRAIN_RNG (it draws the
+// base noise); after that it is immutable and can be shared by worker threads.
+class TerrainChunkSource {
+public:
+    TerrainChunkSource(
+        int worldWidth,
+        int worldHeight,
+        float islandFeatureSize,
+        float seaFeatureSize,
+        float waterThreshold,
+        float grassThreshold
+    );
+
+    int getWorldWidth() const { return worldWidth; }
+    int getWorldHeight() const { return worldHeight; }
+
+    // Fill out (row-major, width * height) with the blocks of [x0, x0 + width) x [y0, y0 + height).
+    // Cells outside the world are left untouched.
+    void generateRegion(int x0, int y0, int width, int height, BlockName* out) const;
+
+private:
+    int worldWidth;
+    int worldHeight;
+    float waterThreshold;
+    float grassThreshold;
+    bool debugMap;
+    std::vector<float> noise;
+    int noiseWidth = 0;
+    NoiseAxisTable columns;
+    NoiseAxisTable rows;
+};
+
 // Reset terrain noise generation to force fresh generation with new seed
 void resetTerrainGeneration();
 
@@ -36,6 +100,18 @@ void placeTerrainElements(
     int gridHeight
 );
 
+// Same as placeTerrainElements, restricted to the area [originX, originX + gridWidth) x
+// [originY, originY + gridHeight) - used by the streamed world, which only decorates the
+// area loaded at startup
+void placeTerrainElementsInArea(
+    ElementsOnMap& elementsManager,
+    const Map& map,
+    int originX,
+    int originY,
+    int gridWidth,
+    int gridHeight
+);
+
 // Helper function to place elements based on a single generation rule
 void placeElementsFromRule(
     ElementsOnMap& elementsManager,
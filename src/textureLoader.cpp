@@ -0,0 +1,266 @@
+#include "textureLoader.h"
+#include "gameLog.h"
+#include "metrics.h"
+#include "assetPack.h"
+// stb_image without STB_IMAGE_IMPLEMENTATION (defined in map.cpp)
+#include "../third_party/glbasimac/tools/stb_image.h"
+#include <taskflow.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+TextureLoader::DecodeJob::~DecodeJob() {
+    if (ownsPixels) {
+        stbi_image_free(const_cast<unsigned char*>(pixels));
+    }
+}
+
+TextureLoader::TextureLoader() = default;
+
+TextureLoader::~TextureLoader() {
+    // Decodes still running capture their job, let them finish before the executor goes away
+    if (executor) {
+        executor->wait_for_all();
+    }
+}
+
+std::shared_ptr<TextureLoader::DecodeJob> TextureLoader::startDecode(const std::string& path) {
+    auto job = std::make_shared<DecodeJob>();
+    job->path = path;
+
+    // Pre-decoded in the asset pack: nothing to do on a worker
+    PackedTexture packed;
+    if (AssetPack::getInstance().findTexture(path, packed)) {
+        job->pixels = packed.pixels;
+        job->width = packed.width;
+        job->height = packed.height;
+        job->channels = packed.channels;
+        job->fromPack = true;
+        job->done = true;
+        return job;
+    }
+
+    if (!executor) {
+        // Decoding only happens while loading, every core can take an image
+        executor = std::make_unique<tf::Executor>(std::max(2u, std::thread::hardware_concurrency()));
+    }
+
+    executor->silent_async([this, job]() {
+        auto decodeStart = std::chrono::steady_clock::now();
+        // The flip flag and the failure reason are thread-local in stb_image
+        stbi_set_flip_vertically_on_load_thread(1);
+        int width = 0, height = 0, channels = 0;
+        unsigned char* pixels = stbi_load(job->path.c_str(), &width, &height, &channels, 0);
+        std::string error = pixels ? "" : (stbi_failure_reason() ? stbi_failure_reason() : "unknown error");
+        double decodeMs = millisecondsSince(decodeStart);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        job->pixels = pixels;
+        job->ownsPixels = pixels != nullptr;
+        job->width = width;
+        job->height = height;
+        job->channels = channels;
+        job->decodeMs = decodeMs;
+        job->error = error;
+        job->done = true;
+        decodeFinished.notify_all();
+    });
+    return job;
+}
+
+void TextureLoader::prefetch(const std::vector<std::string>& paths) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::string& path : paths) {
+        if (prefetched.find(path) == prefetched.end()) {
+            prefetched.emplace(path, startDecode(path));
+        }
+    }
+}
+
+std::shared_ptr<TextureLoader::DecodeJob> TextureLoader::takeDecode(const std::string& path) {
+    auto it = prefetched.find(path);
+    if (it != prefetched.end()) {
+        std::shared_ptr<DecodeJob> job = it->second;
+        prefetched.erase(it);
+        return job;
+    }
+    return startDecode(path);
+}
+
+void TextureLoader::checkPixelBufferSupport() {
+    if (pixelBufferChecked) return;
+    pixelBufferChecked = true;
+
+    // Pixel unpack buffers are core since 2.1 and glMapBufferRange since 3.0; the loader only
+    // resolves the entry points of the versions the context has
+    pixelBufferUploads = GLAD_GL_VERSION_3_0 && glGenBuffers && glBindBuffer && glBufferData &&
+                         glMapBufferRange && glUnmapBuffer && glDeleteBuffers;
+    if (!pixelBufferUploads) {
+        GAME_LOG_WARN("Texture loader: OpenGL 3.0 pixel buffers not available, textures are uploaded directly");
+    }
+}
+
+void TextureLoader::upload(DecodeJob& job, TextureLoadResult& result, GLuint& pixelBuffer) {
+    result.width = job.width;
+    result.height = job.height;
+    result.channels = job.channels;
+    result.decodeMs = job.decodeMs;
+    result.fromPack = job.fromPack;
+    if (!job.pixels) {
+        result.error = job.error;
+        return;
+    }
+
+    GLenum format;
+    if (job.channels == 1) {
+        format = GL_RED;
+    } else if (job.channels == 3) {
+        format = GL_RGB;
+    } else if (job.channels == 4) {
+        format = GL_RGBA;
+    } else {
+        result.error = "unsupported number of channels: " + std::to_string(job.channels);
+        return;
+    }
+
+    auto uploadStart = std::chrono::steady_clock::now();
+    const size_t bytes = static_cast<size_t>(job.width) * job.height * job.channels;
+
+    // Copy into the pixel buffer (orphaned first: the previous image may still be in transfer),
+    // then let the driver pull it into the texture
+    const void* source = job.pixels;
+    if (pixelBufferUploads) {
+        if (pixelBuffer == 0) {
+            glGenBuffers(1, &pixelBuffer);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped) {
+            std::memcpy(mapped, job.pixels, bytes);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            source = nullptr; // Offset 0 in the pixel buffer
+        } else {
+            // Mapping failed: upload straight from the decoded pixels
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+    }
+
+    glGenTextures(1, &result.textureID);
+    glBindTexture(GL_TEXTURE_2D, result.textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // stb_image rows are tightly packed
+    glTexImage2D(GL_TEXTURE_2D, 0, format, job.width, job.height, 0, format, GL_UNSIGNED_BYTE, source);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (pixelBufferUploads) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    // The GL has its own copy now
+    if (job.ownsPixels) {
+        stbi_image_free(const_cast<unsigned char*>(job.pixels));
+        job.ownsPixels = false;
+    }
+    job.pixels = nullptr;
+    result.uploadMs = millisecondsSince(uploadStart);
+}
+
+std::vector<TextureLoadResult> TextureLoader::loadTextures(const std::vector<std::string>& paths, const std::string& batchName) {
+    static MetricHistogram& decodeSeconds = MetricsRegistry::getInstance().histogram("sorbetcoco_texture_decode_seconds",
+        "Time to decode one texture image on a loader worker", frameTimeBuckets());
+    static MetricHistogram& uploadSeconds = MetricsRegistry::getInstance().histogram("sorbetcoco_texture_upload_seconds",
+        "Time to upload one decoded texture on the GL thread", frameTimeBuckets());
+
+    auto batchStart = std::chrono::steady_clock::now();
+    checkPixelBufferSupport();
+    std::vector<std::shared_ptr<DecodeJob>> jobs;
+    jobs.reserve(paths.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::string& path : paths) {
+            jobs.push_back(takeDecode(path));
+        }
+    }
+
+    // Upload in completion order: whichever decode finishes next goes to the GL first
+    std::vector<TextureLoadResult> results(paths.size());
+    std::vector<bool> uploaded(paths.size(), false);
+    GLuint pixelBuffer = 0;
+    double waitedMs = 0.0;
+    for (size_t remaining = paths.size(); remaining > 0; --remaining) {
+        size_t next = paths.size();
+        auto waitStart = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            decodeFinished.wait(lock, [&]() {
+                for (size_t i = 0; i < jobs.size(); ++i) {
+                    if (!uploaded[i] && jobs[i]->done) {
+                        next = i;
+                        return true;
+                    }
+                }
+                return false;
+            });
+        }
+        TextureLoadResult& result = results[next];
+        result.path = paths[next];
+        result.waitMs = millisecondsSince(waitStart);
+        waitedMs += result.waitMs;
+        upload(*jobs[next], result, pixelBuffer);
+        uploaded[next] = true;
+        jobs[next].reset();
+
+        if (!result.fromPack) {
+            decodeSeconds.observe(result.decodeMs / 1000.0);
+        }
+        if (result.textureID != 0 && result.fromPack) {
+            uploadSeconds.observe(result.uploadMs / 1000.0);
+            GAME_LOG_INFO("Texture " << result.path << ": " << result.width << "x" << result.height << "x" << result.channels
+                          << ", from pack, upload " << result.uploadMs << " ms");
+        } else if (result.textureID != 0) {
+            uploadSeconds.observe(result.uploadMs / 1000.0);
+            GAME_LOG_INFO("Texture " << result.path << ": " << result.width << "x" << result.height << "x" << result.channels
+                          << ", decode " << result.decodeMs << " ms, waited " << result.waitMs << " ms, upload " << result.uploadMs << " ms");
+        } else {
+            GAME_LOG_ERROR("Failed to load texture " << result.path << ": " << result.error);
+        }
+    }
+    if (pixelBuffer != 0) {
+        glDeleteBuffers(1, &pixelBuffer);
+    }
+
+    // Batch summary: the wall time should stay close to the slowest decode, not to the sum
+    double decodeSumMs = 0.0;
+    size_t packedCount = 0;
+    const TextureLoadResult* slowest = nullptr;
+    for (const TextureLoadResult& result : results) {
+        decodeSumMs += result.decodeMs;
+        packedCount += result.fromPack ? 1 : 0;
+        if (!slowest || result.decodeMs > slowest->decodeMs) {
+            slowest = &result;
+        }
+    }
+    if (slowest && results.size() > 1) { // A single texture already has its own timing line
+        GAME_LOG_INFO("Texture batch '" << batchName << "': " << results.size() << " textures (" << packedCount << " from the asset pack) in " << millisecondsSince(batchStart)
+                      << " ms (decodes: " << decodeSumMs << " ms total, slowest " << slowest->decodeMs << " ms for "
+                      << slowest->path << "; GL thread waited " << waitedMs << " ms)");
+    }
+    return results;
+}
+
+TextureLoadResult TextureLoader::loadTexture(const std::string& path) {
+    return loadTextures({path}, path).front();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tf {
+class Executor;
+}
+
+// Parallel texture loading for Map::init, ElementsOnMap::init and GameMenus.
+//  - the PNGs are decoded with stb_image on worker threads (Taskflow executor), all at once
+//  - the calling GL thread uploads each image through a pixel buffer object as soon as its
+//    decode is done, in completion order, so a batch takes about as long as its slowest decode
+//    instead of the sum of all of them
+//  - prefetch() starts decodes early (GameMenus at startup, the element textures while the map
+//    loads); a later load of the same path takes the decoded pixels instead of decoding again
+//  - textures found in the asset pack (assetPack.h) skip the decode: the job is done at once and
+//    the upload reads the pixels straight from the memory-mapped pack
+//  - the pixel buffer path needs OpenGL 3.0 (pixel unpack buffers and glMapBufferRange); it is
+//    checked once, on the first load, and older contexts upload straight from the decoded pixels
+//  - every texture gets one timing line (decode on the worker, wait and upload on the GL thread)
+//    and the sorbetcoco_texture_*_seconds histograms
+// Textures are created the way the loaders did it before: GL_NEAREST, GL_CLAMP_TO_EDGE, flipped
+// vertically (stbi_set_flip_vertically_on_load), 1/3/4 channels as GL_RED/GL_RGB/GL_RGBA.
+
+struct TextureLoadResult {
+    std::string path;
+    GLuint textureID = 0;  // 0 when the image could not be decoded or uploaded
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    bool fromPack = false; // Pixels taken from the asset pack, nothing decoded
+    double decodeMs = 0.0; // On the worker
+    double waitMs = 0.0;   // GL thread blocked waiting for this decode
+    double uploadMs = 0.0; // GL thread, pixel buffer copy + glTexImage2D
+    std::string error;     // Set when textureID is 0
+};
+
+class TextureLoader {
+public:
+    static TextureLoader& getInstance() {
+        static TextureLoader instance;
+        return instance;
+    }
+
+    // Start decoding these images in the background (any thread). A path that already has a
+    // decode waiting to be used is not decoded twice.
+    void prefetch(const std::vector<std::string>& paths);
+
+    // Decode every path in parallel (reusing prefetched decodes) and upload them on the calling
+    // thread, which must own the GL context. Results are in the order of paths; batchName is
+    // only used in the timing report.
+    std::vector<TextureLoadResult> loadTextures(const std::vector<std::string>& paths, const std::string& batchName);
+    TextureLoadResult loadTexture(const std::string& path);
+
+private:
+    struct DecodeJob {
+        std::string path;
+        bool done = false; // Guarded by TextureLoader::mutex
+        const unsigned char* pixels = nullptr;
+        bool ownsPixels = false; // stb_image buffer (freed after upload), otherwise in the asset pack
+        bool fromPack = false;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        double decodeMs = 0.0;
+        std::string error;
+        ~DecodeJob();
+    };
+
+    TextureLoader();
+    ~TextureLoader();
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    std::shared_ptr<DecodeJob> startDecode(const std::string& path);
+    // Prefetched decode of the path, or a new one
+    std::shared_ptr<DecodeJob> takeDecode(const std::string& path);
+    // Upload through pixelBuffer (created on first use, deleted by the caller), or straight from
+    // the pixels without pixel buffer support
+    void upload(DecodeJob& job, TextureLoadResult& result, GLuint& pixelBuffer);
+    // GL thread, first load: whether the context has the pixel buffer entry points
+    void checkPixelBufferSupport();
+
+    std::unique_ptr<tf::Executor> executor;
+    std::mutex mutex;
+    std::condition_variable decodeFinished;
+    std::multimap<std::string, std::shared_ptr<DecodeJob>> prefetched; // Decodes nobody asked for yet
+    bool pixelBufferChecked = false;  // GL thread only
+    bool pixelBufferUploads = false;
+};
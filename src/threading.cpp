@@ -11,6 +11,12 @@
 #include "crashDebug.h"
 #include "performanceProfiler.h"
 #include "globals.h"
+#include "worldSave.h"
+#include "entitiesStatus.h"
+#include "timeSlicedJobs.h"
+#include "frameArena.h"
+#include "motionInterpolation.h"
+#include "readEpoch.h"
 #include <iostream>
 #include "enumDefinitions.h"
 
@@ -26,6 +32,10 @@ GameThreadManager::GameThreadManager()
     , m_elementsManager(nullptr)
     , m_entitiesManager(nullptr)
     , m_camera(nullptr)
+    , m_lockstep(isLockstepSimulation())
+    // Lockstep: one worker, the collision/entity grid caches are per thread
+    , m_tickExecutor(m_lockstep ? 1 : TICK_GRAPH_WORKERS, std::make_shared<TickWorkerInterface>())
+    , m_tickGraph(m_tickExecutor)
     , m_lastAntagonistMoveTime(0.0)
 {
     // Initialize game state
@@ -75,6 +85,28 @@ bool GameThreadManager::initialize(Map* gameMap, ElementsOnMap* elementsManager,
         return false;
     }
     
+    // Player movement and game logic each get their own loop, so a slow entity update never
+    // delays player input. Rendering is paced by the main thread (main.cpp), not by a thread here.
+    // A lockstep session moves the player inside the logic tick instead (Tick_PlayerMovement), so
+    // its steps always land between the same two entity updates.
+    if (m_lockstep) {
+        m_entitiesManager->setDeferredPathfinding(true);
+    } else {
+        m_scheduler.addFixedStepLoop("Player movement", PLAYER_UPDATE_FPS, [](double deltaTime) {
+            MotionStepScope motionStep(MotionClockId::PLAYER_MOVEMENT, deltaTime); // Render interpolation of the player
+            ReadEpochGuard mapReadGuard; // Collision reads map chunks during the step (readEpoch.h)
+            if (g_playerMovementManager != nullptr) {
+                g_playerMovementManager->updateStep(deltaTime);
+            }
+        });
+    }
+    buildTickGraph();
+    m_scheduler.addFixedStepLoop("Game logic", GAME_LOGIC_FPS, [this](double deltaTime) {
+        MotionStepScope motionStep(MotionClockId::GAME_LOGIC, deltaTime); // Render interpolation of the entities
+        ReadEpochGuard mapReadGuard; // One epoch per tick, covering the tick graph workers (readEpoch.h)
+        updateGameLogic(deltaTime);
+    });
+    
     DEBUG_LOG_MEMORY("thread_manager_initialized");
     std::cout << "GameThreadManager initialized successfully with async player movement" << std::endl;
     return true;
@@ -89,14 +121,10 @@ void GameThreadManager::startThreads()
     
     m_running.store(true);
     
-    // Start player movement thread first
-    startPlayerMovementThread();
-    
-    // Start game logic thread
-    m_gameThread = std::thread(&GameThreadManager::gameLogicThread, this);
-    
-    // Start render thread
-    m_renderThread = std::thread(&GameThreadManager::renderThread, this);
+    if (m_paused.load()) {
+        m_scheduler.pause();
+    }
+    m_scheduler.start();
     
     m_threadsStarted.store(true);
     std::cout << "Game threads started successfully with async player movement" << std::endl;
@@ -113,21 +141,8 @@ void GameThreadManager::stopThreads()
     // Signal threads to stop
     m_running.store(false);
     
-    // Stop player movement thread first
-    stopPlayerMovementThread();
-    
-    // Wake up any waiting threads (both pause and game state conditions)
-    m_gameStateChanged.notify_all();
-    m_pauseCondition.notify_all();
-    
-    // Wait for threads to finish
-    if (m_gameThread.joinable()) {
-        m_gameThread.join();
-    }
-    
-    if (m_renderThread.joinable()) {
-        m_renderThread.join();
-    }
+    // Wakes paused loops and joins both (a step in progress finishes first)
+    m_scheduler.stop();
     
     m_threadsStarted.store(false);
     std::cout << "Game threads stopped" << std::endl;
@@ -171,63 +186,188 @@ void GameThreadManager::setPlayerMovementInput(float moveX, float moveY, bool sp
     }
 }
 
-void GameThreadManager::gameLogicThread()
+void GameThreadManager::buildTickGraph()
 {
-    std::cout << "Game logic thread started" << std::endl;
-    
-    auto lastTime = std::chrono::high_resolution_clock::now();
-    double accumulatedTime = 0.0;
-    
-    while (m_running.load()) {
-        // Check if paused - if so, wait for resume
-        if (m_paused.load()) {
-            std::unique_lock<std::mutex> lock(m_gameStateMutex);
-            m_pauseCondition.wait(lock, [this] { return !m_paused.load() || !m_running.load(); });
-            
-            // Reset timing when resuming to avoid catching up on missed frames
-            lastTime = std::chrono::high_resolution_clock::now();
-            accumulatedTime = 0.0;
-            
-            if (!m_running.load()) break;
+    // Input -> {debug keys, camera, player sync}
+    //       -> entity movement -> entity sensing -> time-sliced jobs -> damage -> block transformations -> save capture
+    // What runs side by side touches disjoint state: the debug keys only flip display flags (and
+    // read the elements under their mutex), the camera stage only the camera and the tick's view
+    // bounds, the player sync and state publish only the player and the published game state.
+    // The spatial grids get no stage of their own: they are thread_local and refresh themselves on
+    // the thread that queries them, so a rebuild on another worker would be wasted.
+    // The entity chain stays serial: every stage of it writes the entities (movement, behaviors,
+    // damage, path results) and the movement, damage and block transformations also write the map,
+    // and neither is safe for concurrent writers. TickGraph runs that chain as a single task, so it
+    // costs no executor hop per stage.
+    // A lockstep session adds the player movement after the input, the deferred pathfinding
+    // between sensing and damage, and the replay checksum after the block transformations.
+    TickGraph::StageId input = m_tickGraph.addStage("Tick_Input", [this] {
+        {
+            std::lock_guard<std::mutex> lock(m_inputStateMutex);
+            m_tickInput = m_inputState;
+            m_inputState.stateUpdated = false;
         }
         
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration<double>(currentTime - lastTime).count();
-        lastTime = currentTime;
-        
-        // Accumulate time for fixed timestep
-        accumulatedTime += elapsed;
-        
-        // Run game logic at fixed timestep
-        while (accumulatedTime >= GAME_LOGIC_TIMESTEP) {
-            updateGameLogic(GAME_LOGIC_TIMESTEP);
-            accumulatedTime -= GAME_LOGIC_TIMESTEP;
+        if (m_lockstep) {
+            m_tickReplayInput = g_simulationReplay.nextTickInput();
         }
-        
-        // Sleep for a short time to prevent 100% CPU usage
-        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    });
+    
+    // Debug keys (player movement handled separately)
+    TickGraph::StageId debugKeys = m_tickGraph.addStage("Tick_DebugKeys", [this] {
+        if (m_tickInput.stateUpdated) {
+            processDebugKeys(*m_elementsManager);
+        }
+    });
+    
+    // Camera zoom keys, then the camera bounds for view frustum culling of the entity stages (the
+    // whole world in a lockstep session: what the entities do must not depend on the window size)
+    TickGraph::StageId camera = m_tickGraph.addStage("Tick_Camera", [this] {
+        if (m_tickInput.stateUpdated) {
+            processCameraControls();
+        }
+        if (m_lockstep) {
+            m_tickCameraLeft = 0.0f;
+            m_tickCameraBottom = 0.0f;
+            m_tickCameraRight = static_cast<float>(WORLD_SIZE);
+            m_tickCameraTop = static_cast<float>(WORLD_SIZE);
+        } else {
+            CameraView view = gameCamera.getView(); // One consistent snapshot
+            m_tickCameraLeft = view.left;
+            m_tickCameraRight = view.right;
+            m_tickCameraBottom = view.bottom;
+            m_tickCameraTop = view.top;
+        }
+    });
+    
+    // Lockstep: this tick's player input and movement, as two 120 Hz steps before the entity stages
+    TickGraph::StageId playerMovement = -1;
+    if (m_lockstep) {
+        playerMovement = m_tickGraph.addStage("Tick_PlayerMovement", [this] {
+            if (g_playerMovementManager == nullptr) return;
+            if (m_tickReplayInput.flags & REPLAY_INPUT_PLACE_ICE) {
+                placeIceBlockInFront();
+            }
+            g_playerMovementManager->setPlayerInput(m_tickReplayInput.moveX, m_tickReplayInput.moveY,
+                                                    (m_tickReplayInput.flags & REPLAY_INPUT_SPRINT) != 0);
+            const int steps = static_cast<int>(PLAYER_UPDATE_FPS / GAME_LOGIC_FPS);
+            for (int step = 0; step < steps; ++step) {
+                g_playerMovementManager->updateStep(1.0 / PLAYER_UPDATE_FPS);
+            }
+        });
     }
     
-    std::cout << "Game logic thread ended" << std::endl;
-}
-
-void GameThreadManager::renderThread()
-{
-    std::cout << "Render thread started" << std::endl;
+    // Sync player position from the player movement loop
+    TickGraph::StageId playerSync = m_tickGraph.addStage("Tick_PlayerSync", [] {
+        if (g_playerMovementManager != nullptr) {
+            g_playerMovementManager->syncWithGameState();
+        }
+    });
+    
+    // Update entities (handle movement and animations, damage blocks under them)
+    TickGraph::StageId entityMovement = m_tickGraph.addStage("Tick_EntityMovement", [this] {
+        m_entitiesManager->update(m_tickDeltaTime, m_tickCameraLeft, m_tickCameraRight, m_tickCameraBottom, m_tickCameraTop);
+    });
+    
+    // Entity behaviors: look around for threats/targets and pick the next walk (queues attacks)
+    TickGraph::StageId entitySensing = m_tickGraph.addStage("Tick_EntitySensing", [this] {
+        entityBehaviorManager.update(m_tickDeltaTime, *m_entitiesManager, m_tickCameraLeft, m_tickCameraRight, m_tickCameraBottom, m_tickCameraTop);
+    });
+    
+    // Time-sliced jobs (flee point and unstuck searches, graph refreshes...): TICK_JOB_BUDGET_MS
+    // of them, the rest carries over to the next tick. After the sensing, so a search it starts
+    // can already finish this tick. A lockstep session runs a fixed number of steps instead.
+    TickGraph::StageId jobs = m_tickGraph.addStage("Tick_Jobs", [this] {
+        if (m_lockstep) {
+            g_timeSlicedJobs.runSteps(LOCKSTEP_JOB_STEPS_PER_TICK);
+        } else {
+            g_timeSlicedJobs.runFor(TICK_JOB_BUDGET_MS);
+        }
+    });
+    
+    // Lockstep: the paths requested by this tick, computed here in request order (used next tick)
+    TickGraph::StageId pathfinding = -1;
+    if (m_lockstep) {
+        pathfinding = m_tickGraph.addStage("Tick_Pathfinding", [this] {
+            m_entitiesManager->runDeferredPathfinding();
+        });
+    }
     
-    while (m_running.load()) {
-        // Wait for game state update or timeout
-        std::unique_lock<std::mutex> lock(m_gameStateMutex);
-        m_gameStateChanged.wait_for(lock, std::chrono::milliseconds(16)); // ~60fps max
+    // Attacks queued by the behaviors, applied once every entity has acted
+    TickGraph::StageId damage = m_tickGraph.addStage("Tick_Damage", [this] {
+        processQueuedAttackDamage(*m_entitiesManager);
+    });
+    
+    // ICE melting etc. (placing a block can damage the entities standing on it). Takes the map's
+    // write lock: the main thread places blocks and streams chunks meanwhile
+    TickGraph::StageId blockTransformations = m_tickGraph.addStage("Tick_BlockTransformations", [this] {
+        m_gameMap->updateBlockTransformations(m_tickDeltaTime);
+    });
+    
+    // Snapshot elements and entities for a pending world save, between two updates
+    TickGraph::StageId saveCapture = m_tickGraph.addStage("Tick_SaveCapture", [this] {
+        g_worldSaver.captureObjectState(*m_entitiesManager, *m_elementsManager);
+    });
+    
+    // Lockstep: world checksum for the replay (every REPLAY_CHECKSUM_INTERVAL ticks)
+    TickGraph::StageId checksum = -1;
+    if (m_lockstep) {
+        checksum = m_tickGraph.addStage("Tick_Checksum", [this] {
+            g_simulationReplay.checkWorld(*m_gameMap, *m_elementsManager, *m_entitiesManager);
+        });
+    }
+    
+    // Update game state for rendering
+    TickGraph::StageId publishState = m_tickGraph.addStage("Tick_PublishState", [this] {
+        std::lock_guard<std::mutex> lock(m_gameStateMutex);
+        
+        // Get player position and movement state from the dedicated player movement manager
+        if (g_playerMovementManager != nullptr) {
+            auto playerState = g_playerMovementManager->getPlayerState();
+            m_currentGameState.playerX = playerState.x;
+            m_currentGameState.playerY = playerState.y;
+            m_currentGameState.playerMoving = playerState.isMoving;
+        } else {
+            // Fallback to direct position query if player movement manager is not available
+            if (!getPlayerPosition(m_currentGameState.playerX, m_currentGameState.playerY)) {
+                // Player entity doesn't exist - keep previous position and disable movement
+                m_currentGameState.playerMoving = false;
+            } else {
+                m_currentGameState.playerMoving = false;
+            }
+        }
         
-        // The actual rendering will be done in the main thread
-        // This thread just manages the timing and synchronization
+        m_currentGameState.currentTime = m_tickGameTime;
+        m_currentGameState.deltaTime = m_tickDeltaTime;
         
-        // Sleep briefly to prevent excessive CPU usage
-        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+        // Camera updates are handled in the player movement loop at 120Hz
+        // for smoother camera following synchronized with player movement
+    });
+    
+    m_tickGraph.precede(input, debugKeys);
+    m_tickGraph.precede(input, camera);
+    TickGraph::StageId worldStart = input;
+    if (m_lockstep) {
+        m_tickGraph.precede(input, playerMovement);
+        worldStart = playerMovement;
     }
-    
-    std::cout << "Render thread ended" << std::endl;
+    m_tickGraph.precede(worldStart, playerSync);
+    m_tickGraph.precede(worldStart, entityMovement);
+    m_tickGraph.precede(camera, entityMovement);
+    m_tickGraph.precede(entityMovement, entitySensing);
+    m_tickGraph.precede(entitySensing, jobs);
+    if (m_lockstep) {
+        m_tickGraph.precede(jobs, pathfinding);
+        m_tickGraph.precede(pathfinding, damage);
+    } else {
+        m_tickGraph.precede(jobs, damage);
+    }
+    m_tickGraph.precede(damage, blockTransformations);
+    m_tickGraph.precede(blockTransformations, saveCapture);
+    if (m_lockstep) {
+        m_tickGraph.precede(blockTransformations, checksum);
+    }
+    m_tickGraph.precede(playerSync, publishState);
 }
 
 void GameThreadManager::updateGameLogic(double deltaTime)
@@ -254,75 +394,14 @@ void GameThreadManager::updateGameLogic(double deltaTime)
         DEBUG_LOG_MEMORY("game_logic_frame_" + std::to_string(logicFrameCount));
     }
     
-    // Get current input state
-    InputState currentInput;
-    {
-        PROFILE_SCOPE("InputState_Copy");
-        std::lock_guard<std::mutex> lock(m_inputStateMutex);
-        currentInput = m_inputState;
-        m_inputState.stateUpdated = false;
-    }
-
-    // CRASH FIX: Validate input state before using
+    // CRASH FIX: Exit early if shutting down
     if (!m_running.load()) {
-        return; // Exit early if shutting down
+        return;
     }
     
     // Update game time
     static double gameTime = 0.0;
     gameTime += deltaTime;
-      
-    // Process input if updated (debug keys and camera controls only - player movement handled separately)
-    if (currentInput.stateUpdated) {
-        PROFILE_SCOPE("Input_Processing");
-        // Process debug keys
-        processDebugKeys(*m_elementsManager);
-        
-        // Process camera controls
-        processCameraControls();
-    }
-    
-    // Sync player position from the dedicated player movement thread
-    {
-        PROFILE_SCOPE("PlayerMovement_Sync");
-        if (g_playerMovementManager != nullptr) {
-            g_playerMovementManager->syncWithGameState();
-        }
-    }
-      
-    // Update entities (handle movement and animations) - this is now the main focus of the game logic thread
-    // CRASH FIX: Add try-catch around entities update to prevent crashes
-    try {
-        // Get camera bounds for view frustum culling
-        float cameraLeft, cameraRight, cameraBottom, cameraTop;
-        {
-            PROFILE_SCOPE("Camera_Bounds_Get");
-            cameraLeft = gameCamera.getLeft();
-            cameraRight = gameCamera.getRight();
-            cameraBottom = gameCamera.getBottom();
-            cameraTop = gameCamera.getTop();
-        }
-        
-        // Update entities with view frustum culling
-        {
-            PROFILE_SCOPE("Entities_Update");
-            m_entitiesManager->update(deltaTime, cameraLeft, cameraRight, cameraBottom, cameraTop);
-        }
-        
-        // Update entity behaviors with view frustum culling (automatic behaviors like passive random walking)
-        {
-            PROFILE_SCOPE("EntityBehaviors_Update");
-            entityBehaviorManager.update(deltaTime, *m_entitiesManager, cameraLeft, cameraRight, cameraBottom, cameraTop);
-        }
-        
-        // Update player slip functionality
-    } catch (const std::exception& e) {
-        std::cerr << "CRITICAL: Exception in entities update: " << e.what() << std::endl;
-        // Continue execution to prevent complete crash
-    } catch (...) {
-        std::cerr << "CRITICAL: Unknown exception in entities update!" << std::endl;
-        // Continue execution to prevent complete crash
-    }
     
     /* // Periodically move antagonists
     if (gameTime - m_lastAntagonistMoveTime >= ANTAGONIST_MOVE_INTERVAL) {
@@ -332,44 +411,23 @@ void GameThreadManager::updateGameLogic(double deltaTime)
         m_entitiesManager->walkEntityWithPathFindingToRandomRadiusTarget("antagonist3", 30.0f, WalkType::NORMAL);
         m_lastAntagonistMoveTime = gameTime;
     } */
-      
-    // Update game state for rendering
-    {
-        PROFILE_SCOPE("GameState_Update");
-        std::lock_guard<std::mutex> lock(m_gameStateMutex);
-        
-        // Get player position and movement state from the dedicated player movement manager
-        if (g_playerMovementManager != nullptr) {
-            auto playerState = g_playerMovementManager->getPlayerState();
-            m_currentGameState.playerX = playerState.x;
-            m_currentGameState.playerY = playerState.y;
-            m_currentGameState.playerMoving = playerState.isMoving;        } else {
-            // Fallback to direct position query if player movement manager is not available
-            if (!getPlayerPosition(m_currentGameState.playerX, m_currentGameState.playerY)) {
-                // Player entity doesn't exist - keep previous position and disable movement
-                m_currentGameState.playerMoving = false;
-            } else {
-                m_currentGameState.playerMoving = false;
-            }
-        }
-          
-        m_currentGameState.currentTime = gameTime;
-        m_currentGameState.deltaTime = deltaTime;
-        
-        // Camera updates are now handled in the player movement thread at 120Hz
-        // for smoother camera following synchronized with player movement
-    }
+    
+    // Run every stage of the tick (see buildTickGraph)
+    m_tickDeltaTime = deltaTime;
+    m_tickGameTime = gameTime;
+    m_tickGraph.run();
     
     // Print performance report every 5 seconds (300 frames at 60Hz)
     static int frameCounter = 0;
     frameCounter++;
     if (frameCounter >= 300) {
         PerformanceProfiler::getInstance().printReport();
+        m_tickGraph.printReport();
+        g_timeSlicedJobs.printReport();
+        printFrameArenaReport();
+        m_scheduler.printJitterStats();
         frameCounter = 0;
     }
-    
-    // Notify render thread that game state has been updated
-    m_gameStateChanged.notify_one();
 }
 
 void GameThreadManager::pauseGame()
@@ -377,6 +435,9 @@ void GameThreadManager::pauseGame()
     std::cout << "Pausing game..." << std::endl;
     m_paused.store(true);
     
+    // Park the logic and movement loops (no wakeups until resume)
+    m_scheduler.pause();
+    
     // Set game state to PAUSE
     GAME_STATE = ::GameState::PAUSE;
     std::cout << "Game state set to: " << gameStateToString(GAME_STATE) << std::endl;
@@ -411,8 +472,8 @@ void GameThreadManager::resumeGame()
         g_playerMovementManager->resumeMovement();
     }
     
-    // Wake up any waiting threads
-    m_pauseCondition.notify_all();
+    // Wake up the parked loops
+    m_scheduler.resume();
 }
 
 // Convenience functions implementation
@@ -1,13 +1,14 @@
 #ifndef THREADING_H
 #define THREADING_H
 
-#include <thread>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <chrono>
 #include <functional>
 #include "enumDefinitions.h"
+#include "frameScheduler.h"
+#include "tickGraph.h"
+#include "simulationReplay.h"
 
 
 // Forward declarations
@@ -18,10 +19,12 @@ class Camera;
 class PlayerMovementManager;
 
 /**
- * GameThreadManager handles the separation of game logic and rendering into separate threads
- * - Game logic runs at fixed 60Hz timestep for entities and world state
- * - Player movement runs at 120Hz in separate thread for responsiveness
- * - Rendering runs at variable rate (up to display refresh rate)
+ * GameThreadManager separates game logic from rendering
+ * - Game logic runs at fixed 60Hz timestep for entities and world state, as a TickGraph of stages
+ * - Player movement runs at 120Hz on its own loop for responsiveness (inside the logic tick in a
+ *   lockstep session, see simulationReplay.h)
+ * - Both loops are driven by a FrameScheduler (absolute deadlines, no sleep-polling)
+ * - Rendering stays on the main thread, paced by its own frame deadline in main.cpp
  * - Thread synchronization prevents race conditions
  */
 class GameThreadManager {
@@ -35,7 +38,7 @@ public:
     // Initialize the threading system with game objects
     bool initialize(Map* gameMap, ElementsOnMap* elementsManager, EntitiesManager* entitiesManager, Camera* camera);
     
-    // Start the game and render threads
+    // Start the game logic and player movement loops
     void startThreads();
     
     // Stop all threads and cleanup
@@ -70,16 +73,14 @@ public:
     void setPlayerMovementInput(float moveX, float moveY, bool sprint);
     
 private:
-    // Thread functions
-    void gameLogicThread();
-    void renderThread();
-    
     // Game logic update function (runs at 60Hz)
     void updateGameLogic(double deltaTime);
     
-    // Threading objects
-    std::thread m_gameThread;
-    std::thread m_renderThread;
+    // Create the stages of one logic tick and their dependencies (once, in initialize)
+    void buildTickGraph();
+    
+    // Fixed-step loops (game logic + player movement)
+    FrameScheduler m_scheduler;
     std::atomic<bool> m_running;
     std::atomic<bool> m_threadsStarted;
     std::atomic<bool> m_paused;
@@ -87,8 +88,6 @@ private:
     // Synchronization
     mutable std::mutex m_gameStateMutex;
     mutable std::mutex m_inputStateMutex;
-    std::condition_variable m_gameStateChanged;
-    std::condition_variable m_pauseCondition;
     
     // Game objects (not owned by this class)
     Map* m_gameMap;
@@ -107,9 +106,22 @@ private:
         bool stateUpdated;
     } m_inputState;
     
+    // Lockstep session (decided when the manager is created, at gameplay start)
+    bool m_lockstep;
+    
+    // Logic tick graph and the data its stages hand to each other (written before/by earlier stages)
+    tf::Executor m_tickExecutor;
+    TickGraph m_tickGraph;
+    InputState m_tickInput;
+    double m_tickDeltaTime = 0.0;
+    double m_tickGameTime = 0.0;
+    ReplayTickInput m_tickReplayInput; // Lockstep only
+    float m_tickCameraLeft = 0.0f, m_tickCameraRight = 0.0f, m_tickCameraBottom = 0.0f, m_tickCameraTop = 0.0f;
+    
     // Timing constants
     static constexpr double GAME_LOGIC_FPS = 60.0;
     static constexpr double GAME_LOGIC_TIMESTEP = 1.0 / GAME_LOGIC_FPS;
+    static constexpr double PLAYER_UPDATE_FPS = 120.0; // Higher frequency for responsive movement
     
     // Timing variables
     std::chrono::high_resolution_clock::time_point m_lastGameUpdate;
@@ -0,0 +1,201 @@
+#include "tickGraph.h"
+#include "gameLog.h"
+#include "frameArena.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+void TickWorkerInterface::scheduler_prologue(tf::Worker& worker) {
+    PerformanceProfiler::getInstance().setCurrentThreadName("Tick worker " + std::to_string(worker.id()));
+}
+
+void TickWorkerInterface::scheduler_epilogue(tf::Worker&, std::exception_ptr) {
+}
+
+TickGraph::TickGraph(tf::Executor& executor)
+    : executor(executor), taskflow("Tick"),
+      tickSeconds(MetricsRegistry::getInstance().histogram("sorbetcoco_logic_tick_seconds",
+          "Wall time of one logic tick", frameTimeBuckets())),
+      criticalPathSeconds(MetricsRegistry::getInstance().histogram("sorbetcoco_logic_tick_critical_path_seconds",
+          "Longest chain of stages of one logic tick", frameTimeBuckets())),
+      lastTickSeconds(MetricsRegistry::getInstance().gauge("sorbetcoco_logic_tick_last_seconds",
+          "Wall time of the latest logic tick")) {
+    criticalPathZone = PerformanceProfiler::getInstance().registerZone("Tick_CriticalPath");
+}
+
+TickGraph::StageId TickGraph::addStage(const char* name, std::function<void()> work) {
+    StageId id = static_cast<StageId>(stages.size());
+    Stage stage;
+    stage.name = name;
+    stage.zone = PerformanceProfiler::getInstance().registerZone(name);
+    stage.work = std::move(work);
+    stages.push_back(std::move(stage));
+    return id;
+}
+
+void TickGraph::precede(StageId before, StageId after) {
+    if (before < 0 || after >= static_cast<StageId>(stages.size()) || before >= after) {
+        // Keeps the insertion order topological, which the critical path walk relies on
+        std::cerr << "TickGraph: stage " << before << " must be added before stage " << after << std::endl;
+        return;
+    }
+    if (tasksBuilt) {
+        std::cerr << "TickGraph: precede() after the first run() is ignored" << std::endl;
+        return;
+    }
+    stages[before].successors.push_back(after);
+    stages[after].predecessors.push_back(before);
+}
+
+void TickGraph::buildTasks() {
+    // Insertion order is topological, so a stage's predecessor already has its chain
+    std::vector<int> chainOf(stages.size(), -1);
+    for (StageId id = 0; id < static_cast<StageId>(stages.size()); ++id) {
+        const Stage& stage = stages[id];
+        if (stage.predecessors.size() == 1 && stages[stage.predecessors[0]].successors.size() == 1) {
+            chainOf[id] = chainOf[stage.predecessors[0]];
+            chains[chainOf[id]].push_back(id);
+        } else {
+            chainOf[id] = static_cast<int>(chains.size());
+            chains.push_back({id});
+        }
+    }
+
+    std::vector<tf::Task> tasks;
+    for (size_t chain = 0; chain < chains.size(); ++chain) {
+        tasks.push_back(taskflow.emplace([this, chain] {
+            for (StageId id : chains[chain]) {
+                runStage(id);
+            }
+        }).name(stages[chains[chain].front()].name));
+    }
+    for (size_t chain = 0; chain < chains.size(); ++chain) {
+        std::vector<int> successorChains;
+        for (StageId id : chains[chain]) {
+            for (StageId successor : stages[id].successors) {
+                int successorChain = chainOf[successor];
+                if (successorChain != static_cast<int>(chain) &&
+                    std::find(successorChains.begin(), successorChains.end(), successorChain) == successorChains.end()) {
+                    successorChains.push_back(successorChain);
+                    tasks[chain].precede(tasks[successorChain]);
+                }
+            }
+        }
+    }
+    tasksBuilt = true;
+}
+
+void TickGraph::runStage(StageId id) {
+    Stage& stage = stages[id];
+    uint64_t start = PerformanceProfiler::nowNanoseconds();
+    uint64_t allocationsAtStart = profileThreadHeapAllocations();
+    {
+        // Whatever the stage takes from this thread's frame arena is given back when it ends
+        FrameArenaScope arenaScope;
+        // CRASH FIX: a throwing stage must not cancel the rest of the tick
+        try {
+            stage.work();
+        } catch (const std::exception& e) {
+            GAME_LOG_ERROR("CRITICAL: Exception in tick stage " << stage.name << ": " << e.what());
+        } catch (...) {
+            GAME_LOG_ERROR("CRITICAL: Unknown exception in tick stage " << stage.name);
+        }
+    }
+    stage.lastDurationNanoseconds = PerformanceProfiler::nowNanoseconds() - start;
+    stage.lastHeapAllocations = profileThreadHeapAllocations() - allocationsAtStart;
+    PerformanceProfiler::getInstance().addSample(stage.zone, start, stage.lastDurationNanoseconds, stage.lastHeapAllocations);
+}
+
+void TickGraph::run() {
+    if (stages.empty()) return;
+    if (!tasksBuilt) buildTasks();
+    uint64_t start = PerformanceProfiler::nowNanoseconds();
+    executor.run(taskflow).wait();
+    accumulateCriticalPath(PerformanceProfiler::nowNanoseconds() - start);
+}
+
+void TickGraph::accumulateCriticalPath(uint64_t tickNanoseconds) {
+    // Longest path by measured durations: finish(stage) = duration + latest predecessor finish
+    finishTimes.assign(stages.size(), 0);
+    criticalFrom.assign(stages.size(), -1);
+    StageId last = 0;
+    for (StageId id = 0; id < static_cast<StageId>(stages.size()); ++id) {
+        uint64_t ready = 0;
+        for (StageId predecessor : stages[id].predecessors) {
+            if (finishTimes[predecessor] >= ready) {
+                ready = finishTimes[predecessor];
+                criticalFrom[id] = predecessor;
+            }
+        }
+        finishTimes[id] = ready + stages[id].lastDurationNanoseconds;
+        if (finishTimes[id] >= finishTimes[last]) last = id;
+
+        Stage& stage = stages[id];
+        stage.totalNanoseconds += stage.lastDurationNanoseconds;
+        stage.maxNanoseconds = std::max(stage.maxNanoseconds, stage.lastDurationNanoseconds);
+        stage.totalHeapAllocations += stage.lastHeapAllocations;
+        if (stage.lastHeapAllocations == 0) stage.allocationFreeCount++;
+    }
+    for (StageId id = last; id >= 0; id = criticalFrom[id]) {
+        stages[id].criticalCount++;
+    }
+
+    uint64_t criticalNanoseconds = finishTimes[last];
+    PerformanceProfiler::getInstance().addSample(criticalPathZone, PerformanceProfiler::nowNanoseconds() - criticalNanoseconds, criticalNanoseconds);
+    tickSeconds.observe(tickNanoseconds * 1e-9);
+    criticalPathSeconds.observe(criticalNanoseconds * 1e-9);
+    lastTickSeconds.set(tickNanoseconds * 1e-9);
+    windowTicks++;
+    windowCriticalNanoseconds += criticalNanoseconds;
+    windowTickNanoseconds += tickNanoseconds;
+}
+
+std::vector<TickStageReport> TickGraph::collectReport(double& averageCriticalPathMs, double& averageTickMs) {
+    std::vector<TickStageReport> reports;
+    double ticks = static_cast<double>(std::max<uint64_t>(windowTicks, 1));
+    averageCriticalPathMs = windowCriticalNanoseconds / ticks / 1000000.0;
+    averageTickMs = windowTickNanoseconds / ticks / 1000000.0;
+
+    for (Stage& stage : stages) {
+        TickStageReport report;
+        report.name = stage.name;
+        report.averageMs = stage.totalNanoseconds / ticks / 1000000.0;
+        report.maxMs = stage.maxNanoseconds / 1000000.0;
+        report.criticalShare = stage.criticalCount / ticks;
+        report.heapAllocationsPerTick = stage.totalHeapAllocations / ticks;
+        report.allocationFreeShare = stage.allocationFreeCount / ticks;
+        reports.push_back(report);
+
+        stage.totalNanoseconds = 0;
+        stage.maxNanoseconds = 0;
+        stage.criticalCount = 0;
+        stage.totalHeapAllocations = 0;
+        stage.allocationFreeCount = 0;
+    }
+    windowTicks = 0;
+    windowCriticalNanoseconds = 0;
+    windowTickNanoseconds = 0;
+    return reports;
+}
+
+void TickGraph::printReport() {
+    double averageCriticalPathMs = 0.0;
+    double averageTickMs = 0.0;
+    std::vector<TickStageReport> reports = collectReport(averageCriticalPathMs, averageTickMs);
+
+    std::cout << "=== Tick Graph ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    // Tick minus critical path = time lost to scheduling between stages
+    std::cout << "Tick avg=" << averageTickMs << "ms, critical path avg=" << averageCriticalPathMs << "ms ("
+              << stages.size() << " stages in " << chains.size() << " tasks)" << std::endl;
+    for (const auto& report : reports) {
+        std::cout << "  " << report.name << ": avg=" << report.averageMs << "ms max=" << report.maxMs
+                  << "ms on critical path " << std::setprecision(0) << report.criticalShare * 100.0 << "%"
+                  << std::setprecision(1) << ", heap allocs/tick=" << report.heapAllocationsPerTick
+                  << std::setprecision(0) << " (malloc-free " << report.allocationFreeShare * 100.0 << "%)"
+                  << std::setprecision(3) << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "performanceProfiler.h" // For ProfileZoneId
+#include "metrics.h"
+#include <taskflow.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// One simulation tick as a Taskflow dependency graph, built once and re-run every tick:
+//  - addStage() registers a named stage, precede() says which stage must finish first
+//  - stages without a path between them run concurrently on the executor's workers
+//  - a serial run of stages (each one the only successor of the previous one, which is its only
+//    predecessor) becomes a single Taskflow task that calls them back to back, so a chain costs
+//    one executor hop, not one per stage. The tasks are built on the first run().
+//  - every stage is timed (also as a profiler zone of the same name); after each run the
+//    longest chain through the graph - the critical path - is worked out from those times,
+//    because that chain, not the sum of all stages, is what bounds the tick duration
+//  - tick and critical path durations are published as sorbetcoco_logic_tick_* metrics
+//  - every stage runs inside a FrameArenaScope (frameArena.h) and its heap allocations are
+//    counted, so the report shows which stages still call malloc
+//
+// Stages must be added in dependency order (precede(a, b) needs a added before b) so the
+// insertion order is a topological order.
+
+const int TICK_GRAPH_WORKERS = 3; // Three short stages are ready at once after the input
+
+// Names the tick executor's workers in the profiler trace ("Tick worker N")
+class TickWorkerInterface : public tf::WorkerInterface {
+public:
+    void scheduler_prologue(tf::Worker& worker) override;
+    void scheduler_epilogue(tf::Worker& worker, std::exception_ptr exception) override;
+};
+
+struct TickStageReport {
+    const char* name = "";
+    double averageMs = 0.0;
+    double maxMs = 0.0;
+    double criticalShare = 0.0; // Fraction of ticks where the stage was on the critical path
+    double heapAllocationsPerTick = 0.0;
+    double allocationFreeShare = 0.0; // Fraction of ticks where the stage made no heap allocation
+};
+
+class TickGraph {
+public:
+    typedef int StageId;
+
+    explicit TickGraph(tf::Executor& executor);
+    TickGraph(const TickGraph&) = delete;
+    TickGraph& operator=(const TickGraph&) = delete;
+
+    // Name must outlive the graph (a string literal)
+    StageId addStage(const char* name, std::function<void()> work);
+    void precede(StageId before, StageId after);
+
+    // Run every stage once and wait for the whole graph (called from the tick thread)
+    void run();
+
+    // Per-stage times and critical path since the last report (then starts a new window)
+    std::vector<TickStageReport> collectReport(double& averageCriticalPathMs, double& averageTickMs);
+    void printReport();
+
+private:
+    struct Stage {
+        const char* name;
+        ProfileZoneId zone;
+        std::function<void()> work;
+        std::vector<StageId> predecessors;
+        std::vector<StageId> successors;
+        uint64_t lastDurationNanoseconds = 0; // Written by the stage, read after run() joined
+        uint64_t lastHeapAllocations = 0;     // Same
+        // Report window (tick thread only)
+        uint64_t totalNanoseconds = 0;
+        uint64_t maxNanoseconds = 0;
+        uint64_t criticalCount = 0;
+        uint64_t totalHeapAllocations = 0;
+        uint64_t allocationFreeCount = 0;
+    };
+
+    void runStage(StageId id);
+    // One task per serial run of stages, wired like the stages (first run())
+    void buildTasks();
+    void accumulateCriticalPath(uint64_t tickNanoseconds);
+
+    tf::Executor& executor;
+    tf::Taskflow taskflow;
+    std::vector<Stage> stages; // Indexed by StageId
+    std::vector<std::vector<StageId>> chains; // Stages of each task, in run order
+    bool tasksBuilt = false;
+    ProfileZoneId criticalPathZone;
+    MetricHistogram& tickSeconds;
+    MetricHistogram& criticalPathSeconds;
+    MetricGauge& lastTickSeconds;
+
+    std::vector<uint64_t> finishTimes;  // Scratch for the critical path walk
+    std::vector<StageId> criticalFrom;
+    uint64_t windowTicks = 0;
+    uint64_t windowCriticalNanoseconds = 0;
+    uint64_t windowTickNanoseconds = 0;
+};
@@ -0,0 +1,186 @@
+#include "tileRenderer.h"
+#include "gameLog.h"
+#include "tools/shaders.hpp" // glbasimac shader loader (same as the engine's shaders)
+#include <cstddef> // offsetof
+#include <iostream>
+
+namespace {
+
+// Instance attribute locations (tile_animated.vert)
+const GLuint ATTRIBUTE_CELL = 0;
+const GLuint ATTRIBUTE_PHASE_OFFSET = 1;
+const GLuint ATTRIBUTE_ROTATION = 2;
+
+} // namespace
+
+bool TileRenderer::init() {
+    if (initAttempted) {
+        return ready;
+    }
+    initAttempted = true;
+
+    if (!GLAD_GL_VERSION_3_3) {
+        GAME_LOG_WARN("Tile renderer: OpenGL 3.3 not available, blocks are drawn in immediate mode");
+        return false;
+    }
+
+    // Same fragment stage as the sprites: the texel, like GL_REPLACE on a white quad
+    program = STP3D::ShaderManager::loadShader("../assets/shaders/tile_animated.vert", "../assets/shaders/sprite_instanced.frag", false);
+    if (program == 0) {
+        GAME_LOG_WARN("Tile renderer: could not build the tile shader, blocks are drawn in immediate mode");
+        return false;
+    }
+    transformLocation = glGetUniformLocation(program, "transformMat");
+    textureLocation = glGetUniformLocation(program, "tex0");
+    cameraRectLocation = glGetUniformLocation(program, "cameraRect");
+    gridRectLocation = glGetUniformLocation(program, "gridRect");
+    cellSizeLocation = glGetUniformLocation(program, "cellSize");
+    cullRectLocation = glGetUniformLocation(program, "cullRect");
+    frameCountLocation = glGetUniformLocation(program, "frameCount");
+    frameRatioLocation = glGetUniformLocation(program, "frameRatio");
+    wrappedPhaseLocation = glGetUniformLocation(program, "wrappedPhase");
+
+    // The attributes are per instance; the stream and its offset are set per run in drawChunk()
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+    glEnableVertexAttribArray(ATTRIBUTE_CELL);
+    glEnableVertexAttribArray(ATTRIBUTE_PHASE_OFFSET);
+    glEnableVertexAttribArray(ATTRIBUTE_ROTATION);
+    glVertexAttribDivisor(ATTRIBUTE_CELL, 1);
+    glVertexAttribDivisor(ATTRIBUTE_PHASE_OFFSET, 1);
+    glVertexAttribDivisor(ATTRIBUTE_ROTATION, 1);
+    glBindVertexArray(0);
+
+    ready = true;
+    std::cout << "Tile renderer: per-chunk tile streams, animation and rotation in the vertex shader" << std::endl;
+    return ready;
+}
+
+bool TileRenderer::hasChunk(int chunkX, int chunkY, unsigned int contentVersion) const {
+    auto it = chunkStreams.find({chunkX, chunkY});
+    return it != chunkStreams.end() && it->second.contentVersion == contentVersion;
+}
+
+void TileRenderer::uploadChunk(int chunkX, int chunkY, unsigned int contentVersion, const std::vector<TileInstance>& tiles, const std::vector<TileRun>& runs) {
+    ChunkStream& stream = chunkStreams[{chunkX, chunkY}];
+    if (stream.buffer == 0) {
+        glGenBuffers(1, &stream.buffer);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(tiles.size() * sizeof(TileInstance)), tiles.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    stream.contentVersion = contentVersion;
+    stream.runs = runs;
+    lastChunkUploads++;
+}
+
+void TileRenderer::setTileAttributes(size_t byteOffset) {
+    const GLsizei stride = sizeof(TileInstance);
+    auto at = [byteOffset](size_t fieldOffset) {
+        return reinterpret_cast<const void*>(byteOffset + fieldOffset);
+    };
+    glVertexAttribPointer(ATTRIBUTE_CELL, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(TileInstance, x)));
+    glVertexAttribPointer(ATTRIBUTE_PHASE_OFFSET, 1, GL_FLOAT, GL_FALSE, stride, at(offsetof(TileInstance, phaseOffset)));
+    glVertexAttribIPointer(ATTRIBUTE_ROTATION, 1, GL_UNSIGNED_INT, stride, at(offsetof(TileInstance, rotation)));
+}
+
+void TileRenderer::beginFrame(const TileView& view) {
+    lastDrawCalls = 0;
+    lastChunkUploads = 0;
+
+    // Same transform as the immediate-mode quads: projection * modelview of the fixed-function stack
+    GLfloat projection[16];
+    GLfloat modelview[16];
+    GLfloat transform[16];
+    glGetFloatv(GL_PROJECTION_MATRIX, projection);
+    glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            transform[column * 4 + row] = projection[0 * 4 + row] * modelview[column * 4 + 0] +
+                                          projection[1 * 4 + row] * modelview[column * 4 + 1] +
+                                          projection[2 * 4 + row] * modelview[column * 4 + 2] +
+                                          projection[3 * 4 + row] * modelview[column * 4 + 3];
+        }
+    }
+
+    // The differences are computed here exactly like collectBlockQuads computes them
+    float viewWidth = view.cameraRight - view.cameraLeft;
+    float viewHeight = view.cameraTop - view.cameraBottom;
+    float gridWidth = view.endX - view.startX;
+    float gridHeight = view.endY - view.startY;
+
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(program);
+    glUniformMatrix4fv(transformLocation, 1, GL_FALSE, transform);
+    glUniform1i(textureLocation, 0);
+    glUniform4f(cameraRectLocation, view.cameraLeft, view.cameraBottom, viewWidth, viewHeight);
+    glUniform4f(gridRectLocation, view.startX, view.startY, gridWidth, gridHeight);
+    glUniform2f(cellSizeLocation, gridWidth / viewWidth, gridHeight / viewHeight);
+    glUniform4f(cullRectLocation, view.cameraLeft - 1, view.cameraRight + 1, view.cameraBottom - 1, view.cameraTop + 1);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(vertexArray);
+}
+
+void TileRenderer::drawChunk(int chunkX, int chunkY, const std::vector<TileTypeAnimation>& types) {
+    auto it = chunkStreams.find({chunkX, chunkY});
+    if (it == chunkStreams.end()) {
+        return;
+    }
+    ChunkStream& stream = it->second;
+    stream.lastDrawnFrame = frameIndex;
+
+    glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+    for (const TileRun& run : stream.runs) {
+        if (run.typeIndex < 0 || static_cast<size_t>(run.typeIndex) >= types.size() || !types[run.typeIndex].known) {
+            continue;
+        }
+        const TileTypeAnimation& type = types[run.typeIndex];
+        glBindTexture(GL_TEXTURE_2D, type.textureID);
+        glUniform1f(frameCountLocation, type.frameCount);
+        glUniform1f(frameRatioLocation, type.frameRatio);
+        glUniform1f(wrappedPhaseLocation, type.wrappedPhase);
+        setTileAttributes(run.first * sizeof(TileInstance));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(run.count));
+        lastDrawCalls++;
+    }
+}
+
+void TileRenderer::endFrame() {
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(static_cast<GLuint>(previousProgram)); // Normally 0: the elements and the overlays use the fixed-function pipeline
+
+    // Streams of chunks out of view (or unloaded) for a while: free the GPU memory
+    frameIndex++;
+    if (frameIndex % 256 == 0) {
+        for (auto it = chunkStreams.begin(); it != chunkStreams.end();) {
+            if (frameIndex - it->second.lastDrawnFrame > TILE_CHUNK_RETENTION_FRAMES) {
+                glDeleteBuffers(1, &it->second.buffer);
+                it = chunkStreams.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void TileRenderer::clearChunks() {
+    for (auto& entry : chunkStreams) {
+        glDeleteBuffers(1, &entry.second.buffer);
+    }
+    chunkStreams.clear();
+}
+
+void TileRenderer::shutdown() {
+    if (!ready) {
+        return;
+    }
+    clearChunks();
+    glDeleteVertexArrays(1, &vertexArray);
+    vertexArray = 0;
+    STP3D::ShaderManager::deleteProgram(program);
+    program = 0;
+    ready = false;
+    initAttempted = false;
+}
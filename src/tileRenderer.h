@@ -0,0 +1,126 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+// GPU path of Map::drawBlocks: the blocks of a chunk are uploaded once as a static stream of
+// TileInstance records and drawn with one glDrawArraysInstanced per block type of the chunk.
+// tile_animated.vert derives everything drawBlocks used to compute per block every frame:
+//  - the quad in grid space, from the block cell and the camera/grid rectangles (uniforms)
+//  - the camera cull (blocks outside the view collapse to a degenerate quad)
+//  - the texture rows of the animation frame, from the tile phase offset and the wrapped phase of
+//    its block type (one uniform per draw, see tileAnimationFrame)
+//  - the corner order of the texture coordinates for the rotation code
+// A chunk stream is rebuilt only when its content version changes (block placed, chunk loaded),
+// so once the visible chunks are resident a frame does no per-block work on the CPU.
+// Needs GL 3.3; when init fails drawBlocks keeps its immediate-mode quads. GL thread only.
+
+const unsigned long long TILE_CHUNK_RETENTION_FRAMES = 600; // Chunk streams not drawn for this long are deleted
+
+// One block of a chunk stream, 16 bytes (attribute layout in tile_animated.vert)
+struct TileInstance {
+    float x, y;          // Block cell (world units, exact as floats)
+    float phaseOffset;   // Block::currentFrame: animation phase at clock 0, in frames
+    uint32_t rotation;   // rotationAngle / 90
+};
+
+// Consecutive tiles of one block type in a chunk stream
+struct TileRun {
+    int typeIndex; // static_cast<int>(BlockName), index in the TileTypeAnimation table
+    size_t first;
+    size_t count;
+};
+
+// Per block type state of the current frame (Map::advanceBlockAnimations)
+struct TileTypeAnimation {
+    bool known = false;      // The type has texture details (unknown types are not drawn)
+    GLuint textureID = 0;
+    float frameCount = 1.0f; // 1 for static textures
+    float frameRatio = 1.0f; // 1.0f / frameCount, the height of one frame in texture space
+    float wrappedPhase = 0.0f;
+};
+
+// Grid rectangle on screen and camera rectangle in world units (the drawBlocks arguments)
+struct TileView {
+    float startX, endX, startY, endY;
+    float cameraLeft, cameraRight, cameraBottom, cameraTop;
+};
+
+// Frame a block shows: its phase offset plus the wrapped phase of its type, wrapped once more.
+// The CPU quads and tile_animated.vert both do exactly these float operations, so the two paths
+// always pick the same frame.
+inline int tileAnimationFrame(float phaseOffset, float wrappedPhase, int frameCount) {
+    float frame = phaseOffset + wrappedPhase;
+    if (frame >= frameCount) {
+        frame -= frameCount;
+    }
+    return static_cast<int>(frame);
+}
+
+class TileRenderer {
+public:
+    TileRenderer() = default;
+    TileRenderer(const TileRenderer&) = delete;
+    TileRenderer& operator=(const TileRenderer&) = delete;
+
+    // Compile the shader (context current). False when the context cannot run it; the result is
+    // kept, later calls return it without retrying.
+    bool init();
+    bool isReady() const { return ready; }
+
+    // Whether the stream of the chunk was built from this content version
+    bool hasChunk(int chunkX, int chunkY, unsigned int contentVersion) const;
+    // (Re)upload the stream of a chunk; tiles are grouped by type, one run per type
+    void uploadChunk(int chunkX, int chunkY, unsigned int contentVersion, const std::vector<TileInstance>& tiles, const std::vector<TileRun>& runs);
+
+    // Bind the program and set the view uniforms, then drawChunk for every visible chunk
+    void beginFrame(const TileView& view);
+    void drawChunk(int chunkX, int chunkY, const std::vector<TileTypeAnimation>& types);
+    // Restore the fixed-function state and delete the streams of chunks not drawn for a while
+    void endFrame();
+
+    // Delete every chunk stream (the chunks are rebuilt on the next draw)
+    void clearChunks();
+    // Delete the GL objects (context still current)
+    void shutdown();
+
+    // Last frame: instanced draw calls and chunk streams uploaded
+    size_t getLastDrawCalls() const { return lastDrawCalls; }
+    size_t getLastChunkUploads() const { return lastChunkUploads; }
+    size_t getChunkStreamCount() const { return chunkStreams.size(); }
+
+private:
+    struct ChunkStream {
+        GLuint buffer = 0;
+        unsigned int contentVersion = 0;
+        std::vector<TileRun> runs;
+        unsigned long long lastDrawnFrame = 0;
+    };
+
+    void setTileAttributes(size_t byteOffset);
+
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLint transformLocation = -1;
+    GLint textureLocation = -1;
+    GLint cameraRectLocation = -1;
+    GLint gridRectLocation = -1;
+    GLint cellSizeLocation = -1;
+    GLint cullRectLocation = -1;
+    GLint frameCountLocation = -1;
+    GLint frameRatioLocation = -1;
+    GLint wrappedPhaseLocation = -1;
+
+    bool initAttempted = false;
+    bool ready = false;
+    GLint previousProgram = 0;
+
+    std::map<std::pair<int, int>, ChunkStream> chunkStreams; // Key = (chunkX, chunkY)
+    unsigned long long frameIndex = 0;
+    size_t lastDrawCalls = 0;
+    size_t lastChunkUploads = 0;
+};
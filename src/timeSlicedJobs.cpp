@@ -0,0 +1,187 @@
+#include "timeSlicedJobs.h"
+#include "metrics.h"
+#include <iomanip>
+#include <iostream>
+
+TimeSlicedJobs g_timeSlicedJobs;
+
+namespace {
+
+struct JobMetrics {
+    MetricCounter& steps;
+    MetricCounter& completed;
+    MetricCounter& overruns;
+    MetricCounter& carriedOver;
+    MetricGauge& queueDepth;
+    MetricHistogram& sliceSeconds;
+};
+
+JobMetrics& jobMetrics() {
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    static JobMetrics instance{
+        metrics.counter("sorbetcoco_jobs_steps_total", "Time-sliced job steps run"),
+        metrics.counter("sorbetcoco_jobs_completed_total", "Time-sliced jobs finished"),
+        metrics.counter("sorbetcoco_jobs_budget_overruns_total", "Ticks where the job steps ran past the tick budget"),
+        metrics.counter("sorbetcoco_jobs_carried_over_total", "Ticks that ended with jobs still queued"),
+        metrics.gauge("sorbetcoco_jobs_queue_depth", "Time-sliced jobs waiting for the next tick"),
+        metrics.histogram("sorbetcoco_jobs_slice_seconds", "Wall time spent on jobs per tick", frameTimeBuckets())};
+    return instance;
+}
+
+} // namespace
+
+void TimeSlicedJobs::submit(const char* name, StepFunction step, const std::string& key) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    uint64_t id = nextJobId++;
+    if (!key.empty()) {
+        // An older job with this key is skipped when it comes up (see popRunnable)
+        liveKeys[key] = id;
+    }
+    queue.push_back(Job{name, key, std::move(step), id, 0, Clock::now()});
+}
+
+bool TimeSlicedJobs::isQueued(const std::string& key) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return liveKeys.count(key) != 0;
+}
+
+void TimeSlicedJobs::cancel(const std::string& key) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    liveKeys.erase(key);
+}
+
+void TimeSlicedJobs::clear() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queue.clear();
+    liveKeys.clear();
+}
+
+size_t TimeSlicedJobs::getPendingCount() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return queue.size();
+}
+
+bool TimeSlicedJobs::popRunnable(Job& job) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    while (!queue.empty()) {
+        job = std::move(queue.front());
+        queue.pop_front();
+        if (job.key.empty()) return true;
+        auto keyIt = liveKeys.find(job.key);
+        if (keyIt != liveKeys.end() && keyIt->second == job.id) return true;
+        // Replaced by a newer job with the same key, or cancelled
+    }
+    return false;
+}
+
+template <typename KeepGoing>
+void TimeSlicedJobs::runWhile(double budgetMs, KeepGoing keepGoing) {
+    Clock::time_point start = Clock::now();
+    uint64_t steps = 0;
+    uint64_t elapsed = 0;
+    Job job;
+
+    // Round-robin: one step per job, then the job goes to the back of the queue, so a long
+    // rebuild can't starve the short searches queued behind it
+    while (keepGoing(steps, elapsed) && popRunnable(job)) {
+        Clock::time_point stepStart = Clock::now();
+        JobStep result = JobStep::DONE;
+        // CRASH FIX: a throwing job is dropped instead of taking the logic tick down with it
+        try {
+            result = job.step();
+        } catch (const std::exception& e) {
+            std::cerr << "Time-sliced job " << job.name << " threw: " << e.what() << " - dropped" << std::endl;
+        } catch (...) {
+            std::cerr << "Time-sliced job " << job.name << " threw - dropped" << std::endl;
+        }
+        Clock::time_point stepEnd = Clock::now();
+        uint64_t stepNanoseconds = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(stepEnd - stepStart).count());
+        elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stepEnd - start).count());
+        ++steps;
+        ++job.steps;
+        if (stepNanoseconds > windowMaxStepNanoseconds) {
+            windowMaxStepNanoseconds = stepNanoseconds;
+            windowMaxStepJob = job.name;
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto keyIt = job.key.empty() ? liveKeys.end() : liveKeys.find(job.key);
+        bool stillOwnsKey = job.key.empty() || (keyIt != liveKeys.end() && keyIt->second == job.id);
+        if (result == JobStep::CONTINUE) {
+            if (stillOwnsKey) queue.push_back(std::move(job));
+            continue;
+        }
+        if (!job.key.empty() && stillOwnsKey) {
+            liveKeys.erase(keyIt);
+        }
+        ++windowCompleted;
+        jobMetrics().completed.increment();
+        double latencyMs = std::chrono::duration<double, std::milli>(stepEnd - job.submitTime).count();
+        if (latencyMs > windowMaxLatencyMs) windowMaxLatencyMs = latencyMs;
+    }
+
+    JobMetrics& metrics = jobMetrics();
+    size_t pending = getPendingCount();
+    ++windowTicks;
+    windowSteps += steps;
+    windowNanoseconds += elapsed;
+    if (elapsed > windowMaxNanoseconds) windowMaxNanoseconds = elapsed;
+    if (elapsed > static_cast<uint64_t>(budgetMs * 1e6)) {
+        ++windowOverruns;
+        metrics.overruns.increment();
+    }
+    if (pending > 0) {
+        ++windowCarriedOver;
+        metrics.carriedOver.increment();
+    }
+    metrics.steps.increment(static_cast<double>(steps));
+    metrics.queueDepth.set(static_cast<double>(pending));
+    metrics.sliceSeconds.observe(elapsed / 1e9);
+}
+
+void TimeSlicedJobs::runFor(double budgetMs) {
+    const uint64_t budgetNanoseconds = static_cast<uint64_t>(budgetMs * 1e6);
+    runWhile(budgetMs, [budgetNanoseconds](uint64_t, uint64_t elapsed) {
+        return elapsed < budgetNanoseconds;
+    });
+}
+
+void TimeSlicedJobs::runSteps(int maxSteps) {
+    // Overruns are still measured against the wall-time budget
+    runWhile(TICK_JOB_BUDGET_MS, [maxSteps](uint64_t steps, uint64_t) {
+        return steps < static_cast<uint64_t>(maxSteps);
+    });
+}
+
+void TimeSlicedJobs::runAll() {
+    while (getPendingCount() > 0) {
+        runSteps(LOCKSTEP_JOB_STEPS_PER_TICK);
+    }
+}
+
+void TimeSlicedJobs::printReport() {
+    if (windowTicks == 0) return;
+
+    std::cout << "=== Time-Sliced Jobs ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Per tick avg=" << (windowNanoseconds / 1e6) / windowTicks << "ms max=" << windowMaxNanoseconds / 1e6
+              << "ms (budget " << TICK_JOB_BUDGET_MS << "ms), steps=" << windowSteps
+              << ", completed=" << windowCompleted << ", queued=" << getPendingCount() << std::endl;
+    std::cout << "Budget overruns=" << windowOverruns << "/" << windowTicks << " ticks, carried over="
+              << windowCarriedOver << " ticks, longest step=" << windowMaxStepNanoseconds / 1e6 << "ms ("
+              << windowMaxStepJob << "), longest wait=" << windowMaxLatencyMs << "ms" << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+
+    windowTicks = 0;
+    windowSteps = 0;
+    windowCompleted = 0;
+    windowOverruns = 0;
+    windowCarriedOver = 0;
+    windowNanoseconds = 0;
+    windowMaxNanoseconds = 0;
+    windowMaxStepNanoseconds = 0;
+    windowMaxStepJob = "";
+    windowMaxLatencyMs = 0.0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Cooperative time-sliced jobs for gameplay work too expensive to finish inside one tick
+// (flee point and unstuck searches, pathfinding graph refreshes, mass element removal):
+//  - a job is a step function doing a small, bounded piece of its work per call and returning
+//    JobStep::CONTINUE until it is finished (the job keeps its progress in its captures)
+//  - the Tick_Jobs stage runs the queued jobs round-robin until TICK_JOB_BUDGET_MS is used up;
+//    whatever is left carries over to the next tick, so one expensive request costs a few ticks
+//    of latency instead of one long tick
+//  - a lockstep session runs a fixed number of steps per tick instead: how far a job gets must
+//    not depend on how fast the machine is
+//  - a budget overrun is a tick where the steps ran past the budget (one step too large);
+//    overruns, steps, completions and carried-over ticks are published as sorbetcoco_jobs_*
+//    metrics and printed with the 5 second tick report
+// Jobs may be submitted from any thread; they only ever run on the tick thread.
+
+const double TICK_JOB_BUDGET_MS = 2.0;          // Wall time per logic tick (of the 16.7 ms)
+const int LOCKSTEP_JOB_STEPS_PER_TICK = 48;     // Steps per tick in a lockstep session
+
+enum class JobStep {
+    CONTINUE,
+    DONE
+};
+
+class TimeSlicedJobs {
+public:
+    typedef std::function<JobStep()> StepFunction;
+
+    // Queue a job. A non-empty key names it: submitting a key that is still queued replaces the
+    // older job (a newer flee search for the same entity makes the pending one pointless).
+    // Name must outlive the job (a string literal); it labels the report.
+    void submit(const char* name, StepFunction step, const std::string& key = "");
+    bool isQueued(const std::string& key);
+    void cancel(const std::string& key);
+    // Drop every queued job (gameplay end)
+    void clear();
+    size_t getPendingCount();
+
+    // Run queued jobs until budgetMs of wall time is used or the queue is empty (tick thread)
+    void runFor(double budgetMs);
+    // Run at most maxSteps steps (lockstep sessions)
+    void runSteps(int maxSteps);
+    // Finish every queued job, whatever it costs (bench teardown)
+    void runAll();
+
+    void printReport();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Job {
+        const char* name;
+        std::string key;
+        StepFunction step;
+        uint64_t id;
+        uint64_t steps;
+        Clock::time_point submitTime;
+    };
+
+    // Runs queued jobs while keepGoing(stepsSoFar, elapsedNanoseconds) says so
+    template <typename KeepGoing>
+    void runWhile(double budgetMs, KeepGoing keepGoing);
+    bool popRunnable(Job& job);
+
+    std::mutex queueMutex;
+    std::deque<Job> queue;
+    std::unordered_map<std::string, uint64_t> liveKeys; // Key -> id of the job that owns it
+    uint64_t nextJobId = 1;
+
+    // Report window (tick thread only)
+    uint64_t windowTicks = 0;
+    uint64_t windowSteps = 0;
+    uint64_t windowCompleted = 0;
+    uint64_t windowOverruns = 0;
+    uint64_t windowCarriedOver = 0;
+    uint64_t windowNanoseconds = 0;
+    uint64_t windowMaxNanoseconds = 0;
+    uint64_t windowMaxStepNanoseconds = 0;
+    const char* windowMaxStepJob = "";
+    double windowMaxLatencyMs = 0.0;   // Submission to completion
+};
+
+extern TimeSlicedJobs g_timeSlicedJobs;
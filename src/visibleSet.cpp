@@ -0,0 +1,61 @@
+#include "visibleSet.h"
+#include <algorithm>
+#include <cmath>
+
+VisibleSet g_visibleSet;
+
+namespace {
+
+// Floor division, also for the negative coordinates of a view past the world's edge
+int floorDivide(int value, int divisor) {
+    int quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+} // namespace
+
+void VisibleSet::update(float gridStartX, float gridEndX, float gridStartY, float gridEndY, const CameraView& view) {
+    startX = gridStartX;
+    endX = gridEndX;
+    startY = gridStartY;
+    endY = gridEndY;
+    camera = view;
+
+    // The blocks the quads have always drawn: x in [left - 1, right + 1], y in [bottom - 1, top + 1]
+    firstBlockX = static_cast<int>(std::ceil(view.left - 1));
+    lastBlockX = static_cast<int>(std::floor(view.right + 1));
+    firstBlockY = static_cast<int>(std::ceil(view.bottom - 1));
+    lastBlockY = static_cast<int>(std::floor(view.top + 1));
+    firstChunkX = floorDivide(firstBlockX, CHUNK_SIZE);
+    lastChunkX = floorDivide(lastBlockX, CHUNK_SIZE);
+    firstChunkY = floorDivide(firstBlockY, CHUNK_SIZE);
+    lastChunkY = floorDivide(lastBlockY, CHUNK_SIZE);
+
+    motion = MotionFrame::capture();
+
+    // A new frame number forgets the previous frame's elements without clearing the marks
+    elements.clear();
+    if (++frame == 0) {
+        std::fill(elementFrames.begin(), elementFrames.end(), 0u);
+        frame = 1;
+    }
+}
+
+int VisibleSet::chunkCoordinate(float worldCoordinate) {
+    return floorDivide(static_cast<int>(std::floor(worldCoordinate)), CHUNK_SIZE);
+}
+
+bool VisibleSet::overlaps(float minX, float minY, float maxX, float maxY, float margin) const {
+    return !(maxX < camera.left - margin || minX > camera.right + margin ||
+             maxY < camera.bottom - margin || minY > camera.top + margin);
+}
+
+void VisibleSet::addElement(SymbolId symbol) {
+    if (symbol >= elementFrames.size()) {
+        elementFrames.resize(symbol + 1, 0u);
+    }
+    if (elementFrames[symbol] != frame) {
+        elementFrames[symbol] = frame;
+        elements.push_back(symbol);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "camera.h"
+#include "map.h" // CHUNK_SIZE
+#include "motionInterpolation.h"
+#include "symbolTable.h"
+#include <cstdint>
+#include <vector>
+
+// What the camera sees in the frame being rendered, computed once per frame (main.cpp, before the
+// world draw passes) and shared by all of them instead of each pass testing every block, element
+// and entity against the camera rectangle on its own:
+//  - the chunk range and the block cells under the view, grown by one block (the margin the block
+//    quads always had): Map::drawBlocks only visits those cells
+//  - the elements in view, looked up in the chunk grid of ElementsOnMap (collectVisibleElements)
+//    and tested at their interpolated position: drawElements draws those, and the entity debug
+//    overlays ask isElementVisible (an entity shares the symbol of its element)
+//  - the motion frame (motionInterpolation.h), captured once so every pass draws the same instant
+// Updated by the render thread; the render workers fill and read it while that thread waits
+// for them (renderCommands.h).
+class VisibleSet {
+public:
+    // Screen rectangle of the grid and camera rectangle in world units (the draw pass arguments).
+    // Clears the elements: collectVisibleElements fills them again.
+    void update(float gridStartX, float gridEndX, float gridStartY, float gridEndY, const CameraView& view);
+
+    // Chunk containing a world coordinate (any sign)
+    static int chunkCoordinate(float worldCoordinate);
+
+    // World rectangle touches the camera rectangle grown by margin
+    bool overlaps(float minX, float minY, float maxX, float maxY, float margin = 0.0f) const;
+
+    void addElement(SymbolId symbol);
+    bool isElementVisible(SymbolId symbol) const {
+        return symbol < elementFrames.size() && elementFrames[symbol] == frame;
+    }
+    const std::vector<SymbolId>& getElements() const { return elements; }
+
+    // Grid rectangle on screen
+    float startX = -1.0f;
+    float endX = 1.0f;
+    float startY = -1.0f;
+    float endY = 1.0f;
+    CameraView camera;
+
+    // Block cells drawn (world coordinates, inclusive, not clamped to the world)
+    int firstBlockX = 0;
+    int lastBlockX = -1;
+    int firstBlockY = 0;
+    int lastBlockY = -1;
+    // Chunks holding those cells (inclusive, not clamped to the chunk grid of the map)
+    int firstChunkX = 0;
+    int lastChunkX = -1;
+    int firstChunkY = 0;
+    int lastChunkY = -1;
+
+    MotionFrame motion;
+
+private:
+    uint32_t frame = 0;
+    std::vector<SymbolId> elements;       // Unordered: drawElements sorts them for drawing
+    std::vector<uint32_t> elementFrames;  // By SymbolId: frame the element was last visible in
+};
+
+// The set of the frame being rendered (main.cpp)
+extern VisibleSet g_visibleSet;
@@ -0,0 +1,935 @@
+#include "worldSave.h"
+#include "entities.h"
+#include "chunkStreaming.h"
+#include "globals.h" // For SEED_GAMEPLAY, WORLD_SIZE, GRID_SIZE, COCONUT_COUNTER and the save settings
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Global instances
+WorldSaveFile g_loadedWorldSave;
+WorldSaver g_worldSaver;
+
+// Everything captured for one save
+struct WorldSaveJob {
+    std::string path;
+    bool fresh = false; // Write a new file instead of updating the tracked one
+    WorldSaveHeader header = {};
+    std::vector<ChunkImage> chunks; // Only the chunks that changed since the last save
+    std::vector<BlockTimerState> blockTimers;
+    std::map<std::pair<int, int>, BlockName> savedExistingBlocks;
+    std::vector<PlacedElement> elements;
+    std::vector<SavedEntity> entities;
+};
+
+namespace {
+
+uint64_t alignUp(uint64_t value) {
+    return (value + WORLD_SAVE_ALIGNMENT - 1) / WORLD_SAVE_ALIGNMENT * WORLD_SAVE_ALIGNMENT;
+}
+
+// Push what was written to a file (or a rename in a directory) from the OS cache to the disk.
+// Any handle to the file will do, so the writer's stream can stay open.
+bool syncToDisk(const std::filesystem::path& path, bool isDirectory = false) {
+#ifdef _WIN32
+    if (isDirectory) return true; // A rename is durable once MoveFileEx returns
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    const bool synced = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    return synced;
+#else
+    int fd = ::open(path.c_str(), isDirectory ? (O_RDONLY | O_DIRECTORY) : O_RDONLY);
+    if (fd < 0) return false;
+    const bool synced = fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+// Appends plain values and length-prefixed strings to a byte buffer (native little-endian layout)
+class ByteWriter {
+public:
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteWriter only writes plain values");
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(&value);
+        bytes.insert(bytes.end(), raw, raw + sizeof(T));
+    }
+    void putBool(bool value) { put<uint8_t>(value ? 1 : 0); }
+    void putString(const std::string& value) {
+        put<uint32_t>(static_cast<uint32_t>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+
+    // Sections are padded to 8 bytes so raw arrays in them stay aligned in the mapped file
+    size_t beginSection(WorldSaveSection type) {
+        size_t start = bytes.size();
+        put(WorldSaveSectionHeader{static_cast<uint32_t>(type), 0, 0});
+        return start;
+    }
+    void endSection(size_t start) {
+        while (bytes.size() % 8 != 0) bytes.push_back(0);
+        uint64_t payloadSize = bytes.size() - start - sizeof(WorldSaveSectionHeader);
+        std::memcpy(bytes.data() + start + offsetof(WorldSaveSectionHeader, size), &payloadSize, sizeof(payloadSize));
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+// Reads what ByteWriter wrote; any read past the end marks the reader as failed
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteReader only reads plain values");
+        if (failed || size - position < sizeof(T)) {
+            failed = true;
+            return false;
+        }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+    bool getBool(bool& value) {
+        uint8_t raw = 0;
+        get(raw);
+        value = raw != 0;
+        return !failed;
+    }
+    bool getString(std::string& value) {
+        uint32_t length = 0;
+        if (!get(length) || size - position < length) {
+            failed = true;
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data + position), length);
+        position += length;
+        return true;
+    }
+    bool ok() const { return !failed; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+    bool failed = false;
+};
+
+void writeElement(ByteWriter& writer, const PlacedElement& element) {
+    writer.putString(element.instanceName);
+    writer.put<int32_t>(static_cast<int32_t>(element.elementName));
+    writer.put(element.scale);
+    writer.put(element.x);
+    writer.put(element.y);
+    writer.put(element.rotation);
+    writer.put<int32_t>(static_cast<int32_t>(element.anchorPoint));
+    writer.put(element.anchorOffsetX);
+    writer.put(element.anchorOffsetY);
+    writer.put(element.scaleOffsetX);
+    writer.put(element.scaleOffsetY);
+    writer.put<int32_t>(element.spriteSheetPhase);
+    writer.put<int32_t>(element.spriteSheetFrame);
+    writer.putBool(element.isAnimated);
+    writer.put(element.animationSpeed);
+}
+
+bool readElement(ByteReader& reader, PlacedElement& element) {
+    int32_t elementName = 0, anchorPoint = 0, phase = 0, frame = 0;
+    reader.getString(element.instanceName);
+    reader.get(elementName);
+    reader.get(element.scale);
+    reader.get(element.x);
+    reader.get(element.y);
+    reader.get(element.rotation);
+    reader.get(anchorPoint);
+    reader.get(element.anchorOffsetX);
+    reader.get(element.anchorOffsetY);
+    reader.get(element.scaleOffsetX);
+    reader.get(element.scaleOffsetY);
+    reader.get(phase);
+    reader.get(frame);
+    reader.getBool(element.isAnimated);
+    reader.get(element.animationSpeed);
+    element.elementName = static_cast<ElementName>(elementName);
+    element.anchorPoint = static_cast<AnchorPoint>(anchorPoint);
+    element.spriteSheetPhase = phase;
+    element.spriteSheetFrame = frame;
+    return reader.ok();
+}
+
+void writeEntity(ByteWriter& writer, const SavedEntity& entity) {
+    writer.putString(entity.instanceName);
+    writer.put(entity.type);
+    writer.put(entity.lifePoints);
+    writer.put(entity.damagePoints);
+    writer.putBool(entity.isWalking);
+    writer.put(entity.targetX);
+    writer.put(entity.targetY);
+    writer.put(entity.walkType);
+    writer.put(entity.lastDirection);
+    writer.put(entity.currentSegmentSpriteDirection);
+    writer.put<uint32_t>(static_cast<uint32_t>(entity.path.size()));
+    for (const auto& waypoint : entity.path) {
+        writer.put(waypoint.first);
+        writer.put(waypoint.second);
+    }
+    writer.put(entity.currentPathIndex);
+    writer.putBool(entity.hasValidPath);
+    writer.putString(entity.currentBehavior);
+    writer.put(entity.behaviorTimer);
+    writer.put(entity.nextBehaviorTriggerTime);
+    writer.putBool(entity.isInAlertState);
+    writer.putString(entity.alertTargetEntityName);
+    writer.putBool(entity.isInFleeState);
+    writer.putString(entity.fleeTargetEntityName);
+    writer.put(entity.fleeStateTimer);
+    writer.putBool(entity.isInAttackState);
+    writer.putString(entity.attackTargetEntityName);
+    writer.put(entity.attackStateTimer);
+    writer.put(entity.attackStateWaitTimer);
+    writer.putBool(entity.isWaitingBeforeCharge);
+    writer.put(entity.nextChargeTime);
+}
+
+bool readEntity(ByteReader& reader, SavedEntity& entity) {
+    reader.getString(entity.instanceName);
+    reader.get(entity.type);
+    reader.get(entity.lifePoints);
+    reader.get(entity.damagePoints);
+    reader.getBool(entity.isWalking);
+    reader.get(entity.targetX);
+    reader.get(entity.targetY);
+    reader.get(entity.walkType);
+    reader.get(entity.lastDirection);
+    reader.get(entity.currentSegmentSpriteDirection);
+    uint32_t pathLength = 0;
+    if (!reader.get(pathLength)) return false;
+    entity.path.clear();
+    for (uint32_t i = 0; i < pathLength && reader.ok(); ++i) {
+        std::pair<float, float> waypoint;
+        reader.get(waypoint.first);
+        reader.get(waypoint.second);
+        entity.path.push_back(waypoint);
+    }
+    reader.get(entity.currentPathIndex);
+    reader.getBool(entity.hasValidPath);
+    reader.getString(entity.currentBehavior);
+    reader.get(entity.behaviorTimer);
+    reader.get(entity.nextBehaviorTriggerTime);
+    reader.getBool(entity.isInAlertState);
+    reader.getString(entity.alertTargetEntityName);
+    reader.getBool(entity.isInFleeState);
+    reader.getString(entity.fleeTargetEntityName);
+    reader.get(entity.fleeStateTimer);
+    reader.getBool(entity.isInAttackState);
+    reader.getString(entity.attackTargetEntityName);
+    reader.get(entity.attackStateTimer);
+    reader.get(entity.attackStateWaitTimer);
+    reader.getBool(entity.isWaitingBeforeCharge);
+    reader.get(entity.nextChargeTime);
+    return reader.ok();
+}
+
+SavedEntity captureEntity(const Entity& entity) {
+    SavedEntity saved;
+    saved.instanceName = entity.instanceName;
+    saved.type = static_cast<int32_t>(entity.type);
+    saved.lifePoints = entity.lifePoints;
+    saved.damagePoints = entity.damagePoints;
+    saved.isWalking = entity.isWalking;
+    saved.targetX = entity.targetX;
+    saved.targetY = entity.targetY;
+    saved.walkType = static_cast<int32_t>(entity.walkType);
+    saved.lastDirection = entity.lastDirection;
+    saved.currentSegmentSpriteDirection = static_cast<int32_t>(entity.currentSegmentSpriteDirection);
+    saved.path = entity.path;
+    saved.currentPathIndex = static_cast<uint32_t>(entity.currentPathIndex);
+    saved.hasValidPath = entity.hasValidPath;
+    saved.currentBehavior = entity.currentBehavior;
+    saved.behaviorTimer = entity.behaviorTimer;
+    saved.nextBehaviorTriggerTime = entity.nextBehaviorTriggerTime;
+    saved.isInAlertState = entity.isInAlertState;
+    saved.alertTargetEntityName = entity.alertTargetEntityName;
+    saved.isInFleeState = entity.isInFleeState;
+    saved.fleeTargetEntityName = entity.fleeTargetEntityName;
+    saved.fleeStateTimer = entity.fleeStateTimer;
+    saved.isInAttackState = entity.isInAttackState;
+    saved.attackTargetEntityName = entity.attackTargetEntityName;
+    saved.attackStateTimer = entity.attackStateTimer;
+    saved.attackStateWaitTimer = entity.attackStateWaitTimer;
+    saved.isWaitingBeforeCharge = entity.isWaitingBeforeCharge;
+    saved.nextChargeTime = entity.nextChargeTime;
+    return saved;
+}
+
+} // namespace
+
+// ---- MappedFile ----
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedData = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+    mappedData = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!mappedData) return;
+#ifdef _WIN32
+    UnmapViewOfFile(mappedData);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+// ---- WorldSaveFile ----
+
+bool WorldSaveFile::open(const std::string& savePath) {
+    close();
+    if (!file.open(savePath)) {
+        std::cout << "No world save at " << savePath << std::endl;
+        return false;
+    }
+    path = savePath;
+
+    const uint8_t* data = file.data();
+    const uint64_t size = file.size();
+    bool valid = size >= WORLD_SAVE_HEADER_SIZE;
+    if (valid) {
+        std::memcpy(&header, data, sizeof(header));
+        const uint64_t chunkCount = static_cast<uint64_t>(std::max(header.chunkCountX, 0)) * static_cast<uint64_t>(std::max(header.chunkCountY, 0));
+        valid = std::memcmp(header.magic, WORLD_SAVE_MAGIC, sizeof(WORLD_SAVE_MAGIC)) == 0
+             && header.version == WORLD_SAVE_VERSION
+             && header.worldWidth > 0 && header.worldHeight > 0
+             && header.chunkCountX == (header.worldWidth + CHUNK_SIZE - 1) / CHUNK_SIZE
+             && header.chunkCountY == (header.worldHeight + CHUNK_SIZE - 1) / CHUNK_SIZE
+             && header.chunkTableOffset % sizeof(uint64_t) == 0 && header.chunkTableOffset >= WORLD_SAVE_HEADER_SIZE
+             && header.chunkTableOffset + chunkCount * sizeof(uint64_t) <= header.chunkDataEnd
+             && header.chunkDataEnd <= size && header.tailSize <= size - header.chunkDataEnd;
+        if (valid) {
+            chunkTable = reinterpret_cast<const uint64_t*>(data + header.chunkTableOffset);
+            // Incremental saves append records after the older tables and tails (see worldSave.h)
+            for (uint64_t i = 0; i < chunkCount && valid; ++i) {
+                uint64_t offset = chunkTable[i];
+                valid = offset == 0 || (offset >= WORLD_SAVE_HEADER_SIZE && offset % WORLD_SAVE_ALIGNMENT == 0
+                                        && offset + sizeof(ChunkImage) <= header.chunkDataEnd);
+            }
+        }
+    }
+    if (!valid || !readSections()) {
+        std::cerr << "World save " << savePath << " is invalid or from an incompatible version - ignoring it" << std::endl;
+        close();
+        return false;
+    }
+
+    std::cout << "Opened world save " << savePath << " (seed " << header.seed << ", " << header.worldWidth << "x"
+              << header.worldHeight << ", " << elements.size() << " elements, " << entities.size() << " entities)" << std::endl;
+    return true;
+}
+
+bool WorldSaveFile::readSections() {
+    const uint8_t* tail = file.data() + header.chunkDataEnd;
+    uint64_t position = 0;
+    while (position + sizeof(WorldSaveSectionHeader) <= header.tailSize) {
+        WorldSaveSectionHeader section;
+        std::memcpy(&section, tail + position, sizeof(section));
+        position += sizeof(section);
+        if (section.size > header.tailSize - position) return false;
+        const uint8_t* payload = tail + position;
+        ByteReader reader(payload, static_cast<size_t>(section.size));
+
+        switch (static_cast<WorldSaveSection>(section.type)) {
+            case WorldSaveSection::BLOCK_TIMERS: {
+                // Used in place, like the chunk records
+                uint32_t count = 0;
+                reader.get(count);
+                const uint8_t* timers = payload + sizeof(uint64_t); // Count is padded to 8 bytes
+                if (sizeof(uint64_t) + static_cast<uint64_t>(count) * sizeof(BlockTimerState) > section.size
+                    || reinterpret_cast<uintptr_t>(timers) % alignof(BlockTimerState) != 0) {
+                    return false;
+                }
+                blockTimers = reinterpret_cast<const BlockTimerState*>(timers);
+                blockTimerCount = count;
+                break;
+            }
+            case WorldSaveSection::SAVED_EXISTING_BLOCKS: {
+                uint32_t count = 0;
+                reader.get(count);
+                for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+                    int32_t x = 0, y = 0, name = 0;
+                    reader.get(x);
+                    reader.get(y);
+                    reader.get(name);
+                    savedExistingBlocks.push_back({{x, y}, static_cast<BlockName>(name)});
+                }
+                break;
+            }
+            case WorldSaveSection::ELEMENTS: {
+                uint32_t count = 0;
+                reader.get(count);
+                for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+                    PlacedElement element;
+                    if (readElement(reader, element)) elements.push_back(std::move(element));
+                }
+                break;
+            }
+            case WorldSaveSection::ENTITIES: {
+                uint32_t count = 0;
+                reader.get(count);
+                for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+                    SavedEntity entity;
+                    if (readEntity(reader, entity)) entities.push_back(std::move(entity));
+                }
+                break;
+            }
+            default:
+                // Section from a newer version - skip it
+                break;
+        }
+        if (!reader.ok()) return false;
+        position += section.size;
+    }
+    return true;
+}
+
+void WorldSaveFile::close() {
+    file.close();
+    path.clear();
+    header = {};
+    chunkTable = nullptr;
+    blockTimers = nullptr;
+    blockTimerCount = 0;
+    savedExistingBlocks.clear();
+    elements.clear();
+    entities.clear();
+}
+
+void WorldSaveFile::getFocusPoint(float& x, float& y) const {
+    x = header.worldWidth / 2.0f;
+    y = header.worldHeight / 2.0f;
+    for (const PlacedElement& element : elements) {
+        if (element.instanceName == "player1") {
+            x = element.x;
+            y = element.y;
+            return;
+        }
+    }
+}
+
+void WorldSaveFile::loadBlocks(Map& map) const {
+    if (!isOpen()) return;
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    map.setWorldSize(header.worldWidth, header.worldHeight);
+
+    // Streamed worlds only install the spawn-sized area around the focus point; the streamer
+    // restores the other chunks when the camera gets to them
+    const bool streamed = isStreamedWorld() && g_chunkStreamer.isActive();
+    float focusX, focusY;
+    getFocusPoint(focusX, focusY);
+    const int minChunkX = static_cast<int>(focusX - GRID_SIZE / 2.0f) / CHUNK_SIZE;
+    const int maxChunkX = static_cast<int>(focusX + GRID_SIZE / 2.0f) / CHUNK_SIZE;
+    const int minChunkY = static_cast<int>(focusY - GRID_SIZE / 2.0f) / CHUNK_SIZE;
+    const int maxChunkY = static_cast<int>(focusY + GRID_SIZE / 2.0f) / CHUNK_SIZE;
+
+    size_t installedChunks = 0;
+    size_t deferredChunks = 0;
+    for (int chunkY = 0; chunkY < header.chunkCountY; ++chunkY) {
+        for (int chunkX = 0; chunkX < header.chunkCountX; ++chunkX) {
+            uint64_t offset = chunkTable[static_cast<size_t>(chunkY) * header.chunkCountX + chunkX];
+            if (offset == 0) continue;
+            const ChunkImage& image = *reinterpret_cast<const ChunkImage*>(file.data() + offset);
+            if (image.chunkX != chunkX || image.chunkY != chunkY) continue;
+
+            if (streamed && (chunkX < minChunkX || chunkX > maxChunkX || chunkY < minChunkY || chunkY > maxChunkY)) {
+                BlockName cells[CHUNK_CELL_COUNT];
+                for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+                    cells[cell] = image.names[cell] == CHUNK_IMAGE_NO_BLOCK ? BlockName::GRASS_0 : static_cast<BlockName>(image.names[cell]);
+                }
+                g_chunkStreamer.addEvictedChunk(chunkX, chunkY, cells, 0);
+                deferredChunks++;
+            } else {
+                map.importChunkImage(image, ChunkStreamer::streamedChunkSeed(header.seed, chunkX, chunkY));
+                installedChunks++;
+            }
+        }
+    }
+    if (streamed) {
+        g_chunkStreamer.adoptResidentChunks(map);
+    }
+
+    map.importBlockTimers(blockTimers, blockTimerCount);
+    std::map<std::pair<int, int>, BlockName> existingBlocks(savedExistingBlocks.begin(), savedExistingBlocks.end());
+    map.setSavedExistingBlocks(existingBlocks);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << "Loaded " << installedChunks << " saved chunks (" << deferredChunks << " deferred to streaming), "
+              << blockTimerCount << " block timers in "
+              << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms" << std::endl;
+}
+
+void WorldSaveFile::placeElements(ElementsOnMap& elementsManager) const {
+    std::unordered_set<std::string> entityNames;
+    for (const SavedEntity& entity : entities) {
+        entityNames.insert(EntitiesManager::getElementName(entity.instanceName));
+    }
+
+    size_t placedCount = 0;
+    for (const PlacedElement& element : elements) {
+        if (entityNames.count(element.instanceName)) continue; // Placed with its entity
+        elementsManager.restorePlacedElement(element);
+        placedCount++;
+    }
+    std::cout << "Restored " << placedCount << " saved elements" << std::endl;
+}
+
+void WorldSaveFile::placeEntities(EntitiesManager& entitiesManager, ElementsOnMap& elementsManager) const {
+    for (const SavedEntity& saved : entities) {
+        const std::string elementName = EntitiesManager::getElementName(saved.instanceName);
+        auto element = std::find_if(elements.begin(), elements.end(),
+            [&elementName](const PlacedElement& candidate) { return candidate.instanceName == elementName; });
+        if (element == elements.end()) {
+            std::cerr << "World save: no element for entity " << saved.instanceName << " - skipped" << std::endl;
+            continue;
+        }
+
+        if (!entitiesManager.placeEntityByType(saved.instanceName, static_cast<EntityName>(saved.type), element->x, element->y, element->spriteSheetPhase)) {
+            continue;
+        }
+        // The saved position was valid when saved, so undo any spawn collision resolution
+        elementsManager.changeElementCoordinates(elementName, element->x, element->y, element->rotation);
+        elementsManager.changeElementSpriteFrame(elementName, element->spriteSheetFrame);
+        elementsManager.changeElementAnimationSpeed(elementName, element->animationSpeed);
+        elementsManager.changeElementAnimationStatus(elementName, element->isAnimated);
+
+        if (Entity* entity = entitiesManager.getEntity(saved.instanceName)) {
+            entity->lifePoints = saved.lifePoints;
+            entity->damagePoints = saved.damagePoints;
+        }
+    }
+    std::cout << "Restored " << entities.size() << " saved entities" << std::endl;
+}
+
+void WorldSaveFile::restoreEntityStates(EntitiesManager& entitiesManager) const {
+    for (const SavedEntity& saved : entities) {
+        Entity* entity = entitiesManager.getEntity(saved.instanceName);
+        if (!entity) continue;
+
+        entity->isWalking = saved.isWalking;
+        entity->targetX = saved.targetX;
+        entity->targetY = saved.targetY;
+        entity->walkType = static_cast<WalkType>(saved.walkType);
+        entity->lastDirection = saved.lastDirection;
+        entity->currentSegmentSpriteDirection = static_cast<EntityDirection>(saved.currentSegmentSpriteDirection);
+        entity->path = saved.path;
+        entity->currentPathIndex = std::min<size_t>(saved.currentPathIndex, saved.path.size());
+        entity->hasValidPath = saved.hasValidPath && !saved.path.empty();
+        // Requests in flight were not saved; the behaviors ask again if needed
+        entity->isPathfindingRequested = false;
+        entity->isWaitingForPath = false;
+
+        entity->currentBehavior = saved.currentBehavior;
+        entity->behaviorTimer = saved.behaviorTimer;
+        entity->nextBehaviorTriggerTime = saved.nextBehaviorTriggerTime;
+        entity->isInAlertState = saved.isInAlertState;
+        entity->alertTargetEntityName = saved.alertTargetEntityName;
+        entity->isInFleeState = saved.isInFleeState;
+        entity->fleeTargetEntityName = saved.fleeTargetEntityName;
+        entity->fleeStateTimer = saved.fleeStateTimer;
+        entity->isInAttackState = saved.isInAttackState;
+        entity->attackTargetEntityName = saved.attackTargetEntityName;
+        entity->attackStateTimer = saved.attackStateTimer;
+        entity->attackStateWaitTimer = saved.attackStateWaitTimer;
+        entity->isWaitingBeforeCharge = saved.isWaitingBeforeCharge;
+        entity->nextChargeTime = saved.nextChargeTime;
+    }
+}
+
+// ---- WorldSaver ----
+
+WorldSaver::WorldSaver() {}
+
+WorldSaver::~WorldSaver() {
+    stop();
+}
+
+bool WorldSaver::requestSave(const std::string& savePath) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (stage.load() != STAGE_IDLE) {
+        std::cout << "World save already in progress" << std::endl;
+        return false;
+    }
+    if (!writerThread.joinable()) {
+        stopRequested = false;
+        writerThread = std::thread(&WorldSaver::writerLoop, this);
+    }
+    job = std::make_unique<WorldSaveJob>();
+    job->path = savePath;
+    requestedPath = savePath;
+    stage.store(STAGE_CAPTURE_MAP);
+    return true;
+}
+
+void WorldSaver::captureMapState(const Map& map) {
+    if (stage.load() != STAGE_CAPTURE_MAP) return;
+
+    WorldSaveJob& saveJob = *job;
+    // One consistent map state: no block transformation or chunk change until the capture is done
+    auto mapLock = map.lockWrites();
+    const int chunkCountX = map.getChunkCountX();
+    const int chunkCountY = map.getChunkCountY();
+    saveJob.fresh = trackedPath != saveJob.path || trackedSeed != SEED_GAMEPLAY || compactionDue
+                 || trackedChunkCountX != chunkCountX || trackedChunkCountY != chunkCountY
+                 || !std::filesystem::exists(saveJob.path);
+    auto savedVersion = [&](int chunkX, int chunkY) {
+        return saveJob.fresh ? 0u : savedVersions[static_cast<size_t>(chunkY) * chunkCountX + chunkX];
+    };
+
+    // Resident chunks that changed since they were last written
+    for (int chunkY = 0; chunkY < chunkCountY; ++chunkY) {
+        for (int chunkX = 0; chunkX < chunkCountX; ++chunkX) {
+            unsigned int version = map.getChunkContentVersion(chunkX, chunkY);
+            if (version == 0 || version == savedVersion(chunkX, chunkY)) continue;
+            saveJob.chunks.emplace_back();
+            map.exportChunkImage(chunkX, chunkY, saveJob.chunks.back());
+        }
+    }
+
+    // Streamed chunks that left the map since (a new file takes all of them)
+    if (g_chunkStreamer.isActive()) {
+        g_chunkStreamer.forEachEvictedChunk([&](int chunkX, int chunkY, unsigned int version) {
+            if (chunkX >= chunkCountX || chunkY >= chunkCountY) return;
+            if (!saveJob.fresh && version == savedVersion(chunkX, chunkY)) return;
+            BlockName cells[CHUNK_CELL_COUNT];
+            if (!g_chunkStreamer.getEvictedChunkCells(chunkX, chunkY, cells)) return;
+            saveJob.chunks.emplace_back();
+            ChunkImage& image = saveJob.chunks.back();
+            image.chunkX = chunkX;
+            image.chunkY = chunkY;
+            image.blockCount = CHUNK_CELL_COUNT;
+            image.contentVersion = version;
+            image.flags = CHUNK_IMAGE_ROTATIONS_FROM_SEED;
+            for (int cell = 0; cell < CHUNK_CELL_COUNT; ++cell) {
+                image.names[cell] = static_cast<int32_t>(cells[cell]);
+                image.rotations[cell] = 0;
+            }
+        });
+    }
+
+    map.exportBlockTimers(saveJob.blockTimers);
+    saveJob.savedExistingBlocks = map.getSavedExistingBlocks();
+
+    WorldSaveHeader& header = saveJob.header;
+    std::memcpy(header.magic, WORLD_SAVE_MAGIC, sizeof(WORLD_SAVE_MAGIC));
+    header.version = WORLD_SAVE_VERSION;
+    header.flags = g_chunkStreamer.isActive() ? WORLD_SAVE_FLAG_STREAMED : 0;
+    header.seed = SEED_GAMEPLAY;
+    header.worldWidth = map.getWorldWidth();
+    header.worldHeight = map.getWorldHeight();
+    header.chunkCountX = chunkCountX;
+    header.chunkCountY = chunkCountY;
+    header.coconutCounter = COCONUT_COUNTER;
+    header.chunkTableOffset = WORLD_SAVE_HEADER_SIZE;
+
+    stage.store(STAGE_CAPTURE_OBJECTS);
+}
+
+void WorldSaver::captureObjectState(EntitiesManager& entities, const ElementsOnMap& elements) {
+    // Claim the capture: while paused both the main thread and a finishing logic tick may get here
+    int expected = STAGE_CAPTURE_OBJECTS;
+    if (stage.load() != STAGE_CAPTURE_OBJECTS || !stage.compare_exchange_strong(expected, STAGE_WRITING)) return;
+
+    WorldSaveJob& saveJob = *job;
+    saveJob.elements = elements.getElements();
+    for (const auto& pair : entities.getEntities()) {
+        saveJob.entities.push_back(captureEntity(pair.second));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        jobQueued = true;
+    }
+    writerCondition.notify_all();
+}
+
+void WorldSaver::updateAutosave() {
+    if (AUTOSAVE_INTERVAL_SECONDS <= 0.0f) return;
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<float>(now - lastAutosaveTime).count() >= AUTOSAVE_INTERVAL_SECONDS) {
+        lastAutosaveTime = now;
+        if (requestSave(WORLD_SAVE_PATH)) {
+            std::cout << "Autosaving world..." << std::endl;
+        }
+    }
+}
+
+void WorldSaver::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    const int currentStage = stage.load();
+    if (currentStage == STAGE_CAPTURE_MAP || currentStage == STAGE_CAPTURE_OBJECTS) {
+        // Only called while the game threads are stopped, so nobody will finish this capture
+        std::cout << "World save abandoned (gameplay ended before it was captured)" << std::endl;
+        job.reset();
+        stage.store(STAGE_IDLE);
+        return;
+    }
+    writerCondition.wait(lock, [this] { return stage.load() == STAGE_IDLE; });
+}
+
+void WorldSaver::resetTracking() {
+    waitUntilIdle();
+    trackedPath.clear();
+    trackedSeed = 0;
+    trackedChunkCountX = 0;
+    trackedChunkCountY = 0;
+    chunkOffsets.clear();
+    savedVersions.clear();
+    savedDataEnd = 0;
+    compactionDue = false;
+    lastAutosaveTime = std::chrono::steady_clock::now();
+}
+
+void WorldSaver::trackLoadedWorld(const WorldSaveFile& file, const Map& map) {
+    resetTracking();
+    if (!file.isOpen() || file.getChunkCountX() != map.getChunkCountX() || file.getChunkCountY() != map.getChunkCountY()) return;
+
+    trackedPath = file.getPath();
+    trackedSeed = file.getSeed();
+    trackedChunkCountX = file.getChunkCountX();
+    trackedChunkCountY = file.getChunkCountY();
+    const size_t chunkCount = static_cast<size_t>(trackedChunkCountX) * trackedChunkCountY;
+    chunkOffsets.assign(chunkCount, 0);
+    savedVersions.assign(chunkCount, 0);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        chunkOffsets[i] = file.getChunkOffset(i);
+        // Installed chunks are unchanged until their version moves; deferred ones sit in the
+        // streamer with version 0
+        if (chunkOffsets[i] != 0) {
+            savedVersions[i] = map.getChunkContentVersion(static_cast<int>(i % trackedChunkCountX), static_cast<int>(i / trackedChunkCountX));
+        }
+    }
+    savedDataEnd = file.getDataEnd();
+}
+
+void WorldSaver::stop() {
+    if (!writerThread.joinable()) return;
+    waitUntilIdle();
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopRequested = true;
+    }
+    writerCondition.notify_all();
+    writerThread.join();
+}
+
+void WorldSaver::writerLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        writerCondition.wait(lock, [this] { return jobQueued || stopRequested; });
+        if (jobQueued) {
+            lock.unlock();
+            auto startTime = std::chrono::high_resolution_clock::now();
+            const size_t chunkCount = job->chunks.size();
+            bool saved = writeJob(*job);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            if (saved) {
+                std::cout << "World saved to " << job->path << " (" << chunkCount << " chunks written"
+                          << (job->fresh ? ", new file" : "") << ") in "
+                          << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms" << std::endl;
+            }
+            lock.lock();
+            jobQueued = false;
+            job.reset();
+            stage.store(STAGE_IDLE);
+            writerCondition.notify_all();
+            continue;
+        }
+        if (stopRequested) break;
+    }
+}
+
+bool WorldSaver::writeJob(WorldSaveJob& saveJob) {
+    WorldSaveHeader& header = saveJob.header;
+    const size_t chunkCount = static_cast<size_t>(header.chunkCountX) * header.chunkCountY;
+    const uint64_t chunkTableSize = chunkCount * sizeof(uint64_t);
+
+    // A new file is written next to the old one and renamed over it; an update appends past the
+    // data the current header references, and only the header itself is rewritten
+    uint64_t writeOffset;
+    if (saveJob.fresh) {
+        trackedPath = saveJob.path;
+        trackedSeed = header.seed;
+        trackedChunkCountX = header.chunkCountX;
+        trackedChunkCountY = header.chunkCountY;
+        chunkOffsets.assign(chunkCount, 0);
+        savedVersions.assign(chunkCount, 0);
+        writeOffset = alignUp(header.chunkTableOffset + chunkTableSize);
+    } else {
+        writeOffset = alignUp(savedDataEnd);
+    }
+
+    std::error_code error;
+    std::filesystem::path filePath(saveJob.path);
+    if (filePath.has_parent_path()) {
+        std::filesystem::create_directories(filePath.parent_path(), error);
+    }
+    std::filesystem::path writePath = saveJob.fresh ? std::filesystem::path(saveJob.path + ".tmp") : filePath;
+    std::fstream out(writePath, saveJob.fresh ? (std::ios::out | std::ios::binary | std::ios::trunc)
+                                              : (std::ios::in | std::ios::out | std::ios::binary));
+    if (!out.is_open()) {
+        std::cerr << "World save failed: cannot open " << writePath.string() << std::endl;
+        trackedPath.clear();
+        return false;
+    }
+
+    // 1. Chunk records of the chunks that changed, then (update) a new chunk table after them
+    for (const ChunkImage& image : saveJob.chunks) {
+        size_t chunkIndex = static_cast<size_t>(image.chunkY) * header.chunkCountX + image.chunkX;
+        chunkOffsets[chunkIndex] = writeOffset;
+        writeOffset += WORLD_SAVE_CHUNK_STRIDE;
+        out.seekp(static_cast<std::streamoff>(chunkOffsets[chunkIndex]));
+        out.write(reinterpret_cast<const char*>(&image), sizeof(ChunkImage));
+    }
+    if (!saveJob.fresh) {
+        header.chunkTableOffset = writeOffset;
+        writeOffset = alignUp(writeOffset + chunkTableSize);
+    }
+    out.seekp(static_cast<std::streamoff>(header.chunkTableOffset));
+    out.write(reinterpret_cast<const char*>(chunkOffsets.data()), static_cast<std::streamsize>(chunkTableSize));
+    const uint64_t chunkDataEnd = writeOffset;
+
+    // 2. Tail sections
+    ByteWriter tail;
+    size_t section = tail.beginSection(WorldSaveSection::BLOCK_TIMERS);
+    tail.put<uint32_t>(static_cast<uint32_t>(saveJob.blockTimers.size()));
+    tail.put<uint32_t>(0); // Keeps the array 8-byte aligned
+    for (const BlockTimerState& timer : saveJob.blockTimers) tail.put(timer);
+    tail.endSection(section);
+
+    section = tail.beginSection(WorldSaveSection::SAVED_EXISTING_BLOCKS);
+    tail.put<uint32_t>(static_cast<uint32_t>(saveJob.savedExistingBlocks.size()));
+    for (const auto& entry : saveJob.savedExistingBlocks) {
+        tail.put<int32_t>(entry.first.first);
+        tail.put<int32_t>(entry.first.second);
+        tail.put<int32_t>(static_cast<int32_t>(entry.second));
+    }
+    tail.endSection(section);
+
+    section = tail.beginSection(WorldSaveSection::ELEMENTS);
+    tail.put<uint32_t>(static_cast<uint32_t>(saveJob.elements.size()));
+    for (const PlacedElement& element : saveJob.elements) writeElement(tail, element);
+    tail.endSection(section);
+
+    section = tail.beginSection(WorldSaveSection::ENTITIES);
+    tail.put<uint32_t>(static_cast<uint32_t>(saveJob.entities.size()));
+    for (const SavedEntity& entity : saveJob.entities) writeEntity(tail, entity);
+    tail.endSection(section);
+
+    out.seekp(static_cast<std::streamoff>(chunkDataEnd));
+    out.write(reinterpret_cast<const char*>(tail.bytes.data()), static_cast<std::streamsize>(tail.bytes.size()));
+
+    // 3. The header last, once everything it will reference is on the disk: an update overwrites
+    // only these WORLD_SAVE_HEADER_SIZE bytes (one sector), so a crash keeps either save whole
+    out.flush();
+    bool written = out.good() && (saveJob.fresh || syncToDisk(writePath));
+    if (written) {
+        header.chunkDataEnd = chunkDataEnd;
+        header.tailSize = tail.bytes.size();
+        char headerBlock[WORLD_SAVE_HEADER_SIZE] = {};
+        std::memcpy(headerBlock, &header, sizeof(header));
+        out.seekp(0);
+        out.write(headerBlock, sizeof(headerBlock));
+        out.flush();
+        written = out.good();
+    }
+    out.close();
+    written = written && syncToDisk(writePath);
+    if (written && saveJob.fresh) {
+        std::filesystem::rename(writePath, filePath, error);
+        written = !error && syncToDisk(filePath.has_parent_path() ? filePath.parent_path() : std::filesystem::path("."), true);
+    }
+    if (!written) {
+        std::cerr << "World save failed: error while writing " << writePath.string() << std::endl;
+        if (saveJob.fresh) std::filesystem::remove(writePath, error);
+        trackedPath.clear();
+        return false;
+    }
+
+    savedDataEnd = chunkDataEnd + tail.bytes.size();
+    if (!saveJob.fresh) {
+        // Bytes a crashed update may have left past the new end
+        std::filesystem::resize_file(filePath, savedDataEnd, error);
+    }
+
+    // Superseded records, tables and tails pile up with every update: compact on the next save once
+    // they take more room than the live data
+    uint64_t liveBytes = WORLD_SAVE_HEADER_SIZE + chunkTableSize + tail.bytes.size();
+    for (uint64_t offset : chunkOffsets) {
+        if (offset != 0) liveBytes += WORLD_SAVE_CHUNK_STRIDE;
+    }
+    compactionDue = savedDataEnd > 2 * liveBytes;
+
+    for (const ChunkImage& image : saveJob.chunks) {
+        savedVersions[static_cast<size_t>(image.chunkY) * header.chunkCountX + image.chunkX] = image.contentVersion;
+    }
+    return true;
+}
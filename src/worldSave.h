@@ -0,0 +1,242 @@
+#pragma once
+
+#include "map.h"
+#include "elementsOnMap.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class EntitiesManager;
+
+// ---- World save file format (version 1) ----
+//
+//   [WorldSaveHeader, padded to WORLD_SAVE_HEADER_SIZE]
+//   [chunk table: chunkCountX * chunkCountY uint64 file offsets, 0 = chunk not saved]
+//   [ChunkImage records, each at a WORLD_SAVE_ALIGNMENT aligned offset, WORLD_SAVE_CHUNK_STRIDE apart]
+//   [tail: WorldSaveSectionHeader + payload, repeated; unknown section types are skipped]
+//
+// That is the layout of a new file. An incremental save never overwrites what the current header
+// references: it appends the changed chunk records, a new chunk table and a new tail past the old
+// tail, makes them durable, and only then rewrites the header (one sector). So the chunk table and
+// the records may sit anywhere between the header and chunkDataEnd; a crash mid-save leaves the
+// previous save intact. Once superseded records take more room than live data, the next save
+// compacts by writing a new file next to the old one and renaming it over it.
+// Chunk records are plain ChunkImage structs in native (little-endian) layout, so loading
+// installs them straight from the memory-mapped file without parsing or copying.
+const char WORLD_SAVE_MAGIC[8] = {'S', 'C', 'W', 'O', 'R', 'L', 'D', '\0'};
+const uint32_t WORLD_SAVE_VERSION = 1;
+const uint32_t WORLD_SAVE_FLAG_STREAMED = 1u; // Saved from a streamed (chunk-by-chunk) world
+const uint64_t WORLD_SAVE_ALIGNMENT = 64;
+const uint64_t WORLD_SAVE_HEADER_SIZE = 128;
+const uint64_t WORLD_SAVE_CHUNK_STRIDE = (sizeof(ChunkImage) + WORLD_SAVE_ALIGNMENT - 1) / WORLD_SAVE_ALIGNMENT * WORLD_SAVE_ALIGNMENT;
+
+struct WorldSaveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;            // WORLD_SAVE_FLAG_*
+    uint32_t seed;             // SEED_GAMEPLAY of the saved world
+    int32_t worldWidth;
+    int32_t worldHeight;
+    int32_t chunkCountX;
+    int32_t chunkCountY;
+    int32_t coconutCounter;
+    uint64_t chunkTableOffset;
+    uint64_t chunkDataEnd;     // End of the chunk records = start of the tail
+    uint64_t tailSize;
+};
+static_assert(sizeof(WorldSaveHeader) <= WORLD_SAVE_HEADER_SIZE, "World save header does not fit");
+
+enum class WorldSaveSection : uint32_t {
+    BLOCK_TIMERS = 1,          // BlockTimerState[]
+    SAVED_EXISTING_BLOCKS = 2, // {int32 x, int32 y, int32 name}[] - blocks under ICE
+    ELEMENTS = 3,              // Every placed element (including the ones owned by entities)
+    ENTITIES = 4               // Entity state: health, movement, path, behaviors
+};
+
+struct WorldSaveSectionHeader {
+    uint32_t type;             // WorldSaveSection
+    uint32_t reserved;
+    uint64_t size;             // Payload size in bytes
+};
+
+// Entity state worth saving (the rest is rebuilt by the entity systems)
+struct SavedEntity {
+    std::string instanceName;
+    int32_t type = 0;          // EntityName
+    int32_t lifePoints = 0;
+    int32_t damagePoints = 0;
+    bool isWalking = false;
+    float targetX = 0.0f;
+    float targetY = 0.0f;
+    int32_t walkType = 0;      // WalkType
+    int32_t lastDirection = 1;
+    int32_t currentSegmentSpriteDirection = 1;
+    std::vector<std::pair<float, float>> path;
+    uint32_t currentPathIndex = 0;
+    bool hasValidPath = false;
+    std::string currentBehavior;
+    double behaviorTimer = 0.0;
+    double nextBehaviorTriggerTime = 0.0;
+    bool isInAlertState = false;
+    std::string alertTargetEntityName;
+    bool isInFleeState = false;
+    std::string fleeTargetEntityName;
+    double fleeStateTimer = 0.0;
+    bool isInAttackState = false;
+    std::string attackTargetEntityName;
+    double attackStateTimer = 0.0;
+    double attackStateWaitTimer = 0.0;
+    bool isWaitingBeforeCharge = false;
+    double nextChargeTime = 0.0;
+};
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+class MappedFile {
+public:
+    MappedFile() {}
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    const uint8_t* data() const { return mappedData; }
+    size_t size() const { return mappedSize; }
+
+private:
+    const uint8_t* mappedData = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// A save file opened for loading. The chunk records are used in place from the mapping, so keep
+// the file open until loadBlocks() has run.
+class WorldSaveFile {
+public:
+    // Map the file and validate its header and sections. Returns false (and stays closed) if the
+    // file is missing or not a valid save.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.data() != nullptr; }
+    const std::string& getPath() const { return path; }
+
+    unsigned int getSeed() const { return header.seed; }
+    int getWorldWidth() const { return header.worldWidth; }
+    int getWorldHeight() const { return header.worldHeight; }
+    bool isStreamedWorld() const { return (header.flags & WORLD_SAVE_FLAG_STREAMED) != 0; }
+    int getCoconutCounter() const { return header.coconutCounter; }
+    // Where the world should be loaded around first: the player if saved, else the world center
+    void getFocusPoint(float& x, float& y) const;
+
+    // Install the saved blocks, timers and ICE memory into the map (main thread, map already
+    // cleared and sized). For streamed worlds g_chunkStreamer must be started: chunks around the
+    // focus point are installed and the others handed to the streamer in compact form.
+    void loadBlocks(Map& map) const;
+    // Place the saved elements, except the ones that belong to entities
+    void placeElements(ElementsOnMap& elements) const;
+    // Place the saved entities and give their elements back their saved animation state
+    void placeEntities(EntitiesManager& entities, ElementsOnMap& elements) const;
+    // Restore movement/behavior state - after EntitiesManager::resetAllEntityMovementStates
+    void restoreEntityStates(EntitiesManager& entities) const;
+
+    // Chunk table, for WorldSaver::trackLoadedWorld
+    uint64_t getChunkOffset(size_t chunkIndex) const { return chunkTable[chunkIndex]; }
+    uint64_t getDataEnd() const { return header.chunkDataEnd + header.tailSize; }
+    int getChunkCountX() const { return header.chunkCountX; }
+    int getChunkCountY() const { return header.chunkCountY; }
+
+private:
+    bool readSections();
+
+    MappedFile file;
+    std::string path;
+    WorldSaveHeader header = {};
+    const uint64_t* chunkTable = nullptr;   // Points into the mapping
+
+    const BlockTimerState* blockTimers = nullptr; // Points into the mapping
+    size_t blockTimerCount = 0;
+    std::vector<std::pair<std::pair<int, int>, BlockName>> savedExistingBlocks;
+    std::vector<PlacedElement> elements;
+    std::vector<SavedEntity> entities;
+};
+
+// The save being loaded at gameplay start (open only while startGameplay runs)
+extern WorldSaveFile g_loadedWorldSave;
+
+struct WorldSaveJob;
+
+// Saves the world in the background, without stalling the frame or the 60 Hz logic tick:
+//  1. requestSave() (any thread) asks for a save
+//  2. captureMapState() (main thread, every frame) copies the chunks that changed since the last
+//     save, the block timers and the ICE memory while holding the map's write lock (Map::lockWrites),
+//     so the logic tick's block transformations cannot land halfway through
+//  3. captureObjectState() (logic thread, every tick) copies elements and entities between two
+//     updates; while the game is paused the main thread calls it instead
+//  4. the writer thread serializes the snapshot and appends it to the file, or writes a new file
+//     and renames it over the old one (see the file format above)
+class WorldSaver {
+public:
+    WorldSaver();
+    ~WorldSaver();
+
+    // Returns false if a save is already in progress
+    bool requestSave(const std::string& savePath);
+    bool isBusy() const { return stage.load() != STAGE_IDLE; }
+
+    void captureMapState(const Map& map);
+    void captureObjectState(EntitiesManager& entities, const ElementsOnMap& elements);
+
+    // Main thread, every frame while playing: requests a save every AUTOSAVE_INTERVAL_SECONDS
+    void updateAutosave();
+
+    // A new world starts: the next save rewrites the whole file. Waits for a save in progress.
+    void resetTracking();
+    // The world was loaded from file: the next save only rewrites what changed since
+    void trackLoadedWorld(const WorldSaveFile& file, const Map& map);
+
+    // Finish the save in progress (if any) and stop the writer thread
+    void stop();
+
+private:
+    enum Stage { STAGE_IDLE, STAGE_CAPTURE_MAP, STAGE_CAPTURE_OBJECTS, STAGE_WRITING };
+
+    void startWriter();
+    void writerLoop();
+    bool writeJob(WorldSaveJob& job);
+    void waitUntilIdle();
+
+    std::atomic<int> stage{STAGE_IDLE};
+    std::unique_ptr<WorldSaveJob> job; // Owned by whichever stage is running
+    std::string requestedPath;
+
+    std::thread writerThread;
+    std::mutex writerMutex;
+    std::condition_variable writerCondition;
+    bool jobQueued = false;
+    bool stopRequested = false;
+
+    // What the file on disk holds (touched by one stage at a time)
+    std::string trackedPath;
+    unsigned int trackedSeed = 0;
+    int trackedChunkCountX = 0;
+    int trackedChunkCountY = 0;
+    std::vector<uint64_t> chunkOffsets;       // File offset of each chunk record, 0 = not in the file
+    std::vector<unsigned int> savedVersions;  // Map content version of each chunk when it was written
+    uint64_t savedDataEnd = 0;                // End of the tail the header references: the next save appends after it
+    bool compactionDue = false;               // The next save writes a new file (superseded records outgrew the live data)
+
+    std::chrono::steady_clock::time_point lastAutosaveTime = std::chrono::steady_clock::now();
+};
+
+// Global world saver
+extern WorldSaver g_worldSaver;
@@ -0,0 +1,142 @@
+// Asset packer
+// Decodes every PNG under <assets>/textures (blocks, decorations, entities, items, ui) once and
+// writes them to a single pre-decoded pack (format in src/assetPack.h) that the game maps at
+// startup instead of decoding the PNGs. Built and run by the asset_pack target:
+//   cmake --build <build dir> --target asset_pack
+// Usage: sorbetcoco_asset_packer <assets dir> <output pack>
+// The pixels are decoded exactly like the loaders decode them (stb_image, flipped vertically,
+// source channel count), so a packed texture uploads to the same texels as the PNG.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../third_party/glbasimac/tools/stb_image.h"
+#include "../src/assetPack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PackedImage {
+    std::string key; // Path as the game asks for it: "../assets/textures/..."
+    uint64_t sourceSize = 0;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<unsigned char> pixels;
+};
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool writeAll(FILE* file, const void* data, size_t size) {
+    return size == 0 || std::fwrite(data, 1, size, file) == size;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <assets dir> <output pack>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const fs::path assetsDir = argv[1];
+    const fs::path outputPath = argv[2];
+    const fs::path texturesDir = assetsDir / "textures";
+    if (!fs::is_directory(texturesDir)) {
+        std::cerr << "No textures directory in " << assetsDir << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Sorted, so the same textures always give the same pack
+    std::vector<fs::path> sources;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(texturesDir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".png") {
+            sources.push_back(entry.path());
+        }
+    }
+    std::sort(sources.begin(), sources.end());
+
+    std::vector<PackedImage> images;
+    stbi_set_flip_vertically_on_load(1);
+    for (const fs::path& source : sources) {
+        PackedImage image;
+        image.key = "../assets/" + fs::relative(source, assetsDir).generic_string();
+        image.sourceSize = fs::file_size(source);
+        unsigned char* pixels = stbi_load(source.string().c_str(), &image.width, &image.height, &image.channels, 0);
+        if (!pixels) {
+            std::cerr << "Cannot decode " << source << ": " << stbi_failure_reason() << std::endl;
+            return EXIT_FAILURE;
+        }
+        image.pixels.assign(pixels, pixels + static_cast<size_t>(image.width) * image.height * image.channels);
+        stbi_image_free(pixels);
+        images.push_back(std::move(image));
+    }
+
+    // Header, entry table and string table first, then the aligned payloads
+    AssetPackHeader header = {};
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = static_cast<uint32_t>(images.size());
+    header.stringsOffset = sizeof(AssetPackHeader) + images.size() * sizeof(AssetPackEntry);
+
+    std::string strings;
+    std::vector<AssetPackEntry> entries(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        entries[i].pathOffset = static_cast<uint32_t>(strings.size());
+        entries[i].pathLength = static_cast<uint32_t>(images[i].key.size());
+        strings += images[i].key;
+    }
+    header.stringsSize = strings.size();
+
+    uint64_t payloadOffset = alignUp(header.stringsOffset + header.stringsSize, ASSET_PACK_PAYLOAD_ALIGNMENT);
+    for (size_t i = 0; i < images.size(); ++i) {
+        AssetPackEntry& entry = entries[i];
+        entry.payloadOffset = payloadOffset;
+        entry.payloadSize = images[i].pixels.size();
+        entry.sourceSize = images[i].sourceSize;
+        entry.width = static_cast<uint32_t>(images[i].width);
+        entry.height = static_cast<uint32_t>(images[i].height);
+        entry.channels = static_cast<uint32_t>(images[i].channels);
+        entry.compression = ASSET_PACK_RAW;
+        payloadOffset = alignUp(payloadOffset + entry.payloadSize, ASSET_PACK_PAYLOAD_ALIGNMENT);
+    }
+
+    // Written next to the target first: the game never maps a half-written pack
+    const fs::path temporaryPath = outputPath.string() + ".tmp";
+    FILE* file = std::fopen(temporaryPath.string().c_str(), "wb");
+    if (!file) {
+        std::cerr << "Cannot write " << temporaryPath << std::endl;
+        return EXIT_FAILURE;
+    }
+    bool written = writeAll(file, &header, sizeof(header)) &&
+                   writeAll(file, entries.data(), entries.size() * sizeof(AssetPackEntry)) &&
+                   writeAll(file, strings.data(), strings.size());
+    uint64_t position = header.stringsOffset + header.stringsSize;
+    const unsigned char padding[ASSET_PACK_PAYLOAD_ALIGNMENT] = {};
+    for (size_t i = 0; written && i < images.size(); ++i) {
+        written = writeAll(file, padding, static_cast<size_t>(entries[i].payloadOffset - position)) &&
+                  writeAll(file, images[i].pixels.data(), images[i].pixels.size());
+        position = entries[i].payloadOffset + entries[i].payloadSize;
+    }
+    written = std::fclose(file) == 0 && written;
+    std::error_code error;
+    if (written) {
+        fs::rename(temporaryPath, outputPath, error);
+    }
+    if (!written || error) {
+        std::cerr << "Cannot write " << outputPath << std::endl;
+        fs::remove(temporaryPath, error);
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Packed " << images.size() << " textures into " << outputPath.string() << " (" << position / 1024 << " KiB)" << std::endl;
+    return EXIT_SUCCESS;
+}